@@ -0,0 +1,80 @@
+//MIT License
+
+//Copyright (c) 2020 bexoft GmbH (mail@bexoft.de)
+
+//Permission is hereby granted, free of charge, to any person obtaining a copy
+//of this software and associated documentation files (the "Software"), to deal
+//in the Software without restriction, including without limitation the rights
+//to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//copies of the Software, and to permit persons to whom the Software is
+//furnished to do so, subject to the following conditions:
+
+//The above copyright notice and this permission notice shall be included in all
+//copies or substantial portions of the Software.
+
+//THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//SOFTWARE.
+
+
+#include <benchmark/benchmark.h>
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include "finalmq/helpers/Executor.h"
+
+using namespace finalmq;
+
+namespace
+{
+const int NUMBER_OF_WORKERS = 4;
+const int NUMBER_OF_INSTANCES = 16;
+const int ACTIONS_PER_PRODUCER = 50000;
+
+// Several producer threads add actions to the executor of a worker pool. Half of the actions
+// have no instance, the other half is distributed over instances that are owned by one producer.
+template<class T>
+void benchContention(benchmark::State& state)
+{
+    const int numberOfProducers = static_cast<int>(state.range(0));
+    const int numberOfActions = numberOfProducers * ACTIONS_PER_PRODUCER;
+    ExecutorWorker<T> worker(NUMBER_OF_WORKERS);
+    for (auto _ : state)
+    {
+        std::atomic<int> counter{0};
+        std::vector<std::thread> producers;
+        for (int p = 0; p < numberOfProducers; ++p)
+        {
+            producers.emplace_back([&worker, &counter, p]() {
+                for (int i = 0; i < ACTIONS_PER_PRODUCER; ++i)
+                {
+                    std::int64_t instanceId = (i % 2 == 0) ? 0 : (p * NUMBER_OF_INSTANCES + (i % NUMBER_OF_INSTANCES) + 1);
+                    worker.addAction([&counter]() {
+                        counter.fetch_add(1, std::memory_order_relaxed);
+                    }, instanceId);
+                }
+            });
+        }
+        for (auto& producer : producers)
+        {
+            producer.join();
+        }
+        while (counter.load() < numberOfActions)
+        {
+            std::this_thread::yield();
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * numberOfActions);
+}
+
+} // namespace
+
+BENCHMARK_TEMPLATE(benchContention, Executor)->Arg(1)->Arg(4)->UseRealTime()->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(benchContention, ExecutorIgnoreOrderOfInstance)->Arg(1)->Arg(4)->UseRealTime()->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(benchContention, ExecutorWorkStealing)->Arg(1)->Arg(4)->UseRealTime()->Unit(benchmark::kMillisecond);
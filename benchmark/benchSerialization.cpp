@@ -0,0 +1,409 @@
+//MIT License
+
+//Copyright (c) 2020 bexoft GmbH (mail@bexoft.de)
+
+//Permission is hereby granted, free of charge, to any person obtaining a copy
+//of this software and associated documentation files (the "Software"), to deal
+//in the Software without restriction, including without limitation the rights
+//to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//copies of the Software, and to permit persons to whom the Software is
+//furnished to do so, subject to the following conditions:
+
+//The above copyright notice and this permission notice shall be included in all
+//copies or substantial portions of the Software.
+
+//THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//SOFTWARE.
+
+
+#include <benchmark/benchmark.h>
+
+#include <functional>
+#include <new>
+#include <string>
+#include <vector>
+
+#include <stdlib.h>
+
+#include "bench.fmq.h"
+#include "finalmq/helpers/ZeroCopyBuffer.h"
+#include "finalmq/serializehl7/ParserHl7.h"
+#include "finalmq/serializehl7/SerializerHl7.h"
+#include "finalmq/serializejson/ParserJson.h"
+#include "finalmq/serializejson/SerializerJson.h"
+#include "finalmq/serializeproto/ParserProto.h"
+#include "finalmq/serializeproto/SerializerProto.h"
+#include "finalmq/serializeqt/ParserQt.h"
+#include "finalmq/serializeqt/SerializerQt.h"
+#include "finalmq/serializestruct/ParserStruct.h"
+#include "finalmq/serializestruct/SerializerStruct.h"
+#include "finalmq/serializevariant/ParserVariant.h"
+#include "finalmq/serializevariant/SerializerVariant.h"
+#include "finalmq/variant/VariantValueList.h"
+#include "finalmq/variant/VariantValueStruct.h"
+#include "finalmq/variant/VariantValues.h"
+#include "testhl7.fmq.h"
+
+using namespace finalmq;
+
+// counts the heap allocations of the current thread
+static thread_local std::int64_t g_allocations = 0;
+
+void* operator new(size_t size)
+{
+    ++g_allocations;
+    void* p = malloc(size ? size : 1);
+    if (p == nullptr)
+    {
+        throw std::bad_alloc();
+    }
+    return p;
+}
+
+void operator delete(void* p) noexcept
+{
+    free(p);
+}
+
+void operator delete(void* p, size_t /*size*/) noexcept
+{
+    free(p);
+}
+
+namespace
+{
+enum class Format
+{
+    PROTO,
+    PROTO_CANONICAL,
+    JSON,
+    QT,
+    HL7,
+    VARIANT,
+    STRUCT,
+};
+
+// the encoded form of a message: a byte stream or a variant
+struct Encoded
+{
+    std::string data{};
+    Variant variant{};
+};
+
+struct Shape
+{
+    const char* name;
+    std::function<std::shared_ptr<StructBase>()> create;
+    std::function<std::shared_ptr<StructBase>()> createEmpty;
+    bool hl7;
+    bool nullStructs;
+};
+
+const int BLOCK_SIZE = 4096;
+
+template<class T>
+std::shared_ptr<StructBase> createEmpty()
+{
+    return std::make_shared<T>();
+}
+
+void encode(Format format, const StructBase& msg, const Shape& shape, Encoded& encoded)
+{
+    switch (format)
+    {
+        case Format::VARIANT:
+        {
+            SerializerVariant serializer(encoded.variant);
+            ParserStruct parser(serializer, msg);
+            parser.parseStruct();
+        }
+        break;
+        case Format::STRUCT:
+        {
+            std::shared_ptr<StructBase> copy = shape.createEmpty();
+            SerializerStruct serializer(*copy);
+            ParserStruct parser(serializer, msg);
+            parser.parseStruct();
+        }
+        break;
+        default:
+        {
+            ZeroCopyBuffer buffer;
+            if (format == Format::PROTO)
+            {
+                SerializerProto serializer(buffer, BLOCK_SIZE);
+                ParserStruct parser(serializer, msg);
+                parser.parseStruct();
+            }
+            else if (format == Format::PROTO_CANONICAL)
+            {
+                std::vector<ssize_t> structSizes;
+                SerializerProtoSize serializerSize(structSizes);
+                ParserStruct parserSize(serializerSize, msg);
+                parserSize.parseStruct();
+                SerializerProto serializer(buffer, BLOCK_SIZE, &structSizes);
+                ParserStruct parser(serializer, msg);
+                parser.parseStruct();
+            }
+            else if (format == Format::JSON)
+            {
+                SerializerJson serializer(buffer, BLOCK_SIZE);
+                ParserStruct parser(serializer, msg);
+                parser.parseStruct();
+            }
+            else if (format == Format::QT)
+            {
+                SerializerQt serializer(buffer, SerializerQt::Mode::NONE, BLOCK_SIZE);
+                ParserStruct parser(serializer, msg);
+                parser.parseStruct();
+            }
+            else
+            {
+                SerializerHl7 serializer(buffer, BLOCK_SIZE);
+                ParserStruct parser(serializer, msg);
+                parser.parseStruct();
+            }
+            encoded.data = buffer.getData();
+        }
+        break;
+    }
+}
+
+bool decode(Format format, const Encoded& encoded, StructBase& msg)
+{
+    SerializerStruct serializer(msg);
+    const std::string& typeName = msg.getStructInfo().getTypeName();
+    const char* data = encoded.data.data();
+    ssize_t size = encoded.data.size();
+    switch (format)
+    {
+        case Format::PROTO:
+        case Format::PROTO_CANONICAL:
+            return ParserProto(serializer, data, size).parseStruct(typeName);
+        case Format::JSON:
+            return ParserJson(serializer, data, size).parseStruct(typeName) != nullptr;
+        case Format::QT:
+            return ParserQt(serializer, data, size).parseStruct(typeName);
+        case Format::HL7:
+            return ParserHl7(serializer, data, size).parseStruct(typeName) != nullptr;
+        case Format::VARIANT:
+            return ParserVariant(serializer, encoded.variant).parseStruct(typeName);
+        default:
+            return false;
+    }
+}
+
+// Variants and structs have no byte stream, their throughput is related to the protobuf size of the message.
+ssize_t messageSize(Format format, const StructBase& msg, const Shape& shape, const Encoded& encoded)
+{
+    if (format == Format::VARIANT || format == Format::STRUCT)
+    {
+        Encoded proto;
+        encode(Format::PROTO, msg, shape, proto);
+        return proto.data.size();
+    }
+    return encoded.data.size();
+}
+
+void setCounters(benchmark::State& state, ssize_t size, std::int64_t allocations)
+{
+    state.SetItemsProcessed(state.iterations());
+    state.SetBytesProcessed(state.iterations() * size);
+    state.counters["allocs/msg"] = benchmark::Counter(static_cast<double>(allocations), benchmark::Counter::kAvgIterations);
+}
+
+void benchEncode(benchmark::State& state, Format format, const Shape& shape)
+{
+    std::shared_ptr<StructBase> msg = shape.create();
+    Encoded encoded;
+    encode(format, *msg, shape, encoded);
+    const ssize_t size = messageSize(format, *msg, shape, encoded);
+
+    std::int64_t allocations = g_allocations;
+    for (auto _ : state)
+    {
+        Encoded result;
+        encode(format, *msg, shape, result);
+        benchmark::DoNotOptimize(result);
+    }
+    allocations = g_allocations - allocations;
+    setCounters(state, size, allocations);
+}
+
+void benchDecode(benchmark::State& state, Format format, const Shape& shape)
+{
+    std::shared_ptr<StructBase> msg = shape.create();
+    Encoded encoded;
+    encode(format, *msg, shape, encoded);
+    const ssize_t size = messageSize(format, *msg, shape, encoded);
+
+    std::int64_t allocations = g_allocations;
+    for (auto _ : state)
+    {
+        std::shared_ptr<StructBase> result = shape.createEmpty();
+        if (!decode(format, encoded, *result))
+        {
+            state.SkipWithError("decode failed");
+            break;
+        }
+        benchmark::DoNotOptimize(result);
+    }
+    allocations = g_allocations - allocations;
+    setCounters(state, size, allocations);
+}
+
+////////////////////////////////////////////
+// message shapes
+
+std::shared_ptr<StructBase> createFlat()
+{
+    return std::make_shared<bench::Flat>(true, -123456, 123456, -1234567890123LL, 1234567890123ULL, 1.5f, -2.25, bench::Color::COLOR_GREEN, "flat message", 42);
+}
+
+std::shared_ptr<StructBase> createNested()
+{
+    static const int DEPTH = 32;
+    std::shared_ptr<bench::Node> root = std::make_shared<bench::Node>();
+    bench::Node* node = root.get();
+    for (int i = 0; i < DEPTH; ++i)
+    {
+        node->level = i;
+        node->name = "level " + std::to_string(i);
+        if (i < DEPTH - 1)
+        {
+            node->child = std::make_shared<bench::Node>();
+            node = node->child.get();
+        }
+    }
+    return root;
+}
+
+std::shared_ptr<StructBase> createArrays()
+{
+    static const int ENTRIES = 1000;
+    std::shared_ptr<bench::Arrays> msg = std::make_shared<bench::Arrays>();
+    for (int i = 0; i < ENTRIES; ++i)
+    {
+        msg->int32s.push_back(i * 1000);
+        msg->doubles.push_back(i * 0.5);
+        msg->strings.push_back("entry " + std::to_string(i));
+        msg->structs.push_back(*std::static_pointer_cast<bench::Flat>(createFlat()));
+    }
+    return msg;
+}
+
+std::shared_ptr<StructBase> createBlob()
+{
+    static const int SIZE = 256 * 1024;
+    std::shared_ptr<bench::Blob> msg = std::make_shared<bench::Blob>();
+    msg->text.reserve(SIZE);
+    msg->data.reserve(SIZE);
+    for (int i = 0; i < SIZE; ++i)
+    {
+        msg->text += static_cast<char>('a' + i % 26);
+        msg->data.push_back(static_cast<BytesElement>(i));
+    }
+    return msg;
+}
+
+std::shared_ptr<StructBase> createDynamic()
+{
+    static const int ENTRIES = 100;
+    VariantStruct root;
+    for (int i = 0; i < ENTRIES; ++i)
+    {
+        VariantStruct entry{{"id", i}, {"name", std::string("entry ") + std::to_string(i)}, {"ratio", i * 0.25}};
+        entry.emplace_back("values", VariantList{1, 2, 3, std::string("four")});
+        root.emplace_back("entry" + std::to_string(i), std::move(entry));
+    }
+    std::shared_ptr<bench::Dynamic> msg = std::make_shared<bench::Dynamic>();
+    msg->value = std::move(root);
+    return msg;
+}
+
+std::shared_ptr<StructBase> createHl7()
+{
+    static const int CONTAINERS = 20;
+    std::shared_ptr<testhl7::SSU_U03> msg = std::make_shared<testhl7::SSU_U03>();
+    msg->msh.fieldSeparator = "|";
+    msg->msh.encodingCharacters = "^~\\&";
+    msg->msh.messageType.messageCode = "SSU";
+    msg->msh.messageType.triggerEvent = "U03";
+    msg->msh.messageType.messageStructure = "SSU_U03";
+    msg->msh.countryCode = "de";
+    msg->sft.resize(3);
+    msg->sft[0].softwareBinaryId = "world";
+    msg->specimen_container.resize(CONTAINERS);
+    for (auto& container : msg->specimen_container)
+    {
+        container.sac.positionInTray.value1 = "hey";
+        container.sac.specimenSource = "hh";
+        container.sac.carrierIdentifier.entityIdentifier = "uu";
+        container.sac.carrierIdentifier.universalId = "bbb";
+        container.obx.resize(2);
+        container.specimen.resize(3);
+        container.specimen[0].spm.accessionId.resize(1);
+        container.specimen[0].spm.accessionId[0].idNumber = "ggg";
+        container.specimen[0].spm.containerCondition.alternateText = "tt";
+        container.specimen[0].obx.resize(5);
+    }
+    return msg;
+}
+
+const Shape SHAPES[] = {
+    {"Flat", createFlat, createEmpty<bench::Flat>, false, false},
+    {"Nested", createNested, createEmpty<bench::Node>, false, true},
+    {"Arrays", createArrays, createEmpty<bench::Arrays>, false, false},
+    {"Blob", createBlob, createEmpty<bench::Blob>, false, false},
+    {"Dynamic", createDynamic, createEmpty<bench::Dynamic>, false, false},
+    {"Hl7", createHl7, createEmpty<testhl7::SSU_U03>, true, true},
+};
+
+const std::pair<Format, const char*> FORMATS[] = {
+    {Format::PROTO, "Proto"},
+    {Format::PROTO_CANONICAL, "ProtoCanonical"},
+    {Format::JSON, "Json"},
+    {Format::QT, "Qt"},
+    {Format::HL7, "Hl7"},
+    {Format::VARIANT, "Variant"},
+    {Format::STRUCT, "Struct"},
+};
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    for (const auto& format : FORMATS)
+    {
+        for (const Shape& shape : SHAPES)
+        {
+            // HL7 can only express HL7 message structures
+            if (format.first == Format::HL7 && !shape.hl7)
+            {
+                continue;
+            }
+            std::string name = std::string(format.second) + "/" + shape.name;
+            benchmark::RegisterBenchmark(("Encode" + name).c_str(), benchEncode, format.first, shape);
+            // the struct copy has no separate decode step and
+            // the Qt stream has no representation of null structs, they cannot be decoded.
+            if (format.first != Format::STRUCT && !(format.first == Format::QT && shape.nullStructs))
+            {
+                benchmark::RegisterBenchmark(("Decode" + name).c_str(), benchDecode, format.first, shape);
+            }
+        }
+    }
+
+    benchmark::Initialize(&argc, argv);
+    if (benchmark::ReportUnrecognizedArguments(argc, argv))
+    {
+        return 1;
+    }
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+    return 0;
+}
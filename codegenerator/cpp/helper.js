@@ -188,6 +188,24 @@ module.exports = {
         }
     },
 
+    isPmr : function(stru)
+    {
+        return (stru.flags && stru.flags.indexOf('METASTRUCTFLAG_PMR') != -1);
+    },
+
+    fieldType : function(data, stru, field)
+    {
+        // the strings and arrays of a struct with METASTRUCTFLAG_PMR use the polymorphic allocator of the struct
+        var type = this.tid2type(data, field);
+        if (!this.isPmr(stru) || (field.tid == 'TYPE_STRUCT'))
+        {
+            return type;
+        }
+        return type.replace(/std::vector</g, 'std::pmr::vector<')
+                   .replace(/std::string/g, 'std::pmr::string')
+                   .replace(/finalmq::Bytes/g, 'std::pmr::vector<finalmq::BytesElement>');
+    },
+
     convertFlags : function(flagArray)
     {
         var flags = 'finalmq::METAFLAG_NONE'
@@ -255,6 +273,171 @@ module.exports = {
         return entries[0]
     },
 
+    isProtoDirect : function(stru)
+    {
+        // the visitor pipeline is needed for variants, json and for the index and abort features
+        for (var n = 0; n < stru.fields.length; n++)
+        {
+            var field = stru.fields[n];
+            if (field.tid == 'TYPE_VARIANT' || field.tid == 'TYPE_JSON')
+            {
+                return false;
+            }
+            if (field.flags && field.flags.indexOf('METAFLAG_INDEX') != -1)
+            {
+                return false;
+            }
+            if (field.attrs)
+            {
+                for (var i = 0; i < field.attrs.length; i++)
+                {
+                    if (field.attrs[i].startsWith('abortstruct'))
+                    {
+                        return false;
+                    }
+                }
+            }
+        }
+        return true;
+    },
+
+    protoSerializeField : function(field, id)
+    {
+        var name = this.avoidCppKeyWords(field.name);
+        var flags = this.convertFlags(field.flags);
+        switch (field.tid)
+        {
+            case 'TYPE_BOOL': return 'serializer.writeBool(' + id + ', ' + name + ');'
+            case 'TYPE_INT8':
+            case 'TYPE_INT16':
+            case 'TYPE_INT32': return 'serializer.writeInt32(' + id + ', ' + name + ', ' + flags + ');'
+            case 'TYPE_UINT8':
+            case 'TYPE_UINT16':
+            case 'TYPE_UINT32': return 'serializer.writeUInt32(' + id + ', ' + name + ', ' + flags + ');'
+            case 'TYPE_INT64': return 'serializer.writeInt64(' + id + ', ' + name + ', ' + flags + ');'
+            case 'TYPE_UINT64': return 'serializer.writeUInt64(' + id + ', ' + name + ', ' + flags + ');'
+            case 'TYPE_FLOAT': return 'serializer.writeFloat(' + id + ', ' + name + ');'
+            case 'TYPE_DOUBLE': return 'serializer.writeDouble(' + id + ', ' + name + ');'
+            case 'TYPE_STRING': return 'serializer.writeString(' + id + ', ' + name + ');'
+            case 'TYPE_BYTES': return 'serializer.writeBytes(' + id + ', ' + name + ');'
+            case 'TYPE_STRUCT':
+                if (this.isNullable(field))
+                {
+                    return 'serializer.writeStructPtr(' + id + ', ' + name + ');'
+                }
+                return 'serializer.writeStruct(' + id + ', ' + name + ');'
+            case 'TYPE_ENUM': return 'serializer.writeEnum(' + id + ', ' + name + ');'
+            case 'TYPE_ARRAY_BOOL': return 'serializer.writeArrayBool(' + id + ', ' + name + ');'
+            case 'TYPE_ARRAY_INT8':
+            case 'TYPE_ARRAY_INT16':
+            case 'TYPE_ARRAY_INT32': return 'serializer.writeArrayInt32(' + id + ', ' + name + ', ' + flags + ');'
+            case 'TYPE_ARRAY_UINT16':
+            case 'TYPE_ARRAY_UINT32': return 'serializer.writeArrayUInt32(' + id + ', ' + name + ', ' + flags + ');'
+            case 'TYPE_ARRAY_INT64': return 'serializer.writeArrayInt64(' + id + ', ' + name + ', ' + flags + ');'
+            case 'TYPE_ARRAY_UINT64': return 'serializer.writeArrayUInt64(' + id + ', ' + name + ', ' + flags + ');'
+            case 'TYPE_ARRAY_FLOAT': return 'serializer.writeArrayFloat(' + id + ', ' + name + ');'
+            case 'TYPE_ARRAY_DOUBLE': return 'serializer.writeArrayDouble(' + id + ', ' + name + ');'
+            case 'TYPE_ARRAY_STRING': return 'serializer.writeArrayString(' + id + ', ' + name + ');'
+            case 'TYPE_ARRAY_BYTES': return 'serializer.writeArrayBytes(' + id + ', ' + name + ');'
+            case 'TYPE_ARRAY_STRUCT': return 'serializer.writeArrayStruct(' + id + ', ' + name + ');'
+            case 'TYPE_ARRAY_ENUM': return 'serializer.writeArrayEnum(' + id + ', ' + name + ');'
+        }
+        return ''
+    },
+
+    protoParseField : function(field)
+    {
+        var name = this.avoidCppKeyWords(field.name);
+        var flags = this.convertFlags(field.flags);
+        switch (field.tid)
+        {
+            case 'TYPE_BOOL': return 'parser.readBool(' + name + ');'
+            case 'TYPE_INT8':
+            case 'TYPE_INT16':
+            case 'TYPE_INT32':
+            case 'TYPE_INT64': return 'parser.readInt(' + name + ', ' + flags + ');'
+            case 'TYPE_UINT8':
+            case 'TYPE_UINT16':
+            case 'TYPE_UINT32':
+            case 'TYPE_UINT64': return 'parser.readUInt(' + name + ');'
+            case 'TYPE_FLOAT': return 'parser.readFloat(' + name + ');'
+            case 'TYPE_DOUBLE': return 'parser.readDouble(' + name + ');'
+            case 'TYPE_STRING': return 'parser.readString(' + name + ');'
+            case 'TYPE_BYTES': return 'parser.readBytes(' + name + ');'
+            case 'TYPE_STRUCT':
+                if (this.isNullable(field))
+                {
+                    return 'parser.readStructPtr(' + name + ');'
+                }
+                return 'parser.readStruct(' + name + ');'
+            case 'TYPE_ENUM': return 'parser.readEnum(' + name + ');'
+            case 'TYPE_ARRAY_BOOL': return 'parser.readArrayBool(' + name + ');'
+            case 'TYPE_ARRAY_INT8':
+            case 'TYPE_ARRAY_INT16':
+            case 'TYPE_ARRAY_INT32':
+            case 'TYPE_ARRAY_INT64': return 'parser.readArrayInt(' + name + ', ' + flags + ');'
+            case 'TYPE_ARRAY_UINT16':
+            case 'TYPE_ARRAY_UINT32':
+            case 'TYPE_ARRAY_UINT64': return 'parser.readArrayUInt(' + name + ', ' + flags + ');'
+            case 'TYPE_ARRAY_FLOAT': return 'parser.readArrayFloat(' + name + ');'
+            case 'TYPE_ARRAY_DOUBLE': return 'parser.readArrayDouble(' + name + ');'
+            case 'TYPE_ARRAY_STRING': return 'parser.readArrayString(' + name + ');'
+            case 'TYPE_ARRAY_BYTES': return 'parser.readArrayBytes(' + name + ');'
+            case 'TYPE_ARRAY_STRUCT': return 'parser.readArrayStruct(' + name + ');'
+            case 'TYPE_ARRAY_ENUM': return 'parser.readArrayEnum(' + name + ');'
+        }
+        return 'parser.skip();'
+    },
+
+    protoViewType : function(data, field)
+    {
+        // arrays, variants and json are not supported by the views
+        switch (field.tid)
+        {
+            case 'TYPE_STRING':
+            case 'TYPE_BYTES': return 'std::string_view'
+            case 'TYPE_STRUCT': return this.typeWithNamespace(data, field.type, '::') + 'View'
+            case 'TYPE_BOOL':
+            case 'TYPE_INT8':
+            case 'TYPE_INT16':
+            case 'TYPE_INT32':
+            case 'TYPE_INT64':
+            case 'TYPE_UINT8':
+            case 'TYPE_UINT16':
+            case 'TYPE_UINT32':
+            case 'TYPE_UINT64':
+            case 'TYPE_FLOAT':
+            case 'TYPE_DOUBLE':
+            case 'TYPE_ENUM': return this.tid2type(data, field)
+        }
+        return null
+    },
+
+    protoViewGetField : function(data, field, id)
+    {
+        var type = this.protoViewType(data, field);
+        var flags = this.convertFlags(field.flags);
+        switch (field.tid)
+        {
+            case 'TYPE_BOOL': return 'm_view.getBool(' + id + ')'
+            case 'TYPE_INT8':
+            case 'TYPE_INT16':
+            case 'TYPE_INT32':
+            case 'TYPE_INT64': return 'm_view.getInt<' + type + '>(' + id + ', ' + flags + ')'
+            case 'TYPE_UINT8':
+            case 'TYPE_UINT16':
+            case 'TYPE_UINT32':
+            case 'TYPE_UINT64': return 'm_view.getUInt<' + type + '>(' + id + ')'
+            case 'TYPE_FLOAT': return 'm_view.getFloat(' + id + ')'
+            case 'TYPE_DOUBLE': return 'm_view.getDouble(' + id + ')'
+            case 'TYPE_STRING': return 'm_view.getString(' + id + ')'
+            case 'TYPE_BYTES': return 'm_view.getBytes(' + id + ')'
+            case 'TYPE_STRUCT': return type + '(m_view.getStruct(' + id + '))'
+            case 'TYPE_ENUM': return 'm_view.getEnum<' + type + '>(' + id + ')'
+        }
+        return ''
+    },
+
     avoidCppKeyWords: function (name)
     {
         if (name == 'namespace') {
@@ -97,6 +97,11 @@ private:
 
     }
 
+    virtual void writable(const IProtocolSessionPtr& session)
+    {
+
+    }
+
 
 };
 
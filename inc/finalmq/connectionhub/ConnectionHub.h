@@ -24,6 +24,9 @@
 
 #include "finalmq/protocolsession/ProtocolSessionContainer.h"
 
+#include <atomic>
+#include <unordered_set>
+
 namespace finalmq
 {
 struct IConnectionHub
@@ -49,6 +52,7 @@ class SYMBOLEXP ConnectionHub : public IConnectionHub, private IProtocolSessionC
 {
 public:
     ConnectionHub();
+    ~ConnectionHub();
 
 private:
     // IConnectionHub
@@ -72,14 +76,37 @@ private:
     virtual void received(const IProtocolSessionPtr& session, const IMessagePtr& message) override;
     virtual void socketConnected(const IProtocolSessionPtr& session) override;
     virtual void socketDisconnected(const IProtocolSessionPtr& session) override;
+    virtual void writable(const IProtocolSessionPtr& session) override;
+
+    /**
+     * @brief ForwardingSnapshot is an immutable view of the forwarding targets. It is replaced
+     * (copy on write) whenever the sessions or the forwarding filters change, so that received()
+     * can forward a message without locks and without copying the session list.
+     * The readers access it through an atomic raw pointer and announce themselves in
+     * m_snapshotReaders. A replaced snapshot is retired and deleted by a writer as soon as
+     * no reader is active anymore.
+     */
+    struct ForwardingSnapshot
+    {
+        std::vector<IProtocolSessionPtr> sessionsTo{};
+        std::unordered_set<std::int64_t> sessionIdsStopForwardingFromSession{};
+    };
+
+    void forward(const ForwardingSnapshot& snapshot, const IProtocolSessionPtr& session, const IMessagePtr& message);
+    void updateSnapshot(const IProtocolSessionPtr& sessionRemoved = nullptr);
+    void reclaimSnapshots();
 
     std::unique_ptr<IProtocolSessionContainer> m_protocolSessionContainer{};
-    std::vector<std::int64_t> m_sessionIdsStopForwardingFromSession{};
-    std::vector<std::int64_t> m_sessionIdsStopForwardingToSession{};
-    bool m_startMessageForwarding = false;
+    std::unordered_set<std::int64_t> m_sessionIdsStopForwardingFromSession{};
+    std::unordered_set<std::int64_t> m_sessionIdsStopForwardingToSession{};
+    std::atomic<const ForwardingSnapshot*> m_snapshot{nullptr};
+    std::atomic<int> m_snapshotReaders{0};
+    std::vector<std::unique_ptr<const ForwardingSnapshot>> m_snapshotsRetired{};
+    std::atomic<bool> m_snapshotsRetiredPending{false};
+    std::atomic<bool> m_startMessageForwarding{false};
     std::vector<std::pair<IProtocolSessionPtr, IMessagePtr>> m_messagesForForwarding{};
 
-    std::recursive_mutex m_mutex{};
+    std::mutex m_mutex{};
 };
 
 } // namespace finalmq
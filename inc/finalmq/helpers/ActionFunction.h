@@ -0,0 +1,201 @@
+//MIT License
+
+//Copyright (c) 2020 bexoft GmbH (mail@bexoft.de)
+
+//Permission is hereby granted, free of charge, to any person obtaining a copy
+//of this software and associated documentation files (the "Software"), to deal
+//in the Software without restriction, including without limitation the rights
+//to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//copies of the Software, and to permit persons to whom the Software is
+//furnished to do so, subject to the following conditions:
+
+//The above copyright notice and this permission notice shall be included in all
+//copies or substantial portions of the Software.
+
+//THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//SOFTWARE.
+
+
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace finalmq
+{
+/**
+ * @brief ActionFunction is a move-only callable for the executors. Callables up to BUFFER_SIZE bytes
+ * (e.g. a lambda that captures a weak_ptr and a shared_ptr) are stored inside the object, so no
+ * heap allocation is needed to pass an action. Bigger callables are stored on the heap.
+ */
+class ActionFunction
+{
+public:
+    static constexpr std::size_t BUFFER_SIZE = 48;
+
+    ActionFunction() noexcept = default;
+    ActionFunction(std::nullptr_t) noexcept
+    {
+    }
+
+    template<class F, class = typename std::enable_if<!std::is_same<typename std::decay<F>::type, ActionFunction>::value>::type>
+    ActionFunction(F&& func)
+    {
+        typedef typename std::decay<F>::type FuncType;
+        if (isNull(func))
+        {
+            return;
+        }
+        if (isInline<FuncType>())
+        {
+            new (&m_buffer) FuncType(std::forward<F>(func));
+            m_ops = &inlineOps<FuncType>;
+        }
+        else
+        {
+            *reinterpret_cast<FuncType**>(&m_buffer) = new FuncType(std::forward<F>(func));
+            m_ops = &heapOps<FuncType>;
+        }
+    }
+
+    ActionFunction(ActionFunction&& rhs) noexcept
+    {
+        moveFrom(rhs);
+    }
+
+    ActionFunction& operator=(ActionFunction&& rhs) noexcept
+    {
+        if (this != &rhs)
+        {
+            reset();
+            moveFrom(rhs);
+        }
+        return *this;
+    }
+
+    ActionFunction& operator=(std::nullptr_t) noexcept
+    {
+        reset();
+        return *this;
+    }
+
+    ~ActionFunction()
+    {
+        reset();
+    }
+
+    void operator()()
+    {
+        m_ops->invoke(&m_buffer);
+    }
+
+    explicit operator bool() const noexcept
+    {
+        return (m_ops != nullptr);
+    }
+
+    void reset() noexcept
+    {
+        if (m_ops)
+        {
+            m_ops->destroy(&m_buffer);
+            m_ops = nullptr;
+        }
+    }
+
+private:
+    ActionFunction(const ActionFunction&) = delete;
+    ActionFunction& operator=(const ActionFunction&) = delete;
+
+    struct Ops
+    {
+        void (*invoke)(void* buffer);
+        void (*move)(void* bufferDestination, void* bufferSource) noexcept;
+        void (*destroy)(void* buffer) noexcept;
+    };
+
+    typedef typename std::aligned_storage<BUFFER_SIZE, alignof(std::max_align_t)>::type Buffer;
+
+    template<class FuncType>
+    static constexpr bool isInline()
+    {
+        return (sizeof(FuncType) <= BUFFER_SIZE && alignof(FuncType) <= alignof(std::max_align_t) && std::is_nothrow_move_constructible<FuncType>::value);
+    }
+
+    template<class F>
+    static bool isNull(const F&)
+    {
+        return false;
+    }
+    template<class R>
+    static bool isNull(const std::function<R()>& func)
+    {
+        return !func;
+    }
+    template<class R>
+    static bool isNull(R (*func)())
+    {
+        return (func == nullptr);
+    }
+
+    template<class FuncType>
+    static void invokeInline(void* buffer)
+    {
+        (*static_cast<FuncType*>(buffer))();
+    }
+    template<class FuncType>
+    static void moveInline(void* bufferDestination, void* bufferSource) noexcept
+    {
+        FuncType* source = static_cast<FuncType*>(bufferSource);
+        new (bufferDestination) FuncType(std::move(*source));
+        source->~FuncType();
+    }
+    template<class FuncType>
+    static void destroyInline(void* buffer) noexcept
+    {
+        static_cast<FuncType*>(buffer)->~FuncType();
+    }
+
+    template<class FuncType>
+    static void invokeHeap(void* buffer)
+    {
+        (**static_cast<FuncType**>(buffer))();
+    }
+    static void moveHeap(void* bufferDestination, void* bufferSource) noexcept
+    {
+        *static_cast<void**>(bufferDestination) = *static_cast<void**>(bufferSource);
+    }
+    template<class FuncType>
+    static void destroyHeap(void* buffer) noexcept
+    {
+        delete *static_cast<FuncType**>(buffer);
+    }
+
+    template<class FuncType>
+    static constexpr Ops inlineOps{&invokeInline<FuncType>, &moveInline<FuncType>, &destroyInline<FuncType>};
+    template<class FuncType>
+    static constexpr Ops heapOps{&invokeHeap<FuncType>, &moveHeap, &destroyHeap<FuncType>};
+
+    void moveFrom(ActionFunction& rhs) noexcept
+    {
+        if (rhs.m_ops)
+        {
+            rhs.m_ops->move(&m_buffer, &rhs.m_buffer);
+            m_ops = rhs.m_ops;
+            rhs.m_ops = nullptr;
+        }
+    }
+
+    Buffer m_buffer;
+    const Ops* m_ops{nullptr};
+};
+
+} // namespace finalmq
@@ -22,9 +22,11 @@
 
 #pragma once
 
+#include <array>
 #include <atomic>
 #include <deque>
 #include <list>
+#include <mutex>
 #include <thread>
 #include <unordered_map>
 #include <unordered_set>
@@ -57,25 +59,44 @@ public:
 private:
     virtual bool runAvailableActions(const FuncIsAbort& funcIsAbort = nullptr) override;
     virtual bool runAvailableActionBatch(const FuncIsAbort& funcIsAbort = nullptr) override;
-    virtual void addAction(std::function<void()> func, std::int64_t instanceId = 0) override;
+    virtual void addAction(ActionFunction func, std::int64_t instanceId = 0) override;
 
     inline bool areRunnableActionsAvailable() const;
 
 private:
+    /**
+     * The entries are kept in a list of consecutive actions with the same instanceId. Released list nodes,
+     * their function vectors and the hash nodes of the instance IDs are reused, so that adding and
+     * running actions does not allocate memory in the steady state.
+     */
     struct ActionEntry
     {
-        ActionEntry(std::int64_t i, std::unique_ptr<std::function<void()>>&& f)
-            : instanceId(i)
-        {
-            funcs.emplace_back(std::move(f));
-        }
         std::int64_t instanceId{};
-        std::deque<std::unique_ptr<std::function<void()>>> funcs{};
+        std::vector<ActionFunction> funcs{};
+        size_t front{0};
     };
-    std::list<ActionEntry> m_actions{};
+    typedef std::list<ActionEntry> ActionList;
+    typedef std::unordered_map<std::int64_t, std::int32_t> StoredIds;
+    typedef std::unordered_set<std::int64_t> RunningIds;
+
+    static const size_t MAX_FREE_NODES = 256;
+    static const size_t MIN_COMPACT_SIZE = 64;
+
+    ActionEntry& createEntry(std::int64_t instanceId);
+    void releaseEntry(ActionList& list, ActionList::iterator it);
+    bool incrementStoredId(std::int64_t instanceId);
+    void decrementStoredId(std::int64_t instanceId, std::int32_t count);
+    void insertRunningId(std::int64_t instanceId);
+    void eraseRunningId(std::int64_t instanceId);
+    void clearIds();
+
+    ActionList m_actions{};
+    ActionList m_actionsFree{};
 
-    std::unordered_map<std::int64_t, std::int32_t> m_storedIds{};
-    std::unordered_set<std::int64_t> m_runningIds{};
+    StoredIds m_storedIds{};
+    RunningIds m_runningIds{};
+    std::vector<StoredIds::node_type> m_storedIdsFree{};
+    std::vector<RunningIds::node_type> m_runningIdsFree{};
     int m_zeroIdCounter = 0;
 };
 
@@ -85,10 +106,121 @@ public:
 private:
     virtual bool runAvailableActions(const FuncIsAbort& funcIsAbort = nullptr) override;
     virtual bool runAvailableActionBatch(const FuncIsAbort& funcIsAbort = nullptr) override;
-    virtual void addAction(std::function<void()> func, std::int64_t instanceId = 0) override;
+    virtual void addAction(ActionFunction func, std::int64_t instanceId = 0) override;
 
 private:
-    std::deque<std::function<void()>> m_actions{};
+    std::deque<ActionFunction> m_actions{};
+};
+
+/**
+ * @brief ExecutorWorkStealing keeps one work-stealing deque per worker thread (the threads that call run()).
+ * A worker pushes and pops at the bottom of its own deque without locks, idle workers steal from the top of
+ * the other deques. Actions that are added by other threads go through a lock-free bounded queue.
+ * Actions with the same instanceId (!= 0) are collected in a strand, which is scheduled as one task,
+ * so they are executed in order and never concurrently. The strands are stored in striped maps,
+ * therefore producers of different instances rarely meet at the same lock.
+ */
+class SYMBOLEXP ExecutorWorkStealing : public ExecutorBase
+{
+public:
+    ExecutorWorkStealing();
+    ~ExecutorWorkStealing();
+
+private:
+    ExecutorWorkStealing(const ExecutorWorkStealing&) = delete;
+    const ExecutorWorkStealing& operator=(const ExecutorWorkStealing&) = delete;
+
+    virtual void run() override;
+    virtual bool runAvailableActions(const FuncIsAbort& funcIsAbort = nullptr) override;
+    virtual bool runAvailableActionBatch(const FuncIsAbort& funcIsAbort = nullptr) override;
+    virtual void addAction(ActionFunction func, std::int64_t instanceId = 0) override;
+
+private:
+    struct Strand;
+    struct Task
+    {
+        ActionFunction func{};
+        Strand* strand{nullptr};
+    };
+
+    struct Strand
+    {
+        std::int64_t instanceId{};
+        std::vector<ActionFunction> funcs{};
+        Task task{};
+    };
+
+    struct alignas(64) StrandShard
+    {
+        std::mutex mutex{};
+        std::unordered_map<std::int64_t, Strand*> strands{};
+    };
+
+    class WorkerDeque
+    {
+    public:
+        WorkerDeque();
+        ~WorkerDeque();
+        void push(Task* task);
+        Task* pop();
+        Task* steal();
+
+    private:
+        struct Array
+        {
+            explicit Array(std::int64_t c);
+            std::int64_t capacity;
+            std::int64_t mask;
+            std::unique_ptr<std::atomic<Task*>[]> buffer;
+        };
+        Array* grow(Array* array, std::int64_t bottom, std::int64_t top);
+
+        alignas(64) std::atomic<std::int64_t> m_top{0};
+        alignas(64) std::atomic<std::int64_t> m_bottom{0};
+        std::atomic<Array*> m_array{nullptr};
+        std::vector<std::unique_ptr<Array>> m_arrays{};
+    };
+
+    class InjectionQueue
+    {
+    public:
+        InjectionQueue();
+        bool push(Task* task);
+        Task* pop();
+
+    private:
+        struct Cell
+        {
+            std::atomic<std::size_t> sequence{};
+            Task* task{nullptr};
+        };
+        static const std::size_t CAPACITY = 4096;
+        std::unique_ptr<Cell[]> m_cells{};
+        alignas(64) std::atomic<std::size_t> m_enqueuePos{0};
+        alignas(64) std::atomic<std::size_t> m_dequeuePos{0};
+    };
+
+    static const int MAX_WORKERS = 64;
+    static const int NUMBER_OF_SHARDS = 64;
+
+    WorkerDeque* getOwnDeque() const;
+    WorkerDeque* registerWorker();
+    void schedule(Task* task);
+    Task* takeTask(WorkerDeque* ownDeque);
+    void notifyWorkers(bool wasEmpty);
+    void runTask(Task* task, const FuncIsAbort& funcIsAbort);
+    void runStrand(Strand* strand, const FuncIsAbort& funcIsAbort);
+    StrandShard& getShard(std::int64_t instanceId);
+
+    std::array<std::atomic<WorkerDeque*>, MAX_WORKERS> m_workers{};
+    std::atomic<int> m_numberOfWorkers{0};
+    std::atomic<std::uint32_t> m_stealStart{0};
+    InjectionQueue m_injection{};
+    std::deque<Task*> m_overflow{};
+    std::atomic<int> m_overflowSize{0};
+    std::array<StrandShard, NUMBER_OF_SHARDS> m_shards{};
+    alignas(64) std::atomic<std::int64_t> m_pending{0};
+    alignas(64) std::atomic<int> m_sleeping{0};
 };
 
 class SYMBOLEXP ExecutorWorkerBase : public IExecutorWorker
@@ -98,7 +230,7 @@ public:
     virtual ~ExecutorWorkerBase();
 
     virtual IExecutorPtr getExecutor() const override;
-    virtual void addAction(std::function<void()> func, std::int64_t instanceId = 0) override;
+    virtual void addAction(ActionFunction func, std::int64_t instanceId = 0) override;
     virtual void terminate() override;
     virtual bool isTerminating() const override;
     virtual void join() override;
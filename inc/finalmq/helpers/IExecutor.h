@@ -25,6 +25,8 @@
 #include <memory>
 #include <functional>
 
+#include "finalmq/helpers/ActionFunction.h"
+
 
 namespace finalmq {
 
@@ -37,7 +39,7 @@ struct IExecutor
     virtual void registerActionNotification(std::function<void()> func) = 0;
     virtual bool runAvailableActions(const FuncIsAbort& funcIsAbort = nullptr) = 0;
     virtual bool runAvailableActionBatch(const FuncIsAbort& funcIsAbort = nullptr) = 0;
-    virtual void addAction(std::function<void()> func, std::int64_t instanceId = 0) = 0;
+    virtual void addAction(ActionFunction func, std::int64_t instanceId = 0) = 0;
     virtual void run() = 0;
     virtual void terminate() = 0;
     virtual bool isTerminating() const = 0;
@@ -50,7 +52,7 @@ struct IExecutorWorker
 {
     virtual ~IExecutorWorker() {}
     virtual IExecutorPtr getExecutor() const = 0;
-    virtual void addAction(std::function<void()> func, std::int64_t instanceId = 0) = 0;
+    virtual void addAction(ActionFunction func, std::int64_t instanceId = 0) = 0;
     virtual void terminate() = 0;
     virtual bool isTerminating() const = 0;
     virtual void join() = 0;
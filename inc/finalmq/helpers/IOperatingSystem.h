@@ -26,6 +26,7 @@
 
 
 struct stat;
+struct iovec;
 
 namespace finalmq {
 
@@ -50,6 +51,8 @@ namespace finalmq {
         virtual int write(int fd, const char* buffer, int len) = 0;
         virtual int read(int fd, char* buffer, int len) = 0;
         virtual int send(SOCKET fd, const char* buffer, int len, int flags) = 0;
+        virtual int sendv(SOCKET fd, const struct iovec* iov, int iovcnt, int flags) = 0;
+        virtual int sendfile(SOCKET fd, int fdFile, off_t offset, int len) = 0;
         virtual int recv(SOCKET fd, char* buffer, int len, int flags) = 0;
         virtual int getLastError() = 0;
         virtual int select(int nfds, fd_set* readfds, fd_set* writefds, fd_set* exceptfds, struct timeval* timeout) = 0;
@@ -57,6 +60,7 @@ namespace finalmq {
         virtual int epoll_create1(int flags) = 0;
         virtual int epoll_ctl(int epfd, int op, int fd, struct epoll_event* event) = 0;
         virtual int epoll_pwait(int epfd, struct epoll_event* events, int maxevents, int timeout, const sigset_t* sigmask) = 0;
+        virtual int eventfd(unsigned int initval, int flags) = 0;
 #endif
         virtual int makeSocketPair(SocketDescriptorPtr& socket1, SocketDescriptorPtr& socket2) = 0;
         virtual int ioctlInt(SOCKET fd, unsigned long int request, int* value) = 0;
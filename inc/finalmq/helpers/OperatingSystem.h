@@ -33,6 +33,11 @@
 #define SOCKETERROR(err)	WSA##err
 typedef	int					socklen_t;
 typedef sockaddr            t_sockaddr;
+struct iovec
+{
+    void*   iov_base;
+    size_t  iov_len;
+};
 
 #else
 
@@ -40,6 +45,7 @@ typedef sockaddr            t_sockaddr;
 #include <netinet/in.h>
 #include <netdb.h>
 #include <sys/ioctl.h>
+#include <sys/uio.h>
 #include <sys/un.h>
 
 #ifdef __QNX__
@@ -49,6 +55,7 @@ typedef sockaddr            t_sockaddr;
 #include <sys/select.h>
 #else
 #include <sys/epoll.h>
+#include <sys/eventfd.h>
 #endif
 
 #define SOCKETERROR(err)	err
@@ -85,6 +92,8 @@ namespace finalmq
         virtual int write(int fd, const char* buffer, int len) override;
         virtual int read(int fd, char* buffer, int len) override;
         virtual int send(SOCKET fd, const char* buffer, int len, int flags) override;
+        virtual int sendv(SOCKET fd, const struct iovec* iov, int iovcnt, int flags) override;
+        virtual int sendfile(SOCKET fd, int fdFile, off_t offset, int len) override;
         virtual int recv(SOCKET fd, char* buffer, int len, int flags) override;
         virtual int getLastError() override;
         virtual int select(int nfds, fd_set* readfds, fd_set* writefds, fd_set* exceptfds, struct timeval* timeout) override;
@@ -92,6 +101,7 @@ namespace finalmq
         virtual int epoll_create1(int flags) override;
         virtual int epoll_ctl(int epfd, int op, int fd, struct epoll_event* event) override;
         virtual int epoll_pwait(int epfd, struct epoll_event* events, int maxevents, int timeout, const sigset_t* sigmask) override;
+        virtual int eventfd(unsigned int initval, int flags) override;
 #endif
         virtual int makeSocketPair(SocketDescriptorPtr& socket1, SocketDescriptorPtr& socket2) override;
         virtual int ioctlInt(SOCKET fd, unsigned long int request, int* value) override;
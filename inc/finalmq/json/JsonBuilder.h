@@ -64,6 +64,8 @@ private:
     void resizeBuffer();
     void correctComma();
     void escapeString(const char* str, ssize_t size);
+    void writeString(const char* str, ssize_t size, char terminator);
+    void writeChunked(const char* str, ssize_t size);
 
     IZeroCopyBuffer& m_zeroCopybuffer;
     ssize_t m_maxBlockSize = 512;
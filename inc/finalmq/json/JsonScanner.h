@@ -0,0 +1,314 @@
+//MIT License
+
+//Copyright (c) 2020 bexoft GmbH (mail@bexoft.de)
+
+//Permission is hereby granted, free of charge, to any person obtaining a copy
+//of this software and associated documentation files (the "Software"), to deal
+//in the Software without restriction, including without limitation the rights
+//to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//copies of the Software, and to permit persons to whom the Software is
+//furnished to do so, subject to the following conditions:
+
+//The above copyright notice and this permission notice shall be included in all
+//copies or substantial portions of the Software.
+
+//THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//SOFTWARE.
+
+
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define FINALMQ_JSONSCANNER_AVX2
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define FINALMQ_JSONSCANNER_SSE2
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#include <arm_neon.h>
+#define FINALMQ_JSONSCANNER_NEON
+#endif
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+namespace finalmq
+{
+/**
+ * @brief JsonScanner finds the characters of interest in a JSON text block by block
+ * (AVX2: 32 bytes, SSE2/NEON: 16 bytes, otherwise 8 bytes with plain 64 bit arithmetic).
+ * All functions scan the range [str, end) and return end if nothing was found (or str, if str >= end).
+ */
+class JsonScanner
+{
+public:
+    /**
+     * @brief findQuoteOrEscape returns the first '"', '\\' or '\0'.
+     */
+    static inline const char* findQuoteOrEscape(const char* str, const char* end);
+
+    /**
+     * @brief findEscapeNeeded returns the first character that JsonBuilder escapes inside a JSON string:
+     * '"', '\\', a control character (< 0x20) or a non ASCII character (>= 0x80, written as \\u escape).
+     */
+    static inline const char* findEscapeNeeded(const char* str, const char* end);
+
+    /**
+     * @brief skipWhiteSpace returns the first character that is not ' ', '\t', '\n' or '\r'.
+     */
+    static inline const char* skipWhiteSpace(const char* str, const char* end);
+
+private:
+    static inline bool isWhiteSpace(char c)
+    {
+        return (c == ' ' || c == '\t' || c == '\n' || c == '\r');
+    }
+
+    static inline int countTrailingZeros(std::uint32_t mask)
+    {
+#if defined(_MSC_VER)
+        unsigned long index = 0;
+        _BitScanForward(&index, mask);
+        return static_cast<int>(index);
+#else
+        return __builtin_ctz(mask);
+#endif
+    }
+
+#if !defined(FINALMQ_JSONSCANNER_AVX2) && !defined(FINALMQ_JSONSCANNER_SSE2) && !defined(FINALMQ_JSONSCANNER_NEON)
+    static constexpr std::uint64_t ONES = 0x0101010101010101ull;
+    static constexpr std::uint64_t HIGHS = 0x8080808080808080ull;
+
+    static inline std::uint64_t load64(const char* str)
+    {
+        std::uint64_t v;
+        memcpy(&v, str, sizeof(v));
+        return v;
+    }
+    // high bit set in every byte that is 0
+    static inline std::uint64_t hasZero(std::uint64_t v)
+    {
+        return (v - ONES) & ~v & HIGHS;
+    }
+    static inline std::uint64_t hasByte(std::uint64_t v, char c)
+    {
+        return hasZero(v ^ (ONES * static_cast<unsigned char>(c)));
+    }
+    // high bit set in every byte that is < n (n <= 128)
+    static inline std::uint64_t hasLess(std::uint64_t v, unsigned char n)
+    {
+        return (v - ONES * n) & ~v & HIGHS;
+    }
+#endif
+};
+
+const char* JsonScanner::findQuoteOrEscape(const char* str, const char* end)
+{
+#if defined(FINALMQ_JSONSCANNER_AVX2)
+    const __m256i quote = _mm256_set1_epi8('\"');
+    const __m256i backslash = _mm256_set1_epi8('\\');
+    const __m256i zero = _mm256_setzero_si256();
+    while (end - str >= 32)
+    {
+        const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(str));
+        const __m256i m = _mm256_or_si256(_mm256_or_si256(_mm256_cmpeq_epi8(v, quote), _mm256_cmpeq_epi8(v, backslash)), _mm256_cmpeq_epi8(v, zero));
+        const std::uint32_t mask = static_cast<std::uint32_t>(_mm256_movemask_epi8(m));
+        if (mask != 0)
+        {
+            return str + countTrailingZeros(mask);
+        }
+        str += 32;
+    }
+#elif defined(FINALMQ_JSONSCANNER_SSE2)
+    const __m128i quote = _mm_set1_epi8('\"');
+    const __m128i backslash = _mm_set1_epi8('\\');
+    const __m128i zero = _mm_setzero_si128();
+    while (end - str >= 16)
+    {
+        const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(str));
+        const __m128i m = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(v, quote), _mm_cmpeq_epi8(v, backslash)), _mm_cmpeq_epi8(v, zero));
+        const std::uint32_t mask = static_cast<std::uint32_t>(_mm_movemask_epi8(m));
+        if (mask != 0)
+        {
+            return str + countTrailingZeros(mask);
+        }
+        str += 16;
+    }
+#elif defined(FINALMQ_JSONSCANNER_NEON)
+    const uint8x16_t quote = vdupq_n_u8('\"');
+    const uint8x16_t backslash = vdupq_n_u8('\\');
+    const uint8x16_t zero = vdupq_n_u8(0);
+    while (end - str >= 16)
+    {
+        const uint8x16_t v = vld1q_u8(reinterpret_cast<const std::uint8_t*>(str));
+        const uint8x16_t m = vorrq_u8(vorrq_u8(vceqq_u8(v, quote), vceqq_u8(v, backslash)), vceqq_u8(v, zero));
+        if (vmaxvq_u8(m) != 0)
+        {
+            break;
+        }
+        str += 16;
+    }
+#else
+    while (end - str >= 8)
+    {
+        const std::uint64_t v = load64(str);
+        if ((hasByte(v, '\"') | hasByte(v, '\\') | hasZero(v)) != 0)
+        {
+            break;
+        }
+        str += 8;
+    }
+#endif
+    for (; str < end; ++str)
+    {
+        const char c = *str;
+        if (c == '\"' || c == '\\' || c == 0)
+        {
+            return str;
+        }
+    }
+    return str;
+}
+
+const char* JsonScanner::findEscapeNeeded(const char* str, const char* end)
+{
+#if defined(FINALMQ_JSONSCANNER_AVX2)
+    const __m256i quote = _mm256_set1_epi8('\"');
+    const __m256i backslash = _mm256_set1_epi8('\\');
+    const __m256i control = _mm256_set1_epi8(0x1f);
+    while (end - str >= 32)
+    {
+        const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(str));
+        // v <= 0x1f (unsigned): min(v, 0x1f) == v
+        const __m256i isControl = _mm256_cmpeq_epi8(_mm256_min_epu8(v, control), v);
+        const __m256i m = _mm256_or_si256(_mm256_or_si256(_mm256_cmpeq_epi8(v, quote), _mm256_cmpeq_epi8(v, backslash)), isControl);
+        // the sign bit of v marks non ASCII characters
+        const std::uint32_t mask = static_cast<std::uint32_t>(_mm256_movemask_epi8(m) | _mm256_movemask_epi8(v));
+        if (mask != 0)
+        {
+            return str + countTrailingZeros(mask);
+        }
+        str += 32;
+    }
+#elif defined(FINALMQ_JSONSCANNER_SSE2)
+    const __m128i quote = _mm_set1_epi8('\"');
+    const __m128i backslash = _mm_set1_epi8('\\');
+    const __m128i control = _mm_set1_epi8(0x1f);
+    while (end - str >= 16)
+    {
+        const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(str));
+        // v <= 0x1f (unsigned): min(v, 0x1f) == v
+        const __m128i isControl = _mm_cmpeq_epi8(_mm_min_epu8(v, control), v);
+        const __m128i m = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(v, quote), _mm_cmpeq_epi8(v, backslash)), isControl);
+        // the sign bit of v marks non ASCII characters
+        const std::uint32_t mask = static_cast<std::uint32_t>(_mm_movemask_epi8(m) | _mm_movemask_epi8(v));
+        if (mask != 0)
+        {
+            return str + countTrailingZeros(mask);
+        }
+        str += 16;
+    }
+#elif defined(FINALMQ_JSONSCANNER_NEON)
+    const uint8x16_t quote = vdupq_n_u8('\"');
+    const uint8x16_t backslash = vdupq_n_u8('\\');
+    const uint8x16_t control = vdupq_n_u8(0x20);
+    const uint8x16_t ascii = vdupq_n_u8(0x7f);
+    while (end - str >= 16)
+    {
+        const uint8x16_t v = vld1q_u8(reinterpret_cast<const std::uint8_t*>(str));
+        const uint8x16_t m = vorrq_u8(vorrq_u8(vceqq_u8(v, quote), vceqq_u8(v, backslash)), vorrq_u8(vcltq_u8(v, control), vcgtq_u8(v, ascii)));
+        if (vmaxvq_u8(m) != 0)
+        {
+            break;
+        }
+        str += 16;
+    }
+#else
+    while (end - str >= 8)
+    {
+        const std::uint64_t v = load64(str);
+        if ((hasByte(v, '\"') | hasByte(v, '\\') | hasLess(v, 0x20) | (v & HIGHS)) != 0)
+        {
+            break;
+        }
+        str += 8;
+    }
+#endif
+    for (; str < end; ++str)
+    {
+        const unsigned char c = static_cast<unsigned char>(*str);
+        if (c == '\"' || c == '\\' || c < 0x20 || c >= 0x80)
+        {
+            return str;
+        }
+    }
+    return str;
+}
+
+const char* JsonScanner::skipWhiteSpace(const char* str, const char* end)
+{
+    // most of the time there is no or only one white space
+    if (str >= end || !isWhiteSpace(*str))
+    {
+        return str;
+    }
+    ++str;
+    if (str >= end || !isWhiteSpace(*str))
+    {
+        return str;
+    }
+#if defined(FINALMQ_JSONSCANNER_AVX2)
+    const __m256i space = _mm256_set1_epi8(' ');
+    const __m256i tab = _mm256_set1_epi8('\t');
+    const __m256i newline = _mm256_set1_epi8('\n');
+    const __m256i carriageReturn = _mm256_set1_epi8('\r');
+    while (end - str >= 32)
+    {
+        const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(str));
+        const __m256i m = _mm256_or_si256(_mm256_or_si256(_mm256_cmpeq_epi8(v, space), _mm256_cmpeq_epi8(v, tab)),
+                                          _mm256_or_si256(_mm256_cmpeq_epi8(v, newline), _mm256_cmpeq_epi8(v, carriageReturn)));
+        const std::uint32_t mask = ~static_cast<std::uint32_t>(_mm256_movemask_epi8(m));
+        if (mask != 0)
+        {
+            return str + countTrailingZeros(mask);
+        }
+        str += 32;
+    }
+#elif defined(FINALMQ_JSONSCANNER_SSE2)
+    const __m128i space = _mm_set1_epi8(' ');
+    const __m128i tab = _mm_set1_epi8('\t');
+    const __m128i newline = _mm_set1_epi8('\n');
+    const __m128i carriageReturn = _mm_set1_epi8('\r');
+    while (end - str >= 16)
+    {
+        const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(str));
+        const __m128i m = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(v, space), _mm_cmpeq_epi8(v, tab)),
+                                       _mm_or_si128(_mm_cmpeq_epi8(v, newline), _mm_cmpeq_epi8(v, carriageReturn)));
+        const std::uint32_t mask = static_cast<std::uint32_t>(_mm_movemask_epi8(m)) ^ 0xffff;
+        if (mask != 0)
+        {
+            return str + countTrailingZeros(mask);
+        }
+        str += 16;
+    }
+#endif
+    for (; str < end; ++str)
+    {
+        if (!isWhiteSpace(*str))
+        {
+            return str;
+        }
+    }
+    return str;
+}
+
+} // namespace finalmq
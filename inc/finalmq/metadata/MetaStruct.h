@@ -24,6 +24,7 @@
 
 #include <list>
 #include <memory>
+#include <string_view>
 #include <unordered_map>
 #include <vector>
 
@@ -37,6 +38,7 @@ enum MetaStructFlags : std::int32_t
     METASTRUCTFLAG_NONE = 0,
     METASTRUCTFLAG_HL7_SEGMENT = 1,
     METASTRUCTFLAG_CHOICE = 2,
+    METASTRUCTFLAG_PMR = 4,
 };
 
 class SYMBOLEXP MetaStruct
@@ -53,7 +55,11 @@ public:
     const std::unordered_map<std::string, std::string>& getProperties() const;
 
     const MetaField* getFieldByIndex(ssize_t index) const;
-    const MetaField* getFieldByName(const std::string& name) const;
+    /**
+     * @brief getFieldByName looks up a field by its name. The lookup does not allocate memory,
+     * so parsers can pass the key directly from their input buffer.
+     */
+    const MetaField* getFieldByName(std::string_view name) const;
 
     void addField(const MetaField& field);
 
@@ -83,6 +89,13 @@ public:
     }
 
 private:
+    struct NameEntry
+    {
+        std::string_view name{};
+        const MetaField* field{nullptr};
+    };
+
+    static bool lessName(const NameEntry& entry, std::string_view name);
     static std::unordered_map<std::string, std::string> generateProperties(const std::vector<std::string>& attrs);
 
     const std::string m_typeName{};
@@ -92,7 +105,7 @@ private:
     const int m_flags{};
     const std::vector<std::string> m_attrs{};
     const std::unordered_map<std::string, std::string> m_properties{};
-    std::unordered_map<std::string, std::shared_ptr<const MetaField>> m_name2Field{};
+    std::vector<NameEntry> m_nameIndex{};   // sorted by name size, then by name
     const std::string EMPTY_STRING{};
 };
 
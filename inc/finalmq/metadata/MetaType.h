@@ -23,6 +23,7 @@
 #pragma once
 
 #include <cstdint>
+#include <memory_resource>
 #include <string>
 #include <vector>
 
@@ -393,4 +394,30 @@ public:
     static const int TypeId = MetaTypeId::TYPE_ARRAY_BYTES;
 };
 
+// the fields of structs with METASTRUCTFLAG_PMR
+template <>
+class MetaTypeInfo<std::pmr::string>
+{
+public:
+    static const int TypeId = MetaTypeId::TYPE_STRING;
+};
+template <class T>
+class MetaTypeInfo<std::pmr::vector<T>>
+{
+public:
+    static const int TypeId = MetaTypeInfo<std::vector<T>>::TypeId;
+};
+template <>
+class MetaTypeInfo<std::pmr::vector<std::pmr::string>>
+{
+public:
+    static const int TypeId = MetaTypeId::TYPE_ARRAY_STRING;
+};
+template <>
+class MetaTypeInfo<std::pmr::vector<std::pmr::vector<BytesElement>>>
+{
+public:
+    static const int TypeId = MetaTypeId::TYPE_ARRAY_BYTES;
+};
+
 }   // namespace finalmq
@@ -22,10 +22,12 @@
 
 #pragma once
 
+#include <memory>
 #include <vector>
 
 #include <assert.h>
 
+#include "finalmq/helpers/OperatingSystem.h"
 #include "finalmq/helpers/SocketDescriptor.h"
 
 namespace finalmq
@@ -38,13 +40,11 @@ struct DescriptorInfo
         readable = false;
         writable = false;
         disconnected = false;
-        bytesToRead = 0;
     }
     SOCKET sd = INVALID_SOCKET;
     bool readable = false;
     bool writable = false;
     bool disconnected = false;
-    std::int32_t bytesToRead = 0;
 };
 
 class DescriptorInfos
@@ -85,12 +85,29 @@ private:
     std::vector<DescriptorInfo> m_descriptorInfos{};
 };
 
+enum class CompletionType
+{
+    COMPLETION_RECEIVE,
+    COMPLETION_SEND,
+    COMPLETION_ACCEPT,
+};
+
+struct CompletionInfo
+{
+    SOCKET sd = INVALID_SOCKET;
+    CompletionType type = CompletionType::COMPLETION_RECEIVE;
+    int result = 0;               // received or sent bytes, the accepted descriptor or -errno
+    const char* buffer = nullptr; // received bytes or the address of the accepted peer, valid till the next wait
+    int size = 0;                 // size of buffer
+};
+
 struct PollerResult
 {
     bool error = false;
     bool timeout = false;
     std::uint32_t releaseWait = 0;
     DescriptorInfos descriptorInfos;
+    std::vector<CompletionInfo> completions;
 
     void clear()
     {
@@ -98,6 +115,7 @@ struct PollerResult
         timeout = false;
         releaseWait = 0;
         descriptorInfos.clear();
+        completions.clear();
     }
     PollerResult() = default;
 
@@ -123,4 +141,33 @@ struct IPoller
 
 typedef std::shared_ptr<IPoller> IPollerPtr;
 
+/**
+ * @brief IPollerCompletion is implemented by pollers that can execute the I/O of a socket themselves.
+ * The operations are submitted together with the wait, and their results are returned as completions
+ * in PollerResult::completions instead of readiness events.
+ */
+struct IPollerCompletion
+{
+    virtual ~IPollerCompletion()
+    {}
+    /**
+     * @brief enableReceive replaces the read events of an added socket by receive completions.
+     * The poller receives into its own buffer of the socket and receives again at the next wait.
+     * A result <= 0 means that the connection was closed, the poller does not receive anymore.
+     */
+    virtual void enableReceive(const SocketDescriptorPtr& fd) = 0;
+    /**
+     * @brief enableAccept replaces the read events of an added listening socket by accept completions.
+     * The result is the accepted non-blocking descriptor, which is owned by the receiver of the completion.
+     */
+    virtual void enableAccept(const SocketDescriptorPtr& fd) = 0;
+    /**
+     * @brief submitSend sends the buffers with one operation. Only one send of a socket can be pending.
+     * @param buffers the buffers to send. The memory they point to must stay valid till the completion.
+     * @param keepalive is released after the completion (also if the socket was removed meanwhile).
+     * @return false, if the socket is not added or a send is already pending. Then nothing was submitted.
+     */
+    virtual bool submitSend(const SocketDescriptorPtr& fd, std::vector<struct iovec>&& buffers, std::shared_ptr<const void>&& keepalive) = 0;
+};
+
 } // namespace finalmq
@@ -0,0 +1,60 @@
+//MIT License
+
+//Copyright (c) 2020 bexoft GmbH (mail@bexoft.de)
+
+//Permission is hereby granted, free of charge, to any person obtaining a copy
+//of this software and associated documentation files (the "Software"), to deal
+//in the Software without restriction, including without limitation the rights
+//to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//copies of the Software, and to permit persons to whom the Software is
+//furnished to do so, subject to the following conditions:
+
+//The above copyright notice and this permission notice shall be included in all
+//copies or substantial portions of the Software.
+
+//THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//SOFTWARE.
+
+
+#pragma once
+
+#include <memory>
+
+#include "finalmq/helpers/FmqDefines.h"
+#include "finalmq/poller/Poller.h"
+
+namespace finalmq
+{
+enum class PollerType
+{
+    POLLER_DEFAULT, ///< epoll on linux, select on windows and QNX
+    POLLER_EPOLL,
+    POLLER_SELECT,
+    POLLER_URING,   ///< io_uring, falls back to POLLER_DEFAULT if the kernel does not support it
+};
+
+class SYMBOLEXP PollerFactory
+{
+public:
+    /**
+     * @brief createPoller creates a poller of the given type. If the type is not supported
+     * on this platform, the default poller of the platform is created.
+     * @param pollerType the poller type. POLLER_DEFAULT uses the type that was set with setDefaultPollerType().
+     */
+    static std::shared_ptr<IPoller> createPoller(PollerType pollerType = PollerType::POLLER_DEFAULT);
+
+    /**
+     * @brief setDefaultPollerType sets the poller type that is used by createPoller() for POLLER_DEFAULT.
+     * This is the poller type that is used by the StreamConnectionContainer.
+     * The environment variable FINALMQ_POLLER (epoll, select, uring) defines the initial value.
+     */
+    static void setDefaultPollerType(PollerType pollerType);
+    static PollerType getDefaultPollerType();
+};
+
+} // namespace finalmq
@@ -64,8 +64,7 @@ private:
     void collectSockets(int res);
     void releaseWaitInternal(char info);
 
-    SocketDescriptorPtr m_controlSocketRead{};
-    SocketDescriptorPtr m_controlSocketWrite{};
+    SocketDescriptorPtr m_controlEvent{};
 
     std::unordered_map<SocketDescriptorPtr, int> m_socketDescriptors{};
 
@@ -73,6 +72,8 @@ private:
     int m_fdEpoll{-1};
     std::atomic_flag m_socketDescriptorsStable{ATOMIC_FLAG_INIT};
     std::atomic_uint32_t m_releaseFlags{};
+    std::atomic_bool m_sleeping{false};
+    std::atomic_bool m_wakeupSignaled{false};
     std::array<epoll_event, 32> m_events{};
 
     std::vector<SocketDescriptorPtr> m_socketDescriptorsConstForEpoll{};
@@ -0,0 +1,189 @@
+//MIT License
+
+//Copyright (c) 2020 bexoft GmbH (mail@bexoft.de)
+
+//Permission is hereby granted, free of charge, to any person obtaining a copy
+//of this software and associated documentation files (the "Software"), to deal
+//in the Software without restriction, including without limitation the rights
+//to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//copies of the Software, and to permit persons to whom the Software is
+//furnished to do so, subject to the following conditions:
+
+//The above copyright notice and this permission notice shall be included in all
+//copies or substantial portions of the Software.
+
+//THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//SOFTWARE.
+
+#pragma once
+
+#if defined(__linux__) && !defined(__QNX__) && defined(__has_include)
+#if __has_include(<linux/io_uring.h>)
+#define FINALMQ_HAS_URING
+#endif
+#endif
+
+#ifdef FINALMQ_HAS_URING
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include <linux/io_uring.h>
+
+#include "Poller.h"
+
+namespace finalmq
+{
+/**
+ * @brief PollerImplUring is a poller that uses io_uring poll requests instead of epoll.
+ * All changes of the poll masks that happen inside the poller thread are collected in the
+ * submission queue and submitted together with the wait for completions (one system call).
+ * Changes from other threads are submitted immediately. The polls are one-shot and are
+ * re-armed at the next wait, so the readiness is always evaluated after the events were handled.
+ * A pending poll holds a reference to its socket. Therefore, a removed socket is kept open until the
+ * completion of its cancelled poll arrived, so that the close releases the socket (e.g. its listening port).
+ *
+ * As IPollerCompletion, the poller also receives, sends and accepts with io_uring operations. A socket
+ * that receives with completions gets its own buffer, which starts small and grows with the received
+ * bytes. The operations of the poller thread are submitted together with the wait, so that the data of
+ * many connections is transferred without any additional system call.
+ */
+class SYMBOLEXP PollerImplUring : public IPoller, public IPollerCompletion
+{
+public:
+    PollerImplUring();
+    ~PollerImplUring();
+
+    /**
+     * @brief isAvailable checks, if the kernel supports the io_uring features that are needed by this poller.
+     */
+    static bool isAvailable();
+
+private:
+    PollerImplUring(const PollerImplUring&) = delete;
+    const PollerImplUring& operator=(const PollerImplUring&) = delete;
+    PollerImplUring(const PollerImplUring&&) = delete;
+    const PollerImplUring& operator=(PollerImplUring&&) = delete;
+
+    virtual void init() override;
+    virtual void addSocket(const SocketDescriptorPtr& fd) override;
+    virtual void addSocketEnableRead(const SocketDescriptorPtr& fd) override;
+    virtual void removeSocket(const SocketDescriptorPtr& fd) override;
+    virtual void enableRead(const SocketDescriptorPtr& fd) override;
+    virtual void disableRead(const SocketDescriptorPtr& fd) override;
+    virtual void enableWrite(const SocketDescriptorPtr& fd) override;
+    virtual void disableWrite(const SocketDescriptorPtr& fd) override;
+    virtual const PollerResult& wait(std::int32_t timeout) override;
+    virtual void releaseWait(std::uint32_t info) override;
+
+    // IPollerCompletion
+    virtual void enableReceive(const SocketDescriptorPtr& fd) override;
+    virtual void enableAccept(const SocketDescriptorPtr& fd) override;
+    virtual bool submitSend(const SocketDescriptorPtr& fd, std::vector<struct iovec>&& buffers, std::shared_ptr<const void>&& keepalive) override;
+
+private:
+    // memory that the kernel accesses till the completion of an operation
+    struct OperationData
+    {
+        std::vector<char> buffer{};             // receive buffer or address of the accepted peer
+        bool full{false};                       // the last receive filled the buffer
+        socklen_t addressSize{0};
+        std::vector<struct iovec> buffers{};    // buffers to send
+        msghdr msg{};
+        std::shared_ptr<const void> keepalive{};
+    };
+
+    struct Operation
+    {
+        std::uint64_t userData{0};
+        bool armed{false};
+        bool rearm{false};
+        std::unique_ptr<OperationData> data{};
+    };
+
+    struct SocketEntry
+    {
+        SocketDescriptorPtr fd{};
+        std::uint32_t events{0};
+        std::uint64_t userData{0};
+        bool armed{false};
+        bool rearm{false};
+        bool receiveCompletions{false};
+        bool acceptCompletions{false};
+        Operation receive{};
+        Operation accept{};
+        Operation send{};
+    };
+
+    struct OperationCancelled
+    {
+        SocketDescriptorPtr fd{};
+        std::unique_ptr<OperationData> data{};
+        bool accept{false};
+    };
+
+    bool setupRing(unsigned int entries);
+    void destroyRing();
+    void cancelAllPolls();
+    void addSocketIntern(const SocketDescriptorPtr& fd, std::uint32_t events);
+    void updateEvents(const SocketDescriptorPtr& fd, std::uint32_t eventsSet, std::uint32_t eventsClear);
+    void arm(SocketEntry& entry);
+    void cancelPoll(SocketEntry& entry);
+    void updatePoll(SocketEntry& entry, std::uint32_t pollEventsBefore);
+    void armOperations(SocketEntry& entry);
+    void armReceive(SocketEntry& entry);
+    void armAccept(SocketEntry& entry);
+    void cancelOperation(SocketEntry& entry, Operation& operation, bool accept);
+    void cancelAll(SocketEntry& entry);
+    bool collectOperationCompletion(SocketEntry& entry, const io_uring_cqe& cqe);
+    io_uring_sqe* getSqe();
+    void submitIfNotPollerThread();
+    int enter(unsigned int toSubmit, unsigned int minComplete, unsigned int flags, std::int32_t timeout);
+    void collectCompletions();
+    unsigned int rearmPolls();
+
+    int m_fdRing{-1};
+    void* m_sqRing{nullptr};
+    void* m_cqRing{nullptr};
+    size_t m_sqRingSize{0};
+    size_t m_cqRingSize{0};
+    io_uring_sqe* m_sqes{nullptr};
+    size_t m_sqesSize{0};
+
+    unsigned* m_sqHead{nullptr};
+    unsigned* m_sqTail{nullptr};
+    unsigned m_sqMask{0};
+    unsigned m_sqEntries{0};
+    unsigned* m_cqHead{nullptr};
+    unsigned* m_cqTail{nullptr};
+    unsigned m_cqMask{0};
+    io_uring_cqe* m_cqes{nullptr};
+
+    SocketDescriptorPtr m_controlSocketRead{};
+    SocketDescriptorPtr m_controlSocketWrite{};
+
+    std::unordered_map<SOCKET, SocketEntry> m_socketDescriptors{};
+    std::unordered_map<std::uint64_t, OperationCancelled> m_operationsCancelled{};
+    std::vector<std::unique_ptr<OperationData>> m_operationDataReleased{};
+    std::vector<SOCKET> m_rearm{};
+    std::uint32_t m_nextGeneration{1};
+    std::thread::id m_threadIdWait{};
+
+    PollerResult m_result{};
+    std::atomic_uint32_t m_releaseFlags{};
+
+    std::mutex m_mutex{};
+};
+
+} // namespace finalmq
+
+#endif
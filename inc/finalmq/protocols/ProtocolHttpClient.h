@@ -93,7 +93,8 @@ private:
     virtual FuncCreateMessage getMessageFactory() const override;
     virtual void sendMessage(IMessagePtr message) override;
     virtual void moveOldProtocolState(IProtocol& protocolOld) override;
-    virtual bool received(const IStreamConnectionPtr& connection, const SocketPtr& socket, int bytesToRead) override;
+    virtual bool received(const IStreamConnectionPtr& connection, const char* buffer, int size) override;
+    virtual void writable(const IStreamConnectionPtr& connection) override;
     virtual hybrid_ptr<IStreamConnectionCallback> connected(const IStreamConnectionPtr& connection) override;
     virtual void disconnected(const IStreamConnectionPtr& connection) override;
     virtual IMessagePtr pollReply(std::deque<IMessagePtr>&& messages) override;
@@ -103,6 +104,7 @@ private:
     virtual void setProtocolSessionData(const IProtocolSessionDataPtr& protocolSessionData) override;
 
     bool receiveHeaders(ssize_t bytesReceived);
+    void responseDone();
     void reset();
     //    bool handleInternalCommands(const std::shared_ptr<IProtocolCallback>& callback, bool& ok);
 
@@ -22,6 +22,7 @@
 
 #pragma once
 
+#include <map>
 #include <random>
 
 #include "finalmq/helpers/Executor.h"
@@ -89,7 +90,8 @@ private:
     virtual FuncCreateMessage getMessageFactory() const override;
     virtual void sendMessage(IMessagePtr message) override;
     virtual void moveOldProtocolState(IProtocol& protocolOld) override;
-    virtual bool received(const IStreamConnectionPtr& connection, const SocketPtr& socket, int bytesToRead) override;
+    virtual bool received(const IStreamConnectionPtr& connection, const char* buffer, int size) override;
+    virtual void writable(const IStreamConnectionPtr& connection) override;
     virtual hybrid_ptr<IStreamConnectionCallback> connected(const IStreamConnectionPtr& connection) override;
     virtual void disconnected(const IStreamConnectionPtr& connection) override;
     virtual IMessagePtr pollReply(std::deque<IMessagePtr>&& messages) override;
@@ -99,11 +101,16 @@ private:
     virtual void setProtocolSessionData(const IProtocolSessionDataPtr& protocolSessionData) override;
 
     bool receiveHeaders(ssize_t bytesReceived);
+    bool requestDone();
     void reset();
     std::string createSessionName();
     void checkSessionName();
-    void cookiesToSessionIds(const std::string& cookies);
-    bool handleInternalCommands(const std::shared_ptr<IProtocolCallback>& callback, bool& ok);
+    void cookiesToSessionIds(std::string_view cookies);
+    void receiveQuery(std::string_view query, IMessage::Metainfo& metainfo);
+    bool handleInternalCommands(const std::shared_ptr<IProtocolCallback>& callback, std::int64_t requestId, bool& ok);
+    void sendInOrderOfRequests(const IMessagePtr& message);
+    IMessagePtr createResponse(std::int64_t requestId);
+    void addRequestId(IMessage& message, std::int64_t requestId) const;
 
     enum class State
     {
@@ -142,6 +149,9 @@ private:
     IStreamConnectionPtr m_connection{};
     ChunkedState m_chunkedState = STATE_STOP;
     bool m_multipart = false;
+    std::int64_t m_requestIdNext = 0;
+    std::int64_t m_responseIdNext = 0;
+    std::map<std::int64_t, std::vector<IMessagePtr>> m_responsesPending{};
 
     // path
     std::string* m_path = nullptr;
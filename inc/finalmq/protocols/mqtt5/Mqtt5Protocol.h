@@ -58,7 +58,7 @@ struct IMqtt5Protocol
 {
     virtual ~IMqtt5Protocol() = default;
     virtual void setCallback(hybrid_ptr<IMqtt5ProtocolCallback> callback) = 0;
-    virtual bool receive(const IStreamConnectionPtr& connection, const SocketPtr& socket, int bytesToRead) = 0;
+    virtual bool receive(const IStreamConnectionPtr& connection, const char* buffer, int size) = 0;
     virtual void sendConnect(const IStreamConnectionPtr& connection, const Mqtt5ConnectData& data) = 0;
     virtual void sendConnAck(const IStreamConnectionPtr& connection, const Mqtt5ConnAckData& data) = 0;
     virtual void sendPublish(const IStreamConnectionPtr& connection, Mqtt5PublishData& data, const IMessagePtr& message) = 0;
@@ -89,10 +89,10 @@ public:
         MESSAGECOMPLETE,
     };
 
-    bool receiveHeader(const SocketPtr& socket, int& bytesToRead);
-    bool receiveRemainingSize(const IStreamConnectionPtr& connection, const SocketPtr& socket, int& bytesToRead);
+    void receiveHeader(const char*& buffer, int& size);
+    bool receiveRemainingSize(const IStreamConnectionPtr& connection, const char*& buffer, int& size);
     void setPayloadSize();
-    bool receivePayload(const IStreamConnectionPtr& connection, const SocketPtr& socket, int& bytesToRead);
+    bool receivePayload(const IStreamConnectionPtr& connection, const char*& buffer, int& size);
     bool processPayload(const IStreamConnectionPtr& connection);
     void clearState();
 
@@ -113,7 +113,7 @@ public:
 
     // IMqtt5Protocol
     virtual void setCallback(hybrid_ptr<IMqtt5ProtocolCallback> callback) override;
-    virtual bool receive(const IStreamConnectionPtr& connection, const SocketPtr& socket, int bytesToRead) override;
+    virtual bool receive(const IStreamConnectionPtr& connection, const char* buffer, int size) override;
     virtual void sendConnect(const IStreamConnectionPtr& connection, const Mqtt5ConnectData& data) override;
     virtual void sendConnAck(const IStreamConnectionPtr& connection, const Mqtt5ConnAckData& data) override;
     virtual void sendPublish(const IStreamConnectionPtr& connection, Mqtt5PublishData& data, const IMessagePtr& message) override;
@@ -0,0 +1,72 @@
+//MIT License
+
+//Copyright (c) 2020 bexoft GmbH (mail@bexoft.de)
+
+//Permission is hereby granted, free of charge, to any person obtaining a copy
+//of this software and associated documentation files (the "Software"), to deal
+//in the Software without restriction, including without limitation the rights
+//to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//copies of the Software, and to permit persons to whom the Software is
+//furnished to do so, subject to the following conditions:
+
+//The above copyright notice and this permission notice shall be included in all
+//copies or substantial portions of the Software.
+
+//THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//SOFTWARE.
+
+
+#pragma once
+
+#include <string>
+#include <string_view>
+
+#include "finalmq/helpers/FmqDefines.h"
+
+namespace finalmq
+{
+/**
+ * @brief HttpHeaderParser contains the single pass helpers to parse the start line and the header lines
+ * of HTTP/1.1 messages. The results are slices of the receive buffer. Owned strings are created by the caller,
+ * only for the parts it keeps.
+ */
+class SYMBOLEXP HttpHeaderParser
+{
+public:
+    /**
+     * @brief findEndOfLine searches the '\n' of the next line inside [indexBegin, indexEnd).
+     * @return the index of the '\n' or -1, if the line is not complete, yet.
+     */
+    static ssize_t findEndOfLine(const char* buffer, ssize_t indexBegin, ssize_t indexEnd);
+
+    /**
+     * @brief splitStartLine splits the start line at the first two spaces, e.g. "GET /path HTTP/1.1" or "HTTP/1.1 404 Not Found".
+     * The rest may contain spaces or may be empty.
+     * @return false, if the line has less than two parts.
+     */
+    static bool splitStartLine(std::string_view line, std::string_view& first, std::string_view& second, std::string_view& rest);
+
+    /**
+     * @brief splitHeaderLine splits a header line at the colon. The whitespaces around the value are removed.
+     * A line without colon results in the name and an empty value.
+     */
+    static void splitHeaderLine(std::string_view line, std::string_view& name, std::string_view& value);
+
+    /**
+     * @brief parseContentLength parses the decimal value of a Content-Length header.
+     * @return the length or 0, if the value is not a number.
+     */
+    static ssize_t parseContentLength(std::string_view value);
+
+    /**
+     * @brief decode appends the percent decoded src to dest.
+     */
+    static void decode(std::string& dest, std::string_view src);
+};
+
+} // namespace finalmq
@@ -54,7 +54,8 @@ private:
     virtual FuncCreateMessage getMessageFactory() const override;
     virtual void sendMessage(IMessagePtr message) override;
     virtual void moveOldProtocolState(IProtocol& protocolOld) override;
-    virtual bool received(const IStreamConnectionPtr& connection, const SocketPtr& socket, int bytesToRead) override;
+    virtual bool received(const IStreamConnectionPtr& connection, const char* buffer, int size) override;
+    virtual void writable(const IStreamConnectionPtr& connection) override;
     virtual hybrid_ptr<IStreamConnectionCallback> connected(const IStreamConnectionPtr& connection) override;
     virtual void disconnected(const IStreamConnectionPtr& connection) override;
     virtual IMessagePtr pollReply(std::deque<IMessagePtr>&& messages) override;
@@ -63,25 +64,23 @@ private:
     virtual IProtocolSessionDataPtr createProtocolSessionData() override;
     virtual void setProtocolSessionData(const IProtocolSessionDataPtr& protocolSessionData) override;
 
-    std::vector<ssize_t> findEndOfMessage(const char* buffer, ssize_t size);
+    ssize_t findDelimiter(const char* buffer, ssize_t indexBegin, ssize_t indexEnd) const;
+    void prepareReceiveBuffer(ssize_t bytesToRead);
+
+    static constexpr ssize_t RECEIVE_SLAB_SIZE = 64 * 1024;
 
     std::weak_ptr<IProtocolCallback> m_callback{};
     IStreamConnectionPtr m_connection{};
 
     const std::string m_delimiter{};
     const char m_delimiterStart{};
-    ssize_t m_indexStartMessage = 0;
+
+    // The received bytes are appended to a slab. The received messages reference slices of the slab,
+    // so they are not copied. Only the unfinished message is moved, when the slab is full.
     std::shared_ptr<std::string> m_receiveBuffer{};
-    ssize_t m_bufferSize = 0;
-
-    struct ReceiveBufferStore
-    {
-        std::shared_ptr<std::string> receiveBuffer{};
-        ssize_t indexStartMessage = -1;
-        ssize_t indexEndMessage = -1;
-    };
-    std::vector<ReceiveBufferStore> m_receiveBuffers{};
-    ssize_t m_receiveBuffersTotal = 0;
+    ssize_t m_bufferSize = 0;        ///< number of filled bytes of the slab
+    ssize_t m_indexStartMessage = 0; ///< begin of the unfinished message
+    ssize_t m_indexSearch = 0;       ///< the delimiter search continues here
 
     mutable std::mutex m_mutex{};
 };
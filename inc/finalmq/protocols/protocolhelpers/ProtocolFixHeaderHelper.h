@@ -36,7 +36,7 @@ class SYMBOLEXP ProtocolFixHeaderHelper
 public:
     ProtocolFixHeaderHelper(int sizeHeader, std::function<int(const std::string& header)> funcGetPayloadSize);
 
-    bool receive(const SocketPtr& socket, int bytesToRead, std::deque<IMessagePtr>& messages);
+    void receive(const char* buffer, int size, std::deque<IMessagePtr>& messages);
 
 private:
     ProtocolFixHeaderHelper(const ProtocolFixHeaderHelper&) = delete;
@@ -50,9 +50,9 @@ private:
         WAITFORPAYLOAD
     };
 
-    bool receiveHeader(const SocketPtr& socket, int& bytesToRead);
+    void receiveHeader(const char*& buffer, int& size);
     void setPayloadSize(int sizePayload);
-    bool receivePayload(const SocketPtr& socket, int& bytesToRead);
+    void receivePayload(const char*& buffer, int& size);
     void handlePayloadReceived();
     void clearState();
 
@@ -46,6 +46,7 @@ struct IProtocolCallback
     virtual void received(const IMessagePtr& message, std::int64_t connectionId = 0) = 0;
     virtual void socketConnected() = 0;
     virtual void socketDisconnected() = 0;
+    virtual void writable() = 0;
     virtual void reconnect() = 0;
     virtual bool findSessionByName(const std::string& sessionName, const IProtocolPtr& protocol) = 0;
     virtual void setSessionName(const std::string& sessionName, const IProtocolPtr& protocol, const IStreamConnectionPtr& connection) = 0;
@@ -47,6 +47,12 @@ struct IProtocolSession
     virtual IExecutorPtr getExecutor() const = 0;
     virtual void subscribe(const std::vector<std::string>& subscribtions) = 0;
     virtual const Variant& getFormatData() const = 0;
+    /**
+     * @brief isWritable returns false, if the send queue of the session or of its connection reached a high water mark
+     * (see SendQueueConfig). Producers can pause until the callback IProtocolSessionCallback::writable is called.
+     */
+    virtual bool isWritable() const = 0;
+    virtual SendQueueStatistics getSendQueueStatistics() const = 0;
 };
 
 //struct IProtocolSession;
@@ -63,6 +69,7 @@ struct IProtocolSessionCallback
     virtual void received(const IProtocolSessionPtr& session, const IMessagePtr& message) = 0;
     virtual void socketConnected(const IProtocolSessionPtr& session) = 0;
     virtual void socketDisconnected(const IProtocolSessionPtr& session) = 0;
+    virtual void writable(const IProtocolSessionPtr& session) = 0;
 };
 
 }   // namespace finalmq
@@ -23,6 +23,7 @@
 #pragma once
 
 #include <unordered_map>
+#include <vector>
 
 #include "finalmq/protocolsession/IProtocol.h"
 #include "finalmq/streamconnection/IMessage.h"
@@ -67,10 +68,13 @@ private:
     virtual void addSendPayload(const char* payload, ssize_t size, ssize_t reserve = 0) override;
     virtual char* addSendPayload(ssize_t size, ssize_t reserve = 0) override;
     virtual void downsizeLastSendPayload(ssize_t newSize) override;
+    virtual void addSendPayload(const std::shared_ptr<const std::string>& payload) override;
+    virtual void addSendPayload(const std::shared_ptr<const std::string>& buffer, ssize_t offset, ssize_t size) override;
 
     // for receive
     virtual BufferRef getReceiveHeader() const override;
     virtual BufferRef getReceivePayload() const override;
+    virtual std::shared_ptr<const std::string> getReceiveBuffer() const override;
     virtual char* resizeReceiveBuffer(ssize_t size) override;
     virtual void setReceiveBuffer(const std::shared_ptr<std::string>& receiveBuffer, ssize_t offset, ssize_t size) override;
     virtual void setHeaderSize(ssize_t header) override;
@@ -89,6 +93,10 @@ private:
     virtual char* addSendHeader(ssize_t size) override;
     virtual void downsizeLastSendHeader(ssize_t newSize) override;
 
+    // for the protocol to send a file region behind the send buffers (zero copy)
+    virtual void setSendFile(const FileRegionPtr& file) override;
+    virtual const FileRegionPtr& getSendFile() const override;
+
     // for the protocol to prepare the message for send
     virtual void prepareMessageToSend() override;
 
@@ -100,6 +108,19 @@ private:
     virtual IMessagePtr getMessage(std::uint32_t protocolId) const override;
 
 private:
+    friend class ProtocolMessagePool;
+
+    // for the pool: release all references, but keep the buffers for the next usage
+    void clear();
+    void reinit(std::uint32_t protocolId, ssize_t sizeHeader, ssize_t sizeTrailer);
+
+    template<class T>
+    static T& insertNode(std::list<T>& list, typename std::list<T>::iterator pos, std::list<T>& spare);
+
+    static const size_t MAX_SPARE_BUFFERS = 4;
+    static const size_t MAX_SPARE_REFS = 16;
+    static const size_t MAX_RECYCLED_BUFFER_SIZE = 65536;
+
     Metainfo m_metainfo{};
     Variant m_controlData{};
     Variant m_echoData{};
@@ -114,6 +135,10 @@ private:
     ssize_t m_sizeSendBufferTotal = 0;
     std::list<BufferRef> m_sendPayloadRefs{};
     ssize_t m_sizeSendPayloadTotal = 0;
+    std::list<std::string> m_spareBuffers{};
+    std::list<BufferRef> m_spareRefs{};
+    std::vector<std::shared_ptr<const std::string>> m_sharedPayloads{};
+    FileRegionPtr m_sendFile{};
 
     // receive
     std::shared_ptr<std::string> m_receiveBuffer{};
@@ -123,7 +148,7 @@ private:
     ssize_t m_sizeTrailer = 0;
 
     bool m_preparedToSend = false;
-    const std::uint32_t m_protocolId;
+    std::uint32_t m_protocolId;
 
     std::unordered_map<std::uint32_t, IMessagePtr> m_messages{};
 };
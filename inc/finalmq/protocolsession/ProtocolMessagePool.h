@@ -0,0 +1,63 @@
+//MIT License
+
+//Copyright (c) 2020 bexoft GmbH (mail@bexoft.de)
+
+//Permission is hereby granted, free of charge, to any person obtaining a copy
+//of this software and associated documentation files (the "Software"), to deal
+//in the Software without restriction, including without limitation the rights
+//to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//copies of the Software, and to permit persons to whom the Software is
+//furnished to do so, subject to the following conditions:
+
+//The above copyright notice and this permission notice shall be included in all
+//copies or substantial portions of the Software.
+
+//THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//SOFTWARE.
+
+
+#pragma once
+
+#include <cstdint>
+
+#include "finalmq/streamconnection/IMessage.h"
+
+namespace finalmq
+{
+struct ProtocolMessagePoolStatistics
+{
+    std::uint64_t hits{0};
+    std::uint64_t misses{0};
+};
+
+/**
+ * @brief ProtocolMessagePool creates ProtocolMessage objects that are recycled when the last IMessagePtr
+ * is released. The shared_ptr control block is part of the pooled object, and the message keeps its
+ * receive buffer and its send chunks, so a recycled message can be filled without memory allocations.
+ * Each thread has a small cache, the caches exchange messages in batches through a global depot.
+ */
+class SYMBOLEXP ProtocolMessagePool
+{
+public:
+    static IMessagePtr createMessage(std::uint32_t protocolId, ssize_t sizeHeader = 0, ssize_t sizeTrailer = 0);
+
+    /**
+     * @brief getStatistics returns how many messages were taken from the pool (hits)
+     * and how many had to be allocated (misses).
+     */
+    static ProtocolMessagePoolStatistics getStatistics();
+    static void resetStatistics();
+
+private:
+    ProtocolMessagePool() = delete;
+
+    struct MessageRecycler;
+    static void recycle(class ProtocolMessage* message);
+};
+
+} // namespace finalmq
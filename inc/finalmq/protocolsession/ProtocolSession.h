@@ -22,6 +22,7 @@
 
 #pragma once
 
+#include <chrono>
 #include <unordered_set>
 
 #include "IProtocol.h"
@@ -87,6 +88,8 @@ private:
     virtual IExecutorPtr getExecutor() const override;
     virtual void subscribe(const std::vector<std::string>& subscribtions) override;
     virtual const Variant& getFormatData() const override;
+    virtual bool isWritable() const override;
+    virtual SendQueueStatistics getSendQueueStatistics() const override;
 
     //// IStreamConnectionCallback
     //virtual hybrid_ptr<IStreamConnectionCallback> connected(const IStreamConnectionPtr& connection) override;
@@ -108,6 +111,7 @@ private:
     virtual void received(const IMessagePtr& message, std::int64_t connectionId) override;
     virtual void socketConnected() override;
     virtual void socketDisconnected() override;
+    virtual void writable() override;
     virtual void reconnect() override;
     virtual bool findSessionByName(const std::string& sessionName, const IProtocolPtr& protocol) override;
     virtual void setSessionName(const std::string& sessionName, const IProtocolPtr& protocol, const IStreamConnectionPtr& connection) override;
@@ -119,7 +123,12 @@ private:
 
     IMessagePtr convertMessageToProtocol(const IMessagePtr& msg);
     void initProtocolValues();
+    std::string createConnectionPoolKey() const;
     void sendBufferedMessages();
+    bool queueMessage(std::deque<IMessagePtr>& messages, const IMessagePtr& message);
+    void checkQueueDrained();
+    IStreamConnectionPtr getSendConnection() const;
+    IExecutorPtr getConnectionExecutor(const IStreamConnectionPtr& connection) const;
     void addSessionToList(bool verified);
     void getProtocolFromConnectionId(IProtocolPtr& protocol, std::int64_t connectionId);
     void sendMessage(const IMessagePtr& message, const IProtocolPtr& protocol);
@@ -127,9 +136,16 @@ private:
     void pollRelease();
 
     bool hasPendingRequests() const;
+    void prewarmRequestConnections();
     IProtocolPtr allocateRequestConnection();
+    IProtocolPtr acquirePooledRequestConnection();
+    IProtocolPtr findPipelinedRequestConnection() const;
     IProtocolPtr createRequestConnection();
+    void releaseRequestConnection(std::int64_t connectionId);
+    void poolIdleRequestConnections();
+    std::vector<IProtocolPtr> removeExpiredRequestConnections();
     void sendNextRequests();
+    void receivedMessage(const IMessagePtr& message);
 
     const hybrid_ptr<IProtocolSessionCallback> m_callback;
     const IExecutorPtr m_executor;
@@ -137,7 +153,7 @@ private:
     IProtocolPtr m_protocol{};
     std::atomic<std::int64_t> m_connectionId{0};
     std::unordered_map<std::int64_t, IProtocolPtr> m_multiProtocols{};
-    std::unordered_set<std::int64_t> m_unallocatedConnections{};
+    std::unordered_map<std::int64_t, std::chrono::steady_clock::time_point> m_unallocatedConnections{}; ///< idle request connections and the time since they are idle
 
     const std::weak_ptr<IProtocolSessionList> m_protocolSessionList;
     const int64_t m_sessionId = 0;
@@ -168,12 +184,19 @@ private:
     IProtocolSessionDataPtr m_protocolSessionData{};
     Variant m_formatData{};
     int m_maxSynchReqRepConnections = -1;
+    int m_maxPipelinedRequests = 1;
+    int m_idleTimeout = 0;
+    bool m_connectionPool = false;
+    std::string m_connectionPoolKey{};
 
     std::deque<IMessagePtr> m_messagesBuffered{};
-    std::unordered_map<std::int64_t, Variant> m_runningRequests{};
+    std::unordered_map<std::int64_t, std::deque<Variant>> m_runningRequests{}; ///< echo data of the requests in flight per connection, in the order of the replies
 
     std::deque<IMessagePtr> m_pollMessages{};
     int m_pollMaxRequests = 10000;
+    SendQueueConfig m_sendQueueConfig{};
+    bool m_queueBlocked = false;
+    std::int64_t m_droppedMessages = 0;
     //    IMessagePtr                                     m_pollReply;
     IProtocolPtr m_pollProtocol = nullptr;
     PollingTimer m_pollTimer{};
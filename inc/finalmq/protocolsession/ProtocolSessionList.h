@@ -25,6 +25,7 @@
 #include <unordered_map>
 
 #include "IProtocolSession.h"
+#include "RequestConnectionPool.h"
 
 namespace finalmq
 {
@@ -42,6 +43,7 @@ struct IProtocolSessionList
     virtual IProtocolSessionPtr getSession(std::int64_t sessionId) const = 0;
     virtual IProtocolSessionPrivatePtr findSessionByName(const std::string& sessionName) const = 0;
     virtual bool setSessionName(std::int64_t sessionId, const std::string& sessionName) = 0;
+    virtual RequestConnectionPool& getRequestConnectionPool() = 0;
 };
 
 typedef std::shared_ptr<IProtocolSessionList> IProtocolSessionListPtr;
@@ -60,6 +62,7 @@ private:
     virtual IProtocolSessionPtr getSession(std::int64_t sessionId) const override;
     virtual IProtocolSessionPrivatePtr findSessionByName(const std::string& sessionName) const override;
     virtual bool setSessionName(std::int64_t sessionId, const std::string& sessionName) override;
+    virtual RequestConnectionPool& getRequestConnectionPool() override;
 
     struct SessionData
     {
@@ -69,6 +72,7 @@ private:
     };
 
     std::unordered_map<std::int64_t, SessionData> m_connectionId2ProtocolSession{};
+    RequestConnectionPool m_requestConnectionPool{};
     static std::atomic_int64_t m_nextSessionId;
     mutable std::mutex m_mutex{};
 };
@@ -0,0 +1,85 @@
+//MIT License
+
+//Copyright (c) 2020 bexoft GmbH (mail@bexoft.de)
+
+//Permission is hereby granted, free of charge, to any person obtaining a copy
+//of this software and associated documentation files (the "Software"), to deal
+//in the Software without restriction, including without limitation the rights
+//to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//copies of the Software, and to permit persons to whom the Software is
+//furnished to do so, subject to the following conditions:
+
+//The above copyright notice and this permission notice shall be included in all
+//copies or substantial portions of the Software.
+
+//THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//SOFTWARE.
+
+
+#pragma once
+
+#include <chrono>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+#include "finalmq/helpers/FmqDefines.h"
+#include "IProtocol.h"
+
+namespace finalmq
+{
+/**
+ * @brief RequestConnectionPool keeps the idle connections of disconnected sessions of synchronous request/reply protocols (e.g. httpclient),
+ * so that other sessions to the same endpoint can reuse them instead of opening new sockets.
+ * The connections are grouped by a key, which contains the protocol, the endpoint, the TLS settings, the protocol data and the send queue limits.
+ */
+class SYMBOLEXP RequestConnectionPool
+{
+public:
+    RequestConnectionPool();
+    ~RequestConnectionPool();
+
+    /**
+     * @brief acquire takes the most recently released connection, which is still connected.
+     * @return the protocol of the connection or nullptr, if there is no idle connection for the key.
+     */
+    IProtocolPtr acquire(const std::string& key);
+
+    /**
+     * @brief release puts an idle connection into the pool. The connection is closed after idleTimeout [ms]
+     * (0 = no timeout). If the pool already contains maxIdleConnections for the key, the oldest one is closed.
+     */
+    void release(const std::string& key, const IProtocolPtr& protocol, int idleTimeout, int maxIdleConnections);
+
+    /**
+     * @brief cycleTime closes the connections, which are idle longer than their idle timeout.
+     */
+    void cycleTime();
+
+    /**
+     * @brief clear closes all idle connections.
+     */
+    void clear();
+
+private:
+    RequestConnectionPool(const RequestConnectionPool&) = delete;
+    RequestConnectionPool& operator=(const RequestConnectionPool&) = delete;
+
+    struct IdleConnection
+    {
+        IProtocolPtr protocol{};
+        std::chrono::steady_clock::time_point expiration{};
+        bool expires = false;
+    };
+
+    std::unordered_map<std::string, std::deque<IdleConnection>> m_idleConnections{};
+    std::mutex m_mutex{};
+};
+
+} // namespace finalmq
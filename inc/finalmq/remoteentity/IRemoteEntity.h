@@ -105,6 +105,24 @@ namespace finalmq
             return false;
         }
 
+        bool isWritable() const
+        {
+            if (m_session)
+            {
+                return m_session->isWritable();
+            }
+            return false;
+        }
+
+        SendQueueStatistics getSendQueueStatistics() const
+        {
+            if (m_session)
+            {
+                return m_session->getSendQueueStatistics();
+            }
+            return {};
+        }
+
     private:
         hybrid_ptr<IRemoteEntityContainer> m_entityContainer{};
         IProtocolSessionPtr m_session{};
@@ -119,6 +137,7 @@ namespace finalmq
         Header header{};
         bool automaticConnect = false;
         std::shared_ptr<StructBase> structBase{};
+        std::shared_ptr<std::pmr::memory_resource> arena{};
     };
 
     typedef std::function<void(PeerId peerId, Status status, const StructBasePtr& structBase)> FuncReply;
@@ -657,6 +676,7 @@ namespace finalmq
         // methods for RemoteEntityContainer
         virtual void sessionDisconnected(const IProtocolSessionPtr& session) = 0;
         virtual void virtualSessionDisconnected(const IProtocolSessionPtr& session, const std::string& virtualSessionId) = 0;
+        virtual void sessionWritable(const IProtocolSessionPtr& session) = 0;
         virtual void receivedRequest(ReceiveData& receiveData) = 0;
         virtual void receivedReply(const ReceiveData& receiveData) = 0;
         virtual void deinit() = 0;
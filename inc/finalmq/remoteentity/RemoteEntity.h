@@ -24,6 +24,7 @@
 
 #include <atomic>
 #include <memory>
+#include <memory_resource>
 #include <mutex>
 #include <unordered_map>
 #include <vector>
@@ -51,7 +52,8 @@ public:
     enum Enum : std::int32_t
     {
         PEER_CONNECTED = 0,   ///< The entity connected to a remote entity or a remote entity connected to the entity.
-        PEER_DISCONNECTED = 1 ///< The entity disconnected from a remote entity or a remote entity disconnected from the entity.
+        PEER_DISCONNECTED = 1, ///< The entity disconnected from a remote entity or a remote entity disconnected from the entity.
+        PEER_WRITABLE = 2      ///< The send queue of the session of the peer drained below its low water marks, the entity can continue sending.
     };
 
     PeerEvent();
@@ -98,6 +100,7 @@ public:
     std::deque<PeerManager::Request> connect(PeerId peerId, const SessionInfo& session, EntityId entityId, const std::string& entityName);
     void setEntityId(EntityId entityId);
     void setPeerEvent(const std::shared_ptr<FuncPeerEvent>& funcPeerEvent);
+    void firePeerEvent(PeerId peerId, PeerEvent peerEvent);
     const SessionInfo& getSession(PeerId peerId) const;
 
 private:
@@ -128,7 +131,7 @@ class RequestContext : public std::enable_shared_from_this<RequestContext>
 {
 public:
     inline RequestContext(const PeerManagerPtr& sessionIdEntityIdToPeerId, EntityId entityIdSrc, ReceiveData& receiveData)
-        : m_peerManager(sessionIdEntityIdToPeerId), m_session(receiveData.session), m_virtualSessionId(std::move(receiveData.virtualSessionId)), m_entityIdDest(receiveData.header.srcid), m_entityIdSrc(entityIdSrc), m_correlationId(receiveData.header.corrid), m_replySent(false), m_metainfo(std::move(receiveData.message->getAllMetainfo())), m_echoData(std::move(receiveData.message->getEchoData()))
+        : m_peerManager(sessionIdEntityIdToPeerId), m_session(receiveData.session), m_virtualSessionId(std::move(receiveData.virtualSessionId)), m_entityIdDest(receiveData.header.srcid), m_entityIdSrc(entityIdSrc), m_correlationId(receiveData.header.corrid), m_replySent(false), m_metainfo(std::move(receiveData.message->getAllMetainfo())), m_echoData(std::move(receiveData.message->getEchoData())), m_arena(std::move(receiveData.arena))
     {
     }
 
@@ -235,6 +238,17 @@ public:
         return m_entityIdDest;
     }
 
+    /**
+     * @brief arena is the monotonic arena of the request, if the container was initialized with decodeIntoArena.
+     * A reply, that is built with an allocator of the arena, does not need the heap. The arena is
+     * released when the RequestContext and the request struct are released.
+     * @return nullptr, if the request was not decoded into an arena.
+     */
+    inline std::pmr::memory_resource* arena() const
+    {
+        return m_arena.get();
+    }
+
 private:
     RequestContext(const RequestContext&) = delete;
     const RequestContext& operator=(const RequestContext&) = delete;
@@ -252,6 +266,7 @@ private:
     bool m_replySent = false;
     IMessage::Metainfo m_metainfo;
     Variant m_echoData;
+    std::shared_ptr<std::pmr::memory_resource> m_arena;
 
     friend class RemoteEntity;
 };
@@ -301,6 +316,7 @@ public:
 private:
     virtual void sessionDisconnected(const IProtocolSessionPtr& session) override;
     virtual void virtualSessionDisconnected(const IProtocolSessionPtr& session, const std::string& virtualSessionId) override;
+    virtual void sessionWritable(const IProtocolSessionPtr& session) override;
     virtual void receivedRequest(ReceiveData& receiveData) override;
     virtual void receivedReply(const ReceiveData& receiveData) override;
     virtual void deinit() override;
@@ -311,6 +327,8 @@ protected:
 private:
     PeerId connectIntern(const SessionInfo& session, const std::string& virtualSessionId, const std::string& entityName, EntityId, const std::shared_ptr<FuncReplyConnect>& funcReplyConnect);
     void connectIntern(PeerId peerId, const SessionInfo& session, const std::string& entityName, EntityId entityId);
+    void sendRequestIntern(const PeerId& peerId, const std::string& path, const StructBase& structBase, CorrelationId correlationId, IMessage::Metainfo* metainfo, SerializedDataCache* serializedDataCache);
+    void sendEventToPeers(const std::vector<PeerId>& peers, const std::string& path, const StructBase& structBase, IMessage::Metainfo* metainfo);
     void removePeer(PeerId peerId, Status status);
     void replyReceived(const ReceiveData& receiveData);
     void sendConnectEntity(PeerId peerId, IRemoteEntityContainer& entityContainer, const std::shared_ptr<FuncReplyConnect>& funcReplyConnect);
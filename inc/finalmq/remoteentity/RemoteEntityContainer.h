@@ -36,6 +36,7 @@ public:
         CONNECTIONEVENT_DISCONNECTED = 1,
         CONNECTIONEVENT_SOCKET_CONNECTED = 2,
         CONNECTIONEVENT_SOCKET_DISCONNECTED = 3,
+        CONNECTIONEVENT_WRITABLE = 4, ///< the send queue of the session drained below its low water marks
     };
 
     ConnectionEvent();
@@ -69,8 +70,10 @@ struct IRemoteEntityContainer
      * @param funcTimer is a callback that is been called every cycleTime.
      * @param storeRawDataInReceiveStruct is a flag. It is usually false. But if you wish to have the raw data inside a message struct, then you can set this flag to true.
      * @param checkReconnectInterval is the timer interval in [ms] in which the reconnect timers will be checked (the reconnect timers are not checked every cycleTime). Unit tests which test reconnection, set this parameter to 1ms to have faster tests.
+     * @param numberOfReactors is the number of poller loops (threads) that handle the socket connections. The connections are distributed round-robin over the reactors. Without an executor, the events of a session are called from the thread of its connection, so the callbacks of different sessions are called from different threads.
+     * @param decodeIntoArena is a flag. If it is true, every received message is decoded into its own monotonic arena. The structs with the flag METASTRUCTFLAG_PMR are allocated with all their strings and arrays inside the arena. The arena is released in one shot, when the RequestContext and the received struct are released. Structs without the flag are decoded like before.
      */
-    virtual void init(const IExecutorPtr& executor = nullptr, int cycleTime = 100, FuncTimer funcTimer = nullptr, bool storeRawDataInReceiveStruct = false, int checkReconnectInterval = 1000) = 0;
+    virtual void init(const IExecutorPtr& executor = nullptr, int cycleTime = 100, FuncTimer funcTimer = nullptr, bool storeRawDataInReceiveStruct = false, int checkReconnectInterval = 1000, int numberOfReactors = 1, bool decodeIntoArena = false) = 0;
 
     ///
     /// @brief bind opens a listener socket.
@@ -189,7 +192,7 @@ public:
     virtual ~RemoteEntityContainer();
 
     // IRemoteEntityContainer
-    virtual void init(const IExecutorPtr& executor = nullptr, int cycleTime = 100, FuncTimer funcTimer = {}, bool storeRawDataInReceiveStruct = false, int checkReconnectInterval = 1000) override;
+    virtual void init(const IExecutorPtr& executor = nullptr, int cycleTime = 100, FuncTimer funcTimer = {}, bool storeRawDataInReceiveStruct = false, int checkReconnectInterval = 1000, int numberOfReactors = 1, bool decodeIntoArena = false) override;
     virtual int bind(const std::string& endpoint, const BindProperties& bindProperties = {}) override;
     virtual void unbind(const std::string& endpoint) override;
     virtual SessionInfo connect(const std::string& endpoint, const ConnectProperties& connectProperties = {}) override;
@@ -215,6 +218,7 @@ private:
     virtual void received(const IProtocolSessionPtr& session, const IMessagePtr& message) override;
     virtual void socketConnected(const IProtocolSessionPtr& session) override;
     virtual void socketDisconnected(const IProtocolSessionPtr& session) override;
+    virtual void writable(const IProtocolSessionPtr& session) override;
 
     SessionInfo createSessionInfo(const IProtocolSessionPtr& session);
     inline void triggerConnectionEvent(const SessionInfo& session, ConnectionEvent connectionEvent) const;
@@ -229,6 +233,7 @@ private:
     std::unordered_map<EntityId, std::string> m_entityId2name{};
     std::shared_ptr<FuncConnectionEvent> m_funcConnectionEvent{};
     bool m_storeRawDataInReceiveStruct = false;
+    bool m_decodeIntoArena = false;
     //    std::list<std::string>                                      m_pureDataPaths{};
     //    std::list<std::string>                                      m_pureDataPathPrefixes{};
     const IExecutorPtr m_executor;
@@ -38,10 +38,11 @@ public:
     static const std::string PROPERTY_SERIALIZE_SKIP_DEFAULT_VALUES;    // skipDefVal
 
 private:
-    virtual std::shared_ptr<StructBase> parse(const IProtocolSessionPtr& session, const BufferRef& bufferRef, bool storeRawData, const std::unordered_map<std::string, std::pair<EntityId, hybrid_ptr<IRemoteEntity>>>& name2Entity, Header& header, int& formatStatus) override;
-    virtual std::shared_ptr<StructBase> parseData(const IProtocolSessionPtr& session, const BufferRef& bufferRef, bool storeRawData, std::string& type, int& formatStatus, const std::string& typeOfGeneralMessage) override;
+    virtual std::shared_ptr<StructBase> parse(const IProtocolSessionPtr& session, const BufferRef& bufferRef, bool storeRawData, const std::shared_ptr<std::pmr::memory_resource>& arena, const std::unordered_map<std::string, std::pair<EntityId, hybrid_ptr<IRemoteEntity>>>& name2Entity, Header& header, int& formatStatus) override;
+    virtual std::shared_ptr<StructBase> parseData(const IProtocolSessionPtr& session, const BufferRef& bufferRef, bool storeRawData, const std::shared_ptr<std::pmr::memory_resource>& arena, std::string& type, int& formatStatus, const std::string& typeOfGeneralMessage) override;
     virtual void serialize(const IProtocolSessionPtr& session, IMessage& message, const Header& header, const StructBase* structBase = nullptr) override;
     virtual void serializeData(const IProtocolSessionPtr& session, IMessage& message, const StructBase* structBase = nullptr) override;
+    virtual bool serializeWithData(const IProtocolSessionPtr& session, IMessage& message, const Header& header, const std::shared_ptr<const std::string>& serializedData) override;
 };
 
 
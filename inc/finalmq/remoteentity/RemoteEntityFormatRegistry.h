@@ -23,7 +23,10 @@
 #pragma once
 
 #include <atomic>
+#include <memory_resource>
 #include <mutex>
+#include <string>
+#include <vector>
 
 #include "finalmq/protocolsession/ProtocolSessionContainer.h"
 #include "finalmq/remoteentity/IRemoteEntity.h"
@@ -46,19 +49,44 @@ struct IRemoteEntityFormat
 {
     virtual ~IRemoteEntityFormat()
     {}
-    virtual std::shared_ptr<StructBase> parse(const IProtocolSessionPtr& session, const BufferRef& bufferRef, bool storeRawData, const std::unordered_map<std::string, std::pair<EntityId, hybrid_ptr<IRemoteEntity>>>& name2Entity, Header& header, int& formatStatus) = 0;
-    virtual std::shared_ptr<StructBase> parseData(const IProtocolSessionPtr& session, const BufferRef& bufferRef, bool storeRawData, std::string& type, int& formatStatus, const std::string& typeOfGeneralMessage) = 0;
+    virtual std::shared_ptr<StructBase> parse(const IProtocolSessionPtr& session, const BufferRef& bufferRef, bool storeRawData, const std::shared_ptr<std::pmr::memory_resource>& arena, const std::unordered_map<std::string, std::pair<EntityId, hybrid_ptr<IRemoteEntity>>>& name2Entity, Header& header, int& formatStatus) = 0;
+    virtual std::shared_ptr<StructBase> parseData(const IProtocolSessionPtr& session, const BufferRef& bufferRef, bool storeRawData, const std::shared_ptr<std::pmr::memory_resource>& arena, std::string& type, int& formatStatus, const std::string& typeOfGeneralMessage) = 0;
     virtual void serialize(const IProtocolSessionPtr& session, IMessage& message, const Header& header, const StructBase* structBase = nullptr) = 0;
     virtual void serializeData(const IProtocolSessionPtr& session, IMessage& message, const StructBase* structBase = nullptr) = 0;
+
+    /**
+     * @brief serializeWithData serializes the header and appends data, that was produced before by serializeData().
+     * The data is shared by all messages of a broadcast, so it is referenced by the message and not copied.
+     * @return false, if the format does not support it. Then the caller serializes the struct again.
+     */
+    virtual bool serializeWithData(const IProtocolSessionPtr& /*session*/, IMessage& /*message*/, const Header& /*header*/, const std::shared_ptr<const std::string>& /*serializedData*/)
+    {
+        return false;
+    }
+};
+
+/**
+ * @brief SerializedDataCache keeps the serialized payload of one struct per content type and format data.
+ * It is used to serialize a broadcast only once for all peers that share the same format.
+ */
+struct SerializedDataCache
+{
+    struct Entry
+    {
+        int contentType{0};
+        Variant formatData{};
+        std::shared_ptr<const std::string> data{};
+    };
+    std::vector<Entry> entries{};
 };
 
 struct IRemoteEntityFormatRegistry
 {
     virtual ~IRemoteEntityFormatRegistry()
     {}
-    virtual std::shared_ptr<StructBase> parse(const IProtocolSessionPtr& session, IMessage& message, bool storeRawData, const std::unordered_map<std::string, std::pair<EntityId, hybrid_ptr<IRemoteEntity>>>& name2Entity, Header& header, int& formatStatus) = 0;
-    virtual std::shared_ptr<StructBase> parseHeaderInMetainfo(const IProtocolSessionPtr& session, IMessage& message, bool storeRawData, const std::unordered_map<std::string, std::pair<EntityId, hybrid_ptr<IRemoteEntity>>>& name2Entity, Header& header, int& formatStatus) = 0;
-    virtual void send(const IProtocolSessionPtr& session, const std::string& virtualSessionId, Header& header, Variant&& echoData, const StructBase* structBase = nullptr, IMessage::Metainfo* metainfo = nullptr, Variant* controlData = nullptr) = 0;
+    virtual std::shared_ptr<StructBase> parse(const IProtocolSessionPtr& session, IMessage& message, bool storeRawData, const std::shared_ptr<std::pmr::memory_resource>& arena, const std::unordered_map<std::string, std::pair<EntityId, hybrid_ptr<IRemoteEntity>>>& name2Entity, Header& header, int& formatStatus) = 0;
+    virtual std::shared_ptr<StructBase> parseHeaderInMetainfo(const IProtocolSessionPtr& session, IMessage& message, bool storeRawData, const std::shared_ptr<std::pmr::memory_resource>& arena, const std::unordered_map<std::string, std::pair<EntityId, hybrid_ptr<IRemoteEntity>>>& name2Entity, Header& header, int& formatStatus) = 0;
+    virtual void send(const IProtocolSessionPtr& session, const std::string& virtualSessionId, Header& header, Variant&& echoData, const StructBase* structBase = nullptr, IMessage::Metainfo* metainfo = nullptr, Variant* controlData = nullptr, SerializedDataCache* serializedDataCache = nullptr) = 0;
 
     virtual void registerFormat(const std::string& contentTypeName, int contentType, const std::shared_ptr<IRemoteEntityFormat>& format) = 0;
     virtual bool isRegistered(int contentType) const = 0;
@@ -68,9 +96,9 @@ struct IRemoteEntityFormatRegistry
 class RemoteEntityFormatRegistryImpl : public IRemoteEntityFormatRegistry
 {
 public:
-    virtual std::shared_ptr<StructBase> parse(const IProtocolSessionPtr& session, IMessage& message, bool storeRawData, const std::unordered_map<std::string, std::pair<EntityId, hybrid_ptr<IRemoteEntity>>>& name2Entity, Header& header, int& formatStatus) override;
-    virtual std::shared_ptr<StructBase> parseHeaderInMetainfo(const IProtocolSessionPtr& session, IMessage& message, bool storeRawData, const std::unordered_map<std::string, std::pair<EntityId, hybrid_ptr<IRemoteEntity>>>& name2Entity, Header& header, int& formatStatus) override;
-    virtual void send(const IProtocolSessionPtr& session, const std::string& virtualSessionId, Header& header, Variant&& echoData, const StructBase* structBase = nullptr, IMessage::Metainfo* metainfo = nullptr, Variant* controlData = nullptr) override;
+    virtual std::shared_ptr<StructBase> parse(const IProtocolSessionPtr& session, IMessage& message, bool storeRawData, const std::shared_ptr<std::pmr::memory_resource>& arena, const std::unordered_map<std::string, std::pair<EntityId, hybrid_ptr<IRemoteEntity>>>& name2Entity, Header& header, int& formatStatus) override;
+    virtual std::shared_ptr<StructBase> parseHeaderInMetainfo(const IProtocolSessionPtr& session, IMessage& message, bool storeRawData, const std::shared_ptr<std::pmr::memory_resource>& arena, const std::unordered_map<std::string, std::pair<EntityId, hybrid_ptr<IRemoteEntity>>>& name2Entity, Header& header, int& formatStatus) override;
+    virtual void send(const IProtocolSessionPtr& session, const std::string& virtualSessionId, Header& header, Variant&& echoData, const StructBase* structBase = nullptr, IMessage::Metainfo* metainfo = nullptr, Variant* controlData = nullptr, SerializedDataCache* serializedDataCache = nullptr) override;
     virtual void registerFormat(const std::string& contentTypeName, int contentType, const std::shared_ptr<IRemoteEntityFormat>& format) override;
     virtual bool isRegistered(int contentType) const override;
     virtual int getContentType(const std::string& contentTypeName) const override;
@@ -80,6 +108,7 @@ private:
     std::string parseMetainfo(IMessage& message, const std::unordered_map<std::string, std::pair<EntityId, hybrid_ptr<IRemoteEntity>>>& name2Entity, Header& header, std::string& typeOfGeneralMessage);
     bool serialize(const IProtocolSessionPtr& session, IMessage& message, const Header& header, const StructBase* structBase = nullptr);
     bool serializeData(const IProtocolSessionPtr& session, IMessage& message, const StructBase* structBase);
+    bool serializeCached(const IProtocolSessionPtr& session, IMessage& message, const Header& header, const StructBase* structBase, bool withHeader, SerializedDataCache& serializedDataCache);
 
     std::unordered_map<int, std::shared_ptr<IRemoteEntityFormat>> m_contentTypeToFormat{};
     std::unordered_map<std::string, int> m_contentTypeNameToContentType{};
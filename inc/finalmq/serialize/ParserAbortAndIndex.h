@@ -29,18 +29,25 @@
 
 namespace finalmq
 {
-class SYMBOLEXP ParserAbortAndIndex : public IParserVisitor
+/**
+ * @brief ParserAbortAndIndexT handles the "abortstruct" and index attributes of the meta data fields and passes the remaining values to the next visitor.
+ * Visitor is the type of the next visitor. A concrete (final) type lets the compiler call the
+ * next visitor directly, see ParserStage. ParserAbortAndIndex is the runtime configurable variant.
+ */
+template<class Visitor = IParserVisitor>
+class ParserAbortAndIndexT : public IParserVisitor
 {
 public:
-    ParserAbortAndIndex(IParserVisitor* visitor = nullptr);
-    void setVisitor(IParserVisitor& visitor);
+    ParserAbortAndIndexT(Visitor* visitor = nullptr);
+    void setVisitor(Visitor& visitor);
 
 private:
-    ParserAbortAndIndex(const ParserAbortAndIndex&) = delete;
-    ParserAbortAndIndex(ParserAbortAndIndex&&) = delete;
-    const ParserAbortAndIndex& operator=(const ParserAbortAndIndex&) = delete;
-    const ParserAbortAndIndex& operator=(ParserAbortAndIndex&&) = delete;
+    ParserAbortAndIndexT(const ParserAbortAndIndexT&) = delete;
+    ParserAbortAndIndexT(ParserAbortAndIndexT&&) = delete;
+    const ParserAbortAndIndexT& operator=(const ParserAbortAndIndexT&) = delete;
+    const ParserAbortAndIndexT& operator=(ParserAbortAndIndexT&&) = delete;
 
+public:
     // IParserVisitor
     virtual void notifyError(const char* str, const char* message) override;
     virtual void startStruct(const MetaStruct& stru) override;
@@ -105,6 +112,7 @@ private:
     virtual void enterArrayEnumMove(const MetaField& field, std::vector<std::string>&& value) override;
     virtual void enterArrayEnum(const MetaField& field, const std::vector<std::string>& value) override;
 
+private:
     enum IndexStatus
     {
         INDEX_NOT_AVAILABLE = -1,
@@ -129,9 +137,24 @@ private:
     void checkAbortAndIndex(const MetaField& field, const std::string& value, LevelState& levelState);
     void checkAbortAndIndex(const MetaField& field, std::int64_t value, LevelState& levelState);
 
-    IParserVisitor* m_visitor;
+    inline static const std::string ABORTSTRUCT{"abortstruct"};
+    inline static const std::string ABORT_FALSE{"false"};
+    inline static const std::string ABORT_TRUE{"true"};
+    inline static const std::string INDEXMODE{"indexmode"};
+    inline static const std::string INDEXMODE_MAPPING{"mapping"};
+    inline static const std::string INDEXOFFSET{"indexoffset"};
+
+    Visitor* m_visitor;
 
     std::deque<LevelState> m_levelState{};
 };
 
+extern template class ParserAbortAndIndexT<IParserVisitor>;
+
+class SYMBOLEXP ParserAbortAndIndex : public ParserAbortAndIndexT<IParserVisitor>
+{
+public:
+    using ParserAbortAndIndexT<IParserVisitor>::ParserAbortAndIndexT;
+};
+
 } // namespace finalmq
@@ -27,18 +27,25 @@
 
 namespace finalmq
 {
-class SYMBOLEXP ParserConverter : public IParserVisitor
+/**
+ * @brief ParserConverterT converts the values of the parser to the types of the meta data fields and passes them to the next visitor.
+ * Visitor is the type of the next visitor. A concrete (final) type lets the compiler call the
+ * next visitor directly, see ParserStage. ParserConverter is the runtime configurable variant.
+ */
+template<class Visitor = IParserVisitor>
+class ParserConverterT : public IParserVisitor
 {
 public:
-    ParserConverter(IParserVisitor* visitor = nullptr);
-    void setVisitor(IParserVisitor& visitor);
+    ParserConverterT(Visitor* visitor = nullptr);
+    void setVisitor(Visitor& visitor);
 
 private:
-    ParserConverter(const ParserConverter&) = delete;
-    ParserConverter(ParserConverter&&) = delete;
-    const ParserConverter& operator=(const ParserConverter&) = delete;
-    const ParserConverter& operator=(ParserConverter&&) = delete;
+    ParserConverterT(const ParserConverterT&) = delete;
+    ParserConverterT(ParserConverterT&&) = delete;
+    const ParserConverterT& operator=(const ParserConverterT&) = delete;
+    const ParserConverterT& operator=(ParserConverterT&&) = delete;
 
+public:
     // IParserVisitor
     virtual void notifyError(const char* str, const char* message) override;
     virtual void startStruct(const MetaStruct& stru) override;
@@ -103,6 +110,7 @@ private:
     virtual void enterArrayEnumMove(const MetaField& field, std::vector<std::string>&& value) override;
     virtual void enterArrayEnum(const MetaField& field, const std::vector<std::string>& value) override;
 
+private:
     template<class T>
     void convertNumber(const MetaField& field, T value);
     template<class T>
@@ -113,7 +121,15 @@ private:
     void convertString(const MetaField& field, const char* value, ssize_t size);
     void convertArraytString(const MetaField& field, const std::vector<std::string>& value);
 
-    IParserVisitor* m_visitor = nullptr;
+    Visitor* m_visitor = nullptr;
+};
+
+extern template class ParserConverterT<IParserVisitor>;
+
+class SYMBOLEXP ParserConverter : public ParserConverterT<IParserVisitor>
+{
+public:
+    using ParserConverterT<IParserVisitor>::ParserConverterT;
 };
 
 } // namespace finalmq
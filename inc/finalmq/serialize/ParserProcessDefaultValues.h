@@ -29,19 +29,26 @@
 
 namespace finalmq
 {
-class SYMBOLEXP ParserProcessDefaultValues : public IParserVisitor
+/**
+ * @brief ParserProcessDefaultValuesT skips the default values or adds the missing default values and passes them to the next visitor.
+ * Visitor is the type of the next visitor. A concrete (final) type lets the compiler call the
+ * next visitor directly, see ParserStage. ParserProcessDefaultValues is the runtime configurable variant.
+ */
+template<class Visitor = IParserVisitor>
+class ParserProcessDefaultValuesT : public IParserVisitor
 {
 public:
-    ParserProcessDefaultValues(bool skipDefaultValues, IParserVisitor* visitor = nullptr);
-    void setVisitor(IParserVisitor& visitor);
+    ParserProcessDefaultValuesT(bool skipDefaultValues, Visitor* visitor = nullptr);
+    void setVisitor(Visitor& visitor);
     void resetVarValueActive();
 
 private:
-    ParserProcessDefaultValues(const ParserProcessDefaultValues&) = delete;
-    ParserProcessDefaultValues(ParserProcessDefaultValues&&) = delete;
-    const ParserProcessDefaultValues& operator=(const ParserProcessDefaultValues&) = delete;
-    const ParserProcessDefaultValues& operator=(ParserProcessDefaultValues&&) = delete;
+    ParserProcessDefaultValuesT(const ParserProcessDefaultValuesT&) = delete;
+    ParserProcessDefaultValuesT(ParserProcessDefaultValuesT&&) = delete;
+    const ParserProcessDefaultValuesT& operator=(const ParserProcessDefaultValuesT&) = delete;
+    const ParserProcessDefaultValuesT& operator=(ParserProcessDefaultValuesT&&) = delete;
 
+public:
     // IParserVisitor
     virtual void notifyError(const char* str, const char* message) override;
     virtual void startStruct(const MetaStruct& stru) override;
@@ -106,6 +113,7 @@ private:
     virtual void enterArrayEnumMove(const MetaField& field, std::vector<std::string>&& value) override;
     virtual void enterArrayEnum(const MetaField& field, const std::vector<std::string>& value) override;
 
+private:
     void processDefaultValues(const MetaStruct& stru, const std::vector<bool>& fieldsDone);
     inline void markAsDone(const MetaField& field);
     void executeEnterStruct();
@@ -158,7 +166,10 @@ private:
         int level{};
     };
 
-    IParserVisitor* m_visitor{nullptr};
+    inline static const std::string STR_VARVALUE{"finalmq.variant.VarValue"};
+    inline static const std::string FIXED_ARRAY{"fixedarray"};
+
+    Visitor* m_visitor{nullptr};
     const bool m_skipDefaultValues{true};
     const MetaStruct* m_struct{nullptr};
     std::deque<std::pair<std::string, std::vector<bool>>> m_stackFieldsDone{};
@@ -168,4 +179,12 @@ private:
     std::deque<EntryArrayStructState> m_stackArrayStructState{};
 };
 
+extern template class ParserProcessDefaultValuesT<IParserVisitor>;
+
+class SYMBOLEXP ParserProcessDefaultValues : public ParserProcessDefaultValuesT<IParserVisitor>
+{
+public:
+    using ParserProcessDefaultValuesT<IParserVisitor>::ParserProcessDefaultValuesT;
+};
+
 } // namespace finalmq
@@ -0,0 +1,45 @@
+//MIT License
+
+//Copyright (c) 2020 bexoft GmbH (mail@bexoft.de)
+
+//Permission is hereby granted, free of charge, to any person obtaining a copy
+//of this software and associated documentation files (the "Software"), to deal
+//in the Software without restriction, including without limitation the rights
+//to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//copies of the Software, and to permit persons to whom the Software is
+//furnished to do so, subject to the following conditions:
+
+//The above copyright notice and this permission notice shall be included in all
+//copies or substantial portions of the Software.
+
+//THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//SOFTWARE.
+
+
+#pragma once
+
+namespace finalmq
+{
+/**
+ * @brief ParserStage composes the parser visitors (ParserConverterT, ParserProcessDefaultValuesT,
+ * ParserAbortAndIndexT) at compile time, e.g.
+ * ParserConverterT<ParserStage<ParserProcessDefaultValuesT, ParserStage<ParserAbortAndIndexT, Sink>>>.
+ * The stage is final, so the previous stage calls it without a virtual call and the compiler
+ * can inline the whole chain into one pass. Use the non-template classes (ParserConverter, ...)
+ * if the chain has to be configured at runtime.
+ */
+template<template<class> class Stage, class Visitor>
+class ParserStage final : public Stage<Visitor>
+{
+    using Base = Stage<Visitor>;
+
+public:
+    using Base::Base;
+};
+
+} // namespace finalmq
@@ -26,98 +26,106 @@
 #include "finalmq/helpers/IZeroCopyBuffer.h"
 #include "finalmq/serialize/IParserVisitor.h"
 #include "finalmq/serialize/ParserConverter.h"
+#include "finalmq/serialize/ParserAbortAndIndex.h"
+#include "finalmq/serialize/ParserProcessDefaultValues.h"
+#include "finalmq/serialize/ParserStage.h"
 #include "finalmq/json/JsonBuilder.h"
 
 namespace finalmq {
+/**
+ * @brief SerializerJsonInternal is the last visitor of the SerializerJson pipeline, it writes the data.
+ */
+class SerializerJsonInternal final : public IParserVisitor
+{
+public:
+    SerializerJsonInternal(IZeroCopyBuffer& buffer, int maxBlockSize, bool enumAsString);
+public:
+    // IParserVisitor
+    virtual void notifyError(const char* str, const char* message) override;
+    virtual void startStruct(const MetaStruct& stru) override;
+    virtual void finished() override;
+
+    virtual void enterStruct(const MetaField& field) override;
+    virtual void exitStruct(const MetaField& field) override;
+    virtual void enterStructNull(const MetaField& field) override;
+
+    virtual void enterArrayStruct(const MetaField& field) override;
+    virtual void exitArrayStruct(const MetaField& field) override;
+
+    virtual void enterBool(const MetaField& field, bool value) override;
+    virtual void enterInt8(const MetaField& field, std::int8_t value) override;
+    virtual void enterUInt8(const MetaField& field, std::uint8_t value) override;
+    virtual void enterInt16(const MetaField& field, std::int16_t value) override;
+    virtual void enterUInt16(const MetaField& field, std::uint16_t value) override;
+    virtual void enterInt32(const MetaField& field, std::int32_t value) override;
+    virtual void enterUInt32(const MetaField& field, std::uint32_t value) override;
+    virtual void enterInt64(const MetaField& field, std::int64_t value) override;
+    virtual void enterUInt64(const MetaField& field, std::uint64_t value) override;
+    virtual void enterFloat(const MetaField& field, float value) override;
+    virtual void enterDouble(const MetaField& field, double value) override;
+    virtual void enterString(const MetaField& field, std::string&& value) override;
+    virtual void enterString(const MetaField& field, const char* value, ssize_t size) override;
+    virtual void enterBytes(const MetaField& field, Bytes&& value) override;
+    virtual void enterBytes(const MetaField& field, const BytesElement* value, ssize_t size) override;
+    virtual void enterEnum(const MetaField& field, std::int32_t value) override;
+    virtual void enterEnum(const MetaField& field, std::string&& value) override;
+    virtual void enterEnum(const MetaField& field, const char* value, ssize_t size) override;
+    virtual void enterJsonString(const MetaField& field, std::string&& value) override;
+    virtual void enterJsonString(const MetaField& field, const char* value, ssize_t size) override;
+    virtual void enterJsonVariant(const MetaField& field, const Variant& value) override;
+    virtual void enterJsonVariantMove(const MetaField& field, Variant&& value) override;
+
+    virtual void enterArrayBoolMove(const MetaField& field, std::vector<bool>&& value) override;
+    virtual void enterArrayBool(const MetaField& field, const std::vector<bool>& value) override;
+    virtual void enterArrayInt8(const MetaField& field, std::vector<std::int8_t>&& value) override;
+    virtual void enterArrayInt8(const MetaField& field, const std::int8_t* value, ssize_t size) override;
+    virtual void enterArrayInt16(const MetaField& field, std::vector<std::int16_t>&& value) override;
+    virtual void enterArrayInt16(const MetaField& field, const std::int16_t* value, ssize_t size) override;
+    virtual void enterArrayUInt16(const MetaField& field, std::vector<std::uint16_t>&& value) override;
+    virtual void enterArrayUInt16(const MetaField& field, const std::uint16_t* value, ssize_t size) override;
+    virtual void enterArrayInt32(const MetaField& field, std::vector<std::int32_t>&& value) override;
+    virtual void enterArrayInt32(const MetaField& field, const std::int32_t* value, ssize_t size) override;
+    virtual void enterArrayUInt32(const MetaField& field, std::vector<std::uint32_t>&& value) override;
+    virtual void enterArrayUInt32(const MetaField& field, const std::uint32_t* value, ssize_t size) override;
+    virtual void enterArrayInt64(const MetaField& field, std::vector<std::int64_t>&& value) override;
+    virtual void enterArrayInt64(const MetaField& field, const std::int64_t* value, ssize_t size) override;
+    virtual void enterArrayUInt64(const MetaField& field, std::vector<std::uint64_t>&& value) override;
+    virtual void enterArrayUInt64(const MetaField& field, const std::uint64_t* value, ssize_t size) override;
+    virtual void enterArrayFloat(const MetaField& field, std::vector<float>&& value) override;
+    virtual void enterArrayFloat(const MetaField& field, const float* value, ssize_t size) override;
+    virtual void enterArrayDouble(const MetaField& field, std::vector<double>&& value) override;
+    virtual void enterArrayDouble(const MetaField& field, const double* value, ssize_t size) override;
+    virtual void enterArrayStringMove(const MetaField& field, std::vector<std::string>&& value) override;
+    virtual void enterArrayString(const MetaField& field, const std::vector<std::string>& value) override;
+    virtual void enterArrayBytesMove(const MetaField& field, std::vector<Bytes>&& value) override;
+    virtual void enterArrayBytes(const MetaField& field, const std::vector<Bytes>& value) override;
+    virtual void enterArrayEnum(const MetaField& field, std::vector<std::int32_t>&& value) override;
+    virtual void enterArrayEnum(const MetaField& field, const std::int32_t* value, ssize_t size) override;
+    virtual void enterArrayEnumMove(const MetaField& field, std::vector<std::string>&& value) override;
+    virtual void enterArrayEnum(const MetaField& field, const std::vector<std::string>& value) override;
+
+private:
+    void setKey(const MetaField& field);
 
-class SYMBOLEXP SerializerJson : public ParserConverter
+    void handleDouble(double value);
+
+    std::unique_ptr<JsonBuilder>    m_uniqueJsonBuilder;
+    JsonBuilder&                    m_jsonBuilder;
+    bool                            m_enumAsString = true;
+};
+
+class SYMBOLEXP SerializerJson : public ParserConverterT<ParserStage<ParserProcessDefaultValuesT, ParserStage<ParserAbortAndIndexT, SerializerJsonInternal>>>
 {
 public:
     SerializerJson(IZeroCopyBuffer& buffer, int maxBlockSize = 512, bool enumAsString = true, bool skipDefaultValues = true);
 
 private:
-    class Internal : public IParserVisitor
-    {
-    public:
-        Internal(IZeroCopyBuffer& buffer, int maxBlockSize, bool enumAsString);
-    private:
-        // IParserVisitor
-        virtual void notifyError(const char* str, const char* message) override;
-        virtual void startStruct(const MetaStruct& stru) override;
-        virtual void finished() override;
-
-        virtual void enterStruct(const MetaField& field) override;
-        virtual void exitStruct(const MetaField& field) override;
-        virtual void enterStructNull(const MetaField& field) override;
-
-        virtual void enterArrayStruct(const MetaField& field) override;
-        virtual void exitArrayStruct(const MetaField& field) override;
-
-        virtual void enterBool(const MetaField& field, bool value) override;
-        virtual void enterInt8(const MetaField& field, std::int8_t value) override;
-        virtual void enterUInt8(const MetaField& field, std::uint8_t value) override;
-        virtual void enterInt16(const MetaField& field, std::int16_t value) override;
-        virtual void enterUInt16(const MetaField& field, std::uint16_t value) override;
-        virtual void enterInt32(const MetaField& field, std::int32_t value) override;
-        virtual void enterUInt32(const MetaField& field, std::uint32_t value) override;
-        virtual void enterInt64(const MetaField& field, std::int64_t value) override;
-        virtual void enterUInt64(const MetaField& field, std::uint64_t value) override;
-        virtual void enterFloat(const MetaField& field, float value) override;
-        virtual void enterDouble(const MetaField& field, double value) override;
-        virtual void enterString(const MetaField& field, std::string&& value) override;
-        virtual void enterString(const MetaField& field, const char* value, ssize_t size) override;
-        virtual void enterBytes(const MetaField& field, Bytes&& value) override;
-        virtual void enterBytes(const MetaField& field, const BytesElement* value, ssize_t size) override;
-        virtual void enterEnum(const MetaField& field, std::int32_t value) override;
-        virtual void enterEnum(const MetaField& field, std::string&& value) override;
-        virtual void enterEnum(const MetaField& field, const char* value, ssize_t size) override;
-        virtual void enterJsonString(const MetaField& field, std::string&& value) override;
-        virtual void enterJsonString(const MetaField& field, const char* value, ssize_t size) override;
-        virtual void enterJsonVariant(const MetaField& field, const Variant& value) override;
-        virtual void enterJsonVariantMove(const MetaField& field, Variant&& value) override;
-
-        virtual void enterArrayBoolMove(const MetaField& field, std::vector<bool>&& value) override;
-        virtual void enterArrayBool(const MetaField& field, const std::vector<bool>& value) override;
-        virtual void enterArrayInt8(const MetaField& field, std::vector<std::int8_t>&& value) override;
-        virtual void enterArrayInt8(const MetaField& field, const std::int8_t* value, ssize_t size) override;
-        virtual void enterArrayInt16(const MetaField& field, std::vector<std::int16_t>&& value) override;
-        virtual void enterArrayInt16(const MetaField& field, const std::int16_t* value, ssize_t size) override;
-        virtual void enterArrayUInt16(const MetaField& field, std::vector<std::uint16_t>&& value) override;
-        virtual void enterArrayUInt16(const MetaField& field, const std::uint16_t* value, ssize_t size) override;
-        virtual void enterArrayInt32(const MetaField& field, std::vector<std::int32_t>&& value) override;
-        virtual void enterArrayInt32(const MetaField& field, const std::int32_t* value, ssize_t size) override;
-        virtual void enterArrayUInt32(const MetaField& field, std::vector<std::uint32_t>&& value) override;
-        virtual void enterArrayUInt32(const MetaField& field, const std::uint32_t* value, ssize_t size) override;
-        virtual void enterArrayInt64(const MetaField& field, std::vector<std::int64_t>&& value) override;
-        virtual void enterArrayInt64(const MetaField& field, const std::int64_t* value, ssize_t size) override;
-        virtual void enterArrayUInt64(const MetaField& field, std::vector<std::uint64_t>&& value) override;
-        virtual void enterArrayUInt64(const MetaField& field, const std::uint64_t* value, ssize_t size) override;
-        virtual void enterArrayFloat(const MetaField& field, std::vector<float>&& value) override;
-        virtual void enterArrayFloat(const MetaField& field, const float* value, ssize_t size) override;
-        virtual void enterArrayDouble(const MetaField& field, std::vector<double>&& value) override;
-        virtual void enterArrayDouble(const MetaField& field, const double* value, ssize_t size) override;
-        virtual void enterArrayStringMove(const MetaField& field, std::vector<std::string>&& value) override;
-        virtual void enterArrayString(const MetaField& field, const std::vector<std::string>& value) override;
-        virtual void enterArrayBytesMove(const MetaField& field, std::vector<Bytes>&& value) override;
-        virtual void enterArrayBytes(const MetaField& field, const std::vector<Bytes>& value) override;
-        virtual void enterArrayEnum(const MetaField& field, std::vector<std::int32_t>&& value) override;
-        virtual void enterArrayEnum(const MetaField& field, const std::int32_t* value, ssize_t size) override;
-        virtual void enterArrayEnumMove(const MetaField& field, std::vector<std::string>&& value) override;
-        virtual void enterArrayEnum(const MetaField& field, const std::vector<std::string>& value) override;
-
-        void setKey(const MetaField& field);
-
-        void handleDouble(double value);
-
-        std::unique_ptr<JsonBuilder>    m_uniqueJsonBuilder;
-        JsonBuilder&                    m_jsonBuilder;
-        bool                            m_enumAsString = true;
-    };
-
-    Internal                            m_internal;
-
-    std::unique_ptr<IParserVisitor>     m_parserAbortAndIndex;
-    std::unique_ptr<IParserVisitor>     m_parserProcessDefaultValues;
+    using AbortAndIndex = ParserStage<ParserAbortAndIndexT, SerializerJsonInternal>;
+    using ProcessDefaultValues = ParserStage<ParserProcessDefaultValuesT, AbortAndIndex>;
+
+    SerializerJsonInternal              m_internal;
+    AbortAndIndex                       m_parserAbortAndIndex;
+    ProcessDefaultValues                m_parserProcessDefaultValues;
 };
 
 }   // namespace finalmq
@@ -0,0 +1,550 @@
+//MIT License
+
+//Copyright (c) 2020 bexoft GmbH (mail@bexoft.de)
+
+//Permission is hereby granted, free of charge, to any person obtaining a copy
+//of this software and associated documentation files (the "Software"), to deal
+//in the Software without restriction, including without limitation the rights
+//to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//copies of the Software, and to permit persons to whom the Software is
+//furnished to do so, subject to the following conditions:
+
+//The above copyright notice and this permission notice shall be included in all
+//copies or substantial portions of the Software.
+
+//THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//SOFTWARE.
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <assert.h>
+#include <memory.h>
+
+#include "finalmq/helpers/FmqDefines.h"
+#include "finalmq/metadata/MetaField.h"
+#include "finalmq/metadata/MetaType.h"
+
+namespace finalmq
+{
+class StructBase;
+class ProtoView;
+
+/**
+ * @brief ParserProtoDirect is used by the generated code to read the fields of a struct
+ * directly from protobuf data, without the visitor pipeline (ParserProto -> SerializerStruct).
+ * It accepts the same wire formats as ParserProto.
+ */
+class SYMBOLEXP ParserProtoDirect
+{
+public:
+    template<class T>
+    static bool parse(const char* ptr, ssize_t size, T& root)
+    {
+        root.clear();
+        if (size == 0 && ptr == nullptr)
+        {
+            return true;
+        }
+        if (ptr == nullptr || size < 0)
+        {
+            return false;
+        }
+        ParserProtoDirect parser(ptr, size);
+        return root.parseProtoFields(parser);
+    }
+
+    /**
+     * @brief next reads the tag of the next field.
+     * @return false at the end of the struct or if the data is corrupt.
+     */
+    bool next()
+    {
+        if (m_ptr == nullptr || m_size <= 0)
+        {
+            return false;
+        }
+        m_tag = static_cast<std::uint32_t>(parseVarint());
+        return (m_ptr != nullptr);
+    }
+
+    int getId() const
+    {
+        return static_cast<int>(m_tag >> 3);
+    }
+
+    bool isValid() const
+    {
+        return (m_ptr != nullptr);
+    }
+
+    void skip();
+
+    void readBool(bool& value)
+    {
+        std::uint64_t v = 0;
+        if (parseValue(v, false))
+        {
+            value = (v != 0);
+        }
+    }
+
+    template<class T>
+    void readInt(T& value, int flags)
+    {
+        std::uint64_t v = 0;
+        if (parseValue(v, (flags & METAFLAG_PROTO_ZIGZAG) != 0))
+        {
+            value = static_cast<T>(v);
+        }
+    }
+
+    template<class T>
+    void readUInt(T& value)
+    {
+        std::uint64_t v = 0;
+        if (parseValue(v, false))
+        {
+            value = static_cast<T>(v);
+        }
+    }
+
+    void readFloat(float& value)
+    {
+        if (getWireType() == WIRETYPE_FIXED32)
+        {
+            value = parseFixed<float>();
+        }
+        else
+        {
+            skip();
+        }
+    }
+
+    void readDouble(double& value)
+    {
+        if (getWireType() == WIRETYPE_FIXED64)
+        {
+            value = parseFixed<double>();
+        }
+        else
+        {
+            skip();
+        }
+    }
+
+    template<class A>
+    void readString(std::basic_string<char, std::char_traits<char>, A>& value)
+    {
+        const char* buffer = nullptr;
+        ssize_t size = 0;
+        if (parseLengthDelimited(buffer, size))
+        {
+            value.assign(buffer, size);
+        }
+    }
+
+    template<class A>
+    void readBytes(std::vector<BytesElement, A>& value)
+    {
+        const char* buffer = nullptr;
+        ssize_t size = 0;
+        if (parseLengthDelimited(buffer, size))
+        {
+            value.assign(buffer, buffer + size);
+        }
+    }
+
+    /**
+     * @brief readEnum reads an enum value. Like in SerializerStruct, an unknown value is set to 0.
+     */
+    template<class E>
+    void readEnum(E& value)
+    {
+        std::uint64_t v = 0;
+        if (parseValue(v, false))
+        {
+            const std::int32_t valueEnum = static_cast<std::int32_t>(v);
+            value = static_cast<typename E::Enum>(E::enumInfo().getMetaEnum().isId(valueEnum) ? valueEnum : 0);
+        }
+    }
+
+    template<class T>
+    void readStruct(T& value)
+    {
+        const char* buffer = nullptr;
+        ssize_t size = 0;
+        if (parseLengthDelimited(buffer, size))
+        {
+            ParserProtoDirect parser(buffer, size);
+            if (!value.parseProtoFields(parser))
+            {
+                setInvalid();
+            }
+        }
+    }
+
+    template<class T>
+    void readStructPtr(std::shared_ptr<T>& value)
+    {
+        if (getWireType() == WIRETYPE_LENGTH_DELIMITED)
+        {
+            if (!value)
+            {
+                value = std::make_shared<T>();
+            }
+            readStruct(*value);
+        }
+        else
+        {
+            skip();
+        }
+    }
+
+    template<class T, class A>
+    void readArrayStruct(std::vector<T, A>& value)
+    {
+        if (getWireType() == WIRETYPE_LENGTH_DELIMITED)
+        {
+            reserveEntries(value);
+            value.emplace_back();
+            readStruct(value.back());
+        }
+        else
+        {
+            skip();
+        }
+    }
+
+    template<class A>
+    void readArrayBool(std::vector<bool, A>& value)
+    {
+        parseArrayVarint(value, false);
+    }
+
+    template<class T, class A>
+    void readArrayInt(std::vector<T, A>& value, int flags)
+    {
+        if (flags & METAFLAG_PROTO_VARINT)
+        {
+            parseArrayVarint(value, false);
+        }
+        else if (flags & METAFLAG_PROTO_ZIGZAG)
+        {
+            parseArrayVarint(value, true);
+        }
+        else if (sizeof(T) <= sizeof(std::int32_t))
+        {
+            parseArrayFixed<std::int32_t, WIRETYPE_FIXED32>(value);
+        }
+        else
+        {
+            parseArrayFixed<std::int64_t, WIRETYPE_FIXED64>(value);
+        }
+    }
+
+    template<class T, class A>
+    void readArrayUInt(std::vector<T, A>& value, int flags)
+    {
+        if (flags & METAFLAG_PROTO_VARINT)
+        {
+            parseArrayVarint(value, false);
+        }
+        else if (sizeof(T) <= sizeof(std::uint32_t))
+        {
+            parseArrayFixed<std::uint32_t, WIRETYPE_FIXED32>(value);
+        }
+        else
+        {
+            parseArrayFixed<std::uint64_t, WIRETYPE_FIXED64>(value);
+        }
+    }
+
+    template<class A>
+    void readArrayFloat(std::vector<float, A>& value)
+    {
+        parseArrayFixed<float, WIRETYPE_FIXED32>(value);
+    }
+
+    template<class A>
+    void readArrayDouble(std::vector<double, A>& value)
+    {
+        parseArrayFixed<double, WIRETYPE_FIXED64>(value);
+    }
+
+    template<class S, class A>
+    void readArrayString(std::vector<S, A>& value)
+    {
+        const char* buffer = nullptr;
+        ssize_t size = 0;
+        reserveEntries(value);
+        if (parseLengthDelimited(buffer, size))
+        {
+            value.emplace_back(buffer, size);
+        }
+    }
+
+    template<class B, class A>
+    void readArrayBytes(std::vector<B, A>& value)
+    {
+        const char* buffer = nullptr;
+        ssize_t size = 0;
+        reserveEntries(value);
+        if (parseLengthDelimited(buffer, size))
+        {
+            value.emplace_back(buffer, buffer + size);
+        }
+    }
+
+    template<class E, class A>
+    void readArrayEnum(std::vector<E, A>& value)
+    {
+        std::vector<std::int32_t> values;
+        parseArrayVarint(values, false);
+        value.reserve(value.size() + values.size());
+        for (size_t i = 0; i < values.size(); ++i)
+        {
+            value.emplace_back(static_cast<typename E::Enum>(values[i]));
+        }
+    }
+
+    /**
+     * @brief readStructFallback reads the fields of a struct with the visitor pipeline. It is used by
+     * the generated code for structs that need the features of the pipeline (variants, json, index and abort fields).
+     */
+    bool readStructFallback(StructBase& structBase);
+
+private:
+    friend class ProtoView;
+
+    enum WireType
+    {
+        WIRETYPE_VARINT = 0,
+        WIRETYPE_FIXED64 = 1,
+        WIRETYPE_LENGTH_DELIMITED = 2,
+        WIRETYPE_START_GROUP = 3,
+        WIRETYPE_END_GROUP = 4,
+        WIRETYPE_FIXED32 = 5,
+    };
+
+    ParserProtoDirect(const char* ptr, ssize_t size)
+        : m_ptr(ptr), m_size(size)
+    {
+    }
+
+    /**
+     * @brief countEntries counts the length delimited entries of a repeated field that follow
+     * each other with the same tag, starting at the current entry. It does not change the read position.
+     */
+    ssize_t countEntries() const;
+
+    /**
+     * @brief reserveEntries reserves the size of an array at its first entry, so that the
+     * array does not grow (and move its elements) entry by entry.
+     */
+    template<class T, class A>
+    void reserveEntries(std::vector<T, A>& value) const
+    {
+        if (value.empty())
+        {
+            value.reserve(countEntries());
+        }
+    }
+
+    WireType getWireType() const
+    {
+        return static_cast<WireType>(m_tag & 0x7);
+    }
+
+    void setInvalid()
+    {
+        m_ptr = nullptr;
+        m_size = 0;
+    }
+
+    static std::uint64_t zigzag(std::uint64_t value)
+    {
+        return static_cast<std::uint64_t>((value >> 1) ^ (~(value & 1) + 1));
+    }
+
+    std::uint64_t parseVarint()
+    {
+        if (m_size <= 0)
+        {
+            setInvalid();
+            return 0;
+        }
+        std::uint64_t c = static_cast<std::uint8_t>(*m_ptr);
+        std::uint64_t res = c;
+        ++m_ptr;
+        --m_size;
+        if (c < 128)
+        {
+            return res;
+        }
+        for (int shift = 7; shift < 70; shift += 7)
+        {
+            if (m_size <= 0)
+            {
+                break;
+            }
+            c = static_cast<std::uint8_t>(*m_ptr);
+            res += (c - 1) << shift;
+            ++m_ptr;
+            --m_size;
+            if (c < 128)
+            {
+                return res;
+            }
+        }
+        setInvalid();
+        return 0;
+    }
+
+    template<class T>
+    T parseFixed()
+    {
+        T value = 0;
+        if (m_size >= static_cast<ssize_t>(sizeof(T)))
+        {
+            EndianHelper<static_cast<int>(sizeof(T))>::read(m_ptr, value);
+            m_ptr += sizeof(T);
+            m_size -= sizeof(T);
+        }
+        else
+        {
+            setInvalid();
+        }
+        return value;
+    }
+
+    bool parseValue(std::uint64_t& value, bool zz)
+    {
+        switch (getWireType())
+        {
+        case WIRETYPE_VARINT:
+            value = parseVarint();
+            if (zz)
+            {
+                value = zigzag(value);
+            }
+            break;
+        case WIRETYPE_FIXED32:
+            value = parseFixed<std::uint32_t>();
+            break;
+        case WIRETYPE_FIXED64:
+            value = parseFixed<std::uint64_t>();
+            break;
+        default:
+            skip();
+            return false;
+        }
+        return (m_ptr != nullptr);
+    }
+
+    bool parseLengthDelimited(const char*& buffer, ssize_t& size)
+    {
+        if (getWireType() != WIRETYPE_LENGTH_DELIMITED)
+        {
+            skip();
+            return false;
+        }
+        const std::int32_t sizeBuffer = static_cast<std::int32_t>(parseVarint());
+        if (sizeBuffer >= 0 && sizeBuffer <= m_size && m_ptr)
+        {
+            buffer = m_ptr;
+            size = sizeBuffer;
+            m_ptr += sizeBuffer;
+            m_size -= sizeBuffer;
+            return true;
+        }
+        setInvalid();
+        return false;
+    }
+
+    template<class V, class A>
+    void parseArrayVarint(std::vector<V, A>& value, bool zz)
+    {
+        const WireType wireType = getWireType();
+        if (wireType == WIRETYPE_VARINT)
+        {
+            std::uint64_t v = parseVarint();
+            if (m_ptr)
+            {
+                value.push_back(static_cast<V>(zz ? zigzag(v) : v));
+            }
+        }
+        else if (wireType == WIRETYPE_LENGTH_DELIMITED)
+        {
+            const char* buffer = nullptr;
+            ssize_t size = 0;
+            if (parseLengthDelimited(buffer, size))
+            {
+                ParserProtoDirect parser(buffer, size);
+                while (parser.m_size > 0)
+                {
+                    std::uint64_t v = parser.parseVarint();
+                    if (parser.m_ptr == nullptr)
+                    {
+                        setInvalid();
+                        break;
+                    }
+                    value.push_back(static_cast<V>(zz ? zigzag(v) : v));
+                }
+            }
+        }
+        else
+        {
+            skip();
+        }
+    }
+
+    template<class T, int WIRETYPE, class V, class A>
+    void parseArrayFixed(std::vector<V, A>& value)
+    {
+        const WireType wireType = getWireType();
+        if (wireType == WIRETYPE)
+        {
+            T v = parseFixed<T>();
+            if (m_ptr)
+            {
+                value.push_back(static_cast<V>(v));
+            }
+        }
+        else if (wireType == WIRETYPE_LENGTH_DELIMITED)
+        {
+            const char* buffer = nullptr;
+            ssize_t size = 0;
+            if (parseLengthDelimited(buffer, size))
+            {
+                const ssize_t sizeElements = size / sizeof(T);
+                const size_t sizeBefore = value.size();
+                value.resize(sizeBefore + sizeElements);
+                for (ssize_t i = 0; i < sizeElements; ++i)
+                {
+                    T v;
+                    EndianHelper<static_cast<int>(sizeof(T))>::read(buffer + i * sizeof(T), v);
+                    value[sizeBefore + i] = static_cast<V>(v);
+                }
+            }
+        }
+        else
+        {
+            skip();
+        }
+    }
+
+    const char* m_ptr = nullptr;
+    ssize_t m_size = 0;
+    std::uint32_t m_tag = 0;
+};
+
+} // namespace finalmq
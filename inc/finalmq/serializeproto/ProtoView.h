@@ -0,0 +1,140 @@
+//MIT License
+
+//Copyright (c) 2020 bexoft GmbH (mail@bexoft.de)
+
+//Permission is hereby granted, free of charge, to any person obtaining a copy
+//of this software and associated documentation files (the "Software"), to deal
+//in the Software without restriction, including without limitation the rights
+//to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//copies of the Software, and to permit persons to whom the Software is
+//furnished to do so, subject to the following conditions:
+
+//The above copyright notice and this permission notice shall be included in all
+//copies or substantial portions of the Software.
+
+//THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//SOFTWARE.
+
+
+#pragma once
+
+#include <string_view>
+#include <vector>
+
+#include "ParserProtoDirect.h"
+#include "finalmq/helpers/FmqDefines.h"
+
+namespace finalmq
+{
+/**
+ * @brief ProtoView reads single fields of protobuf data without decoding the whole struct.
+ * The buffer is not copied, it must stay valid as long as the view (and the string views
+ * that it returns) are used. At the first access, the view indexes the positions of the fields
+ * in one pass over the buffer. Sub structs are only indexed, when they are accessed.
+ * If a field occurs more than once, the last occurrence is used. Arrays are not supported
+ * by the view, for them the struct has to be decoded. Only fields with ids below 1024 are indexed.
+ * A view is not thread-safe, because the index is built lazily.
+ * The generated code has a typed view for each struct (<struct name>View).
+ */
+class SYMBOLEXP ProtoView
+{
+public:
+    ProtoView() = default;
+    ProtoView(const char* buffer, ssize_t size);
+
+    /**
+     * @brief isValid returns false, if the data of the struct is corrupt.
+     */
+    bool isValid() const;
+
+    /**
+     * @brief hasField returns true, if the field with the given protobuf id is in the data.
+     */
+    bool hasField(int id) const;
+
+    bool getBool(int id) const
+    {
+        bool value = false;
+        getParser(id).readBool(value);
+        return value;
+    }
+
+    template<class T>
+    T getInt(int id, int flags) const
+    {
+        T value = 0;
+        getParser(id).readInt(value, flags);
+        return value;
+    }
+
+    template<class T>
+    T getUInt(int id) const
+    {
+        T value = 0;
+        getParser(id).readUInt(value);
+        return value;
+    }
+
+    float getFloat(int id) const
+    {
+        float value = 0;
+        getParser(id).readFloat(value);
+        return value;
+    }
+
+    double getDouble(int id) const
+    {
+        double value = 0;
+        getParser(id).readDouble(value);
+        return value;
+    }
+
+    /**
+     * @brief getString returns the string without copying it. The view points into the buffer.
+     */
+    std::string_view getString(int id) const;
+
+    /**
+     * @brief getBytes returns the bytes without copying them. The view points into the buffer.
+     */
+    std::string_view getBytes(int id) const
+    {
+        return getString(id);
+    }
+
+    template<class E>
+    E getEnum(int id) const
+    {
+        E value{};
+        getParser(id).readEnum(value);
+        return value;
+    }
+
+    /**
+     * @brief getStruct returns a view of a sub struct. If the field is not in the data, the view is empty.
+     */
+    ProtoView getStruct(int id) const;
+
+private:
+    struct FieldPosition
+    {
+        const char* ptr{nullptr};    // the data after the tag
+        std::uint32_t tag{0};
+    };
+
+    void buildIndex() const;
+    ParserProtoDirect getParser(int id) const;
+
+    const char* m_buffer{nullptr};
+    ssize_t m_size{0};
+    mutable std::vector<FieldPosition> m_fields{};
+    mutable bool m_indexed{false};
+    mutable bool m_valid{true};
+};
+
+} // namespace finalmq
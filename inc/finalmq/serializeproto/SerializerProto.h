@@ -23,17 +23,23 @@
 #pragma once
 
 #include <deque>
+#include <vector>
 
 #include "finalmq/helpers/IZeroCopyBuffer.h"
 #include "finalmq/metadata/MetaStruct.h"
 #include "finalmq/serialize/ParserConverter.h"
+#include "finalmq/serialize/ParserAbortAndIndex.h"
+#include "finalmq/serialize/ParserStage.h"
 
 namespace finalmq
 {
-class SYMBOLEXP SerializerProto : public ParserConverter
+/**
+ * @brief SerializerProtoInternal is the last visitor of the SerializerProto pipeline, it writes the data.
+ */
+class SerializerProtoInternal final : public IParserVisitor
 {
 public:
-    SerializerProto(IZeroCopyBuffer& buffer, int maxBlockSize = 512);
+    SerializerProtoInternal(IZeroCopyBuffer& buffer, int maxBlockSize, const std::vector<ssize_t>* structSizes);
 
 private:
     enum WireType
@@ -46,141 +52,285 @@ private:
         WIRETYPE_FIXED32 = 5,
     };
 
-    class Internal : public IParserVisitor
+    SerializerProtoInternal(const SerializerProtoInternal&) = delete;
+    SerializerProtoInternal(SerializerProtoInternal&&) = delete;
+    const SerializerProtoInternal& operator=(const SerializerProtoInternal&) = delete;
+    const SerializerProtoInternal& operator=(SerializerProtoInternal&&) = delete;
+
+public:
+    // IParserVisitor
+    virtual void notifyError(const char* str, const char* message) override;
+    virtual void startStruct(const MetaStruct& stru) override;
+    virtual void finished() override;
+
+    virtual void enterStruct(const MetaField& field) override;
+    virtual void exitStruct(const MetaField& field) override;
+    virtual void enterStructNull(const MetaField& field) override;
+
+    virtual void enterArrayStruct(const MetaField& field) override;
+    virtual void exitArrayStruct(const MetaField& field) override;
+
+    virtual void enterBool(const MetaField& field, bool value) override;
+    virtual void enterInt8(const MetaField& field, std::int8_t value) override;
+    virtual void enterUInt8(const MetaField& field, std::uint8_t value) override;
+    virtual void enterInt16(const MetaField& field, std::int16_t value) override;
+    virtual void enterUInt16(const MetaField& field, std::uint16_t value) override;
+    virtual void enterInt32(const MetaField& field, std::int32_t value) override;
+    virtual void enterUInt32(const MetaField& field, std::uint32_t value) override;
+    virtual void enterInt64(const MetaField& field, std::int64_t value) override;
+    virtual void enterUInt64(const MetaField& field, std::uint64_t value) override;
+    virtual void enterFloat(const MetaField& field, float value) override;
+    virtual void enterDouble(const MetaField& field, double value) override;
+    virtual void enterString(const MetaField& field, std::string&& value) override;
+    virtual void enterString(const MetaField& field, const char* value, ssize_t size) override;
+    virtual void enterBytes(const MetaField& field, Bytes&& value) override;
+    virtual void enterBytes(const MetaField& field, const BytesElement* value, ssize_t size) override;
+    virtual void enterEnum(const MetaField& field, std::int32_t value) override;
+    virtual void enterEnum(const MetaField& field, std::string&& value) override;
+    virtual void enterEnum(const MetaField& field, const char* value, ssize_t size) override;
+    virtual void enterJsonString(const MetaField& field, std::string&& value) override;
+    virtual void enterJsonString(const MetaField& field, const char* value, ssize_t size) override;
+    virtual void enterJsonVariant(const MetaField& field, const Variant& value) override;
+    virtual void enterJsonVariantMove(const MetaField& field, Variant&& value) override;
+
+    virtual void enterArrayBoolMove(const MetaField& field, std::vector<bool>&& value) override;
+    virtual void enterArrayBool(const MetaField& field, const std::vector<bool>& value) override;
+    virtual void enterArrayInt8(const MetaField& field, std::vector<std::int8_t>&& value) override;
+    virtual void enterArrayInt8(const MetaField& field, const std::int8_t* value, ssize_t size) override;
+    virtual void enterArrayInt16(const MetaField& field, std::vector<std::int16_t>&& value) override;
+    virtual void enterArrayInt16(const MetaField& field, const std::int16_t* value, ssize_t size) override;
+    virtual void enterArrayUInt16(const MetaField& field, std::vector<std::uint16_t>&& value) override;
+    virtual void enterArrayUInt16(const MetaField& field, const std::uint16_t* value, ssize_t size) override;
+    virtual void enterArrayInt32(const MetaField& field, std::vector<std::int32_t>&& value) override;
+    virtual void enterArrayInt32(const MetaField& field, const std::int32_t* value, ssize_t size) override;
+    virtual void enterArrayUInt32(const MetaField& field, std::vector<std::uint32_t>&& value) override;
+    virtual void enterArrayUInt32(const MetaField& field, const std::uint32_t* value, ssize_t size) override;
+    virtual void enterArrayInt64(const MetaField& field, std::vector<std::int64_t>&& value) override;
+    virtual void enterArrayInt64(const MetaField& field, const std::int64_t* value, ssize_t size) override;
+    virtual void enterArrayUInt64(const MetaField& field, std::vector<std::uint64_t>&& value) override;
+    virtual void enterArrayUInt64(const MetaField& field, const std::uint64_t* value, ssize_t size) override;
+    virtual void enterArrayFloat(const MetaField& field, std::vector<float>&& value) override;
+    virtual void enterArrayFloat(const MetaField& field, const float* value, ssize_t size) override;
+    virtual void enterArrayDouble(const MetaField& field, std::vector<double>&& value) override;
+    virtual void enterArrayDouble(const MetaField& field, const double* value, ssize_t size) override;
+    virtual void enterArrayStringMove(const MetaField& field, std::vector<std::string>&& value) override;
+    virtual void enterArrayString(const MetaField& field, const std::vector<std::string>& value) override;
+    virtual void enterArrayBytesMove(const MetaField& field, std::vector<Bytes>&& value) override;
+    virtual void enterArrayBytes(const MetaField& field, const std::vector<Bytes>& value) override;
+    virtual void enterArrayEnum(const MetaField& field, std::vector<std::int32_t>&& value) override;
+    virtual void enterArrayEnum(const MetaField& field, const std::int32_t* value, ssize_t size) override;
+    virtual void enterArrayEnumMove(const MetaField& field, std::vector<std::string>&& value) override;
+    virtual void enterArrayEnum(const MetaField& field, const std::vector<std::string>& value) override;
+
+private:
+    template<bool ignoreZeroLength>
+    void serializeString(int id, const char* value, ssize_t size);
+
+    char* serializeStruct(int id);
+
+    void serializeVarintValue(int id, std::uint64_t value);
+
+    void serializeZigZagValue(int id, std::int64_t value);
+
+    inline std::uint64_t zigzag(std::int64_t value);
+
+    template<class T, int WIRETYPE>
+    void serializeFixedValue(int id, T value);
+
+    template<class T>
+    void serializeArrayFixed(int id, const T* value, ssize_t size);
+
+    void serializeArrayBool(int id, const std::vector<bool>& value);
+    void serializeArrayString(int id, const std::vector<std::string>& value);
+    void serializeArrayBytes(int id, const std::vector<Bytes>& value);
+
+    template<class T>
+    void serializeArrayVarint(int id, const T* value, ssize_t size);
+
+    template<class T>
+    void serializeArrayZigZag(int id, const T* value, ssize_t size);
+
+    inline void serializeVarint(std::uint64_t value);
+    void reserveSpace(ssize_t space);
+    void resizeBuffer();
+    ssize_t calculateStructSize(ssize_t& structSize);
+    void fillRemainingStruct(ssize_t remainingSize);
+    void enterStructCanonical(int id);
+
+    struct StructData
     {
-    public:
-        Internal(IZeroCopyBuffer& buffer, int maxBlockSize);
-
-    private:
-        Internal(const Internal&) = delete;
-        Internal(Internal&&) = delete;
-        const Internal& operator=(const Internal&) = delete;
-        const Internal& operator=(Internal&&) = delete;
-
-        // IParserVisitor
-        virtual void notifyError(const char* str, const char* message) override;
-        virtual void startStruct(const MetaStruct& stru) override;
-        virtual void finished() override;
-
-        virtual void enterStruct(const MetaField& field) override;
-        virtual void exitStruct(const MetaField& field) override;
-        virtual void enterStructNull(const MetaField& field) override;
-
-        virtual void enterArrayStruct(const MetaField& field) override;
-        virtual void exitArrayStruct(const MetaField& field) override;
-
-        virtual void enterBool(const MetaField& field, bool value) override;
-        virtual void enterInt8(const MetaField& field, std::int8_t value) override;
-        virtual void enterUInt8(const MetaField& field, std::uint8_t value) override;
-        virtual void enterInt16(const MetaField& field, std::int16_t value) override;
-        virtual void enterUInt16(const MetaField& field, std::uint16_t value) override;
-        virtual void enterInt32(const MetaField& field, std::int32_t value) override;
-        virtual void enterUInt32(const MetaField& field, std::uint32_t value) override;
-        virtual void enterInt64(const MetaField& field, std::int64_t value) override;
-        virtual void enterUInt64(const MetaField& field, std::uint64_t value) override;
-        virtual void enterFloat(const MetaField& field, float value) override;
-        virtual void enterDouble(const MetaField& field, double value) override;
-        virtual void enterString(const MetaField& field, std::string&& value) override;
-        virtual void enterString(const MetaField& field, const char* value, ssize_t size) override;
-        virtual void enterBytes(const MetaField& field, Bytes&& value) override;
-        virtual void enterBytes(const MetaField& field, const BytesElement* value, ssize_t size) override;
-        virtual void enterEnum(const MetaField& field, std::int32_t value) override;
-        virtual void enterEnum(const MetaField& field, std::string&& value) override;
-        virtual void enterEnum(const MetaField& field, const char* value, ssize_t size) override;
-        virtual void enterJsonString(const MetaField& field, std::string&& value) override;
-        virtual void enterJsonString(const MetaField& field, const char* value, ssize_t size) override;
-        virtual void enterJsonVariant(const MetaField& field, const Variant& value) override;
-        virtual void enterJsonVariantMove(const MetaField& field, Variant&& value) override;
-
-        virtual void enterArrayBoolMove(const MetaField& field, std::vector<bool>&& value) override;
-        virtual void enterArrayBool(const MetaField& field, const std::vector<bool>& value) override;
-        virtual void enterArrayInt8(const MetaField& field, std::vector<std::int8_t>&& value) override;
-        virtual void enterArrayInt8(const MetaField& field, const std::int8_t* value, ssize_t size) override;
-        virtual void enterArrayInt16(const MetaField& field, std::vector<std::int16_t>&& value) override;
-        virtual void enterArrayInt16(const MetaField& field, const std::int16_t* value, ssize_t size) override;
-        virtual void enterArrayUInt16(const MetaField& field, std::vector<std::uint16_t>&& value) override;
-        virtual void enterArrayUInt16(const MetaField& field, const std::uint16_t* value, ssize_t size) override;
-        virtual void enterArrayInt32(const MetaField& field, std::vector<std::int32_t>&& value) override;
-        virtual void enterArrayInt32(const MetaField& field, const std::int32_t* value, ssize_t size) override;
-        virtual void enterArrayUInt32(const MetaField& field, std::vector<std::uint32_t>&& value) override;
-        virtual void enterArrayUInt32(const MetaField& field, const std::uint32_t* value, ssize_t size) override;
-        virtual void enterArrayInt64(const MetaField& field, std::vector<std::int64_t>&& value) override;
-        virtual void enterArrayInt64(const MetaField& field, const std::int64_t* value, ssize_t size) override;
-        virtual void enterArrayUInt64(const MetaField& field, std::vector<std::uint64_t>&& value) override;
-        virtual void enterArrayUInt64(const MetaField& field, const std::uint64_t* value, ssize_t size) override;
-        virtual void enterArrayFloat(const MetaField& field, std::vector<float>&& value) override;
-        virtual void enterArrayFloat(const MetaField& field, const float* value, ssize_t size) override;
-        virtual void enterArrayDouble(const MetaField& field, std::vector<double>&& value) override;
-        virtual void enterArrayDouble(const MetaField& field, const double* value, ssize_t size) override;
-        virtual void enterArrayStringMove(const MetaField& field, std::vector<std::string>&& value) override;
-        virtual void enterArrayString(const MetaField& field, const std::vector<std::string>& value) override;
-        virtual void enterArrayBytesMove(const MetaField& field, std::vector<Bytes>&& value) override;
-        virtual void enterArrayBytes(const MetaField& field, const std::vector<Bytes>& value) override;
-        virtual void enterArrayEnum(const MetaField& field, std::vector<std::int32_t>&& value) override;
-        virtual void enterArrayEnum(const MetaField& field, const std::int32_t* value, ssize_t size) override;
-        virtual void enterArrayEnumMove(const MetaField& field, std::vector<std::string>&& value) override;
-        virtual void enterArrayEnum(const MetaField& field, const std::vector<std::string>& value) override;
-
-        template<bool ignoreZeroLength>
-        void serializeString(int id, const char* value, ssize_t size);
-
-        char* serializeStruct(int id);
-
-        void serializeVarintValue(int id, std::uint64_t value);
-
-        void serializeZigZagValue(int id, std::int64_t value);
-
-        inline std::uint64_t zigzag(std::int64_t value);
-
-        template<class T, int WIRETYPE>
-        void serializeFixedValue(int id, T value);
-
-        template<class T>
-        void serializeArrayFixed(int id, const T* value, ssize_t size);
-
-        void serializeArrayBool(int id, const std::vector<bool>& value);
-        void serializeArrayString(int id, const std::vector<std::string>& value);
-        void serializeArrayBytes(int id, const std::vector<Bytes>& value);
-
-        template<class T>
-        void serializeArrayVarint(int id, const T* value, ssize_t size);
-
-        template<class T>
-        void serializeArrayZigZag(int id, const T* value, ssize_t size);
-
-        inline void serializeVarint(std::uint64_t value);
-        void reserveSpace(ssize_t space);
-        void resizeBuffer();
-        ssize_t calculateStructSize(ssize_t& structSize);
-        void fillRemainingStruct(ssize_t remainingSize);
-
-        struct StructData
+        StructData(char* bstart, char* bsize, char* b, bool ae)
+            : bufferStructStart(bstart), bufferStructSize(bsize), buffer(b), arrayEntry(ae)
         {
-            StructData(char* bstart, char* bsize, char* b, bool ae)
-                : bufferStructStart(bstart), bufferStructSize(bsize), buffer(b), arrayEntry(ae)
-            {
-            }
-            char* bufferStructStart = nullptr;
-            char* bufferStructSize = nullptr;
-            char* buffer = nullptr;
-            ssize_t size = 0;
-            bool allocateNextDataBuffer = false;
-            bool arrayParent = false;
-            bool arrayEntry = false;
-        };
-
-        IZeroCopyBuffer& m_zeroCopybuffer;
-        ssize_t m_maxBlockSize = 512;
-        char* m_bufferStart = nullptr;
-        char* m_buffer = nullptr;
-        char* m_bufferEnd = nullptr;
-        bool m_arrayParent = false;
-        std::deque<StructData> m_stackStruct{};
+        }
+        char* bufferStructStart = nullptr;
+        char* bufferStructSize = nullptr;
+        char* buffer = nullptr;
+        ssize_t size = 0;
+        bool allocateNextDataBuffer = false;
+        bool arrayParent = false;
+        bool arrayEntry = false;
     };
 
-    Internal m_internal;
+    IZeroCopyBuffer& m_zeroCopybuffer;
+    ssize_t m_maxBlockSize = 512;
+    char* m_bufferStart = nullptr;
+    char* m_buffer = nullptr;
+    char* m_bufferEnd = nullptr;
+    bool m_arrayParent = false;
+    std::deque<StructData> m_stackStruct{};
+    const std::vector<ssize_t>* m_structSizes = nullptr;
+    size_t m_indexStructSizes = 0;
+};
+
+/**
+ * @brief SerializerProtoSizeInternal is the last visitor of the SerializerProtoSize pipeline. It writes nothing,
+ * it only calculates the sizes of the sub structs like SerializerProtoInternal would serialize them.
+ */
+class SerializerProtoSizeInternal final : public IParserVisitor
+{
+public:
+    SerializerProtoSizeInternal(std::vector<ssize_t>& structSizes);
+
+private:
+    SerializerProtoSizeInternal(const SerializerProtoSizeInternal&) = delete;
+    SerializerProtoSizeInternal(SerializerProtoSizeInternal&&) = delete;
+    const SerializerProtoSizeInternal& operator=(const SerializerProtoSizeInternal&) = delete;
+    const SerializerProtoSizeInternal& operator=(SerializerProtoSizeInternal&&) = delete;
+
+public:
+    ssize_t getSize() const;
+
+    // IParserVisitor
+    virtual void notifyError(const char* str, const char* message) override;
+    virtual void startStruct(const MetaStruct& stru) override;
+    virtual void finished() override;
+
+    virtual void enterStruct(const MetaField& field) override;
+    virtual void exitStruct(const MetaField& field) override;
+    virtual void enterStructNull(const MetaField& field) override;
+
+    virtual void enterArrayStruct(const MetaField& field) override;
+    virtual void exitArrayStruct(const MetaField& field) override;
+
+    virtual void enterBool(const MetaField& field, bool value) override;
+    virtual void enterInt8(const MetaField& field, std::int8_t value) override;
+    virtual void enterUInt8(const MetaField& field, std::uint8_t value) override;
+    virtual void enterInt16(const MetaField& field, std::int16_t value) override;
+    virtual void enterUInt16(const MetaField& field, std::uint16_t value) override;
+    virtual void enterInt32(const MetaField& field, std::int32_t value) override;
+    virtual void enterUInt32(const MetaField& field, std::uint32_t value) override;
+    virtual void enterInt64(const MetaField& field, std::int64_t value) override;
+    virtual void enterUInt64(const MetaField& field, std::uint64_t value) override;
+    virtual void enterFloat(const MetaField& field, float value) override;
+    virtual void enterDouble(const MetaField& field, double value) override;
+    virtual void enterString(const MetaField& field, std::string&& value) override;
+    virtual void enterString(const MetaField& field, const char* value, ssize_t size) override;
+    virtual void enterBytes(const MetaField& field, Bytes&& value) override;
+    virtual void enterBytes(const MetaField& field, const BytesElement* value, ssize_t size) override;
+    virtual void enterEnum(const MetaField& field, std::int32_t value) override;
+    virtual void enterEnum(const MetaField& field, std::string&& value) override;
+    virtual void enterEnum(const MetaField& field, const char* value, ssize_t size) override;
+    virtual void enterJsonString(const MetaField& field, std::string&& value) override;
+    virtual void enterJsonString(const MetaField& field, const char* value, ssize_t size) override;
+    virtual void enterJsonVariant(const MetaField& field, const Variant& value) override;
+    virtual void enterJsonVariantMove(const MetaField& field, Variant&& value) override;
+
+    virtual void enterArrayBoolMove(const MetaField& field, std::vector<bool>&& value) override;
+    virtual void enterArrayBool(const MetaField& field, const std::vector<bool>& value) override;
+    virtual void enterArrayInt8(const MetaField& field, std::vector<std::int8_t>&& value) override;
+    virtual void enterArrayInt8(const MetaField& field, const std::int8_t* value, ssize_t size) override;
+    virtual void enterArrayInt16(const MetaField& field, std::vector<std::int16_t>&& value) override;
+    virtual void enterArrayInt16(const MetaField& field, const std::int16_t* value, ssize_t size) override;
+    virtual void enterArrayUInt16(const MetaField& field, std::vector<std::uint16_t>&& value) override;
+    virtual void enterArrayUInt16(const MetaField& field, const std::uint16_t* value, ssize_t size) override;
+    virtual void enterArrayInt32(const MetaField& field, std::vector<std::int32_t>&& value) override;
+    virtual void enterArrayInt32(const MetaField& field, const std::int32_t* value, ssize_t size) override;
+    virtual void enterArrayUInt32(const MetaField& field, std::vector<std::uint32_t>&& value) override;
+    virtual void enterArrayUInt32(const MetaField& field, const std::uint32_t* value, ssize_t size) override;
+    virtual void enterArrayInt64(const MetaField& field, std::vector<std::int64_t>&& value) override;
+    virtual void enterArrayInt64(const MetaField& field, const std::int64_t* value, ssize_t size) override;
+    virtual void enterArrayUInt64(const MetaField& field, std::vector<std::uint64_t>&& value) override;
+    virtual void enterArrayUInt64(const MetaField& field, const std::uint64_t* value, ssize_t size) override;
+    virtual void enterArrayFloat(const MetaField& field, std::vector<float>&& value) override;
+    virtual void enterArrayFloat(const MetaField& field, const float* value, ssize_t size) override;
+    virtual void enterArrayDouble(const MetaField& field, std::vector<double>&& value) override;
+    virtual void enterArrayDouble(const MetaField& field, const double* value, ssize_t size) override;
+    virtual void enterArrayStringMove(const MetaField& field, std::vector<std::string>&& value) override;
+    virtual void enterArrayString(const MetaField& field, const std::vector<std::string>& value) override;
+    virtual void enterArrayBytesMove(const MetaField& field, std::vector<Bytes>&& value) override;
+    virtual void enterArrayBytes(const MetaField& field, const std::vector<Bytes>& value) override;
+    virtual void enterArrayEnum(const MetaField& field, std::vector<std::int32_t>&& value) override;
+    virtual void enterArrayEnum(const MetaField& field, const std::int32_t* value, ssize_t size) override;
+    virtual void enterArrayEnumMove(const MetaField& field, std::vector<std::string>&& value) override;
+    virtual void enterArrayEnum(const MetaField& field, const std::vector<std::string>& value) override;
+
+private:
+    void sizeVarintValue(int id, std::uint64_t value);
+    void sizeString(int id, ssize_t size);
+
+    template<class T>
+    void sizeFixedValue(int id, T value);
+
+    template<class T>
+    void sizeArrayFixed(int id, ssize_t size);
+
+    template<class T>
+    void sizeArrayVarint(int id, const T* value, ssize_t size);
+
+    template<class T>
+    void sizeArrayZigZag(int id, const T* value, ssize_t size);
+
+    struct StructData
+    {
+        size_t indexStructSize = 0;
+        ssize_t sizeParent = 0;
+        bool arrayParent = false;
+        bool arrayEntry = false;
+    };
+
+    std::vector<ssize_t>& m_structSizes;
+    ssize_t m_size = 0;
+    bool m_arrayParent = false;
+    std::deque<StructData> m_stackStruct{};
+};
+
+class SYMBOLEXP SerializerProto : public ParserConverterT<ParserStage<ParserAbortAndIndexT, SerializerProtoInternal>>
+{
+public:
+    /**
+     * @param structSizes if set, the serializer writes canonical protobuf (no padding of the struct sizes).
+     * The sizes of the sub structs must be calculated before by SerializerProtoSize from the same input,
+     * so that the serializer can write each struct size directly in front of the struct.
+     */
+    SerializerProto(IZeroCopyBuffer& buffer, int maxBlockSize = 512, const std::vector<ssize_t>* structSizes = nullptr);
+
+private:
+    using AbortAndIndex = ParserStage<ParserAbortAndIndexT, SerializerProtoInternal>;
+
+    SerializerProtoInternal m_internal;
+    AbortAndIndex m_parserAbortAndIndex;
+};
+
+/**
+ * @brief SerializerProtoSize is the first walk of the canonical protobuf serialization. It calculates the sizes
+ * of all sub structs in the order in which they are entered, like protobuf's ByteSize does.
+ */
+class SYMBOLEXP SerializerProtoSize : public ParserConverterT<ParserStage<ParserAbortAndIndexT, SerializerProtoSizeInternal>>
+{
+public:
+    SerializerProtoSize(std::vector<ssize_t>& structSizes);
+
+    /**
+     * @brief getSize returns the size of the whole serialized data, after the input was parsed.
+     */
+    ssize_t getSize() const;
+
+private:
+    using AbortAndIndex = ParserStage<ParserAbortAndIndexT, SerializerProtoSizeInternal>;
 
-    std::unique_ptr<IParserVisitor> m_parserAbortAndIndex;
+    SerializerProtoSizeInternal m_internal;
+    AbortAndIndex m_parserAbortAndIndex;
 };
 
 } // namespace finalmq
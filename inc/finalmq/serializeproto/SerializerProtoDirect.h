@@ -0,0 +1,520 @@
+//MIT License
+
+//Copyright (c) 2020 bexoft GmbH (mail@bexoft.de)
+
+//Permission is hereby granted, free of charge, to any person obtaining a copy
+//of this software and associated documentation files (the "Software"), to deal
+//in the Software without restriction, including without limitation the rights
+//to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//copies of the Software, and to permit persons to whom the Software is
+//furnished to do so, subject to the following conditions:
+
+//The above copyright notice and this permission notice shall be included in all
+//copies or substantial portions of the Software.
+
+//THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//SOFTWARE.
+
+#pragma once
+
+#include <deque>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include <assert.h>
+#include <memory.h>
+
+#include "finalmq/helpers/FmqDefines.h"
+#include "finalmq/helpers/IZeroCopyBuffer.h"
+#include "finalmq/metadata/MetaField.h"
+#include "finalmq/metadata/MetaType.h"
+
+namespace finalmq
+{
+class StructBase;
+
+/**
+ * @brief SerializerProtoDirect is used by the generated code to write the fields of a struct
+ * directly in protobuf format, without the visitor pipeline (ParserStruct -> SerializerProto).
+ * The generated function serializeProtoFields() is called twice: The first pass calculates the sizes
+ * of the struct and of all sub structs, the second pass writes the fields into one buffer of the exact size.
+ * The wire format is the same as the one of SerializerProto.
+ */
+class SYMBOLEXP SerializerProtoDirect
+{
+public:
+    template<class T>
+    static void serialize(IZeroCopyBuffer& buffer, const T& root)
+    {
+        SerializerProtoDirect serializer;
+        root.serializeProtoFields(serializer);
+        if (serializer.startWriting(buffer))
+        {
+            root.serializeProtoFields(serializer);
+            serializer.finished();
+        }
+    }
+
+    void writeBool(int id, bool value)
+    {
+        writeVarintValue(id, value ? 1 : 0);
+    }
+
+    void writeInt32(int id, std::int32_t value, int flags)
+    {
+        if (flags & METAFLAG_PROTO_VARINT)
+        {
+            writeVarintValue(id, static_cast<std::uint64_t>(static_cast<std::int64_t>(value)));
+        }
+        else if (flags & METAFLAG_PROTO_ZIGZAG)
+        {
+            writeVarintValue(id, zigzag(value));
+        }
+        else
+        {
+            writeFixedValue<std::int32_t, WIRETYPE_FIXED32>(id, value);
+        }
+    }
+
+    void writeUInt32(int id, std::uint32_t value, int flags)
+    {
+        if (flags & METAFLAG_PROTO_VARINT)
+        {
+            writeVarintValue(id, value);
+        }
+        else
+        {
+            writeFixedValue<std::uint32_t, WIRETYPE_FIXED32>(id, value);
+        }
+    }
+
+    void writeInt64(int id, std::int64_t value, int flags)
+    {
+        if (flags & METAFLAG_PROTO_VARINT)
+        {
+            writeVarintValue(id, static_cast<std::uint64_t>(value));
+        }
+        else if (flags & METAFLAG_PROTO_ZIGZAG)
+        {
+            writeVarintValue(id, zigzag(value));
+        }
+        else
+        {
+            writeFixedValue<std::int64_t, WIRETYPE_FIXED64>(id, value);
+        }
+    }
+
+    void writeUInt64(int id, std::uint64_t value, int flags)
+    {
+        if (flags & METAFLAG_PROTO_VARINT)
+        {
+            writeVarintValue(id, value);
+        }
+        else
+        {
+            writeFixedValue<std::uint64_t, WIRETYPE_FIXED64>(id, value);
+        }
+    }
+
+    void writeFloat(int id, float value)
+    {
+        writeFixedValue<float, WIRETYPE_FIXED32>(id, value);
+    }
+
+    void writeDouble(int id, double value)
+    {
+        writeFixedValue<double, WIRETYPE_FIXED64>(id, value);
+    }
+
+    template<class A>
+    void writeString(int id, const std::basic_string<char, std::char_traits<char>, A>& value)
+    {
+        if (!value.empty())
+        {
+            writeLengthDelimited(id, value.data(), value.size());
+        }
+    }
+
+    template<class A>
+    void writeBytes(int id, const std::vector<BytesElement, A>& value)
+    {
+        if (!value.empty())
+        {
+            writeLengthDelimited(id, value.data(), value.size());
+        }
+    }
+
+    template<class E>
+    void writeEnum(int id, const E& value)
+    {
+        writeVarintValue(id, static_cast<std::uint64_t>(static_cast<std::int64_t>(static_cast<std::int32_t>(value))));
+    }
+
+    /**
+     * @brief writeStruct writes a sub struct. Like in SerializerProto, an empty struct is only written as an array entry.
+     */
+    template<class T>
+    void writeStruct(int id, const T& value, bool arrayEntry = false)
+    {
+        const std::uint32_t tag = (id << 3) | WIRETYPE_LENGTH_DELIMITED;
+        if (m_buffer == nullptr)
+        {
+            const size_t index = m_structSizes.size();
+            m_structSizes.push_back(0);
+            const ssize_t sizeBefore = m_size;
+            value.serializeProtoFields(*this);
+            const ssize_t sizeStruct = m_size - sizeBefore;
+            m_structSizes[index] = sizeStruct;
+            if (sizeStruct > 0 || arrayEntry)
+            {
+                m_size += sizeVarint(tag) + sizeVarint(sizeStruct);
+            }
+        }
+        else
+        {
+            assert(m_indexStructSizes < m_structSizes.size());
+            const ssize_t sizeStruct = m_structSizes[m_indexStructSizes];
+            ++m_indexStructSizes;
+            if (sizeStruct > 0 || arrayEntry)
+            {
+                writeVarint(tag);
+                writeVarint(sizeStruct);
+            }
+            value.serializeProtoFields(*this);
+        }
+    }
+
+    template<class T>
+    void writeStructPtr(int id, const std::shared_ptr<T>& value)
+    {
+        if (value)
+        {
+            writeStruct(id, *value);
+        }
+    }
+
+    template<class T, class A>
+    void writeArrayStruct(int id, const std::vector<T, A>& value)
+    {
+        for (size_t i = 0; i < value.size(); ++i)
+        {
+            writeStruct(id, value[i], true);
+        }
+    }
+
+    template<class A>
+    void writeArrayBool(int id, const std::vector<bool, A>& value)
+    {
+        if (value.empty())
+        {
+            return;
+        }
+        const ssize_t sizeByte = value.size();
+        if (m_buffer == nullptr)
+        {
+            m_size += sizeTag(id, WIRETYPE_LENGTH_DELIMITED) + sizeVarint(sizeByte) + sizeByte;
+        }
+        else
+        {
+            writeTag(id, WIRETYPE_LENGTH_DELIMITED);
+            writeVarint(sizeByte);
+            assert(m_buffer + sizeByte <= m_bufferEnd);
+            for (size_t i = 0; i < value.size(); ++i)
+            {
+                *m_buffer = value[i] ? 1 : 0;
+                ++m_buffer;
+            }
+        }
+    }
+
+    template<class T, class A>
+    void writeArrayInt32(int id, const std::vector<T, A>& value, int flags)
+    {
+        if (flags & METAFLAG_PROTO_VARINT)
+        {
+            writeArrayVarint(id, value, [] (T v) { return static_cast<std::uint64_t>(static_cast<std::int64_t>(v)); });
+        }
+        else if (flags & METAFLAG_PROTO_ZIGZAG)
+        {
+            writeArrayVarint(id, value, [] (T v) { return zigzag(v); });
+        }
+        else
+        {
+            writeArrayFixed<std::int32_t>(id, value);
+        }
+    }
+
+    template<class T, class A>
+    void writeArrayUInt32(int id, const std::vector<T, A>& value, int flags)
+    {
+        if (flags & METAFLAG_PROTO_VARINT)
+        {
+            writeArrayVarint(id, value, [] (T v) { return static_cast<std::uint64_t>(v); });
+        }
+        else
+        {
+            writeArrayFixed<std::uint32_t>(id, value);
+        }
+    }
+
+    template<class A>
+    void writeArrayInt64(int id, const std::vector<std::int64_t, A>& value, int flags)
+    {
+        if (flags & METAFLAG_PROTO_VARINT)
+        {
+            writeArrayVarint(id, value, [] (std::int64_t v) { return static_cast<std::uint64_t>(v); });
+        }
+        else if (flags & METAFLAG_PROTO_ZIGZAG)
+        {
+            writeArrayVarint(id, value, [] (std::int64_t v) { return zigzag(v); });
+        }
+        else
+        {
+            writeArrayFixed<std::int64_t>(id, value);
+        }
+    }
+
+    template<class A>
+    void writeArrayUInt64(int id, const std::vector<std::uint64_t, A>& value, int flags)
+    {
+        if (flags & METAFLAG_PROTO_VARINT)
+        {
+            writeArrayVarint(id, value, [] (std::uint64_t v) { return v; });
+        }
+        else
+        {
+            writeArrayFixed<std::uint64_t>(id, value);
+        }
+    }
+
+    template<class A>
+    void writeArrayFloat(int id, const std::vector<float, A>& value)
+    {
+        writeArrayFixed<float>(id, value);
+    }
+
+    template<class A>
+    void writeArrayDouble(int id, const std::vector<double, A>& value)
+    {
+        writeArrayFixed<double>(id, value);
+    }
+
+    template<class S, class A>
+    void writeArrayString(int id, const std::vector<S, A>& value)
+    {
+        for (size_t i = 0; i < value.size(); ++i)
+        {
+            writeLengthDelimited(id, value[i].data(), value[i].size());
+        }
+    }
+
+    template<class B, class A>
+    void writeArrayBytes(int id, const std::vector<B, A>& value)
+    {
+        for (size_t i = 0; i < value.size(); ++i)
+        {
+            writeLengthDelimited(id, value[i].data(), value[i].size());
+        }
+    }
+
+    template<class E, class A>
+    void writeArrayEnum(int id, const std::vector<E, A>& value)
+    {
+        writeArrayVarint(id, value, [] (const E& v) { return static_cast<std::uint64_t>(static_cast<std::int64_t>(static_cast<std::int32_t>(v))); });
+    }
+
+    /**
+     * @brief writeStructFallback writes the fields of a struct with the visitor pipeline. It is used by
+     * the generated code for structs that need the features of the pipeline (variants, json, index and abort fields).
+     */
+    void writeStructFallback(const StructBase& structBase);
+
+private:
+    enum WireType
+    {
+        WIRETYPE_VARINT = 0,
+        WIRETYPE_FIXED64 = 1,
+        WIRETYPE_LENGTH_DELIMITED = 2,
+        WIRETYPE_FIXED32 = 5,
+    };
+
+    SerializerProtoDirect() = default;
+
+    bool startWriting(IZeroCopyBuffer& buffer);
+    void finished();
+
+    static std::uint64_t zigzag(std::int64_t value)
+    {
+        return (static_cast<std::uint64_t>(value) << 1) ^ static_cast<std::uint64_t>(value >> 63);
+    }
+
+    static ssize_t sizeVarint(std::uint64_t value)
+    {
+        ssize_t size = 1;
+        while (value >= 0x80)
+        {
+            value >>= 7;
+            ++size;
+        }
+        return size;
+    }
+
+    static ssize_t sizeTag(int id, int wireType)
+    {
+        return sizeVarint(static_cast<std::uint32_t>((id << 3) | wireType));
+    }
+
+    void writeVarint(std::uint64_t value)
+    {
+        assert(m_buffer + sizeVarint(value) <= m_bufferEnd);
+        while (value >= 0x80)
+        {
+            *m_buffer = static_cast<char>(value | 0x80);
+            value >>= 7;
+            ++m_buffer;
+        }
+        *m_buffer = static_cast<char>(value);
+        ++m_buffer;
+    }
+
+    void writeTag(int id, int wireType)
+    {
+        writeVarint(static_cast<std::uint32_t>((id << 3) | wireType));
+    }
+
+    void writeVarintValue(int id, std::uint64_t value)
+    {
+        if (value == 0)
+        {
+            return;
+        }
+        if (m_buffer == nullptr)
+        {
+            m_size += sizeTag(id, WIRETYPE_VARINT) + sizeVarint(value);
+        }
+        else
+        {
+            writeTag(id, WIRETYPE_VARINT);
+            writeVarint(value);
+        }
+    }
+
+    template<class T, int WIRETYPE>
+    void writeFixedValue(int id, T value)
+    {
+#ifndef WIN32
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wfloat-equal"
+#endif
+        if (value == 0)
+#ifndef WIN32
+#pragma GCC diagnostic pop
+#endif
+        {
+            return;
+        }
+        if (m_buffer == nullptr)
+        {
+            m_size += sizeTag(id, WIRETYPE) + sizeof(T);
+        }
+        else
+        {
+            writeTag(id, WIRETYPE);
+            assert(m_buffer + sizeof(T) <= m_bufferEnd);
+            EndianHelper<static_cast<int>(sizeof(T))>::write(m_buffer, value);
+            m_buffer += sizeof(T);
+        }
+    }
+
+    void writeLengthDelimited(int id, const char* value, ssize_t size)
+    {
+        if (m_buffer == nullptr)
+        {
+            m_size += sizeTag(id, WIRETYPE_LENGTH_DELIMITED) + sizeVarint(size) + size;
+        }
+        else
+        {
+            writeTag(id, WIRETYPE_LENGTH_DELIMITED);
+            writeVarint(size);
+            assert(m_buffer + size <= m_bufferEnd);
+            memcpy(m_buffer, value, size);
+            m_buffer += size;
+        }
+    }
+
+    template<class T, class V, class A>
+    void writeArrayFixed(int id, const std::vector<V, A>& value)
+    {
+        if (value.empty())
+        {
+            return;
+        }
+        const ssize_t sizeByte = value.size() * sizeof(T);
+        if (m_buffer == nullptr)
+        {
+            m_size += sizeTag(id, WIRETYPE_LENGTH_DELIMITED) + sizeVarint(sizeByte) + sizeByte;
+        }
+        else
+        {
+            writeTag(id, WIRETYPE_LENGTH_DELIMITED);
+            writeVarint(sizeByte);
+            assert(m_buffer + sizeByte <= m_bufferEnd);
+#ifdef FINALMQ_LITTLE_ENDIAN
+            if (std::is_same<T, V>::value)
+            {
+                memcpy(m_buffer, value.data(), sizeByte);
+                m_buffer += sizeByte;
+                return;
+            }
+#endif
+            for (size_t i = 0; i < value.size(); ++i)
+            {
+                EndianHelper<static_cast<int>(sizeof(T))>::write(m_buffer, static_cast<T>(value[i]));
+                m_buffer += sizeof(T);
+            }
+        }
+    }
+
+    template<class V, class A, class F>
+    void writeArrayVarint(int id, const std::vector<V, A>& value, F toVarint)
+    {
+        if (value.empty())
+        {
+            return;
+        }
+        // not packed, like SerializerProto
+        const ssize_t sizeTagVarint = sizeTag(id, WIRETYPE_VARINT);
+        if (m_buffer == nullptr)
+        {
+            for (size_t i = 0; i < value.size(); ++i)
+            {
+                m_size += sizeTagVarint + sizeVarint(toVarint(value[i]));
+            }
+        }
+        else
+        {
+            for (size_t i = 0; i < value.size(); ++i)
+            {
+                writeTag(id, WIRETYPE_VARINT);
+                writeVarint(toVarint(value[i]));
+            }
+        }
+    }
+
+    ssize_t m_size = 0;
+    std::vector<ssize_t> m_structSizes{};
+    size_t m_indexStructSizes = 0;
+    std::deque<std::string> m_fallbackData{};
+    size_t m_indexFallbackData = 0;
+    char* m_buffer = nullptr;
+    char* m_bufferEnd = nullptr;
+};
+
+} // namespace finalmq
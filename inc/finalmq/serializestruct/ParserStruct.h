@@ -43,6 +43,7 @@ public:
 
 private:
     void parseStruct(const StructBase& structBase);
+    template<bool PMR>
     void processField(const StructBase& structBase, const FieldInfo& fieldInfo);
 
     IParserVisitor&     m_visitor;
@@ -24,6 +24,8 @@
 
 #include <cstdint>
 #include <functional>
+#include <memory_resource>
+#include <type_traits>
 #include <vector>
 
 #include <assert.h>
@@ -36,6 +38,7 @@
 namespace finalmq
 {
 class StructBase;
+struct IZeroCopyBuffer;
 typedef std::shared_ptr<StructBase> StructBasePtr;
 
 struct IArrayStructAdapter
@@ -54,27 +57,28 @@ struct IStructPtrAdapter
     virtual StructBasePtr create() const = 0;
 };
 
-template<class T>
+template<class T, class V = std::vector<T>>
 class ArrayStructAdapter : public IArrayStructAdapter
 {
 private:
     // IArrayStructAdapter
     virtual StructBase* add(char& array) override
     {
-        std::vector<T>& vect = reinterpret_cast<std::vector<T>&>(array);
-        vect.resize(vect.size() + 1);
+        // emplace_back passes the allocator of a std::pmr::vector to the new entry
+        V& vect = reinterpret_cast<V&>(array);
+        vect.emplace_back();
         return &vect.back();
     }
 
     virtual ssize_t size(const char& array) const override
     {
-        const std::vector<T>& vect = reinterpret_cast<const std::vector<T>&>(array);
+        const V& vect = reinterpret_cast<const V&>(array);
         return vect.size();
     }
 
     virtual const StructBase& at(const char& array, ssize_t index) const override
     {
-        const std::vector<T>& vect = reinterpret_cast<const std::vector<T>&>(array);
+        const V& vect = reinterpret_cast<const V&>(array);
         assert(index >= 0 && index < static_cast<ssize_t>(vect.size()));
         return vect[index];
     }
@@ -126,11 +130,12 @@ private:
 };
 
 typedef std::function<std::shared_ptr<StructBase>()> FuncStructBaseFactory;
+typedef std::function<std::shared_ptr<StructBase>(const std::shared_ptr<std::pmr::memory_resource>& arena)> FuncStructBaseArenaFactory;
 
 class SYMBOLEXP StructInfo
 {
 public:
-    StructInfo(const std::string& typeName, const std::string& description, int flags, const std::vector<std::string>& attrs, FuncStructBaseFactory factory, std::vector<MetaField>&& fields, std::vector<FieldInfo>&& fieldInfos);
+    StructInfo(const std::string& typeName, const std::string& description, int flags, const std::vector<std::string>& attrs, FuncStructBaseFactory factory, std::vector<MetaField>&& fields, std::vector<FieldInfo>&& fieldInfos, FuncStructBaseArenaFactory arenaFactory = nullptr);
 
     inline const std::string& getTypeName() const
     {
@@ -227,6 +232,26 @@ public:
     virtual const StructInfo& getStructInfo() const = 0;
     virtual std::shared_ptr<StructBase> clone() const = 0;
 
+    /**
+     * @brief serializeProto serializes the struct in protobuf format. The generated code overrides it and
+     * writes the fields directly. The default implementation uses the visitor pipeline (ParserStruct -> SerializerProto).
+     */
+    virtual void serializeProto(IZeroCopyBuffer& buffer) const;
+
+    /**
+     * @brief serializeProtoCanonical serializes the struct in canonical protobuf format (minimal struct sizes, no padding).
+     * The default implementation walks the struct twice: SerializerProtoSize calculates the sizes of the sub structs,
+     * then SerializerProto writes them directly. The generated code overrides it, because it is always canonical.
+     */
+    virtual void serializeProtoCanonical(IZeroCopyBuffer& buffer) const;
+
+    /**
+     * @brief parseProto parses protobuf data into the struct. The generated code overrides it and
+     * reads the fields directly. The default implementation uses the visitor pipeline (ParserProto -> SerializerStruct).
+     * @return false, if the data is corrupt.
+     */
+    virtual bool parseProto(const char* buffer, ssize_t size);
+
 private:
     struct RawData
     {
@@ -274,6 +299,60 @@ private:
 
 typedef std::shared_ptr<StructBase> StructBasePtr;
 
+/**
+ * @brief PmrType is the type of a field inside a struct with METASTRUCTFLAG_PMR. Its strings and
+ * arrays use the polymorphic allocator of the struct.
+ */
+template<class T>
+struct PmrType
+{
+    using Type = T;
+};
+template<>
+struct PmrType<std::string>
+{
+    using Type = std::pmr::string;
+};
+template<class T>
+struct PmrType<std::vector<T>>
+{
+    using Type = std::pmr::vector<typename PmrType<T>::Type>;
+};
+
+/**
+ * @brief makeWithAllocator constructs a field of a struct with METASTRUCTFLAG_PMR. Strings, arrays and
+ * sub structs get the allocator, all other types are constructed without it.
+ */
+template<class T, class... Args>
+T makeWithAllocator(const std::pmr::polymorphic_allocator<char>& allocator, Args&&... args)
+{
+    if constexpr (std::uses_allocator<T, std::pmr::polymorphic_allocator<char>>::value)
+    {
+        return T(std::forward<Args>(args)..., allocator);
+    }
+    else
+    {
+        return T(std::forward<Args>(args)...);
+    }
+}
+
+/**
+ * @brief createStructInArena creates a struct with METASTRUCTFLAG_PMR inside the arena. All its strings
+ * and arrays are allocated from the arena as well. The struct keeps the arena alive, the memory is
+ * released in one shot, when the arena is released.
+ */
+template<class T>
+std::shared_ptr<T> createStructInArena(const std::shared_ptr<std::pmr::memory_resource>& arena)
+{
+    assert(arena);
+    std::pmr::polymorphic_allocator<T> allocator(arena.get());
+    T* structBase = allocator.allocate(1);
+    allocator.construct(structBase);
+    return std::shared_ptr<T>(structBase, [arena](T* p) {
+        p->~T();
+    });
+}
+
 #define OFFSET_STRUCTBASE_TO_PARAM(type, param) (static_cast<int>(reinterpret_cast<long long>(&(reinterpret_cast<type*>(1000))->param) - (reinterpret_cast<long long>(reinterpret_cast<StructBase*>(reinterpret_cast<type*>(1000))))))
 #define OFFSET_STRUCTBASE_TO_STRUCTBASE(type, param) (static_cast<int>(reinterpret_cast<long long>(reinterpret_cast<StructBase*>(&(reinterpret_cast<type*>(1000))->param)) - (reinterpret_cast<long long>(reinterpret_cast<StructBase*>(reinterpret_cast<type*>(1000))))))
 
@@ -36,7 +36,14 @@ struct IStructFactoryRegistry
     virtual ~IStructFactoryRegistry()
     {}
     virtual void registerFactory(const std::string& typeName, FuncStructBaseFactory factory) = 0;
+    virtual void registerArenaFactory(const std::string& typeName, FuncStructBaseArenaFactory factory) = 0;
     virtual std::shared_ptr<StructBase> createStruct(const std::string& typeName) = 0;
+
+    /**
+     * @brief createStruct creates a struct with METASTRUCTFLAG_PMR inside the arena. Structs without
+     * the flag are created with the default factory.
+     */
+    virtual std::shared_ptr<StructBase> createStruct(const std::string& typeName, const std::shared_ptr<std::pmr::memory_resource>& arena) = 0;
 };
 
 class SYMBOLEXP StructFactoryRegistryImpl : public IStructFactoryRegistry
@@ -45,9 +52,12 @@ public:
 private:
     // IStructFactoryRegistry
     virtual void registerFactory(const std::string& typeName, FuncStructBaseFactory factory) override;
+    virtual void registerArenaFactory(const std::string& typeName, FuncStructBaseArenaFactory factory) override;
     virtual std::shared_ptr<StructBase> createStruct(const std::string& typeName) override;
+    virtual std::shared_ptr<StructBase> createStruct(const std::string& typeName, const std::shared_ptr<std::pmr::memory_resource>& arena) override;
 
     std::unordered_map<std::string, FuncStructBaseFactory> m_factories{};
+    std::unordered_map<std::string, FuncStructBaseArenaFactory> m_arenaFactories{};
 };
 
 class SYMBOLEXP StructFactoryRegistry
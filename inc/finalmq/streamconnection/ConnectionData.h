@@ -41,11 +41,52 @@ enum class ConnectionState
     CONNECTIONSTATE_DISCONNECTED = 5,
 };
 
+/**
+ * @brief OverflowPolicy defines what happens with a message that is sent while the send queue
+ * of a connection (or session) is above its high water mark.
+ */
+enum class OverflowPolicy
+{
+    OVERFLOW_BLOCK = 0,       ///< the producer waits until the queue drained below the low water mark. Inside a poller thread, the new message is dropped.
+    OVERFLOW_DROP_OLDEST = 1, ///< the oldest messages, that were not started to be sent, are dropped to make room for the new message.
+    OVERFLOW_DROP_NEWEST = 2, ///< the new message is dropped.
+    OVERFLOW_DISCONNECT = 3,  ///< the connection is disconnected, a slow peer shall not keep the memory.
+};
+
+/**
+ * @brief SendQueueConfig limits the send queue of a connection. A value of -1 means: no limit.
+ * A low water mark of -1 means: half of the high water mark. The overflow policy is applied,
+ * when a message is sent while the queue reached one of its high water marks. As soon as the
+ * queue drained to both low water marks, the connection signals that it is writable again.
+ */
+struct SendQueueConfig
+{
+    ssize_t highWaterMarkBytes{-1};
+    ssize_t lowWaterMarkBytes{-1};
+    ssize_t highWaterMarkMessages{-1};
+    ssize_t lowWaterMarkMessages{-1};
+    OverflowPolicy overflowPolicy{OverflowPolicy::OVERFLOW_BLOCK};
+};
+
+/**
+ * @brief SendQueueStatistics are the queue depth metrics of a connection.
+ */
+struct SendQueueStatistics
+{
+    ssize_t pendingBytes{0};         ///< bytes that are queued and not sent, yet
+    ssize_t pendingMessages{0};      ///< messages that are queued and not completely sent, yet
+    ssize_t peakBytes{0};            ///< maximum of pendingBytes
+    ssize_t peakMessages{0};         ///< maximum of pendingMessages
+    std::int64_t droppedMessages{0}; ///< messages that were dropped by the overflow policy
+    std::int64_t highWaterMarkReached{0}; ///< how often the queue reached a high water mark
+};
+
 struct BindProperties
 {
     CertificateData certificateData{};
     Variant protocolData{};
     Variant formatData{}; ///< data for the serialization format
+    SendQueueConfig sendQueue{}; ///< limits of the send queues of the incoming connections
 };
 
 struct ConnectConfig
@@ -65,6 +106,7 @@ struct ConnectProperties
     ConnectConfig config{};
     Variant protocolData{};
     Variant formatData{}; ///< data for the serialization format
+    SendQueueConfig sendQueue{}; ///< limits of the send queue
 };
 
 
@@ -0,0 +1,75 @@
+//MIT License
+
+//Copyright (c) 2020 bexoft GmbH (mail@bexoft.de)
+
+//Permission is hereby granted, free of charge, to any person obtaining a copy
+//of this software and associated documentation files (the "Software"), to deal
+//in the Software without restriction, including without limitation the rights
+//to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//copies of the Software, and to permit persons to whom the Software is
+//furnished to do so, subject to the following conditions:
+
+//The above copyright notice and this permission notice shall be included in all
+//copies or substantial portions of the Software.
+
+//THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//SOFTWARE.
+
+
+#pragma once
+
+#include <memory>
+#include <string>
+
+#include "finalmq/helpers/FmqDefines.h"
+
+namespace finalmq
+{
+class FileRegion;
+typedef std::shared_ptr<FileRegion> FileRegionPtr;
+
+/**
+ * @brief FileRegion is a part of an open file that is sent behind the buffers of a message.
+ * The stream connection sends it with sendfile directly from the page cache, without copying it
+ * into messages. The file is closed when the last message that references the region is released.
+ */
+class SYMBOLEXP FileRegion
+{
+public:
+    /**
+     * @brief open opens a file for the transfer of its whole content.
+     * @return the region or nullptr, if the file cannot be opened.
+     */
+    static FileRegionPtr open(const std::string& filename);
+
+    FileRegion(int fd, ssize_t offset, ssize_t size);
+    ~FileRegion();
+
+    inline int getDescriptor() const
+    {
+        return m_fd;
+    }
+    inline ssize_t getOffset() const
+    {
+        return m_offset;
+    }
+    inline ssize_t getSize() const
+    {
+        return m_size;
+    }
+
+private:
+    FileRegion(const FileRegion&) = delete;
+    const FileRegion& operator=(const FileRegion&) = delete;
+
+    const int m_fd;
+    const ssize_t m_offset;
+    const ssize_t m_size;
+};
+
+} // namespace finalmq
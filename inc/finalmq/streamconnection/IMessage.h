@@ -23,6 +23,7 @@
 #pragma once
 
 #include "finalmq/helpers/IZeroCopyBuffer.h"
+#include "finalmq/streamconnection/FileRegion.h"
 
 #include <memory>
 #include <string>
@@ -68,10 +69,16 @@ struct IMessage : public IZeroCopyBuffer
     virtual void addSendPayload(const char* payload, ssize_t size, ssize_t reserve = 0) = 0;
     virtual char* addSendPayload(ssize_t size, ssize_t reserve = 0) = 0;
     virtual void downsizeLastSendPayload(ssize_t newSize) = 0;
+    // references a shared immutable payload without copying it, the message keeps it alive and never modifies it
+    virtual void addSendPayload(const std::shared_ptr<const std::string>& payload) = 0;
+    // references the region [offset, offset + size) of a shared immutable buffer
+    virtual void addSendPayload(const std::shared_ptr<const std::string>& buffer, ssize_t offset, ssize_t size) = 0;
 
     // for receive
     virtual BufferRef getReceiveHeader() const = 0;
     virtual BufferRef getReceivePayload() const = 0;
+    // the buffer, which holds the receive payload, other messages can reference the payload without copying it
+    virtual std::shared_ptr<const std::string> getReceiveBuffer() const = 0;
     virtual char* resizeReceiveBuffer(ssize_t size) = 0;
     virtual void setReceiveBuffer(const std::shared_ptr<std::string>& receiveBuffer, ssize_t offset, ssize_t size) = 0;
     virtual void setHeaderSize(ssize_t sizeHeader) = 0;
@@ -90,6 +97,10 @@ struct IMessage : public IZeroCopyBuffer
     virtual char* addSendHeader(ssize_t size) = 0;
     virtual void downsizeLastSendHeader(ssize_t newSize) = 0;
 
+    // for the protocol to send a file region behind the send buffers (zero copy)
+    virtual void setSendFile(const FileRegionPtr& file) = 0;
+    virtual const FileRegionPtr& getSendFile() const = 0;
+
     // for the protocol to prepare the message for send
     virtual void prepareMessageToSend() = 0;
 
@@ -58,7 +58,20 @@ public:
     int bind(const sockaddr* addr, int namelen);
     int listen(int backlog);
     int send(const char* buf, int len, int flags = 0);
+    int sendv(const struct iovec* iov, int iovcnt, int flags = 0);
+    /**
+     * @brief sendFile sends a region of a file. Plain sockets use sendfile, so that the data is not copied
+     * into the user space. SSL sockets read the file in large chunks and encrypt them.
+     * @return the number of bytes sent, 0 if the socket would block and -1 on error or if the file ends before the region.
+     */
+    int sendFile(int fdFile, off_t offset, int len, int flags = 0);
     int receive(char* buf, int len, int flags = 0);
+
+    /**
+     * @brief receiveAvailable reads optimistically into the buffer, without asking the number of pending bytes.
+     * @return the number of bytes read, 0 if no data is available and -1 if the connection was closed by the peer or on error.
+     */
+    int receiveAvailable(char* buf, int len);
     void destroy();
     void attach(SOCKET sd);
     int pendingRead() const;
@@ -73,11 +86,17 @@ private:
     const Socket& operator=(const Socket& obj) = delete;
 
     int handleError(int err, const char* funcName);
+    int sendFileBuffered(int fdFile, off_t offset, int len, int flags);
 
     SocketDescriptorPtr m_sd{};
     int m_af = 0;
     int m_protocol = 0;
     std::string m_name{};
+    std::vector<char> m_sendFileBuffer{};
+    int m_sendFileBufferBegin = 0;
+    int m_sendFileBufferEnd = 0;
+    int m_sendFileDescriptor = -1;
+    off_t m_sendFileOffset = 0;
 
 #ifdef USE_OPENSSL
 public:
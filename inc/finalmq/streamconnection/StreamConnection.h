@@ -22,9 +22,11 @@
 
 #pragma once
 
+#include <condition_variable>
 #include <list>
 #include <memory>
 #include <mutex>
+#include <thread>
 #include <vector>
 
 #include <assert.h>
@@ -50,7 +52,17 @@ struct IStreamConnectionCallback
     {}
     virtual hybrid_ptr<IStreamConnectionCallback> connected(const IStreamConnectionPtr& connection) = 0;
     virtual void disconnected(const IStreamConnectionPtr& connection) = 0;
-    virtual bool received(const IStreamConnectionPtr& connection, const SocketPtr& socket, int bytesToRead) = 0;
+    /**
+     * @brief received is called when data arrived. The bytes were already read from the socket.
+     * @param buffer the received bytes. The buffer is reused after the call, so the callback has to copy the bytes that it keeps.
+     * @param size the number of received bytes.
+     */
+    virtual bool received(const IStreamConnectionPtr& connection, const char* buffer, int size) = 0;
+    /**
+     * @brief writable is called when the send queue reached a high water mark before and
+     * drained below the low water marks now. Producers can continue sending.
+     */
+    virtual void writable(const IStreamConnectionPtr& connection) = 0;
 };
 
 struct IStreamConnection
@@ -63,6 +75,17 @@ struct IStreamConnection
     virtual std::int64_t getConnectionId() const = 0;
     virtual SocketPtr getSocket() = 0;
     virtual void disconnect() = 0;
+    /**
+     * @brief isWritable returns false, if the send queue reached a high water mark and did not drain below the low water marks, yet.
+     */
+    virtual bool isWritable() const = 0;
+    virtual SendQueueStatistics getSendQueueStatistics() const = 0;
+    /**
+     * @brief getExecutor returns the executor of the poller thread (reactor) that handles the connection.
+     * All events of the connection are triggered from this thread, so actions, which are added to the
+     * executor, are serialized with the events of the connection.
+     */
+    virtual IExecutorPtr getExecutor() const = 0;
 };
 
 struct IStreamConnectionPrivate : public IStreamConnection
@@ -72,6 +95,7 @@ struct IStreamConnectionPrivate : public IStreamConnection
     virtual void setSocket(const SocketPtr& socket) = 0;
     virtual bool sendPendingMessages() = 0;
     virtual bool checkEdgeConnected() = 0;
+    virtual bool checkEdgeWritable() = 0;
     virtual bool doReconnect() = 0;
     virtual bool changeStateForDisconnect() = 0;
     virtual bool getDisconnectFlag() const = 0;
@@ -79,7 +103,13 @@ struct IStreamConnectionPrivate : public IStreamConnection
 
     virtual void connected(const IStreamConnectionPtr& connection) = 0;
     virtual void disconnected(const IStreamConnectionPtr& connection) = 0;
-    virtual bool received(const IStreamConnectionPtr& connection, const SocketPtr& socket, int bytesToRead) = 0;
+    virtual bool received(const IStreamConnectionPtr& connection, const char* buffer, int size) = 0;
+    virtual void writable(const IStreamConnectionPtr& connection) = 0;
+    /**
+     * @brief sendCompleted is called with the completion of a send that was submitted to an IPollerCompletion.
+     * @param result the number of sent bytes or -errno.
+     */
+    virtual void sendCompleted(int result) = 0;
 };
 
 typedef std::shared_ptr<IStreamConnectionPrivate> IStreamConnectionPrivatePtr;
@@ -87,9 +117,15 @@ typedef std::shared_ptr<IStreamConnectionPrivate> IStreamConnectionPrivatePtr;
 class SYMBOLEXP StreamConnection : public IStreamConnectionPrivate
 {
 public:
-    StreamConnection(const ConnectionData& connectionData, std::shared_ptr<Socket> socket, const IPollerPtr& poller, hybrid_ptr<IStreamConnectionCallback> callback);
+    StreamConnection(const ConnectionData& connectionData, std::shared_ptr<Socket> socket, const IPollerPtr& poller, const IExecutorPtr& executor, hybrid_ptr<IStreamConnectionCallback> callback);
     ~StreamConnection();
 
+    /**
+     * @brief markReactorThread marks the calling thread as a poller loop thread. On these threads,
+     * OVERFLOW_BLOCK never waits for the send queue of any connection, it drops the new message instead.
+     */
+    static void markReactorThread();
+
 private:
     // IStreamConnection
     virtual void sendMessage(const IMessagePtr& msg) override;
@@ -98,6 +134,9 @@ private:
     virtual std::int64_t getConnectionId() const override;
     virtual SocketPtr getSocket() override;
     virtual void disconnect() override;
+    virtual bool isWritable() const override;
+    virtual SendQueueStatistics getSendQueueStatistics() const override;
+    virtual IExecutorPtr getExecutor() const override;
 
     // IStreamConnectionPrivate
     virtual bool connect() override;
@@ -105,6 +144,7 @@ private:
     virtual void setSocket(const SocketPtr& socket) override;
     virtual bool sendPendingMessages() override;
     virtual bool checkEdgeConnected() override;
+    virtual bool checkEdgeWritable() override;
     virtual bool doReconnect() override;
     virtual bool changeStateForDisconnect() override;
     virtual bool getDisconnectFlag() const override;
@@ -112,24 +152,54 @@ private:
 
     virtual void connected(const IStreamConnectionPtr& connection) override;
     virtual void disconnected(const IStreamConnectionPtr& connection) override;
-    virtual bool received(const IStreamConnectionPtr& connection, const SocketPtr& socket, int bytesToRead) override;
+    virtual bool received(const IStreamConnectionPtr& connection, const char* buffer, int size) override;
+    virtual void writable(const IStreamConnectionPtr& connection) override;
+    virtual void sendCompleted(int result) override;
 
     struct MessageSendState
     {
         IMessagePtr msg{};
         std::list<BufferRef>::const_iterator it{};
         int offset = 0;
+        ssize_t fileSent = 0;
+        ssize_t size = 0;
     };
 
+    bool sendPendingBuffers();
+    bool removeSentBuffers(ssize_t sizeSent, bool complete);
+    IPollerCompletion* getPollerCompletion() const;
+    bool sendFileRegion(MessageSendState& messageSendState, const FileRegion& file);
+    bool isSendQueueFull() const;
+    bool isSendQueueDrained() const;
+    bool handleOverflow(std::unique_lock<std::mutex>& lock);
+    bool waitWritable(std::unique_lock<std::mutex>& lock);
+    void popPendingMessage(std::list<MessageSendState>::iterator it);
+    void updateWritable();
+
+    static constexpr size_t MAX_SEND_BUFFERS = 1024; // IOV_MAX on linux
+    static constexpr ssize_t MAX_SENDFILE_SIZE = 0x40000000;
+
     const std::int64_t m_connectionId = 0;
     ConnectionData m_connectionData{};
     SocketPtr m_socketPrivate{};
     SocketPtr m_socket{};
     const IPollerPtr m_poller{};
+    IPollerCompletion* const m_pollerCompletion{};
+    const IExecutorPtr m_executor{};
     std::list<MessageSendState> m_pendingMessages{};
+    std::vector<struct iovec> m_sendBuffers{};
+    bool m_sendSubmitted = false;        // the poller sends the first m_messagesSubmitted messages
+    size_t m_messagesSubmitted = 0;
+    ssize_t m_sizeSubmitted = 0;
     std::atomic<bool> m_disconnectFlag{};
     hybrid_ptr<IStreamConnectionCallback> m_callback{};
 
+    SendQueueStatistics m_sendQueueStatistics{};
+    bool m_writeBlocked = false;
+    bool m_edgeWritable = false;
+    std::thread::id m_threadIdPoller{};
+    std::condition_variable m_condWritable{};
+
     std::chrono::time_point<std::chrono::steady_clock> m_lastReconnectTime{};
 
     mutable std::mutex m_mutex{};
@@ -45,7 +45,17 @@ struct IStreamConnectionContainer
     virtual ~IStreamConnectionContainer()
     {}
 
-    virtual void init(int cycleTime = 100, FuncPollerLoopTimer funcTimer = {}, int checkReconnectInterval = 1000) = 0;
+    /**
+     * @brief init initializes the container. Call it once before bind/connect.
+     * @param cycleTime is the interval in [ms] in which funcTimer is called.
+     * @param funcTimer is called every cycleTime from the thread that calls run().
+     * @param checkReconnectInterval is the interval in [ms] in which the reconnect timers are checked.
+     * @param numberOfReactors is the number of poller loops. The first loop is executed by run(), the others
+     * get their own threads. Accepted and connected sockets are distributed round-robin over the loops.
+     * With more than one reactor, the callbacks of a connection are called from the thread of its reactor,
+     * see IStreamConnection::getExecutor().
+     */
+    virtual void init(int cycleTime = 100, FuncPollerLoopTimer funcTimer = {}, int checkReconnectInterval = 1000, int numberOfReactors = 1) = 0;
     virtual int bind(const std::string& endpoint, hybrid_ptr<IStreamConnectionCallback> callback, const BindProperties& bindProperties = {}) = 0;
     virtual void unbind(const std::string& endpoint) = 0;
     virtual IStreamConnectionPtr connect(const std::string& endpoint, hybrid_ptr<IStreamConnectionCallback> callback, const ConnectProperties& connectionProperties = {}) = 0;
@@ -70,7 +80,7 @@ public:
 
 private:
     // IStreamConnectionContainer
-    virtual void init(int cycleTime = 100, FuncPollerLoopTimer funcTimer = {}, int checkReconnectInterval = 1000) override;
+    virtual void init(int cycleTime = 100, FuncPollerLoopTimer funcTimer = {}, int checkReconnectInterval = 1000, int numberOfReactors = 1) override;
     virtual int bind(const std::string& endpoint, hybrid_ptr<IStreamConnectionCallback> callback, const BindProperties& bindProperties = {}) override;
     virtual void unbind(const std::string& endpoint) override;
     virtual IStreamConnectionPtr connect(const std::string& endpoint, hybrid_ptr<IStreamConnectionCallback> callback, const ConnectProperties& connectionProperties = {}) override;
@@ -82,8 +92,6 @@ private:
     virtual void terminatePollerLoop() override;
     virtual IExecutorPtr getPollerThreadExecutor() const override;
 
-    void pollerLoop();
-
     struct BindData
     {
         ConnectionData connectionData{};
@@ -91,31 +99,67 @@ private:
         hybrid_ptr<IStreamConnectionCallback> callback{};
     };
 
+#ifdef USE_OPENSSL
+    struct SslAcceptingData
+    {
+        SocketPtr socket;
+        ConnectionData connectionData;
+        hybrid_ptr<IStreamConnectionCallback> callback;
+    };
+#endif
+
+    struct Reactor
+    {
+        std::shared_ptr<IPoller> poller{};
+        IPollerCompletion* pollerCompletion{nullptr};                                               // the poller, if it receives, sends and accepts itself
+        IExecutorPtr executor{};
+        std::unordered_map<std::int64_t, IStreamConnectionPrivatePtr> connectionId2Connection{};    // protected by m_mutex
+        std::unordered_map<SOCKET, IStreamConnectionPrivatePtr> sd2Connection{};                    // protected by m_mutex
+        std::unordered_map<SOCKET, IStreamConnectionPrivatePtr> sd2ConnectionPollerLoop{};          // only used by the reactor's thread
+        std::vector<SocketDescriptorPtr> socketErase{};                                             // protected by m_mutex
+        std::atomic_flag connectionsStable{};
+        std::thread thread{};
+        std::vector<char> receiveBuffer{};                                                          // only used by the reactor's thread
+#ifdef USE_OPENSSL
+        std::unordered_map<SOCKET, SslAcceptingData> sslAcceptings{};                               // only used by the reactor's thread
+#endif
+    };
+
+    void createReactor();
+    Reactor& nextReactor();
+    void connectionsChanged(Reactor& reactor);
+    Reactor* findReactorByConnectionId(std::int64_t connectionId);
+    void pollerLoop(Reactor& reactor);
+    void updateConnectionsPollerLoop(Reactor& reactor);
+
     std::unordered_map<SOCKET, BindData>::iterator findBindByEndpoint(const std::string& endpoint);
-    IStreamConnectionPrivatePtr findConnectionBySdOnlyForPollerLoop(SOCKET sd);
+    IStreamConnectionPrivatePtr findConnectionBySdOnlyForPollerLoop(Reactor& reactor, SOCKET sd);
     IStreamConnectionPrivatePtr findConnectionById(std::int64_t connectionId);
     bool createSocket(const IStreamConnectionPtr& streamConnection, ConnectionData& connectionData, const ConnectProperties& connectionProperties);
-    void disconnectIntern(const IStreamConnectionPrivatePtr& connectionDisconnect, const SocketDescriptorPtr& sd);
-    IStreamConnectionPrivatePtr addConnection(const SocketPtr& socket, ConnectionData& connectionData, hybrid_ptr<IStreamConnectionCallback> callback);
-    void handleConnectionEvents(const IStreamConnectionPrivatePtr& connection, const SocketPtr& socket, const DescriptorInfo& info);
-    void handleBindEvents(const DescriptorInfo& info);
-    void handleReceive(const IStreamConnectionPrivatePtr& connection, const SocketPtr& socket, int bytesToRead);
+    void disconnectIntern(Reactor& reactor, const IStreamConnectionPrivatePtr& connectionDisconnect, const SocketDescriptorPtr& sd);
+    IStreamConnectionPrivatePtr addConnection(Reactor& reactor, const SocketPtr& socket, ConnectionData& connectionData, hybrid_ptr<IStreamConnectionCallback> callback);
+    void acceptConnection(Reactor& reactor, const SocketPtr& socketAccept, ConnectionData& connectionData, hybrid_ptr<IStreamConnectionCallback> callback);
+    void handleConnectionEvents(Reactor& reactor, const IStreamConnectionPrivatePtr& connection, const SocketPtr& socket, const DescriptorInfo& info);
+    void handleBindEvents(Reactor& reactor, const DescriptorInfo& info);
+    void handleCompletion(Reactor& reactor, const CompletionInfo& info);
+    void handleAcceptCompletion(Reactor& reactor, const CompletionInfo& info);
+    void acceptIncoming(Reactor& reactor, const BindData& bindData, const SocketPtr& socketAccept, const std::string& addr);
+    static IPollerCompletion* getPollerCompletion(const Reactor& reactor, const SocketPtr& socket);
+    void handleReceive(Reactor& reactor, const IStreamConnectionPrivatePtr& connection, const SocketPtr& socket);
+    bool receiveIntoBuffer(Reactor& reactor, const IStreamConnectionPrivatePtr& connection, const SocketPtr& socket);
     static bool isTimerExpired(std::chrono::time_point<std::chrono::steady_clock>& lastTime, int interval);
     void doReconnect();
 
-    const std::shared_ptr<IPoller> m_poller{};
+    std::vector<std::unique_ptr<Reactor>> m_reactors{};
+    std::atomic_uint32_t m_nextReactor{0};
     std::unordered_map<SOCKET, BindData> m_sd2binds{};
     std::unordered_map<std::int64_t, IStreamConnectionPrivatePtr> m_connectionId2Connection{};
-    std::unordered_map<SOCKET, IStreamConnectionPrivatePtr> m_sd2Connection{};
-    std::unordered_map<SOCKET, IStreamConnectionPrivatePtr> m_sd2ConnectionPollerLoop{};
-    std::vector<SocketDescriptorPtr> m_socketErase{};
-    std::atomic_flag m_connectionsStable{};
     static std::atomic_int64_t m_nextConnectionId;
     std::atomic_bool m_terminatePollerLoop{false};
     int m_cycleTime{100};
     int m_checkReconnectInterval{1000};
     FuncPollerLoopTimer m_funcTimer{};
-    const IExecutorPtr m_executorPollerThread;
+    IExecutorPtr m_executorPollerThread{};
     std::unique_ptr<IExecutorWorker> m_executorWorker{};
     std::thread m_threadTimer{};
     mutable std::mutex m_mutex{};
@@ -123,14 +167,7 @@ private:
     std::chrono::time_point<std::chrono::steady_clock> m_lastReconnectTime{};
 
 #ifdef USE_OPENSSL
-    struct SslAcceptingData
-    {
-        SocketPtr socket;
-        ConnectionData connectionData;
-        hybrid_ptr<IStreamConnectionCallback> callback;
-    };
-    bool sslAccepting(SslAcceptingData& sslAcceptingData);
-    std::unordered_map<SOCKET, SslAcceptingData> m_sslAcceptings{};
+    bool sslAccepting(Reactor& reactor, SslAcceptingData& sslAcceptingData);
 #endif
 };
 
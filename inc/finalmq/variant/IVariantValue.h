@@ -55,6 +55,9 @@ struct IVariantValue
     virtual Variant* getVariant(const std::string& name) = 0;
     virtual const Variant* getVariant(const std::string& name) const = 0;
     virtual std::shared_ptr<IVariantValue> clone() const = 0;
+    // cloneInline and moveInline construct the value in the inline storage of a Variant (Variant::INLINE_SIZE)
+    virtual IVariantValue* cloneInline(void* storage) const = 0;
+    virtual IVariantValue* moveInline(void* storage) = 0;
     virtual bool operator ==(const IVariantValue& rhs) const = 0;
     virtual Variant* add(const std::string& name, const Variant& variant) = 0;
     virtual Variant* add(const std::string& name, Variant&& variant) = 0;
@@ -22,8 +22,12 @@
 
 #pragma once
 
+#include <algorithm>
+#include <cstring>
 #include <memory>
+#include <new>
 #include <string>
+#include <type_traits>
 
 #include <assert.h>
 
@@ -35,23 +39,41 @@ namespace finalmq
 
 const static int VARTYPE_NONE = 0;
 
+/**
+ * @brief Variant holds a value of one of the variant types (see VariantValues.h, VariantStruct and VariantList).
+ * Scalars and short strings are stored inline in the variant, they do not need a heap allocation.
+ * Bigger values (long strings, bytes, arrays, structs and lists) are stored on the heap and are shared
+ * between copies of the variant. A shared value is copied at the first non-const access (copy on write).
+ * Note: Do not keep a pointer to the data of a variant, while you copy the variant and change the data
+ * through the pointer, because the copy can share the data.
+ */
 class SYMBOLEXP Variant
 {
 public:
+    /**
+     * @brief INLINE_SIZE is the size of the inline storage, it fits a value of type std::string
+     * (64 bit platforms).
+     */
+    static constexpr size_t INLINE_SIZE = 5 * sizeof(void*);
+    static constexpr size_t INLINE_ALIGN = std::max({alignof(void*), alignof(std::int64_t), alignof(double)});
+    static constexpr size_t SHORT_STRING_SIZE = 15;
+
     Variant();
+    ~Variant();
 
     Variant(std::shared_ptr<IVariantValue> value);
 
     template<class T>
     Variant(T data)
-        : m_value(std::make_shared<typename VariantValueTypeInfo<T>::VariantValueType>(std::move(data)))
     {
+        createValue<typename VariantValueTypeInfo<T>::VariantValueType>(std::move(data));
     }
 
     template<class T>
     const Variant& operator=(T data)
     {
-        m_value = std::make_shared<typename VariantValueTypeInfo<T>::VariantValueType>(std::move(data));
+        destroyValue();
+        createValue<typename VariantValueTypeInfo<T>::VariantValueType>(std::move(data));
 #ifndef WIN32
 #pragma GCC diagnostic push
 #pragma GCC diagnostic ignored "-Weffc++"
@@ -65,27 +87,13 @@ public:
     template<class T>
     operator T*()
     {
-        if (m_value)
-        {
-            if (m_value->getType() == VariantValueTypeInfo<T>::VARTYPE)
-            {
-                return static_cast<T*>(m_value->getData());
-            }
-        }
-        return nullptr;
+        return getDataIntern<T>();
     }
 
     template<class T>
     operator const T*() const
     {
-        if (m_value)
-        {
-            if (m_value->getType() == VariantValueTypeInfo<T>::VARTYPE)
-            {
-                return static_cast<const T*>(m_value->getData());
-            }
-        }
-        return nullptr;
+        return getDataIntern<T>();
     }
 
     template<class T>
@@ -106,14 +114,7 @@ public:
         Variant* variant = getVariant(name);
         if (variant)
         {
-            std::shared_ptr<IVariantValue>& value = variant->m_value;
-            if (value)
-            {
-                if (value->getType() == VariantValueTypeInfo<T>::VARTYPE)
-                {
-                    return static_cast<T*>(value->getData());
-                }
-            }
+            return variant->getDataIntern<T>();
         }
         return nullptr;
     }
@@ -121,7 +122,12 @@ public:
     template<class T>
     const T* getData(const std::string& name) const
     {
-        return const_cast<Variant*>(this)->getData<T>(name);
+        const Variant* variant = getVariant(name);
+        if (variant)
+        {
+            return variant->getDataIntern<T>();
+        }
+        return nullptr;
     }
 
     template<class T>
@@ -152,6 +158,10 @@ public:
     Variant(Variant&& rhs) noexcept;
     Variant& operator=(Variant&& rhs) noexcept;
 
+    /**
+     * @brief accept passes the variant to the visitor. A shared value is not copied for the visitor,
+     * so the visitor must not change the variant.
+     */
     void accept(IVariantVisitor& visitor, ssize_t index = 0, int level = 0, ssize_t size = 0, const std::string& name = "", bool parentIsStruct = false);
 
     Variant* getVariant(const std::string& name);
@@ -167,8 +177,80 @@ public:
 
     Variant& getOrCreate(const std::string& name);
 
+    /**
+     * @brief isInline returns true, if the value is stored inside the variant (no heap allocation).
+     */
+    bool isInline() const
+    {
+        return m_inline;
+    }
+
 private:
-    std::shared_ptr<IVariantValue> m_value{};
+    template<class T>
+    static bool isInlineValue(const T& /*data*/)
+    {
+        return std::is_arithmetic<T>::value;
+    }
+
+    static bool isInlineValue(const std::string& data)
+    {
+        return (data.size() <= SHORT_STRING_SIZE);
+    }
+
+    static bool isInlineValue(const char* data)
+    {
+        return (data == nullptr || strlen(data) <= SHORT_STRING_SIZE);
+    }
+
+    template<class TValue, class T>
+    void createValue(T&& data)
+    {
+        assert(m_value == nullptr);
+        if constexpr (sizeof(TValue) <= INLINE_SIZE && alignof(TValue) <= INLINE_ALIGN)
+        {
+            if (isInlineValue(data))
+            {
+                m_value = new (m_storage) TValue(std::forward<T>(data));
+                m_inline = true;
+                return;
+            }
+        }
+        setShared(std::make_shared<TValue>(std::forward<T>(data)));
+    }
+
+    template<class T>
+    T* getDataIntern()
+    {
+        makeUnique();
+        if (m_value && m_value->getType() == VariantValueTypeInfo<T>::VARTYPE)
+        {
+            return static_cast<T*>(m_value->getData());
+        }
+        return nullptr;
+    }
+
+    template<class T>
+    const T* getDataIntern() const
+    {
+        const IVariantValue* value = m_value;
+        if (value && value->getType() == VariantValueTypeInfo<T>::VARTYPE)
+        {
+            return static_cast<const T*>(value->getData());
+        }
+        return nullptr;
+    }
+
+    std::shared_ptr<IVariantValue>& getShared();
+    const std::shared_ptr<IVariantValue>& getShared() const;
+    void moveFrom(Variant& rhs);
+    void setShared(std::shared_ptr<IVariantValue>&& value);
+    void destroyValue();
+    void makeUnique();
+
+    IVariantValue* m_value{nullptr};    // points into m_storage (inline value) or to the shared value
+    bool m_inline{false};
+    // holds the inline value or the shared pointer to the value
+    alignas(INLINE_ALIGN) unsigned char m_storage[INLINE_SIZE];
 };
 
 } // namespace finalmq
@@ -53,6 +53,8 @@ private:
     virtual Variant* getVariant(const std::string& name) override;
     virtual const Variant* getVariant(const std::string& name) const override;
     virtual std::shared_ptr<IVariantValue> clone() const override;
+    virtual IVariantValue* cloneInline(void* storage) const override;
+    virtual IVariantValue* moveInline(void* storage) override;
     virtual bool operator ==(const IVariantValue& rhs) const override;
     virtual Variant* add(const std::string& name, const Variant& variant) override;
     virtual Variant* add(const std::string& name, Variant&& variant) override;
@@ -27,6 +27,7 @@
 #include "VariantValueConvert.h"
 
 #include <deque>
+#include <unordered_map>
 
 namespace finalmq {
 
@@ -52,6 +53,8 @@ private:
     virtual Variant* getVariant(const std::string& name) override;
     virtual const Variant* getVariant(const std::string& name) const override;
     virtual std::shared_ptr<IVariantValue> clone() const override;
+    virtual IVariantValue* cloneInline(void* storage) const override;
+    virtual IVariantValue* moveInline(void* storage) override;
     virtual bool operator ==(const IVariantValue& rhs) const override;
     virtual Variant* add(const std::string& name, const Variant& variant) override;
     virtual Variant* add(const std::string& name, Variant&& variant) override;
@@ -62,8 +65,15 @@ private:
 
 
     VariantStruct::iterator find(const std::string& name);
+    VariantStruct::const_iterator find(const std::string& name) const;
+    bool isIndexValid() const;
+    void buildIndex();
+    void addToIndex(const std::string& name);
 
     std::unique_ptr<VariantStruct>     m_value;
+    // name -> position in m_value, it is built for structs with more than INDEX_THRESHOLD entries
+    std::unique_ptr<std::unordered_map<std::string, ssize_t>> m_index{};
+    size_t                             m_indexSize{0};
 };
 
 
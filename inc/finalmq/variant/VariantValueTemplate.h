@@ -82,6 +82,27 @@ private:
         return std::make_shared<VariantValueTemplate>(*this);
     }
 
+    // only values that fit into the inline storage of a variant are stored inline
+    virtual IVariantValue* cloneInline(void* storage) const override
+    {
+        if constexpr (sizeof(VariantValueTemplate) <= Variant::INLINE_SIZE)
+        {
+            return new (storage) VariantValueTemplate(*this);
+        }
+        assert(false);
+        return nullptr;
+    }
+
+    virtual IVariantValue* moveInline(void* storage) override
+    {
+        if constexpr (sizeof(VariantValueTemplate) <= Variant::INLINE_SIZE)
+        {
+            return new (storage) VariantValueTemplate(std::move(*this));
+        }
+        assert(false);
+        return nullptr;
+    }
+
     virtual bool operator==(const IVariantValue& rhs) const override
     {
         if (this == &rhs)
@@ -49,6 +49,8 @@ public:
     MOCK_METHOD(int, write, (int fd, const char* buffer, int len), (override));
     MOCK_METHOD(int, read, (int fd, char* buffer, int len), (override));
     MOCK_METHOD(int, send, (SOCKET fd, const char* buffer, int len, int flags), (override));
+    MOCK_METHOD(int, sendv, (SOCKET fd, const struct iovec* iov, int iovcnt, int flags), (override));
+    MOCK_METHOD(int, sendfile, (SOCKET fd, int fdFile, off_t offset, int len), (override));
     MOCK_METHOD(int, recv, (SOCKET fd, char* buffer, int len, int flags), (override));
     MOCK_METHOD(int, getLastError, (), (override));
     MOCK_METHOD(int, select, (int nfds, fd_set* readfds, fd_set* writefds, fd_set* exceptfds, struct timeval* timeout), (override));
@@ -56,6 +58,7 @@ public:
     MOCK_METHOD(int, epoll_create1, (int flags), (override));
     MOCK_METHOD(int, epoll_ctl, (int epfd, int op, int fd, struct epoll_event* event), (override));
     MOCK_METHOD(int, epoll_pwait, (int epfd, struct epoll_event *events, int maxevents, int timeout, const sigset_t* mask), (override));
+    MOCK_METHOD(int, eventfd, (unsigned int initval, int flags), (override));
 #endif
     MOCK_METHOD(int, makeSocketPair, (SocketDescriptorPtr& socket1, SocketDescriptorPtr& socket2), (override));
     MOCK_METHOD(int, ioctlInt, (SOCKET fd, unsigned long int request, int* value), (override));
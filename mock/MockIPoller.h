@@ -0,0 +1,49 @@
+//MIT License
+
+//Copyright (c) 2020 bexoft GmbH (mail@bexoft.de)
+
+//Permission is hereby granted, free of charge, to any person obtaining a copy
+//of this software and associated documentation files (the "Software"), to deal
+//in the Software without restriction, including without limitation the rights
+//to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//copies of the Software, and to permit persons to whom the Software is
+//furnished to do so, subject to the following conditions:
+
+//The above copyright notice and this permission notice shall be included in all
+//copies or substantial portions of the Software.
+
+//THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//SOFTWARE.
+
+
+#pragma once
+
+
+#include "finalmq/poller/Poller.h"
+
+
+#include "gmock/gmock.h"
+
+namespace finalmq {
+
+class MockIPoller : public IPoller
+{
+public:
+    MOCK_METHOD(void, init, (), (override));
+    MOCK_METHOD(void, addSocket, (const SocketDescriptorPtr& fd), (override));
+    MOCK_METHOD(void, addSocketEnableRead, (const SocketDescriptorPtr& fd), (override));
+    MOCK_METHOD(void, removeSocket, (const SocketDescriptorPtr& fd), (override));
+    MOCK_METHOD(void, enableRead, (const SocketDescriptorPtr& fd), (override));
+    MOCK_METHOD(void, disableRead, (const SocketDescriptorPtr& fd), (override));
+    MOCK_METHOD(void, enableWrite, (const SocketDescriptorPtr& fd), (override));
+    MOCK_METHOD(void, disableWrite, (const SocketDescriptorPtr& fd), (override));
+    MOCK_METHOD(const PollerResult&, wait, (std::int32_t timeout), (override));
+    MOCK_METHOD(void, releaseWait, (std::uint32_t info), (override));
+};
+
+}
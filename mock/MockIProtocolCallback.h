@@ -38,6 +38,7 @@ public:
     MOCK_METHOD(void, received, (const IMessagePtr& message, std::int64_t connectionId), (override));
     MOCK_METHOD(void, socketConnected, (), (override));
     MOCK_METHOD(void, socketDisconnected, (), (override));
+    MOCK_METHOD(void, writable, (), (override));
     MOCK_METHOD(void, reconnect, (), (override));
     MOCK_METHOD(bool, findSessionByName, (const std::string& sessionName, const IProtocolPtr& protocol), (override));
     MOCK_METHOD(void, setSessionName, (const std::string& sessionName, const IProtocolPtr& protocol, const IStreamConnectionPtr& connection), (override));
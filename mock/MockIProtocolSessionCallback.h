@@ -38,6 +38,7 @@ public:
     MOCK_METHOD(void, received, (const IProtocolSessionPtr& connection, const IMessagePtr& message), (override));
     MOCK_METHOD(void, socketConnected, (const IProtocolSessionPtr& connection), (override));
     MOCK_METHOD(void, socketDisconnected, (const IProtocolSessionPtr& connection), (override));
+    MOCK_METHOD(void, writable, (const IProtocolSessionPtr& connection), (override));
 };
 
 }   // namespace finalmq
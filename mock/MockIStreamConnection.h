@@ -41,6 +41,9 @@ public:
     MOCK_METHOD(std::int64_t, getConnectionId, (), (const override));
     MOCK_METHOD(SocketPtr, getSocket, (), (override));
     MOCK_METHOD(void, disconnect, (), (override));
+    MOCK_METHOD(bool, isWritable, (), (const override));
+    MOCK_METHOD(SendQueueStatistics, getSendQueueStatistics, (), (const override));
+    MOCK_METHOD(IExecutorPtr, getExecutor, (), (const override));
 };
 
 }
@@ -35,7 +35,8 @@ class MockIStreamConnectionCallback : public IStreamConnectionCallback
 public:
     MOCK_METHOD(hybrid_ptr<IStreamConnectionCallback>, connected, (const IStreamConnectionPtr& connection), (override));
     MOCK_METHOD(void, disconnected, (const IStreamConnectionPtr& connection), (override));
-    MOCK_METHOD(bool, received, (const IStreamConnectionPtr& connection, const SocketPtr& socket, int bytesToRead), (override));
+    MOCK_METHOD(bool, received, (const IStreamConnectionPtr& connection, const char* buffer, int size), (override));
+    MOCK_METHOD(void, writable, (const IStreamConnectionPtr& connection), (override));
 };
 
 }
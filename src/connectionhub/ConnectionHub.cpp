@@ -21,17 +21,22 @@
 //SOFTWARE.
 
 #include "finalmq/connectionhub/ConnectionHub.h"
-#include <algorithm>
 
 
 namespace finalmq {
 
 ConnectionHub::ConnectionHub()
     : m_protocolSessionContainer(std::make_unique<ProtocolSessionContainer>())
+    , m_snapshot(new ForwardingSnapshot())
 {
     assert(m_protocolSessionContainer);
 }
 
+ConnectionHub::~ConnectionHub()
+{
+    delete m_snapshot.exchange(nullptr);
+}
+
 
 
 void ConnectionHub::init(int cycleTime, int checkReconnectInterval)
@@ -52,6 +57,8 @@ void ConnectionHub::unbind(const std::string& endpoint)
 IProtocolSessionPtr ConnectionHub::connect(const std::string& endpoint, const ConnectProperties& connectProperties)
 {
     IProtocolSessionPtr session = m_protocolSessionContainer->connect(endpoint, this, connectProperties);
+    std::unique_lock<std::mutex> lock(m_mutex);
+    updateSnapshot();
     return session;
 }
 
@@ -80,94 +87,166 @@ void ConnectionHub::waitForTerminationOfPollerLoop()
 
 void ConnectionHub::startMessageForwarding()
 {
-    std::unique_lock<std::recursive_mutex> lock(m_mutex);
-    m_startMessageForwarding = true;
+    std::unique_lock<std::mutex> lock(m_mutex);
+    // the snapshot cannot be replaced while m_mutex is locked
+    const ForwardingSnapshot* snapshot = m_snapshot.load(std::memory_order_acquire);
+    assert(snapshot);
     for (size_t i = 0; i < m_messagesForForwarding.size(); ++i)
     {
         auto& entry = m_messagesForForwarding[i];
         assert(entry.first);
         assert(entry.second);
-        received(entry.first, entry.second);
+        forward(*snapshot, entry.first, entry.second);
     }
     m_messagesForForwarding.clear();
+    // set the flag after the buffered messages were forwarded, so that newer messages cannot overtake them.
+    m_startMessageForwarding.store(true, std::memory_order_release);
     lock.unlock();
 }
 
 
 void ConnectionHub::stopForwardingFromSession(std::int64_t sessionId)
 {
-    std::unique_lock<std::recursive_mutex> lock(m_mutex);
-    m_sessionIdsStopForwardingFromSession.push_back(sessionId);
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_sessionIdsStopForwardingFromSession.insert(sessionId);
+    updateSnapshot();
 }
 
 void ConnectionHub::stopForwardingToSession(std::int64_t sessionId)
 {
-    std::unique_lock<std::recursive_mutex> lock(m_mutex);
-    m_sessionIdsStopForwardingToSession.push_back(sessionId);
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_sessionIdsStopForwardingToSession.insert(sessionId);
+    updateSnapshot();
 }
 
 
-
-// IProtocolSessionCallback
-void ConnectionHub::connected(const IProtocolSessionPtr& /*session*/)
+// m_mutex must be locked
+void ConnectionHub::updateSnapshot(const IProtocolSessionPtr& sessionRemoved)
 {
+    std::unique_ptr<ForwardingSnapshot> snapshot = std::make_unique<ForwardingSnapshot>();
+    std::vector< IProtocolSessionPtr > sessions = m_protocolSessionContainer->getAllSessions();
+    snapshot->sessionsTo.reserve(sessions.size());
+    for (size_t i = 0; i < sessions.size(); ++i)
+    {
+        IProtocolSessionPtr& s = sessions[i];
+        assert(s);
+        if (s != sessionRemoved && m_sessionIdsStopForwardingToSession.find(s->getSessionId()) == m_sessionIdsStopForwardingToSession.end())
+        {
+            snapshot->sessionsTo.push_back(std::move(s));
+        }
+    }
+    snapshot->sessionIdsStopForwardingFromSession = m_sessionIdsStopForwardingFromSession;
+    const ForwardingSnapshot* snapshotOld = m_snapshot.exchange(snapshot.release());
+    m_snapshotsRetired.emplace_back(snapshotOld);
+    m_snapshotsRetiredPending.store(true);
+    reclaimSnapshots();
 }
 
-void ConnectionHub::disconnected(const IProtocolSessionPtr& /*session*/)
+// m_mutex must be locked
+void ConnectionHub::reclaimSnapshots()
 {
-
+    // A reader announces itself before it loads m_snapshot. If no reader is active after the exchange,
+    // every later reader sees the current snapshot, so nobody can hold a retired one.
+    if (m_snapshotReaders.load() == 0)
+    {
+        m_snapshotsRetired.clear();
+        m_snapshotsRetiredPending.store(false);
+    }
 }
 
-void ConnectionHub::disconnectedVirtualSession(const IProtocolSessionPtr& /*session*/, const std::string& /*virtualSessionId*/)
+
+void ConnectionHub::forward(const ForwardingSnapshot& snapshot, const IProtocolSessionPtr& session, const IMessagePtr& message)
 {
+    if (snapshot.sessionIdsStopForwardingFromSession.find(session->getSessionId()) != snapshot.sessionIdsStopForwardingFromSession.end())
+    {
+        return;
+    }
 
+    // All sessions reference the received payload, only the header of the protocol is written per session.
+    std::shared_ptr<const std::string> receiveBuffer = message->getReceiveBuffer();
+    if (message->getTotalSendPayloadSize() == 0 && receiveBuffer)
+    {
+        const BufferRef payload = message->getReceivePayload();
+        const ssize_t offset = payload.first - receiveBuffer->data();
+        for (size_t i = 0; i < snapshot.sessionsTo.size(); ++i)
+        {
+            const IProtocolSessionPtr& s = snapshot.sessionsTo[i];
+            // if not from-session
+            if (s != session)
+            {
+                IMessagePtr messageTo = s->createMessage();
+                assert(messageTo);
+                messageTo->getAllMetainfo() = message->getAllMetainfo();
+                messageTo->addSendPayload(receiveBuffer, offset, payload.second);
+                s->sendMessage(messageTo);
+            }
+        }
+        return;
+    }
+
+    // The sessions convert the message only once per protocol (if the messages of the protocol are resendable),
+    // so all sessions with the same protocol send the same payload.
+    for (size_t i = 0; i < snapshot.sessionsTo.size(); ++i)
+    {
+        const IProtocolSessionPtr& s = snapshot.sessionsTo[i];
+        // if not from-session
+        if (s != session)
+        {
+            s->sendMessage(message);
+        }
+    }
 }
 
 
-static bool contains(const std::vector<std::int64_t>& array, std::int64_t sessionId)
+
+// IProtocolSessionCallback
+void ConnectionHub::connected(const IProtocolSessionPtr& /*session*/)
 {
-    if (std::find(array.begin(), array.end(), sessionId) != array.end())
-    {
-        return true;
-    }
-    return false;
+    std::unique_lock<std::mutex> lock(m_mutex);
+    updateSnapshot();
 }
 
+void ConnectionHub::disconnected(const IProtocolSessionPtr& session)
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    updateSnapshot(session);
+}
 
-void ConnectionHub::received(const IProtocolSessionPtr& session, const IMessagePtr& message)
+void ConnectionHub::disconnectedVirtualSession(const IProtocolSessionPtr& /*session*/, const std::string& /*virtualSessionId*/)
 {
-    std::unique_lock<std::recursive_mutex> lock(m_mutex);
 
-    if (contains(m_sessionIdsStopForwardingFromSession, session->getSessionId()))
-    {
-        return;
-    }
-    std::vector<std::int64_t> sessionIdsStopForwardingToSession = m_sessionIdsStopForwardingToSession;
+}
 
-    if (m_startMessageForwarding)
+
+void ConnectionHub::received(const IProtocolSessionPtr& session, const IMessagePtr& message)
+{
+    if (!m_startMessageForwarding.load(std::memory_order_acquire))
     {
-        std::vector< IProtocolSessionPtr > sessions = m_protocolSessionContainer->getAllSessions();
-        for (size_t i = 0; i < sessions.size(); ++i)
+        std::unique_lock<std::mutex> lock(m_mutex);
+        if (!m_startMessageForwarding.load(std::memory_order_relaxed))
         {
-            IProtocolSessionPtr s = sessions[i];
-            assert(s);
-            // if not from-session
-            if (s != session)
+            const ForwardingSnapshot* snapshot = m_snapshot.load(std::memory_order_acquire);
+            if (snapshot->sessionIdsStopForwardingFromSession.find(session->getSessionId()) == snapshot->sessionIdsStopForwardingFromSession.end())
             {
-                // if not in sessionIdsStopForwardingToSession
-                if (!contains(sessionIdsStopForwardingToSession, s->getSessionId()))
-                {
-                    s->sendMessage(message);
-                }
+                m_messagesForForwarding.emplace_back(std::make_pair(session, message));
             }
+            return;
         }
     }
-    else
+
+    m_snapshotReaders.fetch_add(1);
+    const ForwardingSnapshot* snapshot = m_snapshot.load();
+    assert(snapshot);
+    forward(*snapshot, session, message);
+    if (m_snapshotReaders.fetch_sub(1) == 1 && m_snapshotsRetiredPending.load())
     {
-        m_messagesForForwarding.emplace_back(std::make_pair(session, message));
+        // the last reader deletes the retired snapshots, if no writer is busy
+        std::unique_lock<std::mutex> lock(m_mutex, std::try_to_lock);
+        if (lock.owns_lock())
+        {
+            reclaimSnapshots();
+        }
     }
-
-    lock.unlock();
 }
 
 void ConnectionHub::socketConnected(const IProtocolSessionPtr& /*session*/)
@@ -180,4 +259,9 @@ void ConnectionHub::socketDisconnected(const IProtocolSessionPtr& /*session*/)
 
 }
 
+void ConnectionHub::writable(const IProtocolSessionPtr& /*session*/)
+{
+
+}
+
 }   // namespace finalmq
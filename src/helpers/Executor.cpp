@@ -64,40 +64,50 @@ namespace finalmq
 
     bool Executor::runAvailableActions(const FuncIsAbort& funcIsAbort)
     {
-        std::list<ActionEntry> actions;
+        ActionList actions;
         std::unique_lock<std::mutex> lock(m_mutex);
-        actions = std::move(m_actions);
-        m_actions.clear();
+        actions.swap(m_actions);
         m_zeroIdCounter = 0;
-        m_storedIds.clear();
-        m_runningIds.clear();
+        clearIds();
         lock.unlock();
 
-        if (!actions.empty())
+        if (actions.empty())
         {
-            for (auto it1 = actions.begin(); it1 != actions.end(); ++it1)
+            return false;
+        }
+
+        bool abort = false;
+        for (auto it = actions.begin(); it != actions.end() && !abort; ++it)
+        {
+            ActionEntry& entry = *it;
+            for (size_t i = entry.front; i < entry.funcs.size(); ++i)
             {
-                ActionEntry& entry = *it1;
-                for (auto it2 = entry.funcs.begin(); it2 != entry.funcs.end(); ++it2)
+                ActionFunction& func = entry.funcs[i];
+                assert(func);
+                if (!funcIsAbort || !funcIsAbort())
                 {
-                    std::unique_ptr<std::function<void()>>& func = *it2;
-                    assert(func && *func);
-                    if (!funcIsAbort || !funcIsAbort())
-                    {
-                        (*func)();
-                    }
-                    else
-                    {
-                        return true;
-                    }
+                    func();
+                }
+                else
+                {
+                    abort = true;
+                    break;
                 }
             }
-            return true;
         }
-        else
+
+        // destroy the functions outside of the lock, their captures could add new actions
+        for (auto it = actions.begin(); it != actions.end(); ++it)
         {
-            return false;
+            it->funcs.clear();
+        }
+        lock.lock();
+        while (!actions.empty())
+        {
+            releaseEntry(actions, actions.begin());
         }
+        lock.unlock();
+        return true;
     }
 
     bool Executor::areRunnableActionsAvailable() const
@@ -118,8 +128,9 @@ namespace finalmq
         {
             return false;
         }
-        std::deque<std::unique_ptr<std::function<void()>>> funcs;
-        std::int64_t instanceId = -1;
+        ActionList entryInstance;
+        ActionFunction func;
+        std::int64_t instanceId = 0;
         for (auto it = m_actions.begin(); it != m_actions.end(); ++it)
         {
             ActionEntry& entry = *it;
@@ -130,23 +141,29 @@ namespace finalmq
                 bool erased = false;
                 if (instanceId != 0)
                 {
-                    m_runningIds.insert(instanceId);
-                    funcs = std::move(entry.funcs);
-                    it = m_actions.erase(it);
+                    insertRunningId(instanceId);
+                    auto itNext = std::next(it);
+                    entryInstance.splice(entryInstance.end(), m_actions, it);
+                    it = itNext;
                     erased = true;
                 }
                 else
                 {
                     --m_zeroIdCounter;
-                    funcs.push_back(std::move(entry.funcs.front()));
-                    if (entry.funcs.size() == 1)
+                    func = std::move(entry.funcs[entry.front]);
+                    ++entry.front;
+                    if (entry.front == entry.funcs.size())
                     {
-                        it = m_actions.erase(it);
+                        auto itNext = std::next(it);
+                        releaseEntry(m_actions, it);
+                        it = itNext;
                         erased = true;
                     }
-                    else
+                    else if (entry.front >= MIN_COMPACT_SIZE && entry.front * 2 >= entry.funcs.size())
                     {
-                        entry.funcs.pop_front();
+                        // an entry that is refilled faster than it is drained must not grow for ever
+                        entry.funcs.erase(entry.funcs.begin(), entry.funcs.begin() + entry.front);
+                        entry.front = 0;
                     }
                 }
                 if (erased && it != m_actions.end())
@@ -157,8 +174,8 @@ namespace finalmq
                         --itPrev;
                         if (itPrev->instanceId == it->instanceId)
                         {
-                            itPrev->funcs.insert(itPrev->funcs.end(), std::make_move_iterator(it->funcs.begin()), std::make_move_iterator(it->funcs.end()));
-                            m_actions.erase(it);
+                            itPrev->funcs.insert(itPrev->funcs.end(), std::make_move_iterator(it->funcs.begin() + it->front), std::make_move_iterator(it->funcs.end()));
+                            releaseEntry(m_actions, it);
                         }
                     }
                 }
@@ -175,47 +192,48 @@ namespace finalmq
             m_newActions = true;
         }
 
-        for (auto it = funcs.begin(); it != funcs.end(); ++it)
+        if (func)
         {
-            assert(*it && **it);
             if (!funcIsAbort || !funcIsAbort())
             {
-                (**it)();
-            }
-            else
-            {
-                break;
+                func();
             }
         }
-
-        if (instanceId > 0)
+        else if (!entryInstance.empty())
         {
-            lock.lock();
-            m_runningIds.erase(instanceId);
-            auto it = m_storedIds.find(instanceId);
-            assert(it != m_storedIds.end());
-            auto& counter = it->second;
-            assert(counter > 0);
-            assert(counter >= static_cast<std::int32_t>(funcs.size()));
-            counter -= static_cast<std::int32_t>(funcs.size());
-            if (counter == 0)
+            ActionEntry& entry = entryInstance.front();
+            for (size_t i = entry.front; i < entry.funcs.size(); ++i)
             {
-                m_storedIds.erase(it);
+                assert(entry.funcs[i]);
+                if (!funcIsAbort || !funcIsAbort())
+                {
+                    entry.funcs[i]();
+                }
+                else
+                {
+                    break;
+                }
             }
+
+            std::int32_t count = static_cast<std::int32_t>(entry.funcs.size() - entry.front);
+            // destroy the functions outside of the lock, their captures could add new actions
+            entry.funcs.clear();
+            lock.lock();
+            eraseRunningId(instanceId);
+            decrementStoredId(instanceId, count);
+            releaseEntry(entryInstance, entryInstance.begin());
             lock.unlock();
         }
         return wasAvailable;
     }
 
-    void Executor::addAction(std::function<void()> func, std::int64_t instanceId)
+    void Executor::addAction(ActionFunction func, std::int64_t instanceId)
     {
         bool notify = false;
         std::unique_lock<std::mutex> lock(m_mutex);
         if (instanceId != 0)
         {
-            auto& count = m_storedIds[instanceId];
-            notify = (count == 0);
-            ++count;
+            notify = incrementStoredId(instanceId);
         }
         else
         {
@@ -224,11 +242,11 @@ namespace finalmq
         }
         if (!m_actions.empty() && m_actions.back().instanceId == instanceId)
         {
-            m_actions.back().funcs.push_back(std::make_unique<std::function<void()>>(std::move(func)));
+            m_actions.back().funcs.push_back(std::move(func));
         }
         else
         {
-            m_actions.emplace_back(instanceId, std::make_unique<std::function<void()>>(std::move(func)));
+            createEntry(instanceId).funcs.push_back(std::move(func));
         }
         lock.unlock();
         if (notify)
@@ -241,11 +259,128 @@ namespace finalmq
         }
     }
 
+    Executor::ActionEntry& Executor::createEntry(std::int64_t instanceId)
+    {
+        if (!m_actionsFree.empty())
+        {
+            m_actions.splice(m_actions.end(), m_actionsFree, m_actionsFree.begin());
+        }
+        else
+        {
+            m_actions.emplace_back();
+        }
+        ActionEntry& entry = m_actions.back();
+        entry.instanceId = instanceId;
+        return entry;
+    }
+
+    void Executor::releaseEntry(ActionList& list, ActionList::iterator it)
+    {
+        it->funcs.clear();
+        it->front = 0;
+        if (m_actionsFree.size() < MAX_FREE_NODES)
+        {
+            m_actionsFree.splice(m_actionsFree.end(), list, it);
+        }
+        else
+        {
+            list.erase(it);
+        }
+    }
+
+    bool Executor::incrementStoredId(std::int64_t instanceId)
+    {
+        auto it = m_storedIds.find(instanceId);
+        if (it == m_storedIds.end())
+        {
+            if (!m_storedIdsFree.empty())
+            {
+                StoredIds::node_type node = std::move(m_storedIdsFree.back());
+                m_storedIdsFree.pop_back();
+                node.key() = instanceId;
+                node.mapped() = 0;
+                it = m_storedIds.insert(std::move(node)).position;
+            }
+            else
+            {
+                it = m_storedIds.emplace(instanceId, 0).first;
+            }
+        }
+        ++it->second;
+        return (it->second == 1);
+    }
+
+    void Executor::decrementStoredId(std::int64_t instanceId, std::int32_t count)
+    {
+        auto it = m_storedIds.find(instanceId);
+        assert(it != m_storedIds.end());
+        auto& counter = it->second;
+        assert(counter > 0);
+        assert(counter >= count);
+        counter -= count;
+        if (counter == 0)
+        {
+            if (m_storedIdsFree.size() < MAX_FREE_NODES)
+            {
+                m_storedIdsFree.push_back(m_storedIds.extract(it));
+            }
+            else
+            {
+                m_storedIds.erase(it);
+            }
+        }
+    }
+
+    void Executor::insertRunningId(std::int64_t instanceId)
+    {
+        if (!m_runningIdsFree.empty())
+        {
+            RunningIds::node_type node = std::move(m_runningIdsFree.back());
+            m_runningIdsFree.pop_back();
+            node.value() = instanceId;
+            m_runningIds.insert(std::move(node));
+        }
+        else
+        {
+            m_runningIds.insert(instanceId);
+        }
+    }
+
+    void Executor::eraseRunningId(std::int64_t instanceId)
+    {
+        auto it = m_runningIds.find(instanceId);
+        if (it != m_runningIds.end())
+        {
+            if (m_runningIdsFree.size() < MAX_FREE_NODES)
+            {
+                m_runningIdsFree.push_back(m_runningIds.extract(it));
+            }
+            else
+            {
+                m_runningIds.erase(it);
+            }
+        }
+    }
+
+    void Executor::clearIds()
+    {
+        while (!m_storedIds.empty() && m_storedIdsFree.size() < MAX_FREE_NODES)
+        {
+            m_storedIdsFree.push_back(m_storedIds.extract(m_storedIds.begin()));
+        }
+        m_storedIds.clear();
+        while (!m_runningIds.empty() && m_runningIdsFree.size() < MAX_FREE_NODES)
+        {
+            m_runningIdsFree.push_back(m_runningIds.extract(m_runningIds.begin()));
+        }
+        m_runningIds.clear();
+    }
+
     //////////////////////////////////////////////////
 
     bool ExecutorIgnoreOrderOfInstance::runAvailableActions(const FuncIsAbort& funcIsAbort)
     {
-        std::deque<std::function<void()>> actions;
+        std::deque<ActionFunction> actions;
         std::unique_lock<std::mutex> lock(m_mutex);
         actions = std::move(m_actions);
         m_actions.clear();
@@ -276,7 +411,7 @@ namespace finalmq
         bool wasAvailable = false;
         bool stillActions = false;
         std::unique_lock<std::mutex> lock(m_mutex);
-        std::function<void()> action;
+        ActionFunction action;
         if (!m_actions.empty())
         {
             action = std::move(m_actions.front());
@@ -300,7 +435,7 @@ namespace finalmq
         return wasAvailable;
     }
 
-    void ExecutorIgnoreOrderOfInstance::addAction(std::function<void()> func, std::int64_t /*instanceId*/)
+    void ExecutorIgnoreOrderOfInstance::addAction(ActionFunction func, std::int64_t /*instanceId*/)
     {
         std::unique_lock<std::mutex> lock(m_mutex);
         bool notify = m_actions.empty();
@@ -318,6 +453,472 @@ namespace finalmq
 
     //////////////////////////////////////////////////
 
+    namespace
+    {
+        struct WorkerContext
+        {
+            const void* executor{nullptr};
+            void* deque{nullptr};
+        };
+        thread_local WorkerContext t_workerContext{};
+    }
+
+    ExecutorWorkStealing::WorkerDeque::Array::Array(std::int64_t c)
+        : capacity(c)
+        , mask(c - 1)
+        , buffer(std::make_unique<std::atomic<Task*>[]>(static_cast<size_t>(c)))
+    {
+    }
+
+    ExecutorWorkStealing::WorkerDeque::WorkerDeque()
+    {
+        m_arrays.push_back(std::make_unique<Array>(256));
+        m_array.store(m_arrays.back().get(), std::memory_order_relaxed);
+    }
+
+    ExecutorWorkStealing::WorkerDeque::~WorkerDeque()
+    {
+        Task* task = nullptr;
+        while ((task = pop()) != nullptr)
+        {
+            if (task->strand == nullptr)
+            {
+                delete task;
+            }
+        }
+    }
+
+    ExecutorWorkStealing::WorkerDeque::Array* ExecutorWorkStealing::WorkerDeque::grow(Array* array, std::int64_t bottom, std::int64_t top)
+    {
+        // old arrays are kept alive, because a thief could still read from them
+        m_arrays.push_back(std::make_unique<Array>(array->capacity * 2));
+        Array* arrayNew = m_arrays.back().get();
+        for (std::int64_t i = top; i < bottom; ++i)
+        {
+            arrayNew->buffer[i & arrayNew->mask].store(array->buffer[i & array->mask].load(std::memory_order_relaxed), std::memory_order_relaxed);
+        }
+        m_array.store(arrayNew, std::memory_order_release);
+        return arrayNew;
+    }
+
+    void ExecutorWorkStealing::WorkerDeque::push(Task* task)
+    {
+        std::int64_t bottom = m_bottom.load(std::memory_order_relaxed);
+        std::int64_t top = m_top.load(std::memory_order_acquire);
+        Array* array = m_array.load(std::memory_order_relaxed);
+        if (bottom - top > array->capacity - 1)
+        {
+            array = grow(array, bottom, top);
+        }
+        array->buffer[bottom & array->mask].store(task, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        m_bottom.store(bottom + 1, std::memory_order_relaxed);
+    }
+
+    ExecutorWorkStealing::Task* ExecutorWorkStealing::WorkerDeque::pop()
+    {
+        std::int64_t bottom = m_bottom.load(std::memory_order_relaxed) - 1;
+        Array* array = m_array.load(std::memory_order_relaxed);
+        m_bottom.store(bottom, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        std::int64_t top = m_top.load(std::memory_order_relaxed);
+        Task* task = nullptr;
+        if (top <= bottom)
+        {
+            task = array->buffer[bottom & array->mask].load(std::memory_order_relaxed);
+            if (top == bottom)
+            {
+                // last element, race against the thieves
+                if (!m_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+                {
+                    task = nullptr;
+                }
+                m_bottom.store(bottom + 1, std::memory_order_relaxed);
+            }
+        }
+        else
+        {
+            m_bottom.store(bottom + 1, std::memory_order_relaxed);
+        }
+        return task;
+    }
+
+    ExecutorWorkStealing::Task* ExecutorWorkStealing::WorkerDeque::steal()
+    {
+        std::int64_t top = m_top.load(std::memory_order_acquire);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        std::int64_t bottom = m_bottom.load(std::memory_order_acquire);
+        if (top < bottom)
+        {
+            Array* array = m_array.load(std::memory_order_acquire);
+            Task* task = array->buffer[top & array->mask].load(std::memory_order_relaxed);
+            if (m_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+            {
+                return task;
+            }
+        }
+        return nullptr;
+    }
+
+    ExecutorWorkStealing::InjectionQueue::InjectionQueue()
+        : m_cells(std::make_unique<Cell[]>(CAPACITY))
+    {
+        for (std::size_t i = 0; i < CAPACITY; ++i)
+        {
+            m_cells[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    bool ExecutorWorkStealing::InjectionQueue::push(Task* task)
+    {
+        Cell* cell = nullptr;
+        std::size_t pos = m_enqueuePos.load(std::memory_order_relaxed);
+        while (true)
+        {
+            cell = &m_cells[pos & (CAPACITY - 1)];
+            std::size_t sequence = cell->sequence.load(std::memory_order_acquire);
+            std::intptr_t diff = static_cast<std::intptr_t>(sequence) - static_cast<std::intptr_t>(pos);
+            if (diff == 0)
+            {
+                if (m_enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                {
+                    break;
+                }
+            }
+            else if (diff < 0)
+            {
+                return false;
+            }
+            else
+            {
+                pos = m_enqueuePos.load(std::memory_order_relaxed);
+            }
+        }
+        cell->task = task;
+        cell->sequence.store(pos + 1, std::memory_order_release);
+        return true;
+    }
+
+    ExecutorWorkStealing::Task* ExecutorWorkStealing::InjectionQueue::pop()
+    {
+        Cell* cell = nullptr;
+        std::size_t pos = m_dequeuePos.load(std::memory_order_relaxed);
+        while (true)
+        {
+            cell = &m_cells[pos & (CAPACITY - 1)];
+            std::size_t sequence = cell->sequence.load(std::memory_order_acquire);
+            std::intptr_t diff = static_cast<std::intptr_t>(sequence) - static_cast<std::intptr_t>(pos + 1);
+            if (diff == 0)
+            {
+                if (m_dequeuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                {
+                    break;
+                }
+            }
+            else if (diff < 0)
+            {
+                return nullptr;
+            }
+            else
+            {
+                pos = m_dequeuePos.load(std::memory_order_relaxed);
+            }
+        }
+        Task* task = cell->task;
+        cell->sequence.store(pos + CAPACITY, std::memory_order_release);
+        return task;
+    }
+
+    ExecutorWorkStealing::ExecutorWorkStealing()
+    {
+        for (auto& worker : m_workers)
+        {
+            worker.store(nullptr, std::memory_order_relaxed);
+        }
+    }
+
+    ExecutorWorkStealing::~ExecutorWorkStealing()
+    {
+        for (auto& worker : m_workers)
+        {
+            delete worker.load();
+        }
+        Task* task = nullptr;
+        while ((task = m_injection.pop()) != nullptr)
+        {
+            if (task->strand == nullptr)
+            {
+                delete task;
+            }
+        }
+        for (auto it = m_overflow.begin(); it != m_overflow.end(); ++it)
+        {
+            if ((*it)->strand == nullptr)
+            {
+                delete *it;
+            }
+        }
+        for (auto& shard : m_shards)
+        {
+            for (auto it = shard.strands.begin(); it != shard.strands.end(); ++it)
+            {
+                delete it->second;
+            }
+        }
+    }
+
+    ExecutorWorkStealing::WorkerDeque* ExecutorWorkStealing::getOwnDeque() const
+    {
+        if (t_workerContext.executor == this)
+        {
+            return static_cast<WorkerDeque*>(t_workerContext.deque);
+        }
+        return nullptr;
+    }
+
+    ExecutorWorkStealing::WorkerDeque* ExecutorWorkStealing::registerWorker()
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        int numberOfWorkers = m_numberOfWorkers.load(std::memory_order_relaxed);
+        if (numberOfWorkers >= MAX_WORKERS)
+        {
+            return nullptr;
+        }
+        WorkerDeque* deque = new WorkerDeque();
+        m_workers[numberOfWorkers].store(deque, std::memory_order_release);
+        m_numberOfWorkers.store(numberOfWorkers + 1, std::memory_order_release);
+        return deque;
+    }
+
+    ExecutorWorkStealing::StrandShard& ExecutorWorkStealing::getShard(std::int64_t instanceId)
+    {
+        std::uint64_t hash = static_cast<std::uint64_t>(instanceId) * 0x9E3779B97F4A7C15ull;
+        return m_shards[static_cast<size_t>(hash >> 58) & (NUMBER_OF_SHARDS - 1)];
+    }
+
+    void ExecutorWorkStealing::schedule(Task* task)
+    {
+        bool wasEmpty = (m_pending.fetch_add(1) == 0);
+        WorkerDeque* deque = getOwnDeque();
+        if (deque)
+        {
+            deque->push(task);
+        }
+        else if (!m_injection.push(task))
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_overflow.push_back(task);
+            m_overflowSize.fetch_add(1, std::memory_order_release);
+        }
+        notifyWorkers(wasEmpty);
+    }
+
+    void ExecutorWorkStealing::notifyWorkers(bool wasEmpty)
+    {
+        if (m_sleeping.load() > 0)
+        {
+            m_newActions = true;
+        }
+        if (wasEmpty && m_funcNotify)
+        {
+            m_funcNotify();
+        }
+    }
+
+    ExecutorWorkStealing::Task* ExecutorWorkStealing::takeTask(WorkerDeque* ownDeque)
+    {
+        if (m_pending.load() <= 0)
+        {
+            return nullptr;
+        }
+        Task* task = nullptr;
+        if (ownDeque)
+        {
+            task = ownDeque->pop();
+        }
+        if (!task)
+        {
+            task = m_injection.pop();
+        }
+        if (!task && m_overflowSize.load(std::memory_order_acquire) > 0)
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            if (!m_overflow.empty())
+            {
+                task = m_overflow.front();
+                m_overflow.pop_front();
+                m_overflowSize.fetch_sub(1, std::memory_order_relaxed);
+            }
+        }
+        if (!task)
+        {
+            int numberOfWorkers = m_numberOfWorkers.load(std::memory_order_acquire);
+            if (numberOfWorkers > 0)
+            {
+                int start = static_cast<int>(m_stealStart.fetch_add(1, std::memory_order_relaxed) % numberOfWorkers);
+                for (int i = 0; i < numberOfWorkers && !task; ++i)
+                {
+                    WorkerDeque* deque = m_workers[(start + i) % numberOfWorkers].load(std::memory_order_acquire);
+                    if (deque && deque != ownDeque)
+                    {
+                        task = deque->steal();
+                    }
+                }
+            }
+        }
+        if (task)
+        {
+            std::int64_t pending = m_pending.fetch_sub(1) - 1;
+            // trigger next possible thread
+            if (pending > 0 && m_sleeping.load() > 0)
+            {
+                m_newActions = true;
+            }
+        }
+        return task;
+    }
+
+    void ExecutorWorkStealing::runTask(Task* task, const FuncIsAbort& funcIsAbort)
+    {
+        if (task->strand)
+        {
+            runStrand(task->strand, funcIsAbort);
+        }
+        else
+        {
+            assert(task->func);
+            if (!funcIsAbort || !funcIsAbort())
+            {
+                task->func();
+            }
+            delete task;
+        }
+    }
+
+    void ExecutorWorkStealing::runStrand(Strand* strand, const FuncIsAbort& funcIsAbort)
+    {
+        StrandShard& shard = getShard(strand->instanceId);
+        std::vector<ActionFunction> funcs;
+        std::unique_lock<std::mutex> lock(shard.mutex);
+        funcs.swap(strand->funcs);
+        lock.unlock();
+
+        for (auto it = funcs.begin(); it != funcs.end(); ++it)
+        {
+            assert(*it);
+            if (!funcIsAbort || !funcIsAbort())
+            {
+                (*it)();
+            }
+            else
+            {
+                break;
+            }
+        }
+
+        lock.lock();
+        if (strand->funcs.empty())
+        {
+            shard.strands.erase(strand->instanceId);
+            lock.unlock();
+            delete strand;
+        }
+        else
+        {
+            lock.unlock();
+            schedule(&strand->task);
+        }
+    }
+
+    void ExecutorWorkStealing::run()
+    {
+        WorkerDeque* deque = registerWorker();
+        t_workerContext.executor = this;
+        t_workerContext.deque = deque;
+        const FuncIsAbort funcIsAbort = [this]() {
+            return m_terminate.load();
+        };
+        while (!m_terminate.load())
+        {
+            Task* task = takeTask(deque);
+            if (task)
+            {
+                runTask(task, funcIsAbort);
+            }
+            else
+            {
+                m_sleeping.fetch_add(1);
+                if (m_pending.load() <= 0 && !m_terminate.load())
+                {
+                    m_newActions.wait();
+                }
+                m_sleeping.fetch_sub(1);
+            }
+        }
+        t_workerContext = {};
+        // release possible other threads
+        m_newActions = true;
+    }
+
+    bool ExecutorWorkStealing::runAvailableActions(const FuncIsAbort& funcIsAbort)
+    {
+        WorkerDeque* deque = getOwnDeque();
+        bool wasAvailable = false;
+        Task* task = nullptr;
+        while ((task = takeTask(deque)) != nullptr)
+        {
+            wasAvailable = true;
+            runTask(task, funcIsAbort);
+            if (funcIsAbort && funcIsAbort())
+            {
+                break;
+            }
+        }
+        return wasAvailable;
+    }
+
+    bool ExecutorWorkStealing::runAvailableActionBatch(const FuncIsAbort& funcIsAbort)
+    {
+        Task* task = takeTask(getOwnDeque());
+        if (task)
+        {
+            runTask(task, funcIsAbort);
+            return true;
+        }
+        return false;
+    }
+
+    void ExecutorWorkStealing::addAction(ActionFunction func, std::int64_t instanceId)
+    {
+        if (instanceId == 0)
+        {
+            schedule(new Task{std::move(func), nullptr});
+            return;
+        }
+
+        Strand* strandNew = nullptr;
+        StrandShard& shard = getShard(instanceId);
+        std::unique_lock<std::mutex> lock(shard.mutex);
+        Strand*& strand = shard.strands[instanceId];
+        if (strand == nullptr)
+        {
+            strand = new Strand();
+            strand->instanceId = instanceId;
+            strand->task.strand = strand;
+            strandNew = strand;
+        }
+        strand->funcs.push_back(std::move(func));
+        lock.unlock();
+
+        // a strand is scheduled once, the running worker reschedules it, if more actions arrived
+        if (strandNew)
+        {
+            schedule(&strandNew->task);
+        }
+    }
+
+    //////////////////////////////////////////////////
+
     ExecutorWorkerBase::ExecutorWorkerBase(const std::shared_ptr<IExecutor>& executor, int numberOfWorkerThreads)
         : m_executor(executor)
     {
@@ -340,7 +941,7 @@ namespace finalmq
         return m_executor;
     }
 
-    void ExecutorWorkerBase::addAction(std::function<void()> func, std::int64_t instanceId)
+    void ExecutorWorkerBase::addAction(ActionFunction func, std::int64_t instanceId)
     {
         m_executor->addAction(std::move(func), instanceId);
     }
@@ -36,7 +36,13 @@
 #ifndef __QNX__
 #include <sys/unistd.h>
 #endif
+#if defined(__linux__)
+#include <sys/sendfile.h>
 #endif
+#endif
+
+#include <algorithm>
+#include <vector>
 
 namespace finalmq
 {
@@ -141,6 +147,56 @@ namespace finalmq
 #endif
     }
 
+    int OperatingSystemImpl::sendv(SOCKET fd, const struct iovec* iov, int iovcnt, int flags)
+    {
+#if defined(WIN32) || defined(__MINGW32__)
+        int lenWritten = 0;
+        for (int i = 0; i < iovcnt; ++i)
+        {
+            const int len = static_cast<int>(iov[i].iov_len);
+            int err = ::send(fd, static_cast<const char*>(iov[i].iov_base), len, flags);
+            if (err == -1)
+            {
+                return (lenWritten > 0) ? lenWritten : err;
+            }
+            lenWritten += err;
+            if (err != len)
+            {
+                break;
+            }
+        }
+        return lenWritten;
+#else
+        struct msghdr msg;
+        memset(&msg, 0, sizeof(msg));
+        msg.msg_iov = const_cast<struct iovec*>(iov);
+        msg.msg_iovlen = iovcnt;
+        return static_cast<int>(::sendmsg(fd, &msg, flags));
+#endif
+    }
+
+    int OperatingSystemImpl::sendfile(SOCKET fd, int fdFile, off_t offset, int len)
+    {
+#if defined(__linux__)
+        return static_cast<int>(::sendfile(fd, fdFile, &offset, static_cast<size_t>(len)));
+#else
+        // no sendfile, read the file region and send it. Nothing is remembered between the calls,
+        // a partial send is continued at the next offset.
+        static const int MAX_CHUNK_SIZE = 65536;
+        std::vector<char> buffer(std::min(len, MAX_CHUNK_SIZE));
+        if (::lseek(fdFile, offset, SEEK_SET) == -1)
+        {
+            return -1;
+        }
+        int err = static_cast<int>(::read(fdFile, buffer.data(), static_cast<unsigned int>(buffer.size())));
+        if (err <= 0)
+        {
+            return err;
+        }
+        return send(fd, buffer.data(), err, 0);
+#endif
+    }
+
     int OperatingSystemImpl::recv(SOCKET fd, char* buffer, int len, int flags)
     {
 #if defined(WIN32) || defined(__MINGW32__)
@@ -271,6 +327,12 @@ namespace finalmq
         return err;
     }
 
+    int OperatingSystemImpl::eventfd(unsigned int initval, int flags)
+    {
+        int err = ::eventfd(initval, flags);
+        return err;
+    }
+
     int OperatingSystemImpl::makeSocketPair(SocketDescriptorPtr& socket1, SocketDescriptorPtr& socket2)
     {
         int sds[2];
@@ -22,6 +22,7 @@
 
 
 #include "finalmq/json/JsonBuilder.h"
+#include "finalmq/json/JsonScanner.h"
 #include "finalmq/conversions/itoa.h"
 #include "finalmq/conversions/dtoa.h"
 #include "finalmq/logger/LogStream.h"
@@ -34,6 +35,8 @@
 
 namespace finalmq {
 
+// a surrogate pair needs two 6 character escapes
+static constexpr ssize_t MAX_ESCAPE_SIZE = 12;
 
 JsonBuilder::JsonBuilder(IZeroCopyBuffer& buffer, int maxBlockSize)
     : m_zeroCopybuffer(buffer)
@@ -87,6 +90,27 @@ void JsonBuilder::resizeBuffer()
 }
 
 
+void JsonBuilder::writeChunked(const char* str, ssize_t size)
+{
+    ssize_t sizeRemaining = m_bufferEnd - m_buffer;
+    if (sizeRemaining < size)
+    {
+        // fill the current block, the rest goes into the next block
+        if (sizeRemaining > 0)
+        {
+            memcpy(m_buffer, str, sizeRemaining);
+            m_buffer += sizeRemaining;
+            str += sizeRemaining;
+            size -= sizeRemaining;
+        }
+        reserveSpace(size);
+    }
+    assert(m_buffer);
+    memcpy(m_buffer, str, size);
+    m_buffer += size;
+}
+
+
 void JsonBuilder::putJson(const char* json, ssize_t size)
 {
     reserveSpace(size);
@@ -173,26 +197,12 @@ void JsonBuilder::enterDouble(double value)
 
 void JsonBuilder::enterString(const char* value, ssize_t size)
 {
-    reserveSpace(size*6 + 2 + 1); // string*6 + 2" + comma
-    *m_buffer = '\"';
-    ++m_buffer;
-    escapeString(value, size);
-    *m_buffer = '\"';
-    ++m_buffer;
-    *m_buffer = ',';
-    ++m_buffer;
+    writeString(value, size, ',');
 }
 
 void JsonBuilder::enterString(std::string&& value)
 {
-    reserveSpace(value.size()*6 + 2 + 1); // string*6 + 2" + comma
-    *m_buffer = '\"';
-    ++m_buffer;
-    escapeString(value.c_str(), value.size());
-    *m_buffer = '\"';
-    ++m_buffer;
-    *m_buffer = ',';
-    ++m_buffer;
+    writeString(value.c_str(), value.size(), ',');
 }
 
 void JsonBuilder::enterArray()
@@ -234,31 +244,29 @@ void JsonBuilder::exitObject()
 
 void JsonBuilder::enterKey(const char* key, ssize_t size)
 {
-    reserveSpace(size*6 + 2 + 1); // string*6 + 2" + :
-    *m_buffer = '\"';
-    ++m_buffer;
-    escapeString(key, size);
-    *m_buffer = '\"';
-    ++m_buffer;
-    *m_buffer = ':';
-    ++m_buffer;
+    writeString(key, size, ':');
 }
 
 void JsonBuilder::enterKey(std::string&& key)
 {
-    reserveSpace(key.size()*6 + 2 + 1); // string*6 + 2" + :
+    writeString(key.c_str(), key.size(), ':');
+}
+
+
+void JsonBuilder::writeString(const char* str, ssize_t size, char terminator)
+{
+    // no worst case reservation (size * 6) for the escapes, escapeString reserves incrementally
+    reserveSpace(size + 3); // string + 2" + terminator
     *m_buffer = '\"';
     ++m_buffer;
-    escapeString(key.c_str(), key.size());
+    escapeString(str, size);
+    reserveSpace(2);
     *m_buffer = '\"';
     ++m_buffer;
-    *m_buffer = ':';
+    *m_buffer = terminator;
     ++m_buffer;
 }
 
-
-
-
 void JsonBuilder::finished()
 {
     correctComma();
@@ -366,9 +374,21 @@ void JsonBuilder::escapeString(const char* str, ssize_t size)
 
     const char* end = str + size;
 
-
     while (str < end)
     {
+        // copy the characters that need no escape at once
+        const char* next = JsonScanner::findEscapeNeeded(str, end);
+        if (next != str)
+        {
+            writeChunked(str, next - str);
+            str = next;
+            if (str == end)
+            {
+                break;
+            }
+        }
+
+        reserveSpace(MAX_ESCAPE_SIZE);
         unsigned char c = static_cast<unsigned char>(*str);
         if (c < 0x20)
         {
@@ -392,11 +412,9 @@ void JsonBuilder::escapeString(const char* str, ssize_t size)
         }
         else if (c < 0x80)
         {
-            if (c == '\\' || c == '\"')
-            {
-                *m_buffer = '\\';
-                m_buffer++;
-            }
+            assert(c == '\\' || c == '\"');
+            *m_buffer = '\\';
+            m_buffer++;
             *m_buffer = c;
             m_buffer++;
             str++;
@@ -451,7 +469,6 @@ void JsonBuilder::escapeString(const char* str, ssize_t size)
                 *m_buffer = hexDigits[((trail)       & 0x0f)];
                 m_buffer++;
             }
-            str++;
         }
     }
 }
@@ -22,6 +22,8 @@
 
 #include "finalmq/json/JsonParser.h"
 
+#include <cfloat>
+#include <charconv>
 #include <climits>
 #include <limits>
 #include <string>
@@ -29,9 +31,182 @@
 #include <assert.h>
 
 #include "finalmq/helpers/FmqDefines.h"
+#include "finalmq/json/JsonScanner.h"
 
 namespace finalmq
 {
+static inline bool isDigit(char c)
+{
+    return (static_cast<unsigned char>(c - '0') <= 9);
+}
+
+#if (defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__) || defined(_WIN32)
+// 8 digits at once, see "Fast numeric string to int" by Kholdstare and fast_float
+static inline bool isEightDigits(std::uint64_t value)
+{
+    return (((value & 0xF0F0F0F0F0F0F0F0ull) | (((value + 0x0606060606060606ull) & 0xF0F0F0F0F0F0F0F0ull) >> 4)) == 0x3333333333333333ull);
+}
+
+static inline std::uint32_t parseEightDigits(std::uint64_t value)
+{
+    static constexpr std::uint64_t MASK = 0x000000FF000000FFull;
+    static constexpr std::uint64_t MUL1 = 0x000F424000000064ull; // 100 + (1000000ULL << 32)
+    static constexpr std::uint64_t MUL2 = 0x0000271000000001ull; // 1 + (10000ULL << 32)
+    value -= 0x3030303030303030ull;
+    value = (value * 10) + (value >> 8);
+    value = (((value & MASK) * MUL1) + (((value >> 16) & MASK) * MUL2)) >> 32;
+    return static_cast<std::uint32_t>(value);
+}
+#define FINALMQ_PARSE_EIGHT_DIGITS
+#endif
+
+/**
+ * Parses the digits in [str, end) into value. Overflows saturate to UINT64_MAX (like strtoull).
+ * Returns the position of the first character that is not a digit.
+ */
+static const char* parseUInt64(const char* str, const char* end, std::uint64_t& value)
+{
+    std::uint64_t v = 0;
+    // up to 19 digits cannot overflow
+    const char* endNoOverflow = (end - str > 19) ? str + 19 : end;
+#ifdef FINALMQ_PARSE_EIGHT_DIGITS
+    while (endNoOverflow - str >= 8)
+    {
+        std::uint64_t eightChars;
+        memcpy(&eightChars, str, sizeof(eightChars));
+        if (!isEightDigits(eightChars))
+        {
+            break;
+        }
+        v = v * 100000000 + parseEightDigits(eightChars);
+        str += 8;
+    }
+#endif
+    while (str < endNoOverflow && isDigit(*str))
+    {
+        v = v * 10 + static_cast<std::uint64_t>(*str - '0');
+        ++str;
+    }
+    bool overflow = false;
+    while (str < end && isDigit(*str))
+    {
+        const std::uint64_t digit = static_cast<std::uint64_t>(*str - '0');
+        if (v > (std::numeric_limits<std::uint64_t>::max() - digit) / 10)
+        {
+            overflow = true;
+        }
+        else
+        {
+            v = v * 10 + digit;
+        }
+        ++str;
+    }
+    value = overflow ? std::numeric_limits<std::uint64_t>::max() : v;
+    return str;
+}
+
+/**
+ * Parses a JSON number in [first, end) into value. Returns the position where the number ends.
+ * Numbers with up to 19 significant digits and a small decimal exponent are converted exactly
+ * with one floating point operation (Clinger's fast path), all other numbers are converted
+ * by std::from_chars, which is not locale dependent.
+ */
+static const char* parseDouble(const char* first, const char* end, double& value)
+{
+    const char* str = first;
+    const bool negative = (str < end && *str == '-');
+    if (negative)
+    {
+        ++str;
+    }
+
+    std::uint64_t mantissa = 0;
+    int significantDigits = 0;
+    int exponent = 0;
+    const char* strDigits = str;
+    while (str < end && isDigit(*str))
+    {
+        mantissa = mantissa * 10 + static_cast<std::uint64_t>(*str - '0');
+        significantDigits += (mantissa != 0) ? 1 : 0;
+        ++str;
+    }
+    if (str == strDigits)
+    {
+        return str;
+    }
+    if (str < end && *str == '.')
+    {
+        ++str;
+        while (str < end && isDigit(*str))
+        {
+            mantissa = mantissa * 10 + static_cast<std::uint64_t>(*str - '0');
+            significantDigits += (mantissa != 0) ? 1 : 0;
+            --exponent;
+            ++str;
+        }
+    }
+    if (str < end && (*str == 'e' || *str == 'E'))
+    {
+        const char* strExponent = str;
+        ++str;
+        bool exponentNegative = false;
+        if (str < end && (*str == '+' || *str == '-'))
+        {
+            exponentNegative = (*str == '-');
+            ++str;
+        }
+        if (str < end && isDigit(*str))
+        {
+            int exponentValue = 0;
+            while (str < end && isDigit(*str))
+            {
+                if (exponentValue < 100000)
+                {
+                    exponentValue = exponentValue * 10 + (*str - '0');
+                }
+                ++str;
+            }
+            exponent += exponentNegative ? -exponentValue : exponentValue;
+        }
+        else
+        {
+            // no exponent digits, the number ends before the 'e'
+            str = strExponent;
+        }
+    }
+
+#if FLT_EVAL_METHOD == 0
+    static const double POWERS_OF_TEN[] = {1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+                                           1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+    if (significantDigits <= 19 && mantissa <= (1ull << 53) && exponent >= -22 && exponent <= 22)
+    {
+        double d = static_cast<double>(mantissa);
+        if (exponent < 0)
+        {
+            d /= POWERS_OF_TEN[-exponent];
+        }
+        else
+        {
+            d *= POWERS_OF_TEN[exponent];
+        }
+        value = negative ? -d : d;
+        return str;
+    }
+#endif
+
+#if defined(__cpp_lib_to_chars) && __cpp_lib_to_chars >= 201611L
+    std::from_chars_result result = std::from_chars(first, str, value);
+    if (result.ec == std::errc() && result.ptr == str)
+    {
+        return str;
+    }
+#endif
+    // out of range (inf, denormals) or no std::from_chars for double
+    std::string number(first, str);
+    value = strtod(number.c_str(), nullptr);
+    return str;
+}
+
 JsonParser::JsonParser(IJsonParserVisitor& visitor)
     : m_visitor(visitor)
 {
@@ -44,22 +219,7 @@ char JsonParser::getChar(const char* str) const
 
 void JsonParser::parseWhiteSpace()
 {
-    char c;
-    while ((c = this->getChar(m_str)) != 0)
-    {
-        switch(c)
-        {
-            case ' ':
-            case '\t':
-            case '\n':
-            case '\r':
-                m_str++;
-                break;
-            default:
-                return;
-                break;
-        }
-    }
+    m_str = JsonScanner::skipWhiteSpace(m_str, m_end);
 }
 
 const char* JsonParser::parse(const char* str, ssize_t size)
@@ -223,10 +383,11 @@ void JsonParser::parseNumber()
         }
     }
 
-    char* res = nullptr;
+    const char* res = nullptr;
     if (isFloat)
     {
-        double value = strtof64(first, &res);
+        double value = 0.0;
+        res = parseDouble(first, m_str, value);
         if (res != m_str)
         {
             m_visitor.syntaxError(res, "wrong number format");
@@ -237,14 +398,17 @@ void JsonParser::parseNumber()
     }
     else if (isNegative)
     {
-        long long value = strtoll(first, &res, 10);
+        std::uint64_t valueAbs = 0;
+        res = parseUInt64(first + 1, m_str, valueAbs);
         if (res != m_str)
         {
             m_visitor.syntaxError(res, "wrong number format");
             m_str = nullptr;
             return;
         }
-        assert(value < 0);
+        // saturate like strtoll
+        static constexpr std::uint64_t ABS_MIN = static_cast<std::uint64_t>(std::numeric_limits<std::int64_t>::max()) + 1;
+        const std::int64_t value = (valueAbs >= ABS_MIN) ? std::numeric_limits<std::int64_t>::min() : -static_cast<std::int64_t>(valueAbs);
         if (value >= INT_MIN)
         {
             m_visitor.enterInt32(static_cast<std::int32_t>(value));
@@ -256,7 +420,8 @@ void JsonParser::parseNumber()
     }
     else
     {
-        unsigned long long value = strtoull(first, &res, 10);
+        std::uint64_t value = 0;
+        res = parseUInt64(first, m_str, value);
         if (res != m_str)
         {
             m_visitor.syntaxError(res, "wrong number format");
@@ -320,28 +485,21 @@ void JsonParser::parseString(bool key)
     const char* strBegin = m_str;
 
     // try fast parse. it is fast when there is no escape character in the string
-    char c;
-    while ((c = getChar(m_str)) != 0)
+    m_str = JsonScanner::findQuoteOrEscape(m_str, m_end);
+    char c = getChar(m_str);
+    if (c == '\"')
     {
-        if (c == '\"')
+        ssize_t size = m_str - strBegin;
+        if (key)
         {
-            ssize_t size = m_str - strBegin;
-            if (key)
-            {
-                m_visitor.enterKey(strBegin, size);
-            }
-            else
-            {
-                m_visitor.enterString(strBegin, size);
-            }
-            m_str++;
-            return;
+            m_visitor.enterKey(strBegin, size);
         }
-        else if (c == '\\')
+        else
         {
-            break;
+            m_visitor.enterString(strBegin, size);
         }
         m_str++;
+        return;
     }
 
     if (c == 0)
@@ -477,7 +635,11 @@ void JsonParser::parseString(bool key)
         }
         else
         {
-            dest += c;
+            // copy all characters until the next quote or escape at once
+            const char* next = JsonScanner::findQuoteOrEscape(m_str, m_end);
+            dest.append(m_str, next);
+            m_str = next;
+            continue;
         }
         m_str++;
     }
@@ -23,6 +23,7 @@
 
 #include "finalmq/metadata/MetaStruct.h"
 
+#include <algorithm>
 #include <unordered_map>
 
 
@@ -97,12 +98,23 @@ const MetaField* MetaStruct::getFieldByIndex(ssize_t index) const
 }
 
 
-const MetaField* MetaStruct::getFieldByName(const std::string& name) const
+bool MetaStruct::lessName(const NameEntry& entry, std::string_view name)
 {
-    auto it = m_name2Field.find(name);
-    if (it != m_name2Field.end())
+    // the size is compared first, so most of the comparisons do not touch the characters
+    if (entry.name.size() != name.size())
     {
-        return it->second.get();
+        return (entry.name.size() < name.size());
+    }
+    return (entry.name < name);
+}
+
+
+const MetaField* MetaStruct::getFieldByName(std::string_view name) const
+{
+    auto it = std::lower_bound(m_nameIndex.begin(), m_nameIndex.end(), name, lessName);
+    if (it != m_nameIndex.end() && it->name == name)
+    {
+        return it->field;
     }
     return nullptr;
 }
@@ -110,7 +122,8 @@ const MetaField* MetaStruct::getFieldByName(const std::string& name) const
 
 void MetaStruct::addField(const MetaField& field)
 {
-    if (m_name2Field.find(field.name) != m_name2Field.end())
+    auto it = std::lower_bound(m_nameIndex.begin(), m_nameIndex.end(), field.name, lessName);
+    if (it != m_nameIndex.end() && it->name == field.name)
     {
         // field already added
         return;
@@ -120,7 +133,8 @@ void MetaStruct::addField(const MetaField& field)
         field.description, field.flags, field.attrs, static_cast<int>(m_fields.size())));
 
     m_fields.emplace_back(f);
-    m_name2Field.emplace(f->name, f);
+    // the name view points into the field, which is owned by m_fields
+    m_nameIndex.insert(it, {f->name, f.get()});
 }
 
 
@@ -0,0 +1,111 @@
+//MIT License
+
+//Copyright (c) 2020 bexoft GmbH (mail@bexoft.de)
+
+//Permission is hereby granted, free of charge, to any person obtaining a copy
+//of this software and associated documentation files (the "Software"), to deal
+//in the Software without restriction, including without limitation the rights
+//to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//copies of the Software, and to permit persons to whom the Software is
+//furnished to do so, subject to the following conditions:
+
+//The above copyright notice and this permission notice shall be included in all
+//copies or substantial portions of the Software.
+
+//THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//SOFTWARE.
+
+
+#include "finalmq/poller/PollerFactory.h"
+
+#include <atomic>
+#include <stdlib.h>
+#include <string.h>
+
+#include "finalmq/helpers/ModulenameFinalmq.h"
+#include "finalmq/logger/LogStream.h"
+
+#if defined(WIN32) || defined(__MINGW32__) || defined(__QNX__)
+#include "finalmq/poller/PollerImplSelect.h"
+#else
+#include "finalmq/poller/PollerImplEpoll.h"
+#include "finalmq/poller/PollerImplSelect.h"
+#include "finalmq/poller/PollerImplUring.h"
+#endif
+
+namespace finalmq
+{
+static PollerType getPollerTypeFromEnvironment()
+{
+    PollerType pollerType = PollerType::POLLER_DEFAULT;
+    const char* poller = getenv("FINALMQ_POLLER");
+    if (poller)
+    {
+        if (strcmp(poller, "epoll") == 0)
+        {
+            pollerType = PollerType::POLLER_EPOLL;
+        }
+        else if (strcmp(poller, "select") == 0)
+        {
+            pollerType = PollerType::POLLER_SELECT;
+        }
+        else if (strcmp(poller, "uring") == 0)
+        {
+            pollerType = PollerType::POLLER_URING;
+        }
+    }
+    return pollerType;
+}
+
+static std::atomic<PollerType>& defaultPollerType()
+{
+    static std::atomic<PollerType> pollerType{getPollerTypeFromEnvironment()};
+    return pollerType;
+}
+
+void PollerFactory::setDefaultPollerType(PollerType pollerType)
+{
+    defaultPollerType() = pollerType;
+}
+
+PollerType PollerFactory::getDefaultPollerType()
+{
+    return defaultPollerType();
+}
+
+std::shared_ptr<IPoller> PollerFactory::createPoller(PollerType pollerType)
+{
+    if (pollerType == PollerType::POLLER_DEFAULT)
+    {
+        pollerType = defaultPollerType();
+    }
+
+#if defined(WIN32) || defined(__MINGW32__) || defined(__QNX__)
+    return std::make_shared<PollerImplSelect>();
+#else
+    switch (pollerType)
+    {
+        case PollerType::POLLER_SELECT:
+            return std::make_shared<PollerImplSelect>();
+        case PollerType::POLLER_URING:
+#ifdef FINALMQ_HAS_URING
+            if (PollerImplUring::isAvailable())
+            {
+                return std::make_shared<PollerImplUring>();
+            }
+#endif
+            streamInfo << "io_uring is not available, use epoll";
+            break;
+        default:
+            break;
+    }
+    return std::make_shared<PollerImplEpoll>();
+#endif
+}
+
+} // namespace finalmq
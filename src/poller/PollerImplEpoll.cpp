@@ -27,7 +27,6 @@
 #include <assert.h>
 
 #include <netinet/tcp.h>
-#include <sys/ioctl.h>
 
 #include "finalmq/helpers/ModulenameFinalmq.h"
 #include "finalmq/helpers/OperatingSystem.h"
@@ -52,12 +51,12 @@ void PollerImplEpoll::init()
 {
     m_fdEpoll = OperatingSystem::instance().epoll_create1(EPOLL_CLOEXEC);
     assert(m_fdEpoll != -1);
-    int res = OperatingSystem::instance().makeSocketPair(m_controlSocketRead, m_controlSocketWrite);
-    if (res == 0)
+    int fdEvent = OperatingSystem::instance().eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    assert(fdEvent != -1);
+    if (fdEvent != -1)
     {
-        assert(m_controlSocketWrite);
-        assert(m_controlSocketRead);
-        addSocketEnableRead(m_controlSocketRead);
+        m_controlEvent = std::make_shared<SocketDescriptor>(fdEvent);
+        addSocketEnableRead(m_controlEvent);
     }
 }
 
@@ -261,18 +260,22 @@ void PollerImplEpoll::collectSockets(int res)
             SOCKET sd = pe.data.fd;
             DescriptorInfo* descriptorInfo = nullptr;
 
-            if (pe.events & (EPOLLERR | EPOLLHUP))
+            if (sd == m_controlEvent->getDescriptor())
             {
-                if (sd == m_controlSocketRead->getDescriptor())
+                if (pe.events & EPOLLIN)
                 {
-                    // control socket brocken
-                }
-                else
-                {
-                    descriptorInfo = &m_result.descriptorInfos.add();
-                    descriptorInfo->sd = sd;
-                    descriptorInfo->disconnected = true;
+                    // reset the eventfd, the next releaseWait() may signal again
+                    std::uint64_t value = 0;
+                    OperatingSystem::instance().read(sd, reinterpret_cast<char*>(&value), sizeof(value));
+                    m_wakeupSignaled.store(false, std::memory_order_release);
                 }
+                continue;
+            }
+            if (pe.events & (EPOLLERR | EPOLLHUP))
+            {
+                descriptorInfo = &m_result.descriptorInfos.add();
+                descriptorInfo->sd = sd;
+                descriptorInfo->disconnected = true;
             }
             if (pe.events & EPOLLOUT)
             {
@@ -287,39 +290,14 @@ void PollerImplEpoll::collectSockets(int res)
             }
             if (pe.events & EPOLLIN)
             {
-                int countRead = 0;
-                int resIoCtl = OperatingSystem::instance().ioctlInt(sd, FIONREAD, &countRead);
-                if (resIoCtl == -1)
-                {
-                    countRead = 0;
-                }
-
-                if (sd == m_controlSocketRead->getDescriptor())
-                {
-                    if (countRead > 0)
-                    {
-                        // read pending bytes from control socket
-                        std::vector<char> buffer(countRead);
-                        OperatingSystem::instance().recv(sd, buffer.data(), static_cast<int>(buffer.size()), 0);
-                        m_result.releaseWait = m_releaseFlags.exchange(0, std::memory_order_acq_rel);
-                    }
-                    else
-                    {
-                        // control socket broken
-                    }
-                }
-                else
+                if (descriptorInfo == nullptr)
                 {
-                    if (descriptorInfo == nullptr)
-                    {
-                        descriptorInfo = &m_result.descriptorInfos.add();
-                        descriptorInfo->sd = sd;
-                    }
-                    assert(descriptorInfo);
-                    assert(descriptorInfo->sd == sd);
-                    descriptorInfo->readable = true;
-                    descriptorInfo->bytesToRead = countRead;
+                    descriptorInfo = &m_result.descriptorInfos.add();
+                    descriptorInfo->sd = sd;
                 }
+                assert(descriptorInfo);
+                assert(descriptorInfo->sd == sd);
+                descriptorInfo->readable = true;
             }
         }
     }
@@ -349,6 +327,14 @@ const PollerResult& PollerImplEpoll::wait(std::int32_t timeout)
         updateSocketDescriptors();
     }
 
+    // announce the sleep, releaseWait() signals the eventfd only while the poller sleeps.
+    // If a release is already pending, do not sleep.
+    m_sleeping.store(true, std::memory_order_seq_cst);
+    if (m_releaseFlags.load(std::memory_order_seq_cst) != 0)
+    {
+        timeout = 0;
+    }
+
     do
     {
         res = OperatingSystem::instance().epoll_pwait(m_fdEpoll, &m_events[0], static_cast<int>(m_events.size()), timeout, nullptr);
@@ -364,8 +350,16 @@ const PollerResult& PollerImplEpoll::wait(std::int32_t timeout)
         streamError << "epoll_pwait failed with errno: " << err;
     }
 
+    m_sleeping.store(false, std::memory_order_release);
+
     collectSockets(res);
 
+    m_result.releaseWait = m_releaseFlags.exchange(0, std::memory_order_acq_rel);
+    if (m_result.releaseWait != 0)
+    {
+        m_result.timeout = false;
+    }
+
     if (!m_socketDescriptorsStable.test_and_set(std::memory_order_acq_rel))
     {
         std::unique_lock<std::mutex> locker(m_mutex);
@@ -377,11 +371,16 @@ const PollerResult& PollerImplEpoll::wait(std::int32_t timeout)
 
 void PollerImplEpoll::releaseWait(std::uint32_t info)
 {
-    m_releaseFlags.fetch_or(info, std::memory_order_acq_rel);
-    if (m_controlSocketWrite)
+    m_releaseFlags.fetch_or(info, std::memory_order_seq_cst);
+    // wake up the poller only if it sleeps. All releases until the poller
+    // has reset the eventfd are coalesced into one system call.
+    if (m_sleeping.load(std::memory_order_seq_cst) && !m_wakeupSignaled.exchange(true, std::memory_order_acq_rel))
     {
-        char dummy = 0;
-        OperatingSystem::instance().send(m_controlSocketWrite->getDescriptor(), &dummy, 1, 0);
+        if (m_controlEvent)
+        {
+            std::uint64_t value = 1;
+            OperatingSystem::instance().write(m_controlEvent->getDescriptor(), reinterpret_cast<const char*>(&value), sizeof(value));
+        }
     }
 }
 
@@ -38,6 +38,7 @@
 
 namespace finalmq {
 
+static const int CONTROL_BUFFER_SIZE = 256;
 
 PollerImplSelect::PollerImplSelect()
     : m_socketDescriptorsStable{}
@@ -335,20 +336,13 @@ void PollerImplSelect::collectSockets(int res)
             {
                 cntFd++;
 
-                int countRead = 0;
-                int resIoCtl = OperatingSystem::instance().ioctlInt(sd, FIONREAD, &countRead);
-                if (resIoCtl == -1)
-                {
-                    countRead = 0;
-                }
-
                 if (sd == m_controlSocketRead->getDescriptor())
                 {
+                    // read pending bytes from control socket
+                    char buffer[CONTROL_BUFFER_SIZE];
+                    int countRead = OperatingSystem::instance().recv(sd, buffer, sizeof(buffer), 0);
                     if (countRead > 0)
                     {
-                        // read pending bytes from control socket
-                        std::vector<char> buffer(countRead);
-                        OperatingSystem::instance().recv(sd, buffer.data(), static_cast<int>(buffer.size()), 0);
                         m_result.releaseWait = m_releaseFlags.exchange(0, std::memory_order_acq_rel);
                     }
                     else
@@ -362,7 +356,6 @@ void PollerImplSelect::collectSockets(int res)
                     assert(descriptorInfo);
                     descriptorInfo->sd = sd;
                     descriptorInfo->readable = true;
-                    descriptorInfo->bytesToRead = countRead;
                 }
             }
             if (FD_ISSET(sd, &m_writefds))
@@ -0,0 +1,946 @@
+//MIT License
+
+//Copyright (c) 2020 bexoft GmbH (mail@bexoft.de)
+
+//Permission is hereby granted, free of charge, to any person obtaining a copy
+//of this software and associated documentation files (the "Software"), to deal
+//in the Software without restriction, including without limitation the rights
+//to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//copies of the Software, and to permit persons to whom the Software is
+//furnished to do so, subject to the following conditions:
+
+//The above copyright notice and this permission notice shall be included in all
+//copies or substantial portions of the Software.
+
+//THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//SOFTWARE.
+
+#include "finalmq/poller/PollerImplUring.h"
+
+#ifdef FINALMQ_HAS_URING
+
+#include <algorithm>
+#include <chrono>
+
+#include <assert.h>
+#include <errno.h>
+#include <poll.h>
+#include <signal.h>
+#include <string.h>
+
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include "finalmq/helpers/ModulenameFinalmq.h"
+#include "finalmq/helpers/OperatingSystem.h"
+#include "finalmq/logger/LogStream.h"
+
+namespace finalmq
+{
+static const unsigned int RING_ENTRIES = 1024;
+static const int CONTROL_BUFFER_SIZE = 256;
+static const std::uint64_t USERDATA_CANCEL = 0;
+static const std::int32_t CANCEL_TIMEOUT = 1000;
+static const size_t RECEIVE_BUFFER_SIZE_MIN = 4096;
+static const size_t RECEIVE_BUFFER_SIZE_MAX = 65536;
+
+static inline std::uint64_t makeUserData(std::uint32_t generation, SOCKET sd)
+{
+    return (static_cast<std::uint64_t>(generation) << 32) | static_cast<std::uint32_t>(sd);
+}
+
+static inline SOCKET userDataToSocket(std::uint64_t userData)
+{
+    return static_cast<SOCKET>(userData & 0xffffffff);
+}
+
+static void prepPollRemove(io_uring_sqe* sqe, std::uint64_t userData)
+{
+    sqe->opcode = IORING_OP_POLL_REMOVE;
+    sqe->fd = -1;
+    sqe->addr = userData;
+    sqe->user_data = USERDATA_CANCEL;
+}
+
+static void prepCancel(io_uring_sqe* sqe, std::uint64_t userData)
+{
+    sqe->opcode = IORING_OP_ASYNC_CANCEL;
+    sqe->fd = -1;
+    sqe->addr = userData;
+    sqe->user_data = USERDATA_CANCEL;
+}
+
+static std::uint32_t getPollEvents(std::uint32_t events, bool readCompletions)
+{
+    // a socket with receive or accept completions is not polled for reading
+    return readCompletions ? (events & ~POLLIN) : events;
+}
+
+static int sys_io_uring_setup(unsigned int entries, io_uring_params* params)
+{
+    return static_cast<int>(::syscall(__NR_io_uring_setup, entries, params));
+}
+
+static int sys_io_uring_enter(int fd, unsigned int toSubmit, unsigned int minComplete, unsigned int flags, const void* arg, size_t argsz)
+{
+    return static_cast<int>(::syscall(__NR_io_uring_enter, fd, toSubmit, minComplete, flags, arg, argsz));
+}
+
+PollerImplUring::PollerImplUring()
+{
+}
+
+PollerImplUring::~PollerImplUring()
+{
+    cancelAllPolls();
+    destroyRing();
+}
+
+bool PollerImplUring::isAvailable()
+{
+    io_uring_params params;
+    memset(&params, 0, sizeof(params));
+    int fd = sys_io_uring_setup(4, &params);
+    if (fd < 0)
+    {
+        return false;
+    }
+    ::close(fd);
+    // the wait with timeout needs IORING_FEAT_EXT_ARG (linux 5.11)
+    return ((params.features & IORING_FEAT_EXT_ARG) && (params.features & IORING_FEAT_NODROP));
+}
+
+bool PollerImplUring::setupRing(unsigned int entries)
+{
+    io_uring_params params;
+    memset(&params, 0, sizeof(params));
+    params.flags = IORING_SETUP_CQSIZE;
+    params.cq_entries = entries * 4;
+    m_fdRing = sys_io_uring_setup(entries, &params);
+    if (m_fdRing < 0)
+    {
+        streamError << "io_uring_setup failed with errno: " << errno;
+        m_fdRing = -1;
+        return false;
+    }
+
+    m_sqRingSize = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+    m_cqRingSize = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+    const bool singleMmap = (params.features & IORING_FEAT_SINGLE_MMAP);
+    if (singleMmap)
+    {
+        m_sqRingSize = std::max(m_sqRingSize, m_cqRingSize);
+        m_cqRingSize = m_sqRingSize;
+    }
+
+    m_sqRing = ::mmap(nullptr, m_sqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, m_fdRing, IORING_OFF_SQ_RING);
+    if (m_sqRing == MAP_FAILED)
+    {
+        m_sqRing = nullptr;
+        destroyRing();
+        return false;
+    }
+    if (singleMmap)
+    {
+        m_cqRing = m_sqRing;
+    }
+    else
+    {
+        m_cqRing = ::mmap(nullptr, m_cqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, m_fdRing, IORING_OFF_CQ_RING);
+        if (m_cqRing == MAP_FAILED)
+        {
+            m_cqRing = nullptr;
+            destroyRing();
+            return false;
+        }
+    }
+    m_sqesSize = params.sq_entries * sizeof(io_uring_sqe);
+    void* sqes = ::mmap(nullptr, m_sqesSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, m_fdRing, IORING_OFF_SQES);
+    if (sqes == MAP_FAILED)
+    {
+        destroyRing();
+        return false;
+    }
+    m_sqes = static_cast<io_uring_sqe*>(sqes);
+
+    char* sqRing = static_cast<char*>(m_sqRing);
+    m_sqHead = reinterpret_cast<unsigned*>(sqRing + params.sq_off.head);
+    m_sqTail = reinterpret_cast<unsigned*>(sqRing + params.sq_off.tail);
+    m_sqMask = *reinterpret_cast<unsigned*>(sqRing + params.sq_off.ring_mask);
+    m_sqEntries = *reinterpret_cast<unsigned*>(sqRing + params.sq_off.ring_entries);
+    unsigned* sqArray = reinterpret_cast<unsigned*>(sqRing + params.sq_off.array);
+    // the submission queue entries are used in ring order
+    for (unsigned i = 0; i < m_sqEntries; ++i)
+    {
+        sqArray[i] = i;
+    }
+
+    char* cqRing = static_cast<char*>(m_cqRing);
+    m_cqHead = reinterpret_cast<unsigned*>(cqRing + params.cq_off.head);
+    m_cqTail = reinterpret_cast<unsigned*>(cqRing + params.cq_off.tail);
+    m_cqMask = *reinterpret_cast<unsigned*>(cqRing + params.cq_off.ring_mask);
+    m_cqes = reinterpret_cast<io_uring_cqe*>(cqRing + params.cq_off.cqes);
+
+    return true;
+}
+
+void PollerImplUring::destroyRing()
+{
+    if (m_sqes)
+    {
+        ::munmap(m_sqes, m_sqesSize);
+        m_sqes = nullptr;
+    }
+    if (m_cqRing && m_cqRing != m_sqRing)
+    {
+        ::munmap(m_cqRing, m_cqRingSize);
+    }
+    m_cqRing = nullptr;
+    if (m_sqRing)
+    {
+        ::munmap(m_sqRing, m_sqRingSize);
+        m_sqRing = nullptr;
+    }
+    if (m_fdRing != -1)
+    {
+        ::close(m_fdRing);
+        m_fdRing = -1;
+    }
+}
+
+void PollerImplUring::cancelAllPolls()
+{
+    if (m_fdRing == -1)
+    {
+        return;
+    }
+    // the ring releases its socket references asynchronously after it was closed.
+    // Cancel the polls and wait for their completions, so that the close of the sockets
+    // releases them (e.g. a listening port can be bound again).
+    std::unique_lock<std::mutex> locker(m_mutex);
+    for (auto& entry : m_socketDescriptors)
+    {
+        cancelAll(entry.second);
+    }
+    m_socketDescriptors.clear();
+    m_operationDataReleased.clear();
+    unsigned toSubmit = *m_sqTail - __atomic_load_n(m_sqHead, __ATOMIC_ACQUIRE);
+    const std::chrono::steady_clock::time_point deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(CANCEL_TIMEOUT);
+    while (!m_operationsCancelled.empty())
+    {
+        const std::int32_t timeoutRemaining = static_cast<std::int32_t>(std::chrono::duration_cast<std::chrono::milliseconds>(deadline - std::chrono::steady_clock::now()).count());
+        if (timeoutRemaining <= 0)
+        {
+            streamError << "io_uring operations were not cancelled: " << m_operationsCancelled.size();
+            break;
+        }
+        locker.unlock();
+        enter(toSubmit, 1, IORING_ENTER_GETEVENTS, timeoutRemaining);
+        toSubmit = 0;
+        locker.lock();
+        // the completions of the cancelled operations release their sockets, all other completions are dropped
+        unsigned head = *m_cqHead;
+        unsigned tail = __atomic_load_n(m_cqTail, __ATOMIC_ACQUIRE);
+        for (; head != tail; ++head)
+        {
+            const io_uring_cqe& cqe = m_cqes[head & m_cqMask];
+            auto itCancelled = m_operationsCancelled.find(cqe.user_data);
+            if (itCancelled != m_operationsCancelled.end())
+            {
+                if (itCancelled->second.accept && cqe.res >= 0)
+                {
+                    // the connection was accepted before the cancellation
+                    ::close(cqe.res);
+                }
+                m_operationsCancelled.erase(itCancelled);
+            }
+        }
+        __atomic_store_n(m_cqHead, head, __ATOMIC_RELEASE);
+    }
+    m_operationsCancelled.clear();
+    locker.unlock();
+}
+
+void PollerImplUring::init()
+{
+    bool ok = setupRing(RING_ENTRIES);
+    assert(ok);
+    if (!ok)
+    {
+        streamFatal << "io_uring could not be initialized";
+        return;
+    }
+    int res = OperatingSystem::instance().makeSocketPair(m_controlSocketRead, m_controlSocketWrite);
+    if (res == 0)
+    {
+        assert(m_controlSocketWrite);
+        assert(m_controlSocketRead);
+        addSocketEnableRead(m_controlSocketRead);
+    }
+}
+
+io_uring_sqe* PollerImplUring::getSqe()
+{
+    // mutex already locked
+    unsigned tail = *m_sqTail;
+    unsigned head = __atomic_load_n(m_sqHead, __ATOMIC_ACQUIRE);
+    if (tail - head >= m_sqEntries)
+    {
+        // submission queue is full, submit the pending entries
+        enter(tail - head, 0, 0, 0);
+        head = __atomic_load_n(m_sqHead, __ATOMIC_ACQUIRE);
+        if (tail - head >= m_sqEntries)
+        {
+            streamFatal << "io_uring submission queue overflow";
+            return nullptr;
+        }
+    }
+    io_uring_sqe* sqe = &m_sqes[tail & m_sqMask];
+    memset(sqe, 0, sizeof(io_uring_sqe));
+    return sqe;
+}
+
+void PollerImplUring::arm(SocketEntry& entry)
+{
+    // mutex already locked
+    io_uring_sqe* sqe = getSqe();
+    if (sqe)
+    {
+        std::uint32_t events = getPollEvents(entry.events, entry.receiveCompletions || entry.acceptCompletions);
+#if __BYTE_ORDER == __BIG_ENDIAN
+        events = (events << 16) | (events >> 16);
+#endif
+        sqe->opcode = IORING_OP_POLL_ADD;
+        sqe->fd = entry.fd->getDescriptor();
+        sqe->poll32_events = events;
+        sqe->user_data = entry.userData;
+        __atomic_store_n(m_sqTail, *m_sqTail + 1, __ATOMIC_RELEASE);
+        entry.armed = true;
+    }
+}
+
+void PollerImplUring::cancelPoll(SocketEntry& entry)
+{
+    // mutex already locked
+    if (entry.armed)
+    {
+        io_uring_sqe* sqe = getSqe();
+        if (sqe)
+        {
+            prepPollRemove(sqe, entry.userData);
+            __atomic_store_n(m_sqTail, *m_sqTail + 1, __ATOMIC_RELEASE);
+        }
+        // the pending poll holds a reference to the socket. If the socket would be closed now,
+        // the kernel would release it later. Therefore, keep it open till the completion of the poll.
+        m_operationsCancelled[entry.userData] = OperationCancelled{entry.fd, nullptr, false};
+        entry.armed = false;
+    }
+}
+
+void PollerImplUring::updatePoll(SocketEntry& entry, std::uint32_t pollEventsBefore)
+{
+    // mutex already locked
+    const std::uint32_t pollEvents = getPollEvents(entry.events, entry.receiveCompletions || entry.acceptCompletions);
+    if (pollEvents != pollEventsBefore)
+    {
+        if (entry.rearm)
+        {
+            // the poll will be armed with the new events at the next wait
+        }
+        else
+        {
+            cancelPoll(entry);
+            entry.userData = makeUserData(m_nextGeneration++, entry.fd->getDescriptor());
+            if (pollEvents != 0)
+            {
+                arm(entry);
+            }
+        }
+    }
+}
+
+void PollerImplUring::armOperations(SocketEntry& entry)
+{
+    // mutex already locked
+    // an operation that completed at the last wait is armed again at the next wait,
+    // so that its buffer stays valid till the completion was handled.
+    if (entry.events & POLLIN)
+    {
+        if (entry.receiveCompletions && !entry.receive.armed && !entry.receive.rearm)
+        {
+            armReceive(entry);
+        }
+        if (entry.acceptCompletions && !entry.accept.armed && !entry.accept.rearm)
+        {
+            armAccept(entry);
+        }
+    }
+}
+
+void PollerImplUring::armReceive(SocketEntry& entry)
+{
+    // mutex already locked
+    Operation& operation = entry.receive;
+    if (!operation.data)
+    {
+        operation.data = std::make_unique<OperationData>();
+        operation.data->buffer.resize(RECEIVE_BUFFER_SIZE_MIN);
+    }
+    std::vector<char>& buffer = operation.data->buffer;
+    if (operation.data->full && buffer.size() < RECEIVE_BUFFER_SIZE_MAX)
+    {
+        // the connection transfers a lot of data, receive more bytes with one operation
+        buffer.resize(std::min(buffer.size() * 2, RECEIVE_BUFFER_SIZE_MAX));
+    }
+    operation.data->full = false;
+    io_uring_sqe* sqe = getSqe();
+    if (sqe)
+    {
+        sqe->opcode = IORING_OP_RECV;
+        sqe->fd = entry.fd->getDescriptor();
+        sqe->addr = reinterpret_cast<std::uint64_t>(buffer.data());
+        sqe->len = static_cast<std::uint32_t>(buffer.size());
+        operation.userData = makeUserData(m_nextGeneration++, entry.fd->getDescriptor());
+        sqe->user_data = operation.userData;
+        __atomic_store_n(m_sqTail, *m_sqTail + 1, __ATOMIC_RELEASE);
+        operation.armed = true;
+    }
+}
+
+void PollerImplUring::armAccept(SocketEntry& entry)
+{
+    // mutex already locked
+    Operation& operation = entry.accept;
+    if (!operation.data)
+    {
+        operation.data = std::make_unique<OperationData>();
+        operation.data->buffer.resize(sizeof(sockaddr_storage));
+    }
+    OperationData& data = *operation.data;
+    data.addressSize = static_cast<socklen_t>(data.buffer.size());
+    io_uring_sqe* sqe = getSqe();
+    if (sqe)
+    {
+        sqe->opcode = IORING_OP_ACCEPT;
+        sqe->fd = entry.fd->getDescriptor();
+        sqe->addr = reinterpret_cast<std::uint64_t>(data.buffer.data());
+        sqe->addr2 = reinterpret_cast<std::uint64_t>(&data.addressSize);
+        operation.userData = makeUserData(m_nextGeneration++, entry.fd->getDescriptor());
+        sqe->user_data = operation.userData;
+        __atomic_store_n(m_sqTail, *m_sqTail + 1, __ATOMIC_RELEASE);
+        operation.armed = true;
+    }
+}
+
+void PollerImplUring::cancelOperation(SocketEntry& entry, Operation& operation, bool accept)
+{
+    // mutex already locked
+    if (operation.armed)
+    {
+        io_uring_sqe* sqe = getSqe();
+        if (sqe)
+        {
+            prepCancel(sqe, operation.userData);
+            __atomic_store_n(m_sqTail, *m_sqTail + 1, __ATOMIC_RELEASE);
+        }
+        // the kernel accesses the socket and the memory of the operation till its completion
+        m_operationsCancelled[operation.userData] = OperationCancelled{entry.fd, std::move(operation.data), accept};
+        operation.armed = false;
+    }
+    else if (operation.data)
+    {
+        // the buffer of a completion is valid till the next wait
+        m_operationDataReleased.push_back(std::move(operation.data));
+    }
+}
+
+void PollerImplUring::cancelAll(SocketEntry& entry)
+{
+    // mutex already locked
+    cancelPoll(entry);
+    cancelOperation(entry, entry.receive, false);
+    cancelOperation(entry, entry.accept, true);
+    cancelOperation(entry, entry.send, false);
+}
+
+int PollerImplUring::enter(unsigned int toSubmit, unsigned int minComplete, unsigned int flags, std::int32_t timeout)
+{
+    int res = 0;
+    if (flags & IORING_ENTER_GETEVENTS)
+    {
+        __kernel_timespec ts;
+        io_uring_getevents_arg arg;
+        memset(&arg, 0, sizeof(arg));
+        arg.sigmask = 0;
+        arg.sigmask_sz = _NSIG / 8;
+        if (timeout >= 0)
+        {
+            ts.tv_sec = timeout / 1000;
+            ts.tv_nsec = static_cast<long long>(timeout % 1000) * 1000000;
+            arg.ts = reinterpret_cast<std::uint64_t>(&ts);
+        }
+        res = sys_io_uring_enter(m_fdRing, toSubmit, minComplete, flags | IORING_ENTER_EXT_ARG, &arg, sizeof(arg));
+    }
+    else
+    {
+        res = sys_io_uring_enter(m_fdRing, toSubmit, minComplete, flags, nullptr, 0);
+    }
+    return res;
+}
+
+void PollerImplUring::submitIfNotPollerThread()
+{
+    // mutex already locked
+    // inside the poller thread, the submission happens together with the next wait
+    if (std::this_thread::get_id() != m_threadIdWait)
+    {
+        unsigned toSubmit = *m_sqTail - __atomic_load_n(m_sqHead, __ATOMIC_ACQUIRE);
+        if (toSubmit > 0)
+        {
+            int res = enter(toSubmit, 0, 0, 0);
+            if (res < 0)
+            {
+                streamError << "io_uring_enter failed with errno: " << errno;
+            }
+        }
+    }
+}
+
+void PollerImplUring::addSocketIntern(const SocketDescriptorPtr& fd, std::uint32_t events)
+{
+    std::unique_lock<std::mutex> locker(m_mutex);
+    SOCKET sd = fd->getDescriptor();
+    auto result = m_socketDescriptors.emplace(sd, SocketEntry{});
+    if (result.second)
+    {
+        SocketEntry& entry = result.first->second;
+        entry.fd = fd;
+        entry.events = events;
+        entry.userData = makeUserData(m_nextGeneration++, sd);
+        if (events != 0)
+        {
+            arm(entry);
+            submitIfNotPollerThread();
+        }
+    }
+    else
+    {
+        // socket already added
+    }
+    locker.unlock();
+}
+
+void PollerImplUring::addSocket(const SocketDescriptorPtr& fd)
+{
+    addSocketIntern(fd, 0);
+}
+
+void PollerImplUring::addSocketEnableRead(const SocketDescriptorPtr& fd)
+{
+    addSocketIntern(fd, POLLIN);
+}
+
+void PollerImplUring::removeSocket(const SocketDescriptorPtr& fd)
+{
+    if (fd)
+    {
+        std::unique_lock<std::mutex> locker(m_mutex);
+        auto it = m_socketDescriptors.find(fd->getDescriptor());
+        if (it != m_socketDescriptors.end() && it->second.fd == fd)
+        {
+            const unsigned tailBefore = *m_sqTail;
+            cancelAll(it->second);
+            if (*m_sqTail != tailBefore)
+            {
+                // the socket is closed at the completion of the cancelled operations, so submit the removal immediately.
+                unsigned toSubmit = *m_sqTail - __atomic_load_n(m_sqHead, __ATOMIC_ACQUIRE);
+                enter(toSubmit, 0, 0, 0);
+            }
+            m_socketDescriptors.erase(it);
+        }
+        else
+        {
+            // socket not added
+        }
+        locker.unlock();
+    }
+}
+
+void PollerImplUring::updateEvents(const SocketDescriptorPtr& fd, std::uint32_t eventsSet, std::uint32_t eventsClear)
+{
+    std::unique_lock<std::mutex> locker(m_mutex);
+    auto it = m_socketDescriptors.find(fd->getDescriptor());
+    if (it != m_socketDescriptors.end() && it->second.fd == fd)
+    {
+        SocketEntry& entry = it->second;
+        const std::uint32_t pollEventsBefore = getPollEvents(entry.events, entry.receiveCompletions || entry.acceptCompletions);
+        entry.events = (entry.events | eventsSet) & ~eventsClear;
+        updatePoll(entry, pollEventsBefore);
+        armOperations(entry);
+        submitIfNotPollerThread();
+    }
+    else
+    {
+        // error: socket not added
+    }
+    locker.unlock();
+}
+
+void PollerImplUring::enableRead(const SocketDescriptorPtr& fd)
+{
+    updateEvents(fd, POLLIN, 0);
+}
+
+void PollerImplUring::disableRead(const SocketDescriptorPtr& fd)
+{
+    updateEvents(fd, 0, POLLIN);
+}
+
+void PollerImplUring::enableWrite(const SocketDescriptorPtr& fd)
+{
+    updateEvents(fd, POLLOUT, 0);
+}
+
+void PollerImplUring::disableWrite(const SocketDescriptorPtr& fd)
+{
+    updateEvents(fd, 0, POLLOUT);
+}
+
+void PollerImplUring::enableReceive(const SocketDescriptorPtr& fd)
+{
+    std::unique_lock<std::mutex> locker(m_mutex);
+    auto it = m_socketDescriptors.find(fd->getDescriptor());
+    if (it != m_socketDescriptors.end() && it->second.fd == fd)
+    {
+        SocketEntry& entry = it->second;
+        const std::uint32_t pollEventsBefore = getPollEvents(entry.events, entry.receiveCompletions || entry.acceptCompletions);
+        entry.receiveCompletions = true;
+        entry.events |= POLLIN;
+        updatePoll(entry, pollEventsBefore);
+        armOperations(entry);
+        submitIfNotPollerThread();
+    }
+    locker.unlock();
+}
+
+void PollerImplUring::enableAccept(const SocketDescriptorPtr& fd)
+{
+    std::unique_lock<std::mutex> locker(m_mutex);
+    auto it = m_socketDescriptors.find(fd->getDescriptor());
+    if (it != m_socketDescriptors.end() && it->second.fd == fd)
+    {
+        SocketEntry& entry = it->second;
+        const std::uint32_t pollEventsBefore = getPollEvents(entry.events, entry.receiveCompletions || entry.acceptCompletions);
+        entry.acceptCompletions = true;
+        entry.events |= POLLIN;
+        updatePoll(entry, pollEventsBefore);
+        armOperations(entry);
+        submitIfNotPollerThread();
+    }
+    locker.unlock();
+}
+
+bool PollerImplUring::submitSend(const SocketDescriptorPtr& fd, std::vector<struct iovec>&& buffers, std::shared_ptr<const void>&& keepalive)
+{
+    bool submitted = false;
+    std::unique_lock<std::mutex> locker(m_mutex);
+    auto it = m_socketDescriptors.find(fd->getDescriptor());
+    if (it != m_socketDescriptors.end() && it->second.fd == fd && !it->second.send.armed)
+    {
+        Operation& operation = it->second.send;
+        if (!operation.data)
+        {
+            operation.data = std::make_unique<OperationData>();
+        }
+        io_uring_sqe* sqe = getSqe();
+        if (sqe)
+        {
+            OperationData& data = *operation.data;
+            data.buffers = std::move(buffers);
+            data.keepalive = std::move(keepalive);
+            memset(&data.msg, 0, sizeof(data.msg));
+            data.msg.msg_iov = data.buffers.data();
+            data.msg.msg_iovlen = data.buffers.size();
+            sqe->opcode = IORING_OP_SENDMSG;
+            sqe->fd = it->first;
+            sqe->addr = reinterpret_cast<std::uint64_t>(&data.msg);
+            sqe->len = 1;
+            sqe->msg_flags = MSG_NOSIGNAL;
+            operation.userData = makeUserData(m_nextGeneration++, it->first);
+            sqe->user_data = operation.userData;
+            __atomic_store_n(m_sqTail, *m_sqTail + 1, __ATOMIC_RELEASE);
+            operation.armed = true;
+            submitted = true;
+            submitIfNotPollerThread();
+        }
+    }
+    locker.unlock();
+    return submitted;
+}
+
+bool PollerImplUring::collectOperationCompletion(SocketEntry& entry, const io_uring_cqe& cqe)
+{
+    // mutex already locked
+    // returns true, if the operation shall be armed again at the next wait
+    const SOCKET sd = entry.fd->getDescriptor();
+    if (entry.receive.armed && entry.receive.userData == cqe.user_data)
+    {
+        Operation& operation = entry.receive;
+        operation.armed = false;
+        if (cqe.res == -EAGAIN || cqe.res == -EINTR)
+        {
+            operation.rearm = true;
+            return true;
+        }
+        CompletionInfo& info = m_result.completions.emplace_back();
+        info.sd = sd;
+        info.type = CompletionType::COMPLETION_RECEIVE;
+        info.result = cqe.res;
+        if (cqe.res > 0)
+        {
+            std::vector<char>& buffer = operation.data->buffer;
+            info.buffer = buffer.data();
+            info.size = cqe.res;
+            operation.data->full = (static_cast<size_t>(cqe.res) == buffer.size());
+            operation.rearm = true;
+            return true;
+        }
+        // the connection was closed, do not receive anymore
+        entry.events &= ~POLLIN;
+        return false;
+    }
+    if (entry.accept.armed && entry.accept.userData == cqe.user_data)
+    {
+        Operation& operation = entry.accept;
+        operation.armed = false;
+        const int err = (cqe.res < 0) ? -cqe.res : 0;
+        if (err == EAGAIN || err == EINTR || err == ECONNABORTED || err == EMFILE || err == ENFILE || err == ENOBUFS || err == ENOMEM)
+        {
+            // the listening socket is still valid, try again at the next wait
+            if (err != EAGAIN && err != EINTR && err != ECONNABORTED)
+            {
+                streamError << "io_uring accept failed with errno: " << err;
+            }
+            operation.rearm = true;
+            return true;
+        }
+        CompletionInfo& info = m_result.completions.emplace_back();
+        info.sd = sd;
+        info.type = CompletionType::COMPLETION_ACCEPT;
+        info.result = cqe.res;
+        if (cqe.res >= 0)
+        {
+            info.buffer = operation.data->buffer.data();
+            info.size = static_cast<int>(operation.data->addressSize);
+            operation.rearm = true;
+            return true;
+        }
+        entry.events &= ~POLLIN;
+        return false;
+    }
+    if (entry.send.armed && entry.send.userData == cqe.user_data)
+    {
+        Operation& operation = entry.send;
+        operation.armed = false;
+        operation.data->buffers.clear();
+        operation.data->keepalive = nullptr;
+        CompletionInfo& info = m_result.completions.emplace_back();
+        info.sd = sd;
+        info.type = CompletionType::COMPLETION_SEND;
+        info.result = cqe.res;
+    }
+    return false;
+}
+
+void PollerImplUring::collectCompletions()
+{
+    // the sockets of cancelled polls are closed after the mutex was released
+    std::vector<SocketDescriptorPtr> socketsReleased;
+    std::unique_lock<std::mutex> locker(m_mutex);
+    unsigned head = *m_cqHead;
+    unsigned tail = __atomic_load_n(m_cqTail, __ATOMIC_ACQUIRE);
+    for (; head != tail; ++head)
+    {
+        const io_uring_cqe& cqe = m_cqes[head & m_cqMask];
+        if (cqe.user_data == USERDATA_CANCEL)
+        {
+            continue;
+        }
+        auto itCancelled = m_operationsCancelled.find(cqe.user_data);
+        if (itCancelled != m_operationsCancelled.end())
+        {
+            if (itCancelled->second.accept && cqe.res >= 0)
+            {
+                // the connection was accepted before the cancellation
+                ::close(cqe.res);
+            }
+            // the kernel released its reference to the socket
+            socketsReleased.push_back(std::move(itCancelled->second.fd));
+            m_operationsCancelled.erase(itCancelled);
+            continue;
+        }
+        SOCKET sd = userDataToSocket(cqe.user_data);
+        auto it = m_socketDescriptors.find(sd);
+        if (it == m_socketDescriptors.end())
+        {
+            // completion of a removed poll
+            continue;
+        }
+        if (it->second.userData != cqe.user_data || !it->second.armed)
+        {
+            // completion of a receive, send or accept, or of a modified poll
+            if (collectOperationCompletion(it->second, cqe))
+            {
+                m_rearm.push_back(sd);
+            }
+            continue;
+        }
+        SocketEntry& entry = it->second;
+        entry.armed = false;
+        entry.rearm = true;
+        m_rearm.push_back(sd);
+
+        if (cqe.res < 0)
+        {
+            if (cqe.res != -ECANCELED)
+            {
+                streamError << "io_uring poll failed with errno: " << -cqe.res;
+            }
+            continue;
+        }
+
+        const std::uint32_t events = static_cast<std::uint32_t>(cqe.res);
+        if (sd == m_controlSocketRead->getDescriptor())
+        {
+            if (events & POLLIN)
+            {
+                // read pending bytes from control socket
+                char buffer[CONTROL_BUFFER_SIZE];
+                int countRead = OperatingSystem::instance().recv(sd, buffer, sizeof(buffer), 0);
+                if (countRead > 0)
+                {
+                    m_result.releaseWait = m_releaseFlags.exchange(0, std::memory_order_acq_rel);
+                }
+            }
+            continue;
+        }
+
+        DescriptorInfo& descriptorInfo = m_result.descriptorInfos.add();
+        descriptorInfo.sd = sd;
+        if (events & (POLLERR | POLLHUP))
+        {
+            descriptorInfo.disconnected = true;
+        }
+        if (events & POLLOUT)
+        {
+            descriptorInfo.writable = true;
+        }
+        if (events & POLLIN)
+        {
+            descriptorInfo.readable = true;
+        }
+    }
+    __atomic_store_n(m_cqHead, head, __ATOMIC_RELEASE);
+    locker.unlock();
+}
+
+unsigned int PollerImplUring::rearmPolls()
+{
+    std::unique_lock<std::mutex> locker(m_mutex);
+    m_threadIdWait = std::this_thread::get_id();
+    // the buffers of the last completions were handled
+    m_operationDataReleased.clear();
+    // re-arm the one-shot polls and operations that completed at the last wait
+    for (SOCKET sd : m_rearm)
+    {
+        auto it = m_socketDescriptors.find(sd);
+        if (it != m_socketDescriptors.end())
+        {
+            SocketEntry& entry = it->second;
+            if (entry.rearm)
+            {
+                entry.rearm = false;
+                if (getPollEvents(entry.events, entry.receiveCompletions || entry.acceptCompletions) != 0 && !entry.armed)
+                {
+                    arm(entry);
+                }
+            }
+            entry.receive.rearm = false;
+            entry.accept.rearm = false;
+            armOperations(entry);
+        }
+    }
+    m_rearm.clear();
+    unsigned int toSubmit = *m_sqTail - __atomic_load_n(m_sqHead, __ATOMIC_ACQUIRE);
+    locker.unlock();
+    return toSubmit;
+}
+
+const PollerResult& PollerImplUring::wait(std::int32_t timeout)
+{
+    // check if init happened
+    assert(m_fdRing != -1);
+
+    m_result.clear();
+
+    // submit all collected changes and wait for completions with one system call
+    unsigned toSubmit = rearmPolls();
+    const std::chrono::steady_clock::time_point deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(std::max(timeout, 0));
+    unsigned minComplete = (timeout == 0) ? 0 : 1;
+    std::int32_t timeoutRemaining = timeout;
+    while (true)
+    {
+        int res = enter(toSubmit, minComplete, IORING_ENTER_GETEVENTS, timeoutRemaining);
+        int err = (res == -1) ? errno : 0;
+        if (res == -1 && err != ETIME && err != EINTR && err != EAGAIN && err != EBUSY)
+        {
+            streamError << "io_uring_enter failed with errno: " << err;
+            m_result.error = true;
+            return m_result;
+        }
+
+        collectCompletions();
+
+        // completions of removed or modified polls do not count, wait again until the timeout expires
+        if (m_result.descriptorInfos.size() != 0 || !m_result.completions.empty() || m_result.releaseWait != 0 || timeout == 0 || err == ETIME)
+        {
+            break;
+        }
+        toSubmit = rearmPolls();
+        if (timeout > 0)
+        {
+            timeoutRemaining = static_cast<std::int32_t>(std::chrono::duration_cast<std::chrono::milliseconds>(deadline - std::chrono::steady_clock::now()).count());
+            if (timeoutRemaining <= 0)
+            {
+                break;
+            }
+        }
+    }
+
+    if (m_result.descriptorInfos.size() == 0 && m_result.completions.empty() && m_result.releaseWait == 0)
+    {
+        m_result.timeout = true;
+    }
+
+    return m_result;
+}
+
+void PollerImplUring::releaseWait(std::uint32_t info)
+{
+    m_releaseFlags.fetch_or(info, std::memory_order_acq_rel);
+    if (m_controlSocketWrite)
+    {
+        char dummy = 0;
+        OperatingSystem::instance().send(m_controlSocketWrite->getDescriptor(), &dummy, 1, 0);
+    }
+}
+
+} // namespace finalmq
+
+#endif
@@ -25,6 +25,7 @@
 #include <cassert>
 
 #include "finalmq/protocolsession/ProtocolMessage.h"
+#include "finalmq/protocolsession/ProtocolMessagePool.h"
 #include "finalmq/protocolsession/ProtocolRegistry.h"
 #include "finalmq/streamconnection/Socket.h"
 
@@ -134,7 +135,7 @@ bool ProtocolHeaderBinarySize::isSynchronousRequestReply() const
 IProtocol::FuncCreateMessage ProtocolHeaderBinarySize::getMessageFactory() const
 {
     return []() {
-        return std::make_shared<ProtocolMessage>(PROTOCOL_ID, HEADERSIZE);
+        return ProtocolMessagePool::createMessage(PROTOCOL_ID, HEADERSIZE);
     };
 }
 
@@ -165,10 +166,10 @@ void ProtocolHeaderBinarySize::moveOldProtocolState(IProtocol& /*protocolOld*/)
 {
 }
 
-bool ProtocolHeaderBinarySize::received(const IStreamConnectionPtr& /*connection*/, const SocketPtr& socket, int bytesToRead)
+bool ProtocolHeaderBinarySize::received(const IStreamConnectionPtr& /*connection*/, const char* buffer, int size)
 {
     std::deque<IMessagePtr> messages;
-    bool ok = m_headerHelper.receive(socket, bytesToRead, messages);
+    m_headerHelper.receive(buffer, size, messages);
     auto callback = m_callback.lock();
     if (callback)
     {
@@ -177,7 +178,7 @@ bool ProtocolHeaderBinarySize::received(const IStreamConnectionPtr& /*connection
             callback->received(message);
         }
     }
-    return ok;
+    return true;
 }
 
 hybrid_ptr<IStreamConnectionCallback> ProtocolHeaderBinarySize::connected(const IStreamConnectionPtr& /*connection*/)
@@ -199,6 +200,15 @@ void ProtocolHeaderBinarySize::disconnected(const IStreamConnectionPtr& /*connec
     }
 }
 
+void ProtocolHeaderBinarySize::writable(const IStreamConnectionPtr& /*connection*/)
+{
+    auto callback = m_callback.lock();
+    if (callback)
+    {
+        callback->writable();
+    }
+}
+
 IMessagePtr ProtocolHeaderBinarySize::pollReply(std::deque<IMessagePtr>&& /*messages*/)
 {
     return {};
@@ -24,8 +24,10 @@
 
 #include "finalmq/helpers/Utils.h"
 #include "finalmq/protocolsession/ProtocolMessage.h"
+#include "finalmq/protocolsession/ProtocolMessagePool.h"
 #include "finalmq/protocolsession/ProtocolRegistry.h"
 #include "finalmq/protocolsession/ProtocolSession.h"
+#include "finalmq/protocols/protocolhelpers/HttpHeaderParser.h"
 #include "finalmq/streamconnection/Socket.h"
 
 //#include "finalmq/helpers/ModulenameFinalmq.h"
@@ -34,7 +36,6 @@
 #include <cassert>
 #include <cstdlib>
 
-#include <fcntl.h>
 #include <time.h>
 
 namespace finalmq
@@ -84,29 +85,6 @@ static void encode(std::string& dest, const std::string& src)
     }
 }
 
-static void decode(std::string& dest, const std::string& src)
-{
-    dest.reserve(src.size());
-    char code[3] = {0};
-    unsigned long c = 0;
-
-    for (size_t i = 0; i < src.size(); ++i)
-    {
-        if (src[i] == '%')
-        {
-            ++i;
-            memcpy(code, &src[i], 2);
-            c = strtoul(code, NULL, 16);
-            dest += static_cast<char>(c);
-            ++i;
-        }
-        else
-        {
-            dest += src[i];
-        }
-    }
-}
-
 //---------------------------------------
 // Cookie
 //---------------------------------------
@@ -212,7 +190,7 @@ public:
                         }
                         else if (field.first == "path")
                         {
-                            decode(cookie.m_path, field.second);
+                            HttpHeaderParser::decode(cookie.m_path, field.second);
                         }
                         else if (field.first == "secure")
                         {
@@ -1248,49 +1226,31 @@ bool ProtocolHttpClient::isSynchronousRequestReply() const
 IProtocol::FuncCreateMessage ProtocolHttpClient::getMessageFactory() const
 {
     return []() {
-        return std::make_shared<ProtocolMessage>(PROTOCOL_ID);
+        return ProtocolMessagePool::createMessage(PROTOCOL_ID);
     };
 }
 
-static void splitOnce(const std::string& src, ssize_t indexBegin, ssize_t indexEnd, char delimiter, std::vector<std::string>& dest)
-{
-    size_t pos = src.find_first_of(delimiter, indexBegin);
-    if (pos == std::string::npos || static_cast<ssize_t>(pos) > indexEnd)
-    {
-        pos = indexEnd;
-    }
-    ssize_t len = pos - indexBegin;
-    assert(len >= 0);
-    dest.emplace_back(&src[indexBegin], len);
-    ++pos;
-
-    if (static_cast<ssize_t>(pos) < indexEnd)
-    {
-        len = indexEnd - pos;
-        assert(len >= 0);
-        dest.emplace_back(&src[pos], len);
-    }
-}
-
 bool ProtocolHttpClient::receiveHeaders(ssize_t bytesReceived)
 {
     bool ok = true;
     bytesReceived += m_sizeRemaining;
     assert(bytesReceived <= static_cast<ssize_t>(m_receiveBuffer.size()));
+    const char* buffer = m_receiveBuffer.data();
     while (m_offsetRemaining < bytesReceived && ok)
     {
-        size_t index = m_receiveBuffer.find_first_of('\n', m_offsetRemaining);
-        if (index != std::string::npos)
+        ssize_t index = HttpHeaderParser::findEndOfLine(buffer, m_offsetRemaining, bytesReceived);
+        if (index >= 0)
         {
             ssize_t indexEndLine = index;
             --indexEndLine; // goto '\r'
             ssize_t len = indexEndLine - m_offsetRemaining;
-            if (len < 0 || m_receiveBuffer[indexEndLine] != '\r')
+            if (len < 0 || buffer[indexEndLine] != '\r')
             {
                 ok = false;
             }
             if (ok)
             {
+                const std::string_view line(buffer + m_offsetRemaining, len);
                 if (m_state == State::STATE_FIND_FIRST_LINE)
                 {
                     m_contentLength = 0;
@@ -1300,34 +1260,19 @@ bool ProtocolHttpClient::receiveHeaders(ssize_t bytesReceived)
                     }
                     else
                     {
+                        std::string_view protocol;
+                        std::string_view status;
+                        std::string_view statusText;
                         // is response
-                        if (m_receiveBuffer[m_offsetRemaining] == 'H' && m_receiveBuffer[m_offsetRemaining + 1] == 'T')
+                        if (line[0] == 'H' && line[1] == 'T' && HttpHeaderParser::splitStartLine(line, protocol, status, statusText))
                         {
-                            std::vector<std::string> lineSplit;
-                            Utils::split(m_receiveBuffer, m_offsetRemaining, indexEndLine, ' ', lineSplit);
-                            if (lineSplit.size() >= 2)
-                            {
-                                m_message = std::make_shared<ProtocolMessage>(0);
-                                Variant& controlData = m_message->getControlData();
-                                controlData.add(FMQ_HTTP, std::string(HTTP_RESPONSE));
-                                controlData.add(FMQ_PROTOCOL, std::move(lineSplit[0]));
-                                controlData.add(FMQ_HTTP_STATUS, std::move(lineSplit[1]));
-                                std::string statusText;
-                                for (size_t i = 2; i < lineSplit.size(); ++i)
-                                {
-                                    statusText += lineSplit[i];
-                                    if (i < lineSplit.size() - 1)
-                                    {
-                                        statusText += ' ';
-                                    }
-                                }
-                                controlData.add(FMQ_HTTP_STATUSTEXT, std::move(statusText));
-                                m_state = State::STATE_FIND_HEADERS;
-                            }
-                            else
-                            {
-                                ok = false;
-                            }
+                            m_message = ProtocolMessagePool::createMessage(0);
+                            Variant& controlData = m_message->getControlData();
+                            controlData.add(FMQ_HTTP, std::string(HTTP_RESPONSE));
+                            controlData.add(FMQ_PROTOCOL, std::string(protocol));
+                            controlData.add(FMQ_HTTP_STATUS, std::string(status));
+                            controlData.add(FMQ_HTTP_STATUSTEXT, std::string(statusText));
+                            m_state = State::STATE_FIND_HEADERS;
                         }
                         else
                         {
@@ -1354,35 +1299,22 @@ bool ProtocolHttpClient::receiveHeaders(ssize_t bytesReceived)
                     }
                     else
                     {
-                        std::vector<std::string> lineSplit;
-                        splitOnce(m_receiveBuffer, m_offsetRemaining, indexEndLine, ':', lineSplit);
-                        if (lineSplit.size() == 2)
-                        {
-                            std::string& value = lineSplit[1];
-                            if (!value.empty() && value[0] == ' ')
-                            {
-                                value.erase(value.begin());
-                            }
-                            if (lineSplit[0] == CONTENT_LENGTH)
-                            {
-                                m_contentLength = std::atoll(value.c_str());
-                            }
-                            else if (lineSplit[0] == HTTP_SET_COOKIE)
-                            {
-                                const std::vector<Cookie> cookies = Cookie::parseSetCookieHeaderLine(value, m_hostname);
-                                m_cookieStore->add(cookies);
-                            }
-                            m_message->addMetainfo(std::move(lineSplit[0]), std::move(value));
-                        }
-                        else if (lineSplit.size() == 1)
+                        std::string_view name;
+                        std::string_view value;
+                        HttpHeaderParser::splitHeaderLine(line, name, value);
+                        if (name == CONTENT_LENGTH)
                         {
-                            m_message->addMetainfo(std::move(lineSplit[0]), "");
+                            m_contentLength = HttpHeaderParser::parseContentLength(value);
                         }
-                        else
+                        else if (name == HTTP_SET_COOKIE)
                         {
-                            assert(false);
-                            ok = false;
+                            const std::vector<Cookie> cookies = Cookie::parseSetCookieHeaderLine(std::string(value), m_hostname);
+                            std::unique_lock<std::mutex> lock(m_mutex);
+                            CookieStorePtr cookieStore = m_cookieStore;
+                            lock.unlock();
+                            cookieStore->add(cookies);
                         }
+                        m_message->addMetainfo(std::string(name), std::string(value));
                     }
                 }
                 m_offsetRemaining += len + 2;
@@ -1400,8 +1332,7 @@ bool ProtocolHttpClient::receiveHeaders(ssize_t bytesReceived)
 
 void ProtocolHttpClient::reset()
 {
-    m_offsetRemaining = 0;
-    m_sizeRemaining = 0;
+    // m_offsetRemaining and m_sizeRemaining are kept, the remaining bytes belong to the next response
     m_contentLength = 0;
     m_indexFilled = 0;
     m_message = nullptr;
@@ -1426,14 +1357,13 @@ void ProtocolHttpClient::sendMessage(IMessagePtr message)
     const Variant& controlData = message->getControlData();
     const std::string* filename = controlData.getData<std::string>("filetransfer");
     ssize_t filesize = -1;
+    FileRegionPtr file;
     if (filename)
     {
-        struct stat statdata;
-        memset(&statdata, 0, sizeof(statdata));
-        int res = OperatingSystem::instance().stat(filename->c_str(), &statdata);
-        if (res == 0)
+        file = FileRegion::open(*filename);
+        if (file)
         {
-            filesize = statdata.st_size;
+            filesize = file->getSize();
             message->downsizeLastSendPayload(0);
         }
     }
@@ -1585,75 +1515,14 @@ void ProtocolHttpClient::sendMessage(IMessagePtr message)
     assert(index + 2 == sumHeaderSize);
     memcpy(headerBuffer + index, "\r\n", 2);
 
+    if (file)
+    {
+        message->setSendFile(file);
+    }
+
     message->prepareMessageToSend();
 
     connection->sendMessage(message);
-
-    if (filename && filesize > 0)
-    {
-        std::string file = *filename;
-        std::weak_ptr<ProtocolHttpClient> pThisWeak = shared_from_this();
-        GlobalExecutorWorker::instance().addAction([pThisWeak, file, filesize]() {
-            std::shared_ptr<ProtocolHttpClient> pThis = pThisWeak.lock();
-            if (!pThis)
-            {
-                return;
-            }
-            int flags = O_RDONLY;
-#ifdef WIN32
-            flags |= O_BINARY;
-#endif
-            int fd = OperatingSystem::instance().open(file.c_str(), flags);
-            if (fd != -1)
-            {
-                int len = static_cast<int>(filesize);
-                int err = 0;
-                int lenReceived = 0;
-                bool ex = false;
-                while (!ex)
-                {
-                    int size = std::min(1024, len);
-                    IMessagePtr messageData = std::make_shared<ProtocolMessage>(0);
-                    char* buf = messageData->addSendPayload(size);
-                    do
-                    {
-                        err = OperatingSystem::instance().read(fd, buf, size);
-                    } while (err == -1 && OperatingSystem::instance().getLastError() == SOCKETERROR(EINTR));
-
-                    if (err > 0)
-                    {
-                        assert(err <= size);
-                        if (err < size)
-                        {
-                            messageData->downsizeLastSendPayload(err);
-                        }
-                        pThis->m_connection->sendMessage(messageData);
-                        buf += err;
-                        len -= err;
-                        lenReceived += err;
-                        err = 0;
-                        assert(len >= 0);
-                        if (len == 0)
-                        {
-                            ex = true;
-                        }
-                    }
-                    else
-                    {
-                        ex = true;
-                    }
-                }
-                if (lenReceived < filesize)
-                {
-                    pThis->m_connection->disconnect();
-                }
-            }
-            else
-            {
-                pThis->m_connection->disconnect();
-            }
-        });
-    }
 }
 
 void ProtocolHttpClient::moveOldProtocolState(IProtocol& /*protocolOld*/)
@@ -1754,113 +1623,87 @@ void ProtocolHttpClient::moveOldProtocolState(IProtocol& /*protocolOld*/)
 //    return handled;
 //}
 
-bool ProtocolHttpClient::received(const IStreamConnectionPtr& /*connection*/, const SocketPtr& socket, int bytesToRead)
+bool ProtocolHttpClient::received(const IStreamConnectionPtr& /*connection*/, const char* buffer, int size)
 {
     bool ok = true;
 
-    if (m_state != State::STATE_CONTENT)
+    if (m_state == State::STATE_CONTENT)
+    {
+        // only the rest of the body goes into the payload, the following bytes belong to the next (pipelined) response
+        BufferRef payload = m_message->getReceivePayload();
+        assert(payload.second == m_contentLength);
+        const ssize_t bytesContent = std::min(static_cast<ssize_t>(size), m_contentLength - m_indexFilled);
+        memcpy(payload.first + m_indexFilled, buffer, bytesContent);
+        m_indexFilled += bytesContent;
+        assert(m_indexFilled <= m_contentLength);
+        if (m_indexFilled == m_contentLength)
+        {
+            m_state = State::STATE_CONTENT_DONE;
+            responseDone();
+        }
+        buffer += bytesContent;
+        size -= static_cast<int>(bytesContent);
+    }
+
+    if (size > 0)
     {
         if (m_offsetRemaining == 0 || m_sizeRemaining == 0)
         {
-            m_receiveBuffer.resize(m_sizeRemaining + bytesToRead);
+            m_receiveBuffer.resize(m_sizeRemaining + size);
         }
         else
         {
             std::string temp = std::move(m_receiveBuffer);
             m_receiveBuffer.clear();
-            m_receiveBuffer.resize(m_sizeRemaining + bytesToRead);
+            m_receiveBuffer.resize(m_sizeRemaining + size);
             memcpy(&m_receiveBuffer[0], &temp[m_offsetRemaining], m_sizeRemaining);
         }
         m_offsetRemaining = 0;
 
-        ssize_t bytesReceived = 0;
-        int res = 0;
-        do
-        {
-            res = socket->receive((m_receiveBuffer.data() + bytesReceived + m_sizeRemaining), static_cast<int>(bytesToRead - bytesReceived));
-            if (res > 0)
-            {
-                bytesReceived += res;
-            }
-        } while (res > 0 && bytesReceived < bytesToRead);
-        if (res >= 0)
+        memcpy(m_receiveBuffer.data() + m_sizeRemaining, buffer, size);
+        ok = receiveHeaders(size);
+        while (ok && (m_state == State::STATE_CONTENT || m_state == State::STATE_CONTENT_DONE))
         {
-            assert(bytesReceived <= bytesToRead);
-            ok = receiveHeaders(bytesReceived);
-            if (ok && m_state == State::STATE_CONTENT)
+            if (m_state == State::STATE_CONTENT)
             {
                 assert(m_message != nullptr);
                 BufferRef payload = m_message->getReceivePayload();
                 assert(payload.second == m_contentLength);
-                if (m_sizeRemaining <= m_contentLength)
-                {
-                    memcpy(payload.first, m_receiveBuffer.data() + m_offsetRemaining, m_sizeRemaining);
-                    m_indexFilled = m_sizeRemaining;
-                    assert(m_indexFilled <= m_contentLength);
-                    if (m_indexFilled == m_contentLength)
-                    {
-                        m_state = State::STATE_CONTENT_DONE;
-                    }
-                }
-                else
+                const ssize_t sizeContent = std::min(m_sizeRemaining, m_contentLength);
+                memcpy(payload.first, m_receiveBuffer.data() + m_offsetRemaining, sizeContent);
+                m_indexFilled = sizeContent;
+                m_offsetRemaining += sizeContent;
+                m_sizeRemaining -= sizeContent;
+                if (m_indexFilled < m_contentLength)
                 {
-                    // too much content
-                    ok = false;
+                    break;
                 }
+                m_state = State::STATE_CONTENT_DONE;
             }
-        }
-    }
-    else
-    {
-        BufferRef payload = m_message->getReceivePayload();
-        assert(payload.second == m_contentLength);
-        ssize_t remainingContent = m_contentLength - m_indexFilled;
-        if (bytesToRead <= remainingContent)
-        {
-            ssize_t bytesReceived = 0;
-            int res = 0;
-            do
-            {
-                res = socket->receive(payload.first + bytesReceived + m_indexFilled, static_cast<int>(bytesToRead - bytesReceived));
-                if (res > 0)
-                {
-                    bytesReceived += res;
-                }
-            } while (res > 0 && bytesReceived < bytesToRead);
-            if (res >= 0)
+            responseDone();
+            if (m_sizeRemaining == 0)
             {
-                m_indexFilled += bytesReceived;
-                assert(m_indexFilled <= m_contentLength);
-                if (m_indexFilled == m_contentLength)
-                {
-                    m_state = State::STATE_CONTENT_DONE;
-                }
+                break;
             }
-        }
-        else
-        {
-            // too much content
-            ok = false;
+            // pipelining: the next response is already in the buffer, receiveHeaders continues at m_offsetRemaining
+            ok = receiveHeaders(m_offsetRemaining);
         }
     }
 
-    if (ok)
+    return ok;
+}
+
+void ProtocolHttpClient::responseDone()
+{
+    assert(m_state == State::STATE_CONTENT_DONE);
+    std::unique_lock<std::mutex> lock(m_mutex);
+    auto callback = m_callback.lock();
+    lock.unlock();
+    if (callback)
     {
-        if (m_state == State::STATE_CONTENT_DONE)
-        {
-            auto callback = m_callback.lock();
-            if (callback)
-            {
-                //bool handled = handleInternalCommands(callback, ok);
-                //if (!handled)
-                {
-                    callback->received(m_message, m_connectionId);
-                }
-            }
-            reset();
-        }
+        callback->received(m_message, m_connectionId);
     }
-    return ok;
+    reset();
 }
 
 hybrid_ptr<IStreamConnectionCallback> ProtocolHttpClient::connected(const IStreamConnectionPtr& connection)
@@ -1872,7 +1715,9 @@ hybrid_ptr<IStreamConnectionCallback> ProtocolHttpClient::connected(const IStrea
     }
     m_connectionId = connectionData.connectionId;
 
+    std::unique_lock<std::mutex> lock(m_mutex);
     auto callback = m_callback.lock();
+    lock.unlock();
     if (callback)
     {
         callback->connected();
@@ -1886,10 +1731,12 @@ const std::string FMQ_DISCONNECTED = "fmq_disconnected";
 
 void ProtocolHttpClient::disconnected(const IStreamConnectionPtr& connection)
 {
+    std::unique_lock<std::mutex> lock(m_mutex);
     auto callback = m_callback.lock();
+    lock.unlock();
     if (callback)
     {
-        IMessagePtr message = std::make_shared<ProtocolMessage>(0);
+        IMessagePtr message = ProtocolMessagePool::createMessage(0);
         IMessage::Metainfo& metainfo = message->getAllMetainfo();
         metainfo[FMQ_HTTP] = HTTP_RESPONSE;
         metainfo[FMQ_PROTOCOL] = "HTTP/1.1";
@@ -1902,6 +1749,17 @@ void ProtocolHttpClient::disconnected(const IStreamConnectionPtr& connection)
     }
 }
 
+void ProtocolHttpClient::writable(const IStreamConnectionPtr& /*connection*/)
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    auto callback = m_callback.lock();
+    lock.unlock();
+    if (callback)
+    {
+        callback->writable();
+    }
+}
+
 IMessagePtr ProtocolHttpClient::pollReply(std::deque<IMessagePtr>&& /*messages*/)
 {
     return nullptr;
@@ -1922,6 +1780,8 @@ IProtocolSessionDataPtr ProtocolHttpClient::createProtocolSessionData()
 
 void ProtocolHttpClient::setProtocolSessionData(const IProtocolSessionDataPtr& protocolSessionData)
 {
+    // a pooled connection can be taken over by another session, which brings its own cookie store
+    std::unique_lock<std::mutex> lock(m_mutex);
     m_cookieStore = std::static_pointer_cast<CookieStore>(protocolSessionData);
 }
 
@@ -24,8 +24,10 @@
 
 #include "finalmq/helpers/Utils.h"
 #include "finalmq/protocolsession/ProtocolMessage.h"
+#include "finalmq/protocolsession/ProtocolMessagePool.h"
 #include "finalmq/protocolsession/ProtocolRegistry.h"
 #include "finalmq/protocolsession/ProtocolSession.h"
+#include "finalmq/protocols/protocolhelpers/HttpHeaderParser.h"
 #include "finalmq/streamconnection/Socket.h"
 
 //#include "finalmq/helpers/ModulenameFinalmq.h"
@@ -34,8 +36,6 @@
 #include <cassert>
 #include <cstdlib>
 
-#include <fcntl.h>
-
 namespace finalmq
 {
 const std::uint32_t ProtocolHttpServer::PROTOCOL_ID = 4;
@@ -66,6 +66,8 @@ static const std::string FMQ_PATH_CONFIG = "/fmq/config";
 static const std::string FMQ_PATH_CREATESESSION = "/fmq/createsession";
 static const std::string FMQ_PATH_REMOVESESSION = "/fmq/removesession";
 static const std::string FMQ_MULTIPART_BOUNDARY = "B9BMAhxAhY.mQw1IDRBA";
+static const std::string FMQ_HTTP_REQUESTID = "fmq_http_requestid";
+static const std::string FMQ_HTTP_REQUESTCONNID = "fmq_http_requestconnid";
 
 enum ChunkedState
 {
@@ -180,30 +182,10 @@ bool ProtocolHttpServer::isSynchronousRequestReply() const
 IProtocol::FuncCreateMessage ProtocolHttpServer::getMessageFactory() const
 {
     return []() {
-        return std::make_shared<ProtocolMessage>(PROTOCOL_ID);
+        return ProtocolMessagePool::createMessage(PROTOCOL_ID);
     };
 }
 
-static void splitOnce(const std::string& src, ssize_t indexBegin, ssize_t indexEnd, char delimiter, std::vector<std::string>& dest)
-{
-    size_t pos = src.find_first_of(delimiter, indexBegin);
-    if (pos == std::string::npos || static_cast<ssize_t>(pos) > indexEnd)
-    {
-        pos = indexEnd;
-    }
-    ssize_t len = pos - indexBegin;
-    assert(len >= 0);
-    dest.emplace_back(&src[indexBegin], len);
-    ++pos;
-
-    if (static_cast<ssize_t>(pos) < indexEnd)
-    {
-        len = indexEnd - pos;
-        assert(len >= 0);
-        dest.emplace_back(&src[pos], len);
-    }
-}
-
 static const char tabDecToHex[] = {
     '0',
     '1',
@@ -249,29 +231,6 @@ static void encode(std::string& dest, const std::string& src)
     }
 }
 
-static void decode(std::string& dest, const std::string& src)
-{
-    dest.reserve(src.size());
-    char code[3] = {0};
-    unsigned long c = 0;
-
-    for (size_t i = 0; i < src.size(); ++i)
-    {
-        if (src[i] == '%')
-        {
-            ++i;
-            memcpy(code, &src[i], 2);
-            c = strtoul(code, NULL, 16);
-            dest += static_cast<char>(c);
-            ++i;
-        }
-        else
-        {
-            dest += src[i];
-        }
-    }
-}
-
 std::string ProtocolHttpServer::createSessionName()
 {
     std::uint64_t sessionCounter = m_nextSessionNameCounter.fetch_add(1);
@@ -355,35 +314,27 @@ void ProtocolHttpServer::checkSessionName()
     m_sessionNames.clear();
 }
 
-void ProtocolHttpServer::cookiesToSessionIds(const std::string& cookies)
+void ProtocolHttpServer::cookiesToSessionIds(std::string_view cookies)
 {
     m_sessionNames.clear();
-    size_t posStart = 0;
-    while (posStart != std::string::npos)
+    while (!cookies.empty())
     {
-        size_t posEnd = cookies.find_first_of(';', posStart);
-        std::string cookie;
-        if (posEnd != std::string::npos)
-        {
-            cookie = std::string(cookies, posStart, posEnd - posStart);
-            posStart = posEnd + 1;
-        }
-        else
-        {
-            cookie = std::string(cookies, posStart);
-            posStart = posEnd;
-        }
-
+        const size_t posEnd = cookies.find(';');
+        const std::string_view cookie = cookies.substr(0, posEnd);
         size_t pos = cookie.find("fmq=");
-        if (pos != std::string::npos)
+        if (pos != std::string_view::npos)
         {
             pos += 4;
-            std::string sessionId = {cookie, pos};
-            if (!sessionId.empty())
+            if (pos < cookie.size())
             {
-                m_sessionNames.emplace_back(std::move(sessionId));
+                m_sessionNames.emplace_back(cookie.substr(pos));
             }
         }
+        if (posEnd == std::string_view::npos)
+        {
+            break;
+        }
+        cookies.remove_prefix(posEnd + 1);
     }
 }
 
@@ -392,96 +343,62 @@ bool ProtocolHttpServer::receiveHeaders(ssize_t bytesReceived)
     bool ok = true;
     bytesReceived += m_sizeRemaining;
     assert(bytesReceived <= static_cast<ssize_t>(m_receiveBuffer.size()));
+    const char* buffer = m_receiveBuffer.data();
     while (m_offsetRemaining < bytesReceived && ok)
     {
-        size_t index = m_receiveBuffer.find_first_of('\n', m_offsetRemaining);
-        if (index != std::string::npos)
+        ssize_t index = HttpHeaderParser::findEndOfLine(buffer, m_offsetRemaining, bytesReceived);
+        if (index >= 0)
         {
             ssize_t indexEndLine = index;
             --indexEndLine; // goto '\r'
             ssize_t len = indexEndLine - m_offsetRemaining;
-            if (len < 0 || m_receiveBuffer[indexEndLine] != '\r')
+            if (len < 0 || buffer[indexEndLine] != '\r')
             {
                 ok = false;
             }
             if (ok)
             {
+                const std::string_view line(buffer + m_offsetRemaining, len);
                 if (m_state == State::STATE_FIND_FIRST_LINE)
                 {
                     m_contentLength = 0;
-                    if (len < 4)
+                    std::string_view first;
+                    std::string_view second;
+                    std::string_view rest;
+                    if (len < 4 || !HttpHeaderParser::splitStartLine(line, first, second, rest) || rest.empty())
+                    {
+                        ok = false;
+                    }
+                    // is response
+                    else if (line[0] == 'H' && line[1] == 'T')
+                    {
+                        m_message = ProtocolMessagePool::createMessage(0);
+                        IMessage::Metainfo& metainfo = m_message->getAllMetainfo();
+                        metainfo[FMQ_HTTP] = HTTP_RESPONSE;
+                        metainfo[FMQ_PROTOCOL] = first;
+                        metainfo[FMQ_HTTP_STATUS] = second;
+                        metainfo[FMQ_HTTP_STATUSTEXT] = rest;
+                        m_state = State::STATE_FIND_HEADERS;
+                    }
+                    else if (rest.find(' ') != std::string_view::npos)
                     {
                         ok = false;
                     }
                     else
                     {
-                        // is response
-                        if (m_receiveBuffer[m_offsetRemaining] == 'H' && m_receiveBuffer[m_offsetRemaining + 1] == 'T')
-                        {
-                            std::vector<std::string> lineSplit;
-                            Utils::split(m_receiveBuffer, m_offsetRemaining, indexEndLine, ' ', lineSplit);
-                            if (lineSplit.size() == 3)
-                            {
-                                m_message = std::make_shared<ProtocolMessage>(0);
-                                IMessage::Metainfo& metainfo = m_message->getAllMetainfo();
-                                metainfo[FMQ_HTTP] = HTTP_RESPONSE;
-                                metainfo[FMQ_PROTOCOL] = std::move(lineSplit[0]);
-                                metainfo[FMQ_HTTP_STATUS] = std::move(lineSplit[1]);
-                                metainfo[FMQ_HTTP_STATUSTEXT] = std::move(lineSplit[2]);
-                                m_state = State::STATE_FIND_HEADERS;
-                            }
-                            else
-                            {
-                                ok = false;
-                            }
-                        }
-                        else
+                        m_message = ProtocolMessagePool::createMessage(0);
+                        IMessage::Metainfo& metainfo = m_message->getAllMetainfo();
+                        metainfo[FMQ_HTTP] = HTTP_REQUEST;
+                        metainfo[FMQ_METHOD] = first;
+                        metainfo[FMQ_PROTOCOL] = rest;
+                        const size_t posQuery = second.find('?');
+                        m_path = &metainfo[FMQ_PATH];
+                        HttpHeaderParser::decode(*m_path, second.substr(0, posQuery));
+                        if (posQuery != std::string_view::npos)
                         {
-                            std::vector<std::string> lineSplit;
-                            Utils::split(m_receiveBuffer, m_offsetRemaining, indexEndLine, ' ', lineSplit);
-                            if (lineSplit.size() == 3)
-                            {
-                                std::vector<std::string> pathquerySplit;
-                                Utils::split(lineSplit[1], 0, lineSplit[1].size(), '?', pathquerySplit);
-                                m_message = std::make_shared<ProtocolMessage>(0);
-                                IMessage::Metainfo& metainfo = m_message->getAllMetainfo();
-                                metainfo[FMQ_HTTP] = HTTP_REQUEST;
-                                metainfo[FMQ_METHOD] = std::move(lineSplit[0]);
-                                metainfo[FMQ_PROTOCOL] = std::move(lineSplit[2]);
-                                if (pathquerySplit.size() >= 1)
-                                {
-                                    std::string path;
-                                    decode(path, pathquerySplit[0]);
-                                    m_path = &metainfo[FMQ_PATH];
-                                    *m_path = std::move(path);
-                                }
-                                if (pathquerySplit.size() >= 2)
-                                {
-                                    std::vector<std::string> querySplit;
-                                    Utils::split(pathquerySplit[1], 0, pathquerySplit[1].size(), '&', querySplit);
-                                    for (size_t i = 0; i < querySplit.size(); ++i)
-                                    {
-                                        std::string queryTotal;
-                                        decode(queryTotal, querySplit[i]);
-                                        std::vector<std::string> queryNameValue;
-                                        Utils::split(queryTotal, 0, queryTotal.size(), '=', queryNameValue);
-                                        if (queryNameValue.size() == 1)
-                                        {
-                                            metainfo[FMQ_QUERY_PREFIX + queryNameValue[0]] = std::string();
-                                        }
-                                        else if (queryNameValue.size() >= 2)
-                                        {
-                                            metainfo[FMQ_QUERY_PREFIX + queryNameValue[0]] = std::move(queryNameValue[1]);
-                                        }
-                                    }
-                                }
-                                m_state = State::STATE_FIND_HEADERS;
-                            }
-                            else
-                            {
-                                ok = false;
-                            }
+                            receiveQuery(second.substr(posQuery + 1), metainfo);
                         }
+                        m_state = State::STATE_FIND_HEADERS;
                     }
                 }
                 else if (m_state == State::STATE_FIND_HEADERS)
@@ -503,55 +420,35 @@ bool ProtocolHttpServer::receiveHeaders(ssize_t bytesReceived)
                     }
                     else
                     {
-                        std::vector<std::string> lineSplit;
-                        splitOnce(m_receiveBuffer, m_offsetRemaining, indexEndLine, ':', lineSplit);
-                        if (lineSplit.size() == 2)
+                        std::string_view name;
+                        std::string_view value;
+                        HttpHeaderParser::splitHeaderLine(line, name, value);
+                        if (name == CONTENT_LENGTH)
                         {
-                            std::string& value = lineSplit[1];
-                            if (!value.empty() && value[0] == ' ')
-                            {
-                                value.erase(value.begin());
-                            }
-                            if (lineSplit[0] == CONTENT_LENGTH)
-                            {
-                                m_contentLength = std::atoll(value.c_str());
-                            }
-                            else if (lineSplit[0] == FMQ_CREATESESSION)
-                            {
-                                m_createSession = true;
-                            }
-                            else if (lineSplit[0] == FMQ_SESSIONID)
-                            {
-                                m_sessionNames.clear();
-                                if (!value.empty())
-                                {
-                                    m_sessionNames.push_back(value);
-                                }
-                                m_stateSessionId = StateSessionId::SESSIONID_FMQ;
-                            }
-                            else if (lineSplit[0] == HTTP_COOKIE)
-                            {
-                                if (m_stateSessionId == StateSessionId::SESSIONID_NONE)
-                                {
-                                    cookiesToSessionIds(value);
-                                    //                                    if (!m_sessionNames.empty())
-                                    //                                    {
-                                    //                                        streamInfo << this << " input cookie: " << m_sessionNames[0];
-                                    //                                    }
-                                    m_stateSessionId = StateSessionId::SESSIONID_COOKIE;
-                                }
-                            }
-                            m_message->addMetainfo(std::move(lineSplit[0]), std::move(value));
+                            m_contentLength = HttpHeaderParser::parseContentLength(value);
                         }
-                        else if (lineSplit.size() == 1)
+                        else if (name == FMQ_CREATESESSION)
                         {
-                            m_message->addMetainfo(std::move(lineSplit[0]), "");
+                            m_createSession = true;
                         }
-                        else
+                        else if (name == FMQ_SESSIONID)
+                        {
+                            m_sessionNames.clear();
+                            if (!value.empty())
+                            {
+                                m_sessionNames.emplace_back(value);
+                            }
+                            m_stateSessionId = StateSessionId::SESSIONID_FMQ;
+                        }
+                        else if (name == HTTP_COOKIE)
                         {
-                            assert(false);
-                            ok = false;
+                            if (m_stateSessionId == StateSessionId::SESSIONID_NONE)
+                            {
+                                cookiesToSessionIds(value);
+                                m_stateSessionId = StateSessionId::SESSIONID_COOKIE;
+                            }
                         }
+                        m_message->addMetainfo(std::string(name), std::string(value));
                     }
                 }
                 m_offsetRemaining += len + 2;
@@ -567,10 +464,35 @@ bool ProtocolHttpServer::receiveHeaders(ssize_t bytesReceived)
     return ok;
 }
 
+void ProtocolHttpServer::receiveQuery(std::string_view query, IMessage::Metainfo& metainfo)
+{
+    while (!query.empty())
+    {
+        const size_t posEnd = query.find('&');
+        const std::string_view nameValue = query.substr(0, posEnd);
+        if (!nameValue.empty())
+        {
+            const size_t posValue = nameValue.find('=');
+            std::string key = FMQ_QUERY_PREFIX;
+            HttpHeaderParser::decode(key, nameValue.substr(0, posValue));
+            std::string& value = metainfo[std::move(key)];
+            value.clear();
+            if (posValue != std::string_view::npos)
+            {
+                HttpHeaderParser::decode(value, nameValue.substr(posValue + 1));
+            }
+        }
+        if (posEnd == std::string_view::npos)
+        {
+            break;
+        }
+        query.remove_prefix(posEnd + 1);
+    }
+}
+
 void ProtocolHttpServer::reset()
 {
-    m_offsetRemaining = 0;
-    m_sizeRemaining = 0;
+    // m_offsetRemaining and m_sizeRemaining are kept, the remaining bytes belong to the next request
     m_contentLength = 0;
     m_indexFilled = 0;
     m_message = nullptr;
@@ -603,14 +525,13 @@ void ProtocolHttpServer::sendMessage(IMessagePtr message)
     }
     const std::string* filename = controlData.getData<std::string>("filetransfer");
     ssize_t filesize = -1;
+    FileRegionPtr file;
     if (filename)
     {
-        struct stat statdata;
-        memset(&statdata, 0, sizeof(statdata));
-        int res = OperatingSystem::instance().stat(filename->c_str(), &statdata);
-        if (res == 0)
+        file = FileRegion::open(*filename);
+        if (file)
         {
-            filesize = statdata.st_size;
+            filesize = file->getSize();
             message->downsizeLastSendPayload(0);
         }
     }
@@ -820,92 +741,75 @@ void ProtocolHttpServer::sendMessage(IMessagePtr message)
         m_multipart = false;
     }
 
+    if (file)
+    {
+        message->setSendFile(file);
+    }
+
     message->prepareMessageToSend();
 
     assert(m_connection);
-    m_connection->sendMessage(message);
+    sendInOrderOfRequests(message);
+}
 
-    if (filename && filesize > 0)
+void ProtocolHttpServer::sendInOrderOfRequests(const IMessagePtr& message)
+{
+    // the responses of pipelined requests have to be sent in the order of the requests,
+    // a response that is ready before the responses of its previous requests waits in m_responsesPending.
+    const Variant& echoData = message->getEchoData();
+    const std::int64_t* requestId = echoData.getData<std::int64_t>(FMQ_HTTP_REQUESTID);
+    if (requestId && echoData.getDataValue<std::int64_t>(FMQ_HTTP_REQUESTCONNID) != m_connectionId)
     {
-        std::string file = *filename;
-        std::weak_ptr<ProtocolHttpServer> pThisWeak = shared_from_this();
-        GlobalExecutorWorker::instance().addAction([pThisWeak, file, filesize]() {
-            std::shared_ptr<ProtocolHttpServer> pThis = pThisWeak.lock();
-            if (!pThis)
-            {
-                return;
-            }
-            int flags = O_RDONLY;
-#ifdef WIN32
-            flags |= O_BINARY;
-#endif
-            int fd = OperatingSystem::instance().open(file.c_str(), flags);
-            if (fd != -1)
-            {
-                ssize_t len = filesize;
-                int err = 0;
-                int lenReceived = 0;
-                bool ex = false;
-                while (!ex)
-                {
-                    ssize_t size = std::min(static_cast<ssize_t>(1024), len);
-                    IMessagePtr messageData = std::make_shared<ProtocolMessage>(0);
-                    char* buf = messageData->addSendPayload(size);
-                    do
-                    {
-                        err = OperatingSystem::instance().read(fd, buf, static_cast<int>(size));
-                    } while (err == -1 && OperatingSystem::instance().getLastError() == SOCKETERROR(EINTR));
+        // the request was received by another connection
+        requestId = nullptr;
+    }
+    if (requestId == nullptr || *requestId < m_responseIdNext)
+    {
+        if (m_responsesPending.empty())
+        {
+            m_connection->sendMessage(message);
+        }
+        else
+        {
+            // e.g. the chunks of a poll stream, whose header is still waiting
+            m_responsesPending.rbegin()->second.push_back(message);
+        }
+        return;
+    }
 
-                    if (err > 0)
-                    {
-                        assert(err <= size);
-                        if (err < size)
-                        {
-                            messageData->downsizeLastSendPayload(err);
-                        }
-                        pThis->m_connection->sendMessage(messageData);
-                        buf += err;
-                        len -= err;
-                        lenReceived += err;
-                        err = 0;
-                        assert(len >= 0);
-                        if (len == 0)
-                        {
-                            ex = true;
-                        }
-                    }
-                    else
-                    {
-                        ex = true;
-                    }
-                }
-                if (lenReceived < filesize)
-                {
-                    ssize_t diff = filesize - lenReceived;
-                    ex = false;
-                    while (!ex)
-                    {
-                        ssize_t size = std::min(static_cast<ssize_t>(1024), diff);
-                        IMessagePtr messageData = std::make_shared<ProtocolMessage>(0);
-                        char* buf = messageData->addSendPayload(size);
-                        memset(buf, 0, size);
-                        pThis->m_connection->sendMessage(messageData);
-                        diff -= size;
-                        if (diff <= 0)
-                        {
-                            ex = true;
-                        }
-                    }
-                }
-            }
-            else
-            {
-                pThis->m_connection->disconnect();
-            }
-        });
+    if (*requestId > m_responseIdNext)
+    {
+        m_responsesPending[*requestId].push_back(message);
+        return;
+    }
+
+    m_connection->sendMessage(message);
+    ++m_responseIdNext;
+    while (!m_responsesPending.empty() && m_responsesPending.begin()->first == m_responseIdNext)
+    {
+        for (const IMessagePtr& messagePending : m_responsesPending.begin()->second)
+        {
+            m_connection->sendMessage(messagePending);
+        }
+        m_responsesPending.erase(m_responsesPending.begin());
+        ++m_responseIdNext;
     }
 }
 
+IMessagePtr ProtocolHttpServer::createResponse(std::int64_t requestId)
+{
+    IMessagePtr message = getMessageFactory()();
+    addRequestId(*message, requestId);
+    return message;
+}
+
+void ProtocolHttpServer::addRequestId(IMessage& message, std::int64_t requestId) const
+{
+    Variant& echoData = message.getEchoData();
+    echoData.add(FMQ_HTTP_REQUESTID, requestId);
+    echoData.add(FMQ_HTTP_REQUESTCONNID, m_connectionId);
+}
+
 void ProtocolHttpServer::moveOldProtocolState(IProtocol& /*protocolOld*/)
 {
     //assert(protocolOld.getProtocolId() == PROTOCOL_ID);
@@ -915,7 +819,7 @@ void ProtocolHttpServer::moveOldProtocolState(IProtocol& /*protocolOld*/)
     //}
 }
 
-bool ProtocolHttpServer::handleInternalCommands(const std::shared_ptr<IProtocolCallback>& callback, bool& ok)
+bool ProtocolHttpServer::handleInternalCommands(const std::shared_ptr<IProtocolCallback>& callback, std::int64_t requestId, bool& ok)
 {
     assert(callback);
     bool handled = false;
@@ -951,7 +855,7 @@ bool ProtocolHttpServer::handleInternalCommands(const std::shared_ptr<IProtocolC
             //{
             //    timeout = -1;
             //}
-            IMessagePtr message = getMessageFactory()();
+            IMessagePtr message = createResponse(requestId);
             std::string contentType;
             if (m_multipart)
             {
@@ -972,7 +876,7 @@ bool ProtocolHttpServer::handleInternalCommands(const std::shared_ptr<IProtocolC
         {
             handled = true;
             assert(m_connection);
-            sendMessage(getMessageFactory()());
+            sendMessage(createResponse(requestId));
             callback->activity();
         }
         else if (*m_path == FMQ_PATH_CONFIG)
@@ -988,20 +892,20 @@ bool ProtocolHttpServer::handleInternalCommands(const std::shared_ptr<IProtocolC
             {
                 callback->setPollMaxRequests(std::atoi(pollMaxRequests->c_str()));
             }
-            sendMessage(getMessageFactory()());
+            sendMessage(createResponse(requestId));
             callback->activity();
         }
         else if (*m_path == FMQ_PATH_CREATESESSION)
         {
             handled = true;
-            sendMessage(getMessageFactory()());
+            sendMessage(createResponse(requestId));
             callback->activity();
         }
         else if (*m_path == FMQ_PATH_REMOVESESSION)
         {
             handled = true;
             ok = false;
-            sendMessage(getMessageFactory()());
+            sendMessage(createResponse(requestId));
             callback->disconnected();
         }
     }
@@ -1009,113 +913,95 @@ bool ProtocolHttpServer::handleInternalCommands(const std::shared_ptr<IProtocolC
     return handled;
 }
 
-bool ProtocolHttpServer::received(const IStreamConnectionPtr& /*connection*/, const SocketPtr& socket, int bytesToRead)
+bool ProtocolHttpServer::received(const IStreamConnectionPtr& /*connection*/, const char* buffer, int size)
 {
     bool ok = true;
 
-    if (m_state != State::STATE_CONTENT)
+    if (m_state == State::STATE_CONTENT)
+    {
+        // only the rest of the body goes into the payload, the following bytes belong to the next (pipelined) request
+        BufferRef payload = m_message->getReceivePayload();
+        assert(payload.second == m_contentLength);
+        const ssize_t bytesContent = std::min(static_cast<ssize_t>(size), m_contentLength - m_indexFilled);
+        memcpy(payload.first + m_indexFilled, buffer, bytesContent);
+        m_indexFilled += bytesContent;
+        assert(m_indexFilled <= m_contentLength);
+        if (m_indexFilled == m_contentLength)
+        {
+            m_state = State::STATE_CONTENT_DONE;
+            ok = requestDone();
+        }
+        buffer += bytesContent;
+        size -= static_cast<int>(bytesContent);
+    }
+
+    if (ok && size > 0)
     {
         if (m_offsetRemaining == 0 || m_sizeRemaining == 0)
         {
-            m_receiveBuffer.resize(m_sizeRemaining + bytesToRead);
+            m_receiveBuffer.resize(m_sizeRemaining + size);
         }
         else
         {
             std::string temp = std::move(m_receiveBuffer);
             m_receiveBuffer.clear();
-            m_receiveBuffer.resize(m_sizeRemaining + bytesToRead);
+            m_receiveBuffer.resize(m_sizeRemaining + size);
             memcpy(&m_receiveBuffer[0], &temp[m_offsetRemaining], m_sizeRemaining);
         }
         m_offsetRemaining = 0;
 
-        ssize_t bytesReceived = 0;
-        int res = 0;
-        do
-        {
-            res = socket->receive((m_receiveBuffer.data() + bytesReceived + m_sizeRemaining), static_cast<int>(bytesToRead - bytesReceived));
-            if (res > 0)
-            {
-                bytesReceived += res;
-            }
-        } while (res > 0 && bytesReceived < bytesToRead);
-        if (res >= 0)
+        memcpy(m_receiveBuffer.data() + m_sizeRemaining, buffer, size);
+        ok = receiveHeaders(size);
+        while (ok && (m_state == State::STATE_CONTENT || m_state == State::STATE_CONTENT_DONE))
         {
-            assert(bytesReceived <= bytesToRead);
-            ok = receiveHeaders(bytesReceived);
-            if (ok && m_state == State::STATE_CONTENT)
+            if (m_state == State::STATE_CONTENT)
             {
                 assert(m_message != nullptr);
                 BufferRef payload = m_message->getReceivePayload();
                 assert(payload.second == m_contentLength);
-                if (m_sizeRemaining <= m_contentLength)
+                const ssize_t sizeContent = std::min(m_sizeRemaining, m_contentLength);
+                memcpy(payload.first, m_receiveBuffer.data() + m_offsetRemaining, sizeContent);
+                m_indexFilled = sizeContent;
+                m_offsetRemaining += sizeContent;
+                m_sizeRemaining -= sizeContent;
+                if (m_indexFilled < m_contentLength)
                 {
-                    memcpy(payload.first, m_receiveBuffer.data() + m_offsetRemaining, m_sizeRemaining);
-                    m_indexFilled = m_sizeRemaining;
-                    assert(m_indexFilled <= m_contentLength);
-                    if (m_indexFilled == m_contentLength)
-                    {
-                        m_state = State::STATE_CONTENT_DONE;
-                    }
-                }
-                else
-                {
-                    // too much content
-                    ok = false;
+                    break;
                 }
+                m_state = State::STATE_CONTENT_DONE;
             }
-        }
-    }
-    else
-    {
-        BufferRef payload = m_message->getReceivePayload();
-        assert(payload.second == m_contentLength);
-        ssize_t remainingContent = m_contentLength - m_indexFilled;
-        if (bytesToRead <= remainingContent)
-        {
-            ssize_t bytesReceived = 0;
-            int res = 0;
-            do
-            {
-                res = socket->receive(payload.first + bytesReceived + m_indexFilled, static_cast<int>(bytesToRead - bytesReceived));
-                if (res > 0)
-                {
-                    bytesReceived += res;
-                }
-            } while (res > 0 && bytesReceived < bytesToRead);
-            if (res >= 0)
+            ok = requestDone();
+            if (!ok || m_sizeRemaining == 0)
             {
-                m_indexFilled += bytesReceived;
-                assert(m_indexFilled <= m_contentLength);
-                if (m_indexFilled == m_contentLength)
-                {
-                    m_state = State::STATE_CONTENT_DONE;
-                }
+                break;
             }
-        }
-        else
-        {
-            // too much content
-            ok = false;
+            // pipelining: the next request is already in the buffer, receiveHeaders continues at m_offsetRemaining
+            ok = receiveHeaders(m_offsetRemaining);
         }
     }
 
-    if (ok)
+    return ok;
+}
+
+bool ProtocolHttpServer::requestDone()
+{
+    assert(m_state == State::STATE_CONTENT_DONE);
+    bool ok = true;
+    checkSessionName();
+    const std::int64_t requestId = m_requestIdNext;
+    ++m_requestIdNext;
+    auto callback = m_callback.lock();
+    if (callback)
     {
-        if (m_state == State::STATE_CONTENT_DONE)
+        bool handled = handleInternalCommands(callback, requestId, ok);
+        if (!handled)
         {
-            checkSessionName();
-            auto callback = m_callback.lock();
-            if (callback)
-            {
-                bool handled = handleInternalCommands(callback, ok);
-                if (!handled)
-                {
-                    callback->received(m_message, m_connectionId);
-                }
-            }
-            reset();
+            // the reply gets the echo data of the request, so that it can be sent in the order of the requests
+            addRequestId(*m_message, requestId);
+            callback->received(m_message, m_connectionId);
         }
     }
+    reset();
     return ok;
 }
 
@@ -1141,6 +1027,33 @@ void ProtocolHttpServer::disconnected(const IStreamConnectionPtr& /*connection*/
     }
 }
 
+void ProtocolHttpServer::writable(const IStreamConnectionPtr& /*connection*/)
+{
+    auto callback = m_callback.lock();
+    if (callback)
+    {
+        callback->writable();
+    }
+}
+
+static void moveSendPayloads(IMessage& message, IMessage& msg)
+{
+    const std::list<BufferRef>& payloads = msg.getAllSendPayloads();
+    std::list<std::string>& payloadBuffers = msg.getSendPayloadBuffers();
+    if (payloadBuffers.size() == payloads.size())
+    {
+        message.moveSendBuffers(std::move(payloadBuffers), payloads);
+    }
+    else
+    {
+        // shared payloads are not owned by the message, so they cannot be moved
+        for (auto it = payloads.begin(); it != payloads.end(); ++it)
+        {
+            message.addSendPayload(it->first, it->second);
+        }
+    }
+}
+
 IMessagePtr ProtocolHttpServer::pollReply(std::deque<IMessagePtr>&& messages)
 {
     IMessagePtr message = getMessageFactory()();
@@ -1160,9 +1073,7 @@ IMessagePtr ProtocolHttpServer::pollReply(std::deque<IMessagePtr>&& messages)
                 payload += "\r\n\r\n";
                 message->addSendPayload(payload);
                 IMessagePtr& msg = *it;
-                const std::list<BufferRef>& payloads = msg->getAllSendPayloads();
-                std::list<std::string>& payloadBuffers = msg->getSendPayloadBuffers();
-                message->moveSendBuffers(std::move(payloadBuffers), payloads);
+                moveSendPayloads(*message, *msg);
                 payload = "\r\n--" + FMQ_MULTIPART_BOUNDARY;
                 message->addSendPayload(payload);
             }
@@ -1187,9 +1098,7 @@ IMessagePtr ProtocolHttpServer::pollReply(std::deque<IMessagePtr>&& messages)
         for (auto it = messages.begin(); it != messages.end(); ++it)
         {
             IMessagePtr& msg = *it;
-            const std::list<BufferRef>& payloads = msg->getAllSendPayloads();
-            std::list<std::string>& payloadBuffers = msg->getSendPayloadBuffers();
-            message->moveSendBuffers(std::move(payloadBuffers), payloads);
+            moveSendPayloads(*message, *msg);
         }
     }
     return message;
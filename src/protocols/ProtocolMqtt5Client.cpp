@@ -24,6 +24,7 @@
 
 #include "finalmq/helpers/ModulenameFinalmq.h"
 #include "finalmq/protocolsession/ProtocolMessage.h"
+#include "finalmq/protocolsession/ProtocolMessagePool.h"
 #include "finalmq/protocolsession/ProtocolRegistry.h"
 #include "finalmq/streamconnection/Socket.h"
 #include "finalmq/variant/VariantValueStruct.h"
@@ -245,7 +246,7 @@ void ProtocolMqtt5Client::disconnect()
     IMqtt5Client::PublishData dataWill;
     dataWill.qos = 0;
     dataWill.topic = TOPIC_WILLMESSAGE;
-    IMessagePtr message = std::make_shared<ProtocolMessage>(0);
+    IMessagePtr message = ProtocolMessagePool::createMessage(0);
     message->addSendPayload(m_virtualSessionId);
     m_client->publish(connection, std::move(dataWill), message);
 
@@ -306,7 +307,7 @@ bool ProtocolMqtt5Client::isSynchronousRequestReply() const
 IProtocol::FuncCreateMessage ProtocolMqtt5Client::getMessageFactory() const
 {
     return []() {
-        return std::make_shared<ProtocolMessage>(PROTOCOL_ID);
+        return ProtocolMessagePool::createMessage(PROTOCOL_ID);
     };
 }
 
@@ -372,9 +373,9 @@ void ProtocolMqtt5Client::moveOldProtocolState(IProtocol& /*protocolOld*/)
 {
 }
 
-bool ProtocolMqtt5Client::received(const IStreamConnectionPtr& connection, const SocketPtr& socket, int bytesToRead)
+bool ProtocolMqtt5Client::received(const IStreamConnectionPtr& connection, const char* buffer, int size)
 {
-    bool ok = m_client->receive(connection, socket, bytesToRead);
+    bool ok = m_client->receive(connection, buffer, size);
     return ok;
 }
 
@@ -404,6 +405,18 @@ void ProtocolMqtt5Client::disconnected(const IStreamConnectionPtr& /*connection*
     }
 }
 
+void ProtocolMqtt5Client::writable(const IStreamConnectionPtr& /*connection*/)
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    auto callback = m_callback.lock();
+    lock.unlock();
+
+    if (callback)
+    {
+        callback->writable();
+    }
+}
+
 IMessagePtr ProtocolMqtt5Client::pollReply(std::deque<IMessagePtr>&& /*messages*/)
 {
     return {};
@@ -23,10 +23,12 @@
 
 #include "finalmq/protocols/ProtocolStream.h"
 #include "finalmq/protocolsession/ProtocolMessage.h"
+#include "finalmq/protocolsession/ProtocolMessagePool.h"
 #include "finalmq/protocolsession/ProtocolRegistry.h"
 #include "finalmq/streamconnection/Socket.h"
 
 #include <assert.h>
+#include <string.h>
 
 namespace finalmq {
 
@@ -131,7 +133,7 @@ bool ProtocolStream::isSynchronousRequestReply() const
 IProtocol::FuncCreateMessage ProtocolStream::getMessageFactory() const
 {
     return []() {
-        return std::make_shared<ProtocolMessage>(PROTOCOL_ID);
+        return ProtocolMessagePool::createMessage(PROTOCOL_ID);
     };
 }
 
@@ -155,21 +157,15 @@ void ProtocolStream::moveOldProtocolState(IProtocol& /*protocolOld*/)
 }
 
 
-bool ProtocolStream::received(const IStreamConnectionPtr& /*connection*/, const SocketPtr& socket, int bytesToRead)
+bool ProtocolStream::received(const IStreamConnectionPtr& /*connection*/, const char* buffer, int size)
 {
-    IMessagePtr message = std::make_shared<ProtocolMessage>(0);
-    char* payload = message->resizeReceiveBuffer(bytesToRead);
-    int res = socket->receive(payload, bytesToRead);
-    if (res > 0)
+    IMessagePtr message = ProtocolMessagePool::createMessage(0);
+    char* payload = message->resizeReceiveBuffer(size);
+    memcpy(payload, buffer, size);
+    auto callback = m_callback.lock();
+    if (callback)
     {
-        int bytesReceived = res;
-        assert(bytesReceived <= bytesToRead);
-        message->resizeReceiveBuffer(bytesReceived);
-        auto callback = m_callback.lock();
-        if (callback)
-        {
-            callback->received(message);
-        }
+        callback->received(message);
     }
     return true;
 }
@@ -194,6 +190,15 @@ void ProtocolStream::disconnected(const IStreamConnectionPtr& /*connection*/)
     }
 }
 
+void ProtocolStream::writable(const IStreamConnectionPtr& /*connection*/)
+{
+    auto callback = m_callback.lock();
+    if (callback)
+    {
+        callback->writable();
+    }
+}
+
 
 IMessagePtr ProtocolStream::pollReply(std::deque<IMessagePtr>&& /*messages*/)
 {
@@ -38,9 +38,9 @@ void Mqtt5Client::setCallback(hybrid_ptr<IMqtt5ClientCallback> callback)
     m_callback = callback;
 }
 
-bool Mqtt5Client::receive(const IStreamConnectionPtr& connection, const SocketPtr& socket, int bytesToRead)
+bool Mqtt5Client::receive(const IStreamConnectionPtr& connection, const char* buffer, int size)
 {
-    return m_protocol->receive(connection, socket, bytesToRead);
+    return m_protocol->receive(connection, buffer, size);
 }
 
 void Mqtt5Client::startConnection(const IStreamConnectionPtr& connection, const ConnectData& data)
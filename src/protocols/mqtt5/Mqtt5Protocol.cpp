@@ -25,6 +25,7 @@
 #include "finalmq/protocols/mqtt5/Mqtt5Properties.h"
 #include "finalmq/protocols/mqtt5/Mqtt5Serialization.h"
 #include "finalmq/protocolsession/ProtocolMessage.h"
+#include "finalmq/protocolsession/ProtocolMessagePool.h"
 #include "finalmq/streamconnection/Socket.h"
 
 namespace finalmq
@@ -43,21 +44,21 @@ Mqtt5Protocol::Mqtt5Protocol()
     m_messageIdsAllocated.push_back({});
 }
 
-bool Mqtt5Protocol::receive(const IStreamConnectionPtr& connection, const SocketPtr& socket, int bytesToRead)
+bool Mqtt5Protocol::receive(const IStreamConnectionPtr& connection, const char* buffer, int size)
 {
     bool ok = true;
-    while ((bytesToRead > 0) && ok)
+    while ((size > 0) && ok)
     {
         switch(m_state)
         {
             case State::WAITFORHEADER:
-                ok = receiveHeader(socket, bytesToRead);
+                receiveHeader(buffer, size);
                 break;
             case State::WAITFORLENGTH:
-                ok = receiveRemainingSize(connection, socket, bytesToRead);
+                ok = receiveRemainingSize(connection, buffer, size);
                 break;
             case State::WAITFORPAYLOAD:
-                ok = receivePayload(connection, socket, bytesToRead);
+                ok = receivePayload(connection, buffer, size);
                 break;
             default:
                 assert(false);
@@ -67,53 +68,45 @@ bool Mqtt5Protocol::receive(const IStreamConnectionPtr& connection, const Socket
     return ok;
 }
 
-bool Mqtt5Protocol::receiveHeader(const SocketPtr& socket, int& bytesToRead)
+void Mqtt5Protocol::receiveHeader(const char*& buffer, int& size)
 {
-    assert(bytesToRead >= 1);
+    assert(size >= HEADERSIZE);
     assert(m_state == State::WAITFORHEADER);
-    bool ret = false;
 
-    int res = socket->receive(&m_header, HEADERSIZE);
-    if (res == HEADERSIZE)
-    {
-        bytesToRead -= HEADERSIZE;
-        ret = true;
-        m_remainingSize = 0;
-        m_remainingSizeShift = 0;
-        m_state = State::WAITFORLENGTH;
-    }
-    return ret;
+    m_header = *buffer;
+    buffer += HEADERSIZE;
+    size -= HEADERSIZE;
+    m_remainingSize = 0;
+    m_remainingSizeShift = 0;
+    m_state = State::WAITFORLENGTH;
 }
 
-bool Mqtt5Protocol::receiveRemainingSize(const IStreamConnectionPtr& connection, const SocketPtr& socket, int& bytesToRead)
+bool Mqtt5Protocol::receiveRemainingSize(const IStreamConnectionPtr& connection, const char*& buffer, int& size)
 {
-    assert(bytesToRead >= 1);
+    assert(size >= 1);
     assert(m_state == State::WAITFORLENGTH);
     bool ok = true;
     bool done = false;
-    while ((bytesToRead > 0) && !done && ok)
+    while ((size > 0) && !done && ok)
     {
         ok = false;
         if (m_remainingSizeShift <= 21)
         {
-            char data;
-            int res = socket->receive(&data, 1);
-            if (res == 1)
+            char data = *buffer;
+            ok = true;
+            buffer += 1;
+            size -= 1;
+            m_remainingSize |= (data & 0x7f) << m_remainingSizeShift;
+            if ((data & 0x80) == 0)
             {
-                ok = true;
-                bytesToRead -= 1;
-                m_remainingSize |= (data & 0x7f) << m_remainingSizeShift;
-                if ((data & 0x80) == 0)
+                done = true;
+                setPayloadSize();
+                if (m_state == State::MESSAGECOMPLETE)
                 {
-                    done = true;
-                    setPayloadSize();
-                    if (m_state == State::MESSAGECOMPLETE)
-                    {
-                        ok = processPayload(connection);
-                    }
+                    ok = processPayload(connection);
                 }
-                m_remainingSizeShift += 7;
             }
+            m_remainingSizeShift += 7;
         }
     }
 
@@ -126,7 +119,7 @@ void Mqtt5Protocol::setPayloadSize()
     assert(m_remainingSize >= 0);
     if (HEADER_Command(m_header) == Mqtt5Command::COMMAND_PUBLISH)
     {
-        m_message = std::make_shared<ProtocolMessage>(0, HEADERSIZE);
+        m_message = ProtocolMessagePool::createMessage(0, HEADERSIZE);
         m_buffer = m_message->resizeReceiveBuffer(HEADERSIZE + m_remainingSize);
     }
     else
@@ -146,36 +139,27 @@ void Mqtt5Protocol::setPayloadSize()
     m_sizeCurrent = 0;
 }
 
-bool Mqtt5Protocol::receivePayload(const IStreamConnectionPtr& connection, const SocketPtr& socket, int& bytesToRead)
+bool Mqtt5Protocol::receivePayload(const IStreamConnectionPtr& connection, const char*& buffer, int& size)
 {
     assert(m_state == State::WAITFORPAYLOAD);
     assert(m_sizeCurrent < m_remainingSize);
-    bool ok = false;
+    bool ok = true;
 
     ssize_t sizeRead = m_remainingSize - m_sizeCurrent;
-    if (bytesToRead < sizeRead)
+    if (size < sizeRead)
     {
-        sizeRead = bytesToRead;
+        sizeRead = size;
     }
-    int res = socket->receive(m_buffer + HEADERSIZE + m_sizeCurrent, static_cast<int>(sizeRead));
-    if (res > 0)
+    memcpy(m_buffer + HEADERSIZE + m_sizeCurrent, buffer, sizeRead);
+    buffer += sizeRead;
+    size -= static_cast<int>(sizeRead);
+    m_sizeCurrent += sizeRead;
+    assert(m_sizeCurrent <= m_remainingSize);
+    if (m_sizeCurrent == m_remainingSize)
     {
-        int bytesReceived = res;
-        assert(bytesReceived <= sizeRead);
-        bytesToRead -= bytesReceived;
-        assert(bytesToRead >= 0);
-        m_sizeCurrent += bytesReceived;
-        assert(m_sizeCurrent <= m_remainingSize);
-        if (bytesReceived == sizeRead)
-        {
-            ok = true;
-        }
-        if (ok && (m_sizeCurrent == m_remainingSize))
-        {
-            m_state = State::MESSAGECOMPLETE;
-            m_sizeCurrent = 0;
-            ok = processPayload(connection);
-        }
+        m_state = State::MESSAGECOMPLETE;
+        m_sizeCurrent = 0;
+        ok = processPayload(connection);
     }
     return ok;
 }
@@ -213,7 +197,7 @@ bool Mqtt5Protocol::handleAck(const IStreamConnectionPtr& connection, Mqtt5Comma
                 Mqtt5PubAckData data;
                 data.packetId = packetId;
                 data.reasoncode = 0;
-                IMessagePtr message = std::make_shared<ProtocolMessage>(0);
+                IMessagePtr message = ProtocolMessagePool::createMessage(0);
                 m_messagesWaitAck.push_back(message);
                 status.iterator = --m_messagesWaitAck.end();
                 lock.unlock();
@@ -507,7 +491,7 @@ void Mqtt5Protocol::sendConnect(const IStreamConnectionPtr& connection, const Mq
     unsigned int sizePropWillMessage = 0;
     unsigned int sizePayload = Mqtt5Serialization::sizeConnect(data, sizePropPayload, sizePropWillMessage);
     unsigned int sizeMessage = 1u + Mqtt5Serialization::sizeVarByteNumber(sizePayload) + sizePayload;
-    IMessagePtr message = std::make_shared<ProtocolMessage>(0);
+    IMessagePtr message = ProtocolMessagePool::createMessage(0);
     char* buffer = message->addSendHeader(sizeMessage);
     Mqtt5Serialization serialization(buffer, sizeMessage, 0);
     serialization.serializeConnect(data, sizePayload, sizePropPayload, sizePropWillMessage);
@@ -523,7 +507,7 @@ void Mqtt5Protocol::sendConnAck(const IStreamConnectionPtr& connection, const Mq
     unsigned int sizePropPayload = 0;
     unsigned int sizePayload = Mqtt5Serialization::sizeConnAck(data, sizePropPayload);
     unsigned int sizeMessage = 1u + Mqtt5Serialization::sizeVarByteNumber(sizePayload) + sizePayload;
-    IMessagePtr message = std::make_shared<ProtocolMessage>(0);
+    IMessagePtr message = ProtocolMessagePool::createMessage(0);
     char* buffer = message->addSendHeader(sizeMessage);
     Mqtt5Serialization serialization(buffer, sizeMessage, 0);
     serialization.serializeConnAck(data, sizePayload, sizePropPayload);
@@ -698,7 +682,7 @@ void Mqtt5Protocol::sendPubAck(const IStreamConnectionPtr& connection, Mqtt5Comm
     unsigned int sizePropPayload = 0;
     unsigned int sizePayload = Mqtt5Serialization::sizePubAck(data, sizePropPayload);
     unsigned int sizeMessage = 1 + Mqtt5Serialization::sizeVarByteNumber(sizePayload) + sizePayload;
-    IMessagePtr message = std::make_shared<ProtocolMessage>(0);
+    IMessagePtr message = ProtocolMessagePool::createMessage(0);
     char* buffer = message->addSendHeader(sizeMessage);
     Mqtt5Serialization serialization(buffer, sizeMessage, 0);
     serialization.serializePubAck(data, command, sizePayload, sizePropPayload);
@@ -744,7 +728,7 @@ void Mqtt5Protocol::sendSubscribe(const IStreamConnectionPtr& connection, const
     unsigned int sizePropPayload = 0;
     unsigned int sizePayload = Mqtt5Serialization::sizeSubscribe(data, sizePropPayload);
     unsigned int sizeMessage = 1u + Mqtt5Serialization::sizeVarByteNumber(sizePayload) + sizePayload;
-    IMessagePtr message = std::make_shared<ProtocolMessage>(0);
+    IMessagePtr message = ProtocolMessagePool::createMessage(0);
     char* buffer = message->addSendHeader(sizeMessage);
     Mqtt5Serialization serialization(buffer, sizeMessage, 0);
     std::uint8_t* bufferPacketId = nullptr;
@@ -763,7 +747,7 @@ void Mqtt5Protocol::sendSubAck(const IStreamConnectionPtr& connection, Mqtt5Comm
     unsigned int sizePropPayload = 0;
     unsigned int sizePayload = Mqtt5Serialization::sizeSubAck(data, sizePropPayload);
     unsigned int sizeMessage = 1u + Mqtt5Serialization::sizeVarByteNumber(sizePayload) + sizePayload;
-    IMessagePtr message = std::make_shared<ProtocolMessage>(0);
+    IMessagePtr message = ProtocolMessagePool::createMessage(0);
     char* buffer = message->addSendHeader(sizeMessage);
     Mqtt5Serialization serialization(buffer, sizeMessage, 0);
     serialization.serializeSubAck(data, command, sizePayload, sizePropPayload);
@@ -784,7 +768,7 @@ void Mqtt5Protocol::sendUnsubscribe(const IStreamConnectionPtr& connection, cons
     unsigned int sizePropPayload = 0;
     unsigned int sizePayload = Mqtt5Serialization::sizeUnsubscribe(data, sizePropPayload);
     unsigned int sizeMessage = 1u + Mqtt5Serialization::sizeVarByteNumber(sizePayload) + sizePayload;
-    IMessagePtr message = std::make_shared<ProtocolMessage>(0);
+    IMessagePtr message = ProtocolMessagePool::createMessage(0);
     char* buffer = message->addSendHeader(sizeMessage);
     Mqtt5Serialization serialization(buffer, sizeMessage, 0);
     std::uint8_t* bufferPacketId = nullptr;
@@ -806,7 +790,7 @@ void Mqtt5Protocol::sendUnsubAck(const IStreamConnectionPtr& connection, const M
 void Mqtt5Protocol::sendPingReq(const IStreamConnectionPtr& connection)
 {
     constexpr int sizeMessage = 1 + Mqtt5Serialization::sizeVarByteNumber(0);
-    IMessagePtr message = std::make_shared<ProtocolMessage>(0);
+    IMessagePtr message = ProtocolMessagePool::createMessage(0);
     char* buffer = message->addSendHeader(sizeMessage);
     Mqtt5Serialization serialization(buffer, sizeMessage, 0);
     serialization.serializePingReq();
@@ -820,7 +804,7 @@ void Mqtt5Protocol::sendPingReq(const IStreamConnectionPtr& connection)
 void Mqtt5Protocol::sendPingResp(const IStreamConnectionPtr& connection)
 {
     int sizeMessage = 1 + Mqtt5Serialization::sizeVarByteNumber(0);
-    IMessagePtr message = std::make_shared<ProtocolMessage>(0);
+    IMessagePtr message = ProtocolMessagePool::createMessage(0);
     char* buffer = message->addSendHeader(sizeMessage);
     Mqtt5Serialization serialization(buffer, sizeMessage, 0);
     serialization.serializePingResp();
@@ -836,7 +820,7 @@ void Mqtt5Protocol::sendDisconnect(const IStreamConnectionPtr& connection, const
     unsigned int sizePropPayload = 0;
     unsigned int sizePayload = Mqtt5Serialization::sizeDisconnect(data, sizePropPayload);
     unsigned sizeMessage = 1u + Mqtt5Serialization::sizeVarByteNumber(sizePayload) + sizePayload;
-    IMessagePtr message = std::make_shared<ProtocolMessage>(0);
+    IMessagePtr message = ProtocolMessagePool::createMessage(0);
     char* buffer = message->addSendHeader(sizeMessage);
     Mqtt5Serialization serialization(buffer, sizeMessage, 0);
     serialization.serializeDisconnect(data, sizePayload, sizePropPayload);
@@ -852,7 +836,7 @@ void Mqtt5Protocol::sendAuth(const IStreamConnectionPtr& connection, const Mqtt5
     unsigned int sizePropPayload = 0;
     unsigned int sizePayload = Mqtt5Serialization::sizeAuth(data, sizePropPayload);
     unsigned int sizeMessage = 1u + Mqtt5Serialization::sizeVarByteNumber(sizePayload) + sizePayload;
-    IMessagePtr message = std::make_shared<ProtocolMessage>(0);
+    IMessagePtr message = ProtocolMessagePool::createMessage(0);
     char* buffer = message->addSendHeader(sizeMessage);
     Mqtt5Serialization serialization(buffer, sizeMessage, 0);
     serialization.serializeAuth(data, sizePayload, sizePropPayload);
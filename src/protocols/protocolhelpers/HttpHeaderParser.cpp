@@ -0,0 +1,137 @@
+//MIT License
+
+//Copyright (c) 2020 bexoft GmbH (mail@bexoft.de)
+
+//Permission is hereby granted, free of charge, to any person obtaining a copy
+//of this software and associated documentation files (the "Software"), to deal
+//in the Software without restriction, including without limitation the rights
+//to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//copies of the Software, and to permit persons to whom the Software is
+//furnished to do so, subject to the following conditions:
+
+//The above copyright notice and this permission notice shall be included in all
+//copies or substantial portions of the Software.
+
+//THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//SOFTWARE.
+
+
+#include "finalmq/protocols/protocolhelpers/HttpHeaderParser.h"
+
+#include <charconv>
+#include <string.h>
+
+namespace finalmq
+{
+ssize_t HttpHeaderParser::findEndOfLine(const char* buffer, ssize_t indexBegin, ssize_t indexEnd)
+{
+    if (indexBegin >= indexEnd)
+    {
+        return -1;
+    }
+    const char* pos = static_cast<const char*>(memchr(buffer + indexBegin, '\n', indexEnd - indexBegin));
+    if (pos == nullptr)
+    {
+        return -1;
+    }
+    return pos - buffer;
+}
+
+bool HttpHeaderParser::splitStartLine(std::string_view line, std::string_view& first, std::string_view& second, std::string_view& rest)
+{
+    const size_t posFirst = line.find(' ');
+    if (posFirst == std::string_view::npos)
+    {
+        return false;
+    }
+    first = line.substr(0, posFirst);
+    const size_t posSecond = line.find(' ', posFirst + 1);
+    if (posSecond == std::string_view::npos)
+    {
+        second = line.substr(posFirst + 1);
+        rest = {};
+    }
+    else
+    {
+        second = line.substr(posFirst + 1, posSecond - posFirst - 1);
+        rest = line.substr(posSecond + 1);
+    }
+    return (!first.empty() && !second.empty());
+}
+
+void HttpHeaderParser::splitHeaderLine(std::string_view line, std::string_view& name, std::string_view& value)
+{
+    const size_t pos = line.find(':');
+    if (pos == std::string_view::npos)
+    {
+        name = line;
+        value = {};
+        return;
+    }
+    name = line.substr(0, pos);
+    value = line.substr(pos + 1);
+    while (!value.empty() && (value.front() == ' ' || value.front() == '\t'))
+    {
+        value.remove_prefix(1);
+    }
+    while (!value.empty() && (value.back() == ' ' || value.back() == '\t'))
+    {
+        value.remove_suffix(1);
+    }
+}
+
+static int hexToInt(char c)
+{
+    if (c >= '0' && c <= '9')
+    {
+        return c - '0';
+    }
+    if (c >= 'a' && c <= 'f')
+    {
+        return c - 'a' + 10;
+    }
+    if (c >= 'A' && c <= 'F')
+    {
+        return c - 'A' + 10;
+    }
+    return -1;
+}
+
+ssize_t HttpHeaderParser::parseContentLength(std::string_view value)
+{
+    ssize_t length = 0;
+    const std::from_chars_result result = std::from_chars(value.data(), value.data() + value.size(), length);
+    if (result.ec != std::errc() || length < 0)
+    {
+        return 0;
+    }
+    return length;
+}
+
+void HttpHeaderParser::decode(std::string& dest, std::string_view src)
+{
+    dest.reserve(dest.size() + src.size());
+    for (size_t i = 0; i < src.size(); ++i)
+    {
+        const char c = src[i];
+        if (c == '%' && i + 2 < src.size())
+        {
+            const int high = hexToInt(src[i + 1]);
+            const int low = hexToInt(src[i + 2]);
+            if (high >= 0 && low >= 0)
+            {
+                dest += static_cast<char>((high << 4) | low);
+                i += 2;
+                continue;
+            }
+        }
+        dest += c;
+    }
+}
+
+} // namespace finalmq
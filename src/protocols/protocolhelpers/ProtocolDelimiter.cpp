@@ -22,7 +22,11 @@
 
 #include "finalmq/protocols/protocolhelpers/ProtocolDelimiter.h"
 
+#include <algorithm>
+#include <string.h>
+
 #include "finalmq/protocolsession/ProtocolMessage.h"
+#include "finalmq/protocolsession/ProtocolMessagePool.h"
 #include "finalmq/streamconnection/Socket.h"
 
 namespace finalmq
@@ -120,7 +124,7 @@ IProtocol::FuncCreateMessage ProtocolDelimiter::getMessageFactory() const
     size_t sizeDelimiter = m_delimiter.size();
     int protocolId = getProtocolId();
     return [protocolId, sizeDelimiter]() {
-        return std::make_shared<ProtocolMessage>(protocolId, 0, sizeDelimiter);
+        return ProtocolMessagePool::createMessage(protocolId, 0, sizeDelimiter);
     };
 }
 
@@ -149,108 +153,79 @@ void ProtocolDelimiter::moveOldProtocolState(IProtocol& /*protocolOld*/)
 {
 }
 
-bool ProtocolDelimiter::received(const IStreamConnectionPtr& /*connection*/, const SocketPtr& socket, int bytesToRead)
+ssize_t ProtocolDelimiter::findDelimiter(const char* buffer, ssize_t indexBegin, ssize_t indexEnd) const
+{
+    const ssize_t sizeDelimiter = static_cast<ssize_t>(m_delimiter.size());
+    const char* pos = buffer + indexBegin;
+    const char* posLast = buffer + indexEnd - sizeDelimiter; // last position where a complete delimiter fits
+    while (pos <= posLast)
+    {
+        pos = static_cast<const char*>(memchr(pos, m_delimiterStart, posLast - pos + 1));
+        if (pos == nullptr)
+        {
+            break;
+        }
+        if (sizeDelimiter == 1 || memcmp(pos + 1, m_delimiter.data() + 1, sizeDelimiter - 1) == 0)
+        {
+            return pos - buffer;
+        }
+        ++pos;
+    }
+    return -1;
+}
+
+void ProtocolDelimiter::prepareReceiveBuffer(ssize_t bytesToRead)
 {
-    std::shared_ptr<std::string> receiveBufferOld = m_receiveBuffer;
-    ssize_t sizeDelimiterPrefix = 0;
-    ssize_t indexStart = 0;
-    if (receiveBufferOld != nullptr)
+    if (m_receiveBuffer && static_cast<ssize_t>(m_receiveBuffer->size()) - m_bufferSize >= bytesToRead)
     {
-        indexStart = m_indexStartMessage;
-        ssize_t indexEnd = m_bufferSize;
-        sizeDelimiterPrefix = indexEnd - indexStart;
-        m_indexStartMessage = 0;
+        return;
     }
 
-    m_receiveBuffer = std::make_shared<std::string>();
-    m_receiveBuffer->resize(sizeDelimiterPrefix + bytesToRead);
-    if (sizeDelimiterPrefix > 0)
+    const ssize_t sizeUnfinished = m_bufferSize - m_indexStartMessage;
+    if (m_receiveBuffer && m_receiveBuffer.use_count() == 1 && static_cast<ssize_t>(m_receiveBuffer->size()) >= sizeUnfinished + bytesToRead)
     {
-        memcpy(m_receiveBuffer->data(), receiveBufferOld->data() + indexStart, sizeDelimiterPrefix);
+        // no received message references the slab anymore, reuse it.
+        memmove(m_receiveBuffer->data(), m_receiveBuffer->data() + m_indexStartMessage, sizeUnfinished);
     }
-    int res = socket->receive(m_receiveBuffer->data() + sizeDelimiterPrefix, bytesToRead);
-    if (res > 0)
+    else
     {
-        auto callback = m_callback.lock();
-        const char* buffer = m_receiveBuffer->data();
-        ssize_t bytesReceived = res;
-        m_bufferSize = sizeDelimiterPrefix + bytesReceived;
-        ssize_t offsetEnd = m_bufferSize - (m_delimiter.size() - 1);
-        assert(bytesReceived <= bytesToRead);
-        for (ssize_t i = m_indexStartMessage; i < offsetEnd; ++i)
+        // the size grows with the unfinished message, so that a big message is moved only a few times.
+        std::shared_ptr<std::string> receiveBuffer = std::make_shared<std::string>();
+        receiveBuffer->resize(std::max(RECEIVE_SLAB_SIZE, 2 * (sizeUnfinished + bytesToRead)));
+        if (sizeUnfinished > 0)
         {
-            const char c = buffer[i];
-            if (c == m_delimiterStart)
-            {
-                bool match = true;
-                for (ssize_t j = 1; j < static_cast<ssize_t>(m_delimiter.size()); ++j)
-                {
-                    if (buffer[i + j] != m_delimiter[j])
-                    {
-                        match = false;
-                        break;
-                    }
-                }
-                if (match)
-                {
-                    IMessagePtr message = std::make_shared<ProtocolMessage>(0);
-                    if (m_receiveBuffers.empty())
-                    {
-                        ssize_t size = i - m_indexStartMessage;
-                        assert(size >= 0);
-                        message->setReceiveBuffer(m_receiveBuffer, m_indexStartMessage, size);
-                    }
-                    else
-                    {
-                        assert(m_indexStartMessage == 0);
-                        ssize_t sizeLast = i - m_indexStartMessage;
-                        assert(sizeLast >= 0);
-                        m_receiveBuffersTotal += sizeLast;
-                        assert(m_receiveBuffersTotal >= 0);
-                        std::shared_ptr<std::string> receiveBufferHelper = std::make_shared<std::string>();
-                        receiveBufferHelper->resize(m_receiveBuffersTotal);
-                        ssize_t offset = 0;
-                        for (size_t n = 0; n < m_receiveBuffers.size(); ++n)
-                        {
-                            const auto& receiveBufferStore = m_receiveBuffers[n];
-                            ssize_t sizeCopy = receiveBufferStore.indexEndMessage - receiveBufferStore.indexStartMessage;
-                            memcpy(receiveBufferHelper->data() + offset,
-                                   receiveBufferStore.receiveBuffer->data() + receiveBufferStore.indexStartMessage,
-                                   sizeCopy);
-                            offset += sizeCopy;
-                        }
-                        memcpy(receiveBufferHelper->data() + offset, m_receiveBuffer->data(), sizeLast);
-                        message->setReceiveBuffer(receiveBufferHelper, 0, m_receiveBuffersTotal);
-                        m_receiveBuffersTotal = 0;
-                        m_receiveBuffers.clear();
-                    }
-                    if (callback)
-                    {
-                        callback->received(message);
-                    }
-                    i += m_delimiter.size();
-                    m_indexStartMessage = i;
-                    --i;
-                }
-            }
+            memcpy(receiveBuffer->data(), m_receiveBuffer->data() + m_indexStartMessage, sizeUnfinished);
         }
-        if (m_indexStartMessage == m_bufferSize)
-        {
-            m_receiveBuffer = nullptr;
-            m_bufferSize = 0;
-            m_indexStartMessage = 0;
-        }
-        else
+        m_receiveBuffer = std::move(receiveBuffer);
+    }
+    m_indexSearch -= m_indexStartMessage;
+    m_indexStartMessage = 0;
+    m_bufferSize = sizeUnfinished;
+}
+
+bool ProtocolDelimiter::received(const IStreamConnectionPtr& /*connection*/, const char* buffer, int size)
+{
+    prepareReceiveBuffer(size);
+    memcpy(m_receiveBuffer->data() + m_bufferSize, buffer, size);
+    m_bufferSize += size;
+    auto callback = m_callback.lock();
+    const char* receiveBuffer = m_receiveBuffer->data();
+    const ssize_t sizeDelimiter = static_cast<ssize_t>(m_delimiter.size());
+    ssize_t indexDelimiter;
+    while ((indexDelimiter = findDelimiter(receiveBuffer, m_indexSearch, m_bufferSize)) >= 0)
+    {
+        IMessagePtr message = ProtocolMessagePool::createMessage(0);
+        message->setReceiveBuffer(m_receiveBuffer, m_indexStartMessage, indexDelimiter - m_indexStartMessage);
+        if (callback)
         {
-            if (m_indexStartMessage < offsetEnd)
-            {
-                m_receiveBuffers.emplace_back(ReceiveBufferStore{m_receiveBuffer, m_indexStartMessage, offsetEnd});
-                m_receiveBuffersTotal += offsetEnd - m_indexStartMessage;
-                m_indexStartMessage = offsetEnd;
-            }
+            callback->received(message);
         }
+        m_indexStartMessage = indexDelimiter + sizeDelimiter;
+        m_indexSearch = m_indexStartMessage;
     }
-    return (res > 0);
+    // a delimiter can begin inside the last bytes, so these bytes are searched again with the next data
+    m_indexSearch = std::max(m_indexSearch, m_bufferSize - (sizeDelimiter - 1));
+    return true;
 }
 
 hybrid_ptr<IStreamConnectionCallback> ProtocolDelimiter::connected(const IStreamConnectionPtr& /*connection*/)
@@ -272,6 +247,15 @@ void ProtocolDelimiter::disconnected(const IStreamConnectionPtr& /*connection*/)
     }
 }
 
+void ProtocolDelimiter::writable(const IStreamConnectionPtr& /*connection*/)
+{
+    auto callback = m_callback.lock();
+    if (callback)
+    {
+        callback->writable();
+    }
+}
+
 IMessagePtr ProtocolDelimiter::pollReply(std::deque<IMessagePtr>&& /*messages*/)
 {
     return {};
@@ -24,6 +24,7 @@
 #include "finalmq/protocols/protocolhelpers/ProtocolFixHeaderHelper.h"
 #include "finalmq/streamconnection/Socket.h"
 #include "finalmq/protocolsession/ProtocolMessage.h"
+#include "finalmq/protocolsession/ProtocolMessagePool.h"
 
 namespace finalmq {
 
@@ -36,19 +37,18 @@ ProtocolFixHeaderHelper::ProtocolFixHeaderHelper(int sizeHeader, std::function<i
 
 
 
-bool ProtocolFixHeaderHelper::receive(const SocketPtr& socket, int bytesToRead, std::deque<IMessagePtr>& messages)
+void ProtocolFixHeaderHelper::receive(const char* buffer, int size, std::deque<IMessagePtr>& messages)
 {
     m_messages = &messages;
-    bool ok = true;
-    while (bytesToRead > 0 && ok)
+    while (size > 0)
     {
         switch (m_state)
         {
         case State::WAITFORHEADER:
-            ok = receiveHeader(socket, bytesToRead);
+            receiveHeader(buffer, size);
             break;
         case State::WAITFORPAYLOAD:
-            ok = receivePayload(socket, bytesToRead);
+            receivePayload(buffer, size);
             break;
         default:
             assert(false);
@@ -56,44 +56,31 @@ bool ProtocolFixHeaderHelper::receive(const SocketPtr& socket, int bytesToRead,
         }
     }
     m_messages = nullptr;
-
-    return ok;
 }
 
 
-bool ProtocolFixHeaderHelper::receiveHeader(const SocketPtr& socket, int& bytesToRead)
+void ProtocolFixHeaderHelper::receiveHeader(const char*& buffer, int& size)
 {
     assert(m_state == State::WAITFORHEADER);
     assert(m_sizeCurrent < static_cast<ssize_t>(m_header.size()));
-    bool ret = false;
 
     ssize_t sizeRead = m_header.size() - m_sizeCurrent;
-    if (bytesToRead < sizeRead)
+    if (size < sizeRead)
     {
-        sizeRead = bytesToRead;
+        sizeRead = size;
     }
-    int res = socket->receive(m_header.data() + m_sizeCurrent, static_cast<int>(sizeRead));
-    if (res > 0)
+    memcpy(m_header.data() + m_sizeCurrent, buffer, sizeRead);
+    buffer += sizeRead;
+    size -= static_cast<int>(sizeRead);
+    m_sizeCurrent += sizeRead;
+    assert(m_sizeCurrent <= static_cast<ssize_t>(m_header.size()));
+    if (m_sizeCurrent == static_cast<ssize_t>(m_header.size()))
     {
-        int bytesReceived = res;
-        assert(bytesReceived <= sizeRead);
-        bytesToRead -= bytesReceived;
-        assert(bytesToRead >= 0);
-        m_sizeCurrent += bytesReceived;
-        assert(m_sizeCurrent <= static_cast<ssize_t>(m_header.size()));
-        if (m_sizeCurrent == static_cast<ssize_t>(m_header.size()))
-        {
-            m_sizeCurrent = 0;
-            assert(m_funcGetPayloadSize);
-            int sizePayload = m_funcGetPayloadSize(m_header);
-            setPayloadSize(sizePayload);
-        }
-        if (bytesReceived == sizeRead)
-        {
-            ret = true;
-        }
+        m_sizeCurrent = 0;
+        assert(m_funcGetPayloadSize);
+        int sizePayload = m_funcGetPayloadSize(m_header);
+        setPayloadSize(sizePayload);
     }
-    return ret;
 }
 
 
@@ -102,7 +89,7 @@ void ProtocolFixHeaderHelper::setPayloadSize(int sizePayload)
     assert(m_state == State::WAITFORHEADER);
     assert(sizePayload >= 0);
     m_sizePayload = sizePayload;
-    m_message = std::make_shared<ProtocolMessage>(0, m_header.size());
+    m_message = ProtocolMessagePool::createMessage(0, m_header.size());
     m_buffer = m_message->resizeReceiveBuffer(m_header.size() + sizePayload);
     memcpy(m_buffer, m_header.data(), m_header.size());
     if (sizePayload != 0)
@@ -116,37 +103,26 @@ void ProtocolFixHeaderHelper::setPayloadSize(int sizePayload)
 }
 
 
-bool ProtocolFixHeaderHelper::receivePayload(const SocketPtr& socket, int& bytesToRead)
+void ProtocolFixHeaderHelper::receivePayload(const char*& buffer, int& size)
 {
     assert(m_state == State::WAITFORPAYLOAD);
     assert(m_sizeCurrent < m_sizePayload);
-    bool ret = false;
 
     ssize_t sizeRead = m_sizePayload - m_sizeCurrent;
-    if (bytesToRead < sizeRead)
+    if (size < sizeRead)
     {
-        sizeRead = bytesToRead;
+        sizeRead = size;
     }
-    int res = socket->receive(m_buffer + m_header.size() + m_sizeCurrent, static_cast<int>(sizeRead));
-    if (res > 0)
+    memcpy(m_buffer + m_header.size() + m_sizeCurrent, buffer, sizeRead);
+    buffer += sizeRead;
+    size -= static_cast<int>(sizeRead);
+    m_sizeCurrent += sizeRead;
+    assert(m_sizeCurrent <= m_sizePayload);
+    if (m_sizeCurrent == m_sizePayload)
     {
-        int bytesReceived = res;
-        assert(bytesReceived <= sizeRead);
-        bytesToRead -= bytesReceived;
-        assert(bytesToRead >= 0);
-        m_sizeCurrent += bytesReceived;
-        assert(m_sizeCurrent <= m_sizePayload);
-        if (m_sizeCurrent == m_sizePayload)
-        {
-            m_sizeCurrent = 0;
-            handlePayloadReceived();
-        }
-        if (bytesReceived == sizeRead)
-        {
-            ret = true;
-        }
+        m_sizeCurrent = 0;
+        handlePayloadReceived();
     }
-    return ret;
 }
 
 
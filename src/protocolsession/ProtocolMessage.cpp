@@ -22,6 +22,8 @@
 
 #include "finalmq/protocolsession/ProtocolMessage.h"
 
+#include <algorithm>
+
 namespace finalmq
 {
 //---------------------------------------
@@ -36,6 +38,80 @@ ProtocolMessage::ProtocolMessage(std::uint32_t protocolId, ssize_t sizeHeader, s
     m_itSendBufferRefsPayloadBegin = m_sendBufferRefs.end();
 }
 
+template<class T>
+T& ProtocolMessage::insertNode(std::list<T>& list, typename std::list<T>::iterator pos, std::list<T>& spare)
+{
+    if (!spare.empty())
+    {
+        auto it = spare.begin();
+        list.splice(pos, spare, it);
+        return *it;
+    }
+    return *list.emplace(pos);
+}
+
+void ProtocolMessage::clear()
+{
+    m_metainfo.clear();
+    m_controlData = Variant();
+    m_echoData = Variant();
+    m_messages.clear();
+
+    auto keepBuffers = [this](std::list<std::string>& buffers) {
+        while (!buffers.empty())
+        {
+            if (m_spareBuffers.size() < MAX_SPARE_BUFFERS && buffers.front().capacity() <= MAX_RECYCLED_BUFFER_SIZE)
+            {
+                m_spareBuffers.splice(m_spareBuffers.end(), buffers, buffers.begin());
+            }
+            else
+            {
+                buffers.pop_front();
+            }
+        }
+    };
+    keepBuffers(m_headerBuffers);
+    keepBuffers(m_payloadBuffers);
+
+    auto keepRefs = [this](std::list<BufferRef>& refs) {
+        size_t count = 0;
+        if (m_spareRefs.size() < MAX_SPARE_REFS)
+        {
+            count = std::min(refs.size(), MAX_SPARE_REFS - m_spareRefs.size());
+        }
+        auto itEnd = refs.begin();
+        std::advance(itEnd, count);
+        m_spareRefs.splice(m_spareRefs.end(), refs, refs.begin(), itEnd);
+        refs.clear();
+    };
+    keepRefs(m_sendBufferRefs);
+    keepRefs(m_sendPayloadRefs);
+
+    m_itSendBufferRefsPayloadBegin = m_sendBufferRefs.end();
+    m_offset = -1;
+    m_sizeLastBlock = 0;
+    m_sizeSendBufferTotal = 0;
+    m_sizeSendPayloadTotal = 0;
+    m_sharedPayloads.clear();
+    m_sendFile = nullptr;
+
+    // the receive buffer can only be reused, if nobody else references it
+    if (m_receiveBuffer && (m_receiveBuffer.use_count() != 1 || m_receiveBuffer->capacity() > MAX_RECYCLED_BUFFER_SIZE))
+    {
+        m_receiveBuffer = nullptr;
+    }
+    m_receiveBufferRef = {m_receiveBuffer ? m_receiveBuffer->data() : nullptr, 0};
+
+    m_preparedToSend = false;
+}
+
+void ProtocolMessage::reinit(std::uint32_t protocolId, ssize_t sizeHeader, ssize_t sizeTrailer)
+{
+    m_protocolId = protocolId;
+    m_sizeHeader = sizeHeader;
+    m_sizeTrailer = sizeTrailer;
+}
+
 char* ProtocolMessage::addBuffer(ssize_t size, ssize_t reserve)
 {
     assert(!m_preparedToSend);
@@ -95,10 +171,11 @@ char* ProtocolMessage::addBuffer(ssize_t size, ssize_t reserve)
     m_sizeSendBufferTotal += reserve;
     m_sizeSendPayloadTotal += reserve;
     ssize_t sizeBuffer = sizeHeader + reserve + m_sizeTrailer;
-    m_payloadBuffers.resize(m_payloadBuffers.size() + 1);
-    m_payloadBuffers.back().resize(sizeBuffer);
-    m_sendBufferRefs.push_back({m_payloadBuffers.back().data(), sizeBuffer});
-    m_sendPayloadRefs.push_back({m_payloadBuffers.back().data() + sizeHeader, reserve});
+    std::string& buffer = insertNode(m_payloadBuffers, m_payloadBuffers.end(), m_spareBuffers);
+    buffer.clear();
+    buffer.resize(sizeBuffer);
+    insertNode(m_sendBufferRefs, m_sendBufferRefs.end(), m_spareRefs) = {buffer.data(), sizeBuffer};
+    insertNode(m_sendPayloadRefs, m_sendPayloadRefs.end(), m_spareRefs) = {buffer.data() + sizeHeader, reserve};
     if (size < reserve)
     {
         downsizeLastBuffer(size);
@@ -118,7 +195,7 @@ void ProtocolMessage::downsizeLastBuffer(ssize_t newSize)
     assert(newSize <= m_sizeLastBlock);
     assert(m_offset != -1 || newSize == 0);
     assert(!m_payloadBuffers.empty());
-    assert(m_sendBufferRefs.size() == m_payloadBuffers.size() + m_headerBuffers.size());
+    assert(m_sendBufferRefs.size() == m_payloadBuffers.size() + m_headerBuffers.size() + m_sharedPayloads.size());
 
     ssize_t diff = m_sizeLastBlock - newSize;
     assert(diff >= 0);
@@ -270,6 +347,49 @@ void ProtocolMessage::downsizeLastSendPayload(ssize_t newSize)
     downsizeLastBuffer(newSize);
 }
 
+void ProtocolMessage::addSendPayload(const std::shared_ptr<const std::string>& payload)
+{
+    assert(payload);
+    addSendPayload(payload, 0, static_cast<ssize_t>(payload->size()));
+}
+
+void ProtocolMessage::addSendPayload(const std::shared_ptr<const std::string>& buffer, ssize_t offset, ssize_t size)
+{
+    assert(!m_preparedToSend);
+    assert(buffer);
+    assert(offset >= 0 && offset + size <= static_cast<ssize_t>(buffer->size()));
+    if (size <= 0)
+    {
+        return;
+    }
+
+    // the header and the trailer of the protocol are written into own buffers, the shared payload is never modified
+    if (m_payloadBuffers.empty())
+    {
+        addBuffer(0);
+    }
+    // remove the trailer of the last payload, an empty buffer is kept, because it may hold the header
+    BufferRef& lastRef = m_sendBufferRefs.back();
+    assert(lastRef.second >= m_sizeTrailer);
+    lastRef.second -= m_sizeTrailer;
+
+    m_sharedPayloads.push_back(buffer);
+    char* data = const_cast<char*>(buffer->data()) + offset;
+    insertNode(m_sendBufferRefs, m_sendBufferRefs.end(), m_spareRefs) = {data, size};
+    insertNode(m_sendPayloadRefs, m_sendPayloadRefs.end(), m_spareRefs) = {data, size};
+    m_sizeSendBufferTotal += size;
+    m_sizeSendPayloadTotal += size;
+
+    // the trailer follows the shared payload in an own buffer
+    std::string& bufferTrailer = insertNode(m_payloadBuffers, m_payloadBuffers.end(), m_spareBuffers);
+    bufferTrailer.clear();
+    bufferTrailer.resize(m_sizeTrailer);
+    insertNode(m_sendBufferRefs, m_sendBufferRefs.end(), m_spareRefs) = {bufferTrailer.data(), m_sizeTrailer};
+    insertNode(m_sendPayloadRefs, m_sendPayloadRefs.end(), m_spareRefs) = {bufferTrailer.data(), 0};
+    m_offset = 0;
+    m_sizeLastBlock = 0;
+}
+
 // for receive
 BufferRef ProtocolMessage::getReceiveHeader() const
 {
@@ -281,6 +401,11 @@ BufferRef ProtocolMessage::getReceivePayload() const
     return {m_receiveBufferRef.first + m_sizeHeader, m_receiveBufferRef.second - m_sizeHeader};
 }
 
+std::shared_ptr<const std::string> ProtocolMessage::getReceiveBuffer() const
+{
+    return m_receiveBuffer;
+}
+
 char* ProtocolMessage::resizeReceiveBuffer(ssize_t size)
 {
     if (size < 0)
@@ -372,17 +497,18 @@ char* ProtocolMessage::addSendHeader(ssize_t size)
     {
         m_itSendBufferRefsPayloadBegin = m_sendBufferRefs.begin();
     }
-    m_headerBuffers.resize(m_headerBuffers.size() + 1);
-    m_headerBuffers.back().resize(size);
-    m_sendBufferRefs.insert(m_itSendBufferRefsPayloadBegin, {m_headerBuffers.back().data(), m_headerBuffers.back().size()});
+    std::string& header = insertNode(m_headerBuffers, m_headerBuffers.end(), m_spareBuffers);
+    header.clear();
+    header.resize(size);
+    insertNode(m_sendBufferRefs, m_itSendBufferRefsPayloadBegin, m_spareRefs) = {header.data(), size};
     m_sizeSendBufferTotal += size;
-    return m_headerBuffers.back().data();
+    return header.data();
 }
 void ProtocolMessage::downsizeLastSendHeader(ssize_t newSize)
 {
     assert(!m_preparedToSend);
     assert(!m_headerBuffers.empty());
-    assert(m_sendBufferRefs.size() == m_payloadBuffers.size() + m_headerBuffers.size());
+    assert(m_sendBufferRefs.size() == m_payloadBuffers.size() + m_headerBuffers.size() + m_sharedPayloads.size());
     auto itSendBufferRefs = m_itSendBufferRefsPayloadBegin;
     assert(itSendBufferRefs != m_sendBufferRefs.begin());
     --itSendBufferRefs;
@@ -397,6 +523,16 @@ void ProtocolMessage::downsizeLastSendHeader(ssize_t newSize)
     }
 }
 
+void ProtocolMessage::setSendFile(const FileRegionPtr& file)
+{
+    m_sendFile = file;
+}
+
+const FileRegionPtr& ProtocolMessage::getSendFile() const
+{
+    return m_sendFile;
+}
+
 // for the protocol to prepare the message for send
 void ProtocolMessage::prepareMessageToSend()
 {
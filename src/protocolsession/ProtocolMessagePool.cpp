@@ -0,0 +1,214 @@
+//MIT License
+
+//Copyright (c) 2020 bexoft GmbH (mail@bexoft.de)
+
+//Permission is hereby granted, free of charge, to any person obtaining a copy
+//of this software and associated documentation files (the "Software"), to deal
+//in the Software without restriction, including without limitation the rights
+//to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//copies of the Software, and to permit persons to whom the Software is
+//furnished to do so, subject to the following conditions:
+
+//The above copyright notice and this permission notice shall be included in all
+//copies or substantial portions of the Software.
+
+//THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//SOFTWARE.
+
+
+#include "finalmq/protocolsession/ProtocolMessagePool.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <mutex>
+#include <vector>
+
+#include "finalmq/protocolsession/ProtocolMessage.h"
+
+namespace finalmq
+{
+namespace
+{
+    static const size_t CONTROL_BLOCK_SIZE = 64;
+    static const size_t THREAD_CACHE_SIZE = 64;
+    static const size_t BATCH_SIZE = 32;
+    static const size_t MAX_DEPOT_SIZE = 1024;
+
+    struct Slot
+    {
+        Slot()
+            : message(0)
+        {
+        }
+        ProtocolMessage message;
+        alignas(std::max_align_t) unsigned char controlBlock[CONTROL_BLOCK_SIZE];
+    };
+
+    struct Depot
+    {
+        std::mutex mutex{};
+        std::vector<Slot*> slots{};
+    };
+
+    Depot& getDepot()
+    {
+        // never destroyed, messages can be released during the destruction of static objects
+        static Depot* depot = new Depot();
+        return *depot;
+    }
+
+    std::atomic<std::uint64_t> g_hits{0};
+    std::atomic<std::uint64_t> g_misses{0};
+
+    thread_local bool t_cacheDestroyed = false;
+
+    struct ThreadCache
+    {
+        ~ThreadCache()
+        {
+            t_cacheDestroyed = true;
+            for (Slot* slot : slots)
+            {
+                delete slot;
+            }
+        }
+        std::vector<Slot*> slots{};
+    };
+    thread_local ThreadCache t_cache{};
+
+    Slot* takeSlot()
+    {
+        if (!t_cacheDestroyed)
+        {
+            std::vector<Slot*>& slots = t_cache.slots;
+            if (slots.empty())
+            {
+                Depot& depot = getDepot();
+                std::unique_lock<std::mutex> lock(depot.mutex);
+                size_t count = std::min(BATCH_SIZE, depot.slots.size());
+                slots.insert(slots.end(), depot.slots.end() - count, depot.slots.end());
+                depot.slots.resize(depot.slots.size() - count);
+            }
+            if (!slots.empty())
+            {
+                Slot* slot = slots.back();
+                slots.pop_back();
+                g_hits.fetch_add(1, std::memory_order_relaxed);
+                return slot;
+            }
+        }
+        g_misses.fetch_add(1, std::memory_order_relaxed);
+        return new Slot();
+    }
+
+    void releaseSlot(Slot* slot)
+    {
+        if (t_cacheDestroyed)
+        {
+            delete slot;
+            return;
+        }
+        std::vector<Slot*>& slots = t_cache.slots;
+        if (slots.size() >= THREAD_CACHE_SIZE)
+        {
+            // move a batch to the depot, so that other threads can use the messages
+            Depot& depot = getDepot();
+            std::unique_lock<std::mutex> lock(depot.mutex);
+            size_t count = std::min(BATCH_SIZE, MAX_DEPOT_SIZE - std::min(MAX_DEPOT_SIZE, depot.slots.size()));
+            depot.slots.insert(depot.slots.end(), slots.end() - count, slots.end());
+            lock.unlock();
+            slots.resize(slots.size() - count);
+            if (slots.size() >= THREAD_CACHE_SIZE)
+            {
+                delete slot;
+                return;
+            }
+        }
+        slots.push_back(slot);
+    }
+
+    // The allocator places the shared_ptr control block into the slot of the message.
+    // The control block is deallocated after the last weak reference is gone, then the slot can be reused.
+    template<class T>
+    struct SlotAllocator
+    {
+        typedef T value_type;
+
+        explicit SlotAllocator(Slot* s)
+            : slot(s)
+        {
+        }
+        template<class U>
+        SlotAllocator(const SlotAllocator<U>& rhs)
+            : slot(rhs.slot)
+        {
+        }
+        T* allocate(size_t n)
+        {
+            static_assert(sizeof(T) <= CONTROL_BLOCK_SIZE, "control block does not fit into slot");
+            static_assert(alignof(T) <= alignof(std::max_align_t), "control block alignment");
+            assert(n == 1);
+            (void)n;
+            return reinterpret_cast<T*>(slot->controlBlock);
+        }
+        void deallocate(T* /*p*/, size_t /*n*/)
+        {
+            releaseSlot(slot);
+        }
+        template<class U>
+        bool operator==(const SlotAllocator<U>& rhs) const
+        {
+            return slot == rhs.slot;
+        }
+        template<class U>
+        bool operator!=(const SlotAllocator<U>& rhs) const
+        {
+            return slot != rhs.slot;
+        }
+
+        Slot* slot;
+    };
+} // namespace
+
+struct ProtocolMessagePool::MessageRecycler
+{
+    void operator()(ProtocolMessage* message) const
+    {
+        // release the references now, the slot is returned when the control block is deallocated
+        ProtocolMessagePool::recycle(message);
+    }
+};
+
+IMessagePtr ProtocolMessagePool::createMessage(std::uint32_t protocolId, ssize_t sizeHeader, ssize_t sizeTrailer)
+{
+    Slot* slot = takeSlot();
+    slot->message.reinit(protocolId, sizeHeader, sizeTrailer);
+    return std::shared_ptr<ProtocolMessage>(&slot->message, MessageRecycler(), SlotAllocator<ProtocolMessage>(slot));
+}
+
+void ProtocolMessagePool::recycle(ProtocolMessage* message)
+{
+    message->clear();
+}
+
+ProtocolMessagePoolStatistics ProtocolMessagePool::getStatistics()
+{
+    ProtocolMessagePoolStatistics statistics;
+    statistics.hits = g_hits.load(std::memory_order_relaxed);
+    statistics.misses = g_misses.load(std::memory_order_relaxed);
+    return statistics;
+}
+
+void ProtocolMessagePool::resetStatistics()
+{
+    g_hits = 0;
+    g_misses = 0;
+}
+
+} // namespace finalmq
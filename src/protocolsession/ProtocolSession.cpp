@@ -23,8 +23,12 @@
 #include "finalmq/protocolsession/ProtocolSession.h"
 #include "finalmq/streamconnection/StreamConnectionContainer.h"
 #include "finalmq/protocolsession/ProtocolMessage.h"
+#include "finalmq/protocolsession/ProtocolMessagePool.h"
 #include "finalmq/protocolsession/ProtocolRegistry.h"
+#include "finalmq/jsonvariant/VariantToJson.h"
+#include "finalmq/helpers/ZeroCopyBuffer.h"
 
+#include <algorithm>
 #include <assert.h>
 
 
@@ -33,6 +37,10 @@ namespace finalmq {
 constexpr int64_t INSTANCEID_PREFIX = 0x0100000000000000ll;
 constexpr int DEFAULT_MAX_SYNC_REQREP_CONNECTIONS = 6;
 static const std::string PROPERTY_MAX_SYNC_REQREP_CONNECTIONS = "max_sync_reqrep_connections";
+static const std::string PROPERTY_MAX_PIPELINED_REQUESTS = "max_pipelined_requests";
+static const std::string PROPERTY_PREWARM_CONNECTIONS = "prewarm_connections";
+static const std::string PROPERTY_IDLE_TIMEOUT = "idle_timeout";
+static const std::string PROPERTY_CONNECTION_POOL = "connection_pool";
 
 
 const static std::string FMQ_CONNECTION_ID = "fmq_echo_connid";
@@ -51,6 +59,7 @@ ProtocolSession::ProtocolSession(hybrid_ptr<IProtocolSessionCallback> callback,
     , m_bindProperties(bindProperties)
     , m_protocolData(m_bindProperties.protocolData)
     , m_formatData(m_bindProperties.formatData)
+    , m_sendQueueConfig(m_bindProperties.sendQueue)
 {
 }
 
@@ -68,6 +77,7 @@ ProtocolSession::ProtocolSession(hybrid_ptr<IProtocolSessionCallback> callback,
     , m_connectionProperties(connectProperties)
     , m_protocolData(m_connectionProperties.protocolData)
     , m_formatData(m_connectionProperties.formatData)
+    , m_sendQueueConfig(m_connectionProperties.sendQueue)
 {
     m_protocol = protocolFactory->createProtocol(m_connectionProperties.protocolData);
     assert(m_protocol);
@@ -120,6 +130,10 @@ void ProtocolSession::initProtocolValues()
         {
             m_maxSynchReqRepConnections = DEFAULT_MAX_SYNC_REQREP_CONNECTIONS;   // default connections
         }
+        m_maxPipelinedRequests = std::max(m_protocolData.getDataValue<int>(PROPERTY_MAX_PIPELINED_REQUESTS), 1);
+        m_idleTimeout = m_protocolData.getDataValue<int>(PROPERTY_IDLE_TIMEOUT);
+        m_connectionPool = m_protocolData.getDataValue<bool>(PROPERTY_CONNECTION_POOL);
+        m_connectionPoolKey = createConnectionPoolKey();
     }
 
     m_protocolSet.store(true, std::memory_order_release);
@@ -128,6 +142,33 @@ void ProtocolSession::initProtocolValues()
 
 
 
+std::string ProtocolSession::createConnectionPoolKey() const
+{
+    // only sessions with the same protocol, endpoint, TLS settings, protocol data and send queue limits share their connections
+    const CertificateData& certificateData = m_connectionProperties.certificateData;
+    std::string key = std::to_string(m_protocolId) + '|' + m_endpointStreamConnection;
+    if (certificateData.ssl)
+    {
+        key += "|ssl|" + std::to_string(certificateData.verifyMode) + '|' + certificateData.certificateFile + '|' + certificateData.privateKeyFile + '|' + certificateData.caFile + '|' + certificateData.caPath + '|' + certificateData.certificateChainFile + '|' + certificateData.clientCaFile;
+        // verify callbacks cannot be compared, a session with a callback does not share its connections
+        if (certificateData.verifyCallback)
+        {
+            key += "|session|" + std::to_string(m_sessionId);
+        }
+    }
+
+    ZeroCopyBuffer buffer;
+    VariantToJson variantToJson(buffer);
+    variantToJson.parse(m_protocolData);
+    key += '|' + buffer.getData();
+
+    const SendQueueConfig& sendQueue = m_connectionProperties.sendQueue;
+    key += '|' + std::to_string(sendQueue.highWaterMarkBytes) + '|' + std::to_string(sendQueue.lowWaterMarkBytes) + '|' + std::to_string(sendQueue.highWaterMarkMessages) + '|' + std::to_string(sendQueue.lowWaterMarkMessages) + '|' + std::to_string(static_cast<int>(sendQueue.overflowPolicy));
+    return key;
+}
+
+
+
 // IProtocolSessionPrivate
 
 bool ProtocolSession::connect()
@@ -139,12 +180,7 @@ bool ProtocolSession::connect()
         std::unique_lock<std::mutex> lock(m_mutex);
         initProtocolValues();
         m_protocol = nullptr;
-        IProtocolPtr protocol = createRequestConnection();
-        IStreamConnectionPtr connection = protocol->getConnection();
-        if (connection)
-        {
-            m_unallocatedConnections.insert(connection->getConnectionId());
-        }
+        prewarmRequestConnections();
         lock.unlock();
         addSessionToList(true);
         res = true;
@@ -199,7 +235,7 @@ IMessagePtr ProtocolSession::createMessage() const
     {
         return m_messageFactory();
     }
-    return std::make_shared<ProtocolMessage>(0);
+    return ProtocolMessagePool::createMessage(0);
 }
 
 IMessagePtr ProtocolSession::convertMessageToProtocol(const IMessagePtr& msg)
@@ -296,9 +332,11 @@ void ProtocolSession::sendMessage(const IMessagePtr& msg, bool isReply)
                     pollRelease();
                 }
             }
-            else
+            else if (!queueMessage(m_pollMessages, msg))
             {
-                m_pollMessages.push_back(msg);
+                lock.unlock();
+                disconnect();
+                return;
             }
             if (m_pollMaxRequests != -1 && static_cast<ssize_t>(m_pollMessages.size()) >= m_pollMaxRequests)
             {
@@ -310,7 +348,11 @@ void ProtocolSession::sendMessage(const IMessagePtr& msg, bool isReply)
         {
             if (!m_protocolSet.load(std::memory_order_relaxed))  // relaxed, because already locked
             {
-                m_messagesBuffered.push_back(msg);
+                if (!queueMessage(m_messagesBuffered, msg))
+                {
+                    lock.unlock();
+                    disconnect();
+                }
                 return;
             }
 
@@ -327,11 +369,74 @@ void ProtocolSession::sendMessage(const IMessagePtr& msg, bool isReply)
     }
     else
     {
-        m_messagesBuffered.push_back(msg);
+        if (!queueMessage(m_messagesBuffered, msg))
+        {
+            lock.unlock();
+            disconnect();
+            return;
+        }
         sendNextRequests();
     }
 }
 
+bool ProtocolSession::queueMessage(std::deque<IMessagePtr>& messages, const IMessagePtr& message)
+{
+    // m_mutex is already locked
+    // The session queues are only limited by the number of messages, the messages are drained by the
+    // peer (poll request) or by the connect. So, the producer cannot wait for them, OVERFLOW_BLOCK only
+    // marks the session as not writable.
+    const ssize_t highWaterMark = m_sendQueueConfig.highWaterMarkMessages;
+    if (highWaterMark >= 0 && static_cast<ssize_t>(messages.size()) >= highWaterMark)
+    {
+        m_queueBlocked = true;
+        switch (m_sendQueueConfig.overflowPolicy)
+        {
+            case OverflowPolicy::OVERFLOW_DROP_OLDEST:
+                while (!messages.empty() && static_cast<ssize_t>(messages.size()) >= highWaterMark)
+                {
+                    messages.pop_front();
+                    ++m_droppedMessages;
+                }
+                break;
+            case OverflowPolicy::OVERFLOW_DROP_NEWEST:
+                ++m_droppedMessages;
+                return true;
+            case OverflowPolicy::OVERFLOW_DISCONNECT:
+                ++m_droppedMessages;
+                return false;
+            default:
+                break;
+        }
+    }
+    messages.push_back(message);
+    if (highWaterMark >= 0 && static_cast<ssize_t>(messages.size()) >= highWaterMark)
+    {
+        m_queueBlocked = true;
+    }
+    return true;
+}
+
+void ProtocolSession::checkQueueDrained()
+{
+    // m_mutex is already locked
+    if (m_queueBlocked)
+    {
+        const ssize_t lowWaterMark = (m_sendQueueConfig.lowWaterMarkMessages >= 0) ? m_sendQueueConfig.lowWaterMarkMessages : (m_sendQueueConfig.highWaterMarkMessages / 2);
+        if (static_cast<ssize_t>(m_messagesBuffered.size() + m_pollMessages.size()) <= lowWaterMark)
+        {
+            m_queueBlocked = false;
+            std::weak_ptr<ProtocolSession> pThisWeak = shared_from_this();
+            getConnectionExecutor(getSendConnection())->addAction([pThisWeak]() {
+                std::shared_ptr<ProtocolSession> pThis = pThisWeak.lock();
+                if (pThis)
+                {
+                    pThis->writable();
+                }
+            }, m_instanceId);
+        }
+    }
+}
+
 
 bool ProtocolSession::hasPendingRequests() const
 {
@@ -343,14 +448,41 @@ bool ProtocolSession::hasPendingRequests() const
     return false;
 }
 
+void ProtocolSession::prewarmRequestConnections()
+{
+    // m_mutex is already locked
+    const int prewarmConnections = std::max(m_protocolData.getDataValue<int>(PROPERTY_PREWARM_CONNECTIONS), 1);
+    const std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+    for (int i = 0; i < prewarmConnections; ++i)
+    {
+        IProtocolPtr protocol;
+        if (m_connectionPool)
+        {
+            protocol = acquirePooledRequestConnection();
+        }
+        if (protocol == nullptr)
+        {
+            protocol = createRequestConnection();
+        }
+        if (protocol == nullptr)
+        {
+            break;
+        }
+        IStreamConnectionPtr connection = protocol->getConnection();
+        if (connection)
+        {
+            m_unallocatedConnections[connection->getConnectionId()] = now;
+        }
+    }
+}
+
 IProtocolPtr ProtocolSession::allocateRequestConnection()
 {
     // m_mutex is already locked
-    if (!m_unallocatedConnections.empty())
+    while (!m_unallocatedConnections.empty())
     {
         auto itUnallocated = m_unallocatedConnections.begin();
-        assert(itUnallocated != m_unallocatedConnections.end());
-        std::int64_t connectionId = *itUnallocated;
+        std::int64_t connectionId = itUnallocated->first;
         m_unallocatedConnections.erase(itUnallocated);
         auto itConnection = m_multiProtocols.find(connectionId);
         if (itConnection != m_multiProtocols.end())
@@ -358,9 +490,84 @@ IProtocolPtr ProtocolSession::allocateRequestConnection()
             return itConnection->second;
         }
     }
+
+    if (m_connectionPool && static_cast<int>(m_multiProtocols.size()) < m_maxSynchReqRepConnections)
+    {
+        IProtocolPtr protocol = acquirePooledRequestConnection();
+        if (protocol)
+        {
+            return protocol;
+        }
+    }
+
+    // fill the pipelines of the open connections, before opening new sockets
+    if (m_maxPipelinedRequests > 1)
+    {
+        IProtocolPtr protocol = findPipelinedRequestConnection();
+        if (protocol)
+        {
+            return protocol;
+        }
+    }
+
     return createRequestConnection();
 }
 
+IProtocolPtr ProtocolSession::acquirePooledRequestConnection()
+{
+    // m_mutex is already locked
+    IProtocolSessionListPtr protocolSessionList = m_protocolSessionList.lock();
+    if (protocolSessionList == nullptr)
+    {
+        return nullptr;
+    }
+    IProtocolPtr protocol = protocolSessionList->getRequestConnectionPool().acquire(m_connectionPoolKey);
+    if (protocol)
+    {
+        IStreamConnectionPtr connection = protocol->getConnection();
+        assert(connection);
+        protocol->setProtocolSessionData(m_protocolSessionData);
+        protocol->setCallback(shared_from_this());
+        m_connectionId = connection->getConnectionId();
+        m_multiProtocols[m_connectionId] = protocol;
+
+        // the pooled connection is already connected, so the protocol will not trigger the connected event
+        if (!m_triggeredConnected)
+        {
+            std::weak_ptr<ProtocolSession> pThisWeak = shared_from_this();
+            getConnectionExecutor(connection)->addAction([pThisWeak]() {
+                std::shared_ptr<ProtocolSession> pThis = pThisWeak.lock();
+                if (pThis)
+                {
+                    pThis->connected();
+                }
+            }, m_instanceId);
+        }
+    }
+    return protocol;
+}
+
+IProtocolPtr ProtocolSession::findPipelinedRequestConnection() const
+{
+    // m_mutex is already locked
+    IProtocolPtr protocol;
+    size_t requestsMin = m_maxPipelinedRequests;
+    for (auto it = m_runningRequests.begin(); it != m_runningRequests.end(); ++it)
+    {
+        const size_t requests = it->second.size();
+        if (requests < requestsMin)
+        {
+            auto itConnection = m_multiProtocols.find(it->first);
+            if (itConnection != m_multiProtocols.end())
+            {
+                protocol = itConnection->second;
+                requestsMin = requests;
+            }
+        }
+    }
+    return protocol;
+}
+
 IProtocolPtr ProtocolSession::createRequestConnection()
 {
     // m_mutex is already locked
@@ -394,6 +601,82 @@ IProtocolPtr ProtocolSession::createRequestConnection()
     return nullptr;
 }
 
+void ProtocolSession::releaseRequestConnection(std::int64_t connectionId)
+{
+    // m_mutex is already locked
+    if (m_multiProtocols.find(connectionId) != m_multiProtocols.end() &&
+        m_runningRequests.find(connectionId) == m_runningRequests.end())
+    {
+        m_unallocatedConnections[connectionId] = std::chrono::steady_clock::now();
+    }
+}
+
+void ProtocolSession::poolIdleRequestConnections()
+{
+    // m_mutex is already locked
+    IProtocolSessionListPtr protocolSessionList = m_protocolSessionList.lock();
+    if (protocolSessionList == nullptr)
+    {
+        return;
+    }
+    RequestConnectionPool& pool = protocolSessionList->getRequestConnectionPool();
+    for (auto it = m_unallocatedConnections.begin(); it != m_unallocatedConnections.end();)
+    {
+        auto itConnection = m_multiProtocols.find(it->first);
+        if (itConnection == m_multiProtocols.end())
+        {
+            it = m_unallocatedConnections.erase(it);
+            continue;
+        }
+        IStreamConnectionPtr connection = itConnection->second->getConnection();
+        // connections, which are still connecting, stay in the session
+        if (connection && connection->getConnectionData().connectionState == ConnectionState::CONNECTIONSTATE_CONNECTED)
+        {
+            // the pool resets the callback of the protocol, so the session will not get events of the connection anymore
+            pool.release(m_connectionPoolKey, itConnection->second, m_idleTimeout, m_maxSynchReqRepConnections);
+            m_multiProtocols.erase(itConnection);
+            if (m_connectionId == it->first)
+            {
+                m_connectionId = 0;
+            }
+            it = m_unallocatedConnections.erase(it);
+        }
+        else
+        {
+            ++it;
+        }
+    }
+}
+
+std::vector<IProtocolPtr> ProtocolSession::removeExpiredRequestConnections()
+{
+    // m_mutex is already locked
+    std::vector<IProtocolPtr> protocols;
+    if (m_idleTimeout <= 0)
+    {
+        return protocols;
+    }
+    const std::chrono::steady_clock::time_point expired = std::chrono::steady_clock::now() - std::chrono::milliseconds(m_idleTimeout);
+    for (auto it = m_unallocatedConnections.begin(); it != m_unallocatedConnections.end();)
+    {
+        if (it->second <= expired)
+        {
+            auto itConnection = m_multiProtocols.find(it->first);
+            if (itConnection != m_multiProtocols.end())
+            {
+                protocols.push_back(std::move(itConnection->second));
+                m_multiProtocols.erase(itConnection);
+            }
+            it = m_unallocatedConnections.erase(it);
+        }
+        else
+        {
+            ++it;
+        }
+    }
+    return protocols;
+}
+
 void ProtocolSession::sendNextRequests()
 {
     // m_mutex is already locked
@@ -420,8 +703,9 @@ void ProtocolSession::sendNextRequests()
         IMessagePtr message = m_messagesBuffered.front();
         m_messagesBuffered.pop_front();
         assert(message);
-        m_runningRequests[connectionId] = std::move(message->getEchoData());
+        m_runningRequests[connectionId].push_back(std::move(message->getEchoData()));
         sendMessage(message, protocol);
+        checkQueueDrained();
     }
 }
 
@@ -435,6 +719,20 @@ std::int64_t ProtocolSession::getSessionId() const
 ConnectionData ProtocolSession::getConnectionData() const
 {
     std::unique_lock<std::mutex> lock(m_mutex);
+    IStreamConnectionPtr connection = getSendConnection();
+    lock.unlock();
+    if (connection)
+    {
+        return connection->getConnectionData();
+    }
+    static ConnectionData defaultConnectionData;
+    defaultConnectionData.connectionState = ConnectionState::CONNECTIONSTATE_DISCONNECTED;
+    return defaultConnectionData;
+}
+
+IStreamConnectionPtr ProtocolSession::getSendConnection() const
+{
+    // m_mutex is already locked
     IStreamConnectionPtr connection;
     if (m_protocol)
     {
@@ -457,14 +755,20 @@ ConnectionData ProtocolSession::getConnectionData() const
             }
         }
     }
-    lock.unlock();
+    return connection;
+}
+
+
+
+IExecutorPtr ProtocolSession::getConnectionExecutor(const IStreamConnectionPtr& connection) const
+{
+    // without an own executor, the events of the session are triggered by the poller thread of its connection
+    IExecutorPtr executor;
     if (connection)
     {
-        return connection->getConnectionData();
+        executor = connection->getExecutor();
     }
-    static ConnectionData defaultConnectionData;
-    defaultConnectionData.connectionState = ConnectionState::CONNECTIONSTATE_DISCONNECTED;
-    return defaultConnectionData;
+    return executor ? executor : m_executorPollerThread;
 }
 
 
@@ -512,7 +816,13 @@ void ProtocolSession::disconnect()
     m_pollMessages.clear();
     m_pollProtocol = nullptr;
     m_pollTimer.stop();
+    if (m_protocolFlagSynchronousRequestReply && m_connectionPool)
+    {
+        // other sessions to the same endpoint can reuse the idle connections
+        poolIdleRequestConnections();
+    }
     IProtocolSessionListPtr protocolSessionList = m_protocolSessionList.lock();
+    IExecutorPtr executor = getConnectionExecutor(getSendConnection());
     std::vector<IProtocolPtr> protocols;
     protocols.reserve(m_multiProtocols.size() + 1);
     if (m_protocol)
@@ -538,10 +848,10 @@ void ProtocolSession::disconnect()
         protocolSessionList->removeProtocolSession(m_sessionId);
     }
 
-    assert(m_executorPollerThread);
+    assert(executor);
 
     std::weak_ptr<ProtocolSession> pThisWeak = shared_from_this();
-    m_executorPollerThread->addAction([pThisWeak]() {
+    executor->addAction([pThisWeak]() {
         std::shared_ptr<ProtocolSession> pThis = pThisWeak.lock();
         if (pThis)
         {
@@ -558,6 +868,7 @@ void ProtocolSession::sendBufferedMessages()
         sendMessage(m_messagesBuffered[i], m_protocol);
     }
     m_messagesBuffered.clear();
+    checkQueueDrained();
 }
 
 
@@ -617,16 +928,13 @@ bool ProtocolSession::connect(const std::string& endpoint, const ConnectProperti
         m_connectionProperties = connectionProperties;
         m_protocolData = m_connectionProperties.protocolData;
         m_formatData = m_connectionProperties.formatData;
+        m_sendQueueConfig = m_connectionProperties.sendQueue;
         m_contentType = contentType;
         m_protocol = protocol;
         initProtocolValues();
         m_protocol = nullptr;
-        IProtocolPtr connection = createRequestConnection();
-        if (connection)
-        {
-            m_unallocatedConnections.insert(connection->getProtocolId());
-            sendNextRequests();
-        }
+        prewarmRequestConnections();
+        sendNextRequests();
         lock.unlock();
         res = true;
     }
@@ -641,6 +949,7 @@ bool ProtocolSession::connect(const std::string& endpoint, const ConnectProperti
         m_connectionProperties = connectionProperties;
         m_protocolData = m_connectionProperties.protocolData;
         m_formatData = m_connectionProperties.formatData;
+        m_sendQueueConfig = m_connectionProperties.sendQueue;
         m_contentType = contentType;
         m_protocol = protocol;
         m_connectionId = connection->getConnectionId();
@@ -659,7 +968,14 @@ bool ProtocolSession::connect(const std::string& endpoint, const ConnectProperti
 
 IExecutorPtr ProtocolSession::getExecutor() const
 {
-    return m_executor ? m_executor : m_executorPollerThread;
+    if (m_executor)
+    {
+        return m_executor;
+    }
+    std::unique_lock<std::mutex> lock(m_mutex);
+    IStreamConnectionPtr connection = getSendConnection();
+    lock.unlock();
+    return getConnectionExecutor(connection);
 }
 
 void ProtocolSession::subscribe(const std::vector<std::string>& subscribtions)
@@ -682,6 +998,36 @@ const Variant& ProtocolSession::getFormatData() const
     return m_formatData;
 }
 
+bool ProtocolSession::isWritable() const
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    if (m_queueBlocked)
+    {
+        return false;
+    }
+    IStreamConnectionPtr connection = getSendConnection();
+    lock.unlock();
+    return (connection == nullptr || connection->isWritable());
+}
+
+SendQueueStatistics ProtocolSession::getSendQueueStatistics() const
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    const ssize_t messagesSession = static_cast<ssize_t>(m_messagesBuffered.size() + m_pollMessages.size());
+    const std::int64_t droppedSession = m_droppedMessages;
+    IStreamConnectionPtr connection = getSendConnection();
+    lock.unlock();
+    SendQueueStatistics statistics;
+    if (connection)
+    {
+        statistics = connection->getSendQueueStatistics();
+    }
+    statistics.pendingMessages += messagesSession;
+    statistics.peakMessages = std::max(statistics.peakMessages, statistics.pendingMessages);
+    statistics.droppedMessages += droppedSession;
+    return statistics;
+}
+
 // IProtocolCallback
 void ProtocolSession::connected()
 {
@@ -793,24 +1139,38 @@ const std::string FMQ_DISCONNECTED = "fmq_disconnected";
 
 void ProtocolSession::received(const IMessagePtr& message, std::int64_t connectionId)
 {
+    std::deque<Variant> requestsAborted;
     if (m_protocolFlagSynchronousRequestReply)
     {
         bool foundRunningRequest = false;
         std::unique_lock<std::mutex> lock(m_mutex);
+        const bool disconnected = (message->getMetainfo(FMQ_DISCONNECTED) != nullptr);
         auto it = m_runningRequests.find(connectionId);
         if (it != m_runningRequests.end())
         {
-            message->getEchoData() = std::move(it->second);
-            m_runningRequests.erase(it);
+            // the replies come in the order of the (pipelined) requests
+            std::deque<Variant>& requests = it->second;
+            assert(!requests.empty());
+            message->getEchoData() = std::move(requests.front());
+            requests.pop_front();
             foundRunningRequest = true;
+            if (disconnected)
+            {
+                // the requests behind the first one will not get a reply from this connection, anymore
+                requestsAborted = std::move(requests);
+                requests.clear();
+            }
+            if (requests.empty())
+            {
+                m_runningRequests.erase(it);
+            }
         }
-        const bool disconnected = (message->getMetainfo(FMQ_DISCONNECTED) != nullptr);
 
         // in case of disconnected -> keep connection allocated, so that no one will use it till the disconnectedMultiConnection is called
         if (!disconnected)
         {
-            // if not disconnected -> mark connection as unallocated
-            m_unallocatedConnections.insert(connectionId);
+            // if not disconnected -> mark connection as unallocated, if no other request is in flight
+            releaseRequestConnection(connectionId);
             sendNextRequests();
         }
 
@@ -834,6 +1194,20 @@ void ProtocolSession::received(const IMessagePtr& message, std::int64_t connecti
         echoData.add(FMQ_CONNECTION_ID, connectionId);
     }
 
+    receivedMessage(message);
+
+    for (auto it = requestsAborted.begin(); it != requestsAborted.end(); ++it)
+    {
+        IMessagePtr messageAborted = ProtocolMessagePool::createMessage(0);
+        messageAborted->getAllMetainfo() = message->getAllMetainfo();
+        messageAborted->getControlData() = message->getControlData();
+        messageAborted->getEchoData() = std::move(*it);
+        receivedMessage(messageAborted);
+    }
+}
+
+void ProtocolSession::receivedMessage(const IMessagePtr& message)
+{
     if (m_executor)
     {
         std::weak_ptr<ProtocolSession> pThisWeak = shared_from_this();
@@ -913,6 +1287,33 @@ void ProtocolSession::socketDisconnected()
     }
 }
 
+void ProtocolSession::writable()
+{
+    if (m_executor)
+    {
+        std::weak_ptr<ProtocolSession> pThisWeak = shared_from_this();
+        m_executor->addAction([pThisWeak]() {
+            std::shared_ptr<ProtocolSession> pThis = pThisWeak.lock();
+            if (pThis)
+            {
+                auto callback = pThis->m_callback.lock();
+                if (callback)
+                {
+                    callback->writable(pThis);
+                }
+            }
+        }, m_instanceId);
+    }
+    else
+    {
+        auto callback = m_callback.lock();
+        if (callback)
+        {
+            callback->writable(shared_from_this());
+        }
+    }
+}
+
 void ProtocolSession::reconnect()
 {
     std::unique_lock<std::mutex> lock(m_mutex);
@@ -952,8 +1353,14 @@ void ProtocolSession::cycleTime()
     {
         pollRelease();
     }
+    const std::vector<IProtocolPtr> protocolsExpired = removeExpiredRequestConnections();
     lock.unlock();
 
+    for (size_t i = 0; i < protocolsExpired.size(); ++i)
+    {
+        protocolsExpired[i]->disconnect();
+    }
+
     bool activityTimerExpired = m_activityTimer.isExpired();
     if (activityTimerExpired)
     {
@@ -1148,6 +1555,7 @@ void ProtocolSession::pollRequest(const IProtocolPtr& protocol, int timeout, int
         IMessagePtr pollReply = protocol->pollReply(std::move(m_pollMessages));
         m_pollMessages.clear();
         sendMessage(pollReply, protocol);
+        checkQueueDrained();
     }
 
     if (timeout == 0 || (m_pollCountMax >= 0 && m_pollCounter >= m_pollCountMax))
@@ -60,13 +60,19 @@ void ProtocolBind::disconnected(const IStreamConnectionPtr& /*connection*/)
     assert(false);
 }
 
-bool ProtocolBind::received(const IStreamConnectionPtr& /*connection*/, const SocketPtr& /*socket*/, int /*bytesToRead*/)
+bool ProtocolBind::received(const IStreamConnectionPtr& /*connection*/, const char* /*buffer*/, int /*size*/)
 {
     // should never be called, because the callback will be overriden by connected
     assert(false);
     return false;
 }
 
+void ProtocolBind::writable(const IStreamConnectionPtr& /*connection*/)
+{
+    // should never be called, because the callback will be overriden by connected
+    assert(false);
+}
+
 
 
 //////////////////////////////
@@ -84,7 +90,7 @@ ProtocolSessionContainer::~ProtocolSessionContainer()
 }
 
 // IProtocolSessionContainer
-void ProtocolSessionContainer::init(const IExecutorPtr& executor, int cycleTime, FuncTimer funcTimer, int checkReconnectInterval)
+void ProtocolSessionContainer::init(const IExecutorPtr& executor, int cycleTime, FuncTimer funcTimer, int checkReconnectInterval, int numberOfReactors)
 {
     m_executor = executor;
     std::shared_ptr<FuncTimer> pFuncTimer = funcTimer ? std::make_shared<FuncTimer>(std::move(funcTimer)) : nullptr;
@@ -109,7 +115,8 @@ void ProtocolSessionContainer::init(const IExecutorPtr& executor, int cycleTime,
             assert(session);
             session->cycleTime();
         }
-    }, checkReconnectInterval);
+        m_protocolSessionList->getRequestConnectionPool().cycleTime();
+    }, checkReconnectInterval, numberOfReactors);
     if (m_executor)
     {
         m_thread = std::thread([this]() { m_streamConnectionContainer->run(); });
@@ -123,5 +123,11 @@ bool ProtocolSessionList::setSessionName(std::int64_t sessionId, const std::stri
 }
 
 
+RequestConnectionPool& ProtocolSessionList::getRequestConnectionPool()
+{
+    return m_requestConnectionPool;
+}
+
+
 
 }   // namespace finalmq
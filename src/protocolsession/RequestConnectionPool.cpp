@@ -0,0 +1,174 @@
+//MIT License
+
+//Copyright (c) 2020 bexoft GmbH (mail@bexoft.de)
+
+//Permission is hereby granted, free of charge, to any person obtaining a copy
+//of this software and associated documentation files (the "Software"), to deal
+//in the Software without restriction, including without limitation the rights
+//to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//copies of the Software, and to permit persons to whom the Software is
+//furnished to do so, subject to the following conditions:
+
+//The above copyright notice and this permission notice shall be included in all
+//copies or substantial portions of the Software.
+
+//THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//SOFTWARE.
+
+
+#include "finalmq/protocolsession/RequestConnectionPool.h"
+
+#include "finalmq/streamconnection/StreamConnection.h"
+
+#include <assert.h>
+#include <vector>
+
+namespace finalmq
+{
+RequestConnectionPool::RequestConnectionPool()
+{
+}
+
+RequestConnectionPool::~RequestConnectionPool()
+{
+    clear();
+}
+
+static bool isConnected(const IProtocolPtr& protocol)
+{
+    IStreamConnectionPtr connection = protocol->getConnection();
+    return (connection && connection->getConnectionData().connectionState == ConnectionState::CONNECTIONSTATE_CONNECTED);
+}
+
+IProtocolPtr RequestConnectionPool::acquire(const std::string& key)
+{
+    std::vector<IProtocolPtr> protocolsClosed;
+    IProtocolPtr protocol;
+    std::unique_lock<std::mutex> lock(m_mutex);
+    auto it = m_idleConnections.find(key);
+    if (it != m_idleConnections.end())
+    {
+        std::deque<IdleConnection>& connections = it->second;
+        while (!connections.empty() && !protocol)
+        {
+            // the most recently used connection is the warmest one
+            IProtocolPtr protocolIdle = std::move(connections.back().protocol);
+            connections.pop_back();
+            if (isConnected(protocolIdle))
+            {
+                protocol = std::move(protocolIdle);
+            }
+            else
+            {
+                protocolsClosed.push_back(std::move(protocolIdle));
+            }
+        }
+        if (connections.empty())
+        {
+            m_idleConnections.erase(it);
+        }
+    }
+    lock.unlock();
+
+    for (size_t i = 0; i < protocolsClosed.size(); ++i)
+    {
+        protocolsClosed[i]->disconnect();
+    }
+    return protocol;
+}
+
+void RequestConnectionPool::release(const std::string& key, const IProtocolPtr& protocol, int idleTimeout, int maxIdleConnections)
+{
+    assert(protocol);
+    // the pool does not forward events, the next owner sets its callback
+    protocol->setCallback(std::weak_ptr<IProtocolCallback>());
+
+    if (maxIdleConnections <= 0 || !isConnected(protocol))
+    {
+        protocol->disconnect();
+        return;
+    }
+
+    IProtocolPtr protocolClosed;
+    std::unique_lock<std::mutex> lock(m_mutex);
+    std::deque<IdleConnection>& connections = m_idleConnections[key];
+    if (static_cast<int>(connections.size()) >= maxIdleConnections)
+    {
+        protocolClosed = std::move(connections.front().protocol);
+        connections.pop_front();
+    }
+    IdleConnection idleConnection;
+    idleConnection.protocol = protocol;
+    idleConnection.expires = (idleTimeout > 0);
+    if (idleConnection.expires)
+    {
+        idleConnection.expiration = std::chrono::steady_clock::now() + std::chrono::milliseconds(idleTimeout);
+    }
+    connections.push_back(std::move(idleConnection));
+    lock.unlock();
+
+    if (protocolClosed)
+    {
+        protocolClosed->disconnect();
+    }
+}
+
+void RequestConnectionPool::cycleTime()
+{
+    std::vector<IProtocolPtr> protocolsClosed;
+    const std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+    std::unique_lock<std::mutex> lock(m_mutex);
+    for (auto it = m_idleConnections.begin(); it != m_idleConnections.end();)
+    {
+        std::deque<IdleConnection>& connections = it->second;
+        for (auto itConnection = connections.begin(); itConnection != connections.end();)
+        {
+            if (itConnection->expires && now >= itConnection->expiration)
+            {
+                protocolsClosed.push_back(std::move(itConnection->protocol));
+                itConnection = connections.erase(itConnection);
+            }
+            else
+            {
+                ++itConnection;
+            }
+        }
+        if (connections.empty())
+        {
+            it = m_idleConnections.erase(it);
+        }
+        else
+        {
+            ++it;
+        }
+    }
+    lock.unlock();
+
+    for (size_t i = 0; i < protocolsClosed.size(); ++i)
+    {
+        protocolsClosed[i]->disconnect();
+    }
+}
+
+void RequestConnectionPool::clear()
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    std::unordered_map<std::string, std::deque<IdleConnection>> idleConnections = std::move(m_idleConnections);
+    m_idleConnections.clear();
+    lock.unlock();
+
+    for (auto it = idleConnections.begin(); it != idleConnections.end(); ++it)
+    {
+        for (auto itConnection = it->second.begin(); itConnection != it->second.end(); ++itConnection)
+        {
+            itConnection->protocol->disconnect();
+        }
+    }
+}
+
+} // namespace finalmq
@@ -27,6 +27,7 @@
 #include "finalmq/helpers/ModulenameFinalmq.h"
 #include "finalmq/helpers/Utils.h"
 #include "finalmq/protocolsession/ProtocolMessage.h"
+#include "finalmq/protocolsession/ProtocolMessagePool.h"
 #include "finalmq/remoteentity/RemoteEntityContainer.h"
 #include "finalmq/serializestruct/StructBase.h"
 #include "finalmq/remoteentity/entitydata.fmq.h"
@@ -82,6 +83,7 @@ const EnumInfo PeerEvent::_enumInfo = {
     {
         {"PEER_CONNECTED", 0, "", "connected"},
         {"PEER_DISCONNECTED", 1, "", "disconnected"},
+        {"PEER_WRITABLE", 2, "", "writable"},
     }};
 
 ///////////////////////////////////
@@ -441,6 +443,19 @@ void PeerManager::setPeerEvent(const std::shared_ptr<FuncPeerEvent>& funcPeerEve
     m_funcPeerEvent = funcPeerEvent;
 }
 
+void PeerManager::firePeerEvent(PeerId peerId, PeerEvent peerEvent)
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    std::shared_ptr<PeerManager::Peer> peer = getPeer(peerId);
+    std::shared_ptr<FuncPeerEvent> funcPeerEvent = m_funcPeerEvent;
+    lock.unlock();
+
+    if (peer && funcPeerEvent && *funcPeerEvent)
+    {
+        (*funcPeerEvent)(peerId, peer->session, peer->entityId, peerEvent, peer->incoming);
+    }
+}
+
 const SessionInfo& PeerManager::getSession(PeerId peerId) const
 {
     std::unique_lock<std::mutex> lock(m_mutex);
@@ -517,20 +532,12 @@ void RemoteEntity::sendEvent(const PeerId& peerId, const std::string& path, cons
 
 void RemoteEntity::sendEventToAllPeers(const StructBase& structBase)
 {
-    std::vector<PeerId> peers = getAllPeers();
-    for (size_t i = 0; i < peers.size(); ++i)
-    {
-        sendRequest(peers[i], EMPTY_PATH, structBase, CORRELATIONID_NONE);
-    }
+    sendEventToPeers(getAllPeers(), EMPTY_PATH, structBase, nullptr);
 }
 
 void RemoteEntity::sendEventToAllPeers(const std::string& path, const StructBase& structBase)
 {
-    std::vector<PeerId> peers = getAllPeers();
-    for (size_t i = 0; i < peers.size(); ++i)
-    {
-        sendRequest(peers[i], path, structBase, CORRELATIONID_NONE);
-    }
+    sendEventToPeers(getAllPeers(), path, structBase, nullptr);
 }
 
 CorrelationId RemoteEntity::sendRequest(const PeerId& peerId, const StructBase& structBase, FuncReply funcReply)
@@ -553,7 +560,23 @@ CorrelationId RemoteEntity::sendRequest(const PeerId& peerId, const std::string&
     return correlationId;
 }
 
+void RemoteEntity::sendEventToPeers(const std::vector<PeerId>& peers, const std::string& path, const StructBase& structBase, IMessage::Metainfo* metainfo)
+{
+    // the payload is serialized only once for all peers with the same content type and format
+    SerializedDataCache serializedDataCache;
+    SerializedDataCache* cache = (peers.size() > 1) ? &serializedDataCache : nullptr;
+    for (size_t i = 0; i < peers.size(); ++i)
+    {
+        sendRequestIntern(peers[i], path, structBase, CORRELATIONID_NONE, metainfo, cache);
+    }
+}
+
 void RemoteEntity::sendRequest(const PeerId& peerId, const std::string& path, const StructBase& structBase, CorrelationId correlationId, IMessage::Metainfo* metainfo)
+{
+    sendRequestIntern(peerId, path, structBase, correlationId, metainfo, nullptr);
+}
+
+void RemoteEntity::sendRequestIntern(const PeerId& peerId, const std::string& path, const StructBase& structBase, CorrelationId correlationId, IMessage::Metainfo* metainfo, SerializedDataCache* serializedDataCache)
 {
     //// if not initialized (entity not registered)
     //if (!m_initialized.load(std::memory_order_acquire))
@@ -575,7 +598,7 @@ void RemoteEntity::sendRequest(const PeerId& peerId, const std::string& path, co
     if (readyToSend == PeerManager::ReadyToSend::RTS_READY)
     {
         assert(session);
-        RemoteEntityFormatRegistry::instance().send(session, virtualSessionId, header, {}, &structBase, metainfo);
+        RemoteEntityFormatRegistry::instance().send(session, virtualSessionId, header, {}, &structBase, metainfo, nullptr, serializedDataCache);
     }
     else if (readyToSend == PeerManager::ReadyToSend::RTS_SESSION_NOT_AVAILABLE)
     {
@@ -591,7 +614,7 @@ void RemoteEntity::sendRequest(const PeerId& peerId, const std::string& path, co
         ReceiveData receiveData;
         receiveData.header.corrid = correlationId;
         receiveData.header.status = status;
-        receiveData.message = std::make_shared<ProtocolMessage>(0);
+        receiveData.message = ProtocolMessagePool::createMessage(0);
         if (session != nullptr)
         {
             IExecutorPtr executor = session->getExecutor();
@@ -619,20 +642,12 @@ void RemoteEntity::sendEvent(const PeerId& peerId, const std::string& path, IMes
 
 void RemoteEntity::sendEventToAllPeers(IMessage::Metainfo&& metainfo, const StructBase& structBase)
 {
-    std::vector<PeerId> peers = getAllPeers();
-    for (size_t i = 0; i < peers.size(); ++i)
-    {
-        sendRequest(peers[i], EMPTY_PATH, structBase, CORRELATIONID_NONE, &metainfo);
-    }
+    sendEventToPeers(getAllPeers(), EMPTY_PATH, structBase, &metainfo);
 }
 
 void RemoteEntity::sendEventToAllPeers(const std::string& path, IMessage::Metainfo&& metainfo, const StructBase& structBase)
 {
-    std::vector<PeerId> peers = getAllPeers();
-    for (size_t i = 0; i < peers.size(); ++i)
-    {
-        sendRequest(peers[i], path, structBase, CORRELATIONID_NONE, &metainfo);
-    }
+    sendEventToPeers(getAllPeers(), path, structBase, &metainfo);
 }
 
 CorrelationId RemoteEntity::sendRequest(const PeerId& peerId, IMessage::Metainfo&& metainfo, const StructBase& structBase, FuncReplyMeta funcReply)
@@ -1020,6 +1035,16 @@ void RemoteEntity::sessionDisconnected(const IProtocolSessionPtr& session)
     }
 }
 
+void RemoteEntity::sessionWritable(const IProtocolSessionPtr& session)
+{
+    std::vector<PeerId> peerIds = m_peerManager->getAllPeersWithSession(session);
+
+    for (size_t i = 0; i < peerIds.size(); ++i)
+    {
+        m_peerManager->firePeerEvent(peerIds[i], PeerEvent::PEER_WRITABLE);
+    }
+}
+
 void RemoteEntity::virtualSessionDisconnected(const IProtocolSessionPtr& session, const std::string& virtualSessionId)
 {
     std::vector<PeerId> peerIds = m_peerManager->getAllPeersWithVirtualSession(session, virtualSessionId);
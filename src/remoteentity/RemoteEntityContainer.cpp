@@ -22,6 +22,8 @@
 
 #include "finalmq/remoteentity/RemoteEntityContainer.h"
 
+#include <algorithm>
+
 #include "finalmq/helpers/ModulenameFinalmq.h"
 #include "finalmq/remoteentity/entitydata.fmq.h"
 #include "finalmq/variant/VariantValues.h"
@@ -73,6 +75,7 @@ const EnumInfo ConnectionEvent::_enumInfo = {
         {"CONNECTIONEVENT_DISCONNECTED", 1, "", "disconnected"},
         {"CONNECTIONEVENT_SOCKET_CONNECTED", 2, "", "socket connected"},
         {"CONNECTIONEVENT_SOCKET_DISCONNECTED", 3, "", "socket disconnected"},
+        {"CONNECTIONEVENT_WRITABLE", 4, "", "writable"},
     }};
 
 ///////////////////////////////////
@@ -115,10 +118,11 @@ void RemoteEntityContainer::deinit()
 
 // IRemoteEntityContainer
 
-void RemoteEntityContainer::init(const IExecutorPtr& executor, int cycleTime, FuncTimer funcTimer, bool storeRawDataInReceiveStruct, int checkReconnectInterval)
+void RemoteEntityContainer::init(const IExecutorPtr& executor, int cycleTime, FuncTimer funcTimer, bool storeRawDataInReceiveStruct, int checkReconnectInterval, int numberOfReactors, bool decodeIntoArena)
 {
     m_storeRawDataInReceiveStruct = storeRawDataInReceiveStruct;
-    m_protocolSessionContainer->init(executor, cycleTime, std::move(funcTimer), checkReconnectInterval);
+    m_decodeIntoArena = decodeIntoArena;
+    m_protocolSessionContainer->init(executor, cycleTime, std::move(funcTimer), checkReconnectInterval, numberOfReactors);
 }
 
 static std::string endpointToProtocolEndpoint(const std::string& endpoint, std::string* contentTypeName = nullptr)
@@ -509,6 +513,8 @@ struct ThreadLocalDataEntities
 };
 thread_local std::unordered_map<std::uint64_t, ThreadLocalDataEntities> t_threadLocalDataEntities;
 
+static constexpr size_t ARENA_SIZE_MIN = 1024;
+
 void RemoteEntityContainer::received(const IProtocolSessionPtr& session, const IMessagePtr& message)
 {
     assert(session);
@@ -527,14 +533,20 @@ void RemoteEntityContainer::received(const IProtocolSessionPtr& session, const I
     }
 
     int formatStatus = 0;
-    ReceiveData receiveData{createSessionInfo(session), {}, message, {}, false, {}};
+    ReceiveData receiveData{createSessionInfo(session), {}, message, {}, false, {}, {}};
+    if (m_decodeIntoArena)
+    {
+        // the decoded strings and arrays take about the size of the payload
+        const size_t sizeArena = std::max(static_cast<size_t>(message->getReceivePayload().second), ARENA_SIZE_MIN);
+        receiveData.arena = std::make_shared<std::pmr::monotonic_buffer_resource>(sizeArena);
+    }
     if (!session->doesSupportMetainfo())
     {
-        receiveData.structBase = RemoteEntityFormatRegistry::instance().parse(session, *message, m_storeRawDataInReceiveStruct, name2entityNoLock, receiveData.header, formatStatus);
+        receiveData.structBase = RemoteEntityFormatRegistry::instance().parse(session, *message, m_storeRawDataInReceiveStruct, receiveData.arena, name2entityNoLock, receiveData.header, formatStatus);
     }
     else
     {
-        receiveData.structBase = RemoteEntityFormatRegistry::instance().parseHeaderInMetainfo(session, *message, m_storeRawDataInReceiveStruct, name2entityNoLock, receiveData.header, formatStatus);
+        receiveData.structBase = RemoteEntityFormatRegistry::instance().parseHeaderInMetainfo(session, *message, m_storeRawDataInReceiveStruct, receiveData.arena, name2entityNoLock, receiveData.header, formatStatus);
     }
 
     EntityId entityId = receiveData.header.destid;
@@ -626,4 +638,27 @@ void RemoteEntityContainer::socketDisconnected(const IProtocolSessionPtr& sessio
     triggerConnectionEvent(createSessionInfo(session), ConnectionEvent::CONNECTIONEVENT_SOCKET_DISCONNECTED);
 }
 
+void RemoteEntityContainer::writable(const IProtocolSessionPtr& session)
+{
+    triggerConnectionEvent(createSessionInfo(session), ConnectionEvent::CONNECTIONEVENT_WRITABLE);
+
+    std::vector<hybrid_ptr<IRemoteEntity>> entities;
+    std::unique_lock<std::mutex> lock(m_mutex);
+    entities.reserve(m_entityId2entity.size());
+    for (auto it = m_entityId2entity.begin(); it != m_entityId2entity.end(); ++it)
+    {
+        entities.push_back(it->second);
+    }
+    lock.unlock();
+
+    for (size_t i = 0; i < entities.size(); ++i)
+    {
+        auto entity = entities[i].lock();
+        if (entity)
+        {
+            entity->sessionWritable(session);
+        }
+    }
+}
+
 } // namespace finalmq
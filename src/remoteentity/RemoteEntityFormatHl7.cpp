@@ -23,6 +23,7 @@
 #include "finalmq/remoteentity/RemoteEntityFormatHl7.h"
 
 #include "finalmq/protocolsession/ProtocolMessage.h"
+#include "finalmq/protocolsession/ProtocolMessagePool.h"
 #include "finalmq/remoteentity/entitydata.fmq.h"
 #include "finalmq/serializehl7/ParserHl7.h"
 #include "finalmq/serializehl7/SerializerHl7.h"
@@ -184,6 +185,12 @@ void RemoteEntityFormatHl7::serialize(const IProtocolSessionPtr& session, IMessa
     serializeData(session, message, structBase);
 }
 
+bool RemoteEntityFormatHl7::serializeWithData(const IProtocolSessionPtr& /*session*/, IMessage& message, const Header& /*header*/, const std::shared_ptr<const std::string>& serializedData)
+{
+    message.addSendPayload(serializedData);
+    return true;
+}
+
 void RemoteEntityFormatHl7::serializeData(const IProtocolSessionPtr& session, IMessage& message, const StructBase* structBase)
 {
     if (structBase)
@@ -193,7 +200,7 @@ void RemoteEntityFormatHl7::serializeData(const IProtocolSessionPtr& session, IM
         std::string messageend;
         bool replaceNeeded = isReplaceNeeded(session, lineend, messagestart, messageend);
 
-        IMessagePtr messageHelper = replaceNeeded ? std::make_shared<ProtocolMessage>(0) : nullptr;
+        IMessagePtr messageHelper = replaceNeeded ? ProtocolMessagePool::createMessage(0) : nullptr;
         IMessage& messageToSerialize = replaceNeeded ? *messageHelper : message;
 
         if (!messagestart.empty())
@@ -228,7 +235,7 @@ void RemoteEntityFormatHl7::serializeData(const IProtocolSessionPtr& session, IM
     }
 }
 
-std::shared_ptr<StructBase> RemoteEntityFormatHl7::parse(const IProtocolSessionPtr& session, const BufferRef& bufferRef, bool storeRawData, const std::unordered_map<std::string, std::pair<EntityId, hybrid_ptr<IRemoteEntity>>>& /*name2Entity*/, Header& header, int& formatStatus)
+std::shared_ptr<StructBase> RemoteEntityFormatHl7::parse(const IProtocolSessionPtr& session, const BufferRef& bufferRef, bool storeRawData, const std::shared_ptr<std::pmr::memory_resource>& arena, const std::unordered_map<std::string, std::pair<EntityId, hybrid_ptr<IRemoteEntity>>>& /*name2Entity*/, Header& header, int& formatStatus)
 {
     formatStatus = FORMATSTATUS_HEADER_PARSED_BY_FORMAT;
     char* buffer = bufferRef.first;
@@ -328,7 +335,7 @@ std::shared_ptr<StructBase> RemoteEntityFormatHl7::parse(const IProtocolSessionP
         header.corrid = 1;
 
         BufferRef bufferRefData = {buffer, sizeBuffer};
-        data = parseData(session, bufferRefData, storeRawData, header.type, formatStatus, {});
+        data = parseData(session, bufferRefData, storeRawData, arena, header.type, formatStatus, {});
 
         formatStatus |= FORMATSTATUS_AUTOMATIC_CONNECT;
     }
@@ -336,7 +343,7 @@ std::shared_ptr<StructBase> RemoteEntityFormatHl7::parse(const IProtocolSessionP
     return data;
 }
 
-std::shared_ptr<StructBase> RemoteEntityFormatHl7::parseData(const IProtocolSessionPtr& session, const BufferRef& bufferRef, bool storeRawData, std::string& type, int& formatStatus, const std::string& /*typeOfGeneralMessage*/)
+std::shared_ptr<StructBase> RemoteEntityFormatHl7::parseData(const IProtocolSessionPtr& session, const BufferRef& bufferRef, bool storeRawData, const std::shared_ptr<std::pmr::memory_resource>& arena, std::string& type, int& formatStatus, const std::string& /*typeOfGeneralMessage*/)
 {
     const char* buffer = bufferRef.first;
     ssize_t sizeBuffer = bufferRef.second;
@@ -399,7 +406,7 @@ std::shared_ptr<StructBase> RemoteEntityFormatHl7::parseData(const IProtocolSess
     assert(sizeData >= 0);
     if (!type.empty())
     {
-        data = StructFactoryRegistry::instance().createStruct(type);
+        data = StructFactoryRegistry::instance().createStruct(type, arena);
 
         if (data)
         {
@@ -64,14 +64,18 @@ struct RegisterFormatJson
 
 #define JSONBLOCKSIZE   512
 
-void RemoteEntityFormatJson::serialize(const IProtocolSessionPtr& session, IMessage& message, const Header& header, const StructBase* structBase)
+static void serializeHeader(IMessage& message, const Header& header)
 {
     message.addSendPayload("[", 1, JSONBLOCKSIZE);
 
     SerializerJson serializerHeader(message, JSONBLOCKSIZE);
     ParserStruct parserHeader(serializerHeader, header);
     parserHeader.parseStruct();
+}
 
+void RemoteEntityFormatJson::serialize(const IProtocolSessionPtr& session, IMessage& message, const Header& header, const StructBase* structBase)
+{
+    serializeHeader(message, header);
 
     // add end of header
     if (structBase)
@@ -89,6 +93,15 @@ void RemoteEntityFormatJson::serialize(const IProtocolSessionPtr& session, IMess
     }
 }
 
+bool RemoteEntityFormatJson::serializeWithData(const IProtocolSessionPtr& /*session*/, IMessage& message, const Header& header, const std::shared_ptr<const std::string>& serializedData)
+{
+    serializeHeader(message, header);
+    message.addSendPayload(",\t", 2, JSONBLOCKSIZE);
+    message.addSendPayload(serializedData);
+    message.addSendPayload("]\t\t", 3);
+    return true;
+}
+
 
 void RemoteEntityFormatJson::serializeData(const IProtocolSessionPtr& session, IMessage& message, const StructBase* structBase)
 {
@@ -189,7 +202,7 @@ static const std::string FMQ_PATH = "fmq_path";
 
 
 
-std::shared_ptr<StructBase> RemoteEntityFormatJson::parse(const IProtocolSessionPtr& session, const BufferRef& bufferRef, bool storeRawData, const std::unordered_map<std::string, std::pair<EntityId, hybrid_ptr<IRemoteEntity>>>& name2Entity, Header& header, int& formatStatus)
+std::shared_ptr<StructBase> RemoteEntityFormatJson::parse(const IProtocolSessionPtr& session, const BufferRef& bufferRef, bool storeRawData, const std::shared_ptr<std::pmr::memory_resource>& arena, const std::unordered_map<std::string, std::pair<EntityId, hybrid_ptr<IRemoteEntity>>>& name2Entity, Header& header, int& formatStatus)
 {
     formatStatus = 0;
     char* buffer = bufferRef.first;
@@ -334,7 +347,7 @@ std::shared_ptr<StructBase> RemoteEntityFormatJson::parse(const IProtocolSession
         assert(sizeData >= 0);
 
         BufferRef bufferRefData = {buffer, sizeData};
-        data = parseData(session, bufferRefData, storeRawData, header.type, formatStatus, typeOfGeneralMessage);
+        data = parseData(session, bufferRefData, storeRawData, arena, header.type, formatStatus, typeOfGeneralMessage);
     }
 
     return data;
@@ -342,7 +355,7 @@ std::shared_ptr<StructBase> RemoteEntityFormatJson::parse(const IProtocolSession
 
 
 
-std::shared_ptr<StructBase> RemoteEntityFormatJson::parseData(const IProtocolSessionPtr& /*session*/, const BufferRef& bufferRef, bool storeRawData, std::string& type, int& formatStatus, const std::string& typeOfGeneralMessage)
+std::shared_ptr<StructBase> RemoteEntityFormatJson::parseData(const IProtocolSessionPtr& /*session*/, const BufferRef& bufferRef, bool storeRawData, const std::shared_ptr<std::pmr::memory_resource>& arena, std::string& type, int& formatStatus, const std::string& typeOfGeneralMessage)
 {
     formatStatus = 0;
     const char* buffer = bufferRef.first;
@@ -354,7 +367,7 @@ std::shared_ptr<StructBase> RemoteEntityFormatJson::parseData(const IProtocolSes
     assert(sizeData >= 0);
     if (!type.empty())
     {
-        data = StructFactoryRegistry::instance().createStruct(type);
+        data = StructFactoryRegistry::instance().createStruct(type, arena);
 
         if (data)
         {
@@ -24,10 +24,6 @@
 
 #include "finalmq/helpers/ModulenameFinalmq.h"
 #include "finalmq/remoteentity/entitydata.fmq.h"
-#include "finalmq/serializeproto/ParserProto.h"
-#include "finalmq/serializeproto/SerializerProto.h"
-#include "finalmq/serializestruct/ParserStruct.h"
-#include "finalmq/serializestruct/SerializerStruct.h"
 #include "finalmq/serializestruct/StructFactoryRegistry.h"
 
 using finalmq::Header;
@@ -38,6 +34,8 @@ namespace finalmq
 const int RemoteEntityFormatProto::CONTENT_TYPE = 1;
 const std::string RemoteEntityFormatProto::CONTENT_TYPE_NAME = "protobuf";
 
+const std::string RemoteEntityFormatProto::PROPERTY_SERIALIZE_CANONICAL = "canonical";
+
 //static const std::string FMQ_METHOD = "fmq_method";
 
 struct RegisterFormatProto
@@ -50,13 +48,11 @@ struct RegisterFormatProto
 
 #define PROTOBUFBLOCKSIZE 512
 
-void RemoteEntityFormatProto::serialize(const IProtocolSessionPtr& session, IMessage& message, const Header& header, const StructBase* structBase)
+static void serializeHeader(IMessage& message, const Header& header)
 {
     char* bufferSizeHeader = message.addSendPayload(4, PROTOBUFBLOCKSIZE);
 
-    SerializerProto serializerHeader(message, PROTOBUFBLOCKSIZE);
-    ParserStruct parserHeader(serializerHeader, header);
-    parserHeader.parseStruct();
+    header.serializeProto(message);
     ssize_t sizeHeader = message.getTotalSendPayloadSize() - 4;
     assert(sizeHeader >= 0);
     size_t uSizeHeader = sizeHeader;
@@ -68,11 +64,22 @@ void RemoteEntityFormatProto::serialize(const IProtocolSessionPtr& session, IMes
     *bufferSizeHeader = static_cast<unsigned char>(uSizeHeader >> 16);
     ++bufferSizeHeader;
     *bufferSizeHeader = static_cast<unsigned char>(uSizeHeader >> 24);
+}
 
+void RemoteEntityFormatProto::serialize(const IProtocolSessionPtr& session, IMessage& message, const Header& header, const StructBase* structBase)
+{
+    serializeHeader(message, header);
     serializeData(session, message, structBase);
 }
 
-void RemoteEntityFormatProto::serializeData(const IProtocolSessionPtr& /*session*/, IMessage& message, const StructBase* structBase)
+bool RemoteEntityFormatProto::serializeWithData(const IProtocolSessionPtr& /*session*/, IMessage& message, const Header& header, const std::shared_ptr<const std::string>& serializedData)
+{
+    serializeHeader(message, header);
+    message.addSendPayload(serializedData);
+    return true;
+}
+
+void RemoteEntityFormatProto::serializeData(const IProtocolSessionPtr& session, IMessage& message, const StructBase* structBase)
 {
     char* bufferSizePayload = message.addSendPayload(4, PROTOBUFBLOCKSIZE);
     ssize_t sizePayload = 0;
@@ -94,9 +101,24 @@ void RemoteEntityFormatProto::serializeData(const IProtocolSessionPtr& /*session
         }
         else if (structBase->getStructInfo().getTypeName() != finalmq::RawDataMessage::structInfo().getTypeName())
         {
-            SerializerProto serializerData(message);
-            ParserStruct parserData(serializerData, *structBase);
-            parserData.parseStruct();
+            bool canonical = false;
+            const Variant& formatData = session->getFormatData();
+            if (formatData.getType() != VARTYPE_NONE)
+            {
+                const bool* propCanonical = formatData.getData<bool>(PROPERTY_SERIALIZE_CANONICAL);
+                if (propCanonical != nullptr)
+                {
+                    canonical = *propCanonical;
+                }
+            }
+            if (canonical)
+            {
+                structBase->serializeProtoCanonical(message);
+            }
+            else
+            {
+                structBase->serializeProto(message);
+            }
         }
         ssize_t sizeEnd = message.getTotalSendPayloadSize();
         sizePayload = sizeEnd - sizeStart;
@@ -112,7 +134,7 @@ void RemoteEntityFormatProto::serializeData(const IProtocolSessionPtr& /*session
     *bufferSizePayload = static_cast<unsigned char>(uSizePayload >> 24);
 }
 
-std::shared_ptr<StructBase> RemoteEntityFormatProto::parse(const IProtocolSessionPtr& session, const BufferRef& bufferRef, bool storeRawData, const std::unordered_map<std::string, std::pair<EntityId, hybrid_ptr<IRemoteEntity>>>& name2Entity, Header& header, int& formatStatus)
+std::shared_ptr<StructBase> RemoteEntityFormatProto::parse(const IProtocolSessionPtr& session, const BufferRef& bufferRef, bool storeRawData, const std::shared_ptr<std::pmr::memory_resource>& arena, const std::unordered_map<std::string, std::pair<EntityId, hybrid_ptr<IRemoteEntity>>>& name2Entity, Header& header, int& formatStatus)
 {
     formatStatus = 0;
     char* buffer = bufferRef.first;
@@ -142,9 +164,7 @@ std::shared_ptr<StructBase> RemoteEntityFormatProto::parse(const IProtocolSessio
 
     if (sizeHeader <= sizePayload)
     {
-        SerializerStruct serializerHeader(header);
-        ParserProto parserHeader(serializerHeader, buffer, sizeHeader);
-        ok = parserHeader.parseStruct(Header::structInfo().getTypeName());
+        ok = header.parseProto(buffer, sizeHeader);
         if (header.type.empty() && !header.path.empty())
         {
             hybrid_ptr<IRemoteEntity> remoteEntity;
@@ -186,13 +206,13 @@ std::shared_ptr<StructBase> RemoteEntityFormatProto::parse(const IProtocolSessio
         buffer += sizeHeader;
 
         BufferRef bufferRefData = {buffer, sizeData};
-        data = parseData(session, bufferRefData, storeRawData, header.type, formatStatus, typeOfGeneralMessage);
+        data = parseData(session, bufferRefData, storeRawData, arena, header.type, formatStatus, typeOfGeneralMessage);
     }
 
     return data;
 }
 
-std::shared_ptr<StructBase> RemoteEntityFormatProto::parseData(const IProtocolSessionPtr& /*session*/, const BufferRef& bufferRef, bool storeRawData, std::string& type, int& formatStatus, const std::string& typeOfGeneralMessage)
+std::shared_ptr<StructBase> RemoteEntityFormatProto::parseData(const IProtocolSessionPtr& /*session*/, const BufferRef& bufferRef, bool storeRawData, const std::shared_ptr<std::pmr::memory_resource>& arena, std::string& type, int& formatStatus, const std::string& typeOfGeneralMessage)
 {
     formatStatus = 0;
     const char* buffer = bufferRef.first;
@@ -236,15 +256,13 @@ std::shared_ptr<StructBase> RemoteEntityFormatProto::parseData(const IProtocolSe
 
         if (ok)
         {
-            data = StructFactoryRegistry::instance().createStruct(type);
+            data = StructFactoryRegistry::instance().createStruct(type, arena);
             if (data)
             {
                 if (type != GeneralMessage::structInfo().getTypeName() || typeOfGeneralMessage.empty())
                 {
                     assert(sizeDataInStream >= 0);
-                    SerializerStruct serializerData(*data);
-                    ParserProto parserData(serializerData, buffer, sizeDataInStream);
-                    ok = parserData.parseStruct(type);
+                    ok = data->parseProto(buffer, sizeDataInStream);
                     if (!ok)
                     {
                         formatStatus |= FORMATSTATUS_SYNTAX_ERROR;
@@ -27,6 +27,7 @@
 
 #include "finalmq/helpers/ModulenameFinalmq.h"
 #include "finalmq/protocolsession/ProtocolMessage.h"
+#include "finalmq/protocolsession/ProtocolMessagePool.h"
 #include "finalmq/remoteentity/entitydata.fmq.h"
 #include "finalmq/variant/Variant.h"
 #include "finalmq/variant/VariantValueStruct.h"
@@ -135,6 +136,51 @@ bool RemoteEntityFormatRegistryImpl::serializeData(const IProtocolSessionPtr& se
     return false;
 }
 
+bool RemoteEntityFormatRegistryImpl::serializeCached(const IProtocolSessionPtr& session, IMessage& message, const Header& header, const StructBase* structBase, bool withHeader, SerializedDataCache& serializedDataCache)
+{
+    int contentType = session->getContentType();
+    auto it = m_contentTypeToFormat.find(contentType);
+    if (it == m_contentTypeToFormat.end())
+    {
+        return false;
+    }
+    assert(it->second);
+    IRemoteEntityFormat& format = *it->second;
+
+    const Variant& formatData = session->getFormatData();
+    std::shared_ptr<const std::string> data;
+    for (const auto& entry : serializedDataCache.entries)
+    {
+        if (entry.contentType == contentType && entry.formatData == formatData)
+        {
+            data = entry.data;
+            break;
+        }
+    }
+    if (data == nullptr)
+    {
+        IMessagePtr messageData = ProtocolMessagePool::createMessage(0);
+        format.serializeData(session, *messageData, structBase);
+        std::shared_ptr<std::string> dataNew = std::make_shared<std::string>();
+        dataNew->reserve(messageData->getTotalSendPayloadSize());
+        const std::list<BufferRef>& payloads = messageData->getAllSendPayloads();
+        for (auto itPayload = payloads.begin(); itPayload != payloads.end(); ++itPayload)
+        {
+            dataNew->append(itPayload->first, itPayload->second);
+        }
+        data = dataNew;
+        serializedDataCache.entries.push_back({contentType, formatData, data});
+    }
+
+    // the messages of all peers reference the same serialized data
+    if (withHeader)
+    {
+        return format.serializeWithData(session, message, header, data);
+    }
+    message.addSendPayload(data);
+    return true;
+}
+
 inline static bool shallSend(const Header& header, const IProtocolSessionPtr& session)
 {
     if ((header.mode != MsgMode::MSG_REPLY) || (header.corrid != CORRELATIONID_NONE) || session->needsReply())
@@ -219,7 +265,7 @@ static void metainfoToHeader(Header& header, IMessage::Metainfo& metainfo)
     metainfo.clear();
 }
 
-void RemoteEntityFormatRegistryImpl::send(const IProtocolSessionPtr& session, const std::string& virtualSessionId, Header& header, Variant&& echoData, const StructBase* structBase, IMessage::Metainfo* metainfo, Variant* controlData)
+void RemoteEntityFormatRegistryImpl::send(const IProtocolSessionPtr& session, const std::string& virtualSessionId, Header& header, Variant&& echoData, const StructBase* structBase, IMessage::Metainfo* metainfo, Variant* controlData, SerializedDataCache* serializedDataCache)
 {
     assert(session);
     if (shallSend(header, session))
@@ -289,13 +335,21 @@ void RemoteEntityFormatRegistryImpl::send(const IProtocolSessionPtr& session, co
         if (pureData == nullptr)
         {
             bool ok = false;
-            if (!session->doesSupportMetainfo() || (session->isSendRequestByPoll() && header.mode == MsgMode::MSG_REQUEST))
+            bool withHeader = (!session->doesSupportMetainfo() || (session->isSendRequestByPoll() && header.mode == MsgMode::MSG_REQUEST));
+            if (serializedDataCache && structBase)
             {
-                ok = serialize(session, *message, header, structBase);
+                ok = serializeCached(session, *message, header, structBase, withHeader, *serializedDataCache);
             }
-            else
+            if (!ok)
             {
-                ok = serializeData(session, *message, structBase);
+                if (withHeader)
+                {
+                    ok = serialize(session, *message, header, structBase);
+                }
+                else
+                {
+                    ok = serializeData(session, *message, structBase);
+                }
             }
             if (!ok)
             {
@@ -515,7 +569,7 @@ std::string RemoteEntityFormatRegistryImpl::parseMetainfo(IMessage& message, con
     return data;
 }
 
-std::shared_ptr<StructBase> RemoteEntityFormatRegistryImpl::parseHeaderInMetainfo(const IProtocolSessionPtr& session, IMessage& message, bool storeRawData, const std::unordered_map<std::string, std::pair<EntityId, hybrid_ptr<IRemoteEntity>>>& name2Entity, Header& header, int& formatStatus)
+std::shared_ptr<StructBase> RemoteEntityFormatRegistryImpl::parseHeaderInMetainfo(const IProtocolSessionPtr& session, IMessage& message, bool storeRawData, const std::shared_ptr<std::pmr::memory_resource>& arena, const std::unordered_map<std::string, std::pair<EntityId, hybrid_ptr<IRemoteEntity>>>& name2Entity, Header& header, int& formatStatus)
 {
     std::string typeOfGeneralMessage;
     std::string data = parseMetainfo(message, name2Entity, header, typeOfGeneralMessage);
@@ -539,7 +593,7 @@ std::shared_ptr<StructBase> RemoteEntityFormatRegistryImpl::parseHeaderInMetainf
         if (it != m_contentTypeToFormat.end())
         {
             assert(it->second);
-            structBase = it->second->parseData(session, bufferRef, storeRawData, header.type, formatStatus, typeOfGeneralMessage);
+            structBase = it->second->parseData(session, bufferRef, storeRawData, arena, header.type, formatStatus, typeOfGeneralMessage);
         }
     }
     else
@@ -552,7 +606,7 @@ std::shared_ptr<StructBase> RemoteEntityFormatRegistryImpl::parseHeaderInMetainf
     return structBase;
 }
 
-std::shared_ptr<StructBase> RemoteEntityFormatRegistryImpl::parse(const IProtocolSessionPtr& session, IMessage& message, bool storeRawData, const std::unordered_map<std::string, std::pair<EntityId, hybrid_ptr<IRemoteEntity>>>& name2Entity, Header& header, int& formatStatus)
+std::shared_ptr<StructBase> RemoteEntityFormatRegistryImpl::parse(const IProtocolSessionPtr& session, IMessage& message, bool storeRawData, const std::shared_ptr<std::pmr::memory_resource>& arena, const std::unordered_map<std::string, std::pair<EntityId, hybrid_ptr<IRemoteEntity>>>& name2Entity, Header& header, int& formatStatus)
 {
     formatStatus = 0;
     BufferRef bufferRef = message.getReceivePayload();
@@ -564,7 +618,7 @@ std::shared_ptr<StructBase> RemoteEntityFormatRegistryImpl::parse(const IProtoco
     if (it != m_contentTypeToFormat.end())
     {
         assert(it->second);
-        structBase = it->second->parse(session, bufferRef, storeRawData, name2Entity, header, formatStatus);
+        structBase = it->second->parse(session, bufferRef, storeRawData, arena, name2Entity, header, formatStatus);
         metainfoToMessage(message, header.meta);
     }
 
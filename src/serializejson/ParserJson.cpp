@@ -908,12 +908,12 @@ void ParserJson::exitObject()
     }
 }
 
-void ParserJson::enterKey(const char* key, ssize_t size)
+void ParserJson::enterKey(std::string&& key)
 {
-    enterKey(std::string(key, size));
+    enterKey(key.c_str(), key.size());
 }
 
-void ParserJson::enterKey(std::string&& key)
+void ParserJson::enterKey(const char* key, ssize_t size)
 {
     if (m_jsonTypeActive > 0)
     {
@@ -922,7 +922,7 @@ void ParserJson::enterKey(std::string&& key)
     m_fieldCurrent = nullptr;
     if (m_structCurrent)
     {
-        m_fieldCurrent = m_structCurrent->getFieldByName(key);
+        m_fieldCurrent = m_structCurrent->getFieldByName(std::string_view(key, size));
         if (m_fieldCurrent && (m_fieldCurrent->typeId == TYPE_JSON))
         {
             assert(m_jsonTypeActive == 0);
@@ -30,26 +30,31 @@
 #include "finalmq/helpers/base64.h"
 #include "finalmq/helpers/ZeroCopyBuffer.h"
 #include "finalmq/metadata/MetaData.h"
-#include "finalmq/serialize/ParserAbortAndIndex.h"
-#include "finalmq/serialize/ParserProcessDefaultValues.h"
+#include "finalmq/serialize/ParserAbortAndIndexImpl.h"
+#include "finalmq/serialize/ParserConverterImpl.h"
+#include "finalmq/serialize/ParserProcessDefaultValuesImpl.h"
 #include "finalmq/jsonvariant/VariantToJson.h"
 
 namespace finalmq
 {
+template class ParserAbortAndIndexT<SerializerJsonInternal>;
+template class ParserProcessDefaultValuesT<ParserStage<ParserAbortAndIndexT, SerializerJsonInternal>>;
+template class ParserConverterT<ParserStage<ParserProcessDefaultValuesT, ParserStage<ParserAbortAndIndexT, SerializerJsonInternal>>>;
+
 SerializerJson::SerializerJson(IZeroCopyBuffer& buffer, int maxBlockSize, bool enumAsString, bool skipDefaultValues)
-    : ParserConverter(), m_internal(buffer, maxBlockSize, enumAsString), m_parserAbortAndIndex(), m_parserProcessDefaultValues()
+    : ParserConverterT(&m_parserProcessDefaultValues)
+    , m_internal(buffer, maxBlockSize, enumAsString)
+    , m_parserAbortAndIndex(&m_internal)
+    , m_parserProcessDefaultValues(skipDefaultValues, &m_parserAbortAndIndex)
 {
-    m_parserAbortAndIndex = std::make_unique<ParserAbortAndIndex>(&m_internal);
-    m_parserProcessDefaultValues = std::make_unique<ParserProcessDefaultValues>(skipDefaultValues, m_parserAbortAndIndex.get());
-    ParserConverter::setVisitor(*m_parserProcessDefaultValues);
 }
 
-SerializerJson::Internal::Internal(IZeroCopyBuffer& buffer, int maxBlockSize, bool enumAsString)
+SerializerJsonInternal::SerializerJsonInternal(IZeroCopyBuffer& buffer, int maxBlockSize, bool enumAsString)
     : m_uniqueJsonBuilder(std::make_unique<JsonBuilder>(buffer, maxBlockSize)), m_jsonBuilder(*m_uniqueJsonBuilder.get()), m_enumAsString(enumAsString)
 {
 }
 
-void SerializerJson::Internal::setKey(const MetaField& field)
+void SerializerJsonInternal::setKey(const MetaField& field)
 {
     const std::string& name = field.name;
     if (!name.empty())
@@ -59,115 +64,115 @@ void SerializerJson::Internal::setKey(const MetaField& field)
 }
 
 // IParserVisitor
-void SerializerJson::Internal::notifyError(const char* /*str*/, const char* /*message*/)
+void SerializerJsonInternal::notifyError(const char* /*str*/, const char* /*message*/)
 {
 }
 
-void SerializerJson::Internal::startStruct(const MetaStruct& /*stru*/)
+void SerializerJsonInternal::startStruct(const MetaStruct& /*stru*/)
 {
     // outer curly brackets
     m_jsonBuilder.enterObject();
 }
 
-void SerializerJson::Internal::finished()
+void SerializerJsonInternal::finished()
 {
     // outer curly brackets
     m_jsonBuilder.exitObject();
     m_jsonBuilder.finished();
 }
 
-void SerializerJson::Internal::enterStruct(const MetaField& field)
+void SerializerJsonInternal::enterStruct(const MetaField& field)
 {
     setKey(field);
     m_jsonBuilder.enterObject();
 }
 
-void SerializerJson::Internal::exitStruct(const MetaField& /*field*/)
+void SerializerJsonInternal::exitStruct(const MetaField& /*field*/)
 {
     m_jsonBuilder.exitObject();
 }
 
-void SerializerJson::Internal::enterStructNull(const MetaField& field)
+void SerializerJsonInternal::enterStructNull(const MetaField& field)
 {
     setKey(field);
     m_jsonBuilder.enterNull();
 }
 
-void SerializerJson::Internal::enterArrayStruct(const MetaField& field)
+void SerializerJsonInternal::enterArrayStruct(const MetaField& field)
 {
     setKey(field);
     m_jsonBuilder.enterArray();
 }
 
-void SerializerJson::Internal::exitArrayStruct(const MetaField& /*field*/)
+void SerializerJsonInternal::exitArrayStruct(const MetaField& /*field*/)
 {
     m_jsonBuilder.exitArray();
 }
 
-void SerializerJson::Internal::enterBool(const MetaField& field, bool value)
+void SerializerJsonInternal::enterBool(const MetaField& field, bool value)
 {
     assert(field.typeId == MetaTypeId::TYPE_BOOL);
     setKey(field);
     m_jsonBuilder.enterBool(value);
 }
 
-void SerializerJson::Internal::enterInt8(const MetaField& field, std::int8_t value)
+void SerializerJsonInternal::enterInt8(const MetaField& field, std::int8_t value)
 {
     assert(field.typeId == MetaTypeId::TYPE_INT8);
     setKey(field);
     m_jsonBuilder.enterInt32(value);
 }
 
-void SerializerJson::Internal::enterUInt8(const MetaField& field, std::uint8_t value)
+void SerializerJsonInternal::enterUInt8(const MetaField& field, std::uint8_t value)
 {
     assert(field.typeId == MetaTypeId::TYPE_UINT8);
     setKey(field);
     m_jsonBuilder.enterUInt32(value);
 }
 
-void SerializerJson::Internal::enterInt16(const MetaField& field, std::int16_t value)
+void SerializerJsonInternal::enterInt16(const MetaField& field, std::int16_t value)
 {
     assert(field.typeId == MetaTypeId::TYPE_INT16);
     setKey(field);
     m_jsonBuilder.enterInt32(value);
 }
 
-void SerializerJson::Internal::enterUInt16(const MetaField& field, std::uint16_t value)
+void SerializerJsonInternal::enterUInt16(const MetaField& field, std::uint16_t value)
 {
     assert(field.typeId == MetaTypeId::TYPE_UINT16);
     setKey(field);
     m_jsonBuilder.enterUInt32(value);
 }
 
-void SerializerJson::Internal::enterInt32(const MetaField& field, std::int32_t value)
+void SerializerJsonInternal::enterInt32(const MetaField& field, std::int32_t value)
 {
     assert(field.typeId == MetaTypeId::TYPE_INT32);
     setKey(field);
     m_jsonBuilder.enterInt32(value);
 }
 
-void SerializerJson::Internal::enterUInt32(const MetaField& field, std::uint32_t value)
+void SerializerJsonInternal::enterUInt32(const MetaField& field, std::uint32_t value)
 {
     assert(field.typeId == MetaTypeId::TYPE_UINT32);
     setKey(field);
     m_jsonBuilder.enterUInt32(value);
 }
 
-void SerializerJson::Internal::enterInt64(const MetaField& field, std::int64_t value)
+void SerializerJsonInternal::enterInt64(const MetaField& field, std::int64_t value)
 {
     assert(field.typeId == MetaTypeId::TYPE_INT64);
     setKey(field);
     m_jsonBuilder.enterString(std::to_string(value));
 }
 
-void SerializerJson::Internal::enterUInt64(const MetaField& field, std::uint64_t value)
+void SerializerJsonInternal::enterUInt64(const MetaField& field, std::uint64_t value)
 {
     assert(field.typeId == MetaTypeId::TYPE_UINT64);
     setKey(field);
     m_jsonBuilder.enterString(std::to_string(value));
 }
 
-void SerializerJson::Internal::handleDouble(double value)
+void SerializerJsonInternal::handleDouble(double value)
 {
 #ifndef WIN32
 #pragma GCC diagnostic push
@@ -194,35 +199,35 @@ void SerializerJson::Internal::handleDouble(double value)
 #endif
 }
 
-void SerializerJson::Internal::enterFloat(const MetaField& field, float value)
+void SerializerJsonInternal::enterFloat(const MetaField& field, float value)
 {
     assert(field.typeId == MetaTypeId::TYPE_FLOAT);
     setKey(field);
     handleDouble(value);
 }
 
-void SerializerJson::Internal::enterDouble(const MetaField& field, double value)
+void SerializerJsonInternal::enterDouble(const MetaField& field, double value)
 {
     assert(field.typeId == MetaTypeId::TYPE_DOUBLE);
     setKey(field);
     handleDouble(value);
 }
 
-void SerializerJson::Internal::enterString(const MetaField& field, std::string&& value)
+void SerializerJsonInternal::enterString(const MetaField& field, std::string&& value)
 {
     assert(field.typeId == MetaTypeId::TYPE_STRING);
     setKey(field);
     m_jsonBuilder.enterString(value.c_str(), value.size());
 }
 
-void SerializerJson::Internal::enterString(const MetaField& field, const char* value, ssize_t size)
+void SerializerJsonInternal::enterString(const MetaField& field, const char* value, ssize_t size)
 {
     assert(field.typeId == MetaTypeId::TYPE_STRING);
     setKey(field);
     m_jsonBuilder.enterString(value, size);
 }
 
-void SerializerJson::Internal::enterBytes(const MetaField& field, Bytes&& value)
+void SerializerJsonInternal::enterBytes(const MetaField& field, Bytes&& value)
 {
     assert(field.typeId == MetaTypeId::TYPE_BYTES);
     setKey(field);
@@ -232,7 +237,7 @@ void SerializerJson::Internal::enterBytes(const MetaField& field, Bytes&& value)
     m_jsonBuilder.enterString(base64.data(), base64.size());
 }
 
-void SerializerJson::Internal::enterBytes(const MetaField& field, const BytesElement* value, ssize_t size)
+void SerializerJsonInternal::enterBytes(const MetaField& field, const BytesElement* value, ssize_t size)
 {
     assert(field.typeId == MetaTypeId::TYPE_BYTES);
     setKey(field);
@@ -242,7 +247,7 @@ void SerializerJson::Internal::enterBytes(const MetaField& field, const BytesEle
     m_jsonBuilder.enterString(base64.data(), base64.size());
 }
 
-void SerializerJson::Internal::enterEnum(const MetaField& field, std::int32_t value)
+void SerializerJsonInternal::enterEnum(const MetaField& field, std::int32_t value)
 {
     assert(field.typeId == MetaTypeId::TYPE_ENUM);
     setKey(field);
@@ -257,7 +262,7 @@ void SerializerJson::Internal::enterEnum(const MetaField& field, std::int32_t va
     }
 }
 
-void SerializerJson::Internal::enterEnum(const MetaField& field, std::string&& value)
+void SerializerJsonInternal::enterEnum(const MetaField& field, std::string&& value)
 {
     assert(field.typeId == MetaTypeId::TYPE_ENUM);
     setKey(field);
@@ -272,7 +277,7 @@ void SerializerJson::Internal::enterEnum(const MetaField& field, std::string&& v
     }
 }
 
-void SerializerJson::Internal::enterEnum(const MetaField& field, const char* value, ssize_t size)
+void SerializerJsonInternal::enterEnum(const MetaField& field, const char* value, ssize_t size)
 {
     assert(field.typeId == MetaTypeId::TYPE_ENUM);
     setKey(field);
@@ -287,17 +292,17 @@ void SerializerJson::Internal::enterEnum(const MetaField& field, const char* val
     }
 }
 
-void SerializerJson::Internal::enterJsonString(const MetaField& field, std::string&& value)
+void SerializerJsonInternal::enterJsonString(const MetaField& field, std::string&& value)
 {
     enterJsonString(field, value.c_str(), value.size());
 }
-void SerializerJson::Internal::enterJsonString(const MetaField& field, const char* value, ssize_t size)
+void SerializerJsonInternal::enterJsonString(const MetaField& field, const char* value, ssize_t size)
 {
     assert(field.typeId == MetaTypeId::TYPE_JSON);
     setKey(field);
     m_jsonBuilder.putJson(value, size);
 }
-void SerializerJson::Internal::enterJsonVariant(const MetaField& field, const Variant& value)
+void SerializerJsonInternal::enterJsonVariant(const MetaField& field, const Variant& value)
 {
     ZeroCopyBuffer buffer;
     VariantToJson variantToJson(buffer);
@@ -306,13 +311,13 @@ void SerializerJson::Internal::enterJsonVariant(const MetaField& field, const Va
 
     enterJsonString(field, json.c_str(), json.size());
 }
-void SerializerJson::Internal::enterJsonVariantMove(const MetaField& field, Variant&& value)
+void SerializerJsonInternal::enterJsonVariantMove(const MetaField& field, Variant&& value)
 {
     enterJsonVariant(field, value);
 }
 
 
-void SerializerJson::Internal::enterArrayBoolMove(const MetaField& field, std::vector<bool>&& value)
+void SerializerJsonInternal::enterArrayBoolMove(const MetaField& field, std::vector<bool>&& value)
 {
     assert(field.typeId == MetaTypeId::TYPE_ARRAY_BOOL);
     setKey(field);
@@ -323,7 +328,7 @@ void SerializerJson::Internal::enterArrayBoolMove(const MetaField& field, std::v
     m_jsonBuilder.exitArray();
 }
 
-void SerializerJson::Internal::enterArrayBool(const MetaField& field, const std::vector<bool>& value)
+void SerializerJsonInternal::enterArrayBool(const MetaField& field, const std::vector<bool>& value)
 {
     assert(field.typeId == MetaTypeId::TYPE_ARRAY_BOOL);
     setKey(field);
@@ -334,12 +339,12 @@ void SerializerJson::Internal::enterArrayBool(const MetaField& field, const std:
     m_jsonBuilder.exitArray();
 }
 
-void SerializerJson::Internal::enterArrayInt8(const MetaField& field, std::vector<std::int8_t>&& value)
+void SerializerJsonInternal::enterArrayInt8(const MetaField& field, std::vector<std::int8_t>&& value)
 {
     enterArrayInt8(field, value.data(), value.size());
 }
 
-void SerializerJson::Internal::enterArrayInt8(const MetaField& field, const std::int8_t* value, ssize_t size)
+void SerializerJsonInternal::enterArrayInt8(const MetaField& field, const std::int8_t* value, ssize_t size)
 {
     assert(field.typeId == MetaTypeId::TYPE_ARRAY_INT8);
     setKey(field);
@@ -350,12 +355,12 @@ void SerializerJson::Internal::enterArrayInt8(const MetaField& field, const std:
     m_jsonBuilder.exitArray();
 }
 
-void SerializerJson::Internal::enterArrayInt16(const MetaField& field, std::vector<std::int16_t>&& value)
+void SerializerJsonInternal::enterArrayInt16(const MetaField& field, std::vector<std::int16_t>&& value)
 {
     enterArrayInt16(field, value.data(), value.size());
 }
 
-void SerializerJson::Internal::enterArrayInt16(const MetaField& field, const std::int16_t* value, ssize_t size)
+void SerializerJsonInternal::enterArrayInt16(const MetaField& field, const std::int16_t* value, ssize_t size)
 {
     assert(field.typeId == MetaTypeId::TYPE_ARRAY_INT16);
     setKey(field);
@@ -366,12 +371,12 @@ void SerializerJson::Internal::enterArrayInt16(const MetaField& field, const std
     m_jsonBuilder.exitArray();
 }
 
-void SerializerJson::Internal::enterArrayUInt16(const MetaField& field, std::vector<std::uint16_t>&& value)
+void SerializerJsonInternal::enterArrayUInt16(const MetaField& field, std::vector<std::uint16_t>&& value)
 {
     enterArrayUInt16(field, value.data(), value.size());
 }
 
-void SerializerJson::Internal::enterArrayUInt16(const MetaField& field, const std::uint16_t* value, ssize_t size)
+void SerializerJsonInternal::enterArrayUInt16(const MetaField& field, const std::uint16_t* value, ssize_t size)
 {
     assert(field.typeId == MetaTypeId::TYPE_ARRAY_UINT16);
     setKey(field);
@@ -382,12 +387,12 @@ void SerializerJson::Internal::enterArrayUInt16(const MetaField& field, const st
     m_jsonBuilder.exitArray();
 }
 
-void SerializerJson::Internal::enterArrayInt32(const MetaField& field, std::vector<std::int32_t>&& value)
+void SerializerJsonInternal::enterArrayInt32(const MetaField& field, std::vector<std::int32_t>&& value)
 {
     enterArrayInt32(field, value.data(), value.size());
 }
 
-void SerializerJson::Internal::enterArrayInt32(const MetaField& field, const std::int32_t* value, ssize_t size)
+void SerializerJsonInternal::enterArrayInt32(const MetaField& field, const std::int32_t* value, ssize_t size)
 {
     assert(field.typeId == MetaTypeId::TYPE_ARRAY_INT32);
     setKey(field);
@@ -398,12 +403,12 @@ void SerializerJson::Internal::enterArrayInt32(const MetaField& field, const std
     m_jsonBuilder.exitArray();
 }
 
-void SerializerJson::Internal::enterArrayUInt32(const MetaField& field, std::vector<std::uint32_t>&& value)
+void SerializerJsonInternal::enterArrayUInt32(const MetaField& field, std::vector<std::uint32_t>&& value)
 {
     enterArrayUInt32(field, value.data(), value.size());
 }
 
-void SerializerJson::Internal::enterArrayUInt32(const MetaField& field, const std::uint32_t* value, ssize_t size)
+void SerializerJsonInternal::enterArrayUInt32(const MetaField& field, const std::uint32_t* value, ssize_t size)
 {
     assert(field.typeId == MetaTypeId::TYPE_ARRAY_UINT32);
     setKey(field);
@@ -414,12 +419,12 @@ void SerializerJson::Internal::enterArrayUInt32(const MetaField& field, const st
     m_jsonBuilder.exitArray();
 }
 
-void SerializerJson::Internal::enterArrayInt64(const MetaField& field, std::vector<std::int64_t>&& value)
+void SerializerJsonInternal::enterArrayInt64(const MetaField& field, std::vector<std::int64_t>&& value)
 {
     enterArrayInt64(field, value.data(), value.size());
 }
 
-void SerializerJson::Internal::enterArrayInt64(const MetaField& field, const std::int64_t* value, ssize_t size)
+void SerializerJsonInternal::enterArrayInt64(const MetaField& field, const std::int64_t* value, ssize_t size)
 {
     assert(field.typeId == MetaTypeId::TYPE_ARRAY_INT64);
     setKey(field);
@@ -430,12 +435,12 @@ void SerializerJson::Internal::enterArrayInt64(const MetaField& field, const std
     m_jsonBuilder.exitArray();
 }
 
-void SerializerJson::Internal::enterArrayUInt64(const MetaField& field, std::vector<std::uint64_t>&& value)
+void SerializerJsonInternal::enterArrayUInt64(const MetaField& field, std::vector<std::uint64_t>&& value)
 {
     enterArrayUInt64(field, value.data(), value.size());
 }
 
-void SerializerJson::Internal::enterArrayUInt64(const MetaField& field, const std::uint64_t* value, ssize_t size)
+void SerializerJsonInternal::enterArrayUInt64(const MetaField& field, const std::uint64_t* value, ssize_t size)
 {
     assert(field.typeId == MetaTypeId::TYPE_ARRAY_UINT64);
     setKey(field);
@@ -446,12 +451,12 @@ void SerializerJson::Internal::enterArrayUInt64(const MetaField& field, const st
     m_jsonBuilder.exitArray();
 }
 
-void SerializerJson::Internal::enterArrayFloat(const MetaField& field, std::vector<float>&& value)
+void SerializerJsonInternal::enterArrayFloat(const MetaField& field, std::vector<float>&& value)
 {
     enterArrayFloat(field, value.data(), value.size());
 }
 
-void SerializerJson::Internal::enterArrayFloat(const MetaField& field, const float* value, ssize_t size)
+void SerializerJsonInternal::enterArrayFloat(const MetaField& field, const float* value, ssize_t size)
 {
     assert(field.typeId == MetaTypeId::TYPE_ARRAY_FLOAT);
     setKey(field);
@@ -462,12 +467,12 @@ void SerializerJson::Internal::enterArrayFloat(const MetaField& field, const flo
     m_jsonBuilder.exitArray();
 }
 
-void SerializerJson::Internal::enterArrayDouble(const MetaField& field, std::vector<double>&& value)
+void SerializerJsonInternal::enterArrayDouble(const MetaField& field, std::vector<double>&& value)
 {
     enterArrayDouble(field, value.data(), value.size());
 }
 
-void SerializerJson::Internal::enterArrayDouble(const MetaField& field, const double* value, ssize_t size)
+void SerializerJsonInternal::enterArrayDouble(const MetaField& field, const double* value, ssize_t size)
 {
     assert(field.typeId == MetaTypeId::TYPE_ARRAY_DOUBLE);
     setKey(field);
@@ -478,12 +483,12 @@ void SerializerJson::Internal::enterArrayDouble(const MetaField& field, const do
     m_jsonBuilder.exitArray();
 }
 
-void SerializerJson::Internal::enterArrayStringMove(const MetaField& field, std::vector<std::string>&& value)
+void SerializerJsonInternal::enterArrayStringMove(const MetaField& field, std::vector<std::string>&& value)
 {
     enterArrayString(field, value);
 }
 
-void SerializerJson::Internal::enterArrayString(const MetaField& field, const std::vector<std::string>& value)
+void SerializerJsonInternal::enterArrayString(const MetaField& field, const std::vector<std::string>& value)
 {
     assert(field.typeId == MetaTypeId::TYPE_ARRAY_STRING);
     setKey(field);
@@ -494,12 +499,12 @@ void SerializerJson::Internal::enterArrayString(const MetaField& field, const st
     m_jsonBuilder.exitArray();
 }
 
-void SerializerJson::Internal::enterArrayBytesMove(const MetaField& field, std::vector<Bytes>&& value)
+void SerializerJsonInternal::enterArrayBytesMove(const MetaField& field, std::vector<Bytes>&& value)
 {
     enterArrayBytes(field, value);
 }
 
-void SerializerJson::Internal::enterArrayBytes(const MetaField& field, const std::vector<Bytes>& value)
+void SerializerJsonInternal::enterArrayBytes(const MetaField& field, const std::vector<Bytes>& value)
 {
     assert(field.typeId == MetaTypeId::TYPE_ARRAY_BYTES);
     setKey(field);
@@ -513,12 +518,12 @@ void SerializerJson::Internal::enterArrayBytes(const MetaField& field, const std
     m_jsonBuilder.exitArray();
 }
 
-void SerializerJson::Internal::enterArrayEnum(const MetaField& field, std::vector<std::int32_t>&& value)
+void SerializerJsonInternal::enterArrayEnum(const MetaField& field, std::vector<std::int32_t>&& value)
 {
     enterArrayEnum(field, value.data(), value.size());
 }
 
-void SerializerJson::Internal::enterArrayEnum(const MetaField& field, const std::int32_t* value, ssize_t size)
+void SerializerJsonInternal::enterArrayEnum(const MetaField& field, const std::int32_t* value, ssize_t size)
 {
     assert(field.typeId == MetaTypeId::TYPE_ARRAY_ENUM);
     setKey(field);
@@ -541,12 +546,12 @@ void SerializerJson::Internal::enterArrayEnum(const MetaField& field, const std:
     m_jsonBuilder.exitArray();
 }
 
-void SerializerJson::Internal::enterArrayEnumMove(const MetaField& field, std::vector<std::string>&& value)
+void SerializerJsonInternal::enterArrayEnumMove(const MetaField& field, std::vector<std::string>&& value)
 {
     enterArrayEnum(field, value);
 }
 
-void SerializerJson::Internal::enterArrayEnum(const MetaField& field, const std::vector<std::string>& value)
+void SerializerJsonInternal::enterArrayEnum(const MetaField& field, const std::vector<std::string>& value)
 {
     assert(field.typeId == MetaTypeId::TYPE_ARRAY_ENUM);
     setKey(field);
@@ -0,0 +1,103 @@
+//MIT License
+
+//Copyright (c) 2020 bexoft GmbH (mail@bexoft.de)
+
+//Permission is hereby granted, free of charge, to any person obtaining a copy
+//of this software and associated documentation files (the "Software"), to deal
+//in the Software without restriction, including without limitation the rights
+//to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//copies of the Software, and to permit persons to whom the Software is
+//furnished to do so, subject to the following conditions:
+
+//The above copyright notice and this permission notice shall be included in all
+//copies or substantial portions of the Software.
+
+//THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//SOFTWARE.
+
+#include "finalmq/serializeproto/ParserProtoDirect.h"
+
+#include "finalmq/serializeproto/ParserProto.h"
+#include "finalmq/serializestruct/SerializerStruct.h"
+
+namespace finalmq
+{
+void ParserProtoDirect::skip()
+{
+    switch (getWireType())
+    {
+    case WIRETYPE_VARINT:
+        parseVarint();
+        break;
+    case WIRETYPE_FIXED64:
+        m_ptr += sizeof(std::uint64_t);
+        m_size -= sizeof(std::uint64_t);
+        break;
+    case WIRETYPE_LENGTH_DELIMITED:
+        {
+            std::uint64_t len = parseVarint();
+            if (m_ptr)
+            {
+                m_ptr += len;
+                m_size -= len;
+            }
+        }
+        break;
+    case WIRETYPE_FIXED32:
+        m_ptr += sizeof(std::uint32_t);
+        m_size -= sizeof(std::uint32_t);
+        break;
+    default:
+        setInvalid();
+        break;
+    }
+    if (m_size < 0)
+    {
+        setInvalid();
+    }
+}
+
+ssize_t ParserProtoDirect::countEntries() const
+{
+    if (getWireType() != WIRETYPE_LENGTH_DELIMITED)
+    {
+        return 0;
+    }
+    ParserProtoDirect scanner(*this);
+    ssize_t count = 0;
+    while (true)
+    {
+        scanner.skip();
+        if (scanner.m_ptr == nullptr)
+        {
+            break;
+        }
+        ++count;
+        if (scanner.m_size <= 0 || static_cast<std::uint32_t>(scanner.parseVarint()) != m_tag)
+        {
+            break;
+        }
+    }
+    return count;
+}
+
+bool ParserProtoDirect::readStructFallback(StructBase& structBase)
+{
+    if (m_ptr == nullptr)
+    {
+        return false;
+    }
+    SerializerStruct serializer(structBase);
+    ParserProto parser(serializer, m_ptr, m_size);
+    bool res = parser.parseStruct(structBase.getStructInfo().getTypeName());
+    m_ptr += m_size;
+    m_size = 0;
+    return res;
+}
+
+} // namespace finalmq
@@ -0,0 +1,122 @@
+//MIT License
+
+//Copyright (c) 2020 bexoft GmbH (mail@bexoft.de)
+
+//Permission is hereby granted, free of charge, to any person obtaining a copy
+//of this software and associated documentation files (the "Software"), to deal
+//in the Software without restriction, including without limitation the rights
+//to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//copies of the Software, and to permit persons to whom the Software is
+//furnished to do so, subject to the following conditions:
+
+//The above copyright notice and this permission notice shall be included in all
+//copies or substantial portions of the Software.
+
+//THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//SOFTWARE.
+
+
+#include "finalmq/serializeproto/ProtoView.h"
+
+namespace finalmq
+{
+// the ids of the generated structs are the field indexes + 1, higher ids are unknown fields
+static constexpr int MAX_INDEXED_ID = 1024;
+
+ProtoView::ProtoView(const char* buffer, ssize_t size)
+    : m_buffer(buffer), m_size(size)
+{
+    if (m_buffer == nullptr || m_size < 0)
+    {
+        m_buffer = nullptr;
+        m_size = 0;
+        m_valid = (size == 0);
+    }
+}
+
+bool ProtoView::isValid() const
+{
+    buildIndex();
+    return m_valid;
+}
+
+bool ProtoView::hasField(int id) const
+{
+    buildIndex();
+    return (id >= 0 && id < static_cast<int>(m_fields.size()) && m_fields[id].ptr != nullptr);
+}
+
+void ProtoView::buildIndex() const
+{
+    if (m_indexed)
+    {
+        return;
+    }
+    m_indexed = true;
+    if (m_buffer == nullptr)
+    {
+        return;
+    }
+
+    ParserProtoDirect parser(m_buffer, m_size);
+    while (parser.next())
+    {
+        const int id = parser.getId();
+        if (id < MAX_INDEXED_ID)
+        {
+            if (id >= static_cast<int>(m_fields.size()))
+            {
+                m_fields.resize(id + 1);
+            }
+            m_fields[id] = {parser.m_ptr, parser.m_tag};
+        }
+        parser.skip();
+    }
+    if (parser.m_ptr == nullptr)
+    {
+        // corrupt data, the fields that were found before the corruption are still readable
+        m_valid = false;
+    }
+}
+
+ParserProtoDirect ProtoView::getParser(int id) const
+{
+    if (hasField(id))
+    {
+        const FieldPosition& position = m_fields[id];
+        ParserProtoDirect parser(position.ptr, m_buffer + m_size - position.ptr);
+        parser.m_tag = position.tag;
+        return parser;
+    }
+    // an empty parser does not change the values
+    return ParserProtoDirect(nullptr, 0);
+}
+
+std::string_view ProtoView::getString(int id) const
+{
+    const char* buffer = nullptr;
+    ssize_t size = 0;
+    if (getParser(id).parseLengthDelimited(buffer, size))
+    {
+        return std::string_view(buffer, size);
+    }
+    return std::string_view();
+}
+
+ProtoView ProtoView::getStruct(int id) const
+{
+    const char* buffer = nullptr;
+    ssize_t size = 0;
+    if (getParser(id).parseLengthDelimited(buffer, size))
+    {
+        return ProtoView(buffer, size);
+    }
+    return ProtoView();
+}
+
+} // namespace finalmq
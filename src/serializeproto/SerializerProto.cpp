@@ -22,6 +22,7 @@
 
 #include "finalmq/serializeproto/SerializerProto.h"
 
+#include <algorithm>
 #include <iostream>
 
 #include <assert.h>
@@ -32,7 +33,8 @@
 #include "finalmq/helpers/ZeroCopyBuffer.h"
 #include "finalmq/logger/LogStream.h"
 #include "finalmq/metadata/MetaData.h"
-#include "finalmq/serialize/ParserAbortAndIndex.h"
+#include "finalmq/serialize/ParserAbortAndIndexImpl.h"
+#include "finalmq/serialize/ParserConverterImpl.h"
 #include "finalmq/jsonvariant/VariantToJson.h"
 
 namespace finalmq
@@ -41,19 +43,35 @@ static constexpr int INDEX2ID = 1;
 static constexpr int MAX_VARINT_SIZE = 10;
 static constexpr int STRUCT_SIZE_COPY = 128;
 
-SerializerProto::SerializerProto(IZeroCopyBuffer& buffer, int maxBlockSize)
-    : ParserConverter(), m_internal(buffer, maxBlockSize), m_parserAbortAndIndex()
+template class ParserAbortAndIndexT<SerializerProtoInternal>;
+template class ParserConverterT<ParserStage<ParserAbortAndIndexT, SerializerProtoInternal>>;
+template class ParserAbortAndIndexT<SerializerProtoSizeInternal>;
+template class ParserConverterT<ParserStage<ParserAbortAndIndexT, SerializerProtoSizeInternal>>;
+
+SerializerProto::SerializerProto(IZeroCopyBuffer& buffer, int maxBlockSize, const std::vector<ssize_t>* structSizes)
+    : ParserConverterT(&m_parserAbortAndIndex)
+    , m_internal(buffer, maxBlockSize, structSizes)
+    , m_parserAbortAndIndex(&m_internal)
 {
-    m_parserAbortAndIndex = std::make_unique<ParserAbortAndIndex>(&m_internal);
-    ParserConverter::setVisitor(*m_parserAbortAndIndex);
 }
 
-SerializerProto::Internal::Internal(IZeroCopyBuffer& buffer, int maxBlockSize)
-    : m_zeroCopybuffer(buffer), m_maxBlockSize(maxBlockSize)
+SerializerProtoInternal::SerializerProtoInternal(IZeroCopyBuffer& buffer, int maxBlockSize, const std::vector<ssize_t>* structSizes)
+    : m_zeroCopybuffer(buffer), m_maxBlockSize(maxBlockSize), m_structSizes(structSizes)
 {
 }
 
-void SerializerProto::Internal::serializeVarint(std::uint64_t value)
+static ssize_t sizeVarint(std::uint64_t value)
+{
+    ssize_t size = 1;
+    while (value >= 0x80)
+    {
+        value >>= 7;
+        ++size;
+    }
+    return size;
+}
+
+void SerializerProtoInternal::serializeVarint(std::uint64_t value)
 {
     while (value >= 0x80)
     {
@@ -65,7 +83,7 @@ void SerializerProto::Internal::serializeVarint(std::uint64_t value)
     ++m_buffer;
 }
 
-void SerializerProto::Internal::serializeVarintValue(int id, std::uint64_t value)
+void SerializerProtoInternal::serializeVarintValue(int id, std::uint64_t value)
 {
     if (value == 0)
     {
@@ -79,7 +97,7 @@ void SerializerProto::Internal::serializeVarintValue(int id, std::uint64_t value
     serializeVarint(value);
 }
 
-void SerializerProto::Internal::serializeZigZagValue(int id, std::int64_t value)
+void SerializerProtoInternal::serializeZigZagValue(int id, std::int64_t value)
 {
     if (value == 0)
     {
@@ -90,13 +108,13 @@ void SerializerProto::Internal::serializeZigZagValue(int id, std::int64_t value)
     serializeVarintValue(id, v);
 }
 
-std::uint64_t SerializerProto::Internal::zigzag(std::int64_t value)
+std::uint64_t SerializerProtoInternal::zigzag(std::int64_t value)
 {
     return (static_cast<std::uint64_t>(value) << 1) ^ static_cast<std::uint64_t>(value >> 63);
 }
 
 template<class T, int WIRETYPE>
-void SerializerProto::Internal::serializeFixedValue(int id, T value)
+void SerializerProtoInternal::serializeFixedValue(int id, T value)
 {
 #ifndef WIN32
 #pragma GCC diagnostic push
@@ -119,7 +137,7 @@ void SerializerProto::Internal::serializeFixedValue(int id, T value)
 }
 
 template<bool ignoreZeroLength>
-void SerializerProto::Internal::serializeString(int id, const char* value, ssize_t size)
+void SerializerProtoInternal::serializeString(int id, const char* value, ssize_t size)
 {
     if (size <= 0 && ignoreZeroLength)
     {
@@ -136,7 +154,7 @@ void SerializerProto::Internal::serializeString(int id, const char* value, ssize
 }
 
 template<class T>
-void SerializerProto::Internal::serializeArrayFixed(int id, const T* value, ssize_t size)
+void SerializerProtoInternal::serializeArrayFixed(int id, const T* value, ssize_t size)
 {
     if (size <= 0)
     {
@@ -161,7 +179,7 @@ void SerializerProto::Internal::serializeArrayFixed(int id, const T* value, ssiz
     m_buffer += sizeByte;
 }
 
-void SerializerProto::Internal::serializeArrayBool(int id, const std::vector<bool>& value)
+void SerializerProtoInternal::serializeArrayBool(int id, const std::vector<bool>& value)
 {
     if (value.size() <= 0)
     {
@@ -181,7 +199,7 @@ void SerializerProto::Internal::serializeArrayBool(int id, const std::vector<boo
     }
 }
 
-void SerializerProto::Internal::serializeArrayString(int id, const std::vector<std::string>& value)
+void SerializerProtoInternal::serializeArrayString(int id, const std::vector<std::string>& value)
 {
     ssize_t size = value.size();
     if (size <= 0)
@@ -196,7 +214,7 @@ void SerializerProto::Internal::serializeArrayString(int id, const std::vector<s
     }
 }
 
-void SerializerProto::Internal::serializeArrayBytes(int id, const std::vector<Bytes>& value)
+void SerializerProtoInternal::serializeArrayBytes(int id, const std::vector<Bytes>& value)
 {
     ssize_t size = value.size();
     if (size <= 0)
@@ -212,7 +230,7 @@ void SerializerProto::Internal::serializeArrayBytes(int id, const std::vector<By
 }
 
 template<class T>
-void SerializerProto::Internal::serializeArrayVarint(int id, const T* value, ssize_t size)
+void SerializerProtoInternal::serializeArrayVarint(int id, const T* value, ssize_t size)
 {
     if (size <= 0)
     {
@@ -231,7 +249,7 @@ void SerializerProto::Internal::serializeArrayVarint(int id, const T* value, ssi
 }
 
 template<class T>
-void SerializerProto::Internal::serializeArrayZigZag(int id, const T* value, ssize_t size)
+void SerializerProtoInternal::serializeArrayZigZag(int id, const T* value, ssize_t size)
 {
     if (size <= 0)
     {
@@ -253,7 +271,7 @@ void SerializerProto::Internal::serializeArrayZigZag(int id, const T* value, ssi
 static const int RESERVE_STRUCT_SIZE = 8;
 static const int DUMMY_ID = 2047;
 
-char* SerializerProto::Internal::serializeStruct(int id)
+char* SerializerProtoInternal::serializeStruct(int id)
 {
     reserveSpace(MAX_VARINT_SIZE + RESERVE_STRUCT_SIZE);
 
@@ -263,7 +281,7 @@ char* SerializerProto::Internal::serializeStruct(int id)
     return bufferStructStart;
 }
 
-void SerializerProto::Internal::reserveSpace(ssize_t space)
+void SerializerProtoInternal::reserveSpace(ssize_t space)
 {
     ssize_t sizeRemaining = m_bufferEnd - m_buffer;
     if (sizeRemaining < space)
@@ -306,7 +324,7 @@ void SerializerProto::Internal::reserveSpace(ssize_t space)
     }
 }
 
-void SerializerProto::Internal::resizeBuffer()
+void SerializerProtoInternal::resizeBuffer()
 {
     if (m_buffer != nullptr)
     {
@@ -320,29 +338,52 @@ void SerializerProto::Internal::resizeBuffer()
 }
 
 // IParserVisitor
-void SerializerProto::Internal::notifyError(const char* /*str*/, const char* /*message*/)
+void SerializerProtoInternal::notifyError(const char* /*str*/, const char* /*message*/)
 {
 }
 
-void SerializerProto::Internal::startStruct(const MetaStruct& /*stru*/)
+void SerializerProtoInternal::startStruct(const MetaStruct& /*stru*/)
 {
 }
 
-void SerializerProto::Internal::finished()
+void SerializerProtoInternal::finished()
 {
+    assert(m_structSizes == nullptr || m_indexStructSizes == m_structSizes->size());
     resizeBuffer();
 }
 
-void SerializerProto::Internal::enterStruct(const MetaField& field)
+void SerializerProtoInternal::enterStructCanonical(int id)
+{
+    assert(m_indexStructSizes < m_structSizes->size());
+    const ssize_t structSize = (*m_structSizes)[m_indexStructSizes];
+    ++m_indexStructSizes;
+    bool arrayEntry = (!m_stackStruct.empty()) ? m_stackStruct.back().arrayParent : m_arrayParent;
+    // the size is known, so it is written directly in front of the struct
+    if (structSize > 0 || arrayEntry)
+    {
+        reserveSpace(MAX_VARINT_SIZE + MAX_VARINT_SIZE);
+        std::uint32_t tag = (id << 3) | WIRETYPE_LENGTH_DELIMITED;
+        serializeVarint(tag);
+        serializeVarint(structSize);
+    }
+    m_stackStruct.emplace_back(nullptr, nullptr, nullptr, arrayEntry);
+}
+
+void SerializerProtoInternal::enterStruct(const MetaField& field)
 {
     int id = field.index + INDEX2ID;
+    if (m_structSizes)
+    {
+        enterStructCanonical(id);
+        return;
+    }
     char* bufferStructStart = serializeStruct(id);
     bool arrayEntry = (!m_stackStruct.empty()) ? m_stackStruct.back().arrayParent : m_arrayParent;
     m_stackStruct.emplace_back(bufferStructStart, m_buffer, m_buffer + RESERVE_STRUCT_SIZE, arrayEntry);
     m_buffer += RESERVE_STRUCT_SIZE;
 }
 
-ssize_t SerializerProto::Internal::calculateStructSize(ssize_t& structSize)
+ssize_t SerializerProtoInternal::calculateStructSize(ssize_t& structSize)
 {
     static constexpr std::uint32_t tagDummy = (DUMMY_ID << 3) | WIRETYPE_VARINT;
 
@@ -404,7 +445,7 @@ ssize_t SerializerProto::Internal::calculateStructSize(ssize_t& structSize)
     return remainingSize;
 }
 
-void SerializerProto::Internal::fillRemainingStruct(ssize_t remainingSize)
+void SerializerProtoInternal::fillRemainingStruct(ssize_t remainingSize)
 {
     switch(remainingSize)
     {
@@ -429,8 +470,14 @@ void SerializerProto::Internal::fillRemainingStruct(ssize_t remainingSize)
     }
 }
 
-void SerializerProto::Internal::exitStruct(const MetaField& /*field*/)
+void SerializerProtoInternal::exitStruct(const MetaField& /*field*/)
 {
+    if (m_structSizes)
+    {
+        assert(!m_stackStruct.empty());
+        m_stackStruct.pop_back();
+        return;
+    }
     assert(!m_stackStruct.empty());
     StructData& structData = m_stackStruct.back();
     assert(structData.buffer);
@@ -472,11 +519,11 @@ void SerializerProto::Internal::exitStruct(const MetaField& /*field*/)
     m_stackStruct.pop_back();
 }
 
-void SerializerProto::Internal::enterStructNull(const MetaField& /*field*/)
+void SerializerProtoInternal::enterStructNull(const MetaField& /*field*/)
 {
 }
 
-void SerializerProto::Internal::enterArrayStruct(const MetaField& /*field*/)
+void SerializerProtoInternal::enterArrayStruct(const MetaField& /*field*/)
 {
     if (!m_stackStruct.empty())
     {
@@ -487,7 +534,7 @@ void SerializerProto::Internal::enterArrayStruct(const MetaField& /*field*/)
         m_arrayParent = true;
     }
 }
-void SerializerProto::Internal::exitArrayStruct(const MetaField& /*field*/)
+void SerializerProtoInternal::exitArrayStruct(const MetaField& /*field*/)
 {
     if (!m_stackStruct.empty())
     {
@@ -499,29 +546,29 @@ void SerializerProto::Internal::exitArrayStruct(const MetaField& /*field*/)
     }
 }
 
-void SerializerProto::Internal::enterBool(const MetaField& field, bool value)
+void SerializerProtoInternal::enterBool(const MetaField& field, bool value)
 {
     int id = field.index + INDEX2ID;
     serializeVarintValue(id, value);
 }
 
-void SerializerProto::Internal::enterInt8(const MetaField& field, std::int8_t value)
+void SerializerProtoInternal::enterInt8(const MetaField& field, std::int8_t value)
 {
     enterInt32(field, value);
 }
-void SerializerProto::Internal::enterUInt8(const MetaField& field, std::uint8_t value)
+void SerializerProtoInternal::enterUInt8(const MetaField& field, std::uint8_t value)
 {
     enterUInt32(field, value);
 }
-void SerializerProto::Internal::enterInt16(const MetaField& field, std::int16_t value)
+void SerializerProtoInternal::enterInt16(const MetaField& field, std::int16_t value)
 {
     enterInt32(field, value);
 }
-void SerializerProto::Internal::enterUInt16(const MetaField& field, std::uint16_t value)
+void SerializerProtoInternal::enterUInt16(const MetaField& field, std::uint16_t value)
 {
     enterUInt32(field, value);
 }
-void SerializerProto::Internal::enterInt32(const MetaField& field, std::int32_t value)
+void SerializerProtoInternal::enterInt32(const MetaField& field, std::int32_t value)
 {
     int id = field.index + INDEX2ID;
     if (field.flags & METAFLAG_PROTO_VARINT)
@@ -537,7 +584,7 @@ void SerializerProto::Internal::enterInt32(const MetaField& field, std::int32_t
         serializeFixedValue<std::int32_t, WIRETYPE_FIXED32>(id, value);
     }
 }
-void SerializerProto::Internal::enterUInt32(const MetaField& field, std::uint32_t value)
+void SerializerProtoInternal::enterUInt32(const MetaField& field, std::uint32_t value)
 {
     int id = field.index + INDEX2ID;
     if (field.flags & METAFLAG_PROTO_VARINT)
@@ -549,7 +596,7 @@ void SerializerProto::Internal::enterUInt32(const MetaField& field, std::uint32_
         serializeFixedValue<std::uint32_t, WIRETYPE_FIXED32>(id, value);
     }
 }
-void SerializerProto::Internal::enterInt64(const MetaField& field, std::int64_t value)
+void SerializerProtoInternal::enterInt64(const MetaField& field, std::int64_t value)
 {
     int id = field.index + INDEX2ID;
     if (field.flags & METAFLAG_PROTO_VARINT)
@@ -565,7 +612,7 @@ void SerializerProto::Internal::enterInt64(const MetaField& field, std::int64_t
         serializeFixedValue<std::int64_t, WIRETYPE_FIXED64>(id, value);
     }
 }
-void SerializerProto::Internal::enterUInt64(const MetaField& field, std::uint64_t value)
+void SerializerProtoInternal::enterUInt64(const MetaField& field, std::uint64_t value)
 {
     int id = field.index + INDEX2ID;
     if (field.flags & METAFLAG_PROTO_VARINT)
@@ -577,64 +624,64 @@ void SerializerProto::Internal::enterUInt64(const MetaField& field, std::uint64_
         serializeFixedValue<std::uint64_t, WIRETYPE_FIXED64>(id, value);
     }
 }
-void SerializerProto::Internal::enterFloat(const MetaField& field, float value)
+void SerializerProtoInternal::enterFloat(const MetaField& field, float value)
 {
     int id = field.index + INDEX2ID;
     serializeFixedValue<float, WIRETYPE_FIXED32>(id, value);
 }
-void SerializerProto::Internal::enterDouble(const MetaField& field, double value)
+void SerializerProtoInternal::enterDouble(const MetaField& field, double value)
 {
     int id = field.index + INDEX2ID;
     serializeFixedValue<double, WIRETYPE_FIXED64>(id, value);
 }
-void SerializerProto::Internal::enterString(const MetaField& field, std::string&& value)
+void SerializerProtoInternal::enterString(const MetaField& field, std::string&& value)
 {
     int id = field.index + INDEX2ID;
     serializeString<true>(id, value.data(), value.size());
 }
-void SerializerProto::Internal::enterString(const MetaField& field, const char* value, ssize_t size)
+void SerializerProtoInternal::enterString(const MetaField& field, const char* value, ssize_t size)
 {
     int id = field.index + INDEX2ID;
     serializeString<true>(id, value, size);
 }
-void SerializerProto::Internal::enterBytes(const MetaField& field, Bytes&& value)
+void SerializerProtoInternal::enterBytes(const MetaField& field, Bytes&& value)
 {
     int id = field.index + INDEX2ID;
     serializeString<true>(id, reinterpret_cast<const char*>(value.data()), value.size());
 }
-void SerializerProto::Internal::enterBytes(const MetaField& field, const BytesElement* value, ssize_t size)
+void SerializerProtoInternal::enterBytes(const MetaField& field, const BytesElement* value, ssize_t size)
 {
     int id = field.index + INDEX2ID;
     serializeString<true>(id, value, size);
 }
-void SerializerProto::Internal::enterEnum(const MetaField& field, std::int32_t value)
+void SerializerProtoInternal::enterEnum(const MetaField& field, std::int32_t value)
 {
     int id = field.index + INDEX2ID;
     serializeVarintValue(id, value);
 }
 
-void SerializerProto::Internal::enterEnum(const MetaField& field, std::string&& value)
+void SerializerProtoInternal::enterEnum(const MetaField& field, std::string&& value)
 {
     std::int32_t enumValue = MetaDataGlobal::instance().getEnumValueByName(field, value);
     enterEnum(field, enumValue);
 }
 
-void SerializerProto::Internal::enterEnum(const MetaField& field, const char* value, ssize_t size)
+void SerializerProtoInternal::enterEnum(const MetaField& field, const char* value, ssize_t size)
 {
     enterEnum(field, std::string(value, size));
 }
 
-void SerializerProto::Internal::enterJsonString(const MetaField& field, std::string&& value)
+void SerializerProtoInternal::enterJsonString(const MetaField& field, std::string&& value)
 {
     int id = field.index + INDEX2ID;
     serializeString<true>(id, value.c_str(), value.size());
 }
-void SerializerProto::Internal::enterJsonString(const MetaField& field, const char* value, ssize_t size)
+void SerializerProtoInternal::enterJsonString(const MetaField& field, const char* value, ssize_t size)
 {
     int id = field.index + INDEX2ID;
     serializeString<true>(id, value, size);
 }
-void SerializerProto::Internal::enterJsonVariant(const MetaField& field, const Variant& value)
+void SerializerProtoInternal::enterJsonVariant(const MetaField& field, const Variant& value)
 {
     ZeroCopyBuffer buffer;
     VariantToJson variantToJson(buffer);
@@ -643,27 +690,27 @@ void SerializerProto::Internal::enterJsonVariant(const MetaField& field, const V
 
     enterJsonString(field, std::move(json));
 }
-void SerializerProto::Internal::enterJsonVariantMove(const MetaField& field, Variant&& value)
+void SerializerProtoInternal::enterJsonVariantMove(const MetaField& field, Variant&& value)
 {
     enterJsonVariant(field, value);
 }
 
 
-void SerializerProto::Internal::enterArrayBoolMove(const MetaField& field, std::vector<bool>&& value)
+void SerializerProtoInternal::enterArrayBoolMove(const MetaField& field, std::vector<bool>&& value)
 {
     int id = field.index + INDEX2ID;
     serializeArrayBool(id, value);
 }
-void SerializerProto::Internal::enterArrayBool(const MetaField& field, const std::vector<bool>& value)
+void SerializerProtoInternal::enterArrayBool(const MetaField& field, const std::vector<bool>& value)
 {
     int id = field.index + INDEX2ID;
     serializeArrayBool(id, value);
 }
-void SerializerProto::Internal::enterArrayInt8(const MetaField& field, std::vector<std::int8_t>&& value)
+void SerializerProtoInternal::enterArrayInt8(const MetaField& field, std::vector<std::int8_t>&& value)
 {
     enterArrayInt8(field, value.data(), value.size());
 }
-void SerializerProto::Internal::enterArrayInt8(const MetaField& field, const std::int8_t* value, ssize_t size)
+void SerializerProtoInternal::enterArrayInt8(const MetaField& field, const std::int8_t* value, ssize_t size)
 {
     std::vector<std::int32_t> array;
     array.resize(size);
@@ -673,11 +720,11 @@ void SerializerProto::Internal::enterArrayInt8(const MetaField& field, const std
     }
     enterArrayInt32(field, array.data(), array.size());
 }
-void SerializerProto::Internal::enterArrayInt16(const MetaField& field, std::vector<std::int16_t>&& value)
+void SerializerProtoInternal::enterArrayInt16(const MetaField& field, std::vector<std::int16_t>&& value)
 {
     enterArrayInt16(field, value.data(), value.size());
 }
-void SerializerProto::Internal::enterArrayInt16(const MetaField& field, const std::int16_t* value, ssize_t size)
+void SerializerProtoInternal::enterArrayInt16(const MetaField& field, const std::int16_t* value, ssize_t size)
 {
     std::vector<std::int32_t> array;
     array.resize(size);
@@ -687,11 +734,11 @@ void SerializerProto::Internal::enterArrayInt16(const MetaField& field, const st
     }
     enterArrayInt32(field, array.data(), array.size());
 }
-void SerializerProto::Internal::enterArrayUInt16(const MetaField& field, std::vector<std::uint16_t>&& value)
+void SerializerProtoInternal::enterArrayUInt16(const MetaField& field, std::vector<std::uint16_t>&& value)
 {
     enterArrayUInt16(field, value.data(), value.size());
 }
-void SerializerProto::Internal::enterArrayUInt16(const MetaField& field, const std::uint16_t* value, ssize_t size)
+void SerializerProtoInternal::enterArrayUInt16(const MetaField& field, const std::uint16_t* value, ssize_t size)
 {
     std::vector<std::uint32_t> array;
     array.resize(size);
@@ -701,11 +748,11 @@ void SerializerProto::Internal::enterArrayUInt16(const MetaField& field, const s
     }
     enterArrayUInt32(field, array.data(), array.size());
 }
-void SerializerProto::Internal::enterArrayInt32(const MetaField& field, std::vector<std::int32_t>&& value)
+void SerializerProtoInternal::enterArrayInt32(const MetaField& field, std::vector<std::int32_t>&& value)
 {
     enterArrayInt32(field, value.data(), value.size());
 }
-void SerializerProto::Internal::enterArrayInt32(const MetaField& field, const std::int32_t* value, ssize_t size)
+void SerializerProtoInternal::enterArrayInt32(const MetaField& field, const std::int32_t* value, ssize_t size)
 {
     int id = field.index + INDEX2ID;
     if (field.flags & METAFLAG_PROTO_VARINT)
@@ -721,11 +768,11 @@ void SerializerProto::Internal::enterArrayInt32(const MetaField& field, const st
         serializeArrayFixed(id, value, size);
     }
 }
-void SerializerProto::Internal::enterArrayUInt32(const MetaField& field, std::vector<std::uint32_t>&& value)
+void SerializerProtoInternal::enterArrayUInt32(const MetaField& field, std::vector<std::uint32_t>&& value)
 {
     enterArrayUInt32(field, value.data(), value.size());
 }
-void SerializerProto::Internal::enterArrayUInt32(const MetaField& field, const std::uint32_t* value, ssize_t size)
+void SerializerProtoInternal::enterArrayUInt32(const MetaField& field, const std::uint32_t* value, ssize_t size)
 {
     int id = field.index + INDEX2ID;
     if (field.flags & METAFLAG_PROTO_VARINT)
@@ -737,11 +784,11 @@ void SerializerProto::Internal::enterArrayUInt32(const MetaField& field, const s
         serializeArrayFixed(id, value, size);
     }
 }
-void SerializerProto::Internal::enterArrayInt64(const MetaField& field, std::vector<std::int64_t>&& value)
+void SerializerProtoInternal::enterArrayInt64(const MetaField& field, std::vector<std::int64_t>&& value)
 {
     enterArrayInt64(field, value.data(), value.size());
 }
-void SerializerProto::Internal::enterArrayInt64(const MetaField& field, const std::int64_t* value, ssize_t size)
+void SerializerProtoInternal::enterArrayInt64(const MetaField& field, const std::int64_t* value, ssize_t size)
 {
     int id = field.index + INDEX2ID;
     if (field.flags & METAFLAG_PROTO_VARINT)
@@ -757,11 +804,11 @@ void SerializerProto::Internal::enterArrayInt64(const MetaField& field, const st
         serializeArrayFixed(id, value, size);
     }
 }
-void SerializerProto::Internal::enterArrayUInt64(const MetaField& field, std::vector<std::uint64_t>&& value)
+void SerializerProtoInternal::enterArrayUInt64(const MetaField& field, std::vector<std::uint64_t>&& value)
 {
     enterArrayUInt64(field, value.data(), value.size());
 }
-void SerializerProto::Internal::enterArrayUInt64(const MetaField& field, const std::uint64_t* value, ssize_t size)
+void SerializerProtoInternal::enterArrayUInt64(const MetaField& field, const std::uint64_t* value, ssize_t size)
 {
     int id = field.index + INDEX2ID;
     if (field.flags & METAFLAG_PROTO_VARINT)
@@ -773,63 +820,63 @@ void SerializerProto::Internal::enterArrayUInt64(const MetaField& field, const s
         serializeArrayFixed(id, value, size);
     }
 }
-void SerializerProto::Internal::enterArrayFloat(const MetaField& field, std::vector<float>&& value)
+void SerializerProtoInternal::enterArrayFloat(const MetaField& field, std::vector<float>&& value)
 {
     int id = field.index + INDEX2ID;
     serializeArrayFixed(id, value.data(), value.size());
 }
-void SerializerProto::Internal::enterArrayFloat(const MetaField& field, const float* value, ssize_t size)
+void SerializerProtoInternal::enterArrayFloat(const MetaField& field, const float* value, ssize_t size)
 {
     int id = field.index + INDEX2ID;
     serializeArrayFixed(id, value, size);
 }
-void SerializerProto::Internal::enterArrayDouble(const MetaField& field, std::vector<double>&& value)
+void SerializerProtoInternal::enterArrayDouble(const MetaField& field, std::vector<double>&& value)
 {
     int id = field.index + INDEX2ID;
     serializeArrayFixed(id, value.data(), value.size());
 }
-void SerializerProto::Internal::enterArrayDouble(const MetaField& field, const double* value, ssize_t size)
+void SerializerProtoInternal::enterArrayDouble(const MetaField& field, const double* value, ssize_t size)
 {
     int id = field.index + INDEX2ID;
     serializeArrayFixed(id, value, size);
 }
-void SerializerProto::Internal::enterArrayStringMove(const MetaField& field, std::vector<std::string>&& value)
+void SerializerProtoInternal::enterArrayStringMove(const MetaField& field, std::vector<std::string>&& value)
 {
     int id = field.index + INDEX2ID;
     serializeArrayString(id, value);
 }
-void SerializerProto::Internal::enterArrayString(const MetaField& field, const std::vector<std::string>& value)
+void SerializerProtoInternal::enterArrayString(const MetaField& field, const std::vector<std::string>& value)
 {
     int id = field.index + INDEX2ID;
     serializeArrayString(id, value);
 }
-void SerializerProto::Internal::enterArrayBytesMove(const MetaField& field, std::vector<Bytes>&& value)
+void SerializerProtoInternal::enterArrayBytesMove(const MetaField& field, std::vector<Bytes>&& value)
 {
     int id = field.index + INDEX2ID;
     serializeArrayBytes(id, value);
 }
-void SerializerProto::Internal::enterArrayBytes(const MetaField& field, const std::vector<Bytes>& value)
+void SerializerProtoInternal::enterArrayBytes(const MetaField& field, const std::vector<Bytes>& value)
 {
     int id = field.index + INDEX2ID;
     serializeArrayBytes(id, value);
 }
-void SerializerProto::Internal::enterArrayEnum(const MetaField& field, std::vector<std::int32_t>&& value)
+void SerializerProtoInternal::enterArrayEnum(const MetaField& field, std::vector<std::int32_t>&& value)
 {
     int id = field.index + INDEX2ID;
     serializeArrayVarint(id, value.data(), value.size());
 }
-void SerializerProto::Internal::enterArrayEnum(const MetaField& field, const std::int32_t* value, ssize_t size)
+void SerializerProtoInternal::enterArrayEnum(const MetaField& field, const std::int32_t* value, ssize_t size)
 {
     int id = field.index + INDEX2ID;
     serializeArrayVarint(id, value, size);
 }
 
-void SerializerProto::Internal::enterArrayEnumMove(const MetaField& field, std::vector<std::string>&& value)
+void SerializerProtoInternal::enterArrayEnumMove(const MetaField& field, std::vector<std::string>&& value)
 {
     enterArrayEnum(field, value);
 }
 
-void SerializerProto::Internal::enterArrayEnum(const MetaField& field, const std::vector<std::string>& value)
+void SerializerProtoInternal::enterArrayEnum(const MetaField& field, const std::vector<std::string>& value)
 {
     const MetaEnum* metaEnum = MetaDataGlobal::instance().getEnum(field);
     if (metaEnum)
@@ -858,4 +905,481 @@ void SerializerProto::Internal::enterArrayEnum(const MetaField& field, const std
     }
 }
 
+SerializerProtoSize::SerializerProtoSize(std::vector<ssize_t>& structSizes)
+    : ParserConverterT(&m_parserAbortAndIndex)
+    , m_internal(structSizes)
+    , m_parserAbortAndIndex(&m_internal)
+{
+}
+
+ssize_t SerializerProtoSize::getSize() const
+{
+    return m_internal.getSize();
+}
+
+SerializerProtoSizeInternal::SerializerProtoSizeInternal(std::vector<ssize_t>& structSizes)
+    : m_structSizes(structSizes)
+{
+    m_structSizes.clear();
+}
+
+ssize_t SerializerProtoSizeInternal::getSize() const
+{
+    return m_size;
+}
+
+// the wire type does not change the size of the tag
+static ssize_t sizeTag(int id)
+{
+    return sizeVarint(static_cast<std::uint32_t>(id) << 3);
+}
+
+static std::uint64_t zigzagValue(std::int64_t value)
+{
+    return (static_cast<std::uint64_t>(value) << 1) ^ static_cast<std::uint64_t>(value >> 63);
+}
+
+void SerializerProtoSizeInternal::sizeVarintValue(int id, std::uint64_t value)
+{
+    if (value == 0)
+    {
+        return;
+    }
+    m_size += sizeTag(id) + sizeVarint(value);
+}
+
+void SerializerProtoSizeInternal::sizeString(int id, ssize_t size)
+{
+    m_size += sizeTag(id) + sizeVarint(size) + size;
+}
+
+template<class T>
+void SerializerProtoSizeInternal::sizeFixedValue(int id, T value)
+{
+#ifndef WIN32
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wfloat-equal"
+#endif
+    if (value == 0)
+#ifndef WIN32
+#pragma GCC diagnostic pop
+#endif
+    {
+        return;
+    }
+    m_size += sizeTag(id) + sizeof(T);
+}
+
+template<class T>
+void SerializerProtoSizeInternal::sizeArrayFixed(int id, ssize_t size)
+{
+    if (size <= 0)
+    {
+        return;
+    }
+    ssize_t sizeByte = size * sizeof(T);
+    m_size += sizeTag(id) + sizeVarint(sizeByte) + sizeByte;
+}
+
+template<class T>
+void SerializerProtoSizeInternal::sizeArrayVarint(int id, const T* value, ssize_t size)
+{
+    const ssize_t tagSize = sizeTag(id);
+    for (ssize_t i = 0; i < size; i++)
+    {
+        m_size += tagSize + sizeVarint(value[i]);
+    }
+}
+
+template<class T>
+void SerializerProtoSizeInternal::sizeArrayZigZag(int id, const T* value, ssize_t size)
+{
+    const ssize_t tagSize = sizeTag(id);
+    for (ssize_t i = 0; i < size; i++)
+    {
+        m_size += tagSize + sizeVarint(zigzagValue(value[i]));
+    }
+}
+
+// IParserVisitor
+void SerializerProtoSizeInternal::notifyError(const char* /*str*/, const char* /*message*/)
+{
+}
+
+void SerializerProtoSizeInternal::startStruct(const MetaStruct& /*stru*/)
+{
+}
+
+void SerializerProtoSizeInternal::finished()
+{
+    assert(m_stackStruct.empty());
+}
+
+void SerializerProtoSizeInternal::enterStruct(const MetaField& /*field*/)
+{
+    bool arrayEntry = (!m_stackStruct.empty()) ? m_stackStruct.back().arrayParent : m_arrayParent;
+    m_stackStruct.push_back({m_structSizes.size(), m_size, false, arrayEntry});
+    m_structSizes.push_back(0);
+    m_size = 0;
+}
+
+void SerializerProtoSizeInternal::exitStruct(const MetaField& field)
+{
+    assert(!m_stackStruct.empty());
+    const StructData& structData = m_stackStruct.back();
+    const ssize_t structSize = m_size;
+    m_structSizes[structData.indexStructSize] = structSize;
+    m_size = structData.sizeParent;
+    // like in SerializerProtoInternal, an empty struct is only written as an array entry
+    if (structSize > 0 || structData.arrayEntry)
+    {
+        m_size += sizeTag(field.index + INDEX2ID) + sizeVarint(structSize) + structSize;
+    }
+    m_stackStruct.pop_back();
+}
+
+void SerializerProtoSizeInternal::enterStructNull(const MetaField& /*field*/)
+{
+}
+
+void SerializerProtoSizeInternal::enterArrayStruct(const MetaField& /*field*/)
+{
+    if (!m_stackStruct.empty())
+    {
+        m_stackStruct.back().arrayParent = true;
+    }
+    else
+    {
+        m_arrayParent = true;
+    }
+}
+
+void SerializerProtoSizeInternal::exitArrayStruct(const MetaField& /*field*/)
+{
+    if (!m_stackStruct.empty())
+    {
+        m_stackStruct.back().arrayParent = false;
+    }
+    else
+    {
+        m_arrayParent = false;
+    }
+}
+
+void SerializerProtoSizeInternal::enterBool(const MetaField& field, bool value)
+{
+    sizeVarintValue(field.index + INDEX2ID, value);
+}
+void SerializerProtoSizeInternal::enterInt8(const MetaField& field, std::int8_t value)
+{
+    enterInt32(field, value);
+}
+void SerializerProtoSizeInternal::enterUInt8(const MetaField& field, std::uint8_t value)
+{
+    enterUInt32(field, value);
+}
+void SerializerProtoSizeInternal::enterInt16(const MetaField& field, std::int16_t value)
+{
+    enterInt32(field, value);
+}
+void SerializerProtoSizeInternal::enterUInt16(const MetaField& field, std::uint16_t value)
+{
+    enterUInt32(field, value);
+}
+void SerializerProtoSizeInternal::enterInt32(const MetaField& field, std::int32_t value)
+{
+    int id = field.index + INDEX2ID;
+    if (field.flags & METAFLAG_PROTO_VARINT)
+    {
+        sizeVarintValue(id, value);
+    }
+    else if (field.flags & METAFLAG_PROTO_ZIGZAG)
+    {
+        sizeVarintValue(id, zigzagValue(value));
+    }
+    else
+    {
+        sizeFixedValue<std::int32_t>(id, value);
+    }
+}
+void SerializerProtoSizeInternal::enterUInt32(const MetaField& field, std::uint32_t value)
+{
+    int id = field.index + INDEX2ID;
+    if (field.flags & METAFLAG_PROTO_VARINT)
+    {
+        sizeVarintValue(id, value);
+    }
+    else
+    {
+        sizeFixedValue<std::uint32_t>(id, value);
+    }
+}
+void SerializerProtoSizeInternal::enterInt64(const MetaField& field, std::int64_t value)
+{
+    int id = field.index + INDEX2ID;
+    if (field.flags & METAFLAG_PROTO_VARINT)
+    {
+        sizeVarintValue(id, value);
+    }
+    else if (field.flags & METAFLAG_PROTO_ZIGZAG)
+    {
+        sizeVarintValue(id, zigzagValue(value));
+    }
+    else
+    {
+        sizeFixedValue<std::int64_t>(id, value);
+    }
+}
+void SerializerProtoSizeInternal::enterUInt64(const MetaField& field, std::uint64_t value)
+{
+    int id = field.index + INDEX2ID;
+    if (field.flags & METAFLAG_PROTO_VARINT)
+    {
+        sizeVarintValue(id, value);
+    }
+    else
+    {
+        sizeFixedValue<std::uint64_t>(id, value);
+    }
+}
+void SerializerProtoSizeInternal::enterFloat(const MetaField& field, float value)
+{
+    sizeFixedValue<float>(field.index + INDEX2ID, value);
+}
+void SerializerProtoSizeInternal::enterDouble(const MetaField& field, double value)
+{
+    sizeFixedValue<double>(field.index + INDEX2ID, value);
+}
+void SerializerProtoSizeInternal::enterString(const MetaField& field, std::string&& value)
+{
+    enterString(field, value.data(), value.size());
+}
+void SerializerProtoSizeInternal::enterString(const MetaField& field, const char* /*value*/, ssize_t size)
+{
+    if (size > 0)
+    {
+        sizeString(field.index + INDEX2ID, size);
+    }
+}
+void SerializerProtoSizeInternal::enterBytes(const MetaField& field, Bytes&& value)
+{
+    enterString(field, nullptr, value.size());
+}
+void SerializerProtoSizeInternal::enterBytes(const MetaField& field, const BytesElement* /*value*/, ssize_t size)
+{
+    enterString(field, nullptr, size);
+}
+void SerializerProtoSizeInternal::enterEnum(const MetaField& field, std::int32_t value)
+{
+    sizeVarintValue(field.index + INDEX2ID, value);
+}
+void SerializerProtoSizeInternal::enterEnum(const MetaField& field, std::string&& value)
+{
+    std::int32_t enumValue = MetaDataGlobal::instance().getEnumValueByName(field, value);
+    enterEnum(field, enumValue);
+}
+void SerializerProtoSizeInternal::enterEnum(const MetaField& field, const char* value, ssize_t size)
+{
+    enterEnum(field, std::string(value, size));
+}
+void SerializerProtoSizeInternal::enterJsonString(const MetaField& field, std::string&& value)
+{
+    enterString(field, nullptr, value.size());
+}
+void SerializerProtoSizeInternal::enterJsonString(const MetaField& field, const char* /*value*/, ssize_t size)
+{
+    enterString(field, nullptr, size);
+}
+void SerializerProtoSizeInternal::enterJsonVariant(const MetaField& field, const Variant& value)
+{
+    ZeroCopyBuffer buffer;
+    VariantToJson variantToJson(buffer);
+    variantToJson.parse(value);
+    enterString(field, nullptr, buffer.size());
+}
+void SerializerProtoSizeInternal::enterJsonVariantMove(const MetaField& field, Variant&& value)
+{
+    enterJsonVariant(field, value);
+}
+
+void SerializerProtoSizeInternal::enterArrayBoolMove(const MetaField& field, std::vector<bool>&& value)
+{
+    enterArrayBool(field, value);
+}
+void SerializerProtoSizeInternal::enterArrayBool(const MetaField& field, const std::vector<bool>& value)
+{
+    sizeArrayFixed<std::uint8_t>(field.index + INDEX2ID, value.size());
+}
+void SerializerProtoSizeInternal::enterArrayInt8(const MetaField& field, std::vector<std::int8_t>&& value)
+{
+    enterArrayInt8(field, value.data(), value.size());
+}
+void SerializerProtoSizeInternal::enterArrayInt8(const MetaField& field, const std::int8_t* value, ssize_t size)
+{
+    std::vector<std::int32_t> array(value, value + size);
+    enterArrayInt32(field, array.data(), array.size());
+}
+void SerializerProtoSizeInternal::enterArrayInt16(const MetaField& field, std::vector<std::int16_t>&& value)
+{
+    enterArrayInt16(field, value.data(), value.size());
+}
+void SerializerProtoSizeInternal::enterArrayInt16(const MetaField& field, const std::int16_t* value, ssize_t size)
+{
+    std::vector<std::int32_t> array(value, value + size);
+    enterArrayInt32(field, array.data(), array.size());
+}
+void SerializerProtoSizeInternal::enterArrayUInt16(const MetaField& field, std::vector<std::uint16_t>&& value)
+{
+    enterArrayUInt16(field, value.data(), value.size());
+}
+void SerializerProtoSizeInternal::enterArrayUInt16(const MetaField& field, const std::uint16_t* value, ssize_t size)
+{
+    std::vector<std::uint32_t> array(value, value + size);
+    enterArrayUInt32(field, array.data(), array.size());
+}
+void SerializerProtoSizeInternal::enterArrayInt32(const MetaField& field, std::vector<std::int32_t>&& value)
+{
+    enterArrayInt32(field, value.data(), value.size());
+}
+void SerializerProtoSizeInternal::enterArrayInt32(const MetaField& field, const std::int32_t* value, ssize_t size)
+{
+    int id = field.index + INDEX2ID;
+    if (field.flags & METAFLAG_PROTO_VARINT)
+    {
+        sizeArrayVarint(id, value, size);
+    }
+    else if (field.flags & METAFLAG_PROTO_ZIGZAG)
+    {
+        sizeArrayZigZag(id, value, size);
+    }
+    else
+    {
+        sizeArrayFixed<std::int32_t>(id, size);
+    }
+}
+void SerializerProtoSizeInternal::enterArrayUInt32(const MetaField& field, std::vector<std::uint32_t>&& value)
+{
+    enterArrayUInt32(field, value.data(), value.size());
+}
+void SerializerProtoSizeInternal::enterArrayUInt32(const MetaField& field, const std::uint32_t* value, ssize_t size)
+{
+    int id = field.index + INDEX2ID;
+    if (field.flags & METAFLAG_PROTO_VARINT)
+    {
+        sizeArrayVarint(id, value, size);
+    }
+    else
+    {
+        sizeArrayFixed<std::uint32_t>(id, size);
+    }
+}
+void SerializerProtoSizeInternal::enterArrayInt64(const MetaField& field, std::vector<std::int64_t>&& value)
+{
+    enterArrayInt64(field, value.data(), value.size());
+}
+void SerializerProtoSizeInternal::enterArrayInt64(const MetaField& field, const std::int64_t* value, ssize_t size)
+{
+    int id = field.index + INDEX2ID;
+    if (field.flags & METAFLAG_PROTO_VARINT)
+    {
+        sizeArrayVarint(id, value, size);
+    }
+    else if (field.flags & METAFLAG_PROTO_ZIGZAG)
+    {
+        sizeArrayZigZag(id, value, size);
+    }
+    else
+    {
+        sizeArrayFixed<std::int64_t>(id, size);
+    }
+}
+void SerializerProtoSizeInternal::enterArrayUInt64(const MetaField& field, std::vector<std::uint64_t>&& value)
+{
+    enterArrayUInt64(field, value.data(), value.size());
+}
+void SerializerProtoSizeInternal::enterArrayUInt64(const MetaField& field, const std::uint64_t* value, ssize_t size)
+{
+    int id = field.index + INDEX2ID;
+    if (field.flags & METAFLAG_PROTO_VARINT)
+    {
+        sizeArrayVarint(id, value, size);
+    }
+    else
+    {
+        sizeArrayFixed<std::uint64_t>(id, size);
+    }
+}
+void SerializerProtoSizeInternal::enterArrayFloat(const MetaField& field, std::vector<float>&& value)
+{
+    sizeArrayFixed<float>(field.index + INDEX2ID, value.size());
+}
+void SerializerProtoSizeInternal::enterArrayFloat(const MetaField& field, const float* /*value*/, ssize_t size)
+{
+    sizeArrayFixed<float>(field.index + INDEX2ID, size);
+}
+void SerializerProtoSizeInternal::enterArrayDouble(const MetaField& field, std::vector<double>&& value)
+{
+    sizeArrayFixed<double>(field.index + INDEX2ID, value.size());
+}
+void SerializerProtoSizeInternal::enterArrayDouble(const MetaField& field, const double* /*value*/, ssize_t size)
+{
+    sizeArrayFixed<double>(field.index + INDEX2ID, size);
+}
+void SerializerProtoSizeInternal::enterArrayStringMove(const MetaField& field, std::vector<std::string>&& value)
+{
+    enterArrayString(field, value);
+}
+void SerializerProtoSizeInternal::enterArrayString(const MetaField& field, const std::vector<std::string>& value)
+{
+    int id = field.index + INDEX2ID;
+    for (size_t i = 0; i < value.size(); i++)
+    {
+        sizeString(id, value[i].size());
+    }
+}
+void SerializerProtoSizeInternal::enterArrayBytesMove(const MetaField& field, std::vector<Bytes>&& value)
+{
+    enterArrayBytes(field, value);
+}
+void SerializerProtoSizeInternal::enterArrayBytes(const MetaField& field, const std::vector<Bytes>& value)
+{
+    int id = field.index + INDEX2ID;
+    for (size_t i = 0; i < value.size(); i++)
+    {
+        sizeString(id, value[i].size());
+    }
+}
+void SerializerProtoSizeInternal::enterArrayEnum(const MetaField& field, std::vector<std::int32_t>&& value)
+{
+    enterArrayEnum(field, value.data(), value.size());
+}
+void SerializerProtoSizeInternal::enterArrayEnum(const MetaField& field, const std::int32_t* value, ssize_t size)
+{
+    sizeArrayVarint(field.index + INDEX2ID, value, size);
+}
+
+void SerializerProtoSizeInternal::enterArrayEnumMove(const MetaField& field, std::vector<std::string>&& value)
+{
+    enterArrayEnum(field, value);
+}
+
+void SerializerProtoSizeInternal::enterArrayEnum(const MetaField& field, const std::vector<std::string>& value)
+{
+    const MetaEnum* metaEnum = MetaDataGlobal::instance().getEnum(field);
+    if (metaEnum)
+    {
+        const ssize_t tagSize = sizeTag(field.index + INDEX2ID);
+        for (size_t i = 0; i < value.size(); i++)
+        {
+            int intValue = 0;
+            const MetaEnumEntry* entry = metaEnum->getEntryByName(value[i]);
+            if (entry)
+            {
+                intValue = entry->id;
+            }
+            m_size += tagSize + sizeVarint(intValue);
+        }
+    }
+}
+
 } // namespace finalmq
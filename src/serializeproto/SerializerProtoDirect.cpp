@@ -0,0 +1,72 @@
+//MIT License
+
+//Copyright (c) 2020 bexoft GmbH (mail@bexoft.de)
+
+//Permission is hereby granted, free of charge, to any person obtaining a copy
+//of this software and associated documentation files (the "Software"), to deal
+//in the Software without restriction, including without limitation the rights
+//to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//copies of the Software, and to permit persons to whom the Software is
+//furnished to do so, subject to the following conditions:
+
+//The above copyright notice and this permission notice shall be included in all
+//copies or substantial portions of the Software.
+
+//THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//SOFTWARE.
+
+#include "finalmq/serializeproto/SerializerProtoDirect.h"
+
+#include "finalmq/helpers/ZeroCopyBuffer.h"
+#include "finalmq/serializeproto/SerializerProto.h"
+#include "finalmq/serializestruct/ParserStruct.h"
+
+namespace finalmq
+{
+bool SerializerProtoDirect::startWriting(IZeroCopyBuffer& buffer)
+{
+    assert(m_buffer == nullptr);
+    if (m_size == 0)
+    {
+        return false;
+    }
+    m_buffer = buffer.addBuffer(m_size);
+    m_bufferEnd = m_buffer + m_size;
+    m_indexStructSizes = 0;
+    m_indexFallbackData = 0;
+    return true;
+}
+
+void SerializerProtoDirect::finished()
+{
+    assert(m_buffer == m_bufferEnd);
+    assert(m_indexStructSizes == m_structSizes.size());
+    assert(m_indexFallbackData == m_fallbackData.size());
+}
+
+void SerializerProtoDirect::writeStructFallback(const StructBase& structBase)
+{
+    if (m_buffer == nullptr)
+    {
+        ZeroCopyBuffer buffer;
+        structBase.serializeProtoCanonical(buffer);
+        m_fallbackData.push_back(buffer.getData());
+        m_size += m_fallbackData.back().size();
+    }
+    else
+    {
+        assert(m_indexFallbackData < m_fallbackData.size());
+        const std::string& data = m_fallbackData[m_indexFallbackData];
+        ++m_indexFallbackData;
+        assert(m_buffer + data.size() <= m_bufferEnd);
+        memcpy(m_buffer, data.data(), data.size());
+        m_buffer += data.size();
+    }
+}
+
+} // namespace finalmq
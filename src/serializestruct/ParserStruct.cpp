@@ -33,6 +33,53 @@ namespace finalmq {
 
 static const std::string STR_VARVALUE = "finalmq.variant.VarValue";
 
+// the strings and arrays of a struct with METASTRUCTFLAG_PMR are std::pmr types
+template<bool PMR, class T>
+using FieldType = std::conditional_t<PMR, typename PmrType<T>::Type, T>;
+
+// The visitor takes the arrays of bool, string and bytes as std::vector, the ones of a struct with METASTRUCTFLAG_PMR are copied.
+static const std::vector<bool>& toVisitor(const std::vector<bool>& value)
+{
+    return value;
+}
+
+static std::vector<bool> toVisitor(const std::pmr::vector<bool>& value)
+{
+    return {value.begin(), value.end()};
+}
+
+static const std::vector<std::string>& toVisitor(const std::vector<std::string>& value)
+{
+    return value;
+}
+
+static std::vector<std::string> toVisitor(const std::pmr::vector<std::pmr::string>& value)
+{
+    std::vector<std::string> strings;
+    strings.reserve(value.size());
+    for (const std::pmr::string& entry : value)
+    {
+        strings.emplace_back(entry.data(), entry.size());
+    }
+    return strings;
+}
+
+static const std::vector<Bytes>& toVisitor(const std::vector<Bytes>& value)
+{
+    return value;
+}
+
+static std::vector<Bytes> toVisitor(const std::pmr::vector<std::pmr::vector<BytesElement>>& value)
+{
+    std::vector<Bytes> bytes;
+    bytes.reserve(value.size());
+    for (const std::pmr::vector<BytesElement>& entry : value)
+    {
+        bytes.emplace_back(entry.begin(), entry.end());
+    }
+    return bytes;
+}
+
 
 ParserStruct::ParserStruct(IParserVisitor& visitor, const StructBase& structBase)
     : m_visitor(visitor)
@@ -52,6 +99,7 @@ bool ParserStruct::parseStruct()
 
 
 
+template<bool PMR>
 void ParserStruct::processField(const StructBase& structBase, const FieldInfo& fieldInfo)
 {
     const MetaField* f = fieldInfo.getField();
@@ -94,13 +142,13 @@ void ParserStruct::processField(const StructBase& structBase, const FieldInfo& f
         break;
     case TYPE_STRING:
         {
-            const std::string& value = structBase.getValue<std::string>(fieldInfo);
+            const FieldType<PMR, std::string>& value = structBase.getValue<FieldType<PMR, std::string>>(fieldInfo);
             m_visitor.enterString(field, value.data(), value.size());
         }
         break;
     case TYPE_BYTES:
         {
-            const Bytes& value = structBase.getValue<Bytes>(fieldInfo);
+            const FieldType<PMR, Bytes>& value = structBase.getValue<FieldType<PMR, Bytes>>(fieldInfo);
             m_visitor.enterBytes(field, value.data(), value.size());
         }
         break;
@@ -148,67 +196,67 @@ void ParserStruct::processField(const StructBase& structBase, const FieldInfo& f
         }
         break;
     case TYPE_ARRAY_BOOL:
-        m_visitor.enterArrayBool(field, structBase.getValue<std::vector<bool>>(fieldInfo));
+        m_visitor.enterArrayBool(field, toVisitor(structBase.getValue<FieldType<PMR, std::vector<bool>>>(fieldInfo)));
         break;
     case TYPE_ARRAY_INT8:
         {
-            const std::vector<std::int8_t>& value = structBase.getValue<std::vector<std::int8_t>>(fieldInfo);
+            const FieldType<PMR, std::vector<std::int8_t>>& value = structBase.getValue<FieldType<PMR, std::vector<std::int8_t>>>(fieldInfo);
             m_visitor.enterArrayInt8(field, value.data(), value.size());
         }
         break;
     case TYPE_ARRAY_INT16:
         {
-            const std::vector<std::int16_t>& value = structBase.getValue<std::vector<std::int16_t>>(fieldInfo);
+            const FieldType<PMR, std::vector<std::int16_t>>& value = structBase.getValue<FieldType<PMR, std::vector<std::int16_t>>>(fieldInfo);
             m_visitor.enterArrayInt16(field, value.data(), value.size());
         }
         break;
     case TYPE_ARRAY_UINT16:
         {
-            const std::vector<std::uint16_t>& value = structBase.getValue<std::vector<std::uint16_t>>(fieldInfo);
+            const FieldType<PMR, std::vector<std::uint16_t>>& value = structBase.getValue<FieldType<PMR, std::vector<std::uint16_t>>>(fieldInfo);
             m_visitor.enterArrayUInt16(field, value.data(), value.size());
         }
         break;
     case TYPE_ARRAY_INT32:
         {
-            const std::vector<std::int32_t>& value = structBase.getValue<std::vector<std::int32_t>>(fieldInfo);
+            const FieldType<PMR, std::vector<std::int32_t>>& value = structBase.getValue<FieldType<PMR, std::vector<std::int32_t>>>(fieldInfo);
             m_visitor.enterArrayInt32(field, value.data(), value.size());
         }
         break;
     case TYPE_ARRAY_UINT32:
         {
-            const std::vector<std::uint32_t>& value = structBase.getValue<std::vector<std::uint32_t>>(fieldInfo);
+            const FieldType<PMR, std::vector<std::uint32_t>>& value = structBase.getValue<FieldType<PMR, std::vector<std::uint32_t>>>(fieldInfo);
             m_visitor.enterArrayUInt32(field, value.data(), value.size());
         }
         break;
     case TYPE_ARRAY_INT64:
         {
-            const std::vector<std::int64_t>& value = structBase.getValue<std::vector<std::int64_t>>(fieldInfo);
+            const FieldType<PMR, std::vector<std::int64_t>>& value = structBase.getValue<FieldType<PMR, std::vector<std::int64_t>>>(fieldInfo);
             m_visitor.enterArrayInt64(field, value.data(), value.size());
         }
         break;
     case TYPE_ARRAY_UINT64:
         {
-            const std::vector<std::uint64_t>& value = structBase.getValue<std::vector<std::uint64_t>>(fieldInfo);
+            const FieldType<PMR, std::vector<std::uint64_t>>& value = structBase.getValue<FieldType<PMR, std::vector<std::uint64_t>>>(fieldInfo);
             m_visitor.enterArrayUInt64(field, value.data(), value.size());
         }
         break;
     case TYPE_ARRAY_FLOAT:
         {
-            const std::vector<float>& value = structBase.getValue<std::vector<float>>(fieldInfo);
+            const FieldType<PMR, std::vector<float>>& value = structBase.getValue<FieldType<PMR, std::vector<float>>>(fieldInfo);
             m_visitor.enterArrayFloat(field, value.data(), value.size());
         }
         break;
     case TYPE_ARRAY_DOUBLE:
         {
-            const std::vector<double>& value = structBase.getValue<std::vector<double>>(fieldInfo);
+            const FieldType<PMR, std::vector<double>>& value = structBase.getValue<FieldType<PMR, std::vector<double>>>(fieldInfo);
             m_visitor.enterArrayDouble(field, value.data(), value.size());
         }
         break;
     case TYPE_ARRAY_STRING:
-        m_visitor.enterArrayString(field, structBase.getValue<std::vector<std::string>>(fieldInfo));
+        m_visitor.enterArrayString(field, toVisitor(structBase.getValue<FieldType<PMR, std::vector<std::string>>>(fieldInfo)));
         break;
     case TYPE_ARRAY_BYTES:
-        m_visitor.enterArrayBytes(field, structBase.getValue<std::vector<Bytes>>(fieldInfo));
+        m_visitor.enterArrayBytes(field, toVisitor(structBase.getValue<FieldType<PMR, std::vector<Bytes>>>(fieldInfo)));
         break;
     case TYPE_ARRAY_STRUCT:
         {
@@ -233,7 +281,7 @@ void ParserStruct::processField(const StructBase& structBase, const FieldInfo& f
         break;
     case TYPE_ARRAY_ENUM:
         {
-            const std::vector<std::int32_t>& value = structBase.getValue<std::vector<std::int32_t>>(fieldInfo);
+            const FieldType<PMR, std::vector<std::int32_t>>& value = structBase.getValue<FieldType<PMR, std::vector<std::int32_t>>>(fieldInfo);
             m_visitor.enterArrayEnum(field, value.data(), value.size());
         }
         break;
@@ -249,13 +297,21 @@ void ParserStruct::processField(const StructBase& structBase, const FieldInfo& f
 void ParserStruct::parseStruct(const StructBase& structBase)
 {
     const std::vector<FieldInfo>& fields = structBase.getStructInfo().getFields();
+    const bool pmr = ((structBase.getStructInfo().getMetaStruct().getFlags() & METASTRUCTFLAG_PMR) != 0);
     for (size_t i = 0; i < fields.size(); ++i)
     {
         const FieldInfo& fieldInfo = fields[i];
         //const MetaField* field = fieldInfo.getField();
         //assert(field);
         //const_cast<MetaField*>(field)->index = static_cast<int>(i);
-        processField(structBase, fieldInfo);
+        if (pmr)
+        {
+            processField<true>(structBase, fieldInfo);
+        }
+        else
+        {
+            processField<false>(structBase, fieldInfo);
+        }
     }
 }
 
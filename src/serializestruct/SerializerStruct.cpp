@@ -40,6 +40,40 @@ namespace finalmq
 {
 static const std::string STR_VARVALUE = "finalmq.variant.VarValue";
 
+// The values are copied into the fields of a struct with METASTRUCTFLAG_PMR, so that they are allocated by the allocator of the field.
+template<class T>
+static void assignPmr(T& dest, const T& value)
+{
+    dest = value;
+}
+
+static void assignPmr(std::pmr::string& dest, const std::string& value)
+{
+    dest.assign(value.data(), value.size());
+}
+
+template<class T>
+static void assignPmr(std::pmr::vector<T>& dest, const std::vector<T>& value)
+{
+    dest.assign(value.begin(), value.end());
+}
+
+template<class D, class S>
+static void assignPmr(std::pmr::vector<D>& dest, const std::vector<S>& value)
+{
+    dest.clear();
+    dest.reserve(value.size());
+    for (const S& entry : value)
+    {
+        dest.emplace_back(entry.begin(), entry.end());
+    }
+}
+
+static bool isPmr(const StructBase& structBase)
+{
+    return ((structBase.getStructInfo().getMetaStruct().getFlags() & METASTRUCTFLAG_PMR) != 0);
+}
+
 SerializerStruct::SerializerStruct(StructBase& root)
     : IParserVisitor(), m_root(root)
 {
@@ -231,6 +265,15 @@ void SerializerStruct::exitArrayStruct(const MetaField& field)
 template<class T>
 void SerializerStruct::setValue(StructBase& structBase, const FieldInfo& fieldInfoDest, const T& value)
 {
+    if (isPmr(structBase))
+    {
+        typename PmrType<T>::Type* pval = structBase.getData<typename PmrType<T>::Type>(fieldInfoDest);
+        if (pval)
+        {
+            assignPmr(*pval, value);
+        }
+        return;
+    }
     T* pval = structBase.getData<T>(fieldInfoDest);
     if (pval)
     {
@@ -241,6 +284,11 @@ void SerializerStruct::setValue(StructBase& structBase, const FieldInfo& fieldIn
 template<class T>
 void SerializerStruct::setValue(StructBase& structBase, const FieldInfo& fieldInfoDest, T&& value)
 {
+    if (isPmr(structBase))
+    {
+        setValue<T>(structBase, fieldInfoDest, static_cast<const T&>(value));
+        return;
+    }
     T* pval = structBase.getData<T>(fieldInfoDest);
     if (pval)
     {
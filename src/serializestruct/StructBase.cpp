@@ -23,6 +23,10 @@
 #include "finalmq/serializestruct/StructBase.h"
 #include "finalmq/serializestruct/StructFactoryRegistry.h"
 #include "finalmq/metadata/MetaData.h"
+#include "finalmq/serializeproto/ParserProto.h"
+#include "finalmq/serializeproto/SerializerProto.h"
+#include "finalmq/serializestruct/ParserStruct.h"
+#include "finalmq/serializestruct/SerializerStruct.h"
 
 #include <algorithm>
 
@@ -44,11 +48,15 @@ namespace finalmq {
     }
 
 
-    StructInfo::StructInfo(const std::string& typeName, const std::string& description, int flags, const std::vector<std::string>& attrs, FuncStructBaseFactory factory, std::vector<MetaField>&& fields, std::vector<FieldInfo>&& fieldInfos)
+    StructInfo::StructInfo(const std::string& typeName, const std::string& description, int flags, const std::vector<std::string>& attrs, FuncStructBaseFactory factory, std::vector<MetaField>&& fields, std::vector<FieldInfo>&& fieldInfos, FuncStructBaseArenaFactory arenaFactory)
         : m_metaStruct(MetaDataGlobal::instance().addStruct({ typeName, description, std::move(fields), flags, attrs }))
         , m_fieldInfos(std::move(fieldInfos))
     {
         StructFactoryRegistry::instance().registerFactory(typeName, factory);
+        if (arenaFactory)
+        {
+            StructFactoryRegistry::instance().registerArenaFactory(typeName, arenaFactory);
+        }
         ssize_t size = std::min(m_metaStruct.getFieldsSize(), static_cast<ssize_t>(m_fieldInfos.size()));
         for (ssize_t i = 0; i < size; ++i)
         {
@@ -91,4 +99,30 @@ namespace finalmq {
         return nullptr;
     }
 
+    void StructBase::serializeProto(IZeroCopyBuffer& buffer) const
+    {
+        SerializerProto serializer(buffer);
+        ParserStruct parser(serializer, *this);
+        parser.parseStruct();
+    }
+
+    void StructBase::serializeProtoCanonical(IZeroCopyBuffer& buffer) const
+    {
+        std::vector<ssize_t> structSizes;
+        SerializerProtoSize serializerSize(structSizes);
+        ParserStruct parserSize(serializerSize, *this);
+        parserSize.parseStruct();
+
+        SerializerProto serializer(buffer, 512, &structSizes);
+        ParserStruct parser(serializer, *this);
+        parser.parseStruct();
+    }
+
+    bool StructBase::parseProto(const char* buffer, ssize_t size)
+    {
+        SerializerStruct serializer(*this);
+        ParserProto parser(serializer, buffer, size);
+        return parser.parseStruct(getStructInfo().getTypeName());
+    }
+
 }   // namespace finalmq
@@ -47,6 +47,27 @@ std::shared_ptr<StructBase> StructFactoryRegistryImpl::createStruct(const std::s
     return {};
 }
 
+void StructFactoryRegistryImpl::registerArenaFactory(const std::string& typeName, FuncStructBaseArenaFactory factory)
+{
+    m_arenaFactories[typeName] = factory;
+}
+
+std::shared_ptr<StructBase> StructFactoryRegistryImpl::createStruct(const std::string& typeName, const std::shared_ptr<std::pmr::memory_resource>& arena)
+{
+    if (arena)
+    {
+        auto it = m_arenaFactories.find(typeName);
+        if (it != m_arenaFactories.end())
+        {
+            if (it->second)
+            {
+                return it->second(arena);
+            }
+        }
+    }
+    return createStruct(typeName);
+}
+
 
 
 
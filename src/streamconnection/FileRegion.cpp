@@ -0,0 +1,69 @@
+//MIT License
+
+//Copyright (c) 2020 bexoft GmbH (mail@bexoft.de)
+
+//Permission is hereby granted, free of charge, to any person obtaining a copy
+//of this software and associated documentation files (the "Software"), to deal
+//in the Software without restriction, including without limitation the rights
+//to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//copies of the Software, and to permit persons to whom the Software is
+//furnished to do so, subject to the following conditions:
+
+//The above copyright notice and this permission notice shall be included in all
+//copies or substantial portions of the Software.
+
+//THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//SOFTWARE.
+
+
+#include "finalmq/streamconnection/FileRegion.h"
+
+#include <fcntl.h>
+#include <sys/stat.h>
+
+#include <string.h>
+
+#include "finalmq/helpers/OperatingSystem.h"
+
+namespace finalmq
+{
+FileRegionPtr FileRegion::open(const std::string& filename)
+{
+    int flags = O_RDONLY;
+#ifdef WIN32
+    flags |= O_BINARY;
+#endif
+    int fd = OperatingSystem::instance().open(filename.c_str(), flags);
+    if (fd == -1)
+    {
+        return nullptr;
+    }
+    struct stat statdata;
+    memset(&statdata, 0, sizeof(statdata));
+    if (OperatingSystem::instance().fstat(fd, &statdata) != 0)
+    {
+        OperatingSystem::instance().close(fd);
+        return nullptr;
+    }
+    return std::make_shared<FileRegion>(fd, 0, static_cast<ssize_t>(statdata.st_size));
+}
+
+FileRegion::FileRegion(int fd, ssize_t offset, ssize_t size)
+    : m_fd(fd), m_offset(offset), m_size(size)
+{
+}
+
+FileRegion::~FileRegion()
+{
+    if (m_fd != -1)
+    {
+        OperatingSystem::instance().close(m_fd);
+    }
+}
+
+} // namespace finalmq
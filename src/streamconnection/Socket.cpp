@@ -22,6 +22,8 @@
 
 #include "finalmq/streamconnection/Socket.h"
 
+#include <algorithm>
+
 #include <assert.h>
 #include <errno.h>
 #include <string.h>
@@ -272,6 +274,121 @@ int Socket::send(const char* buf, int len, int flags)
     return err;
 }
 
+int Socket::sendv(const struct iovec* iov, int iovcnt, int flags)
+{
+    assert(m_sd);
+#ifdef USE_OPENSSL
+    if (m_sslContext)
+    {
+        // SSL_write has no vectored variant, write buffer by buffer
+        int lenWritten = 0;
+        for (int i = 0; i < iovcnt; ++i)
+        {
+            const int len = static_cast<int>(iov[i].iov_len);
+            int err = send(static_cast<const char*>(iov[i].iov_base), len, flags);
+            if (err < 0)
+            {
+                return (lenWritten > 0) ? lenWritten : err;
+            }
+            lenWritten += err;
+            if (err != len)
+            {
+                break;
+            }
+        }
+        return lenWritten;
+    }
+#endif
+    int err = 0;
+    do
+    {
+        err = OperatingSystem::instance().sendv(m_sd->getDescriptor(), iov, iovcnt, flags);
+    } while (err == -1 && getLastError() == SOCKETERROR(EINTR));
+
+    if (err >= 0)
+    {
+        return err;
+    }
+    return handleError(err, "write");
+}
+
+int Socket::sendFile(int fdFile, off_t offset, int len, int flags)
+{
+    assert(m_sd);
+#ifdef USE_OPENSSL
+    if (m_sslContext)
+    {
+        return sendFileBuffered(fdFile, offset, len, flags);
+    }
+#endif
+    int err = 0;
+    do
+    {
+        err = OperatingSystem::instance().sendfile(m_sd->getDescriptor(), fdFile, offset, len);
+    } while (err == -1 && getLastError() == SOCKETERROR(EINTR));
+
+    if (err == 0 && len > 0)
+    {
+        streamError << "sendfile failed, the file is shorter than expected";
+        return -1;
+    }
+    if (err >= 0)
+    {
+        return err;
+    }
+    return handleError(err, "sendfile");
+}
+
+int Socket::sendFileBuffered(int fdFile, off_t offset, int len, int flags)
+{
+    static const int SENDFILE_BUFFER_SIZE = 262144;
+
+    // a write that would block must be repeated with the same buffer (SSL),
+    // so the chunk is kept until it was sent completely.
+    if (m_sendFileBufferBegin == m_sendFileBufferEnd || m_sendFileDescriptor != fdFile || m_sendFileOffset != offset)
+    {
+        m_sendFileBuffer.resize(SENDFILE_BUFFER_SIZE);
+        m_sendFileBufferBegin = 0;
+        m_sendFileBufferEnd = 0;
+        m_sendFileDescriptor = -1;
+        if (OperatingSystem::instance().lseek(fdFile, offset, SEEK_SET) == -1)
+        {
+            streamError << "lseek failed with error " << getLastError();
+            return -1;
+        }
+        int err = 0;
+        do
+        {
+            err = OperatingSystem::instance().read(fdFile, m_sendFileBuffer.data(), std::min(len, SENDFILE_BUFFER_SIZE));
+        } while (err == -1 && getLastError() == SOCKETERROR(EINTR));
+        if (err <= 0)
+        {
+            streamError << "read of file failed, the file is shorter than expected";
+            return -1;
+        }
+        m_sendFileBufferEnd = err;
+        m_sendFileDescriptor = fdFile;
+        m_sendFileOffset = offset;
+    }
+
+    const int size = std::min(len, m_sendFileBufferEnd - m_sendFileBufferBegin);
+    int err = send(m_sendFileBuffer.data() + m_sendFileBufferBegin, size, flags);
+    if (err > 0)
+    {
+        m_sendFileBufferBegin += err;
+        m_sendFileOffset += err;
+        if (err == len)
+        {
+            // end of the region
+            m_sendFileBuffer = std::vector<char>();
+            m_sendFileBufferBegin = 0;
+            m_sendFileBufferEnd = 0;
+            m_sendFileDescriptor = -1;
+        }
+    }
+    return err;
+}
+
 int Socket::receive(char* buf, int len, int flags)
 {
     assert(m_sd);
@@ -332,6 +449,32 @@ int Socket::receive(char* buf, int len, int flags)
     return err;
 }
 
+int Socket::receiveAvailable(char* buf, int len)
+{
+    assert(m_sd);
+    int err = 0;
+    do
+    {
+        err = OperatingSystem::instance().recv(m_sd->getDescriptor(), buf, len, 0);
+    } while (err == -1 && getLastError() == SOCKETERROR(EINTR));
+
+    if (err > 0)
+    {
+        return err;
+    }
+    if (err == 0)
+    {
+        // connection closed by peer
+        return -1;
+    }
+    if (getLastError() == SOCKETERROR(EWOULDBLOCK))
+    {
+        return 0;
+    }
+    handleError(err, "read");
+    return -1;
+}
+
 void Socket::destroy()
 {
     if (m_sd)
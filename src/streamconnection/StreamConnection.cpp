@@ -22,6 +22,7 @@
 
 #include "finalmq/streamconnection/StreamConnection.h"
 
+#include <algorithm>
 #include <thread>
 
 #include "finalmq/streamconnection/AddressHelpers.h"
@@ -31,8 +32,16 @@
 
 namespace finalmq
 {
-StreamConnection::StreamConnection(const ConnectionData& connectionData, std::shared_ptr<Socket> socket, const IPollerPtr& poller, hybrid_ptr<IStreamConnectionCallback> callback)
-    : m_connectionId(connectionData.connectionId), m_connectionData(connectionData), m_socketPrivate(socket), m_socket(socket), m_poller(poller), m_callback(callback)
+// true for the poller loop threads of all reactors
+static thread_local bool t_reactorThread = false;
+
+void StreamConnection::markReactorThread()
+{
+    t_reactorThread = true;
+}
+
+StreamConnection::StreamConnection(const ConnectionData& connectionData, std::shared_ptr<Socket> socket, const IPollerPtr& poller, const IExecutorPtr& executor, hybrid_ptr<IStreamConnectionCallback> callback)
+    : m_connectionId(connectionData.connectionId), m_connectionData(connectionData), m_socketPrivate(socket), m_socket(socket), m_poller(poller), m_pollerCompletion(dynamic_cast<IPollerCompletion*>(poller.get())), m_executor(executor), m_callback(callback)
 {
     m_lastReconnectTime = std::chrono::steady_clock::now();
 }
@@ -50,55 +59,371 @@ void StreamConnection::sendMessage(const IMessagePtr& msg)
     }
     std::unique_lock<std::mutex> lock(m_mutex);
     ssize_t size = msg->getTotalSendBufferSize();
-    if (size > 0)
+    const FileRegionPtr& file = msg->getSendFile();
+    if (size > 0 || file)
     {
+        if (file)
+        {
+            size += file->getSize();
+        }
+        if (isSendQueueFull() && !handleOverflow(lock))
+        {
+            return;
+        }
         const auto& payloads = msg->getAllSendBuffers();
-        if (!m_pendingMessages.empty() || m_connectionData.connectionState != ConnectionState::CONNECTIONSTATE_CONNECTED)
+        const bool sendNow = (m_pendingMessages.empty() && m_connectionData.connectionState == ConnectionState::CONNECTIONSTATE_CONNECTED);
+        m_pendingMessages.push_back({msg, payloads.begin(), 0, 0, size});
+        m_sendQueueStatistics.pendingBytes += size;
+        ++m_sendQueueStatistics.pendingMessages;
+        m_sendQueueStatistics.peakBytes = std::max(m_sendQueueStatistics.peakBytes, m_sendQueueStatistics.pendingBytes);
+        m_sendQueueStatistics.peakMessages = std::max(m_sendQueueStatistics.peakMessages, m_sendQueueStatistics.pendingMessages);
+        if (!m_writeBlocked && isSendQueueFull())
         {
-            m_pendingMessages.push_back({msg, payloads.begin(), 0});
+            m_writeBlocked = true;
+            ++m_sendQueueStatistics.highWaterMarkReached;
         }
-        else
+        if (sendNow)
         {
-#if 0
-            m_pendingMessages.push_back({msg, payloads.begin(), 0});
-            m_poller->enableWrite(m_socketPrivate->getSocketDescriptor());
-#else
-            bool ex = false;
-            for (auto it = payloads.begin(); it != payloads.end() && !ex; )
+            // one call sends at most MAX_SEND_BUFFERS buffers, continue till the socket would block
+            bool pending = false;
+            while (!m_pendingMessages.empty() && !pending)
             {
-                const BufferRef& payload = *it;
+                pending = !sendPendingBuffers();
+            }
+            if (pending && !m_sendSubmitted)
+            {
+                m_poller->enableWrite(m_socketPrivate->getSocketDescriptor());
+            }
+            updateWritable();
+        }
+    }
+    lock.unlock();
+}
+
+bool StreamConnection::isSendQueueFull() const
+{
+    // mutex is already locked
+    const SendQueueConfig& config = m_connectionData.connectionProperties.sendQueue;
+    return ((config.highWaterMarkBytes >= 0 && m_sendQueueStatistics.pendingBytes >= config.highWaterMarkBytes) ||
+            (config.highWaterMarkMessages >= 0 && m_sendQueueStatistics.pendingMessages >= config.highWaterMarkMessages));
+}
+
+static ssize_t getLowWaterMark(ssize_t highWaterMark, ssize_t lowWaterMark)
+{
+    return (lowWaterMark >= 0) ? lowWaterMark : (highWaterMark / 2);
+}
+
+bool StreamConnection::isSendQueueDrained() const
+{
+    // mutex is already locked
+    const SendQueueConfig& config = m_connectionData.connectionProperties.sendQueue;
+    return ((config.highWaterMarkBytes < 0 || m_sendQueueStatistics.pendingBytes <= getLowWaterMark(config.highWaterMarkBytes, config.lowWaterMarkBytes)) &&
+            (config.highWaterMarkMessages < 0 || m_sendQueueStatistics.pendingMessages <= getLowWaterMark(config.highWaterMarkMessages, config.lowWaterMarkMessages)));
+}
+
+bool StreamConnection::handleOverflow(std::unique_lock<std::mutex>& lock)
+{
+    // mutex is already locked
+    if (!m_writeBlocked)
+    {
+        m_writeBlocked = true;
+        ++m_sendQueueStatistics.highWaterMarkReached;
+    }
+
+    bool queueMessage = false;
+    switch (m_connectionData.connectionProperties.sendQueue.overflowPolicy)
+    {
+        case OverflowPolicy::OVERFLOW_BLOCK:
+            queueMessage = waitWritable(lock);
+            break;
+        case OverflowPolicy::OVERFLOW_DROP_OLDEST:
+        {
+            // a message that is partially sent cannot be dropped, the peer would receive a corrupt stream.
+            // The messages that are sent by the poller are skipped, their buffers are in use.
+            auto it = m_pendingMessages.begin();
+            std::advance(it, m_messagesSubmitted);
+            while (it != m_pendingMessages.end() && isSendQueueFull())
+            {
+                auto itDrop = it;
                 ++it;
+                if (itDrop->it == itDrop->msg->getAllSendBuffers().begin() && itDrop->offset == 0 && itDrop->fileSent == 0)
+                {
+                    popPendingMessage(itDrop);
+                    ++m_sendQueueStatistics.droppedMessages;
+                }
+            }
+            queueMessage = true;
+        }
+        break;
+        case OverflowPolicy::OVERFLOW_DROP_NEWEST:
+            ++m_sendQueueStatistics.droppedMessages;
+            break;
+        case OverflowPolicy::OVERFLOW_DISCONNECT:
+            ++m_sendQueueStatistics.droppedMessages;
+            streamInfo << "send queue overflow, disconnect " << m_connectionData.endpoint;
+            disconnect();
+            break;
+        default:
+            assert(false);
+            break;
+    }
+    return queueMessage;
+}
+
+bool StreamConnection::waitWritable(std::unique_lock<std::mutex>& lock)
+{
+    // mutex is already locked
+    if (t_reactorThread)
+    {
+        // a poller thread shall never block, it has to drain the queues of all its connections.
+        // The queue shall not grow without limit, so the new message is dropped.
+        ++m_sendQueueStatistics.droppedMessages;
+        return false;
+    }
+
+    while (m_writeBlocked && !m_disconnectFlag && m_connectionData.connectionState != ConnectionState::CONNECTIONSTATE_DISCONNECTED)
+    {
+        if (m_connectionData.connectionState == ConnectionState::CONNECTIONSTATE_CONNECTED && m_socketPrivate && !m_pendingMessages.empty())
+        {
+            // help to drain the queue. The poller thread could wait for a lock that is held by the producer.
+            sendPendingBuffers();
+            updateWritable();
+        }
+        if (m_writeBlocked)
+        {
+            m_condWritable.wait_for(lock, std::chrono::milliseconds(10));
+        }
+    }
+
+    if (m_disconnectFlag || m_connectionData.connectionState == ConnectionState::CONNECTIONSTATE_DISCONNECTED)
+    {
+        ++m_sendQueueStatistics.droppedMessages;
+        return false;
+    }
+    return true;
+}
+
+void StreamConnection::popPendingMessage(std::list<MessageSendState>::iterator it)
+{
+    // mutex is already locked
+    m_sendQueueStatistics.pendingBytes -= it->size;
+    --m_sendQueueStatistics.pendingMessages;
+    m_pendingMessages.erase(it);
+}
 
-#ifdef __QNX__
-                int flags = 0;
-#else
-                bool last = (it == payloads.end());
-                int flags = last ? 0 : MSG_MORE; // win32: MSG_PARTIAL
+void StreamConnection::updateWritable()
+{
+    // mutex is already locked
+    if (m_writeBlocked && isSendQueueDrained())
+    {
+        m_writeBlocked = false;
+        m_edgeWritable = true;
+        m_condWritable.notify_all();
+        if (std::this_thread::get_id() != m_threadIdPoller && m_socketPrivate)
+        {
+            // the poller thread fires the writable event at the next write event
+            m_poller->enableWrite(m_socketPrivate->getSocketDescriptor());
+        }
+    }
+}
+
+IPollerCompletion* StreamConnection::getPollerCompletion() const
+{
+    // mutex is already locked
+    // the SSL layer has to encrypt the data, so SSL sockets send by themselves
+#ifdef USE_OPENSSL
+    if (m_socketPrivate && m_socketPrivate->isSsl())
+    {
+        return nullptr;
+    }
 #endif
+    return m_pollerCompletion;
+}
+
+bool StreamConnection::sendPendingBuffers()
+{
+    // mutex is already locked
+    assert(m_socketPrivate);
+
+    if (m_sendSubmitted)
+    {
+        // the poller sends the collected buffers, sendCompleted continues
+        return false;
+    }
 
+    // collect the unsent buffers of all pending messages, so that they can be sent with one system call.
+    // A file region follows the buffers of its message, so the collection stops behind a message with a file.
+    m_sendBuffers.clear();
+    ssize_t sizeToSend = 0;
+    size_t messagesCollected = 0;
+    bool fileFollows = false;
+    for (auto itMessage = m_pendingMessages.begin(); itMessage != m_pendingMessages.end() && m_sendBuffers.size() < MAX_SEND_BUFFERS && !fileFollows; ++itMessage)
+    {
+        ++messagesCollected;
+        const MessageSendState& messageSendState = *itMessage;
+        assert(messageSendState.msg);
+        const auto& payloads = messageSendState.msg->getAllSendBuffers();
+        int offset = messageSendState.offset;
+        for (auto it = messageSendState.it; it != payloads.end() && m_sendBuffers.size() < MAX_SEND_BUFFERS; ++it)
+        {
+            const BufferRef& payload = *it;
+            ssize_t size = payload.second - offset;
+            assert(size >= 0);
+            if (size > 0)
+            {
+                struct iovec buffer;
+                buffer.iov_base = payload.first + offset;
+                buffer.iov_len = static_cast<size_t>(size);
+                m_sendBuffers.push_back(buffer);
+                sizeToSend += size;
+            }
+            offset = 0;
+        }
+        fileFollows = (messageSendState.msg->getSendFile() != nullptr);
+    }
+
+    IPollerCompletion* pollerCompletion = getPollerCompletion();
+    if (pollerCompletion && sizeToSend > 0)
+    {
+        // the poller sends the buffers together with its next wait. The messages are kept
+        // till the completion, also if the connection is removed meanwhile.
+        std::shared_ptr<std::vector<IMessagePtr>> messages = std::make_shared<std::vector<IMessagePtr>>();
+        messages->reserve(messagesCollected);
+        auto itMessage = m_pendingMessages.begin();
+        for (size_t i = 0; i < messagesCollected; ++i, ++itMessage)
+        {
+            messages->push_back(itMessage->msg);
+        }
+        if (pollerCompletion->submitSend(m_socketPrivate->getSocketDescriptor(), std::move(m_sendBuffers), std::move(messages)))
+        {
+            m_sendSubmitted = true;
+            m_messagesSubmitted = messagesCollected;
+            m_sizeSubmitted = sizeToSend;
+            return false;
+        }
+        // the socket is not added to the poller, send directly
+    }
+
+    int flags = 0;
 #if !defined WIN32
-                flags |= MSG_NOSIGNAL; // no sigpipe
+    flags |= MSG_NOSIGNAL; // no sigpipe
 #endif
-                int err = m_socketPrivate->send(payload.first, static_cast<int>(payload.second), flags);
-                if (err != payload.second)
-                {
-                    if (err < 0)
-                    {
-                        err = 0;
-                    }
-                    assert(err < payload.second);
-                    --it;
-                    m_pendingMessages.push_back({msg, it, err});
-                    m_poller->enableWrite(m_socketPrivate->getSocketDescriptor());
-                    ex = true;
-                }
+    int err = 0;
+    if (sizeToSend > 0)
+    {
+        err = m_socketPrivate->sendv(m_sendBuffers.data(), static_cast<int>(m_sendBuffers.size()), flags);
+        if (err < 0)
+        {
+            err = 0;
+        }
+    }
+
+    return removeSentBuffers(err, (err == sizeToSend));
+}
+
+bool StreamConnection::removeSentBuffers(ssize_t sizeSent, bool complete)
+{
+    // mutex is already locked
+    // remove the sent buffers from the pending messages
+    while (!m_pendingMessages.empty())
+    {
+        MessageSendState& messageSendState = m_pendingMessages.front();
+        const auto& payloads = messageSendState.msg->getAllSendBuffers();
+        while (messageSendState.it != payloads.end())
+        {
+            ssize_t size = messageSendState.it->second - messageSendState.offset;
+            if (sizeSent >= size)
+            {
+                sizeSent -= size;
+                ++messageSendState.it;
+                messageSendState.offset = 0;
             }
-#endif
+            else
+            {
+                messageSendState.offset += static_cast<int>(sizeSent);
+                sizeSent = 0;
+                break;
+            }
+        }
+        if (messageSendState.it != payloads.end())
+        {
+            break;
+        }
+        const FileRegionPtr& file = messageSendState.msg->getSendFile();
+        if (file && messageSendState.fileSent < file->getSize())
+        {
+            if (!complete || !sendFileRegion(messageSendState, *file))
+            {
+                complete = false;
+                break;
+            }
+        }
+        popPendingMessage(m_pendingMessages.begin());
+    }
+    assert(sizeSent == 0);
+
+    // complete means that the socket took all collected buffers, the buffers behind
+    // MAX_SEND_BUFFERS or behind a file are still pending and need the next call.
+    return complete;
+}
+
+void StreamConnection::sendCompleted(int result)
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    if (m_sendSubmitted)
+    {
+        m_sendSubmitted = false;
+        m_messagesSubmitted = 0;
+        if (result < 0)
+        {
+            // the peer cannot receive the rest of the stream
+            disconnect();
+        }
+        else if (m_socketPrivate && m_connectionData.connectionState == ConnectionState::CONNECTIONSTATE_CONNECTED)
+        {
+            removeSentBuffers(result, (result == m_sizeSubmitted));
+            // continue with the rest of a partial send and with the messages that were queued meanwhile
+            bool pending = false;
+            while (!m_pendingMessages.empty() && !pending)
+            {
+                pending = !sendPendingBuffers();
+            }
+            if (pending && !m_sendSubmitted)
+            {
+                m_poller->enableWrite(m_socketPrivate->getSocketDescriptor());
+            }
+            updateWritable();
         }
     }
     lock.unlock();
 }
 
+bool StreamConnection::sendFileRegion(MessageSendState& messageSendState, const FileRegion& file)
+{
+    // mutex is already locked
+    int flags = 0;
+#if !defined WIN32
+    flags |= MSG_NOSIGNAL; // no sigpipe
+#endif
+    while (messageSendState.fileSent < file.getSize())
+    {
+        const ssize_t size = std::min(file.getSize() - messageSendState.fileSent, MAX_SENDFILE_SIZE);
+        int err = m_socketPrivate->sendFile(file.getDescriptor(), static_cast<off_t>(file.getOffset() + messageSendState.fileSent), static_cast<int>(size), flags);
+        if (err < 0)
+        {
+            // the rest of the file cannot be sent, the receiver would wait forever
+            disconnect();
+            return false;
+        }
+        if (err == 0)
+        {
+            return false;
+        }
+        messageSendState.fileSent += err;
+    }
+    return true;
+}
+
 ConnectionData StreamConnection::getConnectionData() const
 {
     std::unique_lock<std::mutex> lock(m_mutex);
@@ -140,9 +465,27 @@ SocketPtr StreamConnection::getSocket()
 void StreamConnection::disconnect()
 {
     m_disconnectFlag = true;
+    m_condWritable.notify_all();
     m_poller->releaseWait(RELEASE_DISCONNECT);
 }
 
+bool StreamConnection::isWritable() const
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    return !m_writeBlocked;
+}
+
+SendQueueStatistics StreamConnection::getSendQueueStatistics() const
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    return m_sendQueueStatistics;
+}
+
+IExecutorPtr StreamConnection::getExecutor() const
+{
+    return m_executor;
+}
+
 bool StreamConnection::connect()
 {
     bool connecting = false;
@@ -174,57 +517,20 @@ bool StreamConnection::sendPendingMessages()
 {
     bool pending = false;
     std::unique_lock<std::mutex> lock(m_mutex);
+    m_threadIdPoller = std::this_thread::get_id();
     if (m_socketPrivate)
     {
         if (m_connectionData.connectionState == ConnectionState::CONNECTIONSTATE_CONNECTED)
         {
             while (!m_pendingMessages.empty() && !pending)
             {
-                MessageSendState& messageSendState = m_pendingMessages.front();
-                IMessagePtr& msg = messageSendState.msg;
-                assert(msg);
-                const auto& payloads = msg->getAllSendBuffers();
-                for (auto it = messageSendState.it; it != payloads.end() && !pending;)
-                {
-                    const BufferRef& payload = *it;
-                    ++it;
-#ifdef __QNX__
-                    int flags = 0;
-#else
-                    bool last = ((it == payloads.end()) && (m_pendingMessages.size() == 1));
-                    int flags = last ? 0 : MSG_MORE; // win32: MSG_PARTIAL
-#endif
-#if !defined WIN32
-                    flags |= MSG_NOSIGNAL; // no sigpipe
-#endif
-                    ssize_t size = payload.second - messageSendState.offset;
-                    assert((payload.second == 0 && size == 0) || (size > 0));
-                    int err = m_socketPrivate->send(payload.first + messageSendState.offset, static_cast<int>(size), flags);
-                    if (err == size)
-                    {
-                        messageSendState.it = it;
-                        messageSendState.offset = 0;
-                    }
-                    else if (err > 0)
-                    {
-                        messageSendState.offset += err;
-                        assert(messageSendState.offset < payload.second);
-                        pending = true;
-                    }
-                    else
-                    {
-                        pending = true;
-                    }
-                }
-                if (!pending)
-                {
-                    m_pendingMessages.pop_front();
-                }
+                pending = !sendPendingBuffers();
             }
-            if (!pending)
+            if (!pending || m_sendSubmitted)
             {
                 m_poller->disableWrite(m_socketPrivate->getSocketDescriptor());
             }
+            updateWritable();
         }
     }
     lock.unlock();
@@ -245,6 +551,14 @@ bool StreamConnection::checkEdgeConnected()
     return edgeConnected;
 }
 
+bool StreamConnection::checkEdgeWritable()
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    bool edgeWritable = m_edgeWritable;
+    m_edgeWritable = false;
+    return edgeWritable;
+}
+
 bool StreamConnection::doReconnect()
 {
     bool reconnecting = false;
@@ -290,6 +604,10 @@ bool StreamConnection::changeStateForDisconnect()
 
     m_socketPrivate = nullptr;
     m_socket = nullptr;
+    // a submitted send is cancelled with the removal of the socket
+    m_sendSubmitted = false;
+    m_messagesSubmitted = 0;
+    m_condWritable.notify_all();
 
     return removeConnection;
 }
@@ -309,6 +627,10 @@ void StreamConnection::updateConnectionData(const ConnectionData& connectionData
 
 void StreamConnection::connected(const IStreamConnectionPtr& connection)
 {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_threadIdPoller = std::this_thread::get_id();
+    lock.unlock();
+
     auto callback = m_callback.lock();
     if (callback)
     {
@@ -335,15 +657,24 @@ void StreamConnection::disconnected(const IStreamConnectionPtr& connection)
     }
 }
 
-bool StreamConnection::received(const IStreamConnectionPtr& connection, const SocketPtr& socket, int bytesToRead)
+bool StreamConnection::received(const IStreamConnectionPtr& connection, const char* buffer, int size)
 {
     bool ok = false;
     auto callback = m_callback.lock();
     if (callback && !m_disconnectFlag)
     {
-        ok = callback->received(connection, socket, bytesToRead);
+        ok = callback->received(connection, buffer, size);
     }
     return ok;
 }
 
+void StreamConnection::writable(const IStreamConnectionPtr& connection)
+{
+    auto callback = m_callback.lock();
+    if (callback && !m_disconnectFlag)
+    {
+        callback->writable(connection);
+    }
+}
+
 } // namespace finalmq
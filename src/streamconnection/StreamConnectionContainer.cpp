@@ -30,11 +30,7 @@
 #include "finalmq/streamconnection/streamconnection.fmq.h"
 #include "finalmq/helpers/ModulenameFinalmq.h"
 
-#if defined(WIN32) || defined(__MINGW32__) || defined(__QNX__)
-#include "finalmq/poller/PollerImplSelect.h"
-#else
-#include "finalmq/poller/PollerImplEpoll.h"
-#endif
+#include "finalmq/poller/PollerFactory.h"
 
 #if !defined(WIN32) && !defined(__MINGW32__)
 #include <fcntl.h>
@@ -47,6 +43,7 @@
 #endif
 #endif
 
+#include <algorithm>
 #include <thread>
 
 #include <assert.h>
@@ -55,6 +52,8 @@
 #define RELEASE_EXECUTEINPOLLERTHREAD 2
 #define RELEASE_TERMINATE 4
 
+static const int RECEIVE_BUFFER_SIZE = 65536;
+
 
 
 namespace finalmq
@@ -62,17 +61,11 @@ namespace finalmq
 std::atomic_int64_t StreamConnectionContainer::m_nextConnectionId{1};
 
 StreamConnectionContainer::StreamConnectionContainer()
-#if defined(WIN32) || defined(__MINGW32__) || defined(__QNX__)
-    : m_poller(std::make_shared<PollerImplSelect>())
-#else
-    : m_poller(std::make_shared<PollerImplEpoll>())
-#endif
-      ,
-      m_executorPollerThread(std::make_shared<Executor>()), m_executorWorker(std::make_unique<ExecutorWorker<ExecutorIgnoreOrderOfInstance>>(1))
+    : m_executorWorker(std::make_unique<ExecutorWorker<ExecutorIgnoreOrderOfInstance>>(1))
 {
-    m_executorPollerThread->registerActionNotification([this]() {
-        m_poller->releaseWait(RELEASE_EXECUTEINPOLLERTHREAD);
-    });
+    // the first reactor is the one that is executed by run()
+    createReactor();
+    m_executorPollerThread = m_reactors[0]->executor;
 }
 
 StreamConnectionContainer::~StreamConnectionContainer()
@@ -83,6 +76,58 @@ StreamConnectionContainer::~StreamConnectionContainer()
     {
         m_threadTimer.join();
     }
+    for (size_t i = 1; i < m_reactors.size(); ++i)
+    {
+        Reactor& reactor = *m_reactors[i];
+        if (reactor.thread.joinable())
+        {
+            reactor.thread.join();
+        }
+    }
+}
+
+void StreamConnectionContainer::createReactor()
+{
+    std::unique_ptr<Reactor> reactor = std::make_unique<Reactor>();
+    reactor->poller = PollerFactory::createPoller();
+    reactor->pollerCompletion = dynamic_cast<IPollerCompletion*>(reactor->poller.get());
+    reactor->executor = std::make_shared<Executor>();
+    reactor->receiveBuffer.resize(RECEIVE_BUFFER_SIZE);
+    IPoller* poller = reactor->poller.get();
+    reactor->executor->registerActionNotification([poller]() {
+        poller->releaseWait(RELEASE_EXECUTEINPOLLERTHREAD);
+    });
+    m_reactors.push_back(std::move(reactor));
+}
+
+StreamConnectionContainer::Reactor& StreamConnectionContainer::nextReactor()
+{
+    assert(!m_reactors.empty());
+    if (m_reactors.size() == 1)
+    {
+        return *m_reactors[0];
+    }
+    std::uint32_t ix = m_nextReactor.fetch_add(1, std::memory_order_relaxed);
+    return *m_reactors[ix % m_reactors.size()];
+}
+
+void StreamConnectionContainer::connectionsChanged(Reactor& reactor)
+{
+    // mutex already locked
+    reactor.connectionsStable.clear(std::memory_order_release);
+}
+
+StreamConnectionContainer::Reactor* StreamConnectionContainer::findReactorByConnectionId(std::int64_t connectionId)
+{
+    // mutex already locked
+    for (auto& reactor : m_reactors)
+    {
+        if (reactor->connectionId2Connection.find(connectionId) != reactor->connectionId2Connection.end())
+        {
+            return reactor.get();
+        }
+    }
+    return nullptr;
 }
 
 std::unordered_map<SOCKET, StreamConnectionContainer::BindData>::iterator StreamConnectionContainer::findBindByEndpoint(const std::string& endpoint)
@@ -98,12 +143,12 @@ std::unordered_map<SOCKET, StreamConnectionContainer::BindData>::iterator Stream
     return m_sd2binds.end();
 }
 
-IStreamConnectionPrivatePtr StreamConnectionContainer::findConnectionBySdOnlyForPollerLoop(SOCKET sd)
+IStreamConnectionPrivatePtr StreamConnectionContainer::findConnectionBySdOnlyForPollerLoop(Reactor& reactor, SOCKET sd)
 {
-    // m_sd2ConnectionPollerLoop is only used at poller loop thread
+    // sd2ConnectionPollerLoop is only used at the poller loop thread of the reactor
     IStreamConnectionPrivatePtr connection;
-    auto it = m_sd2ConnectionPollerLoop.find(sd);
-    if (it != m_sd2ConnectionPollerLoop.end())
+    auto it = reactor.sd2ConnectionPollerLoop.find(sd);
+    if (it != reactor.sd2ConnectionPollerLoop.end())
     {
         connection = it->second;
     }
@@ -125,13 +170,26 @@ IStreamConnectionPrivatePtr StreamConnectionContainer::findConnectionById(std::i
 
 // IStreamConnectionContainer
 
-void StreamConnectionContainer::init(int cycleTime, FuncPollerLoopTimer funcTimer, int checkReconnectInterval)
+void StreamConnectionContainer::init(int cycleTime, FuncPollerLoopTimer funcTimer, int checkReconnectInterval, int numberOfReactors)
 {
     std::unique_lock<std::mutex> lock(m_mutex);
     m_funcTimer = std::move(funcTimer);
     m_cycleTime = cycleTime;
     m_checkReconnectInterval = checkReconnectInterval;
-    m_poller->init();
+    m_reactors[0]->poller->init();
+    // all reactors are created before the first thread starts, m_reactors is not changed anymore while the threads run
+    for (int i = 1; i < numberOfReactors; ++i)
+    {
+        createReactor();
+        m_reactors.back()->poller->init();
+    }
+    for (size_t i = 1; i < m_reactors.size(); ++i)
+    {
+        Reactor& reactor = *m_reactors[i];
+        reactor.thread = std::thread([this, &reactor]() {
+            pollerLoop(reactor);
+        });
+    }
     m_threadTimer = std::thread([this]() {
         while (!m_terminatePollerLoop)
         {
@@ -207,6 +265,7 @@ int StreamConnectionContainer::bind(const std::string& endpoint, hybrid_ptr<IStr
 
     ConnectionData connectionData = AddressHelpers::endpoint2ConnectionData(endpoint);
     connectionData.ssl = bindPropertiesToUse.certificateData.ssl;
+    connectionData.connectionProperties.sendQueue = bindPropertiesToUse.sendQueue;
     std::shared_ptr<Socket> socket = std::make_shared<Socket>();
 
     bool ok = false;
@@ -243,9 +302,18 @@ int StreamConnectionContainer::bind(const std::string& endpoint, hybrid_ptr<IStr
         auto it = findBindByEndpoint(endpoint);
         if (it == m_sd2binds.end())
         {
-            assert(m_poller);
+            // the listener sockets are handled by the first reactor
             m_sd2binds.emplace(sd->getDescriptor(), BindData{connectionData, socket, callbackDefault});
-            m_poller->addSocketEnableRead(sd);
+            IPollerCompletion* pollerCompletion = getPollerCompletion(*m_reactors[0], socket);
+            if (pollerCompletion)
+            {
+                m_reactors[0]->poller->addSocket(sd);
+                pollerCompletion->enableAccept(sd);
+            }
+            else
+            {
+                m_reactors[0]->poller->addSocketEnableRead(sd);
+            }
         }
         else
         {
@@ -264,7 +332,7 @@ void StreamConnectionContainer::unbind(const std::string& endpoint)
     {
         SocketPtr socket = it->second.socket;
         assert(socket);
-        m_poller->removeSocket(socket->getSocketDescriptor());
+        m_reactors[0]->poller->removeSocket(socket->getSocketDescriptor());
         m_sd2binds.erase(it);
     }
     locker.unlock();
@@ -295,7 +363,7 @@ IStreamConnectionPtr StreamConnectionContainer::createConnection(hybrid_ptr<IStr
 
     IStreamConnectionPrivatePtr connection;
 
-    connection = addConnection(nullptr, connectionData, callback);
+    connection = addConnection(nextReactor(), nullptr, connectionData, callback);
     assert(connection);
 
     return connection;
@@ -329,16 +397,17 @@ bool StreamConnectionContainer::createSocket(const IStreamConnectionPtr& streamC
         IStreamConnectionPrivatePtr streamConnectionPrivate;        
         std::unique_lock<std::mutex> lock(m_mutex);
         auto it = m_connectionId2Connection.find(connectionData.connectionId);
-        if (it != m_connectionId2Connection.end())
+        Reactor* reactor = findReactorByConnectionId(connectionData.connectionId);
+        if (it != m_connectionId2Connection.end() && reactor)
         {
             streamConnectionPrivate = it->second;
             assert(streamConnectionPrivate);
             streamConnectionPrivate->setSocket(socket);
             streamConnectionPrivate->updateConnectionData(connectionData);
-            auto& entry = m_sd2Connection[connectionData.sd];
+            auto& entry = reactor->sd2Connection[connectionData.sd];
             assert(entry == nullptr);
             entry = it->second;
-            m_connectionsStable.clear(std::memory_order_release);
+            connectionsChanged(*reactor);
         }
         else
         {
@@ -499,20 +568,21 @@ IStreamConnectionPtr StreamConnectionContainer::getConnection(std::int64_t conne
 
 //////////////
 
-void StreamConnectionContainer::disconnectIntern(const IStreamConnectionPrivatePtr& connectionDisconnect, const SocketDescriptorPtr& sd)
+void StreamConnectionContainer::disconnectIntern(Reactor& reactor, const IStreamConnectionPrivatePtr& connectionDisconnect, const SocketDescriptorPtr& sd)
 {
     bool removeConn = connectionDisconnect->changeStateForDisconnect();
-    m_poller->removeSocket(sd);
+    reactor.poller->removeSocket(sd);
     std::unique_lock<std::mutex> lock(m_mutex);
     if (sd)
     {
-        m_socketErase.push_back(sd);
-        m_sd2Connection.erase(sd->getDescriptor());
-        m_connectionsStable.clear(std::memory_order_release);
+        reactor.socketErase.push_back(sd);
+        reactor.sd2Connection.erase(sd->getDescriptor());
+        connectionsChanged(reactor);
     }
     if (removeConn)
     {
         m_connectionId2Connection.erase(connectionDisconnect->getConnectionId());
+        reactor.connectionId2Connection.erase(connectionDisconnect->getConnectionId());
     }
     lock.unlock();
     if (removeConn)
@@ -525,13 +595,16 @@ void StreamConnectionContainer::disconnectIntern(const IStreamConnectionPrivateP
 
 void StreamConnectionContainer::run()
 {
-    pollerLoop();
+    pollerLoop(*m_reactors[0]);
 }
 
 void StreamConnectionContainer::terminatePollerLoop()
 {
     m_terminatePollerLoop = true;
-    m_poller->releaseWait(RELEASE_TERMINATE);
+    for (auto& reactor : m_reactors)
+    {
+        reactor->poller->releaseWait(RELEASE_TERMINATE);
+    }
 }
 
 IExecutorPtr StreamConnectionContainer::getPollerThreadExecutor() const
@@ -539,53 +612,141 @@ IExecutorPtr StreamConnectionContainer::getPollerThreadExecutor() const
     return m_executorPollerThread;
 }
 
-IStreamConnectionPrivatePtr StreamConnectionContainer::addConnection(const SocketPtr& socket, ConnectionData& connectionData, hybrid_ptr<IStreamConnectionCallback> callback)
+IStreamConnectionPrivatePtr StreamConnectionContainer::addConnection(Reactor& reactor, const SocketPtr& socket, ConnectionData& connectionData, hybrid_ptr<IStreamConnectionCallback> callback)
 {
     std::unique_lock<std::mutex> lock(m_mutex);
     std::int64_t connectionId = m_nextConnectionId.fetch_add(1);
     connectionData.connectionId = connectionId;
-    IStreamConnectionPrivatePtr connection = std::make_shared<StreamConnection>(connectionData, socket, m_poller, callback);
+    IStreamConnectionPrivatePtr connection = std::make_shared<StreamConnection>(connectionData, socket, reactor.poller, reactor.executor, callback);
     m_connectionId2Connection[connectionId] = connection;
+    reactor.connectionId2Connection[connectionId] = connection;
     if (connectionData.sd != INVALID_SOCKET)
     {
-        m_sd2Connection[connectionData.sd] = connection;
-        m_connectionsStable.clear(std::memory_order_release);
+        reactor.sd2Connection[connectionData.sd] = connection;
+        connectionsChanged(reactor);
     }
     lock.unlock();
 
     return connection;
 }
 
-void StreamConnectionContainer::handleReceive(const IStreamConnectionPrivatePtr& connection, const SocketPtr& socket, int bytesToRead)
+void StreamConnectionContainer::acceptConnection(Reactor& reactor, const SocketPtr& socketAccept, ConnectionData& connectionData, hybrid_ptr<IStreamConnectionCallback> callback)
+{
+    // this is the poller thread of the reactor
+    SocketDescriptorPtr sd = socketAccept->getSocketDescriptor();
+    assert(sd);
+#ifdef USE_OPENSSL
+    if (connectionData.ssl)
+    {
+        auto it = reactor.sslAcceptings.emplace(sd->getDescriptor(), SslAcceptingData{socketAccept, connectionData, callback}).first;
+        reactor.poller->addSocketEnableRead(sd);
+        sslAccepting(reactor, it->second);
+    }
+    else
+#endif
+    {
+        connectionData.sd = sd->getDescriptor();
+        AddressHelpers::addr2peer(reinterpret_cast<sockaddr*>(const_cast<char*>(connectionData.sockaddr.c_str())), connectionData);
+
+        IStreamConnectionPrivatePtr connection = addConnection(reactor, socketAccept, connectionData, callback);
+        connection->connected(connection);
+        IPollerCompletion* pollerCompletion = getPollerCompletion(reactor, socketAccept);
+        if (pollerCompletion)
+        {
+            reactor.poller->addSocket(sd);
+            pollerCompletion->enableReceive(sd);
+        }
+        else
+        {
+            reactor.poller->addSocketEnableRead(sd);
+        }
+    }
+}
+
+IPollerCompletion* StreamConnectionContainer::getPollerCompletion(const Reactor& reactor, const SocketPtr& socket)
 {
+    // the SSL layer has to read and write the socket by itself
 #ifdef USE_OPENSSL
     if (socket->isSsl())
     {
-        bytesToRead = socket->sslPending();
+        return nullptr;
     }
+#else
+    (void)socket;
 #endif
+    return reactor.pollerCompletion;
+}
 
+bool StreamConnectionContainer::receiveIntoBuffer(Reactor& reactor, const IStreamConnectionPrivatePtr& connection, const SocketPtr& socket)
+{
+    char* buffer = reactor.receiveBuffer.data();
+    const int sizeBuffer = static_cast<int>(reactor.receiveBuffer.size());
     bool ok = true;
     int maxloop = 5;
-    while (bytesToRead > 0 && ok)
+    while (ok && maxloop > 0)
     {
-        ok = connection->received(connection, socket, bytesToRead);
+        // read optimistically until the socket has no more data, the number of pending bytes is not asked
+        int res = socket->receiveAvailable(buffer, sizeBuffer);
+        if (res < 0)
+        {
+            ok = false;
+            break;
+        }
+        if (res == 0)
+        {
+            break;
+        }
+        ok = connection->received(connection, buffer, res);
         maxloop--;
-        if (maxloop > 0 && ok)
+        if (res < sizeBuffer)
         {
-            bytesToRead = socket->pendingRead();
+            // the socket is drained
+            break;
+        }
+    }
+    return ok;
+}
+
+void StreamConnectionContainer::handleReceive(Reactor& reactor, const IStreamConnectionPrivatePtr& connection, const SocketPtr& socket)
+{
+    bool ok = true;
 #ifdef USE_OPENSSL
-            if (bytesToRead > 0 && socket->isSsl())
+    if (socket->isSsl())
+    {
+        int bytesToRead = socket->sslPending();
+        int maxloop = 5;
+        while (bytesToRead > 0 && ok)
+        {
+            // SSL_read cannot read optimistically, so only the pending bytes are read
+            int res = socket->receive(reactor.receiveBuffer.data(), std::min(bytesToRead, static_cast<int>(reactor.receiveBuffer.size())));
+            if (res > 0)
             {
-                bytesToRead = socket->sslPending();
+                ok = connection->received(connection, reactor.receiveBuffer.data(), res);
+            }
+            else if (res < 0)
+            {
+                ok = false;
+            }
+            maxloop--;
+            if (maxloop > 0 && ok)
+            {
+                bytesToRead = socket->pendingRead();
+                if (bytesToRead > 0)
+                {
+                    bytesToRead = socket->sslPending();
+                }
+            }
+            else
+            {
+                break;
             }
-#endif
-        }
-        else
-        {
-            break;
         }
     }
+    else
+#endif
+    {
+        ok = receiveIntoBuffer(reactor, connection, socket);
+    }
 
     if (!ok)
     {
@@ -593,7 +754,7 @@ void StreamConnectionContainer::handleReceive(const IStreamConnectionPrivatePtr&
         if (socket1)
         {
             SocketDescriptorPtr sd = socket1->getSocketDescriptor();
-            disconnectIntern(connection, sd);
+            disconnectIntern(reactor, connection, sd);
         }
     }
 
@@ -602,25 +763,32 @@ void StreamConnectionContainer::handleReceive(const IStreamConnectionPrivatePtr&
     {
         SocketDescriptorPtr sd = socket->getSocketDescriptor();
         assert(sd);
-        m_poller->enableWrite(sd);
+        reactor.poller->enableWrite(sd);
     }
 #endif
 }
 
-void StreamConnectionContainer::handleConnectionEvents(const IStreamConnectionPrivatePtr& connection, const SocketPtr& socket, const DescriptorInfo& info)
+void StreamConnectionContainer::handleConnectionEvents(Reactor& reactor, const IStreamConnectionPrivatePtr& connection, const SocketPtr& socket, const DescriptorInfo& info)
 {
-    bool disconnected = (info.disconnected || (info.readable && info.bytesToRead == 0));
+    bool disconnected = info.disconnected;
+#ifdef USE_OPENSSL
+    if (!disconnected && info.readable && socket->isSsl())
+    {
+        // the SSL layer cannot read optimistically, so a closed connection is detected by the number of pending bytes
+        disconnected = (socket->pendingRead() == 0);
+    }
+#endif
     if (disconnected)
     {
         SocketDescriptorPtr sd = socket->getSocketDescriptor();
         assert(sd);
-        disconnectIntern(connection, sd);
+        disconnectIntern(reactor, connection, sd);
     }
     else
     {
-        std::int32_t bytesToRead = info.bytesToRead;
         bool writable = info.writable;
         bool readable = info.readable;
+        IPollerCompletion* pollerCompletion = nullptr;
 #ifdef USE_OPENSSL
         bool isSsl = socket->isSsl();
         if (isSsl)
@@ -632,15 +800,15 @@ void StreamConnectionContainer::handleConnectionEvents(const IStreamConnectionPr
                 SslSocket::IoState state = socket->sslConnecting();
                 if (state == SslSocket::IoState::WANT_WRITE)
                 {
-                    m_poller->enableWrite(sd);
+                    reactor.poller->enableWrite(sd);
                 }
                 else if (state == SslSocket::IoState::WANT_READ)
                 {
-                    m_poller->disableWrite(sd);
+                    reactor.poller->disableWrite(sd);
                 }
                 else if (state == SslSocket::IoState::SSL_ERROR)
                 {
-                    disconnectIntern(connection, sd);
+                    disconnectIntern(reactor, connection, sd);
                 }
                 else if (state == SslSocket::IoState::SUCCESS)
                 {
@@ -649,7 +817,7 @@ void StreamConnectionContainer::handleConnectionEvents(const IStreamConnectionPr
                     {
                         connection->connected(connection);
                     }
-                    m_poller->enableWrite(sd);
+                    reactor.poller->enableWrite(sd);
                 }
                 return;
             }
@@ -657,11 +825,15 @@ void StreamConnectionContainer::handleConnectionEvents(const IStreamConnectionPr
 
         if (isSsl && writable && socket->isReadWhenWritable())
         {
-            handleReceive(connection, socket, bytesToRead);
+            handleReceive(reactor, connection, socket);
         }
         else if (isSsl && readable && socket->isWriteWhenReadable())
         {
             connection->sendPendingMessages();
+            if (connection->checkEdgeWritable())
+            {
+                connection->writable(connection);
+            }
         }
         else
         {
@@ -672,8 +844,13 @@ void StreamConnectionContainer::handleConnectionEvents(const IStreamConnectionPr
                 if (edgeConnection)
                 {
                     connection->connected(connection);
+                    pollerCompletion = getPollerCompletion(reactor, socket);
                 }
                 connection->sendPendingMessages();
+                if (connection->checkEdgeWritable())
+                {
+                    connection->writable(connection);
+                }
 #ifdef USE_OPENSSL
                 if (socket->isWriteWhenReadable())
                 {
@@ -683,7 +860,12 @@ void StreamConnectionContainer::handleConnectionEvents(const IStreamConnectionPr
             }
             if (readable)
             {
-                handleReceive(connection, socket, bytesToRead);
+                handleReceive(reactor, connection, socket);
+            }
+            if (pollerCompletion)
+            {
+                // the bytes that already arrived were read, the poller receives the next ones
+                pollerCompletion->enableReceive(socket->getSocketDescriptor());
             }
 #ifdef USE_OPENSSL
         }
@@ -691,7 +873,7 @@ void StreamConnectionContainer::handleConnectionEvents(const IStreamConnectionPr
     }
 }
 
-void StreamConnectionContainer::handleBindEvents(const DescriptorInfo& info)
+void StreamConnectionContainer::handleBindEvents(Reactor& reactor, const DescriptorInfo& info)
 {
     if (info.readable)
     {
@@ -713,35 +895,7 @@ void StreamConnectionContainer::handleBindEvents(const DescriptorInfo& info)
             bindData.socket->accept(reinterpret_cast<sockaddr*>(const_cast<char*>(addr.c_str())), &addrlen, socketAccept);
             if (socketAccept)
             {
-                ConnectionData connectionData = bindData.connectionData;
-                connectionData.incomingConnection = true;
-                connectionData.startTime = std::chrono::steady_clock::now();
-                connectionData.sockaddr = addr;
-                connectionData.connectionState = ConnectionState::CONNECTIONSTATE_CONNECTED;
-
-#ifdef USE_OPENSSL
-                if (connectionData.ssl)
-                {
-                    SocketDescriptorPtr sd = socketAccept->getSocketDescriptor();
-                    assert(sd);
-                    SslAcceptingData sslAcceptingData{socketAccept, connectionData, bindData.callback};
-                    m_sslAcceptings.emplace(sd->getDescriptor(), sslAcceptingData);
-                    sslAccepting(sslAcceptingData);
-                }
-                else
-#endif
-                {
-                    SocketDescriptorPtr sd = socketAccept->getSocketDescriptor();
-                    assert(sd);
-                    connectionData.sd = sd->getDescriptor();
-                    AddressHelpers::addr2peer(reinterpret_cast<sockaddr*>(const_cast<char*>(connectionData.sockaddr.c_str())), connectionData);
-
-                    IStreamConnectionPrivatePtr connection = addConnection(socketAccept, connectionData, bindData.callback);
-                    connection->connected(connection);
-                }
-                SocketDescriptorPtr sd = socketAccept->getSocketDescriptor();
-                assert(sd);
-                m_poller->addSocketEnableRead(sd);
+                acceptIncoming(reactor, bindData, socketAccept, addr);
             }
         }
     }
@@ -764,8 +918,99 @@ void StreamConnectionContainer::handleBindEvents(const DescriptorInfo& info)
     }
 }
 
+void StreamConnectionContainer::acceptIncoming(Reactor& reactor, const BindData& bindData, const SocketPtr& socketAccept, const std::string& addr)
+{
+    ConnectionData connectionData = bindData.connectionData;
+    connectionData.incomingConnection = true;
+    connectionData.startTime = std::chrono::steady_clock::now();
+    connectionData.sockaddr = addr;
+    connectionData.connectionState = ConnectionState::CONNECTIONSTATE_CONNECTED;
+
+    Reactor& reactorAccept = nextReactor();
+    if (&reactorAccept == &reactor)
+    {
+        acceptConnection(reactor, socketAccept, connectionData, bindData.callback);
+    }
+    else
+    {
+        // hand the socket over to the poller thread of the other reactor
+        hybrid_ptr<IStreamConnectionCallback> callback = bindData.callback;
+        reactorAccept.executor->addAction([this, &reactorAccept, socketAccept, connectionData, callback]() mutable {
+            acceptConnection(reactorAccept, socketAccept, connectionData, callback);
+        });
+    }
+}
+
+void StreamConnectionContainer::handleAcceptCompletion(Reactor& reactor, const CompletionInfo& info)
+{
+    BindData bindData;
+    std::unique_lock<std::mutex> lock(m_mutex);
+    auto it = m_sd2binds.find(info.sd);
+    if (it != m_sd2binds.end())
+    {
+        bindData = it->second;
+    }
+    lock.unlock();
+
+    if (info.result >= 0)
+    {
+        // the socket owns the accepted descriptor, it is closed if the listener was unbound meanwhile
+        SocketPtr socketAccept = std::make_shared<Socket>();
+        socketAccept->attach(info.result);
+        if (bindData.socket)
+        {
+            std::string addr(info.buffer, info.size);
+            acceptIncoming(reactor, bindData, socketAccept, addr);
+        }
+    }
+    else if (bindData.socket)
+    {
+        // the listening socket failed
+        unbind(bindData.connectionData.endpoint);
+    }
+}
+
+void StreamConnectionContainer::handleCompletion(Reactor& reactor, const CompletionInfo& info)
+{
+    if (info.type == CompletionType::COMPLETION_ACCEPT)
+    {
+        handleAcceptCompletion(reactor, info);
+        return;
+    }
+
+    IStreamConnectionPrivatePtr connection = findConnectionBySdOnlyForPollerLoop(reactor, info.sd);
+    SocketPtr socket = connection ? connection->getSocketPrivate() : nullptr;
+    if (!socket)
+    {
+        // the connection was disconnected in this cycle
+        return;
+    }
+    assert(info.sd == socket->getSocketDescriptor()->getDescriptor()); // remove for performance
+
+    if (info.type == CompletionType::COMPLETION_RECEIVE)
+    {
+        bool ok = false;
+        if (info.result > 0)
+        {
+            ok = connection->received(connection, info.buffer, info.result);
+        }
+        if (!ok)
+        {
+            disconnectIntern(reactor, connection, socket->getSocketDescriptor());
+        }
+    }
+    else
+    {
+        connection->sendCompleted(info.result);
+        if (connection->checkEdgeWritable())
+        {
+            connection->writable(connection);
+        }
+    }
+}
+
 #ifdef USE_OPENSSL
-bool StreamConnectionContainer::sslAccepting(SslAcceptingData& sslAcceptingData)
+bool StreamConnectionContainer::sslAccepting(Reactor& reactor, SslAcceptingData& sslAcceptingData)
 {
     assert(sslAcceptingData.socket);
 
@@ -775,11 +1020,11 @@ bool StreamConnectionContainer::sslAccepting(SslAcceptingData& sslAcceptingData)
 
     if (state == SslSocket::IoState::WANT_WRITE)
     {
-        m_poller->enableWrite(sd);
+        reactor.poller->enableWrite(sd);
     }
     else
     {
-        m_poller->disableWrite(sd);
+        reactor.poller->disableWrite(sd);
     }
 
     if (state == SslSocket::IoState::SUCCESS)
@@ -787,18 +1032,18 @@ bool StreamConnectionContainer::sslAccepting(SslAcceptingData& sslAcceptingData)
         sslAcceptingData.connectionData.sd = sd->getDescriptor();
         AddressHelpers::addr2peer(reinterpret_cast<sockaddr*>(const_cast<char*>(sslAcceptingData.connectionData.sockaddr.c_str())), sslAcceptingData.connectionData);
 
-        IStreamConnectionPrivatePtr connection = addConnection(sslAcceptingData.socket, sslAcceptingData.connectionData, sslAcceptingData.callback);
+        IStreamConnectionPrivatePtr connection = addConnection(reactor, sslAcceptingData.socket, sslAcceptingData.connectionData, sslAcceptingData.callback);
         connection->connected(connection);
     }
 
     if (state == SslSocket::IoState::SSL_ERROR)
     {
-        m_poller->removeSocket(sd);
+        reactor.poller->removeSocket(sd);
     }
 
     if (state == SslSocket::IoState::SUCCESS || state == SslSocket::IoState::SSL_ERROR)
     {
-        m_sslAcceptings.erase(sd->getDescriptor());
+        reactor.sslAcceptings.erase(sd->getDescriptor());
     }
     return (state == SslSocket::IoState::SUCCESS);
 }
@@ -848,40 +1093,45 @@ bool StreamConnectionContainer::isTimerExpired(std::chrono::time_point<std::chro
     return expired;
 }
 
-void StreamConnectionContainer::pollerLoop()
+void StreamConnectionContainer::updateConnectionsPollerLoop(Reactor& reactor)
+{
+    if (!reactor.connectionsStable.test_and_set(std::memory_order_acq_rel))
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        reactor.sd2ConnectionPollerLoop = reactor.sd2Connection;
+        reactor.socketErase.clear();
+    }
+}
+
+void StreamConnectionContainer::pollerLoop(Reactor& reactor)
 {
-    m_lastReconnectTime = std::chrono::steady_clock::now();
+    StreamConnection::markReactorThread();
+    if (&reactor == m_reactors[0].get())
+    {
+        // the reconnect timer is handled by the first reactor
+        m_lastReconnectTime = std::chrono::steady_clock::now();
+    }
     while (!m_terminatePollerLoop)
     {
-        if (!m_connectionsStable.test_and_set(std::memory_order_acq_rel))
-        {
-            std::unique_lock<std::mutex> lock(m_mutex);
-            m_sd2ConnectionPollerLoop = m_sd2Connection;
-            m_socketErase.clear();
-        }
+        updateConnectionsPollerLoop(reactor);
 
-        const PollerResult& result = m_poller->wait(1000);
+        const PollerResult& result = reactor.poller->wait(1000);
 
-        if (!m_connectionsStable.test_and_set(std::memory_order_acq_rel))
-        {
-            std::unique_lock<std::mutex> lock(m_mutex);
-            m_sd2ConnectionPollerLoop = m_sd2Connection;
-            m_socketErase.clear();
-        }
+        updateConnectionsPollerLoop(reactor);
 
         if (result.releaseWait)
         {
             if (result.releaseWait & RELEASE_EXECUTEINPOLLERTHREAD)
             {
-                m_executorPollerThread->runAvailableActions();
+                reactor.executor->runAvailableActions();
             }
 
             if (result.releaseWait & RELEASE_DISCONNECT)
             {
                 std::vector<IStreamConnectionPrivatePtr> connectionsDisconnect;
                 std::unique_lock<std::mutex> lock(m_mutex);
-                connectionsDisconnect.reserve(m_connectionId2Connection.size());
-                for (auto it = m_connectionId2Connection.begin(); it != m_connectionId2Connection.end(); ++it)
+                connectionsDisconnect.reserve(reactor.connectionId2Connection.size());
+                for (auto it = reactor.connectionId2Connection.begin(); it != reactor.connectionId2Connection.end(); ++it)
                 {
                     const IStreamConnectionPrivatePtr& connection = it->second;
                     assert(connection);
@@ -903,17 +1153,12 @@ void StreamConnectionContainer::pollerLoop()
                     {
                         sd = socket->getSocketDescriptor();
                     }
-                    disconnectIntern(connectionDisconnect, sd);
+                    disconnectIntern(reactor, connectionDisconnect, sd);
                 }
             }
         }
 
-        if (!m_connectionsStable.test_and_set(std::memory_order_acq_rel))
-        {
-            std::unique_lock<std::mutex> lock(m_mutex);
-            m_sd2ConnectionPollerLoop = m_sd2Connection;
-            m_socketErase.clear();
-        }
+        updateConnectionsPollerLoop(reactor);
 
         if (result.error)
         {
@@ -928,32 +1173,32 @@ void StreamConnectionContainer::pollerLoop()
             for (size_t i = 0; i < result.descriptorInfos.size(); ++i)
             {
                 const DescriptorInfo& info = result.descriptorInfos[i];
-                IStreamConnectionPrivatePtr connection = findConnectionBySdOnlyForPollerLoop(info.sd);
+                IStreamConnectionPrivatePtr connection = findConnectionBySdOnlyForPollerLoop(reactor, info.sd);
                 if (connection)
                 {
                     SocketPtr socket = connection->getSocketPrivate();
                     if (socket)
                     {
                         assert(info.sd == socket->getSocketDescriptor()->getDescriptor()); // remove for performance
-                        handleConnectionEvents(connection, socket, info);
+                        handleConnectionEvents(reactor, connection, socket, info);
                     }
                 }
                 else
                 {
 #ifdef USE_OPENSSL
-                    auto itSslAccepting = m_sslAcceptings.find(info.sd);
-                    if (itSslAccepting != m_sslAcceptings.end())
+                    auto itSslAccepting = reactor.sslAcceptings.find(info.sd);
+                    if (itSslAccepting != reactor.sslAcceptings.end())
                     {
-                        bool success = sslAccepting(itSslAccepting->second);
+                        bool success = sslAccepting(reactor, itSslAccepting->second);
                         if (success)
                         {
-                            IStreamConnectionPrivatePtr connection1 = findConnectionBySdOnlyForPollerLoop(info.sd);
+                            IStreamConnectionPrivatePtr connection1 = findConnectionBySdOnlyForPollerLoop(reactor, info.sd);
                             if (connection1)
                             {
                                 SocketPtr socket = connection1->getSocketPrivate();
                                 if (socket)
                                 {
-                                    handleConnectionEvents(connection1, socket, info);
+                                    handleConnectionEvents(reactor, connection1, socket, info);
                                 }
                             }
                         }
@@ -961,10 +1206,14 @@ void StreamConnectionContainer::pollerLoop()
                     else
 #endif
                     {
-                        handleBindEvents(info);
+                        handleBindEvents(reactor, info);
                     }
                 }
             }
+            for (const CompletionInfo& info : result.completions)
+            {
+                handleCompletion(reactor, info);
+            }
         }
     }
 }
@@ -34,16 +34,32 @@ Variant::Variant()
 {
 }
 
-Variant::Variant(std::shared_ptr<IVariantValue> value)
-    : m_value(value)
+Variant::~Variant()
 {
+    destroyValue();
+}
 
+Variant::Variant(std::shared_ptr<IVariantValue> value)
+{
+    if (value)
+    {
+        setShared(std::move(value));
+    }
 }
 
 
 Variant::Variant(const Variant& rhs)
-    : m_value((rhs.m_value) ? rhs.m_value->clone() : nullptr)
 {
+    if (rhs.m_inline)
+    {
+        m_value = rhs.m_value->cloneInline(m_storage);
+        m_inline = true;
+    }
+    else if (rhs.m_value)
+    {
+        // copy on write
+        setShared(std::shared_ptr<IVariantValue>(rhs.getShared()));
+    }
 }
 
 const Variant& Variant::operator =(const Variant& rhs)
@@ -52,21 +68,16 @@ const Variant& Variant::operator =(const Variant& rhs)
     {
         return *this;
     }
-    if (rhs.m_value)
-    {
-        m_value = rhs.m_value->clone();
-    }
-    else
-    {
-        m_value = nullptr;
-    }
+    // copy first, rhs could be a part of this variant
+    Variant variant(rhs);
+    destroyValue();
+    moveFrom(variant);
     return *this;
 }
 
 Variant::Variant(Variant&& rhs) noexcept
-    : m_value(std::move(rhs.m_value))
 {
-
+    moveFrom(rhs);
 }
 
 Variant& Variant::operator =(Variant&& rhs) noexcept
@@ -75,11 +86,80 @@ Variant& Variant::operator =(Variant&& rhs) noexcept
     {
         return *this;
     }
-    m_value = std::move(rhs.m_value);
+    // move first, rhs could be a part of this variant
+    Variant variant(std::move(rhs));
+    destroyValue();
+    moveFrom(variant);
     return *this;
 }
 
 
+void Variant::moveFrom(Variant& rhs)
+{
+    assert(m_value == nullptr);
+    if (rhs.m_inline)
+    {
+        m_value = rhs.m_value->moveInline(m_storage);
+        m_inline = true;
+    }
+    else if (rhs.m_value)
+    {
+        setShared(std::move(rhs.getShared()));
+    }
+    rhs.destroyValue();
+}
+
+std::shared_ptr<IVariantValue>& Variant::getShared()
+{
+    assert(m_value && !m_inline);
+    return *std::launder(reinterpret_cast<std::shared_ptr<IVariantValue>*>(m_storage));
+}
+
+const std::shared_ptr<IVariantValue>& Variant::getShared() const
+{
+    assert(m_value && !m_inline);
+    return *std::launder(reinterpret_cast<const std::shared_ptr<IVariantValue>*>(m_storage));
+}
+
+void Variant::setShared(std::shared_ptr<IVariantValue>&& value)
+{
+    assert(m_value == nullptr);
+    std::shared_ptr<IVariantValue>* shared = new (m_storage) std::shared_ptr<IVariantValue>(std::move(value));
+    m_value = shared->get();
+    m_inline = false;
+}
+
+void Variant::destroyValue()
+{
+    if (m_value)
+    {
+        if (m_inline)
+        {
+            m_value->~IVariantValue();
+        }
+        else
+        {
+            getShared().~shared_ptr();
+        }
+        m_value = nullptr;
+        m_inline = false;
+    }
+}
+
+void Variant::makeUnique()
+{
+    if (m_value && !m_inline)
+    {
+        std::shared_ptr<IVariantValue>& shared = getShared();
+        if (shared.use_count() > 1)
+        {
+            shared = m_value->clone();
+            m_value = shared.get();
+        }
+    }
+}
+
+
 void Variant::accept(IVariantVisitor& visitor, ssize_t index, int level, ssize_t size, const std::string& name, bool parentIsStruct)
 {
 
@@ -106,13 +186,24 @@ Variant* Variant::getVariant(const std::string& name)
         return nullptr;
     }
 
+    makeUnique();
     return m_value->getVariant(name);
 }
 
 
 const Variant* Variant::getVariant(const std::string& name) const
 {
-    return const_cast<Variant*>(this)->getVariant(name);
+    if (name.empty())
+    {
+        return this;
+    }
+    const IVariantValue* value = m_value;
+    if (value == nullptr)
+    {
+        return nullptr;
+    }
+
+    return value->getVariant(name);
 }
 
 
@@ -142,6 +233,7 @@ Variant* Variant::add(const std::string& name, const Variant& variant)
 {
     if (m_value)
     {
+        makeUnique();
         return m_value->add(name, variant);
     }
     return nullptr;
@@ -150,6 +242,7 @@ Variant* Variant::add(const std::string& name, Variant&& variant)
 {
     if (m_value)
     {
+        makeUnique();
         return m_value->add(name, std::move(variant));
     }
     return nullptr;
@@ -159,6 +252,7 @@ Variant* Variant::add(const Variant& variant)
 {
     if (m_value)
     {
+        makeUnique();
         return m_value->add(variant);
     }
     return nullptr;
@@ -167,6 +261,7 @@ Variant* Variant::add(Variant&& variant)
 {
     if (m_value)
     {
+        makeUnique();
         return m_value->add(std::move(variant));
     }
     return nullptr;
@@ -214,8 +309,10 @@ Variant& Variant::getOrCreate(const std::string& name)
         assert(sizeNew > 0);
         if (!m_value || m_value->getType() != VARTYPE_LIST)
         {
-            m_value = std::make_shared<VariantValueList>();
+            destroyValue();
+            setShared(std::make_shared<VariantValueList>());
         }
+        makeUnique();
         while (m_value->size() < sizeNew)
         {
             m_value->add(Variant());
@@ -233,8 +330,10 @@ Variant& Variant::getOrCreate(const std::string& name)
         }
         if (!m_value || m_value->getType() != VARTYPE_STRUCT)
         {
-            m_value = std::make_shared<VariantValueStruct>();
+            destroyValue();
+            setShared(std::make_shared<VariantValueStruct>());
         }
+        makeUnique();
         Variant* varSub = m_value->getVariant(partname);
         if (varSub == nullptr)
         {
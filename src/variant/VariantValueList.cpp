@@ -71,9 +71,31 @@ const void* VariantValueList::getData() const
 }
 
 
+static ssize_t getIndex(const std::string& name)
+{
+    return static_cast<ssize_t>(std::atoll(name.c_str()));
+}
+
+static void splitName(const std::string& name, std::string& partname, std::string& restname)
+{
+    //sperate first key ansd second key
+    size_t cntp = name.find('.');
+    if (cntp != std::string::npos)
+    {
+        partname = name.substr(0, cntp);
+        cntp++;
+        restname = name.substr(cntp);
+    }
+    else
+    {
+        partname = name;
+    }
+}
+
+
 VariantList::iterator VariantValueList::find(const std::string& name)
 {
-    ssize_t index = static_cast<ssize_t>(std::atoll(name.c_str()));
+    ssize_t index = getIndex(name);
     if (index >= 0 && index < static_cast<ssize_t>(m_value->size()))
     {
         return m_value->begin() + index;
@@ -93,19 +115,7 @@ Variant* VariantValueList::getVariant(const std::string& name)
 
     std::string partname;
     std::string restname;
-
-    //sperate first key ansd second key
-    size_t cntp = name.find('.');
-    if (cntp != std::string::npos)
-    {
-        partname = name.substr(0, cntp);
-        cntp++;
-        restname = name.substr(cntp);
-    }
-    else
-    {
-        partname = name;
-    }
+    splitName(name, partname, restname);
 
     // check if next key is in map (if not -> nullptr)
     auto it = find(partname);   // auto: std::unordered_map<std::string, Variant>::iterator
@@ -121,7 +131,23 @@ Variant* VariantValueList::getVariant(const std::string& name)
 
 const Variant* VariantValueList::getVariant(const std::string& name) const
 {
-    return const_cast<VariantValueList*>(this)->getVariant(name);
+    if (name.empty())
+    {
+        return nullptr;
+    }
+
+    std::string partname;
+    std::string restname;
+    splitName(name, partname, restname);
+
+    ssize_t index = getIndex(partname);
+    if (index < 0 || index >= static_cast<ssize_t>(m_value->size()))
+    {
+        return nullptr;
+    }
+
+    const Variant& variant = (*m_value)[index];
+    return variant.getVariant(restname);
 }
 
 
@@ -131,6 +157,18 @@ std::shared_ptr<IVariantValue> VariantValueList::clone() const
     return std::make_shared<VariantValueList>(*this);
 }
 
+IVariantValue* VariantValueList::cloneInline(void* storage) const
+{
+    static_assert(sizeof(VariantValueList) <= Variant::INLINE_SIZE, "value does not fit into a variant");
+    return new (storage) VariantValueList(*this);
+}
+
+IVariantValue* VariantValueList::moveInline(void* storage)
+{
+    static_assert(sizeof(VariantValueList) <= Variant::INLINE_SIZE, "value does not fit into a variant");
+    return new (storage) VariantValueList(std::move(*this));
+}
+
 
 bool VariantValueList::operator ==(const IVariantValue& rhs) const
 {
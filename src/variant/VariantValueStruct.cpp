@@ -28,6 +28,31 @@
 
 namespace finalmq {
 
+// up to this size, a linear search is faster than the hash index
+static constexpr size_t INDEX_THRESHOLD = 8;
+
+
+static void splitName(const std::string& name, std::string& partname, std::string& restname)
+{
+    //sperate first key ansd second key
+    size_t cntp = name.find('.');
+    if (cntp != std::string::npos)
+    {
+        partname = name.substr(0, cntp);
+        cntp++;
+        restname = name.substr(cntp);
+    }
+    else
+    {
+        partname = name;
+    }
+
+    // remove "", if available in partname
+    if ((partname.size() >= 2) && (partname[0] == '\"') && (partname.back() == '\"'))
+    {
+        partname = partname.substr(1, partname.size() - 2);
+    }
+}
 
 
 VariantValueStruct::VariantValueStruct()
@@ -42,6 +67,8 @@ VariantValueStruct::VariantValueStruct(const VariantValueStruct& rhs)
 
 VariantValueStruct::VariantValueStruct(VariantValueStruct&& rhs) noexcept
     : m_value(std::move(rhs.m_value))
+    , m_index(std::move(rhs.m_index))
+    , m_indexSize(rhs.m_indexSize)
 {
 }
 
@@ -62,17 +89,74 @@ int VariantValueStruct::getType() const
 
 void* VariantValueStruct::getData()
 {
+    // the caller can rename or replace entries, the index has to be rebuilt
+    m_index.reset();
+    m_indexSize = 0;
     return m_value.get();
 }
 
 const void* VariantValueStruct::getData() const
 {
-    return const_cast<VariantValueStruct*>(this)->getData();
+    return m_value.get();
+}
+
+
+bool VariantValueStruct::isIndexValid() const
+{
+    // the index is dropped when the entries are accessed through the non-const getData()
+    return (m_index && m_indexSize == m_value->size());
 }
 
+void VariantValueStruct::buildIndex()
+{
+    if (!m_index)
+    {
+        m_index = std::make_unique<std::unordered_map<std::string, ssize_t>>();
+    }
+    m_index->clear();
+    m_index->reserve(m_value->size());
+    ssize_t i = 0;
+    for (auto it = m_value->begin(); it != m_value->end(); ++it, ++i)
+    {
+        // like the linear search, the first entry with a name wins
+        m_index->emplace(it->first, i);
+    }
+    m_indexSize = m_value->size();
+}
+
+void VariantValueStruct::addToIndex(const std::string& name)
+{
+    if (m_index && m_indexSize + 1 == m_value->size())
+    {
+        m_index->emplace(name, m_indexSize);
+        ++m_indexSize;
+    }
+}
 
 VariantStruct::iterator VariantValueStruct::find(const std::string& name)
 {
+    if (m_value->size() > INDEX_THRESHOLD)
+    {
+        if (!isIndexValid())
+        {
+            buildIndex();
+        }
+        auto itIndex = m_index->find(name);
+        if (itIndex == m_index->end())
+        {
+            return m_value->end();
+        }
+        auto it = m_value->begin() + itIndex->second;
+        if (it->first == name)
+        {
+            return it;
+        }
+        // the entries were changed through a pointer that was taken before the index was built
+        buildIndex();
+        itIndex = m_index->find(name);
+        return (itIndex != m_index->end()) ? (m_value->begin() + itIndex->second) : m_value->end();
+    }
+
     for (auto it = m_value->begin(); it != m_value->end(); ++it)
     {
         if (it->first == name)
@@ -83,34 +167,43 @@ VariantStruct::iterator VariantValueStruct::find(const std::string& name)
     return m_value->end();
 }
 
-
-
-Variant* VariantValueStruct::getVariant(const std::string& name)
+VariantStruct::const_iterator VariantValueStruct::find(const std::string& name) const
 {
-    std::string partname;
-    std::string restname;
-
-    //sperate first key ansd second key
-    size_t cntp = name.find('.');
-    if (cntp != std::string::npos)
-    {
-        partname = name.substr(0, cntp);
-        cntp++;
-        restname = name.substr(cntp);
-    }
-    else
+    // the const version does not build the index, so that concurrent reads are possible
+    if (isIndexValid())
     {
-        partname = name;
+        auto itIndex = m_index->find(name);
+        if (itIndex == m_index->end())
+        {
+            return m_value->cend();
+        }
+        auto it = m_value->cbegin() + itIndex->second;
+        if (it->first == name)
+        {
+            return it;
+        }
     }
 
-    // remove "", if available in partname
-    if ((partname.size() >= 2) && (partname[0] == '\"') && (partname.back() == '\"'))
+    for (auto it = m_value->cbegin(); it != m_value->cend(); ++it)
     {
-        partname = partname.substr(1, partname.size() - 2);
+        if (it->first == name)
+        {
+            return it;
+        }
     }
+    return m_value->cend();
+}
+
+
+
+Variant* VariantValueStruct::getVariant(const std::string& name)
+{
+    std::string partname;
+    std::string restname;
+    splitName(name, partname, restname);
 
     // check if next key is in map (if not -> nullptr)
-    auto it = find(partname);   // auto: std::unordered_map<std::string, Variant>::iterator
+    auto it = find(partname);
     if (it == m_value->end())
     {
         return nullptr;
@@ -123,7 +216,17 @@ Variant* VariantValueStruct::getVariant(const std::string& name)
 
 const Variant* VariantValueStruct::getVariant(const std::string& name) const
 {
-    return const_cast<VariantValueStruct*>(this)->getVariant(name);
+    std::string partname;
+    std::string restname;
+    splitName(name, partname, restname);
+
+    auto it = find(partname);
+    if (it == m_value->cend())
+    {
+        return nullptr;
+    }
+
+    return it->second.getVariant(restname);
 }
 
 
@@ -132,6 +235,18 @@ std::shared_ptr<IVariantValue> VariantValueStruct::clone() const
     return std::make_shared<VariantValueStruct>(*this);
 }
 
+IVariantValue* VariantValueStruct::cloneInline(void* storage) const
+{
+    static_assert(sizeof(VariantValueStruct) <= Variant::INLINE_SIZE, "value does not fit into a variant");
+    return new (storage) VariantValueStruct(*this);
+}
+
+IVariantValue* VariantValueStruct::moveInline(void* storage)
+{
+    static_assert(sizeof(VariantValueStruct) <= Variant::INLINE_SIZE, "value does not fit into a variant");
+    return new (storage) VariantValueStruct(std::move(*this));
+}
+
 
 bool VariantValueStruct::operator ==(const IVariantValue& rhs) const
 {
@@ -161,6 +276,7 @@ Variant* VariantValueStruct::add(const std::string& name, const Variant& variant
     if (it == m_value->end())
     {
         m_value->emplace_back(name, variant);
+        addToIndex(m_value->back().first);
         return &m_value->back().second;
     }
     else
@@ -176,11 +292,12 @@ Variant* VariantValueStruct::add(const std::string& name, Variant&& variant)
     if (it == m_value->end())
     {
         m_value->emplace_back(name, std::move(variant));
+        addToIndex(m_value->back().first);
         return &m_value->back().second;
     }
     else
     {
-        it->second = variant;
+        it->second = std::move(variant);
         return &it->second;
     }
 }
@@ -191,6 +308,7 @@ Variant* VariantValueStruct::add(const Variant& variant)
     if (it == m_value->end())
     {
         m_value->emplace_back("", variant);
+        addToIndex(m_value->back().first);
         return &m_value->back().second;
     }
     else
@@ -206,11 +324,12 @@ Variant* VariantValueStruct::add(Variant&& variant)
     if (it == m_value->end())
     {
         m_value->emplace_back("", std::move(variant));
+        addToIndex(m_value->back().first);
         return &m_value->back().second;
     }
     else
     {
-        it->second = variant;
+        it->second = std::move(variant);
         return &it->second;
     }
 }
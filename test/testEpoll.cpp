@@ -44,11 +44,9 @@ using namespace finalmq;
 static const std::string BUFFER = "Hello";
 
 static const int EPOLL_FD = 3;
-static const int CONTROLSOCKET_READ = 4;
-static const int CONTROLSOCKET_WRITE = 5;
+static const int CONTROLEVENT = 4;
 static const int TESTSOCKET = 7;
 
-static const int NUMBER_OF_BYTES_TO_READ = 20;
 static const int TIMEOUT = 10;
 
 
@@ -66,15 +64,13 @@ protected:
         EXPECT_CALL(*m_mockMockOperatingSystem, epoll_create1(EPOLL_CLOEXEC)).Times(1)
                     .WillRepeatedly(Return(EPOLL_FD));
 
-        SocketDescriptorPtr sd1 = std::make_shared<SocketDescriptor>(CONTROLSOCKET_READ);
-        SocketDescriptorPtr sd2 = std::make_shared<SocketDescriptor>(CONTROLSOCKET_WRITE);
-        EXPECT_CALL(*m_mockMockOperatingSystem, makeSocketPair(_, _)).Times(1)
-                    .WillRepeatedly(DoAll(testing::SetArgReferee<0>(sd1), testing::SetArgReferee<1>(sd2), Return(0)));
+        EXPECT_CALL(*m_mockMockOperatingSystem, eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC)).Times(1)
+                    .WillRepeatedly(Return(CONTROLEVENT));
 
         epoll_event evCtl;
         evCtl.events = EPOLLIN;
-        evCtl.data.fd = CONTROLSOCKET_READ;
-        EXPECT_CALL(*m_mockMockOperatingSystem, epoll_ctl(EPOLL_FD, EPOLL_CTL_ADD, CONTROLSOCKET_READ, Event(&evCtl))).Times(1);
+        evCtl.data.fd = CONTROLEVENT;
+        EXPECT_CALL(*m_mockMockOperatingSystem, epoll_ctl(EPOLL_FD, EPOLL_CTL_ADD, CONTROLEVENT, Event(&evCtl))).Times(1);
 
         m_select->init();
         testing::Mock::VerifyAndClearExpectations(m_mockMockOperatingSystem);
@@ -124,8 +120,7 @@ TEST_F(TestEpoll, testAddSocketReadableWait)
 
     EXPECT_CALL(*m_mockMockOperatingSystem, epoll_pwait(EPOLL_FD, _, _, TIMEOUT, nullptr)).Times(1)
                 .WillRepeatedly(testing::DoAll(testing::SetArgPointee<1>(events), Return(1)));
-    EXPECT_CALL(*m_mockMockOperatingSystem, ioctlInt(socket->getDescriptor(), FIONREAD, _)).Times(1)
-                                                        .WillRepeatedly(testing::DoAll(testing::SetArgPointee<2>(NUMBER_OF_BYTES_TO_READ), Return(0)));
+    EXPECT_CALL(*m_mockMockOperatingSystem, ioctlInt(_, _, _)).Times(0);
 
     const PollerResult& result = m_select->wait(TIMEOUT);
     EXPECT_EQ(result.error, false);
@@ -137,7 +132,6 @@ TEST_F(TestEpoll, testAddSocketReadableWait)
         EXPECT_EQ(result.descriptorInfos[0].disconnected, false);
         EXPECT_EQ(result.descriptorInfos[0].readable, true);
         EXPECT_EQ(result.descriptorInfos[0].writable, false);
-        EXPECT_EQ(result.descriptorInfos[0].bytesToRead, NUMBER_OF_BYTES_TO_READ);
     }
 }
 
@@ -167,8 +161,7 @@ TEST_F(TestEpoll, testAddSocketReadableEINTR)
     }
     EXPECT_CALL(*m_mockMockOperatingSystem, getLastError()).Times(1)
                         .WillOnce(Return(SOCKETERROR(EINTR)));
-    EXPECT_CALL(*m_mockMockOperatingSystem, ioctlInt(socket->getDescriptor(), FIONREAD, _)).Times(1)
-                                                        .WillRepeatedly(testing::DoAll(testing::SetArgPointee<2>(NUMBER_OF_BYTES_TO_READ), Return(0)));
+    EXPECT_CALL(*m_mockMockOperatingSystem, ioctlInt(_, _, _)).Times(0);
 
     const PollerResult& result = m_select->wait(TIMEOUT);
     EXPECT_EQ(result.error, false);
@@ -180,7 +173,6 @@ TEST_F(TestEpoll, testAddSocketReadableEINTR)
         EXPECT_EQ(result.descriptorInfos[0].disconnected, false);
         EXPECT_EQ(result.descriptorInfos[0].readable, true);
         EXPECT_EQ(result.descriptorInfos[0].writable, false);
-        EXPECT_EQ(result.descriptorInfos[0].bytesToRead, NUMBER_OF_BYTES_TO_READ);
     }
 }
 
@@ -240,8 +232,7 @@ TEST_F(TestEpoll, testAddSocketReadableWaitSocketDescriptorsChanged)
                     Return(1)
                 )
             );
-    EXPECT_CALL(*m_mockMockOperatingSystem, ioctlInt(socket->getDescriptor(), FIONREAD, _)).Times(1)
-                                                        .WillRepeatedly(testing::DoAll(testing::SetArgPointee<2>(NUMBER_OF_BYTES_TO_READ), Return(0)));
+    EXPECT_CALL(*m_mockMockOperatingSystem, ioctlInt(_, _, _)).Times(0);
 
     EXPECT_CALL(*m_mockMockOperatingSystem, closeSocket(socket->getDescriptor())).WillRepeatedly(Return(0));
 
@@ -255,7 +246,6 @@ TEST_F(TestEpoll, testAddSocketReadableWaitSocketDescriptorsChanged)
         EXPECT_EQ(result.descriptorInfos[0].disconnected, false);
         EXPECT_EQ(result.descriptorInfos[0].readable, true);
         EXPECT_EQ(result.descriptorInfos[0].writable, false);
-        EXPECT_EQ(result.descriptorInfos[0].bytesToRead, NUMBER_OF_BYTES_TO_READ);
     }
 }
 
@@ -276,8 +266,7 @@ TEST_F(TestEpoll, testAddSocketDisconnectRead)
 
     EXPECT_CALL(*m_mockMockOperatingSystem, epoll_pwait(EPOLL_FD, _, _, TIMEOUT, nullptr)).Times(1)
                                                 .WillRepeatedly(testing::DoAll(testing::SetArgPointee<1>(events), Return(1)));
-    EXPECT_CALL(*m_mockMockOperatingSystem, ioctlInt(socket->getDescriptor(), FIONREAD, _)).Times(1)
-                                                .WillRepeatedly(testing::DoAll(testing::SetArgPointee<2>(0), Return(0)));
+    EXPECT_CALL(*m_mockMockOperatingSystem, ioctlInt(_, _, _)).Times(0);
 
     const PollerResult& result = m_select->wait(TIMEOUT);
     EXPECT_EQ(result.error, false);
@@ -289,7 +278,6 @@ TEST_F(TestEpoll, testAddSocketDisconnectRead)
         EXPECT_EQ(result.descriptorInfos[0].disconnected, false);
         EXPECT_EQ(result.descriptorInfos[0].readable, true);
         EXPECT_EQ(result.descriptorInfos[0].writable, false);
-        EXPECT_EQ(result.descriptorInfos[0].bytesToRead, 0);
     }
 }
 
@@ -323,45 +311,9 @@ TEST_F(TestEpoll, testAddSocketDisconnectEpollError)
         EXPECT_EQ(result.descriptorInfos[0].disconnected, true);
         EXPECT_EQ(result.descriptorInfos[0].readable, false);
         EXPECT_EQ(result.descriptorInfos[0].writable, false);
-        EXPECT_EQ(result.descriptorInfos[0].bytesToRead, 0);
     }
 }
 
-TEST_F(TestEpoll, testAddSocketIoCtlError)
-{
-    SocketDescriptorPtr socket = std::make_shared<SocketDescriptor>(TESTSOCKET);
-
-    epoll_event evCtl;
-    evCtl.events = EPOLLIN;
-    evCtl.data.fd = socket->getDescriptor();
-    EXPECT_CALL(*m_mockMockOperatingSystem, epoll_ctl(EPOLL_FD, EPOLL_CTL_ADD, socket->getDescriptor(), Event(&evCtl))).Times(1);
-
-    m_select->addSocketEnableRead(socket);
-
-    struct epoll_event events;
-    events.data.fd = socket->getDescriptor();
-    events.events = EPOLLIN;
-
-    EXPECT_CALL(*m_mockMockOperatingSystem, epoll_pwait(EPOLL_FD, _, _, TIMEOUT, nullptr)).Times(1)
-                                                .WillRepeatedly(testing::DoAll(testing::SetArgPointee<1>(events), Return(1)));
-    EXPECT_CALL(*m_mockMockOperatingSystem, ioctlInt(socket->getDescriptor(), FIONREAD, _)).Times(1)
-                                                .WillRepeatedly(testing::DoAll(testing::SetArgPointee<2>(0), Return(-1)));
-
-    const PollerResult& result = m_select->wait(TIMEOUT);
-    EXPECT_EQ(result.error, false);
-    EXPECT_EQ(result.timeout, false);
-    EXPECT_EQ(result.descriptorInfos.size(), 1);
-    if (result.descriptorInfos.size() == 1)
-    {
-        EXPECT_EQ(result.descriptorInfos[0].sd, socket->getDescriptor());
-        EXPECT_EQ(result.descriptorInfos[0].disconnected, false);
-        EXPECT_EQ(result.descriptorInfos[0].readable, true);
-        EXPECT_EQ(result.descriptorInfos[0].writable, false);
-        EXPECT_EQ(result.descriptorInfos[0].bytesToRead, 0);
-    }
-}
-
-
 TEST_F(TestEpoll, testAddSocketWritableWait)
 {
     SocketDescriptorPtr socket = std::make_shared<SocketDescriptor>(TESTSOCKET);
@@ -397,7 +349,6 @@ TEST_F(TestEpoll, testAddSocketWritableWait)
         EXPECT_EQ(result.descriptorInfos[0].disconnected, false);
         EXPECT_EQ(result.descriptorInfos[0].readable, false);
         EXPECT_EQ(result.descriptorInfos[0].writable, true);
-        EXPECT_EQ(result.descriptorInfos[0].bytesToRead, 0);
     }
 }
 
@@ -438,4 +389,52 @@ TEST_F(TestEpoll, testAddSocketDisableWritableWait)
 }
 
 
+TEST_F(TestEpoll, testReleaseWaitNotSleeping)
+{
+    EXPECT_CALL(*m_mockMockOperatingSystem, write(_, _, _)).Times(0);
+
+    m_select->releaseWait(1);
+    m_select->releaseWait(2);
+
+    EXPECT_CALL(*m_mockMockOperatingSystem, epoll_pwait(EPOLL_FD, _, _, 0, nullptr)).Times(1)
+                                                .WillRepeatedly(Return(0));
+
+    const PollerResult& result = m_select->wait(TIMEOUT);
+    EXPECT_EQ(result.error, false);
+    EXPECT_EQ(result.timeout, false);
+    EXPECT_EQ(result.releaseWait, 3);
+    EXPECT_EQ(result.descriptorInfos.size(), 0);
+}
+
+
+TEST_F(TestEpoll, testReleaseWaitSleepingCoalesced)
+{
+    IPoller* poller = m_select.get();
+
+    struct epoll_event events;
+    events.data.fd = CONTROLEVENT;
+    events.events = EPOLLIN;
+
+    EXPECT_CALL(*m_mockMockOperatingSystem, write(CONTROLEVENT, _, sizeof(std::uint64_t))).Times(1)
+                                                .WillRepeatedly(Return(sizeof(std::uint64_t)));
+    EXPECT_CALL(*m_mockMockOperatingSystem, epoll_pwait(EPOLL_FD, _, _, TIMEOUT, nullptr)).Times(1)
+                                                .WillRepeatedly(testing::DoAll(
+                                                    testing::InvokeWithoutArgs([poller]() {
+                                                        for (int i = 0; i < 1000; ++i)
+                                                        {
+                                                            poller->releaseWait(1);
+                                                        }
+                                                    }),
+                                                    testing::SetArgPointee<1>(events), Return(1)));
+    EXPECT_CALL(*m_mockMockOperatingSystem, read(CONTROLEVENT, _, sizeof(std::uint64_t))).Times(1)
+                                                .WillRepeatedly(Return(sizeof(std::uint64_t)));
+
+    const PollerResult& result = m_select->wait(TIMEOUT);
+    EXPECT_EQ(result.error, false);
+    EXPECT_EQ(result.timeout, false);
+    EXPECT_EQ(result.releaseWait, 1);
+    EXPECT_EQ(result.descriptorInfos.size(), 0);
+}
+
+
 #endif
@@ -0,0 +1,251 @@
+//MIT License
+
+//Copyright (c) 2020 bexoft GmbH (mail@bexoft.de)
+
+//Permission is hereby granted, free of charge, to any person obtaining a copy
+//of this software and associated documentation files (the "Software"), to deal
+//in the Software without restriction, including without limitation the rights
+//to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//copies of the Software, and to permit persons to whom the Software is
+//furnished to do so, subject to the following conditions:
+
+//The above copyright notice and this permission notice shall be included in all
+//copies or substantial portions of the Software.
+
+//THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//SOFTWARE.
+
+
+#include "gtest/gtest.h"
+#include "gmock/gmock.h"
+
+#include <array>
+#include <chrono>
+
+#include "finalmq/helpers/Executor.h"
+
+
+using namespace finalmq;
+
+
+static const int NUMBER_OF_WORKERS = 4;
+static const int NUMBER_OF_INSTANCES = 16;
+
+
+static bool waitForCounter(const std::atomic<int>& counter, int expected)
+{
+    auto start = std::chrono::steady_clock::now();
+    while (counter.load() < expected)
+    {
+        if (std::chrono::steady_clock::now() - start > std::chrono::seconds(20))
+        {
+            return false;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    return true;
+}
+
+
+
+template<class T>
+class TestExecutor : public testing::Test
+{
+};
+
+typedef testing::Types<Executor, ExecutorWorkStealing> ExecutorTypes;
+TYPED_TEST_SUITE(TestExecutor, ExecutorTypes);
+
+
+TYPED_TEST(TestExecutor, testOrderOfInstance)
+{
+    static const int NUMBER_OF_ACTIONS = 2000;
+    ExecutorWorker<TypeParam> worker(NUMBER_OF_WORKERS);
+
+    std::vector<int> sequences(NUMBER_OF_INSTANCES + 1, 0);
+    std::vector<std::atomic<int>> running(NUMBER_OF_INSTANCES + 1);
+    std::atomic<int> errors{0};
+    std::atomic<int> counter{0};
+
+    for (int i = 0; i < NUMBER_OF_ACTIONS; ++i)
+    {
+        for (int instance = 1; instance <= NUMBER_OF_INSTANCES; ++instance)
+        {
+            worker.addAction([&sequences, &running, &errors, &counter, instance, i]() {
+                if (running[instance].fetch_add(1) != 0)
+                {
+                    ++errors;
+                }
+                if (sequences[instance] != i)
+                {
+                    ++errors;
+                }
+                sequences[instance] = i + 1;
+                running[instance].fetch_sub(1);
+                ++counter;
+            }, instance);
+        }
+        worker.addAction([&counter]() {
+            ++counter;
+        });
+    }
+
+    ASSERT_TRUE(waitForCounter(counter, NUMBER_OF_ACTIONS * (NUMBER_OF_INSTANCES + 1)));
+    EXPECT_EQ(errors.load(), 0);
+    for (int instance = 1; instance <= NUMBER_OF_INSTANCES; ++instance)
+    {
+        EXPECT_EQ(sequences[instance], NUMBER_OF_ACTIONS);
+    }
+}
+
+
+TYPED_TEST(TestExecutor, testAddActionsInsideActions)
+{
+    static const int NUMBER_OF_ACTIONS = 1000;
+    static const int NUMBER_OF_CHILDREN = 10;
+    ExecutorWorker<TypeParam> worker(NUMBER_OF_WORKERS);
+
+    std::atomic<int> counter{0};
+    for (int i = 0; i < NUMBER_OF_ACTIONS; ++i)
+    {
+        worker.addAction([&worker, &counter]() {
+            for (int n = 0; n < NUMBER_OF_CHILDREN; ++n)
+            {
+                worker.addAction([&counter]() {
+                    ++counter;
+                });
+            }
+        });
+    }
+
+    ASSERT_TRUE(waitForCounter(counter, NUMBER_OF_ACTIONS * NUMBER_OF_CHILDREN));
+}
+
+
+TYPED_TEST(TestExecutor, testRunAvailableActions)
+{
+    IExecutorPtr executor = std::make_shared<TypeParam>();
+    int notifications = 0;
+    executor->registerActionNotification([&notifications]() {
+        ++notifications;
+    });
+
+    std::vector<int> order;
+    executor->addAction([&order]() { order.push_back(1); }, 5);
+    executor->addAction([&order]() { order.push_back(2); }, 5);
+    executor->addAction([&order]() { order.push_back(3); }, 7);
+    EXPECT_GE(notifications, 1);
+
+    EXPECT_EQ(executor->runAvailableActions(), true);
+    EXPECT_EQ(executor->runAvailableActions(), false);
+    ASSERT_EQ(order.size(), 3);
+    EXPECT_LT(std::find(order.begin(), order.end(), 1), std::find(order.begin(), order.end(), 2));
+}
+
+
+
+TYPED_TEST(TestExecutor, testContention)
+{
+    static const int NUMBER_OF_PRODUCERS = 4;
+    static const int ACTIONS_PER_PRODUCER = 5000;
+    ExecutorWorker<TypeParam> worker(NUMBER_OF_WORKERS);
+
+    std::vector<std::atomic<int>> executed(NUMBER_OF_PRODUCERS * ACTIONS_PER_PRODUCER);
+    std::atomic<int> counter{0};
+    std::vector<std::thread> producers;
+    for (int p = 0; p < NUMBER_OF_PRODUCERS; ++p)
+    {
+        producers.emplace_back([&worker, &executed, &counter, p]() {
+            for (int i = 0; i < ACTIONS_PER_PRODUCER; ++i)
+            {
+                // mix actions without instance with actions of instances that are owned by this producer
+                std::int64_t instanceId = (i % 2 == 0) ? 0 : (p * NUMBER_OF_INSTANCES + (i % NUMBER_OF_INSTANCES) + 1);
+                int index = p * ACTIONS_PER_PRODUCER + i;
+                worker.addAction([&executed, &counter, index]() {
+                    ++executed[index];
+                    ++counter;
+                }, instanceId);
+            }
+        });
+    }
+    for (auto& producer : producers)
+    {
+        producer.join();
+    }
+
+    ASSERT_TRUE(waitForCounter(counter, NUMBER_OF_PRODUCERS * ACTIONS_PER_PRODUCER));
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    EXPECT_EQ(counter.load(), NUMBER_OF_PRODUCERS * ACTIONS_PER_PRODUCER);
+    for (int index = 0; index < NUMBER_OF_PRODUCERS * ACTIONS_PER_PRODUCER; ++index)
+    {
+        ASSERT_EQ(executed[index].load(), 1);
+    }
+}
+
+
+
+TEST(TestActionFunction, testInlineAndHeap)
+{
+    std::shared_ptr<int> value = std::make_shared<int>(0);
+    std::weak_ptr<int> valueWeak = value;
+    ActionFunction small([valueWeak, value]() {
+        ++*value;
+    });
+    std::array<char, 200> bigCapture{};
+    ActionFunction big([value, bigCapture]() {
+        *value += 10 + bigCapture[0];
+    });
+    EXPECT_TRUE(small);
+    EXPECT_TRUE(big);
+    EXPECT_EQ(value.use_count(), 3);
+
+    ActionFunction smallMoved = std::move(small);
+    ActionFunction bigMoved;
+    bigMoved = std::move(big);
+    EXPECT_FALSE(small);
+    EXPECT_FALSE(big);
+    smallMoved();
+    bigMoved();
+    EXPECT_EQ(*value, 11);
+
+    smallMoved = nullptr;
+    bigMoved.reset();
+    EXPECT_EQ(value.use_count(), 1);
+}
+
+TEST(TestActionFunction, testEmptyStdFunction)
+{
+    std::function<void()> empty;
+    ActionFunction func(empty);
+    EXPECT_FALSE(func);
+
+    int counter = 0;
+    std::function<void()> notEmpty = [&counter]() { ++counter; };
+    ActionFunction func2(notEmpty);
+    ASSERT_TRUE(func2);
+    func2();
+    EXPECT_EQ(counter, 1);
+}
+
+TEST(TestExecutorReuse, testCapturesAreReleased)
+{
+    IExecutorPtr executor = std::make_shared<Executor>();
+    std::shared_ptr<int> value = std::make_shared<int>(0);
+    for (int n = 0; n < 3; ++n)
+    {
+        for (int i = 0; i < 100; ++i)
+        {
+            executor->addAction([value]() { ++*value; }, i % 3);
+        }
+        while (executor->runAvailableActionBatch())
+        {
+        }
+        EXPECT_EQ(value.use_count(), 1);
+    }
+    EXPECT_EQ(*value, 300);
+}
@@ -28,6 +28,7 @@
 #include "MockIProtocolSessionCallback.h"
 #include "finalmq/protocols/ProtocolDelimiterLinefeed.h"
 #include "finalmq/protocols/ProtocolStream.h"
+#include "finalmq/protocols/ProtocolHeaderBinarySize.h"
 #include "testHelper.h"
 #include "finalmq/connectionhub/ConnectionHub.h"
 #include "matchers.h"
@@ -300,3 +301,70 @@ TEST_F(TestIntegrationConnectionHub, testStopForwardingFromSession)
     std::this_thread::sleep_for(std::chrono::milliseconds(20));
 }
 
+
+
+static auto SessionId(const IProtocolSessionPtr& session)
+{
+    return testing::Pointee(testing::Property(&IProtocolSession::getSessionId, session->getSessionId()));
+}
+
+TEST_F(TestIntegrationConnectionHub, testForwardToManySessions)
+{
+    auto& expectConnectClient = EXPECT_CALL(*m_mockClientCallback, connected(_)).Times(3);
+
+    m_connectionHub->bind("tcp://*:3334:delimiter_lf");
+    m_connectionHub->startMessageForwarding();
+    IProtocolSessionPtr session1 = m_sessionContainer->connect("tcp://localhost:3334:delimiter_lf", m_mockClientCallback, { {},{1} });
+    IProtocolSessionPtr session2 = m_sessionContainer->connect("tcp://localhost:3334:delimiter_lf", m_mockClientCallback, { {},{1} });
+    IProtocolSessionPtr session3 = m_sessionContainer->connect("tcp://localhost:3334:delimiter_lf", m_mockClientCallback, { {},{1} });
+
+    waitTillDone(expectConnectClient, 5000);
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+
+    // match the session ids, the expectations must not hold references to the sessions that own the callback
+    EXPECT_CALL(*m_mockClientCallback, received(SessionId(session1), _)).Times(0);
+    auto& expectReceive2 = EXPECT_CALL(*m_mockClientCallback, received(SessionId(session2), ReceivedMessage(MESSAGE_BUFFER))).Times(2);
+    auto& expectReceive3 = EXPECT_CALL(*m_mockClientCallback, received(SessionId(session3), ReceivedMessage(MESSAGE_BUFFER))).Times(2);
+
+    for (int i = 0; i < 2; ++i)
+    {
+        IMessagePtr message = session1->createMessage();
+        message->addSendPayload(MESSAGE_BUFFER);
+        session1->sendMessage(message);
+    }
+
+    waitTillDone(expectReceive2, 5000);
+    waitTillDone(expectReceive3, 5000);
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+}
+
+TEST_F(TestIntegrationConnectionHub, testForwardToSessionsOfOtherProtocols)
+{
+    auto& expectConnectClient = EXPECT_CALL(*m_mockClientCallback, connected(_)).Times(3);
+
+    m_connectionHub->bind("tcp://*:3334:delimiter_lf");
+    m_connectionHub->bind("tcp://*:3335:headersize");
+    m_connectionHub->startMessageForwarding();
+    IProtocolSessionPtr session1 = m_sessionContainer->connect("tcp://localhost:3334:delimiter_lf", m_mockClientCallback, { {},{1} });
+    IProtocolSessionPtr session2 = m_sessionContainer->connect("tcp://localhost:3334:delimiter_lf", m_mockClientCallback, { {},{1} });
+    IProtocolSessionPtr session3 = m_sessionContainer->connect("tcp://localhost:3335:headersize", m_mockClientCallback, { {},{1} });
+
+    waitTillDone(expectConnectClient, 5000);
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+
+    // every session frames the same forwarded payload with the header or trailer of its own protocol
+    EXPECT_CALL(*m_mockClientCallback, received(SessionId(session1), _)).Times(0);
+    auto& expectReceive2 = EXPECT_CALL(*m_mockClientCallback, received(SessionId(session2), ReceivedMessage(MESSAGE_BUFFER))).Times(2);
+    auto& expectReceive3 = EXPECT_CALL(*m_mockClientCallback, received(SessionId(session3), ReceivedMessage(MESSAGE_BUFFER))).Times(2);
+
+    for (int i = 0; i < 2; ++i)
+    {
+        IMessagePtr message = session1->createMessage();
+        message->addSendPayload(MESSAGE_BUFFER);
+        session1->sendMessage(message);
+    }
+
+    waitTillDone(expectReceive2, 5000);
+    waitTillDone(expectReceive3, 5000);
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+}
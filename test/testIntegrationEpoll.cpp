@@ -82,7 +82,6 @@ TEST(TestIntegrationEpoll, testAddSocketReadableBeforeWait)
     EXPECT_EQ(result.descriptorInfos[0].sd, controlSocketInside->getDescriptor());
     EXPECT_EQ(result.descriptorInfos[0].readable, true);
     EXPECT_EQ(result.descriptorInfos[0].writable, false);
-    EXPECT_EQ(result.descriptorInfos[0].bytesToRead, BUFFER.size());
 }
 
 
@@ -113,7 +112,6 @@ TEST(TestIntegrationEpoll, testAddSocketReadableInsideWait)
     EXPECT_EQ(result.descriptorInfos[0].sd, controlSocketInside->getDescriptor());
     EXPECT_EQ(result.descriptorInfos[0].readable, true);
     EXPECT_EQ(result.descriptorInfos[0].writable, false);
-    EXPECT_EQ(result.descriptorInfos[0].bytesToRead, BUFFER.size());
 
     thread.join();
 }
@@ -147,7 +145,6 @@ TEST(TestIntegrationEpoll, testEnableWriteSocketBeforeWait)
     EXPECT_EQ(result2.descriptorInfos[0].sd, controlSocketInside->getDescriptor());
     EXPECT_EQ(result2.descriptorInfos[0].readable, false);
     EXPECT_EQ(result2.descriptorInfos[0].writable, true);
-    EXPECT_EQ(result2.descriptorInfos[0].bytesToRead, 0);
 }
 
 
@@ -184,7 +181,6 @@ TEST(TestIntegrationEpoll, testEnableWriteSocketInsideWait)
     EXPECT_EQ(result2.descriptorInfos[0].sd, controlSocketInside->getDescriptor());
     EXPECT_EQ(result2.descriptorInfos[0].readable, false);
     EXPECT_EQ(result2.descriptorInfos[0].writable, true);
-    EXPECT_EQ(result2.descriptorInfos[0].bytesToRead, 0);
 
     thread.join();
 }
@@ -268,7 +264,6 @@ TEST(TestIntegrationEpoll, testEnableWriteSocketNotWritableToWritable)
     EXPECT_EQ(result2.descriptorInfos[0].sd, controlSocketInside->getDescriptor());
     EXPECT_EQ(result2.descriptorInfos[0].readable, false);
     EXPECT_EQ(result2.descriptorInfos[0].writable, true);
-    EXPECT_EQ(result2.descriptorInfos[0].bytesToRead, 0);
 
     thread.join();
 }
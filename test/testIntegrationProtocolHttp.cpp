@@ -321,3 +321,226 @@ TEST_F(TestIntegrationProtocolHttp, testCookie)
     connection->sendMessage(message);
     waitTillDone(expectReceive3, 5000);
 }
+
+TEST_F(TestIntegrationProtocolHttp, testPipelinedRequests)
+{
+    int res = m_sessionContainer->bind("tcp://*:3335:httpserver", m_mockServerCallback);
+    EXPECT_EQ(res, 0);
+
+    static const int NUMBER_OF_REQUESTS = 1000;
+
+    auto& expectConnectedClient = EXPECT_CALL(*m_mockClientCallback, connected(_)).Times(1);
+    EXPECT_CALL(*m_mockServerCallback, connected(_)).Times(testing::Between(1, NUMBER_OF_REQUESTS));
+    auto& expectReceive = EXPECT_CALL(*m_mockServerCallback, received(_, _))
+        .Times(NUMBER_OF_REQUESTS)
+        .WillRepeatedly(Invoke([](const IProtocolSessionPtr& session, const IMessagePtr& message) {
+            IMessagePtr reply = session->createMessage();
+            BufferRef payload = message->getReceivePayload();
+            reply->addSendPayload(std::string(payload.first, payload.second));
+            reply->getEchoData() = message->getEchoData();
+            session->sendMessage(reply, true);
+        })
+    );
+
+    // the replies of the pipelined requests come in the order of the requests
+    std::atomic<int> counter{0};
+    std::atomic<bool> inOrder{true};
+    auto& expectReceivedClient = EXPECT_CALL(*m_mockClientCallback, received(_, _))
+        .Times(NUMBER_OF_REQUESTS)
+        .WillRepeatedly(Invoke([&counter, &inOrder](const IProtocolSessionPtr& /*session*/, const IMessagePtr& message) {
+            BufferRef payload = message->getReceivePayload();
+            if (std::string(payload.first, payload.second) != std::to_string(counter))
+            {
+                inOrder = false;
+            }
+            ++counter;
+        })
+    );
+
+    ConnectProperties connectProperties;
+    connectProperties.protocolData = VariantStruct{ {"max_sync_reqrep_connections", 1}, {"max_pipelined_requests", 16} };
+    IProtocolSessionPtr connection = m_sessionContainer->connect("tcp://localhost:3335:httpclient", m_mockClientCallback, connectProperties);
+    for (int i = 0; i < NUMBER_OF_REQUESTS; ++i)
+    {
+        IMessagePtr message = connection->createMessage();
+        message->addSendPayload(std::to_string(i));
+        connection->sendMessage(message);
+    }
+    waitTillDone(expectConnectedClient, 5000);
+    waitTillDone(expectReceive, 10000);
+    waitTillDone(expectReceivedClient, 5000);
+    EXPECT_EQ(counter, NUMBER_OF_REQUESTS);
+    EXPECT_TRUE(inOrder);
+}
+
+TEST_F(TestIntegrationProtocolHttp, testPipelinedRepliesOutOfOrder)
+{
+    int res = m_sessionContainer->bind("tcp://*:3335:httpserver", m_mockServerCallback);
+    EXPECT_EQ(res, 0);
+
+    static const int NUMBER_OF_REQUESTS = 8;
+
+    // the server replies after it got all requests, in the reverse order of the requests
+    std::vector<std::pair<IProtocolSessionPtr, IMessagePtr>> requests;
+    auto& expectConnectedClient = EXPECT_CALL(*m_mockClientCallback, connected(_)).Times(1);
+    EXPECT_CALL(*m_mockServerCallback, connected(_)).Times(testing::Between(1, NUMBER_OF_REQUESTS));
+    auto& expectReceive = EXPECT_CALL(*m_mockServerCallback, received(_, _))
+        .Times(NUMBER_OF_REQUESTS)
+        .WillRepeatedly(Invoke([&requests](const IProtocolSessionPtr& session, const IMessagePtr& message) {
+            requests.emplace_back(session, message);
+            if (requests.size() == NUMBER_OF_REQUESTS)
+            {
+                for (auto it = requests.rbegin(); it != requests.rend(); ++it)
+                {
+                    IMessagePtr reply = it->first->createMessage();
+                    BufferRef payload = it->second->getReceivePayload();
+                    reply->addSendPayload(std::string(payload.first, payload.second));
+                    reply->getEchoData() = it->second->getEchoData();
+                    it->first->sendMessage(reply, true);
+                }
+                requests.clear();
+            }
+        })
+    );
+
+    // the server sends the responses in the order of the requests, so the client matches them correctly
+    std::atomic<int> counter{0};
+    std::atomic<bool> inOrder{true};
+    auto& expectReceivedClient = EXPECT_CALL(*m_mockClientCallback, received(_, _))
+        .Times(NUMBER_OF_REQUESTS)
+        .WillRepeatedly(Invoke([&counter, &inOrder](const IProtocolSessionPtr& /*session*/, const IMessagePtr& message) {
+            BufferRef payload = message->getReceivePayload();
+            if (std::string(payload.first, payload.second) != std::to_string(counter))
+            {
+                inOrder = false;
+            }
+            ++counter;
+        })
+    );
+
+    ConnectProperties connectProperties;
+    connectProperties.protocolData = VariantStruct{ {"max_sync_reqrep_connections", 1}, {"max_pipelined_requests", NUMBER_OF_REQUESTS} };
+    IProtocolSessionPtr connection = m_sessionContainer->connect("tcp://localhost:3335:httpclient", m_mockClientCallback, connectProperties);
+    for (int i = 0; i < NUMBER_OF_REQUESTS; ++i)
+    {
+        IMessagePtr message = connection->createMessage();
+        message->addSendPayload(std::to_string(i));
+        connection->sendMessage(message);
+    }
+    waitTillDone(expectConnectedClient, 5000);
+    waitTillDone(expectReceive, 5000);
+    waitTillDone(expectReceivedClient, 5000);
+    EXPECT_TRUE(inOrder);
+}
+
+TEST_F(TestIntegrationProtocolHttp, testConnectionPool)
+{
+    int res = m_sessionContainer->bind("tcp://*:3335:httpserver", m_mockServerCallback);
+    EXPECT_EQ(res, 0);
+
+    auto& expectConnectedClient = EXPECT_CALL(*m_mockClientCallback, connected(_)).Times(2);
+    EXPECT_CALL(*m_mockServerCallback, connected(_)).Times(testing::Between(1, 2));
+    EXPECT_CALL(*m_mockServerCallback, received(_, ReceivedMessage(MESSAGE1_BUFFER)))
+        .Times(2)
+        .WillRepeatedly(Invoke([](const IProtocolSessionPtr& session, const IMessagePtr& message) {
+            session->sendMessage(message, true);
+        })
+    );
+    auto& expectReceivedClient1 = EXPECT_CALL(*m_mockClientCallback, received(_, _)).Times(1);
+
+    ConnectProperties connectProperties;
+    connectProperties.protocolData = VariantStruct{ {"connection_pool", true} };
+    IProtocolSessionPtr session1 = m_sessionContainer->connect("tcp://localhost:3335:httpclient", m_mockClientCallback, connectProperties);
+    const std::int64_t connectionId = session1->getConnectionData().connectionId;
+    EXPECT_NE(connectionId, 0);
+    IMessagePtr message = session1->createMessage();
+    message->addSendPayload(MESSAGE1_BUFFER);
+    session1->sendMessage(message);
+    waitTillDone(expectReceivedClient1, 5000);
+
+    // the first session keeps its idle connection till it is disconnected
+    EXPECT_EQ(session1->getConnectionData().connectionId, connectionId);
+    EXPECT_CALL(*m_mockClientCallback, disconnected(_)).Times(testing::Between(0, 1));
+    session1->disconnect();
+
+    // the idle connection of the first session is taken over by the second session, no new socket is opened
+    auto& expectReceivedClient2 = EXPECT_CALL(*m_mockClientCallback, received(_, _)).Times(1);
+    IProtocolSessionPtr session2 = m_sessionContainer->connect("tcp://localhost:3335:httpclient", m_mockClientCallback, connectProperties);
+    EXPECT_EQ(session2->getConnectionData().connectionId, connectionId);
+    message = session2->createMessage();
+    message->addSendPayload(MESSAGE1_BUFFER);
+    session2->sendMessage(message);
+    waitTillDone(expectReceivedClient2, 5000);
+    waitTillDone(expectConnectedClient, 5000);
+}
+
+TEST_F(TestIntegrationProtocolHttp, testConnectionPoolDifferentProtocolData)
+{
+    int res = m_sessionContainer->bind("tcp://*:3335:httpserver", m_mockServerCallback);
+    EXPECT_EQ(res, 0);
+
+    auto& expectConnectedClient = EXPECT_CALL(*m_mockClientCallback, connected(_)).Times(2);
+    EXPECT_CALL(*m_mockServerCallback, connected(_)).Times(testing::Between(1, 2));
+    EXPECT_CALL(*m_mockServerCallback, received(_, ReceivedMessage(MESSAGE1_BUFFER)))
+        .Times(2)
+        .WillRepeatedly(Invoke([](const IProtocolSessionPtr& session, const IMessagePtr& message) {
+            session->sendMessage(message, true);
+        })
+    );
+    auto& expectReceivedClient1 = EXPECT_CALL(*m_mockClientCallback, received(_, _)).Times(1);
+
+    ConnectProperties connectProperties;
+    connectProperties.protocolData = VariantStruct{ {"connection_pool", true} };
+    IProtocolSessionPtr session1 = m_sessionContainer->connect("tcp://localhost:3335:httpclient", m_mockClientCallback, connectProperties);
+    const std::int64_t connectionId = session1->getConnectionData().connectionId;
+    IMessagePtr message = session1->createMessage();
+    message->addSendPayload(MESSAGE1_BUFFER);
+    session1->sendMessage(message);
+    waitTillDone(expectReceivedClient1, 5000);
+    EXPECT_CALL(*m_mockClientCallback, disconnected(_)).Times(testing::Between(0, 1));
+    session1->disconnect();
+
+    // the pooled connection was created with other protocol data, the second session opens a new socket
+    auto& expectReceivedClient2 = EXPECT_CALL(*m_mockClientCallback, received(_, _)).Times(1);
+    connectProperties.protocolData = VariantStruct{ {"connection_pool", true}, {"max_pipelined_requests", 2} };
+    IProtocolSessionPtr session2 = m_sessionContainer->connect("tcp://localhost:3335:httpclient", m_mockClientCallback, connectProperties);
+    EXPECT_NE(session2->getConnectionData().connectionId, connectionId);
+    message = session2->createMessage();
+    message->addSendPayload(MESSAGE1_BUFFER);
+    session2->sendMessage(message);
+    waitTillDone(expectReceivedClient2, 5000);
+    waitTillDone(expectConnectedClient, 5000);
+}
+
+TEST_F(TestIntegrationProtocolHttp, testIdleTimeout)
+{
+    int res = m_sessionContainer->bind("tcp://*:3335:httpserver", m_mockServerCallback);
+    EXPECT_EQ(res, 0);
+
+    EXPECT_CALL(*m_mockClientCallback, connected(_)).Times(1);
+    EXPECT_CALL(*m_mockServerCallback, connected(_)).Times(testing::Between(1, 2));
+    EXPECT_CALL(*m_mockServerCallback, received(_, ReceivedMessage(MESSAGE1_BUFFER)))
+        .Times(2)
+        .WillRepeatedly(Invoke([](const IProtocolSessionPtr& session, const IMessagePtr& message) {
+            session->sendMessage(message, true);
+        })
+    );
+    auto& expectReceivedClient1 = EXPECT_CALL(*m_mockClientCallback, received(_, _)).Times(1);
+
+    ConnectProperties connectProperties;
+    connectProperties.protocolData = VariantStruct{ {"idle_timeout", 20} };
+    IProtocolSessionPtr connection = m_sessionContainer->connect("tcp://localhost:3335:httpclient", m_mockClientCallback, connectProperties);
+    IMessagePtr message = connection->createMessage();
+    message->addSendPayload(MESSAGE1_BUFFER);
+    connection->sendMessage(message);
+    waitTillDone(expectReceivedClient1, 5000);
+
+    // the idle connection is closed, the session stays and opens a new connection for the next request
+    EXPECT_CALL(*m_mockServerCallback, disconnected(_)).Times(testing::Between(0, 1));
+    std::this_thread::sleep_for(std::chrono::milliseconds(200));
+    EXPECT_EQ(connection->getConnectionData().connectionState, ConnectionState::CONNECTIONSTATE_DISCONNECTED);
+
+    auto& expectReceivedClient2 = EXPECT_CALL(*m_mockClientCallback, received(_, _)).Times(1);
+    connection->sendMessage(message);
+    waitTillDone(expectReceivedClient2, 5000);
+}
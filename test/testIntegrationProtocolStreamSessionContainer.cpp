@@ -29,6 +29,8 @@
 #include "testHelper.h"
 #include "matchers.h"
 
+#include <future>
+#include <set>
 #include <thread>
 //#include <chrono>
 
@@ -324,6 +326,42 @@ TEST_F(TestIntegrationProtocolStreamSessionContainer, testSendLateConnectBind)
 }
 
 
+TEST_F(TestIntegrationProtocolStreamSessionContainer, testSendQueueDropNewest)
+{
+    EXPECT_CALL(*m_mockClientCallback, connected(_)).Times(1);
+    EXPECT_CALL(*m_mockServerCallback, connected(_)).Times(1);
+    EXPECT_CALL(*m_mockServerCallback, received(_, _)).Times(testing::AnyNumber());
+    auto& expectWritable = EXPECT_CALL(*m_mockClientCallback, writable(_)).Times(1);
+
+    ConnectProperties connectProperties;
+    connectProperties.config = {1};
+    connectProperties.sendQueue.highWaterMarkMessages = 2;
+    connectProperties.sendQueue.overflowPolicy = OverflowPolicy::OVERFLOW_DROP_NEWEST;
+    IProtocolSessionPtr connection = m_sessionContainer->connect("tcp://localhost:3333:stream", m_mockClientCallback, connectProperties);
+    ASSERT_NE(connection, nullptr);
+
+    for (int i = 0; i < 5; ++i)
+    {
+        IMessagePtr message = connection->createMessage();
+        message->addSendPayload(MESSAGE1_BUFFER);
+        connection->sendMessage(message);
+    }
+
+    EXPECT_EQ(connection->isWritable(), false);
+    SendQueueStatistics statistics = connection->getSendQueueStatistics();
+    EXPECT_EQ(statistics.pendingMessages, 2);
+    EXPECT_EQ(statistics.droppedMessages, 3);
+
+    int res = m_sessionContainer->bind("tcp://*:3333:stream", m_mockServerCallback);
+    EXPECT_EQ(res, 0);
+
+    waitTillDone(expectWritable, 5000);
+
+    EXPECT_EQ(connection->isWritable(), true);
+    EXPECT_EQ(connection->getSendQueueStatistics().pendingMessages, 0);
+}
+
+
 TEST_F(TestIntegrationProtocolStreamSessionContainer, testCreateConnectionDisconnect)
 {
     EXPECT_CALL(*m_mockClientCallback, disconnected(_)).Times(0);
@@ -418,3 +456,111 @@ TEST_F(TestIntegrationProtocolStreamSessionContainer, testCreateConnectionWithou
 
     EXPECT_EQ(m_sessionContainer->getSession(connection->getSessionId()), nullptr);
 }
+
+
+
+class TestIntegrationProtocolStreamSessionContainerMultiReactor : public TestIntegrationProtocolStreamSessionContainer
+{
+public:
+    void recordThread(const IProtocolSessionPtr& session)
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_threadsOfSession[session->getSessionId()].insert(std::this_thread::get_id());
+    }
+
+    void connectedServer(const IProtocolSessionPtr& session)
+    {
+        recordThread(session);
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_sessionsServer.push_back(session);
+    }
+
+protected:
+    virtual void SetUp() override
+    {
+        m_mockClientCallback = std::make_shared<MockIProtocolSessionCallback>();
+        m_mockServerCallback = std::make_shared<MockIProtocolSessionCallback>();
+        m_sessionContainer = std::make_unique<ProtocolSessionContainer>();
+        m_sessionContainer->init(nullptr, 1, nullptr, 1, NUMBER_OF_REACTORS);
+        IProtocolSessionContainer* sessionContainerRaw = m_sessionContainer.get();
+        m_thread = std::make_unique<std::thread>([sessionContainerRaw] () {
+            sessionContainerRaw->run();
+        });
+    }
+
+    static const int NUMBER_OF_REACTORS = 4;
+    std::mutex m_mutex;
+    std::unordered_map<std::int64_t, std::set<std::thread::id>> m_threadsOfSession;
+    std::vector<IProtocolSessionPtr> m_sessionsServer;
+};
+
+
+TEST_F(TestIntegrationProtocolStreamSessionContainerMultiReactor, testEventsOfSessionInOneThread)
+{
+    static const int NUMBER_OF_SESSIONS = 2 * NUMBER_OF_REACTORS;
+
+    int res = m_sessionContainer->bind("tcp://*:3333:stream", m_mockServerCallback);
+    EXPECT_EQ(res, 0);
+
+    auto& expectConnectedClient = EXPECT_CALL(*m_mockClientCallback, connected(_)).Times(NUMBER_OF_SESSIONS);
+    EXPECT_CALL(*m_mockServerCallback, connected(_)).Times(NUMBER_OF_SESSIONS)
+        .WillRepeatedly(testing::Invoke(this, &TestIntegrationProtocolStreamSessionContainerMultiReactor::connectedServer));
+    auto& expectReceive = EXPECT_CALL(*m_mockServerCallback, received(_, ReceivedMessage(MESSAGE1_BUFFER))).Times(NUMBER_OF_SESSIONS)
+        .WillRepeatedly(testing::Invoke([this](const IProtocolSessionPtr& session, const IMessagePtr& /*message*/) {
+            recordThread(session);
+        }));
+    auto& expectDisconnectedServer = EXPECT_CALL(*m_mockServerCallback, disconnected(_)).Times(NUMBER_OF_SESSIONS)
+        .WillRepeatedly(testing::Invoke(this, &TestIntegrationProtocolStreamSessionContainerMultiReactor::recordThread));
+    // the clients detect the disconnect of the server sessions
+    EXPECT_CALL(*m_mockClientCallback, disconnected(_)).Times(testing::AnyNumber());
+
+    std::vector<IProtocolSessionPtr> sessions;
+    for (int i = 0; i < NUMBER_OF_SESSIONS; ++i)
+    {
+        IProtocolSessionPtr session = m_sessionContainer->connect("tcp://localhost:3333:stream", m_mockClientCallback);
+        IMessagePtr message = session->createMessage();
+        message->addSendPayload(MESSAGE1_BUFFER);
+        session->sendMessage(message);
+        sessions.push_back(session);
+    }
+
+    waitTillDone(expectConnectedClient, 5000);
+    waitTillDone(expectReceive, 5000);
+
+    std::unique_lock<std::mutex> lockServer(m_mutex);
+    std::vector<IProtocolSessionPtr> sessionsServer = m_sessionsServer;
+    lockServer.unlock();
+    ASSERT_EQ(sessionsServer.size(), NUMBER_OF_SESSIONS);
+
+    // actions of the session executor run in the thread of the session's connection
+    std::vector<std::future<void>> executed;
+    for (const auto& session : sessionsServer)
+    {
+        auto promise = std::make_shared<std::promise<void>>();
+        executed.push_back(promise->get_future());
+        session->getExecutor()->addAction([this, session, promise]() {
+            recordThread(session);
+            promise->set_value();
+        });
+    }
+    for (auto& future : executed)
+    {
+        EXPECT_EQ(future.wait_for(std::chrono::milliseconds(5000)), std::future_status::ready);
+    }
+
+    for (const auto& session : sessionsServer)
+    {
+        session->disconnect();
+    }
+    waitTillDone(expectDisconnectedServer, 5000);
+
+    std::unique_lock<std::mutex> lock(m_mutex);
+    std::set<std::thread::id> threadsServer;
+    for (const auto& session : sessionsServer)
+    {
+        const std::set<std::thread::id>& threads = m_threadsOfSession[session->getSessionId()];
+        ASSERT_EQ(threads.size(), 1);
+        threadsServer.insert(*threads.begin());
+    }
+    EXPECT_GT(threadsServer.size(), 1);
+}
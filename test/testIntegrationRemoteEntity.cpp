@@ -57,7 +57,7 @@ public:
 class TestIntegrationRemoteEntity: public testing::Test
 {
 public:
-    void receivedServer(const IStreamConnectionPtr& connection, const SocketPtr& socket, int bytesToRead)
+    void receivedServer(const IStreamConnectionPtr& connection, const char* buffer, int size)
     {
     }
 
@@ -350,4 +350,137 @@ TEST_F(TestIntegrationRemoteEntity, testProtoLateConnect)
 
 
 
+TEST_F(TestIntegrationRemoteEntity, testEventToAllPeersMixedFormats)
+{
+    MockEvents mockEventsServer;
+    MockEvents mockEventsClient;
+    RemoteEntityContainer entityContainerServer;
+    RemoteEntityContainer entityContainerClient;
+    EntityServer entityServer(mockEventsServer);
+    static const int NUMBER_OF_CLIENTS = 4;
+    std::vector<std::unique_ptr<RemoteEntity>> entityClients;
+
+    entityContainerServer.init(nullptr, 1, nullptr, false, 1);
+    entityContainerClient.init(nullptr, 1, nullptr, false, 1);
+
+    std::thread thread1 = std::thread([&entityContainerServer] () {
+        entityContainerServer.run();
+    });
+    std::thread thread2 = std::thread([&entityContainerClient] () {
+        entityContainerClient.run();
+    });
+
+    entityContainerServer.registerEntity(&entityServer, "MyServer");
+    entityContainerServer.bind("tcp://*:7788:headersize:protobuf");
+    entityContainerServer.bind("tcp://*:7789:headersize:json");
+
+    auto& expectConnected = EXPECT_CALL(mockEventsServer, peerEvent(_, _, _, PeerEvent(PeerEvent::PEER_CONNECTED), true)).Times(NUMBER_OF_CLIENTS);
+    EXPECT_CALL(mockEventsServer, peerEvent(_, _, _, PeerEvent(PeerEvent::PEER_DISCONNECTED), true)).Times(testing::AnyNumber());
+    EXPECT_CALL(mockEventsClient, connectReply(_, Status(Status::STATUS_OK))).Times(NUMBER_OF_CLIENTS);
+    auto& expectEvents = EXPECT_CALL(mockEventsClient, testRequest(_, _)).Times(NUMBER_OF_CLIENTS);
+
+    for (int i = 0; i < NUMBER_OF_CLIENTS; ++i)
+    {
+        entityClients.emplace_back(std::make_unique<RemoteEntity>());
+        RemoteEntity& entityClient = *entityClients.back();
+        entityClient.registerCommand<TestRequest>([&mockEventsClient] (const RequestContextPtr& requestContext, const std::shared_ptr<TestRequest>& request) {
+            ASSERT_NE(request, nullptr);
+            ASSERT_EQ(request->datarequest, DATA_REQUEST);
+            mockEventsClient.testRequest(requestContext, request);
+        });
+        entityContainerClient.registerEntity(&entityClient);
+        SessionInfo sessionClient = entityContainerClient.connect((i % 2 == 0) ? "tcp://localhost:7788:headersize:protobuf" : "tcp://localhost:7789:headersize:json");
+        entityClient.connect(sessionClient, "MyServer", [&mockEventsClient] (PeerId peerId, Status status) {
+            mockEventsClient.connectReply(peerId, status);
+        });
+    }
+
+    waitTillDone(expectConnected, 15000);
+    entityServer.sendEventToAllPeers(TestRequest{DATA_REQUEST});
+
+    waitTillDone(expectEvents, 15000);
+    entityContainerServer.terminatePollerLoop();
+    entityContainerClient.terminatePollerLoop();
+    thread1.join();
+    thread2.join();
+}
+
+
+
+class EntityServerArena : public RemoteEntity
+{
+public:
+    EntityServerArena(MockEvents& mockEvents)
+        : m_mockEvents(mockEvents)
+    {
+        registerCommand<TestPmr>([this] (const RequestContextPtr& requestContext, const std::shared_ptr<TestPmr>& request) {
+            assert(request);
+            m_mockEvents.testRequest(requestContext, nullptr);
+            // the request is decoded into the arena of the request context
+            ASSERT_NE(requestContext->arena(), nullptr);
+            ASSERT_EQ(request->value_string.get_allocator().resource(), requestContext->arena());
+            ASSERT_EQ(request->array_struct.size(), 1u);
+            ASSERT_EQ(request->array_struct[0].name.get_allocator().resource(), requestContext->arena());
+            requestContext->reply(TestReply(std::string(request->value_string) + std::string(request->array_struct[0].name)));
+        });
+    }
+
+    MockEvents& m_mockEvents;
+};
+
+TEST_F(TestIntegrationRemoteEntity, testDecodeIntoArena)
+{
+    MockEvents mockEventsServer;
+    MockEvents mockEventsClient;
+    RemoteEntityContainer entityContainerServer;
+    RemoteEntityContainer entityContainerClient;
+    EntityServerArena entityServer(mockEventsServer);
+    RemoteEntity entityClient;
+
+    entityContainerServer.init(nullptr, 1, nullptr, false, 1, 1, true);
+    entityContainerClient.init(nullptr, 1, nullptr, false, 1);
+
+    std::thread thread1 = std::thread([&entityContainerServer] () {
+        entityContainerServer.run();
+    });
+    std::thread thread2 = std::thread([&entityContainerClient] () {
+        entityContainerClient.run();
+    });
+
+    entityContainerServer.registerEntity(&entityServer, "MyServer");
+    entityContainerClient.registerEntity(&entityClient);
+
+    entityContainerServer.bind("tcp://*:7788:headersize:protobuf");
+    SessionInfo sessionClient = entityContainerClient.connect("tcp://localhost:7788:headersize:protobuf");
+
+    PeerId peerId = entityClient.connect(sessionClient, "MyServer");
+
+    TestPmr request;
+    request.value_string = "a request string that does not fit into the small buffer, ";
+    request.array_struct.resize(1);
+    request.array_struct[0].name = "and a string inside of a struct array";
+
+    static const int LOOP = 10;
+    EXPECT_CALL(mockEventsServer, testRequest(_, _)).Times(LOOP);
+    auto& expectReply = EXPECT_CALL(mockEventsClient, testReply(peerId, _, _)).Times(LOOP);
+    for (int i = 0; i < LOOP; ++i)
+    {
+        entityClient.requestReply<TestReply>(peerId, request, [&mockEventsClient] (PeerId peerId, Status status, const std::shared_ptr<TestReply>& reply) {
+            ASSERT_EQ(status, Status::STATUS_OK);
+            ASSERT_NE(reply, nullptr);
+            ASSERT_EQ(reply->datareply, "a request string that does not fit into the small buffer, and a string inside of a struct array");
+            mockEventsClient.testReply(peerId, status, reply);
+        });
+    }
+
+    waitTillDone(expectReply, 15000);
+    entityContainerServer.terminatePollerLoop();
+    entityContainerClient.terminatePollerLoop();
+    thread1.join();
+    thread2.join();
+}
+
+
+
+
 #endif
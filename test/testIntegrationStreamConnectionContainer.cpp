@@ -28,8 +28,14 @@
 #include "finalmq/helpers/OperatingSystem.h"
 #include "finalmq/protocols/ProtocolStream.h"
 #include "finalmq/protocolsession/ProtocolMessage.h"
+#include "finalmq/streamconnection/FileRegion.h"
 #include "testHelper.h"
 
+#include <fcntl.h>
+
+#include <fstream>
+#include <future>
+#include <set>
 #include <thread>
 //#include <chrono>
 
@@ -48,11 +54,9 @@ static const std::string MESSAGE1_BUFFER = "Hello";
 class TestIntegrationStreamConnectionContainer: public testing::Test
 {
 public:
-    bool receivedServer(const IStreamConnectionPtr& connection, const SocketPtr& socket, int bytesToRead)
+    bool receivedServer(const IStreamConnectionPtr& connection, const char* buffer, int size)
     {
-        std::string message;
-        message.resize(bytesToRead);
-        socket->receive((char*)message.data(), static_cast<int>(message.size()));
+        std::string message(buffer, size);
         m_messagesServer.push_back(std::move(message));
         return true;
     }
@@ -339,6 +343,95 @@ TEST_F(TestIntegrationStreamConnectionContainer, testSendLateConnectBind)
     EXPECT_EQ(m_messagesServer[0], MESSAGE1_BUFFER);
 }
 
+TEST_F(TestIntegrationStreamConnectionContainer, testSendQueueDropOldest)
+{
+    EXPECT_CALL(*m_mockBindCallback, connected(_)).Times(1)
+                                            .WillOnce(Return(m_mockServerCallback));
+    EXPECT_CALL(*m_mockClientCallback, connected(_)).Times(1)
+                                            .WillOnce(Return(nullptr));
+    EXPECT_CALL(*m_mockServerCallback, connected(_)).Times(1);
+    EXPECT_CALL(*m_mockServerCallback, received(_, _, _))
+                                            .WillRepeatedly(Invoke(this, &TestIntegrationStreamConnectionContainer::receivedServer));
+    auto& expectWritable = EXPECT_CALL(*m_mockClientCallback, writable(_)).Times(1);
+
+    ConnectProperties connectProperties;
+    connectProperties.config = {1};
+    connectProperties.sendQueue.highWaterMarkMessages = 2;
+    connectProperties.sendQueue.lowWaterMarkMessages = 0;
+    connectProperties.sendQueue.overflowPolicy = OverflowPolicy::OVERFLOW_DROP_OLDEST;
+    IStreamConnectionPtr connection = m_connectionContainer->connect("tcp://localhost:3333", m_mockClientCallback, connectProperties);
+    ASSERT_NE(connection, nullptr);
+    EXPECT_EQ(connection->isWritable(), true);
+
+    for (int i = 1; i <= 5; ++i)
+    {
+        IMessagePtr message = std::make_shared<ProtocolMessage>(0);
+        message->addSendPayload(std::to_string(i));
+        connection->sendMessage(message);
+    }
+
+    SendQueueStatistics statistics = connection->getSendQueueStatistics();
+    EXPECT_EQ(connection->isWritable(), false);
+    EXPECT_EQ(statistics.pendingMessages, 2);
+    EXPECT_EQ(statistics.pendingBytes, 2);
+    EXPECT_EQ(statistics.peakMessages, 2);
+    EXPECT_EQ(statistics.droppedMessages, 3);
+    EXPECT_EQ(statistics.highWaterMarkReached, 1);
+
+    int res = m_connectionContainer->bind("tcp://*:3333", m_mockBindCallback);
+    EXPECT_EQ(res, 0);
+
+    waitTillDone(expectWritable, 5000);
+    for (int i = 0; i < 500; ++i)
+    {
+        std::string received;
+        for (const auto& message : m_messagesServer)
+        {
+            received += message;
+        }
+        if (received.size() >= 2)
+        {
+            break;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+
+    std::string received;
+    for (const auto& message : m_messagesServer)
+    {
+        received += message;
+    }
+    EXPECT_EQ(received, "45");
+    EXPECT_EQ(connection->isWritable(), true);
+    statistics = connection->getSendQueueStatistics();
+    EXPECT_EQ(statistics.pendingMessages, 0);
+    EXPECT_EQ(statistics.pendingBytes, 0);
+}
+
+TEST_F(TestIntegrationStreamConnectionContainer, testSendQueueDisconnect)
+{
+    auto& expectDisconnectedClient = EXPECT_CALL(*m_mockClientCallback, disconnected(_)).Times(1);
+
+    ConnectProperties connectProperties;
+    connectProperties.config = {1};
+    connectProperties.sendQueue.highWaterMarkMessages = 1;
+    connectProperties.sendQueue.overflowPolicy = OverflowPolicy::OVERFLOW_DISCONNECT;
+    IStreamConnectionPtr connection = m_connectionContainer->connect("tcp://localhost:3333", m_mockClientCallback, connectProperties);
+    ASSERT_NE(connection, nullptr);
+
+    for (int i = 0; i < 2; ++i)
+    {
+        IMessagePtr message = std::make_shared<ProtocolMessage>(0);
+        message->addSendPayload(MESSAGE1_BUFFER);
+        connection->sendMessage(message);
+    }
+
+    waitTillDone(expectDisconnectedClient, 5000);
+
+    EXPECT_EQ(connection->getConnectionData().connectionState, ConnectionState::CONNECTIONSTATE_DISCONNECTED);
+    EXPECT_EQ(connection->getSendQueueStatistics().droppedMessages, 1);
+}
+
 TEST_F(TestIntegrationStreamConnectionContainer, testCreateConnectionDisconnect)
 {
     auto& expectDisconnectedClient = EXPECT_CALL(*m_mockClientCallback, disconnected(_)).Times(1);
@@ -356,3 +449,350 @@ TEST_F(TestIntegrationStreamConnectionContainer, testCreateConnectionDisconnect)
     EXPECT_EQ(connection->getConnectionData().connectionState, ConnectionState::CONNECTIONSTATE_DISCONNECTED);
     EXPECT_EQ(m_connectionContainer->getConnection(connection->getConnectionData().connectionId), nullptr);
 }
+
+
+TEST_F(TestIntegrationStreamConnectionContainer, testSendMultiBufferMessages)
+{
+    static const int NUMBER_OF_MESSAGES = 20;
+    static const int NUMBER_OF_BUFFERS = 7;
+    static const int BUFFER_SIZE = 100000;  // large enough to get partial writes
+
+    int res = m_connectionContainer->bind("tcp://*:3333", m_mockBindCallback);
+    EXPECT_EQ(res, 0);
+
+    std::string received;
+    std::mutex mutexReceived;
+    EXPECT_CALL(*m_mockBindCallback, connected(_)).Times(1)
+                                            .WillOnce(Return(m_mockServerCallback));
+    EXPECT_CALL(*m_mockClientCallback, connected(_)).Times(1)
+                                            .WillOnce(Return(nullptr));
+    EXPECT_CALL(*m_mockServerCallback, connected(_)).Times(1);
+    EXPECT_CALL(*m_mockServerCallback, received(_, _, _))
+        .WillRepeatedly(testing::Invoke([&received, &mutexReceived](const IStreamConnectionPtr& /*connection*/, const char* buffer, int size) {
+            std::unique_lock<std::mutex> lock(mutexReceived);
+            received.append(buffer, size);
+            return true;
+        }));
+
+    IStreamConnectionPtr connection = m_connectionContainer->connect("tcp://localhost:3333", m_mockClientCallback);
+
+    std::string expected;
+    for (int i = 0; i < NUMBER_OF_MESSAGES; ++i)
+    {
+        IMessagePtr message = std::make_shared<ProtocolMessage>(0);
+        for (int j = 0; j < NUMBER_OF_BUFFERS; ++j)
+        {
+            std::string payload(BUFFER_SIZE, static_cast<char>('a' + (i + j) % 26));
+            message->addSendPayload(payload);
+            expected += payload;
+        }
+        connection->sendMessage(message);
+    }
+
+    for (int i = 0; i < 1000; ++i)
+    {
+        std::unique_lock<std::mutex> lock(mutexReceived);
+        if (received.size() >= expected.size())
+        {
+            break;
+        }
+        lock.unlock();
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+
+    std::unique_lock<std::mutex> lock(mutexReceived);
+    EXPECT_EQ(received.size(), expected.size());
+    EXPECT_TRUE(received == expected);
+}
+
+
+
+TEST_F(TestIntegrationStreamConnectionContainer, testSendQueueBlock)
+{
+    static const int NUMBER_OF_MESSAGES = 50;
+    static const int BUFFER_SIZE = 100000;
+    static const ssize_t HIGH_WATER_MARK = 3 * BUFFER_SIZE;
+
+    int res = m_connectionContainer->bind("tcp://*:3333", m_mockBindCallback);
+    EXPECT_EQ(res, 0);
+
+    std::string received;
+    std::mutex mutexReceived;
+    EXPECT_CALL(*m_mockBindCallback, connected(_)).Times(1)
+                                            .WillOnce(Return(m_mockServerCallback));
+    EXPECT_CALL(*m_mockClientCallback, connected(_)).Times(1)
+                                            .WillOnce(Return(nullptr));
+    EXPECT_CALL(*m_mockServerCallback, connected(_)).Times(1);
+    EXPECT_CALL(*m_mockClientCallback, writable(_)).Times(testing::AnyNumber());
+    EXPECT_CALL(*m_mockServerCallback, received(_, _, _))
+        .WillRepeatedly(testing::Invoke([&received, &mutexReceived](const IStreamConnectionPtr& /*connection*/, const char* buffer, int size) {
+            std::unique_lock<std::mutex> lock(mutexReceived);
+            received.append(buffer, size);
+            return true;
+        }));
+
+    ConnectProperties connectProperties;
+    connectProperties.sendQueue.highWaterMarkBytes = HIGH_WATER_MARK;
+    connectProperties.sendQueue.overflowPolicy = OverflowPolicy::OVERFLOW_BLOCK;
+    IStreamConnectionPtr connection = m_connectionContainer->connect("tcp://localhost:3333", m_mockClientCallback, connectProperties);
+    ASSERT_NE(connection, nullptr);
+
+    std::string expected;
+    for (int i = 0; i < NUMBER_OF_MESSAGES; ++i)
+    {
+        IMessagePtr message = std::make_shared<ProtocolMessage>(0);
+        std::string payload(BUFFER_SIZE, static_cast<char>('a' + i % 26));
+        message->addSendPayload(payload);
+        expected += payload;
+        connection->sendMessage(message);
+        // the producer is paced, the queue never grows far beyond the high water mark
+        EXPECT_LE(connection->getSendQueueStatistics().pendingBytes, HIGH_WATER_MARK + BUFFER_SIZE);
+    }
+
+    for (int i = 0; i < 1000; ++i)
+    {
+        std::unique_lock<std::mutex> lock(mutexReceived);
+        if (received.size() >= expected.size())
+        {
+            break;
+        }
+        lock.unlock();
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+
+    std::unique_lock<std::mutex> lock(mutexReceived);
+    EXPECT_EQ(received.size(), expected.size());
+    EXPECT_TRUE(received == expected);
+    SendQueueStatistics statistics = connection->getSendQueueStatistics();
+    EXPECT_LE(statistics.peakBytes, HIGH_WATER_MARK + BUFFER_SIZE);
+    EXPECT_EQ(statistics.droppedMessages, 0);
+}
+
+
+
+TEST_F(TestIntegrationStreamConnectionContainer, testSendFileRegions)
+{
+    static const int NUMBER_OF_MESSAGES = 5;
+    static const int FILE_SIZE = 3000000;  // large enough to get partial writes
+    static const char* FILENAME = "sendfiletest.bin";
+
+    std::string content;
+    content.reserve(FILE_SIZE);
+    for (int i = 0; i < FILE_SIZE; ++i)
+    {
+        content += static_cast<char>('a' + (i * 7) % 26);
+    }
+    {
+        std::ofstream file(FILENAME, std::ios::binary);
+        file.write(content.data(), content.size());
+    }
+
+    int res = m_connectionContainer->bind("tcp://*:3333", m_mockBindCallback);
+    EXPECT_EQ(res, 0);
+
+    std::string received;
+    std::mutex mutexReceived;
+    EXPECT_CALL(*m_mockBindCallback, connected(_)).Times(1)
+                                            .WillOnce(Return(m_mockServerCallback));
+    EXPECT_CALL(*m_mockClientCallback, connected(_)).Times(1)
+                                            .WillOnce(Return(nullptr));
+    EXPECT_CALL(*m_mockServerCallback, connected(_)).Times(1);
+    EXPECT_CALL(*m_mockServerCallback, received(_, _, _))
+        .WillRepeatedly(testing::Invoke([&received, &mutexReceived](const IStreamConnectionPtr& /*connection*/, const char* buffer, int size) {
+            std::unique_lock<std::mutex> lock(mutexReceived);
+            received.append(buffer, size);
+            return true;
+        }));
+
+    IStreamConnectionPtr connection = m_connectionContainer->connect("tcp://localhost:3333", m_mockClientCallback);
+
+    // the file regions are sent behind the buffers of their message and before the next message
+    std::string expected;
+    for (int i = 0; i < NUMBER_OF_MESSAGES; ++i)
+    {
+        IMessagePtr message = std::make_shared<ProtocolMessage>(0);
+        std::string header = "header" + std::to_string(i);
+        message->addSendPayload(header);
+        expected += header;
+        if (i % 2 == 0)
+        {
+            FileRegionPtr file = FileRegion::open(FILENAME);
+            ASSERT_NE(file, nullptr);
+            ASSERT_EQ(file->getSize(), FILE_SIZE);
+            message->setSendFile(file);
+            expected += content;
+        }
+        else
+        {
+            int fd = OperatingSystem::instance().open(FILENAME, O_RDONLY);
+            ASSERT_NE(fd, -1);
+            message->setSendFile(std::make_shared<FileRegion>(fd, 1000 * i, 100000 * i));
+            expected += content.substr(1000 * i, 100000 * i);
+        }
+        connection->sendMessage(message);
+    }
+    IMessagePtr message = std::make_shared<ProtocolMessage>(0);
+    message->addSendPayload(MESSAGE1_BUFFER);
+    connection->sendMessage(message);
+    expected += MESSAGE1_BUFFER;
+
+    for (int i = 0; i < 1000; ++i)
+    {
+        std::unique_lock<std::mutex> lock(mutexReceived);
+        if (received.size() >= expected.size())
+        {
+            break;
+        }
+        lock.unlock();
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+
+    std::unique_lock<std::mutex> lock(mutexReceived);
+    EXPECT_EQ(received.size(), expected.size());
+    EXPECT_TRUE(received == expected);
+    lock.unlock();
+
+    OperatingSystem::instance().unlink(FILENAME);
+}
+
+
+
+class TestIntegrationStreamConnectionContainerMultiReactor : public TestIntegrationStreamConnectionContainer
+{
+public:
+    bool receivedServerLocked(const IStreamConnectionPtr& connection, const char* buffer, int size)
+    {
+        // the server connections are distributed over the reactor threads
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_threadsOfConnection[connection->getConnectionId()].insert(std::this_thread::get_id());
+        return receivedServer(connection, buffer, size);
+    }
+
+    void recordThread(const IStreamConnectionPtr& connection)
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_threadsOfConnection[connection->getConnectionId()].insert(std::this_thread::get_id());
+    }
+
+    void connectedServer(const IStreamConnectionPtr& connection)
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_threadsOfConnection[connection->getConnectionId()].insert(std::this_thread::get_id());
+        m_connectionsServer.push_back(connection);
+    }
+
+protected:
+    virtual void SetUp() override
+    {
+        m_mockBindCallback = std::make_shared<MockIStreamConnectionCallback>();
+        m_mockClientCallback = std::make_shared<MockIStreamConnectionCallback>();
+        m_mockServerCallback = std::make_shared<MockIStreamConnectionCallback>();
+        m_connectionContainer = std::make_unique<StreamConnectionContainer>();
+        m_connectionContainer->init(1, nullptr, 1, NUMBER_OF_REACTORS);
+        IStreamConnectionContainer* connectionContainerRaw = m_connectionContainer.get();
+        m_thread = std::make_unique<std::thread>([connectionContainerRaw] () {
+            connectionContainerRaw->run();
+        });
+    }
+
+    static const int NUMBER_OF_REACTORS = 4;
+    std::mutex m_mutex;
+    std::unordered_map<std::int64_t, std::set<std::thread::id>> m_threadsOfConnection;
+    std::vector<IStreamConnectionPtr> m_connectionsServer;
+};
+
+
+TEST_F(TestIntegrationStreamConnectionContainerMultiReactor, testBindConnectSendDisconnect)
+{
+    static const int NUMBER_OF_CONNECTIONS = 2 * NUMBER_OF_REACTORS;
+
+    int res = m_connectionContainer->bind("tcp://*:3333", m_mockBindCallback);
+    EXPECT_EQ(res, 0);
+
+    EXPECT_CALL(*m_mockBindCallback, connected(_)).Times(NUMBER_OF_CONNECTIONS)
+                                            .WillRepeatedly(Return(m_mockServerCallback));
+    EXPECT_CALL(*m_mockClientCallback, connected(_)).Times(NUMBER_OF_CONNECTIONS)
+                                            .WillRepeatedly(DoAll(Invoke(this, &TestIntegrationStreamConnectionContainerMultiReactor::recordThread), Return(nullptr)));
+    EXPECT_CALL(*m_mockServerCallback, connected(_)).Times(NUMBER_OF_CONNECTIONS)
+                                            .WillRepeatedly(DoAll(Invoke(this, &TestIntegrationStreamConnectionContainerMultiReactor::connectedServer), Return(nullptr)));
+    auto& expectReceive = EXPECT_CALL(*m_mockServerCallback, received(_, _, _)).Times(NUMBER_OF_CONNECTIONS)
+                                                   .WillRepeatedly(Invoke(this, &TestIntegrationStreamConnectionContainerMultiReactor::receivedServerLocked));
+    auto& expectDisconnectedClient = EXPECT_CALL(*m_mockClientCallback, disconnected(_)).Times(NUMBER_OF_CONNECTIONS)
+                                            .WillRepeatedly(Invoke(this, &TestIntegrationStreamConnectionContainerMultiReactor::recordThread));
+    auto& expectDisconnectedServer = EXPECT_CALL(*m_mockServerCallback, disconnected(_)).Times(NUMBER_OF_CONNECTIONS)
+                                            .WillRepeatedly(Invoke(this, &TestIntegrationStreamConnectionContainerMultiReactor::recordThread));
+
+    std::vector<IStreamConnectionPtr> connections;
+    for (int i = 0; i < NUMBER_OF_CONNECTIONS; ++i)
+    {
+        IStreamConnectionPtr connection = m_connectionContainer->connect("tcp://localhost:3333", m_mockClientCallback);
+        ASSERT_NE(connection, nullptr);
+        IMessagePtr message = std::make_shared<ProtocolMessage>(0);
+        message->addSendPayload(MESSAGE1_BUFFER);
+        connection->sendMessage(message);
+        connections.push_back(connection);
+    }
+
+    waitTillDone(expectReceive, 5000);
+
+    EXPECT_EQ(m_connectionContainer->getAllConnections().size(), 2 * NUMBER_OF_CONNECTIONS);
+
+    // the executor of a connection runs its actions in the thread that triggers the events of the connection
+    std::vector<IStreamConnectionPtr> connectionsServer;
+    std::unique_lock<std::mutex> lockServer(m_mutex);
+    connectionsServer = m_connectionsServer;
+    lockServer.unlock();
+    ASSERT_EQ(connectionsServer.size(), NUMBER_OF_CONNECTIONS);
+    std::vector<std::future<void>> executed;
+    for (const auto& connection : connectionsServer)
+    {
+        IExecutorPtr executor = connection->getExecutor();
+        ASSERT_NE(executor, nullptr);
+        auto promise = std::make_shared<std::promise<void>>();
+        executed.push_back(promise->get_future());
+        executor->addAction([this, connection, promise]() {
+            recordThread(connection);
+            promise->set_value();
+        });
+    }
+    for (auto& future : executed)
+    {
+        EXPECT_EQ(future.wait_for(std::chrono::milliseconds(5000)), std::future_status::ready);
+    }
+
+    for (const auto& connection : connections)
+    {
+        connection->disconnect();
+    }
+
+    waitTillDone(expectDisconnectedClient, 5000);
+    waitTillDone(expectDisconnectedServer, 5000);
+
+    for (const auto& connection : connections)
+    {
+        EXPECT_EQ(connection->getConnectionData().connectionState, ConnectionState::CONNECTIONSTATE_DISCONNECTED);
+    }
+    EXPECT_EQ(m_connectionContainer->getAllConnections().size(), 0);
+
+    std::unique_lock<std::mutex> lock(m_mutex);
+    ASSERT_EQ(m_messagesServer.size(), NUMBER_OF_CONNECTIONS);
+    for (const auto& message : m_messagesServer)
+    {
+        EXPECT_EQ(message, MESSAGE1_BUFFER);
+    }
+
+    // the connections landed on more than one reactor, but all events of one connection came from one thread
+    EXPECT_EQ(m_threadsOfConnection.size(), 2 * NUMBER_OF_CONNECTIONS);
+    std::set<std::thread::id> threadsServer;
+    for (const auto& connection : connectionsServer)
+    {
+        const std::set<std::thread::id>& threads = m_threadsOfConnection[connection->getConnectionId()];
+        ASSERT_EQ(threads.size(), 1);
+        threadsServer.insert(*threads.begin());
+    }
+    EXPECT_GT(threadsServer.size(), 1);
+    for (const auto& entry : m_threadsOfConnection)
+    {
+        EXPECT_EQ(entry.second.size(), 1);
+    }
+}
@@ -30,8 +30,12 @@
 #include "finalmq/helpers/OperatingSystem.h"
 #include "finalmq/protocols/ProtocolStream.h"
 #include "finalmq/protocolsession/ProtocolMessage.h"
+#include "finalmq/streamconnection/FileRegion.h"
 #include "testHelper.h"
 
+#include <fcntl.h>
+
+#include <fstream>
 #include <thread>
 //#include <chrono>
 
@@ -50,11 +54,9 @@ static const std::string MESSAGE1_BUFFER = "Hello";
 class TestIntegrationStreamConnectionContainerSsl: public testing::Test
 {
 public:
-    bool receivedServer(const IStreamConnectionPtr& connection, const SocketPtr& socket, int bytesToRead)
+    bool receivedServer(const IStreamConnectionPtr& connection, const char* buffer, int size)
     {
-        std::string message;
-        message.resize(bytesToRead);
-        socket->receive(const_cast<char*>(message.data()), static_cast<int>(message.size()));
+        std::string message(buffer, size);
         m_messagesServer.push_back(std::move(message));
         return true;
     }
@@ -348,4 +350,93 @@ TEST_F(TestIntegrationStreamConnectionContainerSsl, testSendLateConnectBind)
 }
 
 
+
+TEST_F(TestIntegrationStreamConnectionContainerSsl, testSendFileRegions)
+{
+    static const int NUMBER_OF_MESSAGES = 5;
+    static const int FILE_SIZE = 3000000;  // large enough to get partial writes
+    static const char* FILENAME = "sendfiletestssl.bin";
+
+    std::string content;
+    content.reserve(FILE_SIZE);
+    for (int i = 0; i < FILE_SIZE; ++i)
+    {
+        content += static_cast<char>('a' + (i * 7) % 26);
+    }
+    {
+        std::ofstream file(FILENAME, std::ios::binary);
+        file.write(content.data(), content.size());
+    }
+
+    int res = m_connectionContainer->bind("tcp://*:3333", m_mockBindCallback, {{true, SSL_VERIFY_NONE, "ssltest.cert.pem", "ssltest.key.pem"}});
+    EXPECT_EQ(res, 0);
+
+    std::string received;
+    std::mutex mutexReceived;
+    EXPECT_CALL(*m_mockBindCallback, connected(_)).Times(1)
+                                            .WillOnce(Return(m_mockServerCallback));
+    EXPECT_CALL(*m_mockClientCallback, connected(_)).Times(1)
+                                            .WillOnce(Return(nullptr));
+    EXPECT_CALL(*m_mockServerCallback, connected(_)).Times(1);
+    EXPECT_CALL(*m_mockServerCallback, received(_, _, _))
+        .WillRepeatedly(testing::Invoke([&received, &mutexReceived](const IStreamConnectionPtr& /*connection*/, const char* buffer, int size) {
+            std::unique_lock<std::mutex> lock(mutexReceived);
+            received.append(buffer, size);
+            return true;
+        }));
+
+    IStreamConnectionPtr connection = m_connectionContainer->connect("tcp://localhost:3333", m_mockClientCallback, {{true, SSL_VERIFY_NONE}});
+
+    // the file regions are sent behind the buffers of their message and before the next message
+    std::string expected;
+    for (int i = 0; i < NUMBER_OF_MESSAGES; ++i)
+    {
+        IMessagePtr message = std::make_shared<ProtocolMessage>(0);
+        std::string header = "header" + std::to_string(i);
+        message->addSendPayload(header);
+        expected += header;
+        if (i % 2 == 0)
+        {
+            FileRegionPtr file = FileRegion::open(FILENAME);
+            ASSERT_NE(file, nullptr);
+            ASSERT_EQ(file->getSize(), FILE_SIZE);
+            message->setSendFile(file);
+            expected += content;
+        }
+        else
+        {
+            int fd = OperatingSystem::instance().open(FILENAME, O_RDONLY);
+            ASSERT_NE(fd, -1);
+            message->setSendFile(std::make_shared<FileRegion>(fd, 1000 * i, 100000 * i));
+            expected += content.substr(1000 * i, 100000 * i);
+        }
+        connection->sendMessage(message);
+    }
+    IMessagePtr message = std::make_shared<ProtocolMessage>(0);
+    message->addSendPayload(MESSAGE1_BUFFER);
+    connection->sendMessage(message);
+    expected += MESSAGE1_BUFFER;
+
+    for (int i = 0; i < 1000; ++i)
+    {
+        std::unique_lock<std::mutex> lock(mutexReceived);
+        if (received.size() >= expected.size())
+        {
+            break;
+        }
+        lock.unlock();
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+
+    std::unique_lock<std::mutex> lock(mutexReceived);
+    EXPECT_EQ(received.size(), expected.size());
+    EXPECT_TRUE(received == expected);
+    lock.unlock();
+
+    OperatingSystem::instance().unlink(FILENAME);
+}
+
+
+
+
 #endif
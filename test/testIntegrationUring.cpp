@@ -0,0 +1,646 @@
+//MIT License
+
+//Copyright (c) 2020 bexoft GmbH (mail@bexoft.de)
+
+//Permission is hereby granted, free of charge, to any person obtaining a copy
+//of this software and associated documentation files (the "Software"), to deal
+//in the Software without restriction, including without limitation the rights
+//to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//copies of the Software, and to permit persons to whom the Software is
+//furnished to do so, subject to the following conditions:
+
+//The above copyright notice and this permission notice shall be included in all
+//copies or substantial portions of the Software.
+
+//THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//SOFTWARE.
+
+#include "finalmq/poller/PollerImplUring.h"
+
+#ifdef FINALMQ_HAS_URING
+
+#include "gtest/gtest.h"
+#include "gmock/gmock.h"
+
+
+#include "finalmq/helpers/OperatingSystem.h"
+#include "finalmq/poller/PollerFactory.h"
+#include "finalmq/protocolsession/ProtocolMessage.h"
+#include "finalmq/streamconnection/StreamConnectionContainer.h"
+#include "MockIStreamConnectionCallback.h"
+#include "testHelper.h"
+
+#include <atomic>
+#include <thread>
+#include <chrono>
+
+using ::testing::_;
+using ::testing::DoAll;
+using ::testing::Return;
+
+using namespace std::chrono_literals;
+using namespace finalmq;
+
+static const std::string BUFFER = "Hello";
+
+
+typedef PollerImplUring Poller;
+
+
+TEST(TestIntegrationUring, testTimeout)
+{
+    if (!Poller::isAvailable())
+    {
+        GTEST_SKIP();
+    }
+    std::unique_ptr<IPoller> poller = std::make_unique<Poller>();
+    poller->init();
+    const PollerResult& result = poller->wait(0);
+    EXPECT_EQ(result.error, false);
+    EXPECT_EQ(result.timeout, true);
+    EXPECT_EQ(result.descriptorInfos.size(), 0);
+}
+
+
+
+
+TEST(TestIntegrationUring, testAddSocketReadableBeforeWait)
+{
+    if (!Poller::isAvailable())
+    {
+        GTEST_SKIP();
+    }
+    std::unique_ptr<IPoller> poller = std::make_unique<Poller>();
+    poller->init();
+
+    SocketDescriptorPtr controlSocketInside;
+    SocketDescriptorPtr controlSocketOutside;
+
+    int res = OperatingSystem::instance().makeSocketPair(controlSocketInside, controlSocketOutside);
+    EXPECT_EQ(res, 0);
+    EXPECT_NE(controlSocketInside, nullptr);
+    EXPECT_NE(controlSocketOutside, nullptr);
+
+    poller->addSocket(controlSocketInside);
+    poller->enableRead(controlSocketInside);
+    OperatingSystem::instance().send(controlSocketOutside->getDescriptor(), BUFFER.c_str(), BUFFER.size(), 0);
+
+    const PollerResult& result = poller->wait(10);
+    EXPECT_EQ(result.error, false);
+    EXPECT_EQ(result.timeout, false);
+    EXPECT_EQ(result.descriptorInfos.size(), 1);
+    EXPECT_EQ(result.descriptorInfos[0].sd, controlSocketInside->getDescriptor());
+    EXPECT_EQ(result.descriptorInfos[0].readable, true);
+    EXPECT_EQ(result.descriptorInfos[0].writable, false);
+}
+
+
+TEST(TestIntegrationUring, testAddSocketReadableInsideWait)
+{
+    if (!Poller::isAvailable())
+    {
+        GTEST_SKIP();
+    }
+    std::shared_ptr<IPoller> poller = std::make_shared<Poller>();
+    poller->init();
+
+    SocketDescriptorPtr controlSocketInside;
+    SocketDescriptorPtr controlSocketOutside;
+
+    int res = OperatingSystem::instance().makeSocketPair(controlSocketInside, controlSocketOutside);
+    EXPECT_EQ(res, 0);
+    EXPECT_NE(controlSocketInside, nullptr);
+    EXPECT_NE(controlSocketOutside, nullptr);
+
+    std::thread thread([poller, controlSocketInside, controlSocketOutside] () {
+        std::this_thread::sleep_for(10ms);
+        poller->addSocket(controlSocketInside);
+        poller->enableRead(controlSocketInside);
+        OperatingSystem::instance().send(controlSocketOutside->getDescriptor(), BUFFER.c_str(), BUFFER.size(), 0);
+    });
+
+    const PollerResult& result = poller->wait(1000000);
+    EXPECT_EQ(result.error, false);
+    EXPECT_EQ(result.timeout, false);
+    EXPECT_EQ(result.descriptorInfos.size(), 1);
+    EXPECT_EQ(result.descriptorInfos[0].sd, controlSocketInside->getDescriptor());
+    EXPECT_EQ(result.descriptorInfos[0].readable, true);
+    EXPECT_EQ(result.descriptorInfos[0].writable, false);
+
+    thread.join();
+}
+
+
+TEST(TestIntegrationUring, testEnableWriteSocketBeforeWait)
+{
+    if (!Poller::isAvailable())
+    {
+        GTEST_SKIP();
+    }
+    std::unique_ptr<IPoller> poller = std::make_unique<Poller>();
+    poller->init();
+
+    SocketDescriptorPtr controlSocketInside;
+    SocketDescriptorPtr controlSocketOutside;
+
+    int res = OperatingSystem::instance().makeSocketPair(controlSocketInside, controlSocketOutside);
+    EXPECT_EQ(res, 0);
+    EXPECT_NE(controlSocketInside, nullptr);
+    EXPECT_NE(controlSocketOutside, nullptr);
+
+    poller->addSocket(controlSocketInside);
+    poller->enableRead(controlSocketInside);
+    const PollerResult& result1 = poller->wait(0);
+    EXPECT_EQ(result1.error, false);
+    EXPECT_EQ(result1.timeout, true);
+    EXPECT_EQ(result1.descriptorInfos.size(), 0);
+
+    poller->enableWrite(controlSocketInside);
+    const PollerResult& result2 = poller->wait(0);
+    EXPECT_EQ(result2.error, false);
+    EXPECT_EQ(result2.timeout, false);
+    EXPECT_EQ(result2.descriptorInfos.size(), 1);
+    EXPECT_EQ(result2.descriptorInfos[0].sd, controlSocketInside->getDescriptor());
+    EXPECT_EQ(result2.descriptorInfos[0].readable, false);
+    EXPECT_EQ(result2.descriptorInfos[0].writable, true);
+}
+
+
+TEST(TestIntegrationUring, testEnableWriteSocketInsideWait)
+{
+    if (!Poller::isAvailable())
+    {
+        GTEST_SKIP();
+    }
+    std::shared_ptr<IPoller> poller = std::make_shared<Poller>();
+    poller->init();
+
+    SocketDescriptorPtr controlSocketInside;
+    SocketDescriptorPtr controlSocketOutside;
+
+    int res = OperatingSystem::instance().makeSocketPair(controlSocketInside, controlSocketOutside);
+    EXPECT_EQ(res, 0);
+    EXPECT_NE(controlSocketInside, nullptr);
+    EXPECT_NE(controlSocketOutside, nullptr);
+
+    poller->addSocket(controlSocketInside);
+    poller->enableRead(controlSocketInside);
+
+    const PollerResult& result1 = poller->wait(0);
+    EXPECT_EQ(result1.error, false);
+    EXPECT_EQ(result1.timeout, true);
+    EXPECT_EQ(result1.descriptorInfos.size(), 0);
+
+    std::thread thread([poller, controlSocketInside] () {
+        std::this_thread::sleep_for(10ms);
+        poller->enableWrite(controlSocketInside);
+    });
+
+    const PollerResult& result2 = poller->wait(1000000);
+    EXPECT_EQ(result2.error, false);
+    EXPECT_EQ(result2.timeout, false);
+    EXPECT_EQ(result2.descriptorInfos.size(), 1);
+    EXPECT_EQ(result2.descriptorInfos[0].sd, controlSocketInside->getDescriptor());
+    EXPECT_EQ(result2.descriptorInfos[0].readable, false);
+    EXPECT_EQ(result2.descriptorInfos[0].writable, true);
+
+    thread.join();
+}
+
+TEST(TestIntegrationUring, testEnableWriteSocketNotWritable)
+{
+    if (!Poller::isAvailable())
+    {
+        GTEST_SKIP();
+    }
+    std::unique_ptr<IPoller> poller = std::make_unique<Poller>();
+    poller->init();
+
+    SocketDescriptorPtr controlSocketInside;
+    SocketDescriptorPtr controlSocketOutside;
+
+    int res = OperatingSystem::instance().makeSocketPair(controlSocketInside, controlSocketOutside);
+    EXPECT_EQ(res, 0);
+    EXPECT_NE(controlSocketInside, nullptr);
+    EXPECT_NE(controlSocketOutside, nullptr);
+
+    poller->addSocket(controlSocketInside);
+    poller->enableRead(controlSocketInside);
+    const PollerResult& result1 = poller->wait(0);
+    EXPECT_EQ(result1.error, false);
+    EXPECT_EQ(result1.timeout, true);
+    EXPECT_EQ(result1.descriptorInfos.size(), 0);
+
+    static const std::string LARGE_BUFFER = "AAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAA";
+    res = 0;
+    while (res >= 0)
+    {
+        res = OperatingSystem::instance().send(controlSocketInside->getDescriptor(), LARGE_BUFFER.c_str(), LARGE_BUFFER.size(), 0);
+    }
+    poller->enableWrite(controlSocketInside);
+    const PollerResult& result2 = poller->wait(0);
+    EXPECT_EQ(result2.error, false);
+    EXPECT_EQ(result2.timeout, true);
+    EXPECT_EQ(result2.descriptorInfos.size(), 0);
+}
+
+
+TEST(TestIntegrationUring, testEnableWriteSocketNotWritableToWritable)
+{
+    if (!Poller::isAvailable())
+    {
+        GTEST_SKIP();
+    }
+    std::shared_ptr<IPoller> poller = std::make_unique<Poller>();
+    poller->init();
+
+    SocketDescriptorPtr controlSocketInside;
+    SocketDescriptorPtr controlSocketOutside;
+
+    int res = OperatingSystem::instance().makeSocketPair(controlSocketInside, controlSocketOutside);
+    EXPECT_EQ(res, 0);
+    EXPECT_NE(controlSocketInside, nullptr);
+    EXPECT_NE(controlSocketOutside, nullptr);
+
+    poller->addSocket(controlSocketInside);
+    poller->enableRead(controlSocketInside);
+    const PollerResult& result1 = poller->wait(0);
+    EXPECT_EQ(result1.error, false);
+    EXPECT_EQ(result1.timeout, true);
+    EXPECT_EQ(result1.descriptorInfos.size(), 0);
+
+    static const std::string LARGE_BUFFER = "AAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAA";
+    res = 0;
+    while (res >= 0)
+    {
+        res = OperatingSystem::instance().send(controlSocketInside->getDescriptor(), LARGE_BUFFER.c_str(), LARGE_BUFFER.size(), 0);
+    }
+    poller->enableWrite(controlSocketInside);
+
+    std::thread thread([poller, controlSocketOutside] () {
+        std::this_thread::sleep_for(10ms);
+        char buffer[1024];
+        int res = 0;
+        while (res >= 0)
+        {
+            res = OperatingSystem::instance().recv(controlSocketOutside->getDescriptor(), buffer, sizeof(buffer), 0);
+        }
+    });
+
+    const PollerResult& result2 = poller->wait(1000000);
+    EXPECT_EQ(result2.error, false);
+    EXPECT_EQ(result2.timeout, false);
+    EXPECT_EQ(result2.descriptorInfos.size(), 1);
+    EXPECT_EQ(result2.descriptorInfos[0].sd, controlSocketInside->getDescriptor());
+    EXPECT_EQ(result2.descriptorInfos[0].readable, false);
+    EXPECT_EQ(result2.descriptorInfos[0].writable, true);
+
+    thread.join();
+}
+
+
+TEST(TestIntegrationUring, testDisableWriteSocket)
+{
+    if (!Poller::isAvailable())
+    {
+        GTEST_SKIP();
+    }
+    std::shared_ptr<IPoller> poller = std::make_unique<Poller>();
+    poller->init();
+
+    SocketDescriptorPtr controlSocketInside;
+    SocketDescriptorPtr controlSocketOutside;
+
+    int res = OperatingSystem::instance().makeSocketPair(controlSocketInside, controlSocketOutside);
+    EXPECT_EQ(res, 0);
+    EXPECT_NE(controlSocketInside, nullptr);
+    EXPECT_NE(controlSocketOutside, nullptr);
+
+    poller->addSocket(controlSocketInside);
+    poller->enableRead(controlSocketInside);
+    const PollerResult& result1 = poller->wait(0);
+    EXPECT_EQ(result1.error, false);
+    EXPECT_EQ(result1.timeout, true);
+    EXPECT_EQ(result1.descriptorInfos.size(), 0);
+
+    static const std::string LARGE_BUFFER = "AAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAAA";
+    res = 0;
+    while (res >= 0)
+    {
+        res = OperatingSystem::instance().send(controlSocketInside->getDescriptor(), LARGE_BUFFER.c_str(), LARGE_BUFFER.size(), 0);
+    }
+    poller->enableWrite(controlSocketInside);
+
+    std::thread thread([poller, controlSocketInside, controlSocketOutside] () {
+        std::this_thread::sleep_for(10ms);
+        poller->disableWrite(controlSocketInside);
+        std::this_thread::sleep_for(10ms);
+        char buffer[1024];
+        int res = 0;
+        while (res >= 0)
+        {
+            res = OperatingSystem::instance().recv(controlSocketOutside->getDescriptor(), buffer, sizeof(buffer), 0);
+        }
+    });
+
+    const PollerResult& result2 = poller->wait(50);
+    EXPECT_EQ(result2.error, false);
+    EXPECT_EQ(result2.timeout, true);
+    EXPECT_EQ(result2.descriptorInfos.size(), 0);
+
+    thread.join();
+}
+
+
+TEST(TestIntegrationUring, testRemoveSocketInsideWait)
+{
+    if (!Poller::isAvailable())
+    {
+        GTEST_SKIP();
+    }
+    std::shared_ptr<IPoller> poller = std::make_shared<Poller>();
+    poller->init();
+
+    SocketDescriptorPtr controlSocketInside;
+    SocketDescriptorPtr controlSocketOutside;
+
+    int res = OperatingSystem::instance().makeSocketPair(controlSocketInside, controlSocketOutside);
+    EXPECT_EQ(res, 0);
+    EXPECT_NE(controlSocketInside, nullptr);
+    EXPECT_NE(controlSocketOutside, nullptr);
+
+    poller->addSocket(controlSocketInside);
+    poller->enableRead(controlSocketInside);
+
+    std::thread thread([poller, controlSocketInside, controlSocketOutside] () {
+        std::this_thread::sleep_for(10ms);
+        poller->removeSocket(controlSocketInside);
+        std::this_thread::sleep_for(10ms);
+        OperatingSystem::instance().send(controlSocketOutside->getDescriptor(), BUFFER.c_str(), BUFFER.size(), 0);
+    });
+
+
+    const PollerResult& result = poller->wait(50);
+    EXPECT_EQ(result.error, false);
+    EXPECT_EQ(result.timeout, true);
+    EXPECT_EQ(result.descriptorInfos.size(), 0);
+
+    thread.join();
+}
+
+
+TEST(TestIntegrationUring, testReceiveCompletion)
+{
+    if (!Poller::isAvailable())
+    {
+        GTEST_SKIP();
+    }
+    std::shared_ptr<Poller> poller = std::make_shared<Poller>();
+    IPoller& pollerReadiness = *poller;
+    IPollerCompletion& pollerCompletion = *poller;
+    pollerReadiness.init();
+
+    SocketDescriptorPtr controlSocketInside;
+    SocketDescriptorPtr controlSocketOutside;
+
+    int res = OperatingSystem::instance().makeSocketPair(controlSocketInside, controlSocketOutside);
+    EXPECT_EQ(res, 0);
+
+    pollerReadiness.addSocket(controlSocketInside);
+    pollerCompletion.enableReceive(controlSocketInside);
+    OperatingSystem::instance().send(controlSocketOutside->getDescriptor(), BUFFER.c_str(), BUFFER.size(), 0);
+
+    const PollerResult& result1 = pollerReadiness.wait(1000);
+    EXPECT_EQ(result1.error, false);
+    EXPECT_EQ(result1.timeout, false);
+    EXPECT_EQ(result1.descriptorInfos.size(), 0);
+    ASSERT_EQ(result1.completions.size(), 1);
+    EXPECT_EQ(result1.completions[0].sd, controlSocketInside->getDescriptor());
+    EXPECT_EQ(result1.completions[0].type, CompletionType::COMPLETION_RECEIVE);
+    EXPECT_EQ(result1.completions[0].result, static_cast<int>(BUFFER.size()));
+    EXPECT_EQ(std::string(result1.completions[0].buffer, result1.completions[0].size), BUFFER);
+
+    // the poller receives again, a closed peer completes the receive with 0
+    controlSocketOutside = nullptr;
+    const PollerResult& result2 = pollerReadiness.wait(1000);
+    EXPECT_EQ(result2.error, false);
+    ASSERT_EQ(result2.completions.size(), 1);
+    EXPECT_EQ(result2.completions[0].type, CompletionType::COMPLETION_RECEIVE);
+    EXPECT_EQ(result2.completions[0].result, 0);
+
+    // no receive after the close
+    const PollerResult& result3 = pollerReadiness.wait(10);
+    EXPECT_EQ(result3.timeout, true);
+    EXPECT_EQ(result3.completions.size(), 0);
+}
+
+
+TEST(TestIntegrationUring, testRemoveSocketWithPendingReceive)
+{
+    if (!Poller::isAvailable())
+    {
+        GTEST_SKIP();
+    }
+    std::shared_ptr<Poller> poller = std::make_shared<Poller>();
+    IPoller& pollerReadiness = *poller;
+    IPollerCompletion& pollerCompletion = *poller;
+    pollerReadiness.init();
+
+    SocketDescriptorPtr controlSocketInside;
+    SocketDescriptorPtr controlSocketOutside;
+
+    int res = OperatingSystem::instance().makeSocketPair(controlSocketInside, controlSocketOutside);
+    EXPECT_EQ(res, 0);
+
+    pollerReadiness.addSocket(controlSocketInside);
+    pollerCompletion.enableReceive(controlSocketInside);
+    const PollerResult& result1 = pollerReadiness.wait(0);
+    EXPECT_EQ(result1.timeout, true);
+
+    pollerReadiness.removeSocket(controlSocketInside);
+    OperatingSystem::instance().send(controlSocketOutside->getDescriptor(), BUFFER.c_str(), BUFFER.size(), 0);
+
+    const PollerResult& result2 = pollerReadiness.wait(50);
+    EXPECT_EQ(result2.error, false);
+    EXPECT_EQ(result2.timeout, true);
+    EXPECT_EQ(result2.completions.size(), 0);
+}
+
+
+TEST(TestIntegrationUring, testSendCompletion)
+{
+    if (!Poller::isAvailable())
+    {
+        GTEST_SKIP();
+    }
+    std::shared_ptr<Poller> poller = std::make_shared<Poller>();
+    IPoller& pollerReadiness = *poller;
+    IPollerCompletion& pollerCompletion = *poller;
+    pollerReadiness.init();
+
+    SocketDescriptorPtr controlSocketInside;
+    SocketDescriptorPtr controlSocketOutside;
+
+    int res = OperatingSystem::instance().makeSocketPair(controlSocketInside, controlSocketOutside);
+    EXPECT_EQ(res, 0);
+
+    pollerReadiness.addSocket(controlSocketInside);
+
+    std::shared_ptr<std::string> data = std::make_shared<std::string>(BUFFER);
+    std::vector<struct iovec> buffers(2);
+    buffers[0].iov_base = const_cast<char*>(data->data());
+    buffers[0].iov_len = data->size();
+    buffers[1] = buffers[0];
+    EXPECT_EQ(pollerCompletion.submitSend(controlSocketInside, std::move(buffers), data), true);
+
+    // only one send of a socket can be pending
+    std::vector<struct iovec> buffers2(1, iovec{const_cast<char*>(data->data()), data->size()});
+    EXPECT_EQ(pollerCompletion.submitSend(controlSocketInside, std::move(buffers2), data), false);
+
+    const PollerResult& result = pollerReadiness.wait(1000);
+    EXPECT_EQ(result.error, false);
+    ASSERT_EQ(result.completions.size(), 1);
+    EXPECT_EQ(result.completions[0].sd, controlSocketInside->getDescriptor());
+    EXPECT_EQ(result.completions[0].type, CompletionType::COMPLETION_SEND);
+    EXPECT_EQ(result.completions[0].result, static_cast<int>(2 * BUFFER.size()));
+    // the keepalive was released
+    EXPECT_EQ(data.use_count(), 1);
+
+    char bufferReceive[100];
+    res = OperatingSystem::instance().recv(controlSocketOutside->getDescriptor(), bufferReceive, sizeof(bufferReceive), 0);
+    EXPECT_EQ(std::string(bufferReceive, std::max(res, 0)), BUFFER + BUFFER);
+}
+
+
+TEST(TestIntegrationUring, testAcceptCompletion)
+{
+    if (!Poller::isAvailable())
+    {
+        GTEST_SKIP();
+    }
+    std::shared_ptr<Poller> poller = std::make_shared<Poller>();
+    IPoller& pollerReadiness = *poller;
+    IPollerCompletion& pollerCompletion = *poller;
+    pollerReadiness.init();
+
+    SocketPtr socketListen = std::make_shared<Socket>();
+    socketListen->create(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    addr.sin_port = 0;
+    EXPECT_EQ(socketListen->bind(reinterpret_cast<const sockaddr*>(&addr), sizeof(addr)), 0);
+    EXPECT_EQ(socketListen->listen(5), 0);
+    socklen_t addrSize = sizeof(addr);
+    OperatingSystem::instance().getsockname(socketListen->getSocketDescriptor()->getDescriptor(), reinterpret_cast<sockaddr*>(&addr), &addrSize);
+
+    pollerReadiness.addSocket(socketListen->getSocketDescriptor());
+    pollerCompletion.enableAccept(socketListen->getSocketDescriptor());
+
+    SocketPtr socketConnect = std::make_shared<Socket>();
+    socketConnect->create(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+    socketConnect->connect(reinterpret_cast<const sockaddr*>(&addr), sizeof(addr));
+
+    const PollerResult& result = pollerReadiness.wait(1000);
+    EXPECT_EQ(result.error, false);
+    EXPECT_EQ(result.descriptorInfos.size(), 0);
+    ASSERT_EQ(result.completions.size(), 1);
+    EXPECT_EQ(result.completions[0].sd, socketListen->getSocketDescriptor()->getDescriptor());
+    EXPECT_EQ(result.completions[0].type, CompletionType::COMPLETION_ACCEPT);
+    EXPECT_GE(result.completions[0].result, 0);
+    EXPECT_EQ(result.completions[0].size, static_cast<int>(sizeof(sockaddr_in)));
+    if (result.completions[0].result >= 0)
+    {
+        OperatingSystem::instance().closeSocket(result.completions[0].result);
+    }
+}
+
+
+TEST(TestIntegrationUring, testStreamConnectionContainer)
+{
+    if (!Poller::isAvailable())
+    {
+        GTEST_SKIP();
+    }
+    const PollerType pollerTypeBefore = PollerFactory::getDefaultPollerType();
+    PollerFactory::setDefaultPollerType(PollerType::POLLER_URING);
+
+    std::shared_ptr<MockIStreamConnectionCallback> mockBindCallback = std::make_shared<MockIStreamConnectionCallback>();
+    std::shared_ptr<MockIStreamConnectionCallback> mockClientCallback = std::make_shared<MockIStreamConnectionCallback>();
+    std::shared_ptr<MockIStreamConnectionCallback> mockServerCallback = std::make_shared<MockIStreamConnectionCallback>();
+    std::unique_ptr<IStreamConnectionContainer> connectionContainer = std::make_unique<StreamConnectionContainer>();
+    connectionContainer->init(1, nullptr, 1);
+    IStreamConnectionContainer* connectionContainerRaw = connectionContainer.get();
+    std::thread thread([connectionContainerRaw] () {
+        connectionContainerRaw->run();
+    });
+
+    static const int COUNT = 1000;
+    std::string dataServer;
+    std::string dataClient;
+    std::atomic<size_t> sizeClient{0};
+    IStreamConnectionPtr connBind;
+
+    EXPECT_CALL(*mockBindCallback, connected(_)).Times(1)
+                                  .WillOnce(DoAll(testing::SaveArg<0>(&connBind), Return(mockServerCallback)));
+    EXPECT_CALL(*mockServerCallback, connected(_)).Times(1);
+    EXPECT_CALL(*mockClientCallback, connected(_)).Times(1);
+    // the server echoes every received chunk
+    auto& expectReceivedServer = EXPECT_CALL(*mockServerCallback, received(_, _, _)).WillRepeatedly(testing::Invoke(
+        [&dataServer] (const IStreamConnectionPtr& connection, const char* buffer, int size) {
+            dataServer.append(buffer, size);
+            IMessagePtr message = std::make_shared<ProtocolMessage>(0);
+            message->addSendPayload(std::string(buffer, size));
+            connection->sendMessage(message);
+            return true;
+        }));
+    auto& expectReceivedClient = EXPECT_CALL(*mockClientCallback, received(_, _, _)).WillRepeatedly(testing::Invoke(
+        [&dataClient, &sizeClient] (const IStreamConnectionPtr& /*connection*/, const char* buffer, int size) {
+            dataClient.append(buffer, size);
+            sizeClient += size;
+            return true;
+        }));
+    (void)expectReceivedServer;
+    (void)expectReceivedClient;
+
+    int res = connectionContainer->bind("tcp://*:3333", mockBindCallback);
+    EXPECT_EQ(res, 0);
+    IStreamConnectionPtr connection = connectionContainer->connect("tcp://localhost:3333", mockClientCallback);
+
+    std::string dataSent;
+    for (int i = 0; i < COUNT; ++i)
+    {
+        std::string payload = "message " + std::to_string(i) + ";";
+        dataSent += payload;
+        IMessagePtr message = std::make_shared<ProtocolMessage>(0);
+        message->addSendPayload(payload);
+        connection->sendMessage(message);
+    }
+
+    // the data is received and echoed in the same order
+    for (int i = 0; i < 500 && sizeClient < dataSent.size(); ++i)
+    {
+        std::this_thread::sleep_for(10ms);
+    }
+
+    auto& expectDisconnected = EXPECT_CALL(*mockServerCallback, disconnected(_)).Times(1);
+    EXPECT_CALL(*mockClientCallback, disconnected(_)).Times(1);
+    connection->disconnect();
+    waitTillDone(expectDisconnected, 5000);
+
+    connectionContainer->terminatePollerLoop();
+    thread.join();
+    connectionContainer = nullptr;
+    EXPECT_EQ(dataServer, dataSent);
+    EXPECT_EQ(dataClient, dataSent);
+
+    PollerFactory::setDefaultPollerType(pollerTypeBefore);
+}
+
+
+#endif
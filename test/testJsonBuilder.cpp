@@ -26,6 +26,7 @@
 
 #include "finalmq/helpers/FmqDefines.h"
 #include "finalmq/json/JsonBuilder.h"
+#include "finalmq/helpers/ZeroCopyBuffer.h"
 #include "MockIZeroCopyBuffer.h"
 
 using ::testing::_;
@@ -250,6 +251,15 @@ TEST_F(TestJsonBuilder, testStringEscapeU32)
     EXPECT_EQ(m_data, "\"\\ud802\\uddaa\"");
 }
 
+TEST_F(TestJsonBuilder, testStringEscapeU16FollowedByAscii)
+{
+    static const std::string VALUE = {(char)0xc3, (char)0xa4, 'b', 'c'};
+
+    m_builder->enterString(VALUE.c_str(), VALUE.size());
+    m_builder->finished();
+    EXPECT_EQ(m_data, "\"\\u00e4bc\"");
+}
+
 TEST_F(TestJsonBuilder, testArray)
 {
     m_builder->enterArray();
@@ -336,3 +346,36 @@ TEST_F(TestJsonBuilder, testObjectExample)
     m_builder->finished();
     EXPECT_EQ(m_data, "{\"name\":\"Elvis\",\"age\":42,\"arr\":[1.234,2.345,3.456]}");
 }
+
+
+
+TEST(TestJsonBuilderBlocks, testLongStringsOverBlockBoundaries)
+{
+    static const int MAX_BLOCK_SIZE = 64;
+
+    std::string value;
+    std::string escaped;
+    for (int i = 0; i < 100; ++i)
+    {
+        value += "abcdefghij\"\\\n";
+        value += static_cast<char>(0xc3);
+        value += static_cast<char>(0xa4);
+        escaped += "abcdefghij\\\"\\\\\\n\\u00e4";
+    }
+
+    ZeroCopyBuffer buffer;
+    {
+        JsonBuilder builder(buffer, MAX_BLOCK_SIZE);
+        builder.enterArray();
+        builder.enterString(value.c_str(), value.size());
+        builder.enterString(std::string(value));
+        builder.exitArray();
+    }
+    EXPECT_EQ(buffer.getData(), "[\"" + escaped + "\",\"" + escaped + "\"]");
+
+    // no block is reserved for the worst case of the escapes (6 times the string size)
+    for (const auto& chunk : buffer.chunks())
+    {
+        EXPECT_LE(chunk.size(), value.size() + 3);
+    }
+}
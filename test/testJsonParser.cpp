@@ -303,6 +303,115 @@ TEST_F(TestJsonParser, testDoubleWrongFormat)
 
 
 
+TEST_F(TestJsonParser, testDoubleExponentWithoutDigits)
+{
+    std::string json = "1.5e";
+    EXPECT_CALL(m_mockJsonParserVisitor, syntaxError(json.c_str()+3, _)).Times(1);
+    EXPECT_CALL(m_mockJsonParserVisitor, finished()).Times(1);
+    const char* res = m_parser->parse(json.c_str());
+    EXPECT_EQ(res, nullptr);
+}
+
+TEST_F(TestJsonParser, testDoubleSameAsStrtod)
+{
+    const std::vector<std::string> numbers = {
+        "0.1", "-0.0", "1.", "1E+2", "0.30000000000000004", "1.7976931348623157e308", "2.2250738585072014e-308",
+        "5e-324", "1e400", "-1e-400", "9007199254740993.0", "123456789012345678901234567890.5", "0.000000000000000000000000000001",
+        "3.141592653589793238462643383279", "1e22", "1e23", "4.35679e-7", "-12345.678e-3"
+    };
+    for (const std::string& json : numbers)
+    {
+        const double expected = strtod(json.c_str(), nullptr);
+        EXPECT_CALL(m_mockJsonParserVisitor, enterDouble(expected)).Times(1);
+        EXPECT_CALL(m_mockJsonParserVisitor, finished()).Times(1);
+        const char* res = m_parser->parse(json.c_str());
+        EXPECT_EQ(res, json.c_str() + json.size()) << json;
+        testing::Mock::VerifyAndClearExpectations(&m_mockJsonParserVisitor);
+    }
+}
+
+TEST_F(TestJsonParser, testIntegerLimits)
+{
+    {
+        testing::InSequence seq;
+        EXPECT_CALL(m_mockJsonParserVisitor, enterUInt64(18446744073709551615ull)).Times(2);
+        EXPECT_CALL(m_mockJsonParserVisitor, enterInt64(std::numeric_limits<std::int64_t>::min())).Times(2);
+        EXPECT_CALL(m_mockJsonParserVisitor, enterUInt32(2147483647)).Times(1);
+        EXPECT_CALL(m_mockJsonParserVisitor, enterUInt64(2147483648)).Times(1);
+        EXPECT_CALL(m_mockJsonParserVisitor, enterInt32(-2147483647 - 1)).Times(1);
+        EXPECT_CALL(m_mockJsonParserVisitor, enterInt32(0)).Times(1);
+        EXPECT_CALL(m_mockJsonParserVisitor, enterUInt64(12345678901234567ull)).Times(1);
+    }
+    EXPECT_CALL(m_mockJsonParserVisitor, finished()).Times(9);
+    const std::vector<std::string> numbers = {
+        "18446744073709551615", "18446744073709551616", "-9223372036854775808", "-9223372036854775809",
+        "2147483647", "2147483648", "-2147483648", "-0", "12345678901234567"
+    };
+    for (const std::string& json : numbers)
+    {
+        const char* res = m_parser->parse(json.c_str());
+        EXPECT_EQ(res, json.c_str() + json.size()) << json;
+    }
+}
+
+TEST_F(TestJsonParser, testStringBlockBoundaries)
+{
+    // the strings are scanned block by block, check all positions of the quote and the escapes
+    for (size_t len = 0; len < 70; ++len)
+    {
+        const std::string value(len, 'a');
+        std::string json = "\"" + value + "\"";
+        EXPECT_CALL(m_mockJsonParserVisitor, enterString(json.c_str() + 1, len)).Times(1);
+        EXPECT_CALL(m_mockJsonParserVisitor, finished()).Times(1);
+        const char* res = m_parser->parse(json.c_str());
+        EXPECT_EQ(res, json.c_str() + json.size());
+
+        std::string jsonEscape = "\"" + value + "\\n" + value + "\\\"" + value + "\"";
+        EXPECT_CALL(m_mockJsonParserVisitor, enterString(value + "\n" + value + "\"" + value)).Times(1);
+        EXPECT_CALL(m_mockJsonParserVisitor, finished()).Times(1);
+        res = m_parser->parse(jsonEscape.c_str());
+        EXPECT_EQ(res, jsonEscape.c_str() + jsonEscape.size());
+
+        std::string jsonEarlyEnd = "\"" + value;
+        EXPECT_CALL(m_mockJsonParserVisitor, syntaxError(jsonEarlyEnd.c_str() + jsonEarlyEnd.size(), _)).Times(1);
+        EXPECT_CALL(m_mockJsonParserVisitor, finished()).Times(1);
+        res = m_parser->parse(jsonEarlyEnd.c_str(), jsonEarlyEnd.size());
+        EXPECT_EQ(res, nullptr);
+
+        std::string jsonZero = "\"" + value + '\0' + "\"";
+        EXPECT_CALL(m_mockJsonParserVisitor, syntaxError(jsonZero.c_str() + 1 + len, _)).Times(1);
+        EXPECT_CALL(m_mockJsonParserVisitor, finished()).Times(1);
+        res = m_parser->parse(jsonZero.c_str(), jsonZero.size());
+        EXPECT_EQ(res, nullptr);
+        testing::Mock::VerifyAndClearExpectations(&m_mockJsonParserVisitor);
+    }
+}
+
+TEST_F(TestJsonParser, testLongWhiteSpace)
+{
+    for (size_t len = 0; len < 70; ++len)
+    {
+        std::string whiteSpace;
+        for (size_t i = 0; i < len; ++i)
+        {
+            whiteSpace += " \t\r\n"[i % 4];
+        }
+        std::string json = whiteSpace + "[" + whiteSpace + "null" + whiteSpace + "]" + whiteSpace;
+        {
+            testing::InSequence seq;
+            EXPECT_CALL(m_mockJsonParserVisitor, enterArray()).Times(1);
+            EXPECT_CALL(m_mockJsonParserVisitor, enterNull()).Times(1);
+            EXPECT_CALL(m_mockJsonParserVisitor, exitArray()).Times(1);
+            EXPECT_CALL(m_mockJsonParserVisitor, finished()).Times(1);
+        }
+        const char* res = m_parser->parse(json.c_str(), json.size());
+        EXPECT_EQ(res, json.c_str() + json.size());
+        testing::Mock::VerifyAndClearExpectations(&m_mockJsonParserVisitor);
+    }
+}
+
+
+
 TEST_F(TestJsonParser, testEmptyString)
 {
     std::string json = "\"\"";
@@ -0,0 +1,99 @@
+//MIT License
+
+//Copyright (c) 2020 bexoft GmbH (mail@bexoft.de)
+
+//Permission is hereby granted, free of charge, to any person obtaining a copy
+//of this software and associated documentation files (the "Software"), to deal
+//in the Software without restriction, including without limitation the rights
+//to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//copies of the Software, and to permit persons to whom the Software is
+//furnished to do so, subject to the following conditions:
+
+//The above copyright notice and this permission notice shall be included in all
+//copies or substantial portions of the Software.
+
+//THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//SOFTWARE.
+
+
+#include "gtest/gtest.h"
+
+#include "finalmq/metadata/MetaStruct.h"
+
+
+using namespace finalmq;
+
+
+class TestMetaStruct : public testing::Test
+{
+protected:
+    virtual void SetUp()
+    {
+        m_struct.addField({TYPE_INT32, "", "value", "", 0});
+        m_struct.addField({TYPE_STRING, "", "name", "", 0});
+        m_struct.addField({TYPE_STRING, "", "nbme", "", 0});
+        m_struct.addField({TYPE_BOOL, "", "a", "", 0});
+        m_struct.addField({TYPE_DOUBLE, "", "longername", "", 0});
+    }
+
+    virtual void TearDown()
+    {
+    }
+
+    MetaStruct m_struct{};
+};
+
+
+TEST_F(TestMetaStruct, testGetFieldByName)
+{
+    const char* names[] = {"value", "name", "nbme", "a", "longername"};
+    for (int i = 0; i < 5; ++i)
+    {
+        const MetaField* field = m_struct.getFieldByName(names[i]);
+        ASSERT_NE(field, nullptr);
+        EXPECT_EQ(field->name, names[i]);
+        EXPECT_EQ(field->index, i);
+        EXPECT_EQ(field, m_struct.getFieldByIndex(i));
+    }
+}
+
+TEST_F(TestMetaStruct, testGetFieldByNameNotFound)
+{
+    EXPECT_EQ(m_struct.getFieldByName(""), nullptr);
+    EXPECT_EQ(m_struct.getFieldByName("b"), nullptr);
+    EXPECT_EQ(m_struct.getFieldByName("nam"), nullptr);
+    EXPECT_EQ(m_struct.getFieldByName("ncme"), nullptr);
+    EXPECT_EQ(m_struct.getFieldByName("names"), nullptr);
+    EXPECT_EQ(m_struct.getFieldByName("zzzzzzzzzzzz"), nullptr);
+}
+
+TEST_F(TestMetaStruct, testGetFieldByNameFromBuffer)
+{
+    // the key is not null terminated, like a key inside of a JSON buffer
+    static const char BUFFER[] = "\"name\":1";
+    const MetaField* field = m_struct.getFieldByName(std::string_view(BUFFER + 1, 4));
+    ASSERT_NE(field, nullptr);
+    EXPECT_EQ(field->index, 1);
+}
+
+TEST_F(TestMetaStruct, testAddFieldTwice)
+{
+    m_struct.addField({TYPE_INT32, "", "name", "", 0});
+    EXPECT_EQ(m_struct.getFieldsSize(), 5);
+    EXPECT_EQ(m_struct.getFieldByName("name")->typeId, TYPE_STRING);
+}
+
+TEST_F(TestMetaStruct, testCopy)
+{
+    std::unique_ptr<MetaStruct> original = std::make_unique<MetaStruct>(m_struct);
+    MetaStruct copy = *original;
+    original = nullptr;
+    const MetaField* field = copy.getFieldByName("longername");
+    ASSERT_NE(field, nullptr);
+    EXPECT_EQ(field->index, 4);
+}
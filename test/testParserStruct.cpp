@@ -25,6 +25,10 @@
 
 
 #include "finalmq/serializestruct/ParserStruct.h"
+#include "finalmq/serialize/ParserAbortAndIndexImpl.h"
+#include "finalmq/serialize/ParserConverterImpl.h"
+#include "finalmq/serialize/ParserProcessDefaultValuesImpl.h"
+#include "finalmq/serialize/ParserStage.h"
 #include "finalmq/serializevariant/VarValueToVariant.h"
 #include "finalmq/variant/VariantValueStruct.h"
 #include "finalmq/variant/VariantValueList.h"
@@ -1185,5 +1189,36 @@ TEST_F(TestParserStruct, testArrayEnumInt32)
 }
 
 
+TEST_F(TestParserStruct, testCompileTimePipeline)
+{
+    const MetaField* fieldStruct = MetaDataGlobal::instance().getField("test.TestStruct", "struct_int32");
+    ASSERT_NE(fieldStruct, nullptr);
+    const MetaField* fieldValue = MetaDataGlobal::instance().getField("test.TestInt32", "value");
+    ASSERT_NE(fieldValue, nullptr);
+    const MetaField* fieldLastValue = MetaDataGlobal::instance().getField("test.TestStruct", "last_value");
+    ASSERT_NE(fieldLastValue, nullptr);
 
+    MockIParserVisitor mockVisitor;
 
+    {
+        testing::InSequence seq;
+        EXPECT_CALL(mockVisitor, startStruct(_)).Times(1);
+        EXPECT_CALL(mockVisitor, enterStruct(MatcherMetaField(*fieldStruct))).Times(1);
+        EXPECT_CALL(mockVisitor, enterInt32(MatcherMetaField(*fieldValue), -5)).Times(1);
+        EXPECT_CALL(mockVisitor, exitStruct(MatcherMetaField(*fieldStruct))).Times(1);
+        EXPECT_CALL(mockVisitor, enterUInt32(MatcherMetaField(*fieldLastValue), 7u)).Times(1);
+        EXPECT_CALL(mockVisitor, finished()).Times(1);
+    }
+
+    // the default value of struct_string is skipped
+    using AbortAndIndex = ParserStage<ParserAbortAndIndexT, MockIParserVisitor>;
+    using ProcessDefaultValues = ParserStage<ParserProcessDefaultValuesT, AbortAndIndex>;
+    AbortAndIndex abortAndIndex(&mockVisitor);
+    ProcessDefaultValues processDefaultValues(true, &abortAndIndex);
+    ParserConverterT<ProcessDefaultValues> converter(&processDefaultValues);
+
+    test::TestStruct root = {test::TestInt32{-5}, test::TestString{""}, 7};
+    ParserStruct parser(converter, root);
+    bool res = parser.parseStruct();
+    ASSERT_EQ(res, true);
+}
@@ -0,0 +1,123 @@
+//MIT License
+
+//Copyright (c) 2020 bexoft GmbH (mail@bexoft.de)
+
+//Permission is hereby granted, free of charge, to any person obtaining a copy
+//of this software and associated documentation files (the "Software"), to deal
+//in the Software without restriction, including without limitation the rights
+//to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//copies of the Software, and to permit persons to whom the Software is
+//furnished to do so, subject to the following conditions:
+
+//The above copyright notice and this permission notice shall be included in all
+//copies or substantial portions of the Software.
+
+//THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//SOFTWARE.
+
+
+#include "gtest/gtest.h"
+#include "gmock/gmock.h"
+
+
+#include "finalmq/helpers/ZeroCopyBuffer.h"
+#include "finalmq/serializeproto/ProtoView.h"
+#include "test.fmq.h"
+
+
+using namespace finalmq;
+
+
+template<class T>
+static std::string serialize(const T& value)
+{
+    ZeroCopyBuffer buffer;
+    value.serializeProto(buffer);
+    return buffer.getData();
+}
+
+
+
+TEST(TestProtoView, testStruct)
+{
+    test::TestStruct value{test::TestInt32{-5}, test::TestString{"hello"}, 7};
+    std::string data = serialize(value);
+
+    test::TestStructView view(data.data(), data.size());
+    EXPECT_EQ(view.isValid(), true);
+    EXPECT_EQ(view.last_value(), 7u);
+    EXPECT_EQ(view.struct_int32().value(), -5);
+    std::string_view str = view.struct_string().value();
+    EXPECT_EQ(str, "hello");
+    // no copy, the string view points into the buffer
+    EXPECT_GE(str.data(), data.data());
+    EXPECT_LE(str.data() + str.size(), data.data() + data.size());
+}
+
+TEST(TestProtoView, testValues)
+{
+    std::string data = serialize(test::TestInt32ZigZag{-12345});
+    EXPECT_EQ(test::TestInt32ZigZagView(data.data(), data.size()).value(), -12345);
+
+    data = serialize(test::TestInt64{-1234567890123ll});
+    EXPECT_EQ(test::TestInt64View(data.data(), data.size()).value(), -1234567890123ll);
+
+    data = serialize(test::TestUInt64{0xfedcba9876543210ull});
+    EXPECT_EQ(test::TestUInt64View(data.data(), data.size()).value(), 0xfedcba9876543210ull);
+
+    data = serialize(test::TestBool{true});
+    EXPECT_EQ(test::TestBoolView(data.data(), data.size()).value(), true);
+
+    data = serialize(test::TestFloat{-1.5f});
+    EXPECT_EQ(test::TestFloatView(data.data(), data.size()).value(), -1.5f);
+
+    data = serialize(test::TestDouble{2.25});
+    EXPECT_EQ(test::TestDoubleView(data.data(), data.size()).value(), 2.25);
+
+    data = serialize(test::TestBytes{{'a', 0, 'b'}});
+    EXPECT_EQ(test::TestBytesView(data.data(), data.size()).value(), std::string_view("a\0b", 3));
+
+    data = serialize(test::TestEnum{test::Foo::FOO_WORLD2});
+    EXPECT_EQ(test::TestEnumView(data.data(), data.size()).value(), test::Foo::FOO_WORLD2);
+}
+
+TEST(TestProtoView, testDefaultValues)
+{
+    // default values are not in the data
+    std::string data = serialize(test::TestStruct{});
+    EXPECT_EQ(data.size(), 0u);
+
+    test::TestStructView view(data.data(), data.size());
+    EXPECT_EQ(view.isValid(), true);
+    EXPECT_EQ(view.getProtoView().hasField(1), false);
+    EXPECT_EQ(view.last_value(), 0u);
+    EXPECT_EQ(view.struct_int32().value(), 0);
+    EXPECT_EQ(view.struct_string().value(), "");
+
+    test::TestStructView viewEmpty;
+    EXPECT_EQ(viewEmpty.isValid(), true);
+    EXPECT_EQ(viewEmpty.last_value(), 0u);
+}
+
+TEST(TestProtoView, testLastOccurrenceWins)
+{
+    std::string data = serialize(test::TestStruct{{}, {}, 1}) + serialize(test::TestStruct{{}, {}, 2});
+    EXPECT_EQ(test::TestStructView(data.data(), data.size()).last_value(), 2u);
+}
+
+TEST(TestProtoView, testCorruptData)
+{
+    test::TestStruct value{test::TestInt32{-5}, test::TestString{"hello"}, 7};
+    std::string data = serialize(value);
+    data.resize(data.size() - 3);
+
+    test::TestStructView view(data.data(), data.size());
+    EXPECT_EQ(view.isValid(), false);
+    EXPECT_EQ(view.struct_int32().value(), -5);
+    EXPECT_EQ(view.last_value(), 0u);
+}
@@ -71,19 +71,12 @@ protected:
         m_mockOperatingSystem = new MockIOperatingSystem;
         OperatingSystem::setInstance(std::unique_ptr<IOperatingSystem>(m_mockOperatingSystem));
 
-        EXPECT_CALL(*m_mockOperatingSystem, socket(0, 0, 0)).WillOnce(Return(3));
-        EXPECT_CALL(*m_mockOperatingSystem, setNonBlocking(3, true)).WillOnce(Return(3));
-        EXPECT_CALL(*m_mockOperatingSystem, setLinger(3, true, 0)).WillOnce(Return(3));
-        m_socket->create(0, 0, 0);
-
         m_protocol = std::make_shared<ProtocolDelimiterTest>();
         m_protocol->setCallback(m_mockCallback);
     }
 
     virtual void TearDown()
     {
-        EXPECT_CALL(*m_mockOperatingSystem, closeSocket(m_socket->getSocketDescriptor()->getDescriptor())).WillOnce(Return(0));
-        m_socket = nullptr;
         OperatingSystem::setInstance({});   // destroy the mock
         if (m_protocol->getConnection())
         {
@@ -96,7 +89,6 @@ protected:
     IProtocolPtr                            m_protocol = nullptr;
     std::shared_ptr<MockIProtocolCallback>  m_mockCallback = std::make_shared<MockIProtocolCallback>();
     std::shared_ptr<MockIStreamConnection>  m_mockStreamConnection = std::make_shared<MockIStreamConnection>();
-    std::shared_ptr<Socket>                 m_socket = std::make_shared<Socket>();
 };
 
 
@@ -106,18 +98,15 @@ TEST_F(TestProtocolDelimiter, testReceiveByteByByte)
     EXPECT_CALL(*m_mockCallback, received(_, _)).Times(0);
     std::string receiveBuffer = "H";
     int size = receiveBuffer.size();
-    EXPECT_CALL(*m_mockOperatingSystem, recv(_, _, size, 0)).Times(1).WillOnce(DoAll(SetArrayArgument<1>(receiveBuffer.data(), receiveBuffer.data() + size), Return(size)));
-    m_protocol->received(nullptr, m_socket, size);
+    m_protocol->received(nullptr, receiveBuffer.data(), size);
 
     receiveBuffer = "l";
     size = receiveBuffer.size();
-    EXPECT_CALL(*m_mockOperatingSystem, recv(_, _, size, 0)).Times(1).WillOnce(DoAll(SetArrayArgument<1>(receiveBuffer.data(), receiveBuffer.data() + size), Return(size)));
-    m_protocol->received(nullptr, m_socket, size);
+    m_protocol->received(nullptr, receiveBuffer.data(), size);
 
     receiveBuffer = "o";
     size = receiveBuffer.size();
-    EXPECT_CALL(*m_mockOperatingSystem, recv(_, _, size, 0)).Times(1).WillOnce(DoAll(SetArrayArgument<1>(receiveBuffer.data(), receiveBuffer.data() + size), Return(size)));
-    m_protocol->received(nullptr, m_socket, size);
+    m_protocol->received(nullptr, receiveBuffer.data(), size);
 
     std::shared_ptr<IMessage> message = std::make_shared<ProtocolMessage>(0);
     message->resizeReceiveBuffer(1);
@@ -125,31 +114,26 @@ TEST_F(TestProtocolDelimiter, testReceiveByteByByte)
     EXPECT_CALL(*m_mockCallback, received(MatcherReceiveMessage(message), _)).Times(1);
     receiveBuffer = "l";
     size = receiveBuffer.size();
-    EXPECT_CALL(*m_mockOperatingSystem, recv(_, _, size, 0)).Times(1).WillOnce(DoAll(SetArrayArgument<1>(receiveBuffer.data(), receiveBuffer.data() + size), Return(size)));
-    m_protocol->received(nullptr, m_socket, size);
+    m_protocol->received(nullptr, receiveBuffer.data(), size);
 
     receiveBuffer = "Ha";
     size = receiveBuffer.size();
-    EXPECT_CALL(*m_mockOperatingSystem, recv(_, _, size, 0)).Times(1).WillOnce(DoAll(SetArrayArgument<1>(receiveBuffer.data(), receiveBuffer.data() + size), Return(size)));
-    m_protocol->received(nullptr, m_socket, size);
+    m_protocol->received(nullptr, receiveBuffer.data(), size);
 
     receiveBuffer = "l";
     size = receiveBuffer.size();
-    EXPECT_CALL(*m_mockOperatingSystem, recv(_, _, size, 0)).Times(1).WillOnce(DoAll(SetArrayArgument<1>(receiveBuffer.data(), receiveBuffer.data() + size), Return(size)));
-    m_protocol->received(nullptr, m_socket, size);
+    m_protocol->received(nullptr, receiveBuffer.data(), size);
 
     receiveBuffer = "o";
     size = receiveBuffer.size();
-    EXPECT_CALL(*m_mockOperatingSystem, recv(_, _, size, 0)).Times(1).WillOnce(DoAll(SetArrayArgument<1>(receiveBuffer.data(), receiveBuffer.data() + size), Return(size)));
-    m_protocol->received(nullptr, m_socket, size);
+    m_protocol->received(nullptr, receiveBuffer.data(), size);
 
     message->resizeReceiveBuffer(2);
     memcpy(message->getReceivePayload().first, "Ha", 2);
     EXPECT_CALL(*m_mockCallback, received(MatcherReceiveMessage(message), _)).Times(1);
     receiveBuffer = "l";
     size = receiveBuffer.size();
-    EXPECT_CALL(*m_mockOperatingSystem, recv(_, _, size, 0)).Times(1).WillOnce(DoAll(SetArrayArgument<1>(receiveBuffer.data(), receiveBuffer.data() + size), Return(size)));
-    m_protocol->received(nullptr, m_socket, size);
+    m_protocol->received(nullptr, receiveBuffer.data(), size);
 }
 
 TEST_F(TestProtocolDelimiter, testReceive)
@@ -160,23 +144,19 @@ TEST_F(TestProtocolDelimiter, testReceive)
     EXPECT_CALL(*m_mockCallback, received(MatcherReceiveMessage(message1), _)).Times(1);
     std::string receiveBuffer = "AlolB";
     int size = receiveBuffer.size();
-    EXPECT_CALL(*m_mockOperatingSystem, recv(_, _, size, 0)).Times(1).WillOnce(DoAll(SetArrayArgument<1>(receiveBuffer.data(), receiveBuffer.data() + size), Return(size)));
-    m_protocol->received(nullptr, m_socket, size);
+    m_protocol->received(nullptr, receiveBuffer.data(), size);
 
     receiveBuffer = "CD";
     size = receiveBuffer.size();
-    EXPECT_CALL(*m_mockOperatingSystem, recv(_, _, size, 0)).Times(1).WillOnce(DoAll(SetArrayArgument<1>(receiveBuffer.data(), receiveBuffer.data() + size), Return(size)));
-    m_protocol->received(nullptr, m_socket, size);
+    m_protocol->received(nullptr, receiveBuffer.data(), size);
 
     receiveBuffer = "EF";
     size = receiveBuffer.size();
-    EXPECT_CALL(*m_mockOperatingSystem, recv(_, _, size, 0)).Times(1).WillOnce(DoAll(SetArrayArgument<1>(receiveBuffer.data(), receiveBuffer.data() + size), Return(size)));
-    m_protocol->received(nullptr, m_socket, size);
+    m_protocol->received(nullptr, receiveBuffer.data(), size);
 
     receiveBuffer = "Gl";
     size = receiveBuffer.size();
-    EXPECT_CALL(*m_mockOperatingSystem, recv(_, _, size, 0)).Times(1).WillOnce(DoAll(SetArrayArgument<1>(receiveBuffer.data(), receiveBuffer.data() + size), Return(size)));
-    m_protocol->received(nullptr, m_socket, size);
+    m_protocol->received(nullptr, receiveBuffer.data(), size);
 
     std::shared_ptr<IMessage> message2 = std::make_shared<ProtocolMessage>(0);
     message2->resizeReceiveBuffer(6);
@@ -184,7 +164,45 @@ TEST_F(TestProtocolDelimiter, testReceive)
     EXPECT_CALL(*m_mockCallback, received(MatcherReceiveMessage(message2), _)).Times(1);
     receiveBuffer = "ol";
     size = receiveBuffer.size();
-    EXPECT_CALL(*m_mockOperatingSystem, recv(_, _, size, 0)).Times(1).WillOnce(DoAll(SetArrayArgument<1>(receiveBuffer.data(), receiveBuffer.data() + size), Return(size)));
-    m_protocol->received(nullptr, m_socket, size);
+    m_protocol->received(nullptr, receiveBuffer.data(), size);
 }
 
+
+TEST_F(TestProtocolDelimiter, testReceiveZeroCopyAndBigMessage)
+{
+    std::vector<IMessagePtr> messages;
+    EXPECT_CALL(*m_mockCallback, received(_, _)).WillRepeatedly(Invoke([&messages](const IMessagePtr& message, std::int64_t /*connectionId*/) {
+        messages.push_back(message);
+    }));
+
+    std::string receiveBuffer = "AlolBlolC";
+    int size = receiveBuffer.size();
+    m_protocol->received(nullptr, receiveBuffer.data(), size);
+
+    ASSERT_EQ(messages.size(), 2);
+    EXPECT_EQ(std::string(messages[0]->getReceivePayload().first, messages[0]->getReceivePayload().second), "A");
+    EXPECT_EQ(std::string(messages[1]->getReceivePayload().first, messages[1]->getReceivePayload().second), "B");
+    // both messages reference the same receive buffer
+    EXPECT_EQ(messages[0]->getReceivePayload().first + 4, messages[1]->getReceivePayload().first);
+
+    // a message that is bigger than one receive buffer
+    std::string expected = "C";
+    receiveBuffer = std::string(50000, 'x');
+    size = receiveBuffer.size();
+    for (int i = 0; i < 3; ++i)
+    {
+        expected += receiveBuffer;
+        m_protocol->received(nullptr, receiveBuffer.data(), size);
+    }
+    EXPECT_EQ(messages.size(), 2);
+
+    receiveBuffer = "yylolz";
+    expected += "yy";
+    size = receiveBuffer.size();
+    m_protocol->received(nullptr, receiveBuffer.data(), size);
+
+    ASSERT_EQ(messages.size(), 3);
+    EXPECT_EQ(std::string(messages[2]->getReceivePayload().first, messages[2]->getReceivePayload().second), expected);
+    // the earlier messages are still valid
+    EXPECT_EQ(std::string(messages[0]->getReceivePayload().first, messages[0]->getReceivePayload().second), "A");
+}
@@ -29,6 +29,8 @@
 #include "finalmq/helpers/OperatingSystem.h"
 #include "finalmq/streamconnection/Socket.h"
 
+#include <sys/stat.h>
+
 #include "MockIOperatingSystem.h"
 #include "MockIStreamConnection.h"
 #include "matchers.h"
@@ -51,11 +53,6 @@ protected:
         m_mockOperatingSystem = new MockIOperatingSystem;
         OperatingSystem::setInstance(std::unique_ptr<IOperatingSystem>(m_mockOperatingSystem));
 
-        EXPECT_CALL(*m_mockOperatingSystem, socket(0, 0, 0)).WillOnce(Return(3));
-        EXPECT_CALL(*m_mockOperatingSystem, setNonBlocking(3, true)).WillOnce(Return(3));
-        EXPECT_CALL(*m_mockOperatingSystem, setLinger(3, true, 0)).WillOnce(Return(3));
-        m_socket->create(0, 0, 0);
-
         m_protocol = std::make_shared<ProtocolHttpServer>();
         EXPECT_CALL(*m_mockCallback, setActivityTimeout(_));
         m_protocol->setCallback(m_mockCallback);
@@ -63,8 +60,6 @@ protected:
 
     virtual void TearDown()
     {
-        EXPECT_CALL(*m_mockOperatingSystem, closeSocket(m_socket->getSocketDescriptor()->getDescriptor())).WillOnce(Return(0));
-        m_socket = nullptr;
         OperatingSystem::setInstance({});   // destroy the mock
         if (m_protocol->getConnection())
         {
@@ -77,7 +72,6 @@ protected:
     IProtocolPtr                            m_protocol = nullptr;
     std::shared_ptr<MockIProtocolCallback>  m_mockCallback = std::make_shared<MockIProtocolCallback>();
     std::shared_ptr<MockIStreamConnection>  m_mockStreamConnection = std::make_shared<MockIStreamConnection>();
-    std::shared_ptr<Socket>                 m_socket = std::make_shared<Socket>();
 };
 
 
@@ -88,8 +82,7 @@ TEST_F(TestProtocolHttpServer, testReceiveFirstLineIncomplete)
     EXPECT_CALL(*m_mockCallback, disconnected()).Times(0);
     std::string receiveBuffer = "GET /hello HTTP/1.1\r";
     int size = receiveBuffer.size();
-    EXPECT_CALL(*m_mockOperatingSystem, recv(_, _, size, 0)).Times(1).WillOnce(DoAll(SetArrayArgument<1>(receiveBuffer.data(), receiveBuffer.data()+size), Return(size)));
-    m_protocol->received(nullptr, m_socket, size);
+    m_protocol->received(nullptr, receiveBuffer.data(), size);
 }
 
 
@@ -100,13 +93,11 @@ TEST_F(TestProtocolHttpServer, testReceiveFirstLineComplete)
 
     std::string receiveBuffer1 = "GET /hello HTTP/1.1\r";
     int size1 = receiveBuffer1.size();
-    EXPECT_CALL(*m_mockOperatingSystem, recv(_, _, size1, 0)).Times(1).WillOnce(DoAll(SetArrayArgument<1>(receiveBuffer1.data(), receiveBuffer1.data() + size1), Return(size1)));
-    m_protocol->received(nullptr, m_socket, size1);
+    m_protocol->received(nullptr, receiveBuffer1.data(), size1);
 
     std::string receiveBuffer2 = "\n";
     int size2 = receiveBuffer2.size();
-    EXPECT_CALL(*m_mockOperatingSystem, recv(_, _, size2, 0)).Times(1).WillOnce(DoAll(SetArrayArgument<1>(receiveBuffer2.data(), receiveBuffer2.data() + size2), Return(size2)));
-    m_protocol->received(nullptr, m_socket, size2);
+    m_protocol->received(nullptr, receiveBuffer2.data(), size2);
 }
 
 
@@ -117,13 +108,11 @@ TEST_F(TestProtocolHttpServer, testReceiveHeaders)
 
     std::string receiveBuffer1 = "GET /hello?filter=world&lang=en HTTP/1.1\r\nhello: ";
     int size1 = receiveBuffer1.size();
-    EXPECT_CALL(*m_mockOperatingSystem, recv(_, _, size1, 0)).Times(1).WillOnce(DoAll(SetArrayArgument<1>(receiveBuffer1.data(), receiveBuffer1.data() + size1), Return(size1)));
-    m_protocol->received(nullptr, m_socket, size1);
+    m_protocol->received(nullptr, receiveBuffer1.data(), size1);
 
     std::string receiveBuffer2 = "123\r\n";
     int size2 = receiveBuffer2.size();
-    EXPECT_CALL(*m_mockOperatingSystem, recv(_, _, size2, 0)).Times(1).WillOnce(DoAll(SetArrayArgument<1>(receiveBuffer2.data(), receiveBuffer2.data() + size2), Return(size2)));
-    m_protocol->received(nullptr, m_socket, size2);
+    m_protocol->received(nullptr, receiveBuffer2.data(), size2);
 
     std::shared_ptr<IMessage> message = std::make_shared<ProtocolMessage>(0);
     IMessage::Metainfo& metainfo = message->getAllMetainfo();
@@ -140,8 +129,42 @@ TEST_F(TestProtocolHttpServer, testReceiveHeaders)
     int size3 = receiveBuffer3.size();
     m_protocol->setConnection(m_mockStreamConnection);
     EXPECT_CALL(*m_mockCallback, setSessionName(_, _, _)).Times(1);
-    EXPECT_CALL(*m_mockOperatingSystem, recv(_, _, size3, 0)).Times(1).WillOnce(DoAll(SetArrayArgument<1>(receiveBuffer3.data(), receiveBuffer3.data() + size3), Return(size3)));
-    m_protocol->received(nullptr, m_socket, size3);
+    m_protocol->received(nullptr, receiveBuffer3.data(), size3);
+}
+
+TEST_F(TestProtocolHttpServer, testReceiveEncodedPathQueryAndHeaderWhitespace)
+{
+    EXPECT_CALL(*m_mockCallback, disconnected()).Times(0);
+
+    std::shared_ptr<IMessage> message = std::make_shared<ProtocolMessage>(0);
+    IMessage::Metainfo& metainfo = message->getAllMetainfo();
+    metainfo[ProtocolHttpServer::FMQ_HTTP] = "request";
+    metainfo[ProtocolHttpServer::FMQ_METHOD] = "GET";
+    metainfo[ProtocolHttpServer::FMQ_PATH] = "/hello world";
+    metainfo[ProtocolHttpServer::FMQ_QUERY_PREFIX + "a=b"] = "c&d";
+    metainfo[ProtocolHttpServer::FMQ_QUERY_PREFIX + "flag"] = "";
+    metainfo[ProtocolHttpServer::FMQ_PROTOCOL] = "HTTP/1.1";
+
+    message->addMetainfo("hello", "1 2 3");
+    message->addMetainfo("empty", "");
+    EXPECT_CALL(*m_mockCallback, received(MatcherReceiveMessage(message), _)).Times(1);
+
+    std::string receiveBuffer1 = "GET /hello%20world?a%3Db=c%26d&flag HTTP/1.1\r\nhello:  \t1 2 3 \t\r\nempty\r\n\r\n";
+    int size1 = receiveBuffer1.size();
+    m_protocol->setConnection(m_mockStreamConnection);
+    EXPECT_CALL(*m_mockCallback, setSessionName(_, _, _)).Times(1);
+    m_protocol->received(nullptr, receiveBuffer1.data(), size1);
+}
+
+TEST_F(TestProtocolHttpServer, testReceiveInvalidRequestLine)
+{
+    EXPECT_CALL(*m_mockCallback, received(_, _)).Times(0);
+
+    std::string receiveBuffer1 = "GET /hello\r\n";
+    int size1 = receiveBuffer1.size();
+    m_protocol->setConnection(m_mockStreamConnection);
+    bool ok = m_protocol->received(nullptr, receiveBuffer1.data(), size1);
+    ASSERT_EQ(ok, false);
 }
 
 TEST_F(TestProtocolHttpServer, testReceivePayload)
@@ -165,9 +188,8 @@ TEST_F(TestProtocolHttpServer, testReceivePayload)
     std::string receiveBuffer1 = "GET /hello?filter=world&lang=en HTTP/1.1\r\nContent-Length: 10\r\n\r\n0123456789";
     int size1 = receiveBuffer1.size();
     m_protocol->setConnection(m_mockStreamConnection);
-    EXPECT_CALL(*m_mockOperatingSystem, recv(_, _, size1, 0)).Times(1).WillOnce(DoAll(SetArrayArgument<1>(receiveBuffer1.data(), receiveBuffer1.data() + size1), Return(size1)));
     EXPECT_CALL(*m_mockCallback, setSessionName(_, _, _)).Times(1);
-    m_protocol->received(nullptr, m_socket, size1);
+    m_protocol->received(nullptr, receiveBuffer1.data(), size1);
 }
 
 TEST_F(TestProtocolHttpServer, testReceiveSplitPayload)
@@ -178,9 +200,8 @@ TEST_F(TestProtocolHttpServer, testReceiveSplitPayload)
     std::string receiveBuffer1 = "GET /hello?filter=world&lang=en HTTP/1.1\r\nContent-Length: 10\r\n\r\n0123456";
     int size1 = receiveBuffer1.size();
     m_protocol->setConnection(m_mockStreamConnection);
-    EXPECT_CALL(*m_mockOperatingSystem, recv(_, _, size1, 0)).Times(1).WillOnce(DoAll(SetArrayArgument<1>(receiveBuffer1.data(), receiveBuffer1.data() + size1), Return(size1)));
     EXPECT_CALL(*m_mockCallback, setSessionName(_, _, _)).Times(1);
-    m_protocol->received(nullptr, m_socket, size1);
+    m_protocol->received(nullptr, receiveBuffer1.data(), size1);
 
     std::shared_ptr<IMessage> message = std::make_shared<ProtocolMessage>(0);
     IMessage::Metainfo& metainfo = message->getAllMetainfo();
@@ -198,37 +219,70 @@ TEST_F(TestProtocolHttpServer, testReceiveSplitPayload)
 
     std::string receiveBuffer2 = "789";
     int size2 = receiveBuffer2.size();
-    EXPECT_CALL(*m_mockOperatingSystem, recv(_, _, size2, 0)).Times(1).WillOnce(DoAll(SetArrayArgument<1>(receiveBuffer2.data(), receiveBuffer2.data() + size2), Return(size2)));
-    m_protocol->received(nullptr, m_socket, size2);
+    m_protocol->received(nullptr, receiveBuffer2.data(), size2);
 }
 
 
-TEST_F(TestProtocolHttpServer, testReceivePayloadTooBig)
+TEST_F(TestProtocolHttpServer, testReceivePipelinedRequests)
 {
-    EXPECT_CALL(*m_mockCallback, received(_, _)).Times(0);
+    EXPECT_CALL(*m_mockCallback, disconnected()).Times(0);
+
+    std::shared_ptr<IMessage> message1 = std::make_shared<ProtocolMessage>(0);
+    IMessage::Metainfo& metainfo1 = message1->getAllMetainfo();
+    metainfo1[ProtocolHttpServer::FMQ_HTTP] = "request";
+    metainfo1[ProtocolHttpServer::FMQ_METHOD] = "GET";
+    metainfo1[ProtocolHttpServer::FMQ_PATH] = "/hello";
+    metainfo1[ProtocolHttpServer::FMQ_PROTOCOL] = "HTTP/1.1";
+    message1->addMetainfo("Content-Length", "10");
+    message1->resizeReceiveBuffer(10);
+    memcpy(message1->getReceivePayload().first, "0123456789", 10);
+
+    std::shared_ptr<IMessage> message2 = std::make_shared<ProtocolMessage>(0);
+    IMessage::Metainfo& metainfo2 = message2->getAllMetainfo();
+    metainfo2[ProtocolHttpServer::FMQ_HTTP] = "request";
+    metainfo2[ProtocolHttpServer::FMQ_METHOD] = "GET";
+    metainfo2[ProtocolHttpServer::FMQ_PATH] = "/world";
+    metainfo2[ProtocolHttpServer::FMQ_PROTOCOL] = "HTTP/1.1";
 
-    std::string receiveBuffer1 = "GET /hello?filter=world&lang=en HTTP/1.1\r\nContent-Length: 10\r\n\r\n01234567890";
+    {
+        testing::InSequence seq;
+        EXPECT_CALL(*m_mockCallback, received(MatcherReceiveMessage(message1), _)).Times(1);
+        EXPECT_CALL(*m_mockCallback, received(MatcherReceiveMessage(message2), _)).Times(1);
+    }
+
+    std::string receiveBuffer1 = "GET /hello HTTP/1.1\r\nContent-Length: 10\r\n\r\n0123456789GET /world HTTP/1.1\r\n\r\nGET /nex";
     int size1 = receiveBuffer1.size();
     m_protocol->setConnection(m_mockStreamConnection);
-    EXPECT_CALL(*m_mockOperatingSystem, recv(_, _, size1, 0)).Times(1).WillOnce(DoAll(SetArrayArgument<1>(receiveBuffer1.data(), receiveBuffer1.data() + size1), Return(size1)));
-    bool ok = m_protocol->received(nullptr, m_socket, size1);
-    ASSERT_EQ(ok, false);
+    EXPECT_CALL(*m_mockCallback, setSessionName(_, _, _)).Times(2);
+    bool ok = m_protocol->received(nullptr, receiveBuffer1.data(), size1);
+    ASSERT_EQ(ok, true);
 }
 
-TEST_F(TestProtocolHttpServer, testReceiveSplitPayloadTooBig)
+TEST_F(TestProtocolHttpServer, testReceiveSplitPayloadFollowedByNextRequest)
 {
     std::string receiveBuffer1 = "GET /hello?filter=world&lang=en HTTP/1.1\r\nContent-Length: 10\r\n\r\n0123456";
     int size1 = receiveBuffer1.size();
     m_protocol->setConnection(m_mockStreamConnection);
-    EXPECT_CALL(*m_mockOperatingSystem, recv(_, _, size1, 0)).Times(1).WillOnce(DoAll(SetArrayArgument<1>(receiveBuffer1.data(), receiveBuffer1.data() + size1), Return(size1)));
-    bool ok = m_protocol->received(nullptr, m_socket, size1);
+    bool ok = m_protocol->received(nullptr, receiveBuffer1.data(), size1);
     ASSERT_EQ(ok, true);
 
-    EXPECT_CALL(*m_mockCallback, received(_, _)).Times(0);
+    EXPECT_CALL(*m_mockCallback, received(_, _)).Times(1);
+    EXPECT_CALL(*m_mockCallback, setSessionName(_, _, _)).Times(1);
 
-    std::string receiveBuffer2 = "7890";
+    // the rest of the body is received into the payload, the following bytes are the begin of the next request
+    std::string receiveBuffer2 = "789";
+    std::string receiveBuffer3 = "GET /world";
     int size2 = receiveBuffer2.size();
-    ok = m_protocol->received(nullptr, m_socket, size2);
+    int size3 = receiveBuffer3.size();
+    std::string receiveBuffer23 = receiveBuffer2 + receiveBuffer3;
+    ok = m_protocol->received(nullptr, receiveBuffer23.data(), size2 + size3);
+    ASSERT_EQ(ok, true);
+
+    // an invalid request line after the body is still detected
+    EXPECT_CALL(*m_mockCallback, received(_, _)).Times(0);
+    std::string receiveBuffer4 = "\r\n";
+    int size4 = receiveBuffer4.size();
+    ok = m_protocol->received(nullptr, receiveBuffer4.data(), size4);
     ASSERT_EQ(ok, false);
 }
 
@@ -263,3 +317,41 @@ TEST_F(TestProtocolHttpServer, testSendMessage)
     ASSERT_EQ(memcmp(it2->first, PAYLOAD.data(), PAYLOAD.size()), 0);
 }
 
+
+
+TEST_F(TestProtocolHttpServer, testSendFileTransfer)
+{
+    static const int FD_FILE = 7;
+    static const int FILE_SIZE = 12345;
+
+    std::shared_ptr<IMessage> message = std::make_shared<ProtocolMessage>(0);
+    Variant& controlData = message->getControlData();
+    controlData.add("filetransfer", std::string("index.html"));
+
+    EXPECT_CALL(*m_mockOperatingSystem, open(testing::StrEq("index.html"), _, _)).WillOnce(Return(FD_FILE));
+    EXPECT_CALL(*m_mockOperatingSystem, fstat(FD_FILE, _)).WillOnce(Invoke([](int /*fd*/, struct stat* buf) {
+        buf->st_size = FILE_SIZE;
+        return 0;
+    }));
+    EXPECT_CALL(*m_mockStreamConnection, sendMessage(_));
+    m_protocol->setConnection(m_mockStreamConnection);
+    m_protocol->sendMessage(message);
+
+    // only the header is inside the buffers, the file follows as a file region
+    const std::list<BufferRef>& buffers = message->getAllSendBuffers();
+    ASSERT_EQ(buffers.size(), 1);
+    static const std::string HEADERS = "HTTP/1.1 200 OK\r\nConnection: keep-alive\r\nContent-Length: 12345\r\n\r\n";
+    ASSERT_EQ(buffers.front().second, HEADERS.size());
+    ASSERT_EQ(memcmp(buffers.front().first, HEADERS.data(), HEADERS.size()), 0);
+
+    const FileRegionPtr& file = message->getSendFile();
+    ASSERT_NE(file, nullptr);
+    EXPECT_EQ(file->getDescriptor(), FD_FILE);
+    EXPECT_EQ(file->getOffset(), 0);
+    EXPECT_EQ(file->getSize(), FILE_SIZE);
+
+    // the file is closed together with the message
+    EXPECT_CALL(*m_mockOperatingSystem, close(FD_FILE)).WillOnce(Return(0));
+    message = nullptr;
+}
+
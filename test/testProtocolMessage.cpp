@@ -25,6 +25,7 @@
 
 
 #include "finalmq/protocolsession/ProtocolMessage.h"
+#include "finalmq/protocolsession/ProtocolMessagePool.h"
 
 
 //using ::testing::_;
@@ -702,3 +703,152 @@ TEST_F(TestProtocolMessage, addSendHeaderAndRemoveItWithoutPayload)
     ASSERT_EQ(totalSendPayloadSize, 0);
 }
 
+
+
+
+TEST_F(TestProtocolMessage, poolRecyclesMessage)
+{
+    IMessagePtr message = ProtocolMessagePool::createMessage(PROTOCOL_ID, SIZE_HEADER, SIZE_TRAILER);
+    char* receiveBuffer = message->resizeReceiveBuffer(100);
+    message->addSendPayload(std::string("hello"));
+    message->addSendHeader(std::string("header"));
+    message->addMetainfo("key", "value");
+    message->getControlData().add("data", 5);
+    IMessage* messageRaw = message.get();
+    message = nullptr;
+
+    ProtocolMessagePool::resetStatistics();
+    IMessagePtr messageRecycled = ProtocolMessagePool::createMessage(0, 4);
+    ProtocolMessagePoolStatistics statistics = ProtocolMessagePool::getStatistics();
+    ASSERT_EQ(statistics.hits, 1);
+    ASSERT_EQ(statistics.misses, 0);
+    ASSERT_EQ(messageRecycled.get(), messageRaw);
+
+    ASSERT_EQ(messageRecycled->getProtocolId(), 0);
+    ASSERT_EQ(messageRecycled->wasSent(), false);
+    ASSERT_EQ(messageRecycled->getAllMetainfo().size(), 0);
+    ASSERT_EQ(messageRecycled->getControlDataIfAvailable(), nullptr);
+    ASSERT_EQ(messageRecycled->getAllSendBuffers().size(), 0);
+    ASSERT_EQ(messageRecycled->getTotalSendBufferSize(), 0);
+    ASSERT_EQ(messageRecycled->getTotalSendPayloadSize(), 0);
+
+    // the receive buffer is reused
+    ASSERT_EQ(messageRecycled->resizeReceiveBuffer(50), receiveBuffer);
+    ASSERT_EQ(messageRecycled->getReceiveHeader().second, 4);
+
+    char* payload = messageRecycled->addSendPayload(3);
+    memcpy(payload, "abc", 3);
+    const std::list<BufferRef>& sendBuffers = messageRecycled->getAllSendBuffers();
+    ASSERT_EQ(sendBuffers.size(), 1);
+    ASSERT_EQ(sendBuffers.front().second, 4 + 3);
+    ASSERT_EQ(std::string(sendBuffers.front().first + 4, 3), "abc");
+}
+
+TEST_F(TestProtocolMessage, poolDoesNotReuseSharedReceiveBuffer)
+{
+    std::shared_ptr<std::string> buffer = std::make_shared<std::string>("0123456789");
+    IMessagePtr message = ProtocolMessagePool::createMessage(PROTOCOL_ID);
+    message->setReceiveBuffer(buffer, 2, 5);
+    message = nullptr;
+
+    IMessagePtr messageRecycled = ProtocolMessagePool::createMessage(PROTOCOL_ID);
+    ASSERT_EQ(buffer.use_count(), 1);
+    char* receiveBuffer = messageRecycled->resizeReceiveBuffer(5);
+    ASSERT_NE(receiveBuffer, buffer->data() + 2);
+    ASSERT_EQ(*buffer, "0123456789");
+}
+
+TEST_F(TestProtocolMessage, addSendPayloadShared)
+{
+    std::shared_ptr<const std::string> shared = std::make_shared<const std::string>("0123456789");
+    ProtocolMessage message(PROTOCOL_ID, SIZE_HEADER, SIZE_TRAILER);
+    IMessage& imessage = message;
+    imessage.addSendPayload(shared);
+
+    const std::list<BufferRef>& sendBuffers = imessage.getAllSendBuffers();
+    const std::list<BufferRef>& sendPayloads = imessage.getAllSendPayloads();
+    ASSERT_EQ(imessage.getTotalSendBufferSize(), 10 + SIZE_HEADER + SIZE_TRAILER);
+    ASSERT_EQ(imessage.getTotalSendPayloadSize(), 10);
+    ASSERT_EQ(shared.use_count(), 2);
+
+    ASSERT_EQ(sendBuffers.size(), 3);
+    auto itBuffers = sendBuffers.begin();
+    ASSERT_EQ(itBuffers->second, SIZE_HEADER);
+    ++itBuffers;
+    ASSERT_EQ(itBuffers->first, shared->data());
+    ASSERT_EQ(itBuffers->second, 10);
+    ++itBuffers;
+    ASSERT_EQ(itBuffers->second, SIZE_TRAILER);
+
+    ssize_t sizePayloads = 0;
+    for (const BufferRef& payload : sendPayloads)
+    {
+        sizePayloads += payload.second;
+    }
+    ASSERT_EQ(sizePayloads, 10);
+    ASSERT_EQ(*shared, "0123456789");
+}
+
+TEST_F(TestProtocolMessage, addSendPayloadSharedBetweenOwnPayloads)
+{
+    std::shared_ptr<const std::string> shared = std::make_shared<const std::string>("0123456789");
+    ProtocolMessage message(PROTOCOL_ID, SIZE_HEADER, SIZE_TRAILER);
+    IMessage& imessage = message;
+    imessage.addSendPayload(std::string("abc"));
+    imessage.addSendPayload(shared);
+    imessage.addSendPayload(std::string("xyz"));
+
+    ASSERT_EQ(imessage.getTotalSendBufferSize(), 16 + SIZE_HEADER + SIZE_TRAILER);
+    ASSERT_EQ(imessage.getTotalSendPayloadSize(), 16);
+
+    std::string payload;
+    for (const BufferRef& ref : imessage.getAllSendPayloads())
+    {
+        payload.append(ref.first, ref.second);
+    }
+    ASSERT_EQ(payload, "abc0123456789xyz");
+
+    const std::list<BufferRef>& sendBuffers = imessage.getAllSendBuffers();
+    ssize_t sizeBuffers = 0;
+    for (const BufferRef& ref : sendBuffers)
+    {
+        sizeBuffers += ref.second;
+    }
+    ASSERT_EQ(sizeBuffers, imessage.getTotalSendBufferSize());
+    ASSERT_EQ(sendBuffers.front().second, SIZE_HEADER + 3);
+    ASSERT_EQ(sendBuffers.back().second, 3 + SIZE_TRAILER);
+}
+
+TEST_F(TestProtocolMessage, poolReleasesSharedPayload)
+{
+    std::shared_ptr<const std::string> shared = std::make_shared<const std::string>("0123456789");
+    IMessagePtr message = ProtocolMessagePool::createMessage(PROTOCOL_ID, SIZE_HEADER, SIZE_TRAILER);
+    message->addSendPayload(shared);
+    ASSERT_EQ(shared.use_count(), 2);
+    message = nullptr;
+    ASSERT_EQ(shared.use_count(), 1);
+}
+
+TEST_F(TestProtocolMessage, addSendPayloadSharedRegionOfReceiveBuffer)
+{
+    ProtocolMessage messageReceivedImpl(PROTOCOL_ID, 4);
+    IMessage& messageReceived = messageReceivedImpl;
+    char* receiveBuffer = messageReceived.resizeReceiveBuffer(4 + 5);
+    memcpy(receiveBuffer, "HEADhello", 9);
+    std::shared_ptr<const std::string> buffer = messageReceived.getReceiveBuffer();
+    ASSERT_EQ(buffer->data(), receiveBuffer);
+    BufferRef payload = messageReceived.getReceivePayload();
+
+    ProtocolMessage message(PROTOCOL_ID, SIZE_HEADER, SIZE_TRAILER);
+    IMessage& imessage = message;
+    imessage.addSendPayload(buffer, payload.first - buffer->data(), payload.second);
+
+    ASSERT_EQ(imessage.getTotalSendBufferSize(), 5 + SIZE_HEADER + SIZE_TRAILER);
+    ASSERT_EQ(imessage.getTotalSendPayloadSize(), 5);
+    const std::list<BufferRef>& sendBuffers = imessage.getAllSendBuffers();
+    ASSERT_EQ(sendBuffers.size(), 3);
+    auto itBuffers = sendBuffers.begin();
+    ++itBuffers;
+    ASSERT_EQ(itBuffers->first, receiveBuffer + 4);
+    ASSERT_EQ(itBuffers->second, 5);
+}
@@ -45,7 +45,6 @@ static const int CONTROLSOCKET_READ = 4;
 static const int CONTROLSOCKET_WRITE = 5;
 static const int TESTSOCKET = 7;
 
-static const int NUMBER_OF_BYTES_TO_READ = 20;
 static const int MILLITOMICRO = 1000;
 static const int TIMEOUT = 10;
 
@@ -143,8 +142,7 @@ TEST_F(TestSelect, testAddSocketReadableWait)
 #endif
     EXPECT_CALL(*m_mockMockOperatingSystem, select(sdMax, FdSet(&fdsReadIn), FdSet(&fdsWriteIn), FdSet(&fdsReadIn), Time(&tim))).Times(1)
                                                                   .WillRepeatedly(testing::DoAll(testing::SetArgPointee<1>(fdsRead), testing::SetArgPointee<3>(fdsError), Return(1)));
-    EXPECT_CALL(*m_mockMockOperatingSystem, ioctlInt(socket->getDescriptor(), FIONREAD, _)).Times(1)
-                                                        .WillRepeatedly(testing::DoAll(testing::SetArgPointee<2>(NUMBER_OF_BYTES_TO_READ), Return(0)));
+    EXPECT_CALL(*m_mockMockOperatingSystem, ioctlInt(_, _, _)).Times(0);
 
     const PollerResult& result = m_select->wait(TIMEOUT);
     EXPECT_EQ(result.error, false);
@@ -156,7 +154,6 @@ TEST_F(TestSelect, testAddSocketReadableWait)
         EXPECT_EQ(result.descriptorInfos[0].disconnected, false);
         EXPECT_EQ(result.descriptorInfos[0].readable, true);
         EXPECT_EQ(result.descriptorInfos[0].writable, false);
-        EXPECT_EQ(result.descriptorInfos[0].bytesToRead, NUMBER_OF_BYTES_TO_READ);
     }
 }
 
@@ -201,8 +198,7 @@ TEST_F(TestSelect, testAddSocketReadableEINTR)
     }
     EXPECT_CALL(*m_mockMockOperatingSystem, getLastError()).Times(1)
                         .WillOnce(Return(SOCKETERROR(EINTR)));
-    EXPECT_CALL(*m_mockMockOperatingSystem, ioctlInt(socket->getDescriptor(), FIONREAD, _)).Times(1)
-                                                        .WillRepeatedly(testing::DoAll(testing::SetArgPointee<2>(NUMBER_OF_BYTES_TO_READ), Return(0)));
+    EXPECT_CALL(*m_mockMockOperatingSystem, ioctlInt(_, _, _)).Times(0);
 
     const PollerResult& result = m_select->wait(TIMEOUT);
     EXPECT_EQ(result.error, false);
@@ -214,7 +210,6 @@ TEST_F(TestSelect, testAddSocketReadableEINTR)
         EXPECT_EQ(result.descriptorInfos[0].disconnected, false);
         EXPECT_EQ(result.descriptorInfos[0].readable, true);
         EXPECT_EQ(result.descriptorInfos[0].writable, false);
-        EXPECT_EQ(result.descriptorInfos[0].bytesToRead, NUMBER_OF_BYTES_TO_READ);
     }
 }
 
@@ -258,9 +253,7 @@ TEST_F(TestSelect, testAddSocketReleaseByControlSocket)
         EXPECT_CALL(*m_mockMockOperatingSystem, select(sdMax, FdSet(&fdsReadIn), FdSet(&fdsWriteIn), _, Time(&tim))).Times(1)
                             .WillOnce(Return(0));
     }
-    EXPECT_CALL(*m_mockMockOperatingSystem, ioctlInt(CONTROLSOCKET_READ, FIONREAD, _)).Times(1)
-                                                        .WillRepeatedly(testing::DoAll(testing::SetArgPointee<2>(1), Return(0)));
-    EXPECT_CALL(*m_mockMockOperatingSystem, recv(CONTROLSOCKET_READ, _, 1, 0)).Times(1)
+    EXPECT_CALL(*m_mockMockOperatingSystem, recv(CONTROLSOCKET_READ, _, _, 0)).Times(1)
                                                         .WillRepeatedly(Return(1));
 
     const PollerResult& result = m_select->wait(TIMEOUT);
@@ -350,8 +343,7 @@ TEST_F(TestSelect, testAddSocketReadableWaitSocketDescriptorsChanged)
                     Return(1)
                 )
             );
-    EXPECT_CALL(*m_mockMockOperatingSystem, ioctlInt(socket->getDescriptor(), FIONREAD, _)).Times(1)
-                                                        .WillRepeatedly(testing::DoAll(testing::SetArgPointee<2>(NUMBER_OF_BYTES_TO_READ), Return(0)));
+    EXPECT_CALL(*m_mockMockOperatingSystem, ioctlInt(_, _, _)).Times(0);
     EXPECT_CALL(*m_mockMockOperatingSystem, send(CONTROLSOCKET_WRITE, _, 1, 0)).Times(1)
                                                         .WillRepeatedly(Return(1));
 
@@ -367,7 +359,6 @@ TEST_F(TestSelect, testAddSocketReadableWaitSocketDescriptorsChanged)
         EXPECT_EQ(result.descriptorInfos[0].disconnected, false);
         EXPECT_EQ(result.descriptorInfos[0].readable, true);
         EXPECT_EQ(result.descriptorInfos[0].writable, false);
-        EXPECT_EQ(result.descriptorInfos[0].bytesToRead, NUMBER_OF_BYTES_TO_READ);
     }
 }
 
@@ -403,8 +394,7 @@ TEST_F(TestSelect, testAddSocketDisconnect)
 #endif
     EXPECT_CALL(*m_mockMockOperatingSystem, select(sdMax, FdSet(&fdsReadIn), FdSet(&fdsWriteIn), FdSet(&fdsReadIn), Time(&tim))).Times(1)
                                                                   .WillRepeatedly(testing::DoAll(testing::SetArgPointee<1>(fdsRead), testing::SetArgPointee<3>(fdsError), Return(1)));
-    EXPECT_CALL(*m_mockMockOperatingSystem, ioctlInt(socket->getDescriptor(), FIONREAD, _)).Times(1)
-                                                        .WillRepeatedly(testing::DoAll(testing::SetArgPointee<2>(0), Return(0)));
+    EXPECT_CALL(*m_mockMockOperatingSystem, ioctlInt(_, _, _)).Times(0);
 
     const PollerResult& result = m_select->wait(TIMEOUT);
     EXPECT_EQ(result.error, false);
@@ -416,60 +406,9 @@ TEST_F(TestSelect, testAddSocketDisconnect)
         EXPECT_EQ(result.descriptorInfos[0].disconnected, false);
         EXPECT_EQ(result.descriptorInfos[0].readable, true);
         EXPECT_EQ(result.descriptorInfos[0].writable, false);
-        EXPECT_EQ(result.descriptorInfos[0].bytesToRead, 0);
     }
 }
 
-TEST_F(TestSelect, testAddSocketIoCtlError)
-{
-    SocketDescriptorPtr socket = std::make_shared<SocketDescriptor>(TESTSOCKET);
-
-    EXPECT_CALL(*m_mockMockOperatingSystem, send(CONTROLSOCKET_WRITE, _, 1, 0)).Times(1)
-                                                        .WillRepeatedly(Return(1));
-    m_select->addSocketEnableRead(socket);
-
-    fd_set fdsReadIn{};
-    fd_set fdsWriteIn{};
-    FD_ZERO(&fdsReadIn);
-    FD_ZERO(&fdsWriteIn);
-    FD_SET(CONTROLSOCKET_READ, &fdsReadIn);
-    FD_SET(socket->getDescriptor(), &fdsReadIn);
-
-    timeval tim;
-    tim.tv_sec = 0;
-    tim.tv_usec = TIMEOUT * MILLITOMICRO;
-
-    fd_set fdsRead{};
-    FD_ZERO(&fdsRead);
-    FD_SET(socket->getDescriptor(), &fdsRead);
-
-    fd_set fdsError{};
-    FD_ZERO(&fdsError);
-
-    int sdMax = static_cast<int>(static_cast<int>(socket->getDescriptor())) + 1;
-#if defined(WIN32)
-    sdMax = 1;
-#endif
-    EXPECT_CALL(*m_mockMockOperatingSystem, select(sdMax, FdSet(&fdsReadIn), FdSet(&fdsWriteIn), FdSet(&fdsReadIn), Time(&tim))).Times(1)
-                                                                  .WillRepeatedly(testing::DoAll(testing::SetArgPointee<1>(fdsRead), testing::SetArgPointee<3>(fdsError), Return(1)));
-    EXPECT_CALL(*m_mockMockOperatingSystem, ioctlInt(socket->getDescriptor(), FIONREAD, _)).Times(1)
-                                                        .WillRepeatedly(testing::DoAll(testing::SetArgPointee<2>(0), Return(-1)));
-
-    const PollerResult& result = m_select->wait(TIMEOUT);
-    EXPECT_EQ(result.error, false);
-    EXPECT_EQ(result.timeout, false);
-    EXPECT_EQ(result.descriptorInfos.size(), 1);
-    if (result.descriptorInfos.size() == 1)
-    {
-        EXPECT_EQ(result.descriptorInfos[0].sd, socket->getDescriptor());
-        EXPECT_EQ(result.descriptorInfos[0].disconnected, false);
-        EXPECT_EQ(result.descriptorInfos[0].readable, true);
-        EXPECT_EQ(result.descriptorInfos[0].writable, false);
-        EXPECT_EQ(result.descriptorInfos[0].bytesToRead, 0);
-    }
-}
-
-
 TEST_F(TestSelect, testAddSocketWritableWait)
 {
     SocketDescriptorPtr socket = std::make_shared<SocketDescriptor>(TESTSOCKET);
@@ -521,7 +460,6 @@ TEST_F(TestSelect, testAddSocketWritableWait)
         EXPECT_EQ(result.descriptorInfos[0].disconnected, false);
         EXPECT_EQ(result.descriptorInfos[0].readable, false);
         EXPECT_EQ(result.descriptorInfos[0].writable, true);
-        EXPECT_EQ(result.descriptorInfos[0].bytesToRead, 0);
     }
 }
 
@@ -0,0 +1,320 @@
+//MIT License
+
+//Copyright (c) 2020 bexoft GmbH (mail@bexoft.de)
+
+//Permission is hereby granted, free of charge, to any person obtaining a copy
+//of this software and associated documentation files (the "Software"), to deal
+//in the Software without restriction, including without limitation the rights
+//to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//copies of the Software, and to permit persons to whom the Software is
+//furnished to do so, subject to the following conditions:
+
+//The above copyright notice and this permission notice shall be included in all
+//copies or substantial portions of the Software.
+
+//THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//SOFTWARE.
+
+#include "gtest/gtest.h"
+#include "gmock/gmock.h"
+
+
+#include "finalmq/helpers/ZeroCopyBuffer.h"
+#include "finalmq/serializeproto/SerializerProtoDirect.h"
+#include "finalmq/serializeproto/ParserProtoDirect.h"
+#include "finalmq/serializestruct/StructFactoryRegistry.h"
+#include "test.fmq.h"
+#include "test.pb.h"
+
+
+using namespace finalmq;
+
+
+template<class T>
+static std::string serializeDirect(const T& value)
+{
+    ZeroCopyBuffer buffer;
+    value.serializeProto(buffer);
+    return buffer.getData();
+}
+
+template<class T>
+static std::string serializePipeline(const T& value)
+{
+    ZeroCopyBuffer buffer;
+    value.StructBase::serializeProto(buffer);
+    return buffer.getData();
+}
+
+template<class T>
+static T parsePipeline(const std::string& data)
+{
+    T value;
+    EXPECT_EQ(value.StructBase::parseProto(data.data(), data.size()), true);
+    return value;
+}
+
+template<class T>
+static T parseDirect(const std::string& data)
+{
+    T value;
+    EXPECT_EQ(value.parseProto(data.data(), data.size()), true);
+    return value;
+}
+
+
+
+TEST(TestSerializerProtoDirect, testSameAsPipeline)
+{
+    test::TestArrayStruct arrayStruct{{{test::TestInt32{-2}, test::TestString{"hello"}, 3}, {test::TestInt32{0}, test::TestString{""}, 0}}, 123};
+    EXPECT_EQ(serializeDirect(arrayStruct), serializePipeline(arrayStruct));
+
+    test::TestInt32ZigZag int32ZigZag{-12345};
+    EXPECT_EQ(serializeDirect(int32ZigZag), serializePipeline(int32ZigZag));
+
+    test::TestArrayInt8 arrayInt8{{-1, 0, 12}};
+    EXPECT_EQ(serializeDirect(arrayInt8), serializePipeline(arrayInt8));
+
+    test::TestArrayBool arrayBool{{true, false, true}};
+    EXPECT_EQ(serializeDirect(arrayBool), serializePipeline(arrayBool));
+
+    test::TestArrayString arrayString{{"a", "", "bc"}};
+    EXPECT_EQ(serializeDirect(arrayString), serializePipeline(arrayString));
+
+    test::TestArrayEnum arrayEnum{{test::Foo::FOO_HELLO, test::Foo::FOO_WORLD2}};
+    EXPECT_EQ(serializeDirect(arrayEnum), serializePipeline(arrayEnum));
+
+    test::TestStructNullable structNullable{nullptr, test::TestString{"x"}, 0};
+    EXPECT_EQ(serializeDirect(structNullable), serializePipeline(structNullable));
+}
+
+TEST(TestSerializerProtoDirect, testBigStruct)
+{
+    // the pipeline pads the size of big sub structs, the direct serialization knows the sizes in advance
+    const std::string VALUE(20000, 'a');
+    test::TestStruct value{test::TestInt32{-5}, test::TestString{VALUE}, 7};
+    std::string data = serializeDirect(value);
+
+    fmq::test::TestStruct message;
+    EXPECT_EQ(message.ParseFromString(data), true);
+    EXPECT_EQ(message.struct_int32().value(), -5);
+    EXPECT_EQ(message.struct_string().value(), VALUE);
+    EXPECT_EQ(message.last_value(), 7u);
+    EXPECT_EQ(data, message.SerializeAsString());
+
+    EXPECT_EQ(parseDirect<test::TestStruct>(data), value);
+    EXPECT_EQ(parsePipeline<test::TestStruct>(data), value);
+    EXPECT_EQ(parseDirect<test::TestStruct>(serializePipeline(value)), value);
+}
+
+TEST(TestSerializerProtoDirect, testArrays)
+{
+    test::TestArrayInt16 arrayInt16{{-1, 2, 32000}};
+    EXPECT_EQ(parseDirect<test::TestArrayInt16>(serializeDirect(arrayInt16)), arrayInt16);
+    test::TestArrayUInt16 arrayUInt16{{1, 2, 65000}};
+    EXPECT_EQ(parseDirect<test::TestArrayUInt16>(serializeDirect(arrayUInt16)), arrayUInt16);
+    test::TestArrayInt64 arrayInt64{{-1, 2, 0x7fffffffffffffffll}};
+    EXPECT_EQ(parseDirect<test::TestArrayInt64>(serializeDirect(arrayInt64)), arrayInt64);
+    test::TestArrayUInt64 arrayUInt64{{1, 0, 0xffffffffffffffffull}};
+    EXPECT_EQ(parseDirect<test::TestArrayUInt64>(serializeDirect(arrayUInt64)), arrayUInt64);
+    test::TestArrayDouble arrayDouble{{-1.5, 0.0, 2.25}};
+    EXPECT_EQ(parseDirect<test::TestArrayDouble>(serializeDirect(arrayDouble)), arrayDouble);
+    test::TestArrayBytes arrayBytes{{{'a', 0}, {}, {'b'}}};
+    EXPECT_EQ(parseDirect<test::TestArrayBytes>(serializeDirect(arrayBytes)), arrayBytes);
+    test::TestArrayEnum arrayEnum{{test::Foo::FOO_HELLO, test::Foo::FOO_WORLD2}};
+    EXPECT_EQ(parseDirect<test::TestArrayEnum>(serializeDirect(arrayEnum)), arrayEnum);
+    test::TestArrayStruct arrayStruct{{{test::TestInt32{-2}, test::TestString{"hello"}, 3}, {}}, 123};
+    EXPECT_EQ(parseDirect<test::TestArrayStruct>(serializeDirect(arrayStruct)), arrayStruct);
+}
+
+TEST(TestSerializerProtoDirect, testArraysReservedFromWire)
+{
+    test::TestArrayStruct arrayStruct;
+    test::TestArrayString arrayString;
+    for (int i = 0; i < 100; ++i)
+    {
+        arrayStruct.value.push_back({test::TestInt32{i}, test::TestString{std::to_string(i)}, static_cast<std::uint32_t>(i)});
+        arrayString.value.push_back(std::to_string(i));
+    }
+    arrayStruct.last_value = 7;
+
+    // the arrays get their size at the first entry and do not grow entry by entry
+    test::TestArrayStruct arrayStructParsed = parseDirect<test::TestArrayStruct>(serializeDirect(arrayStruct));
+    EXPECT_EQ(arrayStructParsed, arrayStruct);
+    EXPECT_EQ(arrayStructParsed.value.capacity(), arrayStruct.value.size());
+
+    test::TestArrayString arrayStringParsed = parseDirect<test::TestArrayString>(serializeDirect(arrayString));
+    EXPECT_EQ(arrayStringParsed, arrayString);
+    EXPECT_EQ(arrayStringParsed.value.capacity(), arrayString.value.size());
+}
+
+TEST(TestSerializerProtoDirect, testArrayEntriesNotInSequence)
+{
+    // protobuf allows other fields between the entries of a repeated field
+    test::TestArrayStruct first{{{test::TestInt32{1}, test::TestString{"a"}, 1}, {test::TestInt32{2}, test::TestString{"b"}, 2}}, 0};
+    test::TestArrayStruct middle{{}, 5};
+    test::TestArrayStruct last{{{test::TestInt32{3}, test::TestString{"c"}, 3}}, 0};
+    std::string data = serializeDirect(first) + serializeDirect(middle) + serializeDirect(last);
+
+    test::TestArrayStruct expected{{first.value[0], first.value[1], last.value[0]}, 5};
+    EXPECT_EQ(parseDirect<test::TestArrayStruct>(data), expected);
+    EXPECT_EQ(parsePipeline<test::TestArrayStruct>(data), expected);
+}
+
+TEST(TestSerializerProtoDirect, testPackedArrays)
+{
+    fmq::test::TestArrayInt32 message;
+    message.add_value(-1);
+    message.add_value(2);
+    message.add_value(3);
+    std::string data = message.SerializeAsString();
+
+    test::TestArrayInt32 value = parseDirect<test::TestArrayInt32>(data);
+    EXPECT_EQ(value.value, std::vector<std::int32_t>({-1, 2, 3}));
+}
+
+TEST(TestSerializerProtoDirect, testFallbackForVariant)
+{
+    test::TestStructVariant value;
+    value.struct_variant.value = VariantStruct{{"a", 2}, {"b", std::string("hello")}};
+    value.struct_variant.valueInt32 = 5;
+    value.last_value = 9;
+
+    std::string data = serializeDirect(value);
+    EXPECT_EQ(data, serializePipeline(value));
+    EXPECT_EQ(parseDirect<test::TestStructVariant>(data), value);
+}
+
+TEST(TestSerializerProtoDirect, testInvalidEnum)
+{
+    fmq::test::TestEnum message;
+    message.set_value(static_cast<fmq::test::Foo>(5));
+    std::string data = message.SerializeAsString();
+
+    test::TestEnum value;
+    value.value = test::Foo::FOO_WORLD2;
+    EXPECT_EQ(value.parseProto(data.data(), data.size()), true);
+    EXPECT_EQ(value.value, test::Foo::FOO_WORLD);
+}
+
+TEST(TestSerializerProtoDirect, testCorruptData)
+{
+    test::TestStruct value{test::TestInt32{-5}, test::TestString{"hello"}, 7};
+    std::string data = serializeDirect(value);
+    data.resize(data.size() - 3);
+
+    test::TestStruct valueParsed;
+    EXPECT_EQ(valueParsed.parseProto(data.data(), data.size()), false);
+
+    test::TestStruct valueEmpty{test::TestInt32{-5}, test::TestString{"hello"}, 7};
+    EXPECT_EQ(valueEmpty.parseProto(nullptr, 0), true);
+    EXPECT_EQ(valueEmpty, test::TestStruct());
+}
+
+class CountingMemoryResource : public std::pmr::memory_resource
+{
+public:
+    size_t getAllocated() const
+    {
+        return m_allocated;
+    }
+
+private:
+    virtual void* do_allocate(size_t bytes, size_t alignment) override
+    {
+        m_allocated += bytes;
+        return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+    }
+    virtual void do_deallocate(void* p, size_t bytes, size_t alignment) override
+    {
+        std::pmr::new_delete_resource()->deallocate(p, bytes, alignment);
+    }
+    virtual bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override
+    {
+        return (this == &other);
+    }
+
+    size_t m_allocated = 0;
+};
+
+static test::TestPmr createTestPmr()
+{
+    test::TestPmr value;
+    value.value_string = "a string that does not fit into the small buffer";
+    value.value_bytes = {'a', 'b', 'c'};
+    value.inner.name = "the name of the inner struct, it is long enough";
+    value.inner.values = {1, 2, 3};
+    value.inner_nullable = std::make_shared<test::TestInt32>(-7);
+    value.array_bool = {true, false, true};
+    value.array_int32 = {-1, 0, 100000};
+    value.array_double = {1.5, -2.25};
+    value.array_string = {"the first entry of the string array", "", "the third entry of the string array"};
+    value.array_bytes = {{'x', 'y'}, {}};
+    value.array_struct.resize(2);
+    value.array_struct[0].name = "the first entry of the struct array";
+    value.array_struct[0].values = {4, 5};
+    value.array_struct[1].name = "the second entry of the struct array";
+    value.array_enum = {test::Foo::FOO_HELLO, test::Foo::FOO_WORLD2};
+    value.last_value = 12;
+    return value;
+}
+
+TEST(TestSerializerProtoDirect, testPmrStruct)
+{
+    test::TestPmr value = createTestPmr();
+
+    std::string data = serializeDirect(value);
+    EXPECT_EQ(data, serializePipeline(value));
+    EXPECT_EQ(parseDirect<test::TestPmr>(data), value);
+    EXPECT_EQ(parsePipeline<test::TestPmr>(data), value);
+}
+
+TEST(TestSerializerProtoDirect, testPmrStructInArena)
+{
+    test::TestPmr value = createTestPmr();
+    std::string data = serializeDirect(value);
+
+    CountingMemoryResource upstream;
+    std::shared_ptr<std::pmr::memory_resource> arena = std::make_shared<std::pmr::monotonic_buffer_resource>(&upstream);
+    std::weak_ptr<std::pmr::memory_resource> arenaWeak = arena;
+
+    StructBasePtr structBase = StructFactoryRegistry::instance().createStruct("test.TestPmr", arena);
+    arena = nullptr;
+    ASSERT_NE(structBase, nullptr);
+    test::TestPmr& valueArena = static_cast<test::TestPmr&>(*structBase);
+    EXPECT_EQ(valueArena.parseProto(data.data(), data.size()), true);
+    EXPECT_EQ(valueArena, value);
+
+    // all strings and arrays are allocated from the arena, only the nullable struct is allocated from the heap
+    std::pmr::memory_resource* resource = valueArena.value_string.get_allocator().resource();
+    EXPECT_NE(resource, std::pmr::get_default_resource());
+    EXPECT_EQ(valueArena.inner.name.get_allocator().resource(), resource);
+    EXPECT_EQ(valueArena.array_string[2].get_allocator().resource(), resource);
+    EXPECT_EQ(valueArena.array_struct[1].name.get_allocator().resource(), resource);
+    EXPECT_EQ(valueArena.array_struct[0].values.get_allocator().resource(), resource);
+    EXPECT_GT(upstream.getAllocated(), 0u);
+
+    // the visitor pipeline (ParserProto -> SerializerStruct) decodes into the arena as well
+    EXPECT_EQ(valueArena.StructBase::parseProto(data.data(), data.size()), true);
+    EXPECT_EQ(valueArena, value);
+    EXPECT_EQ(valueArena.array_struct[1].name.get_allocator().resource(), resource);
+
+    // the struct keeps the arena alive
+    EXPECT_EQ(arenaWeak.expired(), false);
+    structBase = nullptr;
+    EXPECT_EQ(arenaWeak.expired(), true);
+}
+
+TEST(TestSerializerProtoDirect, testArenaForStructWithoutPmr)
+{
+    std::shared_ptr<std::pmr::memory_resource> arena = std::make_shared<std::pmr::monotonic_buffer_resource>();
+    StructBasePtr structBase = StructFactoryRegistry::instance().createStruct("test.TestStruct", arena);
+    ASSERT_NE(structBase, nullptr);
+    EXPECT_EQ(structBase->getStructInfo().getTypeName(), "test.TestStruct");
+    EXPECT_EQ(arena.use_count(), 1);
+}
@@ -25,8 +25,11 @@
 
 
 #include "finalmq/serializeproto/SerializerProto.h"
+#include "finalmq/serializestruct/ParserStruct.h"
+#include "finalmq/helpers/ZeroCopyBuffer.h"
 #include "finalmq/metadata/MetaData.h"
 #include "MockIZeroCopyBuffer.h"
+#include "test.fmq.h"
 #include "test.pb.h"
 #include "matchers.h"
 
@@ -434,3 +437,107 @@ TEST(TestSerializerProtoStruct, test122DataBlockSize1)
     EXPECT_EQ(message.last_value(), VALUE3);
 }
 
+
+
+static std::string serializeStruct(const StructBase& value, bool canonical)
+{
+    ZeroCopyBuffer buffer;
+    if (canonical)
+    {
+        std::vector<ssize_t> structSizes;
+        SerializerProtoSize serializerSize(structSizes);
+        ParserStruct parserSize(serializerSize, value);
+        parserSize.parseStruct();
+        SerializerProto serializer(buffer, 512, &structSizes);
+        ParserStruct parser(serializer, value);
+        parser.parseStruct();
+        EXPECT_EQ(static_cast<size_t>(serializerSize.getSize()), buffer.size());
+    }
+    else
+    {
+        SerializerProto serializer(buffer, 512);
+        ParserStruct parser(serializer, value);
+        parser.parseStruct();
+    }
+    return buffer.getData();
+}
+
+TEST(TestSerializerProtoStruct, testCanonicalBigStructs)
+{
+    const std::string VALUE(20000, 'a');
+    test::TestArrayStruct value{{{test::TestInt32{-5}, test::TestString{VALUE}, 7},
+                                 {},
+                                 {test::TestInt32{0}, test::TestString{"hello"}, 0}},
+                                123};
+
+    std::string data = serializeStruct(value, true);
+    fmq::test::TestArrayStruct message;
+    EXPECT_EQ(message.ParseFromString(data), true);
+    ASSERT_EQ(message.value_size(), 3);
+    EXPECT_EQ(message.value(0).struct_string().value(), VALUE);
+    EXPECT_EQ(message.value(2).struct_string().value(), "hello");
+    EXPECT_EQ(message.last_value(), 123u);
+    EXPECT_EQ(data, message.SerializeAsString());
+
+    // the default mode pads the sizes of big structs
+    std::string dataPadded = serializeStruct(value, false);
+    EXPECT_GT(dataPadded.size(), data.size());
+    fmq::test::TestArrayStruct messagePadded;
+    EXPECT_EQ(messagePadded.ParseFromString(dataPadded), true);
+    ASSERT_EQ(messagePadded.value_size(), 3);
+    EXPECT_EQ(messagePadded.value(0).struct_string().value(), VALUE);
+    EXPECT_EQ(messagePadded.last_value(), 123u);
+}
+
+TEST(TestSerializerProtoStruct, testCanonicalEmptyStructs)
+{
+    test::TestStruct value;
+    EXPECT_EQ(serializeStruct(value, true), "");
+
+    test::TestStruct valueNested{test::TestInt32{0}, test::TestString{"x"}, 0};
+    std::string data = serializeStruct(valueNested, true);
+    fmq::test::TestStruct message;
+    EXPECT_EQ(message.ParseFromString(data), true);
+    EXPECT_EQ(message.has_struct_int32(), false);
+    EXPECT_EQ(data, message.SerializeAsString());
+    EXPECT_EQ(data, serializeStruct(valueNested, false));
+}
+
+TEST(TestSerializerProtoStruct, testCanonicalMixedSizes)
+{
+    test::TestArrayStruct value;
+    for (int i = 0; i < 20; ++i)
+    {
+        value.value.push_back({test::TestInt32{i}, test::TestString{std::string(i * 20, 'a')}, static_cast<std::uint32_t>(i)});
+    }
+    value.value.push_back({test::TestInt32{1}, test::TestString{std::string(5000, 'b')}, 1});
+
+    std::string data = serializeStruct(value, true);
+    fmq::test::TestArrayStruct message;
+    EXPECT_EQ(message.ParseFromString(data), true);
+    ASSERT_EQ(message.value_size(), 21);
+    EXPECT_EQ(message.value(20).struct_string().value(), std::string(5000, 'b'));
+    EXPECT_EQ(data, message.SerializeAsString());
+    EXPECT_LE(data.size(), serializeStruct(value, false).size());
+}
+
+TEST(TestSerializerProtoStruct, testCanonicalVariant)
+{
+    test::TestStructVariant value;
+    value.struct_variant.value = VariantStruct{{"a", 3}, {"b", std::string(200, 'x')}, {"c", VariantList{1.5, -7, std::vector<std::int32_t>{1, -2, 3}}}};
+    value.struct_variant.valueInt32 = -4;
+    value.last_value = 9;
+
+    std::string data = serializeStruct(value, true);
+    fmq::test::TestStructVariant message;
+    EXPECT_EQ(message.ParseFromString(data), true);
+    EXPECT_EQ(message.struct_variant().valueint32(), -4);
+    EXPECT_EQ(message.last_value(), 9u);
+    EXPECT_EQ(data, message.SerializeAsString());
+
+    // the padded data contains the same content, besides the dummy fields
+    fmq::test::TestStructVariant messagePadded;
+    EXPECT_EQ(messagePadded.ParseFromString(serializeStruct(value, false)), true);
+    messagePadded.DiscardUnknownFields();
+    EXPECT_EQ(data, messagePadded.SerializeAsString());
+}
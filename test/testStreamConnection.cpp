@@ -0,0 +1,207 @@
+//MIT License
+
+//Copyright (c) 2020 bexoft GmbH (mail@bexoft.de)
+
+//Permission is hereby granted, free of charge, to any person obtaining a copy
+//of this software and associated documentation files (the "Software"), to deal
+//in the Software without restriction, including without limitation the rights
+//to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//copies of the Software, and to permit persons to whom the Software is
+//furnished to do so, subject to the following conditions:
+
+//The above copyright notice and this permission notice shall be included in all
+//copies or substantial portions of the Software.
+
+//THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//SOFTWARE.
+
+
+#if !defined(WIN32)
+
+#include "gtest/gtest.h"
+#include "gmock/gmock.h"
+
+
+#include "finalmq/streamconnection/StreamConnection.h"
+#include "finalmq/protocolsession/ProtocolMessage.h"
+#include "finalmq/helpers/OperatingSystem.h"
+
+#include <thread>
+
+
+#include "MockIOperatingSystem.h"
+#include "MockIPoller.h"
+#include "MockIStreamConnectionCallback.h"
+
+
+using ::testing::_;
+using ::testing::Return;
+using ::testing::InSequence;
+
+using namespace finalmq;
+
+static const int TESTSOCKET = 7;
+static const std::string BUFFER = "abcd";
+
+static const int MAX_SEND_BUFFERS = 1024;
+
+
+
+class TestStreamConnection : public testing::Test
+{
+protected:
+    virtual void SetUp()
+    {
+        m_mockOperatingSystem = new MockIOperatingSystem;
+        OperatingSystem::setInstance(std::unique_ptr<IOperatingSystem>(m_mockOperatingSystem));
+        EXPECT_CALL(*m_mockOperatingSystem, setNonBlocking(TESTSOCKET, true)).WillRepeatedly(Return(0));
+        EXPECT_CALL(*m_mockOperatingSystem, setLinger(TESTSOCKET, true, 0)).WillRepeatedly(Return(0));
+        EXPECT_CALL(*m_mockOperatingSystem, setNoDelay(TESTSOCKET, true)).WillRepeatedly(Return(0));
+
+        EXPECT_CALL(*m_mockOperatingSystem, closeSocket(TESTSOCKET)).WillRepeatedly(Return(0));
+
+        m_mockPoller = std::make_shared<MockIPoller>();
+        m_mockCallback = std::make_shared<MockIStreamConnectionCallback>();
+
+        createConnection({});
+    }
+
+    virtual void TearDown()
+    {
+        m_connection = nullptr;
+        m_socketDescriptor = nullptr;
+        OperatingSystem::setInstance({});
+    }
+
+    void createConnection(const SendQueueConfig& sendQueue)
+    {
+        SocketPtr socket = std::make_shared<Socket>();
+        socket->attach(TESTSOCKET);
+        m_socketDescriptor = socket->getSocketDescriptor();
+
+        ConnectionData connectionData;
+        connectionData.connectionId = 1;
+        connectionData.connectionState = ConnectionState::CONNECTIONSTATE_CONNECTED;
+        connectionData.connectionProperties.sendQueue = sendQueue;
+        m_connection = std::make_shared<StreamConnection>(connectionData, socket, m_mockPoller, nullptr, m_mockCallback);
+    }
+
+    IMessagePtr createMessage(int numberOfBuffers)
+    {
+        IMessagePtr message = std::make_shared<ProtocolMessage>(0);
+        std::list<std::string> payloadBuffers(numberOfBuffers, BUFFER);
+        std::list<BufferRef> payloads(numberOfBuffers, BufferRef{nullptr, BUFFER.size()});
+        message->moveSendBuffers(std::move(payloadBuffers), payloads);
+        return message;
+    }
+
+    MockIOperatingSystem* m_mockOperatingSystem = nullptr;
+    std::shared_ptr<MockIPoller> m_mockPoller;
+    std::shared_ptr<MockIStreamConnectionCallback> m_mockCallback;
+    SocketDescriptorPtr m_socketDescriptor;
+    IStreamConnectionPrivatePtr m_connection;
+};
+
+
+
+TEST_F(TestStreamConnection, testSendMoreBuffersThanMaxSendBuffers)
+{
+    static const int NUMBER_OF_BUFFERS = MAX_SEND_BUFFERS + 100;
+    {
+        InSequence seq;
+        // the socket takes all buffers of the first call, the rest of the message follows with the next call
+        EXPECT_CALL(*m_mockOperatingSystem, sendv(TESTSOCKET, _, MAX_SEND_BUFFERS, _)).WillOnce(Return(MAX_SEND_BUFFERS * BUFFER.size()));
+        EXPECT_CALL(*m_mockOperatingSystem, sendv(TESTSOCKET, _, NUMBER_OF_BUFFERS - MAX_SEND_BUFFERS, _)).WillOnce(Return(0));
+        EXPECT_CALL(*m_mockPoller, enableWrite(m_socketDescriptor)).Times(1);
+        EXPECT_CALL(*m_mockOperatingSystem, sendv(TESTSOCKET, _, NUMBER_OF_BUFFERS - MAX_SEND_BUFFERS, _)).WillOnce(Return((NUMBER_OF_BUFFERS - MAX_SEND_BUFFERS) * BUFFER.size()));
+        EXPECT_CALL(*m_mockPoller, disableWrite(m_socketDescriptor)).Times(1);
+    }
+
+    m_connection->sendMessage(createMessage(NUMBER_OF_BUFFERS));
+    EXPECT_EQ(m_connection->getSendQueueStatistics().pendingMessages, 1);
+
+    // the socket is writable
+    EXPECT_EQ(m_connection->sendPendingMessages(), false);
+    EXPECT_EQ(m_connection->getSendQueueStatistics().pendingMessages, 0);
+    EXPECT_EQ(m_connection->getSendQueueStatistics().pendingBytes, 0);
+}
+
+TEST_F(TestStreamConnection, testSendMoreBuffersThanMaxSendBuffersInManyMessages)
+{
+    static const int NUMBER_OF_BUFFERS = 400;
+    {
+        InSequence seq;
+        EXPECT_CALL(*m_mockOperatingSystem, sendv(TESTSOCKET, _, NUMBER_OF_BUFFERS, _)).WillOnce(Return(0));
+        EXPECT_CALL(*m_mockPoller, enableWrite(m_socketDescriptor)).Times(1);
+        // the collection stops inside of the third message
+        EXPECT_CALL(*m_mockOperatingSystem, sendv(TESTSOCKET, _, MAX_SEND_BUFFERS, _)).WillOnce(Return(MAX_SEND_BUFFERS * BUFFER.size()));
+        EXPECT_CALL(*m_mockOperatingSystem, sendv(TESTSOCKET, _, 3 * NUMBER_OF_BUFFERS - MAX_SEND_BUFFERS, _)).WillOnce(Return((3 * NUMBER_OF_BUFFERS - MAX_SEND_BUFFERS) * BUFFER.size()));
+        EXPECT_CALL(*m_mockPoller, disableWrite(m_socketDescriptor)).Times(1);
+    }
+
+    // the socket would block, the messages are queued
+    m_connection->sendMessage(createMessage(NUMBER_OF_BUFFERS));
+    m_connection->sendMessage(createMessage(NUMBER_OF_BUFFERS));
+    m_connection->sendMessage(createMessage(NUMBER_OF_BUFFERS));
+    EXPECT_EQ(m_connection->getSendQueueStatistics().pendingMessages, 3);
+
+    // the socket is writable
+    EXPECT_EQ(m_connection->sendPendingMessages(), false);
+    EXPECT_EQ(m_connection->getSendQueueStatistics().pendingMessages, 0);
+}
+
+TEST_F(TestStreamConnection, testDropOldestKeepsPartiallySentMessage)
+{
+    SendQueueConfig sendQueue;
+    sendQueue.highWaterMarkMessages = 2;
+    sendQueue.overflowPolicy = OverflowPolicy::OVERFLOW_DROP_OLDEST;
+    createConnection(sendQueue);
+    {
+        InSequence seq;
+        // the first message is partially sent
+        EXPECT_CALL(*m_mockOperatingSystem, sendv(TESTSOCKET, _, 1, _)).WillOnce(Return(2));
+        EXPECT_CALL(*m_mockPoller, enableWrite(m_socketDescriptor)).Times(1);
+        // the rest of the first message and the third message, the second message was dropped
+        EXPECT_CALL(*m_mockOperatingSystem, sendv(TESTSOCKET, _, 2, _)).WillOnce(Return(BUFFER.size() - 2 + BUFFER.size()));
+        EXPECT_CALL(*m_mockPoller, disableWrite(m_socketDescriptor)).Times(1);
+    }
+
+    m_connection->sendMessage(createMessage(1));
+    m_connection->sendMessage(createMessage(1));
+    m_connection->sendMessage(createMessage(1));
+    EXPECT_EQ(m_connection->getSendQueueStatistics().pendingMessages, 2);
+    EXPECT_EQ(m_connection->getSendQueueStatistics().droppedMessages, 1);
+
+    // the socket is writable
+    EXPECT_EQ(m_connection->sendPendingMessages(), false);
+    EXPECT_EQ(m_connection->getSendQueueStatistics().pendingMessages, 0);
+}
+
+TEST_F(TestStreamConnection, testBlockDoesNotBlockReactorThread)
+{
+    SendQueueConfig sendQueue;
+    sendQueue.highWaterMarkMessages = 1;
+    sendQueue.overflowPolicy = OverflowPolicy::OVERFLOW_BLOCK;
+    createConnection(sendQueue);
+    EXPECT_CALL(*m_mockOperatingSystem, sendv(TESTSOCKET, _, 1, _)).WillOnce(Return(0));
+    EXPECT_CALL(*m_mockPoller, enableWrite(m_socketDescriptor)).Times(1);
+
+    m_connection->sendMessage(createMessage(1));
+    EXPECT_EQ(m_connection->getSendQueueStatistics().pendingMessages, 1);
+
+    // a poller thread of any reactor drops the new message instead of waiting for the full queue
+    std::thread reactorThread([this]() {
+        StreamConnection::markReactorThread();
+        m_connection->sendMessage(createMessage(1));
+    });
+    reactorThread.join();
+    EXPECT_EQ(m_connection->getSendQueueStatistics().pendingMessages, 1);
+    EXPECT_EQ(m_connection->getSendQueueStatistics().droppedMessages, 1);
+}
+
+#endif
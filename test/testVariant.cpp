@@ -572,3 +572,120 @@ TEST_F(TestVariant, testGetOrCreate)
     ASSERT_EQ(std::string("Hello"), variant.getDataValue<std::string>("aaa.3.bbb"));
 }
 
+
+TEST_F(TestVariant, testInlineValues)
+{
+    EXPECT_EQ(Variant(true).isInline(), true);
+    EXPECT_EQ(Variant(static_cast<std::int32_t>(-5)).isInline(), true);
+    EXPECT_EQ(Variant(1.5).isInline(), true);
+    EXPECT_EQ(Variant(std::string("short")).isInline(), true);
+    EXPECT_EQ(Variant("short").isInline(), true);
+    EXPECT_EQ(Variant(std::string(100, 'a')).isInline(), false);
+    EXPECT_EQ(Variant(VariantStruct()).isInline(), false);
+    EXPECT_EQ(Variant().isInline(), false);
+
+    Variant variant = std::string("short");
+    Variant copy = variant;
+    Variant moved = std::move(copy);
+    EXPECT_EQ(moved.isInline(), true);
+    EXPECT_EQ(copy.getType(), VARTYPE_NONE);
+    std::string* str = moved;
+    ASSERT_NE(str, nullptr);
+    *str = "changed";
+    EXPECT_EQ(variant.getDataValue<std::string>(""), "short");
+    EXPECT_EQ(moved.getDataValue<std::string>(""), "changed");
+}
+
+TEST_F(TestVariant, testCopyOnWrite)
+{
+    Variant variant = VariantStruct({{"a", 1}, {"b", std::string(100, 'b')}, {"sub", VariantStruct({{"c", 3}})}});
+    Variant copy = variant;
+
+    // the copy shares the value, till it is changed
+    const Variant& constCopy = copy;
+    EXPECT_EQ(constCopy.getData<VariantStruct>(""), static_cast<const Variant&>(variant).getData<VariantStruct>(""));
+
+    copy.getVariant("sub")->add("d", 4);
+    *copy.getData<std::string>("b") = "changed";
+    copy.add("e", 5);
+
+    EXPECT_EQ(variant.getVariant("sub.d"), nullptr);
+    EXPECT_EQ(variant.getVariant("e"), nullptr);
+    EXPECT_EQ(variant.getDataValue<std::string>("b"), std::string(100, 'b'));
+    EXPECT_EQ(copy.getDataValue<int>("sub.d"), 4);
+    EXPECT_EQ(copy.getDataValue<int>("e"), 5);
+    EXPECT_EQ(copy.getDataValue<std::string>("b"), "changed");
+}
+
+TEST_F(TestVariant, testAssignPartOfItself)
+{
+    Variant variant = VariantStruct({{"sub", VariantStruct({{"a", std::string(100, 'a')}})}});
+    variant = *variant.getVariant("sub");
+    EXPECT_EQ(variant.getDataValue<std::string>("a"), std::string(100, 'a'));
+
+    Variant list = VariantList({VariantList({1, 2})});
+    list = std::move(*list.getVariant("0"));
+    EXPECT_EQ(list.getDataValue<int>("1"), 2);
+}
+
+TEST_F(TestVariant, testStructIndex)
+{
+    static const int SIZE = 100;
+    Variant variant = VariantStruct();
+    for (int i = 0; i < SIZE; ++i)
+    {
+        variant.add("key" + std::to_string(i), i);
+    }
+    // replaces the value
+    variant.add("key50", -50);
+
+    ASSERT_EQ(variant.size(), SIZE);
+    for (int i = 0; i < SIZE; ++i)
+    {
+        EXPECT_EQ(variant.getDataValue<int>("key" + std::to_string(i)), (i == 50) ? -50 : i);
+    }
+    EXPECT_EQ(variant.getVariant("key100"), nullptr);
+
+    // changes through the data are detected
+    VariantStruct* data = variant;
+    ASSERT_NE(data, nullptr);
+    data->pop_front();
+    data->emplace_front("first", 1);
+    data->emplace_back("last", 2);
+    EXPECT_EQ(variant.getDataValue<int>("first"), 1);
+    EXPECT_EQ(variant.getDataValue<int>("last"), 2);
+    EXPECT_EQ(variant.getVariant("key0"), nullptr);
+    EXPECT_EQ(variant.getDataValue<int>("key99"), 99);
+
+    const Variant& constVariant = variant;
+    EXPECT_EQ(constVariant.getDataValue<int>("key98"), 98);
+    EXPECT_EQ(constVariant.getVariant("key0"), nullptr);
+}
+
+TEST_F(TestVariant, testStructIndexRename)
+{
+    static const int SIZE = 20;
+    Variant variant = VariantStruct();
+    for (int i = 0; i < SIZE; ++i)
+    {
+        variant.add("key" + std::to_string(i), i);
+    }
+    // builds the index
+    EXPECT_EQ(variant.getDataValue<int>("key5"), 5);
+
+    // renaming keeps the number of entries
+    VariantStruct* data = variant.getData<VariantStruct>("");
+    ASSERT_NE(data, nullptr);
+    data->at(5).first = "renamed";
+    data->at(6) = {"replaced", -6};
+
+    EXPECT_EQ(variant.getDataValue<int>("renamed"), 5);
+    EXPECT_EQ(variant.getDataValue<int>("replaced"), -6);
+    EXPECT_EQ(variant.getVariant("key5"), nullptr);
+    EXPECT_EQ(variant.getVariant("key6"), nullptr);
+    EXPECT_EQ(variant.getDataValue<int>("key7"), 7);
+
+    const Variant& constVariant = variant;
+    EXPECT_EQ(constVariant.getDataValue<int>("renamed"), 5);
+    EXPECT_EQ(constVariant.getVariant("key5"), nullptr);
+}
@@ -0,0 +1,106 @@
+//MIT License
+
+//Copyright (c) 2020 bexoft GmbH (mail@bexoft.de)
+
+//Permission is hereby granted, free of charge, to any person obtaining a copy
+//of this software and associated documentation files (the "Software"), to deal
+//in the Software without restriction, including without limitation the rights
+//to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//copies of the Software, and to permit persons to whom the Software is
+//furnished to do so, subject to the following conditions:
+
+//The above copyright notice and this permission notice shall be included in all
+//copies or substantial portions of the Software.
+
+//THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//SOFTWARE.
+
+
+#include "gtest/gtest.h"
+
+#include <chrono>
+#include <iostream>
+#include <new>
+
+#include <stdlib.h>
+
+#include "finalmq/variant/Variant.h"
+#include "finalmq/variant/VariantValueStruct.h"
+#include "finalmq/variant/VariantValues.h"
+
+
+using namespace finalmq;
+
+
+// counts the heap allocations of the current thread
+static thread_local std::int64_t g_allocations = 0;
+
+void* operator new(size_t size)
+{
+    ++g_allocations;
+    void* p = malloc(size ? size : 1);
+    if (p == nullptr)
+    {
+        throw std::bad_alloc();
+    }
+    return p;
+}
+
+void operator delete(void* p) noexcept
+{
+    free(p);
+}
+
+void operator delete(void* p, size_t /*size*/) noexcept
+{
+    free(p);
+}
+
+
+
+TEST(TestVariantBenchmark, testAllocations)
+{
+    static const int LOOPS = 100000;
+
+    std::int64_t allocations = g_allocations;
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < LOOPS; ++i)
+    {
+        Variant valueInt = i;
+        Variant valueBool = true;
+        Variant valueString = std::string("short");
+        Variant copyInt = valueInt;
+        Variant copyString = valueString;
+    }
+    double timeScalars = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    std::int64_t allocationsScalars = g_allocations - allocations;
+    // scalars and short strings are stored inline
+    EXPECT_EQ(allocationsScalars, 0);
+
+    // metainfo like data: copies share the struct
+    Variant metainfo = VariantStruct();
+    for (int i = 0; i < 20; ++i)
+    {
+        metainfo.add("header" + std::to_string(i), std::string("value") + std::to_string(i));
+    }
+    allocations = g_allocations;
+    start = std::chrono::steady_clock::now();
+    for (int i = 0; i < LOOPS; ++i)
+    {
+        Variant copy = metainfo;
+        const Variant& constCopy = copy;
+        EXPECT_NE(constCopy.getVariant("header19"), nullptr);
+    }
+    double timeStruct = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    std::int64_t allocationsStruct = g_allocations - allocations;
+    EXPECT_EQ(allocationsStruct, 0);
+
+    std::cout << "variant, " << LOOPS << " loops:" << std::endl
+              << "  scalars and short strings: " << timeScalars << " ms, " << allocationsScalars << " allocations" << std::endl
+              << "  copy and lookup of a struct with 20 entries: " << timeStruct << " ms, " << allocationsStruct << " allocations" << std::endl;
+}